@@ -65,6 +65,8 @@ GST_ELEMENT_REGISTER_DEFINE_WITH_CODE (dtlssrtpdemux, "dtlssrtpdemux",
 
 
 static GstFlowReturn sink_chain (GstPad *, GstObject * self, GstBuffer *);
+static GstFlowReturn sink_chain_list (GstPad *, GstObject * self,
+    GstBufferList *);
 
 static void
 gst_dtls_srtp_demux_class_init (GstDtlsSrtpDemuxClass * klass)
@@ -99,43 +101,121 @@ gst_dtls_srtp_demux_init (GstDtlsSrtpDemux * self)
   g_return_if_fail (self->dtls_src);
 
   gst_pad_set_chain_function (sink, GST_DEBUG_FUNCPTR (sink_chain));
+  gst_pad_set_chain_list_function (sink, GST_DEBUG_FUNCPTR (sink_chain_list));
 
   gst_element_add_pad (GST_ELEMENT (self), sink);
   gst_element_add_pad (GST_ELEMENT (self), self->rtp_src);
   gst_element_add_pad (GST_ELEMENT (self), self->dtls_src);
 }
 
-static GstFlowReturn
-sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+/* returns the pad @buffer has to be pushed on, or %NULL if it is invalid */
+static GstPad *
+get_src_pad_for_buffer (GstDtlsSrtpDemux * self, GstBuffer * buffer)
 {
-  GstDtlsSrtpDemux *self = GST_DTLS_SRTP_DEMUX (parent);
   guint8 first_byte;
 
   if (gst_buffer_get_size (buffer) == 0) {
     GST_LOG_OBJECT (self, "received buffer with size 0");
-    gst_buffer_unref (buffer);
-    return GST_FLOW_OK;
+    return NULL;
   }
 
   if (gst_buffer_extract (buffer, 0, &first_byte, 1) != 1) {
     GST_WARNING_OBJECT (self, "could not extract first byte from buffer");
-    gst_buffer_unref (buffer);
-    return GST_FLOW_OK;
+    return NULL;
   }
 
   if (PACKET_IS_DTLS (first_byte)) {
     GST_LOG_OBJECT (self, "pushing dtls packet");
 
-    return gst_pad_push (self->dtls_src, buffer);
+    return self->dtls_src;
   }
 
   if (PACKET_IS_RTP (first_byte)) {
     GST_LOG_OBJECT (self, "pushing rtp packet");
 
-    return gst_pad_push (self->rtp_src, buffer);
+    return self->rtp_src;
   }
 
   GST_WARNING_OBJECT (self, "received invalid buffer: %x", first_byte);
-  gst_buffer_unref (buffer);
-  return GST_FLOW_OK;
+  return NULL;
+}
+
+static GstFlowReturn
+sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  GstDtlsSrtpDemux *self = GST_DTLS_SRTP_DEMUX (parent);
+  GstPad *srcpad;
+
+  srcpad = get_src_pad_for_buffer (self, buffer);
+  if (!srcpad) {
+    gst_buffer_unref (buffer);
+    return GST_FLOW_OK;
+  }
+
+  return gst_pad_push (srcpad, buffer);
+}
+
+typedef struct
+{
+  GstDtlsSrtpDemux *self;
+  /* consecutive buffers for the same source pad */
+  GstBufferList *run;
+  GstPad *run_pad;
+  GstFlowReturn ret;
+} ChainListData;
+
+static gboolean
+chain_list_buffer (GstBuffer ** buffer, guint idx, ChainListData * data)
+{
+  GstPad *srcpad;
+
+  srcpad = get_src_pad_for_buffer (data->self, *buffer);
+  if (!srcpad) {
+    /* stays in the list and is dropped with it */
+    return TRUE;
+  }
+
+  if (data->run && srcpad != data->run_pad) {
+    data->ret = gst_pad_push_list (data->run_pad, data->run);
+    data->run = NULL;
+    if (data->ret != GST_FLOW_OK)
+      return FALSE;
+  }
+
+  if (data->run == NULL) {
+    data->run = gst_buffer_list_new ();
+    data->run_pad = srcpad;
+  }
+
+  /* move the buffer to the run */
+  gst_buffer_list_add (data->run, *buffer);
+  *buffer = NULL;
+
+  return TRUE;
+}
+
+/* A list usually only contains SRTP, push it on as one list and only split
+ * it where DTLS packets are interleaved, so that their order is kept */
+static GstFlowReturn
+sink_chain_list (GstPad * pad, GstObject * parent, GstBufferList * list)
+{
+  ChainListData data;
+
+  data.self = GST_DTLS_SRTP_DEMUX (parent);
+  data.run = NULL;
+  data.run_pad = NULL;
+  data.ret = GST_FLOW_OK;
+
+  GST_LOG_OBJECT (data.self, "received list of %u buffers",
+      gst_buffer_list_length (list));
+
+  list = gst_buffer_list_make_writable (list);
+  gst_buffer_list_foreach (list, (GstBufferListFunc) chain_list_buffer,
+      &data);
+  gst_buffer_list_unref (list);
+
+  if (data.run)
+    data.ret = gst_pad_push_list (data.run_pad, data.run);
+
+  return data.ret;
 }
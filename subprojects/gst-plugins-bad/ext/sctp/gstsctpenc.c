@@ -63,6 +63,7 @@ enum
   PROP_GST_SCTP_ASSOCIATION_ID,
   PROP_REMOTE_SCTP_PORT,
   PROP_USE_SOCK_STREAM,
+  PROP_SEND_BUFFER_SIZE,
 
   NUM_PROPERTIES
 };
@@ -74,6 +75,7 @@ static GParamSpec *properties[NUM_PROPERTIES];
 #define DEFAULT_GST_SCTP_ORDERED TRUE
 #define DEFAULT_SCTP_PPID 1
 #define DEFAULT_USE_SOCK_STREAM FALSE
+#define DEFAULT_SEND_BUFFER_SIZE (1024 * 1024)
 
 #define BUFFER_FULL_SLEEP_TIME 100000
 
@@ -149,6 +151,8 @@ static void gst_sctp_enc_release_pad (GstElement * element, GstPad * pad);
 static void gst_sctp_enc_srcpad_loop (GstPad * pad);
 static GstFlowReturn gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent,
     GstBuffer * buffer);
+static GstFlowReturn gst_sctp_enc_sink_chain_list (GstPad * pad,
+    GstObject * parent, GstBufferList * list);
 static gboolean gst_sctp_enc_sink_event (GstPad * pad, GstObject * parent,
     GstEvent * event);
 static gboolean gst_sctp_enc_src_event (GstPad * pad, GstObject * parent,
@@ -215,6 +219,23 @@ gst_sctp_enc_class_init (GstSctpEncClass * klass)
       "When TRUE the partial reliability parameters of the channel are ignored.",
       DEFAULT_USE_SOCK_STREAM, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+  /**
+   * GstSctpEnc:send-buffer-size:
+   *
+   * Size of the SCTP send buffer of the association in bytes. Once this much
+   * data is waiting to be acknowledged by the peer, the sink pads block until
+   * there is room again instead of dropping data.
+   *
+   * Since: 1.24
+   */
+  properties[PROP_SEND_BUFFER_SIZE] =
+      g_param_spec_uint ("send-buffer-size",
+      "Send buffer size",
+      "Size of the SCTP send buffer in bytes. Sending blocks once this much "
+      "data is waiting to be acknowledged by the peer.",
+      1, G_MAXINT, DEFAULT_SEND_BUFFER_SIZE,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
 
   signals[SIGNAL_SCTP_ASSOCIATION_ESTABLISHED] =
@@ -261,6 +282,7 @@ gst_sctp_enc_init (GstSctpEnc * self)
 {
   self->sctp_association_id = DEFAULT_GST_SCTP_ASSOCIATION_ID;
   self->remote_sctp_port = DEFAULT_REMOTE_SCTP_PORT;
+  self->send_buffer_size = DEFAULT_SEND_BUFFER_SIZE;
 
   self->sctp_association = NULL;
   self->outbound_sctp_packet_queue =
@@ -303,6 +325,9 @@ gst_sctp_enc_set_property (GObject * object, guint prop_id,
     case PROP_USE_SOCK_STREAM:
       self->use_sock_stream = g_value_get_boolean (value);
       break;
+    case PROP_SEND_BUFFER_SIZE:
+      self->send_buffer_size = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -325,6 +350,9 @@ gst_sctp_enc_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_USE_SOCK_STREAM:
       g_value_set_boolean (value, self->use_sock_stream);
       break;
+    case PROP_SEND_BUFFER_SIZE:
+      g_value_set_uint (value, self->send_buffer_size);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -429,6 +457,8 @@ gst_sctp_enc_request_new_pad (GstElement * element, GstPadTemplate * template,
       template->direction, "template", template, NULL);
   gst_pad_set_chain_function (new_pad,
       GST_DEBUG_FUNCPTR (gst_sctp_enc_sink_chain));
+  gst_pad_set_chain_list_function (new_pad,
+      GST_DEBUG_FUNCPTR (gst_sctp_enc_sink_chain_list));
   gst_pad_set_event_function (new_pad,
       GST_DEBUG_FUNCPTR (gst_sctp_enc_sink_event));
 
@@ -524,10 +554,31 @@ gst_sctp_enc_srcpad_loop (GstPad * pad)
   if (gst_data_queue_pop (self->outbound_sctp_packet_queue, &item)) {
     GstBuffer *buffer = GST_BUFFER (item->object);
 
-    GST_DEBUG_OBJECT (self, "Forwarding buffer %" GST_PTR_FORMAT, buffer);
-
-    flow_ret = gst_pad_push (self->src_pad, buffer);
     item->object = NULL;
+    item->destroy (item);
+
+    /* Forward everything that was queued up in the meantime, e.g. while
+     * usrsctp was sending a whole window, with a single push */
+    if (!gst_data_queue_is_empty (self->outbound_sctp_packet_queue)) {
+      GstBufferList *list = gst_buffer_list_new ();
+
+      gst_buffer_list_add (list, buffer);
+      while (!gst_data_queue_is_empty (self->outbound_sctp_packet_queue)
+          && gst_data_queue_pop (self->outbound_sctp_packet_queue, &item)) {
+        gst_buffer_list_add (list, GST_BUFFER (item->object));
+        item->object = NULL;
+        item->destroy (item);
+      }
+
+      GST_DEBUG_OBJECT (self, "Forwarding %u buffers",
+          gst_buffer_list_length (list));
+
+      flow_ret = gst_pad_push_list (self->src_pad, list);
+    } else {
+      GST_DEBUG_OBJECT (self, "Forwarding buffer %" GST_PTR_FORMAT, buffer);
+
+      flow_ret = gst_pad_push (self->src_pad, buffer);
+    }
 
     GST_OBJECT_LOCK (self);
     self->src_ret = flow_ret;
@@ -548,8 +599,6 @@ gst_sctp_enc_srcpad_loop (GstPad * pad)
       gst_data_queue_flush (self->outbound_sctp_packet_queue);
       gst_pad_pause_task (pad);
     }
-
-    item->destroy (item);
   } else {
     GST_OBJECT_LOCK (self);
     self->src_ret = GST_FLOW_FLUSHING;
@@ -560,12 +609,59 @@ gst_sctp_enc_srcpad_loop (GstPad * pad)
   }
 }
 
-static GstFlowReturn
-gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+/* Queues up @sctpenc_pad for sending and waits until all pads that were
+ * queued before are done. Returns with the pad lock held. */
+static void
+gst_sctp_enc_pad_acquire_turn (GstSctpEnc * self, GstSctpEncPad * sctpenc_pad)
+{
+  gboolean clear_to_send;
+
+  GST_OBJECT_LOCK (self);
+  clear_to_send = g_queue_is_empty (&self->pending_pads);
+  g_queue_push_tail (&self->pending_pads, sctpenc_pad);
+  GST_OBJECT_UNLOCK (self);
+
+  g_mutex_lock (&sctpenc_pad->lock);
+
+  if (clear_to_send) {
+    sctpenc_pad->clear_to_send = TRUE;
+  }
+
+  while (!sctpenc_pad->flushing && !sctpenc_pad->clear_to_send) {
+    g_cond_wait (&sctpenc_pad->cond, &sctpenc_pad->lock);
+  }
+}
+
+/* Releases the pad lock and lets the next queued pad send */
+static void
+gst_sctp_enc_pad_release_turn (GstSctpEnc * self, GstSctpEncPad * sctpenc_pad)
 {
-  GstSctpEnc *self = GST_SCTP_ENC (parent);
-  GstSctpEncPad *sctpenc_pad = GST_SCTP_ENC_PAD (pad);
   GstSctpEncPad *sctpenc_pad_next = NULL;
+
+  sctpenc_pad->clear_to_send = FALSE;
+  g_mutex_unlock (&sctpenc_pad->lock);
+
+  GST_OBJECT_LOCK (self);
+  g_queue_remove (&self->pending_pads, sctpenc_pad);
+  sctpenc_pad_next = g_queue_peek_head (&self->pending_pads);
+  GST_OBJECT_UNLOCK (self);
+
+  if (sctpenc_pad_next) {
+    g_mutex_lock (&sctpenc_pad_next->lock);
+    sctpenc_pad_next->clear_to_send = TRUE;
+    g_cond_signal (&sctpenc_pad_next->cond);
+    g_mutex_unlock (&sctpenc_pad_next->lock);
+  }
+}
+
+/* Sends @buffer as one message, blocking while the send buffer of the
+ * association is full. Must be called with the pad lock held and while it
+ * is the pad's turn. */
+static GstFlowReturn
+gst_sctp_enc_pad_send_buffer (GstSctpEnc * self, GstSctpEncPad * sctpenc_pad,
+    GstBuffer * buffer)
+{
+  GstPad *pad = GST_PAD (sctpenc_pad);
   GstMapInfo map;
   guint32 ppid;
   gboolean ordered;
@@ -577,18 +673,6 @@ gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
   GstFlowReturn flow_ret = GST_FLOW_ERROR;
   const guint8 *data;
   guint32 length;
-  gboolean clear_to_send;
-
-  GST_OBJECT_LOCK (self);
-  if (self->src_ret != GST_FLOW_OK) {
-    GST_ERROR_OBJECT (pad, "Pushing on source pad failed before: %s",
-        gst_flow_get_name (self->src_ret));
-    flow_ret = self->src_ret;
-    GST_OBJECT_UNLOCK (self);
-    gst_buffer_unref (buffer);
-    return flow_ret;
-  }
-  GST_OBJECT_UNLOCK (self);
 
   ppid = sctpenc_pad->ppid;
   ordered = sctpenc_pad->ordered;
@@ -627,27 +711,12 @@ gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
 
   if (!gst_buffer_map (buffer, &map, GST_MAP_READ)) {
     GST_ERROR_OBJECT (pad, "Could not map GstBuffer");
-    goto error;
+    return GST_FLOW_ERROR;
   }
 
   data = map.data;
   length = map.size;
 
-  GST_OBJECT_LOCK (self);
-  clear_to_send = g_queue_is_empty (&self->pending_pads);
-  g_queue_push_tail (&self->pending_pads, sctpenc_pad);
-  GST_OBJECT_UNLOCK (self);
-
-  g_mutex_lock (&sctpenc_pad->lock);
-
-  if (clear_to_send) {
-    sctpenc_pad->clear_to_send = TRUE;
-  }
-
-  while (!sctpenc_pad->flushing && !sctpenc_pad->clear_to_send) {
-    g_cond_wait (&sctpenc_pad->cond, &sctpenc_pad->lock);
-  }
-
   while (!sctpenc_pad->flushing) {
     guint32 bytes_sent;
 
@@ -687,27 +756,86 @@ gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
   flow_ret = sctpenc_pad->flushing ? GST_FLOW_FLUSHING : GST_FLOW_OK;
 
 out:
-  sctpenc_pad->clear_to_send = FALSE;
-  g_mutex_unlock (&sctpenc_pad->lock);
+  gst_buffer_unmap (buffer, &map);
+  return flow_ret;
+}
+
+static GstFlowReturn
+gst_sctp_enc_check_src_ret (GstSctpEnc * self, GstPad * pad)
+{
+  GstFlowReturn flow_ret;
 
   GST_OBJECT_LOCK (self);
-  g_queue_remove (&self->pending_pads, sctpenc_pad);
-  sctpenc_pad_next = g_queue_peek_head (&self->pending_pads);
+  flow_ret = self->src_ret;
+  if (flow_ret != GST_FLOW_OK) {
+    GST_ERROR_OBJECT (pad, "Pushing on source pad failed before: %s",
+        gst_flow_get_name (flow_ret));
+  }
   GST_OBJECT_UNLOCK (self);
 
-  if (sctpenc_pad_next) {
-    g_mutex_lock (&sctpenc_pad_next->lock);
-    sctpenc_pad_next->clear_to_send = TRUE;
-    g_cond_signal (&sctpenc_pad_next->cond);
-    g_mutex_unlock (&sctpenc_pad_next->lock);
+  return flow_ret;
+}
+
+static GstFlowReturn
+gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  GstSctpEnc *self = GST_SCTP_ENC (parent);
+  GstSctpEncPad *sctpenc_pad = GST_SCTP_ENC_PAD (pad);
+  GstFlowReturn flow_ret;
+
+  flow_ret = gst_sctp_enc_check_src_ret (self, pad);
+  if (flow_ret != GST_FLOW_OK) {
+    gst_buffer_unref (buffer);
+    return flow_ret;
   }
 
-  gst_buffer_unmap (buffer, &map);
-error:
+  gst_sctp_enc_pad_acquire_turn (self, sctpenc_pad);
+  flow_ret = gst_sctp_enc_pad_send_buffer (self, sctpenc_pad, buffer);
+  gst_sctp_enc_pad_release_turn (self, sctpenc_pad);
+
   gst_buffer_unref (buffer);
   return flow_ret;
 }
 
+/* Every buffer of the list is sent as a separate message, but the pad only
+ * has to wait for its turn once for the whole list */
+static GstFlowReturn
+gst_sctp_enc_sink_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  GstSctpEnc *self = GST_SCTP_ENC (parent);
+  GstSctpEncPad *sctpenc_pad = GST_SCTP_ENC_PAD (pad);
+  GstFlowReturn flow_ret;
+  guint i, len;
+
+  flow_ret = gst_sctp_enc_check_src_ret (self, pad);
+  if (flow_ret != GST_FLOW_OK) {
+    gst_buffer_list_unref (list);
+    return flow_ret;
+  }
+
+  GST_DEBUG_OBJECT (pad, "Sending list of %u buffers",
+      gst_buffer_list_length (list));
+
+  gst_sctp_enc_pad_acquire_turn (self, sctpenc_pad);
+  len = gst_buffer_list_length (list);
+  for (i = 0; i < len; i++) {
+    if (sctpenc_pad->flushing) {
+      flow_ret = GST_FLOW_FLUSHING;
+      break;
+    }
+
+    flow_ret = gst_sctp_enc_pad_send_buffer (self, sctpenc_pad,
+        gst_buffer_list_get (list, i));
+    if (flow_ret != GST_FLOW_OK)
+      break;
+  }
+  gst_sctp_enc_pad_release_turn (self, sctpenc_pad);
+
+  gst_buffer_list_unref (list);
+  return flow_ret;
+}
+
 static gboolean
 gst_sctp_enc_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
 {
@@ -857,6 +985,9 @@ configure_association (GstSctpEnc * self)
   g_object_bind_property (self, "use-sock-stream", self->sctp_association,
       "use-sock-stream", G_BINDING_SYNC_CREATE);
 
+  g_object_bind_property (self, "send-buffer-size", self->sctp_association,
+      "send-buffer-size", G_BINDING_SYNC_CREATE);
+
   gst_sctp_association_set_on_packet_out (self->sctp_association,
       on_sctp_packet_out, gst_object_ref (self), gst_object_unref);
 
@@ -51,6 +51,7 @@ struct _GstSctpEnc
   guint32 sctp_association_id;
   guint16 remote_sctp_port;
   gboolean use_sock_stream;
+  guint send_buffer_size;
 
   GstSctpAssociation *sctp_association;
   GstDataQueue *outbound_sctp_packet_queue;
@@ -85,6 +85,7 @@ enum
   PROP_REMOTE_PORT,
   PROP_STATE,
   PROP_USE_SOCK_STREAM,
+  PROP_SEND_BUFFER_SIZE,
 
   NUM_PROPERTIES
 };
@@ -96,6 +97,8 @@ static GParamSpec *properties[NUM_PROPERTIES];
 #define DEFAULT_NUMBER_OF_SCTP_STREAMS 1024
 #define DEFAULT_LOCAL_SCTP_PORT 0
 #define DEFAULT_REMOTE_SCTP_PORT 0
+#define DEFAULT_SEND_BUFFER_SIZE (1024 * 1024)
+#define RECEIVE_BUFFER_SIZE (1024 * 1024)
 
 static GHashTable *associations = NULL;
 G_LOCK_DEFINE_STATIC (associations_lock);
@@ -109,7 +112,8 @@ static void gst_sctp_association_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 
 static struct socket *create_sctp_socket (GstSctpAssociation *
-    gst_sctp_association);
+    gst_sctp_association, guint send_buffer_size);
+static void update_send_buffer_size (GstSctpAssociation * self);
 static struct sockaddr_conn get_sctp_socket_address (GstSctpAssociation *
     gst_sctp_association, guint16 port);
 static gboolean client_role_connect (GstSctpAssociation * self);
@@ -171,6 +175,12 @@ gst_sctp_association_class_init (GstSctpAssociationClass * klass)
       "When TRUE the partial reliability parameters of the channel is ignored.",
       FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+  properties[PROP_SEND_BUFFER_SIZE] =
+      g_param_spec_uint ("send-buffer-size", "Send buffer size",
+      "Size of the SCTP send buffer in bytes. Sending blocks once this much "
+      "data is waiting to be acknowledged by the peer.", 1, G_MAXINT,
+      DEFAULT_SEND_BUFFER_SIZE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (gobject_class, NUM_PROPERTIES, properties);
 }
 
@@ -235,6 +245,7 @@ gst_sctp_association_init (GstSctpAssociation * self)
   self->state = GST_SCTP_ASSOCIATION_STATE_NEW;
 
   self->use_sock_stream = TRUE;
+  self->send_buffer_size = DEFAULT_SEND_BUFFER_SIZE;
 
   usrsctp_register_address ((void *) self);
 }
@@ -290,6 +301,11 @@ gst_sctp_association_set_property (GObject * object, guint prop_id,
     case PROP_USE_SOCK_STREAM:
       self->use_sock_stream = g_value_get_boolean (value);
       break;
+    case PROP_SEND_BUFFER_SIZE:
+      self->send_buffer_size = g_value_get_uint (value);
+      if (self->sctp_ass_sock)
+        update_send_buffer_size (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -347,6 +363,9 @@ gst_sctp_association_get_property (GObject * object, guint prop_id,
     case PROP_USE_SOCK_STREAM:
       g_value_set_boolean (value, self->use_sock_stream);
       break;
+    case PROP_SEND_BUFFER_SIZE:
+      g_value_set_uint (value, self->send_buffer_size);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -389,15 +408,29 @@ gst_sctp_association_get (guint32 association_id)
 gboolean
 gst_sctp_association_start (GstSctpAssociation * self)
 {
+  struct socket *sock;
+  guint send_buffer_size;
+
   if (self->state != GST_SCTP_ASSOCIATION_STATE_READY) {
     GST_WARNING_OBJECT (self,
         "SCTP association is in wrong state and cannot be started");
     goto configure_required;
   }
 
-  if ((self->sctp_ass_sock = create_sctp_socket (self)) == NULL)
+  g_mutex_lock (&self->association_mutex);
+  send_buffer_size = self->send_buffer_size;
+  g_mutex_unlock (&self->association_mutex);
+
+  if ((sock = create_sctp_socket (self, send_buffer_size)) == NULL)
     goto error;
 
+  g_mutex_lock (&self->association_mutex);
+  self->sctp_ass_sock = sock;
+  /* the property might have changed while the socket was created */
+  if (self->send_buffer_size != send_buffer_size)
+    update_send_buffer_size (self);
+  g_mutex_unlock (&self->association_mutex);
+
   /* TODO: Support both server and client role */
   if (!client_role_connect (self)) {
     gst_sctp_association_change_state (self, GST_SCTP_ASSOCIATION_STATE_ERROR,
@@ -560,24 +593,42 @@ gst_sctp_association_reset_stream (GstSctpAssociation * self, guint16 stream_id)
 void
 gst_sctp_association_force_close (GstSctpAssociation * self)
 {
-  if (self->sctp_ass_sock) {
-    struct socket *s = self->sctp_ass_sock;
-    self->sctp_ass_sock = NULL;
+  struct socket *s;
+
+  g_mutex_lock (&self->association_mutex);
+  s = self->sctp_ass_sock;
+  self->sctp_ass_sock = NULL;
+  g_mutex_unlock (&self->association_mutex);
+
+  if (s)
     usrsctp_close (s);
-  }
 
   gst_sctp_association_change_state (self,
       GST_SCTP_ASSOCIATION_STATE_DISCONNECTED, TRUE);
 }
 
+/* must be called with the association mutex held */
+static void
+update_send_buffer_size (GstSctpAssociation * self)
+{
+  int buf_size = self->send_buffer_size;
+
+  if (usrsctp_setsockopt (self->sctp_ass_sock, SOL_SOCKET, SO_SNDBUF,
+          (const void *) &buf_size, sizeof (buf_size)) < 0) {
+    GST_WARNING_OBJECT (self, "Could not change send buffer size: (%u) %s",
+        errno, g_strerror (errno));
+  }
+}
+
 static struct socket *
-create_sctp_socket (GstSctpAssociation * self)
+create_sctp_socket (GstSctpAssociation * self, guint send_buffer_size)
 {
   struct socket *sock;
   struct linger l;
   struct sctp_event event;
   struct sctp_assoc_value stream_reset;
-  int buf_size = 1024 * 1024;
+  int rcv_buf_size = RECEIVE_BUFFER_SIZE;
+  int snd_buf_size = send_buffer_size;
   int value = 1;
   guint16 event_types[] = {
     SCTP_ASSOC_CHANGE,
@@ -607,13 +658,13 @@ create_sctp_socket (GstSctpAssociation * self)
   }
 
   if (usrsctp_setsockopt (sock, SOL_SOCKET, SO_RCVBUF,
-          (const void *) &buf_size, sizeof (buf_size)) < 0) {
+          (const void *) &rcv_buf_size, sizeof (rcv_buf_size)) < 0) {
     GST_ERROR_OBJECT (self, "Could not change receive buffer size: (%u) %s",
         errno, g_strerror (errno));
     goto error;
   }
   if (usrsctp_setsockopt (sock, SOL_SOCKET, SO_SNDBUF,
-          (const void *) &buf_size, sizeof (buf_size)) < 0) {
+          (const void *) &snd_buf_size, sizeof (snd_buf_size)) < 0) {
     GST_ERROR_OBJECT (self, "Could not change send buffer size: (%u) %s",
         errno, g_strerror (errno));
     goto error;
@@ -70,15 +70,31 @@ enum
   PROP_STREAMID,
   PROP_AUTHENTICATION,
   PROP_AUTO_RECONNECT,
+  PROP_MAX_CALLER_QUEUE_BYTES,
   PROP_LAST
 };
 
+/* Number of connections the listener of a sink queues up before accepting
+ * them, so that many callers can connect at once */
+#define SINK_LISTEN_BACKLOG 128
+
+/* Number of sockets handled per wakeup of the listener thread */
+#define LISTENER_MAX_EVENTS 64
+
 typedef struct
 {
   SRTSOCKET sock;
   gint poll_id;
   GSocketAddress *sockaddr;
   gboolean sent_headers;
+
+  /* Sink only: buffers that did not fit into the send buffer of the socket
+   * yet and the offset of the unsent data in the first one. They are sent
+   * from the listener thread once the socket becomes writable again. */
+  GQueue queue;
+  gsize queue_offset;
+  gsize queued_bytes;
+  gboolean waiting_for_room;
 } SRTCaller;
 
 static SRTCaller *
@@ -88,6 +104,7 @@ srt_caller_new (void)
   caller->sock = SRT_INVALID_SOCK;
   caller->poll_id = SRT_ERROR;
   caller->sent_headers = FALSE;
+  g_queue_init (&caller->queue);
 
   return caller;
 }
@@ -98,6 +115,7 @@ srt_caller_free (SRTCaller * caller)
   g_return_if_fail (caller != NULL);
 
   g_clear_object (&caller->sockaddr);
+  g_queue_clear_full (&caller->queue, (GDestroyNotify) gst_buffer_unref);
 
   if (caller->sock != SRT_INVALID_SOCK) {
     srt_close (caller->sock);
@@ -355,6 +373,7 @@ gst_srt_object_new (GstElement * element)
   srtobject->sent_headers = FALSE;
   srtobject->wait_for_connection = GST_SRT_DEFAULT_WAIT_FOR_CONNECTION;
   srtobject->auto_reconnect = GST_SRT_DEFAULT_AUTO_RECONNECT;
+  srtobject->max_caller_queue_bytes = GST_SRT_DEFAULT_MAX_CALLER_QUEUE_BYTES;
 
   g_cond_init (&srtobject->sock_cond);
   return srtobject;
@@ -429,6 +448,9 @@ gst_srt_object_set_property_helper (GstSRTObject * srtobject,
     case PROP_AUTO_RECONNECT:
       srtobject->auto_reconnect = g_value_get_boolean (value);
       break;
+    case PROP_MAX_CALLER_QUEUE_BYTES:
+      srtobject->max_caller_queue_bytes = g_value_get_uint (value);
+      break;
     default:
       goto err;
   }
@@ -540,6 +562,11 @@ gst_srt_object_get_property_helper (GstSRTObject * srtobject,
       g_value_set_boolean (value, srtobject->auto_reconnect);
       GST_OBJECT_UNLOCK (srtobject->element);
       break;
+    case PROP_MAX_CALLER_QUEUE_BYTES:
+      GST_OBJECT_LOCK (srtobject->element);
+      g_value_set_uint (value, srtobject->max_caller_queue_bytes);
+      GST_OBJECT_UNLOCK (srtobject->element);
+      break;
     default:
       return FALSE;
   }
@@ -716,6 +743,25 @@ gst_srt_object_install_properties_helper (GObjectClass * gobject_class)
           "Automatically reconnect when connection fails",
           GST_SRT_DEFAULT_AUTO_RECONNECT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstSRTSink:max-caller-queue-bytes:
+   *
+   * In listener mode, data that does not fit into the send buffer of a
+   * caller is queued up for that caller. A caller that falls more than
+   * this many bytes behind is considered dead and dropped. Pick it
+   * according to the bitrate of the stream and how long callers may stall,
+   * e.g. 16 MiB are about 27 seconds of a 5 Mbit/s stream.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_CALLER_QUEUE_BYTES,
+      g_param_spec_uint ("max-caller-queue-bytes",
+          "Maximum caller queue bytes",
+          "Bytes that may be queued up for a caller before it is dropped "
+          "(0 = unlimited)", 0, G_MAXUINT,
+          GST_SRT_DEFAULT_MAX_CALLER_QUEUE_BYTES,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -920,10 +966,109 @@ gst_srt_object_set_uri (GstSRTObject * srtobject, const gchar * uri,
   return TRUE;
 }
 
-static gpointer
-thread_func (gpointer data)
+/* called with sock_lock */
+static GList *
+gst_srt_object_find_caller (GstSRTObject * srtobject, SRTSOCKET sock)
+{
+  GList *item;
+
+  for (item = srtobject->callers; item; item = item->next) {
+    SRTCaller *caller = item->data;
+
+    if (caller->sock == sock)
+      return item;
+  }
+
+  return NULL;
+}
+
+/* called with sock_lock */
+static void
+gst_srt_object_remove_caller (GstSRTObject * srtobject, GList * item)
+{
+  SRTCaller *caller = item->data;
+
+  srtobject->callers = g_list_delete_link (srtobject->callers, item);
+  srt_caller_signal_removed (caller, srtobject);
+  srt_caller_free (caller);
+}
+
+/* Sends as much of the queued data of @caller as fits into the send buffer
+ * of its socket. If something is left, the listener thread is asked to
+ * continue once the socket is writable again. Called with sock_lock. */
+static gboolean
+srt_caller_send_queued (SRTCaller * caller, GstSRTObject * srtobject)
+{
+  GstBuffer *buffer;
+  gint payload_size, optlen = sizeof (payload_size);
+  gboolean waiting_for_room = FALSE;
+
+  if (srt_getsockflag (caller->sock, SRTO_PAYLOADSIZE, &payload_size,
+          &optlen)) {
+    GST_WARNING_OBJECT (srtobject->element, "%s", srt_getlasterror_str ());
+    return FALSE;
+  }
+
+  while (!waiting_for_room && (buffer = g_queue_peek_head (&caller->queue))) {
+    GstMapInfo mapinfo;
+
+    if (!gst_buffer_map (buffer, &mapinfo, GST_MAP_READ)) {
+      GST_WARNING_OBJECT (srtobject->element, "Failed to map buffer");
+      return FALSE;
+    }
+
+    while (caller->queue_offset < mapinfo.size) {
+      gint rest = MIN (mapinfo.size - caller->queue_offset, payload_size);
+      gint sent;
+
+      sent = srt_sendmsg2 (caller->sock,
+          (char *) (mapinfo.data + caller->queue_offset), rest, 0);
+      if (sent < 0) {
+        if (srt_getlasterror (NULL) == SRT_EASYNCSND) {
+          waiting_for_room = TRUE;
+          break;
+        }
+
+        GST_WARNING_OBJECT (srtobject->element, "Dropping caller %d: %s",
+            caller->sock, srt_getlasterror_str ());
+        gst_buffer_unmap (buffer, &mapinfo);
+        return FALSE;
+      }
+      caller->queue_offset += sent;
+      caller->queued_bytes -= sent;
+      srtobject->bytes += sent;
+    }
+
+    gst_buffer_unmap (buffer, &mapinfo);
+
+    if (!waiting_for_room) {
+      gst_buffer_unref (g_queue_pop_head (&caller->queue));
+      caller->queue_offset = 0;
+    }
+  }
+
+  if (waiting_for_room != caller->waiting_for_room) {
+    gint flags = SRT_EPOLL_ERR | (waiting_for_room ? SRT_EPOLL_OUT : 0);
+
+    GST_LOG_OBJECT (srtobject->element, "Caller %d %s", caller->sock,
+        waiting_for_room ? "is full, queueing" : "caught up");
+
+    if (srt_epoll_update_usock (srtobject->listener_poll_id, caller->sock,
+            &flags)) {
+      GST_WARNING_OBJECT (srtobject->element, "%s", srt_getlasterror_str ());
+      return FALSE;
+    }
+    caller->waiting_for_room = waiting_for_room;
+  }
+
+  return TRUE;
+}
+
+/* Accepts a pending connection on the listener socket. Returns TRUE if a
+ * new caller was added. */
+static gboolean
+gst_srt_object_accept (GstSRTObject * srtobject)
 {
-  GstSRTObject *srtobject = data;
   SRTSOCKET caller_sock;
   union
   {
@@ -931,13 +1076,79 @@ thread_func (gpointer data)
     struct sockaddr sa;
   } caller_sa;
   int caller_sa_len = sizeof (caller_sa);
+  SRTCaller *caller;
+  GSocketAddress *sockaddr;
+  gint flag = SRT_EPOLL_ERR;
 
-  gint poll_timeout;
+  caller_sock =
+      srt_accept (srtobject->listener_sock, &caller_sa.sa, &caller_sa_len);
 
-  SRTSOCKET rsock;
-  gint rsocklen = 1;
+  if (caller_sock == SRT_INVALID_SOCK)
+    return FALSE;
+
+  caller = srt_caller_new ();
+  caller->sockaddr =
+      g_socket_address_new_from_native (&caller_sa.sa, caller_sa_len);
+  caller->sock = caller_sock;
+
+  g_mutex_lock (&srtobject->sock_lock);
+
+  if (gst_uri_handler_get_uri_type (GST_URI_HANDLER
+          (srtobject->element)) == GST_URI_SRC) {
+    flag |= SRT_EPOLL_IN;
+    caller->poll_id = srt_epoll_create ();
+
+    if (srt_epoll_add_usock (caller->poll_id, caller_sock, &flag))
+      goto add_failed;
+  } else {
+    /* Callers of a sink are all watched by the listener thread, which only
+     * needs to know about errors and, while data is queued up, when there
+     * is room to send it */
+    if (srt_epoll_add_usock (srtobject->listener_poll_id, caller_sock, &flag))
+      goto add_failed;
+  }
+
+  GST_DEBUG_OBJECT (srtobject->element, "Accept to connect %d", caller->sock);
+
+  /* the caller might already be gone again when the signal is emitted */
+  sockaddr = g_object_ref (caller->sockaddr);
+
+  srtobject->callers = g_list_prepend (srtobject->callers, caller);
+  g_cond_signal (&srtobject->sock_cond);
+  g_mutex_unlock (&srtobject->sock_lock);
+
+  /* notifying caller-added */
+  g_signal_emit_by_name (srtobject->element, "caller-added", 0, sockaddr);
+  g_object_unref (sockaddr);
+
+  return TRUE;
+
+add_failed:
+  g_mutex_unlock (&srtobject->sock_lock);
+
+  GST_ELEMENT_ERROR (srtobject->element, RESOURCE, SETTINGS,
+      ("%s", srt_getlasterror_str ()), (NULL));
+
+  srt_caller_free (caller);
+  return FALSE;
+}
+
+static gpointer
+thread_func (gpointer data)
+{
+  GstSRTObject *srtobject = data;
+  gboolean is_src = gst_uri_handler_get_uri_type (GST_URI_HANDLER
+      (srtobject->element)) == GST_URI_SRC;
+  SRTSOCKET rsocks[LISTENER_MAX_EVENTS];
+  SRTSOCKET wsocks[LISTENER_MAX_EVENTS];
+
+  gint poll_timeout;
 
   for (;;) {
+    gint rsocklen = G_N_ELEMENTS (rsocks);
+    gint wsocklen = G_N_ELEMENTS (wsocks);
+    gint i;
+
     GST_OBJECT_LOCK (srtobject->element);
     if (!gst_structure_get_int (srtobject->parameters, "poll-timeout",
             &poll_timeout)) {
@@ -947,8 +1158,8 @@ thread_func (gpointer data)
 
     GST_DEBUG_OBJECT (srtobject->element, "Waiting a request from caller");
 
-    if (srt_epoll_wait (srtobject->listener_poll_id, &rsock, &rsocklen, 0, 0,
-            poll_timeout, NULL, 0, NULL, 0) < 0) {
+    if (srt_epoll_wait (srtobject->listener_poll_id, rsocks, &rsocklen,
+            wsocks, &wsocklen, poll_timeout, NULL, 0, NULL, 0) < 0) {
       gint srt_errno = srt_getlasterror (NULL);
 
       if (srtobject->listener_poll_id == SRT_ERROR)
@@ -962,52 +1173,35 @@ thread_func (gpointer data)
       return NULL;
     }
 
-    caller_sock =
-        srt_accept (srtobject->listener_sock, &caller_sa.sa, &caller_sa_len);
-
-    if (caller_sock != SRT_INVALID_SOCK) {
-      SRTCaller *caller;
-      gint flag = SRT_EPOLL_ERR;
-
-      caller = srt_caller_new ();
-      caller->sockaddr =
-          g_socket_address_new_from_native (&caller_sa.sa, caller_sa_len);
-      caller->poll_id = srt_epoll_create ();
-      caller->sock = caller_sock;
-
-      if (gst_uri_handler_get_uri_type (GST_URI_HANDLER
-              (srtobject->element)) == GST_URI_SRC) {
-        flag |= SRT_EPOLL_IN;
-      } else {
-        flag |= SRT_EPOLL_OUT;
-      }
-
-      if (srt_epoll_add_usock (caller->poll_id, caller_sock, &flag)) {
-
-        GST_ELEMENT_ERROR (srtobject->element, RESOURCE, SETTINGS,
-            ("%s", srt_getlasterror_str ()), (NULL));
+    for (i = 0; i < rsocklen; i++) {
+      GList *item;
 
-        srt_caller_free (caller);
-
-        /* try-again */
+      if (rsocks[i] == srtobject->listener_sock) {
+        if (gst_srt_object_accept (srtobject) && is_src)
+          return NULL;
         continue;
       }
 
-      GST_DEBUG_OBJECT (srtobject->element, "Accept to connect %d",
-          caller->sock);
-
+      /* Callers of a sink are not watched for input, so they are only
+       * reported here when their connection broke */
       g_mutex_lock (&srtobject->sock_lock);
-      srtobject->callers = g_list_prepend (srtobject->callers, caller);
-      g_cond_signal (&srtobject->sock_cond);
+      item = gst_srt_object_find_caller (srtobject, rsocks[i]);
+      if (item) {
+        GST_DEBUG_OBJECT (srtobject->element, "Caller %d disconnected",
+            rsocks[i]);
+        gst_srt_object_remove_caller (srtobject, item);
+      }
       g_mutex_unlock (&srtobject->sock_lock);
+    }
 
-      /* notifying caller-added */
-      g_signal_emit_by_name (srtobject->element, "caller-added", 0,
-          caller->sockaddr);
+    for (i = 0; i < wsocklen; i++) {
+      GList *item;
 
-      if (gst_uri_handler_get_uri_type (GST_URI_HANDLER (srtobject->element)) ==
-          GST_URI_SRC)
-        return NULL;
+      g_mutex_lock (&srtobject->sock_lock);
+      item = gst_srt_object_find_caller (srtobject, wsocks[i]);
+      if (item && !srt_caller_send_queued (item->data, srtobject))
+        gst_srt_object_remove_caller (srtobject, item);
+      g_mutex_unlock (&srtobject->sock_lock);
     }
   }
 }
@@ -1076,6 +1270,7 @@ gst_srt_object_wait_connect (GstSRTObject * srtobject,
   const gchar *local_address = NULL;
   guint local_port = 0;
   gint sock_flags = SRT_EPOLL_ERR | SRT_EPOLL_IN;
+  gint backlog = 1;
 
   gpointer bind_sa;
   gsize bind_sa_len;
@@ -1135,8 +1330,13 @@ gst_srt_object_wait_connect (GstSRTObject * srtobject,
     goto failed;
   }
 
+  /* A source only ever serves one caller */
+  if (gst_uri_handler_get_uri_type (GST_URI_HANDLER (srtobject->element)) ==
+      GST_URI_SINK)
+    backlog = SINK_LISTEN_BACKLOG;
+
   GST_DEBUG_OBJECT (srtobject->element, "Starting to listen on bind socket");
-  if (srt_listen (sock, 1) == SRT_ERROR) {
+  if (srt_listen (sock, backlog) == SRT_ERROR) {
     g_set_error (error, GST_RESOURCE_ERROR,
         GST_RESOURCE_ERROR_OPEN_READ_WRITE, "Cannot listen on bind socket: %s",
         srt_getlasterror_str ());
@@ -1696,20 +1896,25 @@ gst_srt_object_send_headers (GstSRTObject * srtobject, SRTSOCKET sock,
   return TRUE;
 }
 
+/* Queues @buffer for all callers and sends as much of it right away as
+ * fits into their send buffers. Callers that cannot take it immediately do
+ * not hold up the others, their queue is emptied from the listener thread.
+ * All callers share the same buffer. */
 static gssize
 gst_srt_object_write_to_callers (GstSRTObject * srtobject,
-    GstBufferList * headers,
-    const GstMapInfo * mapinfo, GCancellable * cancellable)
+    GstBufferList * headers, GstBuffer * buffer, GCancellable * cancellable)
 {
   GList *item, *next;
+  gsize size = gst_buffer_get_size (buffer);
+  guint max_queue_bytes;
+
+  GST_OBJECT_LOCK (srtobject->element);
+  max_queue_bytes = srtobject->max_caller_queue_bytes;
+  GST_OBJECT_UNLOCK (srtobject->element);
 
   g_mutex_lock (&srtobject->sock_lock);
   for (item = srtobject->callers, next = NULL; item; item = next) {
     SRTCaller *caller = item->data;
-    gssize len = 0;
-    const guint8 *msg = mapinfo->data;
-    gint sent;
-    gint payload_size, optlen = sizeof (payload_size);
 
     next = item->next;
 
@@ -1718,48 +1923,46 @@ gst_srt_object_write_to_callers (GstSRTObject * srtobject,
     }
 
     if (!caller->sent_headers) {
-      GError *error = NULL;
-
-      if (!gst_srt_object_send_headers (srtobject, caller->sock, -1, 0,
-              headers, cancellable, &error)) {
-        GST_WARNING_OBJECT (srtobject->element,
-            "Failed to send headers to caller %d: %s",
-            caller->sock, error->message);
-        g_error_free (error);
-        goto err;
+      if (headers) {
+        guint i, n_headers = gst_buffer_list_length (headers);
+
+        GST_DEBUG_OBJECT (srtobject->element,
+            "Queueing %u stream headers for caller %d", n_headers,
+            caller->sock);
+
+        for (i = 0; i < n_headers; i++) {
+          GstBuffer *header = gst_buffer_list_get (headers, i);
+
+          g_queue_push_tail (&caller->queue, gst_buffer_ref (header));
+          caller->queued_bytes += gst_buffer_get_size (header);
+        }
       }
 
       caller->sent_headers = TRUE;
     }
 
-    if (srt_getsockflag (caller->sock, SRTO_PAYLOADSIZE, &payload_size,
-            &optlen)) {
-      GST_WARNING_OBJECT (srtobject->element, "%s", srt_getlasterror_str ());
+    if (max_queue_bytes > 0 && caller->queued_bytes + size > max_queue_bytes) {
+      GST_WARNING_OBJECT (srtobject->element,
+          "Dropping caller %d: more than %u bytes queued up", caller->sock,
+          max_queue_bytes);
       goto err;
     }
 
-    while (len < mapinfo->size) {
-      gint rest = MIN (mapinfo->size - len, payload_size);
-      sent = srt_sendmsg2 (caller->sock, (char *) (msg + len), rest, 0);
-      if (sent < 0) {
-        GST_WARNING_OBJECT (srtobject->element, "Dropping caller %d: %s",
-            caller->sock, srt_getlasterror_str ());
-        goto err;
-      }
-      len += sent;
-      srtobject->bytes += sent;
-    }
+    g_queue_push_tail (&caller->queue, gst_buffer_ref (buffer));
+    caller->queued_bytes += size;
+
+    if (!caller->waiting_for_room && !srt_caller_send_queued (caller,
+            srtobject))
+      goto err;
 
     continue;
 
   err:
-    srtobject->callers = g_list_delete_link (srtobject->callers, item);
-    srt_caller_signal_removed (caller, srtobject);
-    srt_caller_free (caller);
+    gst_srt_object_remove_caller (srtobject, item);
   }
 
   g_mutex_unlock (&srtobject->sock_lock);
-  return mapinfo->size;
+  return size;
 
 cancelled:
   g_mutex_unlock (&srtobject->sock_lock);
@@ -1891,7 +2094,7 @@ gst_srt_object_write_one (GstSRTObject * srtobject,
 gssize
 gst_srt_object_write (GstSRTObject * srtobject,
     GstBufferList * headers,
-    const GstMapInfo * mapinfo, GCancellable * cancellable, GError ** error)
+    GstBuffer * buffer, GCancellable * cancellable, GError ** error)
 {
   gssize len = 0;
   GstSRTConnectionMode connection_mode = GST_SRT_CONNECTION_MODE_NONE;
@@ -1913,12 +2116,22 @@ gst_srt_object_write (GstSRTObject * srtobject,
         return 0;
     }
     len =
-        gst_srt_object_write_to_callers (srtobject, headers, mapinfo,
+        gst_srt_object_write_to_callers (srtobject, headers, buffer,
         cancellable);
   } else {
+    GstMapInfo mapinfo;
+
+    if (!gst_buffer_map (buffer, &mapinfo, GST_MAP_READ)) {
+      g_set_error (error, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_READ,
+          "Could not map the input stream");
+      return -1;
+    }
+
     len =
-        gst_srt_object_write_one (srtobject, headers, mapinfo, cancellable,
+        gst_srt_object_write_one (srtobject, headers, &mapinfo, cancellable,
         error);
+
+    gst_buffer_unmap (buffer, &mapinfo);
   }
 
   return len;
@@ -2014,14 +2227,17 @@ gst_srt_object_get_stats (GstSRTObject * srtobject)
 
       tmp = get_stats_for_srtsock (srtobject, caller->sock);
       if (tmp == NULL) {
-        srtobject->callers = g_list_delete_link (srtobject->callers, item);
-        srt_caller_signal_removed (caller, srtobject);
-        srt_caller_free (caller);
+        gst_srt_object_remove_caller (srtobject, item);
         continue;
       }
 
       gst_structure_set (tmp, "caller-address", G_TYPE_SOCKET_ADDRESS,
           caller->sockaddr, NULL);
+      if (is_sender) {
+        /* data waiting for room in the send buffer of the caller */
+        gst_structure_set (tmp, "bytes-queued", G_TYPE_UINT64,
+            (guint64) caller->queued_bytes, NULL);
+      }
 
       g_value_array_append (callers_stats, NULL);
       v = g_value_array_get_nth (callers_stats, callers_stats->n_values - 1);
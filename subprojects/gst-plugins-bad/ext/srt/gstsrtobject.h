@@ -43,6 +43,7 @@ G_BEGIN_DECLS
 #define GST_SRT_DEFAULT_MSG_SIZE 1316
 #define GST_SRT_DEFAULT_WAIT_FOR_CONNECTION (TRUE)
 #define GST_SRT_DEFAULT_AUTO_RECONNECT (TRUE)
+#define GST_SRT_DEFAULT_MAX_CALLER_QUEUE_BYTES (16 * 1024 * 1024)
 
 typedef struct _GstSRTObject GstSRTObject;
 
@@ -71,6 +72,7 @@ struct _GstSRTObject
 
   gboolean                     wait_for_connection;
   gboolean                     auto_reconnect;
+  guint                        max_caller_queue_bytes;
 
   gboolean                     authentication;
 
@@ -107,7 +109,7 @@ gssize          gst_srt_object_read     (GstSRTObject * srtobject,
 
 gssize          gst_srt_object_write    (GstSRTObject * srtobject,
                                          GstBufferList * headers,
-                                         const GstMapInfo * mapinfo,
+                                         GstBuffer * buffer,
                                          GCancellable *cancellable,
                                          GError **err);
 
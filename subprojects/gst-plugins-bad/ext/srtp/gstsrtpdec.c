@@ -211,6 +211,10 @@ static GstFlowReturn gst_srtp_dec_chain_rtp (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
 static GstFlowReturn gst_srtp_dec_chain_rtcp (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
+static GstFlowReturn gst_srtp_dec_chain_list_rtp (GstPad * pad,
+    GstObject * parent, GstBufferList * buf_list);
+static GstFlowReturn gst_srtp_dec_chain_list_rtcp (GstPad * pad,
+    GstObject * parent, GstBufferList * buf_list);
 
 static GstStateChangeReturn gst_srtp_dec_change_state (GstElement * element,
     GstStateChange transition);
@@ -385,6 +389,8 @@ gst_srtp_dec_init (GstSrtpDec * filter)
       GST_DEBUG_FUNCPTR (gst_srtp_dec_iterate_internal_links_rtp));
   gst_pad_set_chain_function (filter->rtp_sinkpad,
       GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_rtp));
+  gst_pad_set_chain_list_function (filter->rtp_sinkpad,
+      GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_list_rtp));
 
   filter->rtp_srcpad =
       gst_pad_new_from_static_template (&rtp_src_template, "rtp_src");
@@ -408,6 +414,8 @@ gst_srtp_dec_init (GstSrtpDec * filter)
       GST_DEBUG_FUNCPTR (gst_srtp_dec_iterate_internal_links_rtcp));
   gst_pad_set_chain_function (filter->rtcp_sinkpad,
       GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_rtcp));
+  gst_pad_set_chain_list_function (filter->rtcp_sinkpad,
+      GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_list_rtcp));
 
   filter->rtcp_srcpad =
       gst_pad_new_from_static_template (&rtcp_src_template, "rtcp_src");
@@ -1460,6 +1468,24 @@ err:
   return FALSE;
 }
 
+/* Returns the source pad for RTP or RTCP, after pushing the events that
+ * have to come first on it */
+static GstPad *
+gst_srtp_dec_get_src_pad (GstSrtpDec * filter, gboolean is_rtcp)
+{
+  if (is_rtcp) {
+    if (!filter->rtcp_has_segment)
+      gst_srtp_dec_push_early_events (filter, filter->rtcp_srcpad,
+          filter->rtp_srcpad, TRUE);
+    return filter->rtcp_srcpad;
+  } else {
+    if (!filter->rtp_has_segment)
+      gst_srtp_dec_push_early_events (filter, filter->rtp_srcpad,
+          filter->rtcp_srcpad, FALSE);
+    return filter->rtp_srcpad;
+  }
+}
+
 static GstFlowReturn
 gst_srtp_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
     gboolean is_rtcp)
@@ -1498,17 +1524,7 @@ gst_srtp_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
 
 push_out:
   /* Push buffer to source pad */
-  if (is_rtcp) {
-    otherpad = filter->rtcp_srcpad;
-    if (!filter->rtcp_has_segment)
-      gst_srtp_dec_push_early_events (filter, filter->rtcp_srcpad,
-          filter->rtp_srcpad, TRUE);
-  } else {
-    otherpad = filter->rtp_srcpad;
-    if (!filter->rtp_has_segment)
-      gst_srtp_dec_push_early_events (filter, filter->rtp_srcpad,
-          filter->rtcp_srcpad, FALSE);
-  }
+  otherpad = gst_srtp_dec_get_src_pad (filter, is_rtcp);
   ret = gst_pad_push (otherpad, buf);
 
   return ret;
@@ -1521,6 +1537,112 @@ drop_buffer:
   return ret;
 }
 
+typedef struct
+{
+  GstSrtpDec *filter;
+  GstPad *pad;
+  gboolean is_rtcp;
+  /* length of the input list, nearly all of them are usually RTP */
+  guint n_buffers;
+  GstBufferList *rtp_list;
+  GstBufferList *rtcp_list;
+} DecodeBufferItData;
+
+/*
+ * This function should be called while holding the filter lock
+ */
+static gboolean
+decode_buffer_it (GstBuffer ** buffer, guint index, gpointer user_data)
+{
+  DecodeBufferItData *data = user_data;
+  GstSrtpDec *filter = data->filter;
+  GstSrtpDecSsrcStream *stream;
+  gboolean is_rtcp = data->is_rtcp;
+  guint32 ssrc = 0;
+  GstBuffer *buf;
+
+  /* take the buffer out of the list, it is decoded in place */
+  buf = *buffer;
+  *buffer = NULL;
+
+  if (!(stream = validate_buffer (filter, buf, &ssrc, &is_rtcp))) {
+    GST_WARNING_OBJECT (filter, "Invalid buffer, dropping");
+    gst_buffer_unref (buf);
+    return TRUE;
+  }
+
+  if (STREAM_HAS_CRYPTO (stream)) {
+    buf = gst_buffer_make_writable (buf);
+
+    if (!gst_srtp_dec_decode_buffer (filter, data->pad, buf, is_rtcp, ssrc)) {
+      gst_buffer_unref (buf);
+      return TRUE;
+    }
+
+    if (gst_srtp_get_soft_limit_reached ()) {
+      GST_OBJECT_UNLOCK (filter);
+      request_key_with_signal (filter, ssrc, SIGNAL_SOFT_LIMIT);
+      GST_OBJECT_LOCK (filter);
+    }
+  }
+
+  if (is_rtcp) {
+    if (!data->rtcp_list)
+      data->rtcp_list = gst_buffer_list_new ();
+    gst_buffer_list_add (data->rtcp_list, buf);
+  } else {
+    if (!data->rtp_list)
+      data->rtp_list = gst_buffer_list_new_sized (data->n_buffers);
+    gst_buffer_list_add (data->rtp_list, buf);
+  }
+
+  return TRUE;
+}
+
+/* Decodes the whole list with a single take of the filter lock and pushes
+ * the decoded packets on as one list per source pad */
+static GstFlowReturn
+gst_srtp_dec_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list, gboolean is_rtcp)
+{
+  GstSrtpDec *filter = GST_SRTP_DEC (parent);
+  GstFlowReturn ret = GST_FLOW_OK;
+  DecodeBufferItData data;
+
+  data.n_buffers = gst_buffer_list_length (buf_list);
+
+  GST_LOG_OBJECT (pad, "Buffer chain with list of %u", data.n_buffers);
+
+  data.filter = filter;
+  data.pad = pad;
+  data.is_rtcp = is_rtcp;
+  data.rtp_list = NULL;
+  data.rtcp_list = NULL;
+
+  buf_list = gst_buffer_list_make_writable (buf_list);
+
+  GST_OBJECT_LOCK (filter);
+  gst_buffer_list_foreach (buf_list, decode_buffer_it, &data);
+  GST_OBJECT_UNLOCK (filter);
+
+  gst_buffer_list_unref (buf_list);
+
+  if (data.rtp_list)
+    ret = gst_pad_push_list (gst_srtp_dec_get_src_pad (filter, FALSE),
+        data.rtp_list);
+
+  if (data.rtcp_list) {
+    GstFlowReturn rtcp_ret;
+
+    rtcp_ret = gst_pad_push_list (gst_srtp_dec_get_src_pad (filter, TRUE),
+        data.rtcp_list);
+    if (ret == GST_FLOW_OK)
+      ret = rtcp_ret;
+  }
+
+  return ret;
+}
+
 static GstFlowReturn
 gst_srtp_dec_chain_rtp (GstPad * pad, GstObject * parent, GstBuffer * buf)
 {
@@ -1533,6 +1655,20 @@ gst_srtp_dec_chain_rtcp (GstPad * pad, GstObject * parent, GstBuffer * buf)
   return gst_srtp_dec_chain (pad, parent, buf, TRUE);
 }
 
+static GstFlowReturn
+gst_srtp_dec_chain_list_rtp (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list)
+{
+  return gst_srtp_dec_chain_list (pad, parent, buf_list, FALSE);
+}
+
+static GstFlowReturn
+gst_srtp_dec_chain_list_rtcp (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list)
+{
+  return gst_srtp_dec_chain_list (pad, parent, buf_list, TRUE);
+}
+
 static GstStateChangeReturn
 gst_srtp_dec_change_state (GstElement * element, GstStateChange transition)
 {
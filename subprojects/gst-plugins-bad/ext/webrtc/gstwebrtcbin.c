@@ -257,6 +257,8 @@ gst_webrtc_bin_pad_finalize (GObject * object)
   gst_clear_object (&pad->trans);
   gst_clear_caps (&pad->received_caps);
   g_clear_pointer (&pad->msid, g_free);
+  gst_clear_caps (&pad->codec_stats_caps);
+  gst_clear_structure (&pad->codec_stats);
 
   G_OBJECT_CLASS (gst_webrtc_bin_pad_parent_class)->finalize (object);
 }
@@ -2486,6 +2488,26 @@ _get_or_create_rtp_transport_channel (GstWebRTCBin * webrtc, guint session_id)
   return ret;
 }
 
+/* maintains the data channel counters of the peer-connection stats */
+static void
+_on_data_channel_stats_ready_state (WebRTCDataChannel * channel,
+    GParamSpec * pspec, GstWebRTCBin * webrtc)
+{
+  GstWebRTCDataChannelState ready_state;
+
+  g_object_get (channel, "ready-state", &ready_state, NULL);
+
+  if (ready_state == GST_WEBRTC_DATA_CHANNEL_STATE_OPEN) {
+    if (!channel->stats_open) {
+      channel->stats_open = TRUE;
+      g_atomic_int_inc (&webrtc->priv->data_channels_opened);
+    }
+  } else if (channel->stats_open) {
+    channel->stats_open = FALSE;
+    g_atomic_int_inc (&webrtc->priv->data_channels_closed);
+  }
+}
+
 /* this is called from the webrtc thread with the pc lock held */
 static void
 _on_data_channel_ready_state (WebRTCDataChannel * channel,
@@ -2511,6 +2533,7 @@ _on_data_channel_ready_state (WebRTCDataChannel * channel,
 
     gst_webrtc_bin_update_sctp_priority (webrtc);
 
+    g_atomic_int_inc (&webrtc->priv->data_channels_accepted);
     g_signal_emit (webrtc, gst_webrtc_bin_signals[ON_DATA_CHANNEL_SIGNAL], 0,
         channel);
   } else if (ready_state == GST_WEBRTC_DATA_CHANNEL_STATE_CLOSED) {
@@ -2556,6 +2579,9 @@ _on_sctpdec_pad_added (GstElement * sctpdec, GstPad * pad,
 
     webrtc_data_channel_link_to_sctp (channel, webrtc->priv->sctp_transport);
 
+    g_signal_connect (channel, "notify::ready-state",
+        G_CALLBACK (_on_data_channel_stats_ready_state), webrtc);
+
     g_ptr_array_add (webrtc->priv->pending_data_channels, channel);
   }
   DC_UNLOCK (webrtc);
@@ -6911,11 +6937,21 @@ _free_get_stats (struct get_stats *stats)
 static GstStructure *
 _get_stats_task (GstWebRTCBin * webrtc, struct get_stats *stats)
 {
+  WebRTCStatsSnapshot *snapshot;
+  GstStructure *s;
+
   /* Our selector is the pad,
    * https://www.w3.org/TR/webrtc/#dfn-stats-selection-algorithm
    */
+  snapshot = gst_webrtc_bin_snapshot_stats (webrtc, stats->pad);
 
-  return gst_webrtc_bin_create_stats (webrtc, stats->pad);
+  /* querying the rtp sessions, jitterbuffers and transports does not need
+   * the PC lock, don't block negotiation and the media path meanwhile */
+  PC_UNLOCK (webrtc);
+  s = gst_webrtc_bin_create_stats (webrtc, snapshot);
+  PC_LOCK (webrtc);
+
+  return s;
 }
 
 static void
@@ -7170,6 +7206,10 @@ gst_webrtc_bin_create_data_channel (GstWebRTCBin * webrtc, const gchar * label,
   g_ptr_array_add (webrtc->priv->data_channels, ret);
   DC_UNLOCK (webrtc);
 
+  g_signal_connect (ret, "notify::ready-state",
+      G_CALLBACK (_on_data_channel_stats_ready_state), webrtc);
+  g_atomic_int_inc (&webrtc->priv->data_channels_requested);
+
   gst_webrtc_bin_update_sctp_priority (webrtc);
   webrtc_data_channel_link_to_sctp (ret, webrtc->priv->sctp_transport);
   if (webrtc->priv->sctp_transport &&
@@ -49,6 +49,11 @@ struct _GstWebRTCBinPad
 
   GstCaps              *received_caps;
   char                 *msid;
+
+  /* codec stats for the last received caps, only accessed from the
+   * get-stats task */
+  GstCaps              *codec_stats_caps;
+  GstStructure         *codec_stats;
 };
 
 struct _GstWebRTCBinPadClass
@@ -115,6 +120,12 @@ struct _GstWebRTCBinPrivate
   /* dc_lock protects data_channels and pending_data_channels */
   /* lock ordering is pc_lock first, then dc_lock */
   GMutex dc_lock;
+  /* counters for the peer-connection stats, only ever incremented and
+   * accessed atomically */
+  gint data_channels_opened;
+  gint data_channels_closed;
+  gint data_channels_requested;
+  gint data_channels_accepted;
 
   guint jb_latency;
 
@@ -71,12 +71,18 @@ _set_base_stats (GstStructure * s, GstWebRTCStatsType type, double ts,
 static GstStructure *
 _get_peer_connection_stats (GstWebRTCBin * webrtc)
 {
+  GstWebRTCBinPrivate *priv = webrtc->priv;
   GstStructure *s = gst_structure_new_empty ("unused");
 
-  /* FIXME: datachannel */
-  gst_structure_set (s, "data-channels-opened", G_TYPE_UINT, 0,
-      "data-channels-closed", G_TYPE_UINT, 0, "data-channels-requested",
-      G_TYPE_UINT, 0, "data-channels-accepted", G_TYPE_UINT, 0, NULL);
+  /* the counters are maintained as the data channels change state */
+  gst_structure_set (s, "data-channels-opened", G_TYPE_UINT,
+      (guint) g_atomic_int_get (&priv->data_channels_opened),
+      "data-channels-closed", G_TYPE_UINT,
+      (guint) g_atomic_int_get (&priv->data_channels_closed),
+      "data-channels-requested", G_TYPE_UINT,
+      (guint) g_atomic_int_get (&priv->data_channels_requested),
+      "data-channels-accepted", G_TYPE_UINT,
+      (guint) g_atomic_int_get (&priv->data_channels_accepted), NULL);
 
   return s;
 }
@@ -97,6 +103,48 @@ _gst_structure_take_structure (GstStructure * s, const char *fieldname,
   *value_s = NULL;
 }
 
+typedef struct
+{
+  guint ssrc;
+  GstWebRTCRTPTransceiverDirection direction;
+  GObject *jitterbuffer;
+} SsrcStats;
+
+/* stats that are shared by all pads of a session, collected only once per
+ * report. Everything up to @ssrcs is taken with the PC lock, the rest is
+ * filled in without it. */
+typedef struct
+{
+  GObject *rtp_session;
+  GObject *gst_rtp_session;
+  GstWebRTCDTLSTransport *transport;
+  GstWebRTCICEStream *ice_stream;
+  /* array of SsrcStats, copied from the ssrc map of the transport stream */
+  GArray *ssrcs;
+
+  GValueArray *source_stats;
+  gchar *transport_id;
+} SessionStats;
+
+typedef struct
+{
+  GstPad *pad;
+  GstStructure *codec_stats;
+  guint clock_rate;
+  const gchar *kind;
+  /* NULL if the pad is not connected to a transport */
+  SessionStats *session;
+} PadStats;
+
+struct _WebRTCStatsSnapshot
+{
+  double ts;
+  /* array of PadStats */
+  GArray *pads;
+  /* session id -> SessionStats */
+  GHashTable *sessions;
+};
+
 #define CLOCK_RATE_VALUE_TO_SECONDS(v,r) ((double) v / (double) clock_rate)
 #define FIXED_16_16_TO_DOUBLE(v) ((double) ((v & 0xffff0000) >> 16) + ((v & 0xffff) / 65536.0))
 #define FIXED_32_32_TO_DOUBLE(v) ((double) ((v & G_GUINT64_CONSTANT (0xffffffff00000000)) >> 32) + ((v & G_GUINT64_CONSTANT (0xffffffff)) / 4294967296.0))
@@ -104,7 +152,7 @@ _gst_structure_take_structure (GstStructure * s, const char *fieldname,
 /* https://www.w3.org/TR/webrtc-stats/#remoteinboundrtpstats-dict* */
 static gboolean
 _get_stats_from_remote_rtp_source_stats (GstWebRTCBin * webrtc,
-    TransportStream * stream, const GstStructure * source_stats,
+    SessionStats * session, const GstStructure * source_stats,
     guint ssrc, guint clock_rate, const gchar * codec_id, const gchar * kind,
     const gchar * transport_id, GstStructure * s)
 {
@@ -205,7 +253,7 @@ _get_stats_from_remote_rtp_source_stats (GstWebRTCBin * webrtc,
    https://www.w3.org/TR/webrtc-stats/#outboundrtpstats-dict* */
 static void
 _get_stats_from_rtp_source_stats (GstWebRTCBin * webrtc,
-    TransportStream * stream, const GstStructure * source_stats,
+    SessionStats * session, const GstStructure * source_stats,
     const gchar * codec_id, const gchar * kind, const gchar * transport_id,
     GstStructure * s)
 {
@@ -321,17 +369,13 @@ _get_stats_from_rtp_source_stats (GstWebRTCBin * webrtc,
 
     gst_structure_get (source_stats, "have-sr", G_TYPE_BOOLEAN, &have_sr, NULL);
 
-    for (i = 0; i < stream->ssrcmap->len; i++) {
-      SsrcMapItem *item = g_ptr_array_index (stream->ssrcmap, i);
+    for (i = 0; i < session->ssrcs->len; i++) {
+      SsrcStats *item = &g_array_index (session->ssrcs, SsrcStats, i);
 
       if (item->direction == GST_WEBRTC_RTP_TRANSCEIVER_DIRECTION_RECVONLY
           && item->ssrc == ssrc) {
-        GObject *jb = g_weak_ref_get (&item->rtpjitterbuffer);
-
-        if (jb) {
-          g_object_get (jb, "stats", &jb_stats, NULL);
-          g_object_unref (jb);
-        }
+        if (item->jitterbuffer)
+          g_object_get (item->jitterbuffer, "stats", &jb_stats, NULL);
         break;
       }
     }
@@ -771,31 +815,16 @@ _get_stats_from_dtls_transport (GstWebRTCBin * webrtc,
 }
 
 /* https://www.w3.org/TR/webrtc-stats/#codec-dict* */
-static gboolean
-_get_codec_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad,
-    GstStructure * s, gchar ** out_id, guint * out_ssrc, guint * out_clock_rate)
+static GstStructure *
+_create_codec_stats_from_caps (GstPad * pad, GstCaps * caps)
 {
-  GstWebRTCBinPad *wpad = GST_WEBRTC_BIN_PAD (pad);
-  GstStructure *stats;
-  GstCaps *caps = NULL;
-  gchar *id;
-  double ts;
-  guint ssrc = 0;
-  gint clock_rate = 0;
-  gboolean has_caps_ssrc = FALSE;
+  GstStructure *stats = gst_structure_new_empty ("unused");
 
-  gst_structure_get_double (s, "timestamp", &ts);
-
-  stats = gst_structure_new_empty ("unused");
-  id = g_strdup_printf ("codec-stats-%s", GST_OBJECT_NAME (pad));
-  _set_base_stats (stats, GST_WEBRTC_STATS_CODEC, ts, id);
-
-  if (wpad->received_caps)
-    caps = gst_caps_ref (wpad->received_caps);
   GST_DEBUG_OBJECT (pad, "Pad caps are: %" GST_PTR_FORMAT, caps);
   if (caps && gst_caps_is_fixed (caps)) {
     GstStructure *caps_s = gst_caps_get_structure (caps, 0);
-    gint pt;
+    gint pt, clock_rate;
+    guint ssrc;
     const gchar *encoding_name, *media, *encoding_params;
     GstSDPMedia sdp_media = { 0 };
     guint channels = 0;
@@ -806,10 +835,8 @@ _get_codec_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad,
     if (gst_structure_get_int (caps_s, "clock-rate", &clock_rate))
       gst_structure_set (stats, "clock-rate", G_TYPE_UINT, clock_rate, NULL);
 
-    if (gst_structure_get_uint (caps_s, "ssrc", &ssrc)) {
+    if (gst_structure_get_uint (caps_s, "ssrc", &ssrc))
       gst_structure_set (stats, "ssrc", G_TYPE_UINT, ssrc, NULL);
-      has_caps_ssrc = TRUE;
-    }
 
     media = gst_structure_get_string (caps_s, "media");
     encoding_name = gst_structure_get_string (caps_s, "encoding-name");
@@ -847,86 +874,127 @@ _get_codec_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad,
     /* FIXME: transportId */
   }
 
+  return stats;
+}
+
+
+/* Called with the PC lock. The codec stats only depend on the caps, they
+ * are kept on the pad and only built again when it received new caps. */
+static GstStructure *
+_get_codec_stats_from_pad (GstPad * pad, guint * out_clock_rate)
+{
+  GstWebRTCBinPad *wpad = GST_WEBRTC_BIN_PAD (pad);
+  GstCaps *caps = NULL;
+  guint clock_rate = 0;
+
+  if (wpad->received_caps)
+    caps = gst_caps_ref (wpad->received_caps);
+
+  if (!wpad->codec_stats || caps != wpad->codec_stats_caps) {
+    gst_clear_structure (&wpad->codec_stats);
+    wpad->codec_stats = _create_codec_stats_from_caps (pad, caps);
+    gst_caps_replace (&wpad->codec_stats_caps, caps);
+  }
+
   if (caps)
     gst_caps_unref (caps);
 
-  gst_structure_set (s, id, GST_TYPE_STRUCTURE, stats, NULL);
-  gst_structure_free (stats);
+  gst_structure_get_uint (wpad->codec_stats, "clock-rate", &clock_rate);
+  *out_clock_rate = clock_rate;
 
-  if (out_id)
-    *out_id = id;
-  else
-    g_free (id);
+  return gst_structure_copy (wpad->codec_stats);
+}
 
-  if (out_ssrc)
-    *out_ssrc = ssrc;
+static void
+ssrc_stats_clear (SsrcStats * ssrc)
+{
+  g_clear_object (&ssrc->jitterbuffer);
+}
 
-  if (out_clock_rate)
-    *out_clock_rate = clock_rate;
+static void
+session_stats_free (SessionStats * session)
+{
+  g_clear_object (&session->rtp_session);
+  g_clear_object (&session->gst_rtp_session);
+  gst_clear_object (&session->transport);
+  gst_clear_object (&session->ice_stream);
+  g_array_free (session->ssrcs, TRUE);
+  if (session->source_stats)
+    g_value_array_free (session->source_stats);
+  g_free (session->transport_id);
+  g_free (session);
+}
 
-  return has_caps_ssrc;
+static void
+pad_stats_clear (PadStats * pad)
+{
+  gst_clear_object (&pad->pad);
+  gst_clear_structure (&pad->codec_stats);
 }
 
-struct transport_stream_stats
+static void
+webrtc_stats_snapshot_free (WebRTCStatsSnapshot * snapshot)
 {
-  GstWebRTCBin *webrtc;
-  TransportStream *stream;
-  char *transport_id;
-  char *codec_id;
-  const char *kind;
-  guint clock_rate;
-  GValueArray *source_stats;
-  GstStructure *s;
-};
+  g_array_free (snapshot->pads, TRUE);
+  g_hash_table_unref (snapshot->sessions);
+  g_free (snapshot);
+}
 
-static gboolean
-webrtc_stats_get_from_transport (SsrcMapItem * entry,
-    struct transport_stream_stats *ts_stats)
+/* Called with the PC lock */
+static SessionStats *
+_snapshot_session (GstWebRTCBin * webrtc, TransportStream * stream,
+    WebRTCStatsSnapshot * snapshot)
 {
-  double ts;
-  int i;
-
-  gst_structure_get_double (ts_stats->s, "timestamp", &ts);
-
-  /* construct stats objects */
-  for (i = 0; i < ts_stats->source_stats->n_values; i++) {
-    const GstStructure *stats;
-    const GValue *val = g_value_array_get_nth (ts_stats->source_stats, i);
-    guint stats_ssrc = 0;
-
-    stats = gst_value_get_structure (val);
-
-    /* skip foreign sources */
-    if (gst_structure_get_uint (stats, "ssrc", &stats_ssrc) &&
-        entry->ssrc == stats_ssrc)
-      _get_stats_from_rtp_source_stats (ts_stats->webrtc, ts_stats->stream,
-          stats, ts_stats->codec_id, ts_stats->kind, ts_stats->transport_id,
-          ts_stats->s);
-    else if (gst_structure_get_uint (stats, "rb-ssrc", &stats_ssrc)
-        && entry->ssrc == stats_ssrc)
-      _get_stats_from_remote_rtp_source_stats (ts_stats->webrtc,
-          ts_stats->stream, stats, entry->ssrc, ts_stats->clock_rate,
-          ts_stats->codec_id, ts_stats->kind, ts_stats->transport_id,
-          ts_stats->s);
+  SessionStats *session;
+  guint i;
+
+  session = g_hash_table_lookup (snapshot->sessions,
+      GUINT_TO_POINTER (stream->session_id));
+  if (session)
+    return session;
+
+  session = g_new0 (SessionStats, 1);
+
+  g_signal_emit_by_name (webrtc->rtpbin, "get-internal-session",
+      stream->session_id, &session->rtp_session);
+  g_signal_emit_by_name (webrtc->rtpbin, "get-session",
+      stream->session_id, &session->gst_rtp_session);
+  session->transport = gst_object_ref (stream->transport);
+  if (stream->stream)
+    session->ice_stream = gst_object_ref (stream->stream);
+
+  session->ssrcs = g_array_sized_new (FALSE, FALSE, sizeof (SsrcStats),
+      stream->ssrcmap->len);
+  g_array_set_clear_func (session->ssrcs, (GDestroyNotify) ssrc_stats_clear);
+  for (i = 0; i < stream->ssrcmap->len; i++) {
+    SsrcMapItem *item = g_ptr_array_index (stream->ssrcmap, i);
+    SsrcStats ssrc;
+
+    ssrc.ssrc = item->ssrc;
+    ssrc.direction = item->direction;
+    ssrc.jitterbuffer = g_weak_ref_get (&item->rtpjitterbuffer);
+    g_array_append_val (session->ssrcs, ssrc);
   }
 
-  /* we want to look at all the entries */
-  return FALSE;
+  g_hash_table_insert (snapshot->sessions,
+      GUINT_TO_POINTER (stream->session_id), session);
+
+  return session;
 }
 
+/* Called with the PC lock */
 static gboolean
-_get_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad, GstStructure * s)
+_snapshot_pad (GstWebRTCBin * webrtc, GstPad * pad,
+    WebRTCStatsSnapshot * snapshot)
 {
   GstWebRTCBinPad *wpad = GST_WEBRTC_BIN_PAD (pad);
-  struct transport_stream_stats ts_stats = { NULL, };
-  guint ssrc, clock_rate;
-  GObject *rtp_session;
-  GObject *gst_rtp_session;
-  GstStructure *rtp_stats, *twcc_stats;
+  PadStats pad_stats = { NULL, };
+  TransportStream *stream;
   GstWebRTCKind kind;
 
-  _get_codec_stats_from_pad (webrtc, pad, s, &ts_stats.codec_id, &ssrc,
-      &clock_rate);
+  pad_stats.pad = gst_object_ref (pad);
+  pad_stats.codec_stats =
+      _get_codec_stats_from_pad (pad, &pad_stats.clock_rate);
 
   if (!wpad->trans)
     goto out;
@@ -934,71 +1002,143 @@ _get_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad, GstStructure * s)
   g_object_get (wpad->trans, "kind", &kind, NULL);
   switch (kind) {
     case GST_WEBRTC_KIND_AUDIO:
-      ts_stats.kind = "audio";
+      pad_stats.kind = "audio";
       break;
     case GST_WEBRTC_KIND_VIDEO:
-      ts_stats.kind = "video";
+      pad_stats.kind = "video";
       break;
     case GST_WEBRTC_KIND_UNKNOWN:
-      ts_stats.kind = NULL;
+      pad_stats.kind = NULL;
       break;
   };
 
-  ts_stats.stream = WEBRTC_TRANSCEIVER (wpad->trans)->stream;
-  if (!ts_stats.stream)
+  stream = WEBRTC_TRANSCEIVER (wpad->trans)->stream;
+  if (!stream)
     goto out;
 
   if (wpad->trans->mline == G_MAXUINT)
     goto out;
 
-  if (!ts_stats.stream->transport)
+  if (!stream->transport)
     goto out;
 
-  g_signal_emit_by_name (webrtc->rtpbin, "get-internal-session",
-      ts_stats.stream->session_id, &rtp_session);
-  g_object_get (rtp_session, "stats", &rtp_stats, NULL);
-  g_signal_emit_by_name (webrtc->rtpbin, "get-session",
-      ts_stats.stream->session_id, &gst_rtp_session);
-  g_object_get (gst_rtp_session, "twcc-stats", &twcc_stats, NULL);
+  pad_stats.session = _snapshot_session (webrtc, stream, snapshot);
 
-  gst_structure_get (rtp_stats, "source-stats", G_TYPE_VALUE_ARRAY,
-      &ts_stats.source_stats, NULL);
+out:
+  g_array_append_val (snapshot->pads, pad_stats);
+  return TRUE;
+}
 
-  ts_stats.transport_id =
-      _get_stats_from_dtls_transport (webrtc, ts_stats.stream->transport,
-      GST_WEBRTC_ICE_STREAM (ts_stats.stream->stream), twcc_stats, s);
+static void
+_get_session_stats (GstWebRTCBin * webrtc, SessionStats * session,
+    GstStructure * s)
+{
+  GstStructure *rtp_stats, *twcc_stats;
 
-  GST_DEBUG_OBJECT (webrtc, "retrieving rtp stream stats from transport %"
-      GST_PTR_FORMAT " rtp session %" GST_PTR_FORMAT " with %u rtp sources, "
-      "transport %" GST_PTR_FORMAT, ts_stats.stream, rtp_session,
-      ts_stats.source_stats->n_values, ts_stats.stream->transport);
+  g_object_get (session->rtp_session, "stats", &rtp_stats, NULL);
+  g_object_get (session->gst_rtp_session, "twcc-stats", &twcc_stats, NULL);
 
-  ts_stats.s = s;
+  gst_structure_get (rtp_stats, "source-stats", G_TYPE_VALUE_ARRAY,
+      &session->source_stats, NULL);
+
+  session->transport_id =
+      _get_stats_from_dtls_transport (webrtc, session->transport,
+      session->ice_stream, twcc_stats, s);
 
-  transport_stream_find_ssrc_map_item (ts_stats.stream, &ts_stats,
-      (FindSsrcMapFunc) webrtc_stats_get_from_transport);
+  GST_DEBUG_OBJECT (webrtc, "retrieved stats of rtp session %"
+      GST_PTR_FORMAT " with %u rtp sources, transport %" GST_PTR_FORMAT,
+      session->rtp_session, session->source_stats->n_values,
+      session->transport);
 
-  g_clear_object (&rtp_session);
-  g_clear_object (&gst_rtp_session);
   gst_clear_structure (&rtp_stats);
   gst_clear_structure (&twcc_stats);
-  g_value_array_free (ts_stats.source_stats);
-  ts_stats.source_stats = NULL;
-  g_clear_pointer (&ts_stats.transport_id, g_free);
+}
+
+static void
+_get_stats_from_pad (GstWebRTCBin * webrtc, PadStats * pad_stats,
+    GstStructure * s)
+{
+  SessionStats *session = pad_stats->session;
+  gchar *codec_id;
+  double ts;
+  guint i, j;
+
+  gst_structure_get_double (s, "timestamp", &ts);
+
+  codec_id =
+      g_strdup_printf ("codec-stats-%s", GST_OBJECT_NAME (pad_stats->pad));
+  _set_base_stats (pad_stats->codec_stats, GST_WEBRTC_STATS_CODEC, ts,
+      codec_id);
+  _gst_structure_take_structure (s, codec_id, &pad_stats->codec_stats);
+
+  if (!session)
+    goto out;
+
+  GST_DEBUG_OBJECT (webrtc, "retrieving rtp stream stats from transport %"
+      GST_PTR_FORMAT " for pad %" GST_PTR_FORMAT, session->transport,
+      pad_stats->pad);
+
+  for (i = 0; i < session->ssrcs->len; i++) {
+    guint ssrc = g_array_index (session->ssrcs, SsrcStats, i).ssrc;
+
+    for (j = 0; j < session->source_stats->n_values; j++) {
+      const GValue *val = g_value_array_get_nth (session->source_stats, j);
+      const GstStructure *stats = gst_value_get_structure (val);
+      guint stats_ssrc = 0;
+
+      /* skip foreign sources */
+      if (gst_structure_get_uint (stats, "ssrc", &stats_ssrc)
+          && ssrc == stats_ssrc)
+        _get_stats_from_rtp_source_stats (webrtc, session, stats, codec_id,
+            pad_stats->kind, session->transport_id, s);
+      else if (gst_structure_get_uint (stats, "rb-ssrc", &stats_ssrc)
+          && ssrc == stats_ssrc)
+        _get_stats_from_remote_rtp_source_stats (webrtc, session, stats,
+            ssrc, pad_stats->clock_rate, codec_id, pad_stats->kind,
+            session->transport_id, s);
+    }
+  }
 
 out:
-  g_clear_pointer (&ts_stats.codec_id, g_free);
-  return TRUE;
+  g_free (codec_id);
 }
 
+/* Called with the PC lock. Takes what is needed from @webrtc to build the
+ * stats of @pad, or of all pads if %NULL, without the PC lock afterwards. */
+WebRTCStatsSnapshot *
+gst_webrtc_bin_snapshot_stats (GstWebRTCBin * webrtc, GstPad * pad)
+{
+  WebRTCStatsSnapshot *snapshot = g_new0 (WebRTCStatsSnapshot, 1);
+
+  _init_debug ();
+
+  snapshot->ts = monotonic_time_as_double_milliseconds ();
+  snapshot->pads = g_array_new (FALSE, FALSE, sizeof (PadStats));
+  g_array_set_clear_func (snapshot->pads, (GDestroyNotify) pad_stats_clear);
+  snapshot->sessions = g_hash_table_new_full (NULL, NULL, NULL,
+      (GDestroyNotify) session_stats_free);
+
+  if (pad)
+    _snapshot_pad (webrtc, pad, snapshot);
+  else
+    gst_element_foreach_pad (GST_ELEMENT (webrtc),
+        (GstElementForeachPadFunc) _snapshot_pad, snapshot);
+
+  return snapshot;
+}
+
+/* Called without the PC lock, queries the elements and builds the stats
+ * report. Takes ownership of @snapshot. */
 GstStructure *
-gst_webrtc_bin_create_stats (GstWebRTCBin * webrtc, GstPad * pad)
+gst_webrtc_bin_create_stats (GstWebRTCBin * webrtc,
+    WebRTCStatsSnapshot * snapshot)
 {
   GstStructure *s = gst_structure_new_empty ("application/x-webrtc-stats");
-  double ts = monotonic_time_as_double_milliseconds ();
+  double ts = snapshot->ts;
   GstStructure *pc_stats;
-
-  _init_debug ();
+  GHashTableIter iter;
+  SessionStats *session;
+  guint i;
 
   gst_structure_set (s, "timestamp", G_TYPE_DOUBLE, ts, NULL);
 
@@ -1015,11 +1155,15 @@ gst_webrtc_bin_create_stats (GstWebRTCBin * webrtc, GstPad * pad)
     gst_structure_free (pc_stats);
   }
 
-  if (pad)
-    _get_stats_from_pad (webrtc, pad, s);
-  else
-    gst_element_foreach_pad (GST_ELEMENT (webrtc),
-        (GstElementForeachPadFunc) _get_stats_from_pad, s);
+  g_hash_table_iter_init (&iter, snapshot->sessions);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) & session))
+    _get_session_stats (webrtc, session, s);
+
+  for (i = 0; i < snapshot->pads->len; i++)
+    _get_stats_from_pad (webrtc, &g_array_index (snapshot->pads, PadStats, i),
+        s);
+
+  webrtc_stats_snapshot_free (snapshot);
 
   gst_structure_remove_field (s, "timestamp");
 
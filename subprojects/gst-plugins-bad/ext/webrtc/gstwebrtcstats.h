@@ -27,9 +27,14 @@
 
 G_BEGIN_DECLS
 
+typedef struct _WebRTCStatsSnapshot WebRTCStatsSnapshot;
+
 G_GNUC_INTERNAL
-GstStructure *     gst_webrtc_bin_create_stats         (GstWebRTCBin * webrtc,
+WebRTCStatsSnapshot * gst_webrtc_bin_snapshot_stats    (GstWebRTCBin * webrtc,
                                                         GstPad * pad);
+G_GNUC_INTERNAL
+GstStructure *     gst_webrtc_bin_create_stats         (GstWebRTCBin * webrtc,
+                                                        WebRTCStatsSnapshot * snapshot);
 
 G_END_DECLS
 
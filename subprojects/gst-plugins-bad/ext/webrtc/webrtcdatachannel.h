@@ -56,6 +56,8 @@ struct _WebRTCDataChannel
   gulong                            src_probe;
   GError                           *stored_error;
   gboolean                          peer_closed;
+  /* for the data channel counters of the webrtcbin stats */
+  gboolean                          stats_open;
 
   gpointer                          _padding[GST_PADDING];
 };
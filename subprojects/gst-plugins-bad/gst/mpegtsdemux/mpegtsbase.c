@@ -275,6 +275,7 @@ mpegts_base_init (MpegTSBase * base)
   base->parse_private_sections = FALSE;
   base->is_pes = g_new0 (guint8, 1024);
   base->known_psi = g_new0 (guint8, 1024);
+  base->wanted_pids = g_new0 (guint8, 1024);
   base->program_size = sizeof (MpegTSBaseProgram);
   base->stream_size = sizeof (MpegTSBaseStream);
 
@@ -295,6 +296,7 @@ mpegts_base_dispose (GObject * object)
     base->disposed = TRUE;
     g_free (base->known_psi);
     g_free (base->is_pes);
+    g_free (base->wanted_pids);
   }
 
   if (G_OBJECT_CLASS (parent_class)->dispose)
@@ -1496,6 +1498,18 @@ mpegts_base_sink_query (GstPad * pad, GstObject * parent, GstQuery * query)
   return GST_MPEGTS_BASE_GET_CLASS (base)->sink_query (base, query);
 }
 
+static void
+mpegts_base_update_wanted_pids (MpegTSBase * base)
+{
+  guint64 *wanted = (guint64 *) base->wanted_pids;
+  const guint64 *is_pes = (const guint64 *) base->is_pes;
+  const guint64 *known_psi = (const guint64 *) base->known_psi;
+  guint i;
+
+  for (i = 0; i < 1024 / sizeof (guint64); i++)
+    wanted[i] = is_pes[i] | known_psi[i];
+}
+
 static GstFlowReturn
 mpegts_base_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 {
@@ -1505,12 +1519,20 @@ mpegts_base_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   MpegTSPacketizer2 *packetizer;
   MpegTSPacketizerPacket packet;
   MpegTSBaseClass *klass;
+  gboolean skip_unwanted;
 
   base = GST_MPEGTS_BASE (parent);
   klass = GST_MPEGTS_BASE_GET_CLASS (base);
 
   packetizer = base->packetizer;
 
+  /* Packets on PIDs that are neither PES nor PSI are only looked at when
+   * they are pushed or inspected. Otherwise runs of them are skipped
+   * straight in the packetizer's mapped data */
+  skip_unwanted = !base->push_unknown && !klass->inspect_packet;
+  if (skip_unwanted)
+    mpegts_base_update_wanted_pids (base);
+
   if (GST_BUFFER_IS_DISCONT (buf)) {
     GST_DEBUG_OBJECT (base, "Got DISCONT buffer, flushing");
     res = mpegts_base_drain (base);
@@ -1536,6 +1558,9 @@ mpegts_base_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   mpegts_packetizer_push (base->packetizer, buf);
 
   while (res == GST_FLOW_OK) {
+    if (skip_unwanted)
+      mpegts_packetizer_skip_packets (packetizer, base->wanted_pids);
+
     pret = mpegts_packetizer_next_packet (base->packetizer, &packet);
 
     /* If we don't have enough data, return */
@@ -1570,6 +1595,9 @@ mpegts_base_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
           mpegts_base_handle_psi (base, (GstMpegtsSection *) tmp->data);
         g_list_free (others);
       }
+      /* a PAT or PMT can add or remove PIDs */
+      if (skip_unwanted && (section || others))
+        mpegts_base_update_wanted_pids (base);
 
       /* we need to push section packet downstream */
       if (base->push_section)
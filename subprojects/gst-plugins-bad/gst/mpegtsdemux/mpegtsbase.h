@@ -135,6 +135,9 @@ struct _MpegTSBase {
   /* Use MPEGTS_BIT_* to set/unset/check the values */
   guint8 *known_psi;
   guint8 *is_pes;
+  /* union of the two above, the PIDs whose packets need to be parsed when
+   * unknown packets are not pushed. Updated by the streaming thread */
+  guint8 *wanted_pids;
 
   gboolean disposed;
 
@@ -917,6 +917,67 @@ mpegts_packetizer_clear_packet (MpegTSPacketizer2 * packetizer,
   }
 }
 
+/* Skips the run of packets at the current position whose PID is not set in
+ * @pid_filter, without parsing them. Packets carrying a PCR are never
+ * skipped so that the clock observations stay the same. Stops at the first
+ * packet that needs looking at, or that has no sync byte so that
+ * mpegts_packetizer_next_packet() can resync. Returns the number of packets
+ * skipped. */
+guint
+mpegts_packetizer_skip_packets (MpegTSPacketizer2 * packetizer,
+    const guint8 * pid_filter)
+{
+  guint packet_size = packetizer->packet_size;
+  const guint8 *data, *end;
+  gsize sync_offset;
+  guint skipped = 0;
+
+  if (G_UNLIKELY (!packet_size || packetizer->need_sync))
+    return 0;
+
+  if (!mpegts_packetizer_map (packetizer, packet_size))
+    return 0;
+
+  /* M2TS packets don't start with the sync byte, all other variants do */
+  if (packet_size == MPEGTS_M2TS_PACKETSIZE)
+    sync_offset = 4;
+  else
+    sync_offset = 0;
+
+  data = packetizer->map_data + packetizer->map_offset + sync_offset;
+  /* last position at which a whole packet is still mapped */
+  end = packetizer->map_data + packetizer->map_size - packet_size +
+      sync_offset;
+
+  for (; data <= end; data += packet_size) {
+    guint16 pid;
+
+    if (G_UNLIKELY (data[0] != PACKET_SYNC_BYTE))
+      break;
+
+    pid = GST_READ_UINT16_BE (data + 1) & 0x1FFF;
+    if (MPEGTS_BIT_IS_SET (pid_filter, pid))
+      break;
+
+    /* adaptation field with a non-zero length and the PCR flag */
+    if (G_UNLIKELY (FLAGS_HAS_AFC (data[3]) && data[4] > 0
+            && (data[5] & MPEGTS_AFC_PCR_FLAG)))
+      break;
+
+    skipped++;
+  }
+
+  if (skipped > 0) {
+    GST_LOG ("skipped %u packets", skipped);
+    packetizer->map_offset += skipped * packet_size;
+    packetizer->offset += skipped * packet_size;
+    if (packetizer->map_size - packetizer->map_offset < packet_size)
+      mpegts_packetizer_flush_bytes (packetizer, packetizer->map_offset);
+  }
+
+  return skipped;
+}
+
 gboolean
 mpegts_packetizer_has_packets (MpegTSPacketizer2 * packetizer)
 {
@@ -354,6 +354,8 @@ G_GNUC_INTERNAL MpegTSPacketizerPacketReturn mpegts_packetizer_next_packet (Mpeg
   MpegTSPacketizerPacket *packet);
 G_GNUC_INTERNAL MpegTSPacketizerPacketReturn
 mpegts_packetizer_process_next_packet(MpegTSPacketizer2 * packetizer);
+G_GNUC_INTERNAL guint mpegts_packetizer_skip_packets (MpegTSPacketizer2 *packetizer,
+							const guint8 *pid_filter);
 G_GNUC_INTERNAL void mpegts_packetizer_clear_packet (MpegTSPacketizer2 *packetizer,
 				     MpegTSPacketizerPacket *packet);
 G_GNUC_INTERNAL void mpegts_packetizer_remove_stream(MpegTSPacketizer2 *packetizer,
@@ -88,10 +88,11 @@ G_DEFINE_TYPE_WITH_CODE (GstRistRtpExt, gst_rist_rtp_ext, GST_TYPE_ELEMENT,
 GST_ELEMENT_REGISTER_DEFINE (ristrtpext, "ristrtpext", GST_RANK_NONE,
     GST_TYPE_RIST_RTP_EXT);
 
-static GstFlowReturn
-gst_rist_rtp_ext_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+/* Adds the extension to @buffer. Returns the resulting buffer, or NULL
+ * after posting an error */
+static GstBuffer *
+gst_rist_rtp_ext_process (GstRistRtpExt * self, GstBuffer * buffer)
 {
-  GstRistRtpExt *self = GST_RIST_RTP_EXT (parent);
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
   gboolean drop_null = self->drop_null;
   gboolean ts_packet_size = 0;
@@ -101,9 +102,6 @@ gst_rist_rtp_ext_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
   guint8 *data;
   guint wordlen;
 
-  if (!self->drop_null && !self->add_seqnumext)
-    return gst_pad_push (self->srcpad, buffer);
-
   if (self->drop_null) {
     if (!gst_rtp_buffer_map (buffer, GST_MAP_READ, &rtp)) {
       GST_ELEMENT_ERROR (self, STREAM, MUX, (NULL),
@@ -205,16 +203,61 @@ gst_rist_rtp_ext_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
     gst_buffer_resize (buffer, 0,
         gst_buffer_get_size (buffer) - (ts_packet_size * num_packets_deleted));
 
-  return gst_pad_push (self->srcpad, buffer);
+  return buffer;
 
 mapping_error:
   gst_buffer_unref (buffer);
-  return GST_FLOW_ERROR;
+  return NULL;
 
 error_mapped:
   gst_rtp_buffer_unmap (&rtp);
   gst_buffer_unref (buffer);
-  return GST_FLOW_ERROR;
+  return NULL;
+}
+
+static GstFlowReturn
+gst_rist_rtp_ext_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  GstRistRtpExt *self = GST_RIST_RTP_EXT (parent);
+
+  if (!self->drop_null && !self->add_seqnumext)
+    return gst_pad_push (self->srcpad, buffer);
+
+  buffer = gst_rist_rtp_ext_process (self, buffer);
+  if (!buffer)
+    return GST_FLOW_ERROR;
+
+  return gst_pad_push (self->srcpad, buffer);
+}
+
+static gboolean
+process_buffer_from_list (GstBuffer ** buffer, guint idx, gpointer user_data)
+{
+  GstRistRtpExt *self = user_data;
+
+  *buffer = gst_rist_rtp_ext_process (self, *buffer);
+
+  return *buffer != NULL;
+}
+
+static GstFlowReturn
+gst_rist_rtp_ext_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  GstRistRtpExt *self = GST_RIST_RTP_EXT (parent);
+
+  if (!self->drop_null && !self->add_seqnumext)
+    return gst_pad_push_list (self->srcpad, list);
+
+  /* the buffers are modified in place and the list stays in one piece, so
+   * the whole batch is pushed on at once */
+  list = gst_buffer_list_make_writable (list);
+  if (!gst_buffer_list_foreach (list, process_buffer_from_list, self)) {
+    gst_buffer_list_unref (list);
+    return GST_FLOW_ERROR;
+  }
+
+  return gst_pad_push_list (self->srcpad, list);
 }
 
 static void
@@ -230,6 +273,7 @@ gst_rist_rtp_ext_init (GstRistRtpExt * self)
   GST_PAD_SET_PROXY_ALLOCATION (self->sinkpad);
   GST_PAD_SET_PROXY_CAPS (self->sinkpad);
   gst_pad_set_chain_function (self->sinkpad, gst_rist_rtp_ext_chain);
+  gst_pad_set_chain_list_function (self->sinkpad, gst_rist_rtp_ext_chain_list);
 
   gst_element_add_pad (GST_ELEMENT (self), self->sinkpad);
   gst_element_add_pad (GST_ELEMENT (self), self->srcpad);
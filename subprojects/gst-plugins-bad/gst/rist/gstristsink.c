@@ -51,13 +51,19 @@
  * mapped to its own RTP session. RTX request are only replied to on the
  * link the NACK was received from.
  *
- * There are currently two bonding methods in place: "broadcast" and "round-robin".
- * In "broadcast" mode, all the packets are duplicated over all sessions.
- * While in "round-robin" mode, packets are evenly distributed over the links. One
- * can also implement its own dispatcher element and configure it using the
- * "dispatcher" property. As a reference, "broadcast" mode is implemented with
- * the "tee" element, while "round-robin" mode is implemented with the
- * "round-robin" element.
+ * There are currently three bonding methods in place: "broadcast",
+ * "round-robin" and "weighted". In "broadcast" mode, all the packets are
+ * duplicated over all sessions. While in "round-robin" mode, packets are
+ * evenly distributed over the links. The "weighted" mode (since 1.24)
+ * distributes the packets like "round-robin", but gives each link a share
+ * that follows the round-trip time and packet loss the receiver reports for
+ * it in its RTCP receiver reports, so that faster and cleaner links carry
+ * more of the stream. The bandwidth of the links is not taken into account,
+ * a link with little capacity only gets a smaller share once it starts
+ * losing packets. One can also implement its own dispatcher element and
+ * configure it using the "dispatcher" property. As a reference, "broadcast"
+ * mode is implemented with the "tee" element, while "round-robin" and
+ * "weighted" modes are implemented with the "round-robin" element.
  *
  * ## Example gst-launch line for bonding
  * |[
@@ -108,6 +114,7 @@ typedef enum
 {
   GST_RIST_BONDING_METHOD_BROADCAST,
   GST_RIST_BONDING_METHOD_ROUND_ROBIN,
+  GST_RIST_BONDING_METHOD_WEIGHTED,
 } GstRistBondingMethod;
 
 static GstStaticPadTemplate sink_templ = GST_STATIC_PAD_TEMPLATE ("sink",
@@ -127,6 +134,7 @@ typedef struct
   GstElement *rtx_send;
   GstElement *rtx_queue;
   guint32 rtcp_ssrc;
+  guint weight;
 } RistSenderBond;
 
 struct _GstRistSink
@@ -140,6 +148,8 @@ struct _GstRistSink
   GstElement *rtxbin;
   GstElement *dispatcher;
   GstElement *rtpext;
+  /* set when the dispatcher is a roundrobin driven by the link quality */
+  gboolean weighted;
 
   /* Common properties, protected by bonds_lock */
   gint multicast_ttl;
@@ -175,6 +185,8 @@ gst_rist_bonding_method_get_type (void)
         "GST_RIST_BONDING_METHOD_BROADCAST", "broadcast"},
     {GST_RIST_BONDING_METHOD_ROUND_ROBIN,
         "GST_RIST_BONDING_METHOD_ROUND_ROBIN", "round-robin"},
+    {GST_RIST_BONDING_METHOD_WEIGHTED,
+        "GST_RIST_BONDING_METHOD_WEIGHTED", "weighted"},
     {0, NULL, NULL}
   };
 
@@ -202,6 +214,7 @@ gst_rist_sink_add_bond (GstRistSink * sink)
 
   bond->session = sink->bonds->len;
   bond->address = g_strdup ("localhost");
+  bond->weight = 1;
 
   g_snprintf (name, 32, "rist_rtp_udpsink%u", bond->session);
   bond->rtp_sink = gst_element_factory_make ("udpsink", name);
@@ -478,6 +491,87 @@ gst_rist_sink_on_new_receiver_ssrc (GstRistSink * sink, guint session_id,
   bond->rtcp_ssrc = ssrc;
 }
 
+/* The weight of a link is proportional to the share of packets the receiver
+ * got and inversely proportional to the round-trip time, in milliseconds.
+ * There is no capacity term: a link with a short round-trip time but little
+ * bandwidth gets a large share until the losses it causes bring its weight
+ * down. */
+static guint
+gst_rist_sink_link_weight (guint fractionlost, guint round_trip)
+{
+  guint64 rtt_ms = MAX (gst_util_uint64_scale (round_trip, 1000, 65536), 1);
+  guint64 weight = (256 - MIN (fractionlost, 255)) * 100 / rtt_ms;
+
+  return CLAMP (weight, 1, G_MAXUINT16);
+}
+
+static void
+gst_rist_sink_on_ssrc_active (GstRistSink * sink, guint session_id,
+    guint ssrc, GstElement * rtpbin)
+{
+  GObject *session = NULL, *source = NULL;
+  GstStructure *sstats = NULL;
+  RistSenderBond *bond;
+  gboolean have_rb = FALSE;
+  guint fractionlost = 0, round_trip = 0, weight;
+  GstPad *pad;
+  gchar name[32];
+
+  g_mutex_lock (&sink->bonds_lock);
+  if (!sink->weighted || session_id >= sink->bonds->len) {
+    g_mutex_unlock (&sink->bonds_lock);
+    return;
+  }
+  g_mutex_unlock (&sink->bonds_lock);
+
+  g_signal_emit_by_name (rtpbin, "get-internal-session", session_id, &session);
+  if (!session)
+    return;
+
+  g_signal_emit_by_name (session, "get-source-by-ssrc", ssrc, &source);
+  if (source) {
+    g_object_get (source, "stats", &sstats, NULL);
+    gst_structure_get_boolean (sstats, "have-rb", &have_rb);
+    gst_structure_get_uint (sstats, "rb-fractionlost", &fractionlost);
+    gst_structure_get_uint (sstats, "rb-round-trip", &round_trip);
+    gst_structure_free (sstats);
+    g_object_unref (source);
+  }
+  g_object_unref (session);
+
+  /* only the receiver reports carry the link quality */
+  if (!have_rb || round_trip == 0)
+    return;
+
+  weight = gst_rist_sink_link_weight (fractionlost, round_trip);
+
+  g_mutex_lock (&sink->bonds_lock);
+  if (session_id >= sink->bonds->len) {
+    g_mutex_unlock (&sink->bonds_lock);
+    return;
+  }
+
+  bond = g_ptr_array_index (sink->bonds, session_id);
+  if (weight == bond->weight) {
+    g_mutex_unlock (&sink->bonds_lock);
+    return;
+  }
+
+  GST_DEBUG_OBJECT (sink, "Link %u: round-trip %u (Q16), fraction lost %u, "
+      "weight %u -> %u", session_id, round_trip, fractionlost, bond->weight,
+      weight);
+  bond->weight = weight;
+
+  g_snprintf (name, 32, "src_%u", bond->session);
+  pad = gst_element_get_static_pad (sink->dispatcher, name);
+  g_mutex_unlock (&sink->bonds_lock);
+
+  if (pad) {
+    g_object_set (pad, "weight", weight, NULL);
+    gst_object_unref (pad);
+  }
+}
+
 static GstPadProbeReturn
 gst_rist_sink_fix_collision (GstPad * pad, GstPadProbeInfo * info,
     gpointer user_data)
@@ -596,6 +690,8 @@ gst_rist_sink_init (GstRistSink * sink)
       G_CALLBACK (gst_rist_sink_on_new_sender_ssrc), sink, G_CONNECT_SWAPPED);
   g_signal_connect_object (sink->rtpbin, "on-new-ssrc",
       G_CALLBACK (gst_rist_sink_on_new_receiver_ssrc), sink, G_CONNECT_SWAPPED);
+  g_signal_connect_object (sink->rtpbin, "on-ssrc-active",
+      G_CALLBACK (gst_rist_sink_on_ssrc_active), sink, G_CONNECT_SWAPPED);
 
   sink->rtxbin = gst_bin_new ("rist_send_rtxbin");
   g_object_ref_sink (sink->rtxbin);
@@ -758,6 +854,12 @@ gst_rist_sink_start (GstRistSink * sink)
             "rist_dispatcher");
         g_assert (sink->dispatcher);
         break;
+      case GST_RIST_BONDING_METHOD_WEIGHTED:
+        sink->dispatcher = gst_element_factory_make ("roundrobin",
+            "rist_dispatcher");
+        g_assert (sink->dispatcher);
+        sink->weighted = TRUE;
+        break;
     }
   }
 
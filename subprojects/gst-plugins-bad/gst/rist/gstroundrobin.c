@@ -27,6 +27,11 @@
  * element, which duplicates buffers over all pads. This element 
  * can be used to distrute load across multiple branches when the buffer
  * can be processed independently.
+ *
+ * Since 1.24, each src pad has a #GstRoundRobinPad:weight. Buffers are spread
+ * over the pads in proportion to their weight, interleaved as evenly as
+ * possible. With the default weight of 1 on all pads the buffers are
+ * distributed equally as before.
  */
 
 #include "gstroundrobin.h"
@@ -44,36 +49,137 @@ static GstStaticPadTemplate src_templ = GST_STATIC_PAD_TEMPLATE ("src_%d",
     GST_PAD_REQUEST,
     GST_STATIC_CAPS ("ANY"));
 
+#define DEFAULT_WEIGHT 1
+
+enum
+{
+  PROP_PAD_0,
+  PROP_PAD_WEIGHT,
+};
+
+struct _GstRoundRobinPad
+{
+  GstPad parent;
+
+  guint weight;
+  /* smooth weighted round robin state, protected by the element lock */
+  gint64 current;
+};
+
 struct _GstRoundRobin
 {
   GstElement parent;
-  gint index;
 };
 
+G_DEFINE_TYPE (GstRoundRobinPad, gst_round_robin_pad, GST_TYPE_PAD);
+
+static void
+gst_round_robin_pad_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstRoundRobinPad *pad = GST_ROUND_ROBIN_PAD (object);
+
+  switch (prop_id) {
+    case PROP_PAD_WEIGHT:
+      g_atomic_int_set (&pad->weight, g_value_get_uint (value));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_round_robin_pad_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstRoundRobinPad *pad = GST_ROUND_ROBIN_PAD (object);
+
+  switch (prop_id) {
+    case PROP_PAD_WEIGHT:
+      g_value_set_uint (value, g_atomic_int_get (&pad->weight));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_round_robin_pad_init (GstRoundRobinPad * pad)
+{
+  pad->weight = DEFAULT_WEIGHT;
+}
+
+static void
+gst_round_robin_pad_class_init (GstRoundRobinPadClass * klass)
+{
+  GObjectClass *object_class = (GObjectClass *) klass;
+
+  object_class->set_property = gst_round_robin_pad_set_property;
+  object_class->get_property = gst_round_robin_pad_get_property;
+
+  /**
+   * GstRoundRobinPad:weight:
+   *
+   * The share of the buffers this pad receives relative to the other pads.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (object_class, PROP_PAD_WEIGHT,
+      g_param_spec_uint ("weight", "Weight",
+          "Share of the buffers pushed on this pad relative to the other pads",
+          1, G_MAXUINT16, DEFAULT_WEIGHT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+}
+
 G_DEFINE_TYPE_WITH_CODE (GstRoundRobin, gst_round_robin,
     GST_TYPE_ELEMENT, GST_DEBUG_CATEGORY_INIT (gst_round_robin_debug,
         "roundrobin", 0, "Round Robin"));
 GST_ELEMENT_REGISTER_DEFINE (roundrobin, "roundrobin", GST_RANK_NONE,
     GST_TYPE_ROUND_ROBIN);
 
+/* Smooth weighted round robin: every pad earns its weight on each pick, the
+ * pad with the most credit is picked and pays back the total. Equal weights
+ * give a plain rotation over the pads. Must be called with the element
+ * lock held. */
+static GstRoundRobinPad *
+gst_round_robin_next_pad (GstRoundRobin * disp)
+{
+  GstElement *elem = (GstElement *) disp;
+  GstRoundRobinPad *best = NULL;
+  gint64 total = 0;
+  GList *l;
+
+  for (l = elem->srcpads; l; l = l->next) {
+    GstRoundRobinPad *pad = l->data;
+    guint weight = g_atomic_int_get (&pad->weight);
+
+    pad->current += weight;
+    total += weight;
+
+    if (!best || pad->current > best->current)
+      best = pad;
+  }
+
+  if (best)
+    best->current -= total;
+
+  return best;
+}
+
 static GstFlowReturn
 gst_round_robin_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
 {
   GstRoundRobin *disp = (GstRoundRobin *) parent;
-  GstElement *elem = (GstElement *) parent;
   GstPad *src_pad = NULL;
   GstFlowReturn ret;
 
   GST_OBJECT_LOCK (disp);
-  if (disp->index >= elem->numsrcpads)
-    disp->index = 0;
-
-  src_pad = g_list_nth_data (elem->srcpads, disp->index);
-
-  if (src_pad) {
+  src_pad = (GstPad *) gst_round_robin_next_pad (disp);
+  if (src_pad)
     gst_object_ref (src_pad);
-    disp->index += 1;
-  }
   GST_OBJECT_UNLOCK (disp);
 
   if (!src_pad)
@@ -86,6 +192,64 @@ gst_round_robin_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
   return ret;
 }
 
+typedef struct
+{
+  GstPad *pad;
+  GstBufferList *list;
+} RoundRobinBatch;
+
+/* Splits the list into one list per src pad so that each branch gets its
+ * share of the buffers in a single push */
+static GstFlowReturn
+gst_round_robin_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  GstRoundRobin *disp = (GstRoundRobin *) parent;
+  GstElement *elem = (GstElement *) parent;
+  GstFlowReturn ret = GST_FLOW_OK;
+  RoundRobinBatch *batches;
+  guint i, n_buffers, n_pads = 0;
+  GList *l;
+
+  n_buffers = gst_buffer_list_length (list);
+
+  GST_OBJECT_LOCK (disp);
+  batches = g_newa (RoundRobinBatch, elem->numsrcpads + 1);
+  for (l = elem->srcpads; l; l = l->next) {
+    batches[n_pads].pad = gst_object_ref (l->data);
+    batches[n_pads].list = NULL;
+    n_pads++;
+  }
+
+  for (i = 0; n_pads > 0 && i < n_buffers; i++) {
+    GstRoundRobinPad *src_pad = gst_round_robin_next_pad (disp);
+    guint p;
+
+    for (p = 0; batches[p].pad != (GstPad *) src_pad; p++);
+
+    if (!batches[p].list)
+      batches[p].list = gst_buffer_list_new_sized (n_buffers);
+    gst_buffer_list_add (batches[p].list,
+        gst_buffer_ref (gst_buffer_list_get (list, i)));
+  }
+  GST_OBJECT_UNLOCK (disp);
+
+  gst_buffer_list_unref (list);
+
+  for (i = 0; i < n_pads; i++) {
+    if (batches[i].list) {
+      GstFlowReturn pad_ret = gst_pad_push_list (batches[i].pad,
+          batches[i].list);
+
+      if (ret == GST_FLOW_OK)
+        ret = pad_ret;
+    }
+    gst_object_unref (batches[i].pad);
+  }
+
+  return ret;
+}
+
 static GstPad *
 gst_round_robin_request_pad (GstElement * element, GstPadTemplate * templ,
     const gchar * name, const GstCaps * caps)
@@ -98,7 +262,8 @@ gst_round_robin_request_pad (GstElement * element, GstPadTemplate * templ,
     return NULL;
   }
 
-  pad = gst_pad_new_from_static_template (&src_templ, name);
+  pad = g_object_new (GST_TYPE_ROUND_ROBIN_PAD, "name", name,
+      "direction", templ->direction, "template", templ, NULL);
   gst_element_add_pad (element, pad);
 
   return pad;
@@ -117,6 +282,8 @@ gst_round_robin_init (GstRoundRobin * disp)
   /* do not proxy allocation, it requires special handling like tee does */
 
   gst_pad_set_chain_function (pad, GST_DEBUG_FUNCPTR (gst_round_robin_chain));
+  gst_pad_set_chain_list_function (pad,
+      GST_DEBUG_FUNCPTR (gst_round_robin_chain_list));
 }
 
 static void
@@ -130,8 +297,11 @@ gst_round_robin_class_init (GstRoundRobinClass * klass)
       "Nicolas Dufresne <nicolas.dufresne@collabora.com");
 
   gst_element_class_add_static_pad_template (element_class, &sink_templ);
-  gst_element_class_add_static_pad_template (element_class, &src_templ);
+  gst_element_class_add_static_pad_template_with_gtype (element_class,
+      &src_templ, GST_TYPE_ROUND_ROBIN_PAD);
 
   element_class->request_new_pad =
       GST_DEBUG_FUNCPTR (gst_round_robin_request_pad);
+
+  gst_type_mark_as_plugin_api (GST_TYPE_ROUND_ROBIN_PAD, 0);
 }
@@ -30,6 +30,11 @@ typedef struct {
   GstElementClass parent;
 } GstRoundRobinClass;
 GType gst_round_robin_get_type (void);
+
+#define GST_TYPE_ROUND_ROBIN_PAD (gst_round_robin_pad_get_type())
+G_DECLARE_FINAL_TYPE (GstRoundRobinPad, gst_round_robin_pad, GST,
+    ROUND_ROBIN_PAD, GstPad);
+
 GST_ELEMENT_REGISTER_DECLARE (roundrobin);
 
 #endif
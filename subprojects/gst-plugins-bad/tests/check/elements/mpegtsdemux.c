@@ -18,10 +18,14 @@
  * Boston, MA 02110-1301, USA.
  */
 
+#include <string.h>
+
 #include <gst/gst.h>
 #include <gst/check/gstcheck.h>
 #include <gst/check/gstharness.h>
 
+#include "../../../gst/mpegtsdemux/mpegtsbase.h"
+
 #define PACKETSIZE 188
 
 /* Output of the following pipeline, split into standard 188-bytes packets:
@@ -377,6 +381,303 @@ GST_START_TEST (test_tsdemux_simple)
 
 GST_END_TEST;
 
+/* A multiplex with one program whose video stream carries the PCR, mixed
+ * with packets on PIDs that are not in the PAT. One of those PIDs carries a
+ * PCR of its own, and a sync byte in the middle of a run of them is broken.
+ * tsdemux skips the unwanted packets without parsing them, its subclass
+ * below inspects every packet and so goes through the normal path. Both
+ * have to see the same PCRs at the same offsets and output the same. */
+#define PMT_PID 0x100
+#define VIDEO_PID 0x101
+#define FIRST_FILLER_PID 0x200
+#define N_FILLER_PIDS 3
+#define FILLER_PCR_PID 0x210
+#define N_FRAMES 8
+#define VIDEO_PACKETS_PER_FRAME 4
+#define FILLER_PACKETS_PER_VIDEO (N_FILLER_PIDS + 1)
+#define PACKETS_PER_FRAME \
+  (VIDEO_PACKETS_PER_FRAME * (1 + FILLER_PACKETS_PER_VIDEO))
+#define N_PACKETS (2 + N_FRAMES * PACKETS_PER_FRAME)
+#define PACKETS_PER_BUFFER 7
+
+typedef struct
+{
+  guint8 *data;
+  gsize pos;
+  guint8 cc[0x2000];
+} Mux;
+
+static guint32
+crc32_mpeg (const guint8 * data, gsize size)
+{
+  guint32 crc = 0xffffffff;
+  gsize i;
+  gint bit;
+
+  for (i = 0; i < size; i++) {
+    crc ^= (guint32) data[i] << 24;
+    for (bit = 0; bit < 8; bit++)
+      crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04c11db7 : crc << 1;
+  }
+
+  return crc;
+}
+
+static guint8 *
+mux_next_packet (Mux * mux, guint16 pid, gboolean pusi)
+{
+  guint8 *p = mux->data + mux->pos;
+
+  p[0] = 0x47;
+  p[1] = (pusi ? 0x40 : 0x00) | (pid >> 8);
+  p[2] = pid & 0xff;
+  p[3] = 0x10 | (mux->cc[pid]++ & 0x0f);
+  memset (p + 4, 0xff, 184);
+  mux->pos += PACKETSIZE;
+
+  return p;
+}
+
+static void
+mux_write_section (Mux * mux, guint16 pid, guint8 table_id, guint16 extension,
+    const guint8 * body, guint body_size)
+{
+  guint8 *p = mux_next_packet (mux, pid, TRUE);
+  guint8 *section = p + 5;
+  guint section_length = 5 + body_size + 4;
+  guint32 crc;
+
+  p[4] = 0;                     /* pointer_field */
+  section[0] = table_id;
+  section[1] = 0xb0 | (section_length >> 8);
+  section[2] = section_length & 0xff;
+  section[3] = extension >> 8;
+  section[4] = extension & 0xff;
+  section[5] = 0xc1;            /* version 0, current */
+  section[6] = 0;               /* section_number */
+  section[7] = 0;               /* last_section_number */
+  memcpy (section + 8, body, body_size);
+
+  crc = crc32_mpeg (section, 8 + body_size);
+  GST_WRITE_UINT32_BE (section + 8 + body_size, crc);
+}
+
+/* writes an adaptation field with only @pcr in it */
+static void
+mux_write_pcr (guint8 * p, guint64 pcr)
+{
+  p[3] |= 0x20;
+  p[4] = 7;
+  p[5] = 0x10;
+  p[6] = pcr >> 25;
+  p[7] = pcr >> 17;
+  p[8] = pcr >> 9;
+  p[9] = pcr >> 1;
+  p[10] = ((pcr & 1) << 7) | 0x7e;
+  p[11] = 0;
+}
+
+static guint8 *
+make_unwanted_pids_ts (void)
+{
+  const guint8 pat[] = {
+    0x00, 0x01, 0xe0 | (PMT_PID >> 8), PMT_PID & 0xff
+  };
+  const guint8 pmt[] = {
+    0xe0 | (VIDEO_PID >> 8), VIDEO_PID & 0xff,  /* PCR PID */
+    0xf0, 0x00,                 /* program_info_length */
+    0x1b, 0xe0 | (VIDEO_PID >> 8), VIDEO_PID & 0xff, 0xf0, 0x00
+  };
+  Mux mux = { 0, };
+  guint frame, i, j;
+
+  mux.data = g_malloc (N_PACKETS * PACKETSIZE);
+  mux_write_section (&mux, 0x0000, 0x00, 1, pat, sizeof (pat));
+  mux_write_section (&mux, PMT_PID, 0x02, 1, pmt, sizeof (pmt));
+
+  for (frame = 0; frame < N_FRAMES; frame++) {
+    guint64 pcr = frame * 3600;
+    guint64 pts = pcr + 9000;
+
+    for (i = 0; i < VIDEO_PACKETS_PER_FRAME; i++) {
+      guint8 *p = mux_next_packet (&mux, VIDEO_PID, i == 0);
+
+      if (i == 0) {
+        mux_write_pcr (p, pcr);
+        p[12] = 0x00;
+        p[13] = 0x00;
+        p[14] = 0x01;
+        p[15] = 0xe0;
+        p[16] = 0x00;
+        p[17] = 0x00;
+        p[18] = 0x80;
+        p[19] = 0x80;
+        p[20] = 5;
+        p[21] = 0x21 | ((pts >> 29) & 0x0e);
+        p[22] = pts >> 22;
+        p[23] = ((pts >> 14) & 0xfe) | 1;
+        p[24] = pts >> 7;
+        p[25] = ((pts << 1) & 0xfe) | 1;
+      }
+      /* every packet of a frame is followed by a run of unwanted ones */
+      for (j = 0; j < N_FILLER_PIDS; j++)
+        mux_next_packet (&mux, FIRST_FILLER_PID + j, FALSE);
+      p = mux_next_packet (&mux, FILLER_PCR_PID, FALSE);
+      mux_write_pcr (p, pcr + 10 * 90000);
+    }
+  }
+  g_assert (mux.pos == N_PACKETS * PACKETSIZE);
+
+  /* lose sync in the middle of a run of unwanted packets */
+  mux.data[(2 + N_FRAMES / 2 * PACKETS_PER_FRAME + 2) * PACKETSIZE] = 0x00;
+
+  return mux.data;
+}
+
+static void
+tsdemux_no_skip_inspect_packet (MpegTSBase * base,
+    MpegTSPacketizerPacket * packet)
+{
+}
+
+static void
+tsdemux_no_skip_class_init (MpegTSBaseClass * klass)
+{
+  /* the unwanted packets are only skipped when nothing inspects them */
+  klass->inspect_packet = tsdemux_no_skip_inspect_packet;
+}
+
+static GType
+tsdemux_no_skip_get_type (void)
+{
+  static GType type = 0;
+
+  if (!type) {
+    GstElement *tsdemux = gst_element_factory_make ("tsdemux", NULL);
+    GTypeQuery query;
+
+    fail_unless (tsdemux != NULL);
+    g_type_query (G_OBJECT_TYPE (tsdemux), &query);
+    type = g_type_register_static_simple (G_OBJECT_TYPE (tsdemux),
+        "GstTSDemuxNoSkip", query.class_size,
+        (GClassInitFunc) tsdemux_no_skip_class_init, query.instance_size,
+        NULL, 0);
+    gst_object_unref (tsdemux);
+  }
+
+  return type;
+}
+
+static void
+tsdemux_unwanted_pad_added (GstElement * tsdemux, GstPad * pad, GstHarness * h)
+{
+  fail_unless (g_str_has_prefix (GST_PAD_NAME (pad), "video_"));
+  gst_harness_add_element_src_pad (h, pad);
+}
+
+/* returns the segment event and the buffers that came out of @tsdemux */
+static GPtrArray *
+run_unwanted_pids (GstElement * tsdemux, const guint8 * data)
+{
+  GstHarness *h = gst_harness_new_with_element (tsdemux, "sink", NULL);
+  GPtrArray *output = g_ptr_array_new_with_free_func (
+      (GDestroyNotify) gst_mini_object_unref);
+  GstSegment segment;
+  GstCaps *caps;
+  GstEvent *event;
+  GstBuffer *buf;
+  gsize offset, size = N_PACKETS * PACKETSIZE;
+
+  caps = gst_caps_from_string ("video/mpegts,systemstream=true");
+  gst_harness_push_event (h, gst_event_new_caps (caps));
+  gst_caps_unref (caps);
+
+  /* PCRs are matched with offsets in BYTES */
+  gst_segment_init (&segment, GST_FORMAT_BYTES);
+  gst_harness_push_event (h, gst_event_new_segment (&segment));
+
+  gst_harness_set_sink_caps_str (h, "video/x-h264");
+  g_signal_connect (tsdemux, "pad-added",
+      G_CALLBACK (tsdemux_unwanted_pad_added), h);
+
+  for (offset = 0; offset < size; offset += PACKETS_PER_BUFFER * PACKETSIZE) {
+    gsize len = MIN (PACKETS_PER_BUFFER * PACKETSIZE, size - offset);
+
+    buf = gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY,
+        (guint8 *) data, size, offset, len, NULL, NULL);
+    fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+  }
+  gst_harness_push_event (h, gst_event_new_eos ());
+
+  while ((event = gst_harness_try_pull_event (h))) {
+    if (GST_EVENT_TYPE (event) == GST_EVENT_SEGMENT)
+      g_ptr_array_add (output, event);
+    else
+      gst_event_unref (event);
+  }
+  while ((buf = gst_harness_try_pull (h)))
+    g_ptr_array_add (output, buf);
+
+  gst_harness_teardown (h);
+
+  return output;
+}
+
+GST_START_TEST (test_tsdemux_unwanted_pids)
+{
+  guint8 *data = make_unwanted_pids_ts ();
+  GstElement *tsdemux;
+  GPtrArray *skipped, *parsed;
+  guint i;
+
+  tsdemux = gst_element_factory_make ("tsdemux", NULL);
+  skipped = run_unwanted_pids (tsdemux, data);
+  gst_object_unref (tsdemux);
+
+  tsdemux = g_object_new (tsdemux_no_skip_get_type (), NULL);
+  parsed = run_unwanted_pids (tsdemux, data);
+  gst_object_unref (tsdemux);
+
+  /* one segment and at least the frames on either side of the sync loss */
+  fail_unless (skipped->len > N_FRAMES / 2);
+  fail_unless_equals_int (skipped->len, parsed->len);
+
+  for (i = 0; i < skipped->len; i++) {
+    GstMiniObject *a = g_ptr_array_index (skipped, i);
+    GstMiniObject *b = g_ptr_array_index (parsed, i);
+
+    if (GST_IS_EVENT (a)) {
+      const GstSegment *segment_a, *segment_b;
+
+      fail_unless (GST_IS_EVENT (b));
+      gst_event_parse_segment (GST_EVENT (a), &segment_a);
+      gst_event_parse_segment (GST_EVENT (b), &segment_b);
+      fail_unless (gst_segment_is_equal (segment_a, segment_b));
+    } else {
+      GstBuffer *buf_a = GST_BUFFER (a), *buf_b = GST_BUFFER (b);
+      GstMapInfo map;
+
+      fail_unless (GST_IS_BUFFER (b));
+      fail_unless_equals_clocktime (GST_BUFFER_PTS (buf_a),
+          GST_BUFFER_PTS (buf_b));
+      fail_unless_equals_clocktime (GST_BUFFER_DTS (buf_a),
+          GST_BUFFER_DTS (buf_b));
+      fail_unless_equals_int (GST_BUFFER_IS_DISCONT (buf_a),
+          GST_BUFFER_IS_DISCONT (buf_b));
+
+      gst_buffer_map (buf_a, &map, GST_MAP_READ);
+      gst_check_buffer_data (buf_b, map.data, map.size);
+      gst_buffer_unmap (buf_a, &map);
+    }
+  }
+
+  g_ptr_array_unref (skipped);
+  g_ptr_array_unref (parsed);
+  g_free (data);
+}
+
+GST_END_TEST;
+
 static Suite *
 mpegtsdemux_suite (void)
 {
@@ -394,6 +695,7 @@ mpegtsdemux_suite (void)
   tc = tcase_create ("tsdemux");
   suite_add_tcase (s, tc);
   tcase_add_test (tc, test_tsdemux_simple);
+  tcase_add_test (tc, test_tsdemux_unwanted_pids);
 
   return s;
 }
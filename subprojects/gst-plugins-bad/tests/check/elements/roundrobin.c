@@ -0,0 +1,176 @@
+/*
+ * roundrobin.c
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gst/check/check.h>
+
+#define N_BUFFERS 8
+
+static GstBuffer *
+make_buffer (guint64 offset)
+{
+  GstBuffer *buf = gst_buffer_new ();
+
+  GST_BUFFER_OFFSET (buf) = offset;
+
+  return buf;
+}
+
+static void
+set_weight (GstHarness * h, const gchar * pad_name, guint weight)
+{
+  GstPad *pad = gst_element_get_static_pad (h->element, pad_name);
+
+  fail_unless (pad != NULL);
+  g_object_set (pad, "weight", weight, NULL);
+  gst_object_unref (pad);
+}
+
+/* checks that @h received exactly the buffers with the given offsets */
+static void
+pull_and_check (GstHarness * h, const guint64 * offsets, guint n_offsets)
+{
+  guint i;
+
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), n_offsets);
+
+  for (i = 0; i < n_offsets; i++) {
+    GstBuffer *buf = gst_harness_pull (h);
+
+    fail_unless_equals_uint64 (GST_BUFFER_OFFSET (buf), offsets[i]);
+    gst_buffer_unref (buf);
+  }
+}
+
+static GstPadProbeReturn
+count_lists (GstPad * pad, GstPadProbeInfo * info, gint * n_lists)
+{
+  *n_lists += 1;
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+check_weighted_split (gboolean as_list)
+{
+  static const guint64 offsets_0[] = { 0, 1, 3, 4, 5, 7 };
+  static const guint64 offsets_1[] = { 2, 6 };
+  GstHarness *h, *h_0, *h_1;
+  gint n_lists[2] = { 0, 0 };
+  guint i;
+
+  h = gst_harness_new_with_padnames ("roundrobin", "sink", NULL);
+  h_0 = gst_harness_new_with_element (h->element, NULL, "src_0");
+  h_1 = gst_harness_new_with_element (h->element, NULL, "src_1");
+  gst_harness_set_src_caps_str (h, "application/x-test");
+
+  set_weight (h, "src_0", 3);
+
+  if (as_list) {
+    GstBufferList *list = gst_buffer_list_new ();
+    GstPad *pad;
+
+    pad = gst_element_get_static_pad (h->element, "src_0");
+    gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER_LIST,
+        (GstPadProbeCallback) count_lists, &n_lists[0], NULL);
+    gst_object_unref (pad);
+    pad = gst_element_get_static_pad (h->element, "src_1");
+    gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER_LIST,
+        (GstPadProbeCallback) count_lists, &n_lists[1], NULL);
+    gst_object_unref (pad);
+
+    for (i = 0; i < N_BUFFERS; i++)
+      gst_buffer_list_add (list, make_buffer (i));
+    fail_unless_equals_int (gst_harness_push_list (h, list), GST_FLOW_OK);
+
+    /* each pad gets its share in a single push */
+    fail_unless_equals_int (n_lists[0], 1);
+    fail_unless_equals_int (n_lists[1], 1);
+  } else {
+    for (i = 0; i < N_BUFFERS; i++)
+      fail_unless_equals_int (gst_harness_push (h, make_buffer (i)),
+          GST_FLOW_OK);
+  }
+
+  /* 3:1, interleaved as a a b a */
+  pull_and_check (h_0, offsets_0, G_N_ELEMENTS (offsets_0));
+  pull_and_check (h_1, offsets_1, G_N_ELEMENTS (offsets_1));
+
+  gst_harness_teardown (h_0);
+  gst_harness_teardown (h_1);
+  gst_harness_teardown (h);
+}
+
+GST_START_TEST (test_weighted)
+{
+  check_weighted_split (FALSE);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_weighted_list)
+{
+  check_weighted_split (TRUE);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_equal_weights)
+{
+  static const guint64 offsets[3][2] = { {0, 3}, {1, 4}, {2, 5} };
+  GstHarness *h, *h_src[3];
+  guint i;
+
+  h = gst_harness_new_with_padnames ("roundrobin", "sink", NULL);
+  for (i = 0; i < 3; i++) {
+    gchar *name = g_strdup_printf ("src_%u", i);
+
+    h_src[i] = gst_harness_new_with_element (h->element, NULL, name);
+    g_free (name);
+  }
+  gst_harness_set_src_caps_str (h, "application/x-test");
+
+  /* with the default weights, the pads take turns */
+  for (i = 0; i < 6; i++)
+    fail_unless_equals_int (gst_harness_push (h, make_buffer (i)),
+        GST_FLOW_OK);
+
+  for (i = 0; i < 3; i++) {
+    pull_and_check (h_src[i], offsets[i], 2);
+    gst_harness_teardown (h_src[i]);
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static Suite *
+roundrobin_suite (void)
+{
+  Suite *s = suite_create ("roundrobin");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (s, tc);
+
+  tcase_add_test (tc, test_equal_weights);
+  tcase_add_test (tc, test_weighted);
+  tcase_add_test (tc, test_weighted_list);
+
+  return s;
+}
+
+GST_CHECK_MAIN (roundrobin);
@@ -0,0 +1,239 @@
+/*
+ * sctpenc.c
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+
+#include <gst/check/check.h>
+
+#define N_STREAMS 2
+#define N_BUFFERS 64
+#define TIMEOUT (10 * G_TIME_SPAN_SECOND)
+
+/* Two associations talking to each other in the same process: the packets
+ * of association 1 go out through enc1 and come in through dec2, and the
+ * other way around. */
+#define PIPELINE \
+  "sctpenc name=enc1 sctp-association-id=1 remote-sctp-port=5000 " \
+  "! sctpdec name=dec2 sctp-association-id=2 local-sctp-port=5000 " \
+  "sctpenc name=enc2 sctp-association-id=2 remote-sctp-port=5000 " \
+  "! sctpdec name=dec1 sctp-association-id=1 local-sctp-port=5000"
+
+typedef struct
+{
+  GMutex lock;
+  GCond cond;
+  GstElement *pipeline;
+  gboolean established;
+  GPtrArray *received[N_STREAMS];
+} TestData;
+
+static void
+on_established (GstElement * enc, gboolean established, TestData * data)
+{
+  g_mutex_lock (&data->lock);
+  data->established = established;
+  g_cond_broadcast (&data->cond);
+  g_mutex_unlock (&data->lock);
+}
+
+static GstPadProbeReturn
+on_received (GstPad * pad, GstPadProbeInfo * info, TestData * data)
+{
+  guint stream_id;
+
+  fail_unless (sscanf (GST_PAD_NAME (pad), "src_%u", &stream_id) == 1);
+  fail_unless (stream_id < N_STREAMS);
+
+  g_mutex_lock (&data->lock);
+  g_ptr_array_add (data->received[stream_id],
+      gst_buffer_ref (GST_PAD_PROBE_INFO_BUFFER (info)));
+  g_cond_broadcast (&data->cond);
+  g_mutex_unlock (&data->lock);
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+on_pad_added (GstElement * dec, GstPad * pad, TestData * data)
+{
+  GstElement *sink = gst_element_factory_make ("fakesink", NULL);
+  GstPad *sinkpad;
+
+  g_object_set (sink, "async", FALSE, NULL);
+  gst_bin_add (GST_BIN (data->pipeline), sink);
+  gst_element_sync_state_with_parent (sink);
+
+  sinkpad = gst_element_get_static_pad (sink, "sink");
+  fail_unless_equals_int (gst_pad_link (pad, sinkpad), GST_PAD_LINK_OK);
+  gst_object_unref (sinkpad);
+
+  gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER,
+      (GstPadProbeCallback) on_received, data, NULL);
+}
+
+/* returns a pad that pushes into a new sink pad of @enc for @stream_id */
+static GstPad *
+setup_stream (GstElement * enc, guint stream_id)
+{
+  GstPad *srcpad, *sinkpad;
+  GstSegment segment;
+  gchar *name;
+
+  name = g_strdup_printf ("sink_%u", stream_id);
+  sinkpad = gst_element_request_pad_simple (enc, name);
+  g_free (name);
+  fail_unless (sinkpad != NULL);
+
+  srcpad = gst_pad_new ("src", GST_PAD_SRC);
+  fail_unless_equals_int (gst_pad_link (srcpad, sinkpad), GST_PAD_LINK_OK);
+  gst_object_unref (sinkpad);
+  gst_pad_set_active (srcpad, TRUE);
+
+  gst_segment_init (&segment, GST_FORMAT_BYTES);
+  fail_unless (gst_pad_push_event (srcpad,
+          gst_event_new_stream_start ("sctpenc-test")));
+  fail_unless (gst_pad_push_event (srcpad,
+          gst_event_new_caps (gst_caps_new_empty_simple ("application/data"))));
+  fail_unless (gst_pad_push_event (srcpad, gst_event_new_segment (&segment)));
+
+  return srcpad;
+}
+
+static GstBufferList *
+make_list (guint stream_id)
+{
+  GstBufferList *list = gst_buffer_list_new_sized (N_BUFFERS);
+  guint i;
+
+  for (i = 0; i < N_BUFFERS; i++) {
+    guint8 data[8];
+
+    GST_WRITE_UINT32_BE (data, stream_id);
+    GST_WRITE_UINT32_BE (data + 4, i);
+    gst_buffer_list_add (list, gst_buffer_new_memdup (data, sizeof (data)));
+  }
+
+  return list;
+}
+
+static gpointer
+push_list_thread (GstPad * srcpad)
+{
+  guint stream_id = GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (srcpad),
+          "stream-id"));
+
+  return GINT_TO_POINTER (gst_pad_push_list (srcpad, make_list (stream_id)));
+}
+
+/* Both pads push a list at the same time. Each of them waits for its turn
+ * once and then sends its whole list, the other one gets its turn after
+ * that. Every message has to arrive, in order, on the right stream. */
+GST_START_TEST (test_concurrent_lists)
+{
+  TestData data = { 0, };
+  GstElement *enc1, *dec2;
+  GstPad *srcpads[N_STREAMS];
+  GThread *threads[N_STREAMS];
+  gint64 end_time;
+  guint i, j;
+
+  g_mutex_init (&data.lock);
+  g_cond_init (&data.cond);
+  for (i = 0; i < N_STREAMS; i++)
+    data.received[i] = g_ptr_array_new_with_free_func (
+        (GDestroyNotify) gst_buffer_unref);
+
+  data.pipeline = gst_parse_launch (PIPELINE, NULL);
+  fail_unless (data.pipeline != NULL);
+  enc1 = gst_bin_get_by_name (GST_BIN (data.pipeline), "enc1");
+  dec2 = gst_bin_get_by_name (GST_BIN (data.pipeline), "dec2");
+  g_signal_connect (enc1, "sctp-association-established",
+      G_CALLBACK (on_established), &data);
+  g_signal_connect (dec2, "pad-added", G_CALLBACK (on_pad_added), &data);
+
+  fail_unless (gst_element_set_state (data.pipeline, GST_STATE_PLAYING) !=
+      GST_STATE_CHANGE_FAILURE);
+
+  end_time = g_get_monotonic_time () + TIMEOUT;
+  g_mutex_lock (&data.lock);
+  while (!data.established)
+    fail_unless (g_cond_wait_until (&data.cond, &data.lock, end_time));
+  g_mutex_unlock (&data.lock);
+
+  for (i = 0; i < N_STREAMS; i++) {
+    srcpads[i] = setup_stream (enc1, i);
+    g_object_set_data (G_OBJECT (srcpads[i]), "stream-id",
+        GUINT_TO_POINTER (i));
+  }
+  for (i = 0; i < N_STREAMS; i++)
+    threads[i] = g_thread_new ("push-list", (GThreadFunc) push_list_thread,
+        srcpads[i]);
+  for (i = 0; i < N_STREAMS; i++)
+    fail_unless_equals_int (GPOINTER_TO_INT (g_thread_join (threads[i])),
+        GST_FLOW_OK);
+
+  end_time = g_get_monotonic_time () + TIMEOUT;
+  g_mutex_lock (&data.lock);
+  for (i = 0; i < N_STREAMS; i++) {
+    while (data.received[i]->len < N_BUFFERS)
+      fail_unless (g_cond_wait_until (&data.cond, &data.lock, end_time));
+  }
+  g_mutex_unlock (&data.lock);
+
+  fail_unless_equals_int (gst_element_set_state (data.pipeline,
+          GST_STATE_NULL), GST_STATE_CHANGE_SUCCESS);
+
+  for (i = 0; i < N_STREAMS; i++) {
+    fail_unless_equals_int (data.received[i]->len, N_BUFFERS);
+
+    for (j = 0; j < N_BUFFERS; j++) {
+      GstBuffer *buf = g_ptr_array_index (data.received[i], j);
+      guint8 expected[8];
+
+      GST_WRITE_UINT32_BE (expected, i);
+      GST_WRITE_UINT32_BE (expected + 4, j);
+      gst_check_buffer_data (buf, expected, sizeof (expected));
+    }
+
+    gst_element_release_request_pad (enc1, GST_PAD_PEER (srcpads[i]));
+    gst_object_unref (srcpads[i]);
+    g_ptr_array_unref (data.received[i]);
+  }
+
+  gst_object_unref (enc1);
+  gst_object_unref (dec2);
+  gst_object_unref (data.pipeline);
+  g_mutex_clear (&data.lock);
+  g_cond_clear (&data.cond);
+}
+
+GST_END_TEST;
+
+static Suite *
+sctpenc_suite (void)
+{
+  Suite *s = suite_create ("sctpenc");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (s, tc);
+
+  tcase_add_test (tc, test_concurrent_lists);
+
+  return s;
+}
+
+GST_CHECK_MAIN (sctpenc);
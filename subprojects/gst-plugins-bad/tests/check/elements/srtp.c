@@ -30,6 +30,7 @@
 #include <gst/check/gstcheck.h>
 
 #include <gst/check/gstharness.h>
+#include <gst/rtp/gstrtpbuffer.h>
 
 GST_START_TEST (test_create_and_unref)
 {
@@ -249,6 +250,102 @@ GST_START_TEST (test_roc)
 
 GST_END_TEST;
 
+static GstPadProbeReturn
+count_buffer_lists_probe (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  guint *n_lists = user_data;
+
+  (*n_lists)++;
+  return GST_PAD_PROBE_OK;
+}
+
+/* A list of SRTP packets must come out decrypted as one list */
+GST_START_TEST (test_srtpdec_buffer_list)
+{
+  static const char CAPS_RTP[] =
+      "application/x-rtp, payload=(int)8, ssrc=(uint)1356955624";
+  static const char CAPS_SRTP[] =
+      "application/x-srtp, payload=(int)8, ssrc=(uint)1356955624, srtp-key=(buffer)012345678901234567890123456789012345678901234567890123456789, srtp-cipher=(string)aes-128-icm, srtp-auth=(string)hmac-sha1-80, srtcp-cipher=(string)aes-128-icm, srtcp-auth=(string)hmac-sha1-80";
+  static const guint8 KEY[] = {
+    0x01, 0x23, 0x45, 0x67, 0x89, 0x01, 0x23, 0x45, 0x67, 0x89,
+    0x01, 0x23, 0x45, 0x67, 0x89, 0x01, 0x23, 0x45, 0x67, 0x89,
+    0x01, 0x23, 0x45, 0x67, 0x89, 0x01, 0x23, 0x45, 0x67, 0x89
+  };
+  GstElement *enc;
+  GstHarness *enc_h, *dec_h;
+  GstBufferList *list;
+  GstBuffer *key;
+  GstPad *pad;
+  guint n_lists = 0;
+  guint i;
+
+  enc = gst_element_factory_make ("srtpenc", NULL);
+  fail_unless (enc != NULL);
+  key = gst_buffer_new_memdup (KEY, sizeof (KEY));
+  g_object_set (enc, "key", key, NULL);
+  gst_buffer_unref (key);
+
+  enc_h = gst_harness_new_with_element (enc, "rtp_sink_0", "rtp_src_0");
+  gst_harness_set_src_caps_str (enc_h, CAPS_RTP);
+  gst_object_unref (enc);
+
+  dec_h = gst_harness_new_with_padnames ("srtpdec", "rtp_sink", "rtp_src");
+  gst_harness_set_caps_str (dec_h, CAPS_SRTP, CAPS_RTP);
+
+  pad = gst_element_get_static_pad (dec_h->element, "rtp_src");
+  gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      count_buffer_lists_probe, &n_lists, NULL);
+  gst_object_unref (pad);
+
+  /* encrypt packets with payloads of 0, 1, 2, ... */
+  list = gst_buffer_list_new ();
+  for (i = 0; i < 10; i++) {
+    GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+    GstBuffer *buf;
+
+    buf = gst_rtp_buffer_new_allocate (16, 0, 0);
+    gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp);
+    gst_rtp_buffer_set_payload_type (&rtp, 8);
+    gst_rtp_buffer_set_ssrc (&rtp, 1356955624);
+    gst_rtp_buffer_set_seq (&rtp, i);
+    memset (gst_rtp_buffer_get_payload (&rtp), i, 16);
+    gst_rtp_buffer_unmap (&rtp);
+
+    buf = gst_harness_push_and_pull (enc_h, buf);
+    fail_unless (buf != NULL);
+    fail_unless (gst_buffer_get_size (buf) > 12 + 16);
+    gst_buffer_list_add (list, buf);
+  }
+
+  fail_unless_equals_int (gst_pad_push_list (dec_h->srcpad, list),
+      GST_FLOW_OK);
+  fail_unless_equals_int (n_lists, 1);
+
+  for (i = 0; i < 10; i++) {
+    GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+    GstBuffer *buf;
+    guint8 expected[16];
+
+    memset (expected, i, 16);
+
+    buf = gst_harness_pull (dec_h);
+    fail_unless (buf != NULL);
+    fail_unless (gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp));
+    fail_unless_equals_int (gst_rtp_buffer_get_seq (&rtp), i);
+    fail_unless_equals_int (gst_rtp_buffer_get_payload_len (&rtp), 16);
+    fail_unless (memcmp (gst_rtp_buffer_get_payload (&rtp), expected,
+            16) == 0);
+    gst_rtp_buffer_unmap (&rtp);
+    gst_buffer_unref (buf);
+  }
+
+  gst_harness_teardown (enc_h);
+  gst_harness_teardown (dec_h);
+}
+
+GST_END_TEST;
+
 #ifdef HAVE_SRTP2
 
 GST_START_TEST (test_simple_mki)
@@ -395,6 +492,7 @@ srtp_suite (void)
   tcase_add_test (tc_chain, test_play);
   tcase_add_test (tc_chain, test_roc);
   tcase_add_test (tc_chain, test_play_key_error);
+  tcase_add_test (tc_chain, test_srtpdec_buffer_list);
 #ifdef HAVE_SRTP2
   tcase_add_test (tc_chain, test_simple_mki);
   tcase_add_test (tc_chain, test_srtpdec_multiple_mki);
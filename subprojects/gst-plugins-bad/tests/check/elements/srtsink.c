@@ -0,0 +1,294 @@
+/* GStreamer unit tests for srtsink
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gio/gio.h>
+#include <srt/srt.h>
+#include <stdbool.h>
+
+#define LISTENER_PORT 17023
+#define PACKET_SIZE 1316
+#define LATENCY_MS 20
+#define N_READERS 3
+#define MAX_CALLER_QUEUE_BYTES (512 * 1024)
+/* How far the readers may fall behind before pushing waits for them. Well
+ * below the queue limit, so that only the stalled caller can hit it. */
+#define MAX_READER_LAG (64 * 1024)
+/* Give up if the stalled caller was not dropped after this much data */
+#define MAX_PUSHED_BYTES (16 * 1024 * 1024)
+
+typedef struct
+{
+  GMutex lock;
+  GCond cond;
+  guint n_added;
+  guint n_removed;
+  guint16 removed_port;
+} CallerState;
+
+typedef struct
+{
+  SRTSOCKET sock;
+  GThread *thread;
+  gint received;
+  gint stop;
+} Reader;
+
+static void
+caller_added_cb (GstElement * sink, gint unused, GSocketAddress * addr,
+    CallerState * state)
+{
+  g_mutex_lock (&state->lock);
+  state->n_added++;
+  g_cond_broadcast (&state->cond);
+  g_mutex_unlock (&state->lock);
+}
+
+static void
+caller_removed_cb (GstElement * sink, gint unused, GSocketAddress * addr,
+    CallerState * state)
+{
+  g_mutex_lock (&state->lock);
+  state->n_removed++;
+  state->removed_port =
+      g_inet_socket_address_get_port (G_INET_SOCKET_ADDRESS (addr));
+  g_cond_broadcast (&state->cond);
+  g_mutex_unlock (&state->lock);
+}
+
+static SRTSOCKET
+connect_caller (gboolean stalled)
+{
+  SRTSOCKET sock = srt_create_socket ();
+  GSocketAddress *addr;
+  struct sockaddr_storage native;
+  gint latency = LATENCY_MS;
+  gint timeout = 100;
+  bool no_tlpktdrop = false;
+
+  fail_unless (sock != SRT_INVALID_SOCK);
+
+  fail_if (srt_setsockflag (sock, SRTO_LATENCY, &latency, sizeof latency));
+  fail_if (srt_setsockflag (sock, SRTO_TLPKTDROP, &no_tlpktdrop,
+          sizeof no_tlpktdrop));
+  fail_if (srt_setsockflag (sock, SRTO_RCVTIMEO, &timeout, sizeof timeout));
+
+  if (stalled) {
+    /* Keep the receive side of the stalled caller as small as possible, so
+     * that its data piles up on the sender soon */
+    gint fc = 32;
+    gint rcvbuf = 32 * (1500 - 28);
+
+    fail_if (srt_setsockflag (sock, SRTO_FC, &fc, sizeof fc));
+    fail_if (srt_setsockflag (sock, SRTO_RCVBUF, &rcvbuf, sizeof rcvbuf));
+  }
+
+  addr = g_inet_socket_address_new_from_string ("127.0.0.1", LISTENER_PORT);
+  fail_unless (g_socket_address_to_native (addr, &native, sizeof native,
+          NULL));
+  fail_if (srt_connect (sock, (struct sockaddr *) &native,
+          g_socket_address_get_native_size (addr)) == SRT_ERROR,
+      "%s", srt_getlasterror_str ());
+  g_object_unref (addr);
+
+  return sock;
+}
+
+static guint16
+get_local_port (SRTSOCKET sock)
+{
+  struct sockaddr_storage native;
+  gint len = sizeof native;
+  GSocketAddress *addr;
+  guint16 port;
+
+  fail_if (srt_getsockname (sock, (struct sockaddr *) &native, &len));
+  addr = g_socket_address_new_from_native (&native, len);
+  port = g_inet_socket_address_get_port (G_INET_SOCKET_ADDRESS (addr));
+  g_object_unref (addr);
+
+  return port;
+}
+
+static gpointer
+reader_thread (Reader * reader)
+{
+  gchar data[1500];
+
+  while (!g_atomic_int_get (&reader->stop)) {
+    gint len = srt_recvmsg (reader->sock, data, sizeof data);
+
+    if (len < 0) {
+      if (srt_getlasterror (NULL) == SRT_EASYNCRCV)
+        continue;
+      break;
+    }
+    g_atomic_int_add (&reader->received, len);
+  }
+
+  return NULL;
+}
+
+static gint
+min_received (Reader * readers)
+{
+  gint i, min = G_MAXINT;
+
+  for (i = 0; i < N_READERS; i++)
+    min = MIN (min, g_atomic_int_get (&readers[i].received));
+
+  return min;
+}
+
+static void
+wait_for_readers (Reader * readers, gint pushed, gint max_lag)
+{
+  gint64 end_time = g_get_monotonic_time () + 5 * G_TIME_SPAN_SECOND;
+
+  while (min_received (readers) < pushed - max_lag) {
+    fail_if (g_get_monotonic_time () > end_time,
+        "readers are stuck at %d of %d bytes", min_received (readers), pushed);
+    g_usleep (1000);
+  }
+}
+
+/* A caller that stops reading must be dropped once more than
+ * max-caller-queue-bytes are queued up for it, while the other callers keep
+ * receiving the complete stream */
+GST_START_TEST (test_listener_drops_stalled_caller)
+{
+  GstElement *sink;
+  GstHarness *h;
+  CallerState state = { 0, };
+  Reader readers[N_READERS] = { {0,}, };
+  SRTSOCKET stalled;
+  guint16 stalled_port;
+  gchar *uri;
+  gint pushed = 0;
+  gint i;
+
+  g_mutex_init (&state.lock);
+  g_cond_init (&state.cond);
+
+  sink = gst_element_factory_make ("srtsink", NULL);
+  fail_unless (sink != NULL);
+
+  uri = g_strdup_printf ("srt://:%u?mode=listener&latency=%u"
+      "&tlpktdrop=false&sndbuf=%u", LISTENER_PORT, LATENCY_MS,
+      64 * (1500 - 28));
+  g_object_set (sink, "uri", uri, "wait-for-connection", FALSE,
+      "max-caller-queue-bytes", MAX_CALLER_QUEUE_BYTES, NULL);
+  g_free (uri);
+
+  g_signal_connect (sink, "caller-added", G_CALLBACK (caller_added_cb),
+      &state);
+  g_signal_connect (sink, "caller-removed", G_CALLBACK (caller_removed_cb),
+      &state);
+
+  h = gst_harness_new_with_element (sink, "sink", NULL);
+  gst_harness_set_src_caps_str (h, "video/mpegts");
+
+  for (i = 0; i < N_READERS; i++) {
+    readers[i].sock = connect_caller (FALSE);
+    readers[i].thread = g_thread_new ("srt-reader",
+        (GThreadFunc) reader_thread, &readers[i]);
+  }
+  stalled = connect_caller (TRUE);
+  stalled_port = get_local_port (stalled);
+
+  g_mutex_lock (&state.lock);
+  while (state.n_added < N_READERS + 1)
+    g_cond_wait (&state.cond, &state.lock);
+  g_mutex_unlock (&state.lock);
+
+  /* Push until the stalled caller was dropped, without letting the readers
+   * fall behind */
+  for (;;) {
+    gboolean dropped;
+
+    fail_unless_equals_int (gst_harness_push (h,
+            gst_harness_create_buffer (h, PACKET_SIZE)), GST_FLOW_OK);
+    pushed += PACKET_SIZE;
+
+    g_mutex_lock (&state.lock);
+    dropped = state.n_removed > 0;
+    g_mutex_unlock (&state.lock);
+    if (dropped)
+      break;
+
+    fail_if (pushed > MAX_PUSHED_BYTES, "stalled caller was not dropped");
+    wait_for_readers (readers, pushed, MAX_READER_LAG);
+  }
+
+  /* Only the stalled caller was dropped, and not before its queue was full */
+  g_mutex_lock (&state.lock);
+  fail_unless_equals_int (state.n_removed, 1);
+  fail_unless_equals_int (state.removed_port, stalled_port);
+  g_mutex_unlock (&state.lock);
+  fail_unless (pushed > MAX_CALLER_QUEUE_BYTES);
+
+  /* The others still get everything, including what comes afterwards */
+  for (i = 0; i < 100; i++) {
+    fail_unless_equals_int (gst_harness_push (h,
+            gst_harness_create_buffer (h, PACKET_SIZE)), GST_FLOW_OK);
+    pushed += PACKET_SIZE;
+    wait_for_readers (readers, pushed, MAX_READER_LAG);
+  }
+  wait_for_readers (readers, pushed, 0);
+
+  for (i = 0; i < N_READERS; i++)
+    fail_unless_equals_int (g_atomic_int_get (&readers[i].received), pushed);
+
+  g_mutex_lock (&state.lock);
+  fail_unless_equals_int (state.n_removed, 1);
+  g_mutex_unlock (&state.lock);
+
+  for (i = 0; i < N_READERS; i++) {
+    g_atomic_int_set (&readers[i].stop, 1);
+    g_thread_join (readers[i].thread);
+    srt_close (readers[i].sock);
+  }
+  srt_close (stalled);
+
+  gst_harness_teardown (h);
+
+  g_cond_clear (&state.cond);
+  g_mutex_clear (&state.lock);
+}
+
+GST_END_TEST;
+
+static Suite *
+srtsink_suite (void)
+{
+  Suite *s = suite_create ("srtsink");
+  TCase *tc_chain;
+
+  suite_add_tcase (s, (tc_chain = tcase_create ("general")));
+  tcase_set_timeout (tc_chain, 60);
+  tcase_add_test (tc_chain, test_listener_drops_stalled_caller);
+
+  return s;
+}
+
+GST_CHECK_MAIN (srtsink)
@@ -1813,6 +1813,140 @@ GST_START_TEST (test_stats_with_stream)
 
 GST_END_TEST;
 
+static GstStructure *
+get_stats_sync (GstElement * webrtc)
+{
+  GstPromise *p = gst_promise_new ();
+  GstStructure *stats;
+
+  g_signal_emit_by_name (webrtc, "get-stats", NULL, p);
+  fail_unless_equals_int (gst_promise_wait (p), GST_PROMISE_RESULT_REPLIED);
+  stats = gst_structure_copy (gst_promise_get_reply (p));
+  gst_promise_unref (p);
+
+  validate_stats (stats);
+
+  return stats;
+}
+
+static gboolean
+has_same_stats_entry (GQuark field_id, const GValue * value,
+    const GstStructure * other)
+{
+  const GstStructure *s = gst_value_get_structure (value);
+  GstStructure *other_s;
+  GstWebRTCStatsType type, other_type;
+
+  fail_unless (gst_structure_get (other, g_quark_to_string (field_id),
+          GST_TYPE_STRUCTURE, &other_s, NULL));
+  fail_unless (gst_structure_get (s, "type", GST_TYPE_WEBRTC_STATS_TYPE,
+          &type, NULL));
+  fail_unless (gst_structure_get (other_s, "type", GST_TYPE_WEBRTC_STATS_TYPE,
+          &other_type, NULL));
+  fail_unless_equals_int (type, other_type);
+  gst_structure_free (other_s);
+
+  return TRUE;
+}
+
+/* returns the codec stats of @pad_name without the timestamp */
+static GstStructure *
+get_codec_stats (const GstStructure * stats, const gchar * pad_name)
+{
+  GstStructure *codec;
+  gchar *id = g_strdup_printf ("codec-stats-%s", pad_name);
+
+  fail_unless (gst_structure_get (stats, id, GST_TYPE_STRUCTURE, &codec,
+          NULL));
+  gst_structure_remove_field (codec, "timestamp");
+  g_free (id);
+
+  return codec;
+}
+
+GST_START_TEST (test_stats_codec_cache)
+{
+  struct test_webrtc *t = create_audio_test ();
+  GstStructure *first, *second, *third;
+  GstStructure *codec1, *codec2, *codec3;
+  GstCaps *caps;
+  GstPad *pad;
+  guint pt, clock_rate;
+
+  /* test that the cached codec stats and the stats shared per session give
+   * the same report on every call, and that new caps update the codec
+   * stats */
+
+  t->on_offer_created = NULL;
+  t->on_answer_created = NULL;
+  t->on_negotiation_needed = NULL;
+
+  fail_if (gst_element_set_state (t->webrtc1,
+          GST_STATE_READY) == GST_STATE_CHANGE_FAILURE);
+  fail_if (gst_element_set_state (t->webrtc2,
+          GST_STATE_READY) == GST_STATE_CHANGE_FAILURE);
+
+  test_webrtc_create_offer (t);
+
+  fail_if (gst_element_set_state (t->webrtc1,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+  fail_if (gst_element_set_state (t->webrtc2,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+
+  caps = gst_caps_from_string (OPUS_RTP_CAPS (96));
+  pad = gst_element_get_static_pad (t->webrtc1, "sink_0");
+  gst_pad_set_caps (pad, caps);
+  gst_caps_unref (caps);
+
+  test_webrtc_wait_for_answer_error_eos (t);
+  test_webrtc_signal_state (t, STATE_ANSWER_SET);
+
+  first = get_stats_sync (t->webrtc1);
+  second = get_stats_sync (t->webrtc1);
+
+  /* the same entries with the same types, whether built or cached */
+  fail_unless_equals_int (gst_structure_n_fields (first),
+      gst_structure_n_fields (second));
+  gst_structure_foreach (first,
+      (GstStructureForeachFunc) has_same_stats_entry, second);
+
+  codec1 = get_codec_stats (first, "sink_0");
+  codec2 = get_codec_stats (second, "sink_0");
+  fail_unless (gst_structure_is_equal (codec1, codec2));
+  fail_unless (gst_structure_get (codec1, "payload-type", G_TYPE_UINT, &pt,
+          "clock-rate", G_TYPE_UINT, &clock_rate, NULL));
+  fail_unless_equals_int (pt, 96);
+  fail_unless_equals_int (clock_rate, 48000);
+  fail_unless_equals_string (gst_structure_get_string (codec1, "mime-type"),
+      "audio/OPUS");
+  fail_unless_equals_string (gst_structure_get_string (codec1, "codec-type"),
+      "encode");
+
+  /* new caps replace the cached codec stats */
+  caps = gst_caps_from_string (OPUS_RTP_CAPS (97));
+  gst_pad_set_caps (pad, caps);
+  gst_caps_unref (caps);
+
+  third = get_stats_sync (t->webrtc1);
+  codec3 = get_codec_stats (third, "sink_0");
+  fail_unless (gst_structure_get (codec3, "payload-type", G_TYPE_UINT, &pt,
+          NULL));
+  fail_unless_equals_int (pt, 97);
+  fail_unless_equals_string (gst_structure_get_string (codec3, "mime-type"),
+      "audio/OPUS");
+
+  gst_structure_free (codec1);
+  gst_structure_free (codec2);
+  gst_structure_free (codec3);
+  gst_structure_free (first);
+  gst_structure_free (second);
+  gst_structure_free (third);
+  gst_object_unref (pad);
+  test_webrtc_free (t);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_add_transceiver)
 {
   struct test_webrtc *t = test_webrtc_new ();
@@ -2368,6 +2502,34 @@ on_data_channel_close (GObject * channel, GParamSpec * pspec,
   }
 }
 
+static void
+check_data_channel_stats (GstElement * webrtc, guint requested,
+    guint accepted, guint opened, guint closed)
+{
+  GstStructure *stats = get_stats_sync (webrtc);
+  GstStructure *pc_stats;
+  guint val;
+
+  fail_unless (gst_structure_get (stats, "peer-connection-stats",
+          GST_TYPE_STRUCTURE, &pc_stats, NULL));
+
+  fail_unless (gst_structure_get_uint (pc_stats, "data-channels-requested",
+          &val));
+  fail_unless_equals_int (val, requested);
+  fail_unless (gst_structure_get_uint (pc_stats, "data-channels-accepted",
+          &val));
+  fail_unless_equals_int (val, accepted);
+  fail_unless (gst_structure_get_uint (pc_stats, "data-channels-opened",
+          &val));
+  fail_unless_equals_int (val, opened);
+  fail_unless (gst_structure_get_uint (pc_stats, "data-channels-closed",
+          &val));
+  fail_unless_equals_int (val, closed);
+
+  gst_structure_free (pc_stats);
+  gst_structure_free (stats);
+}
+
 GST_START_TEST (test_data_channel_close)
 {
 #define NUM_CHANNELS 3
@@ -2462,6 +2624,13 @@ GST_START_TEST (test_data_channel_close)
   assert_equals_int (channel_id[0], channel_id[1]);
   assert_equals_int (channel_id[0], channel_id[2]);
 
+  /* every channel was created on webrtc1 and announced on webrtc2, and was
+   * open and closed on both */
+  check_data_channel_stats (t->webrtc1, NUM_CHANNELS, 0, NUM_CHANNELS,
+      NUM_CHANNELS);
+  check_data_channel_stats (t->webrtc2, 0, NUM_CHANNELS, NUM_CHANNELS,
+      NUM_CHANNELS);
+
   test_webrtc_free (t);
 #undef NUM_CHANNELS
 }
@@ -5731,6 +5900,7 @@ webrtcbin_suite (void)
     tcase_add_test (tc, test_sdp_no_media);
     tcase_add_test (tc, test_session_stats);
     tcase_add_test (tc, test_stats_with_stream);
+    tcase_add_test (tc, test_stats_codec_cache);
     tcase_add_test (tc, test_audio);
     tcase_add_test (tc, test_ice_port_restriction);
     tcase_add_test (tc, test_audio_video);
@@ -28,6 +28,7 @@
 #include <string.h>
 
 #include "audio-channel-mixer.h"
+#include "gstaudioutilsprivate.h"
 
 #ifndef GST_DISABLE_GST_DEBUG
 #define GST_CAT_DEFAULT ensure_debug_category()
@@ -1005,6 +1006,14 @@ gst_audio_channel_mixer_new (GstAudioChannelMixerFlags flags,
       out_channels, matrix);
 }
 
+/* m[in_channels][out_channels], used by the audio converter to fuse the
+ * channel mix with the other conversion steps */
+gfloat **
+__gst_audio_channel_mixer_get_matrix (GstAudioChannelMixer * mix)
+{
+  return mix->matrix;
+}
+
 /**
  * gst_audio_channel_mixer_is_passthrough:
  * @mix: a #GstAudioChannelMixer
@@ -0,0 +1,380 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "audio-channels-x86-sse2.h"
+
+#if defined (HAVE_EMMINTRIN_H) && defined(__SSE2__)
+#include <emmintrin.h>
+
+/* Interleaving and deinterleaving are both a transpose of a frames x channels
+ * matrix. The samples are only moved around, so every sample format of a
+ * given width is handled by the same integer code.
+ *
+ * The kernels work on square blocks of N channels x N frames, with N the
+ * number of samples in a vector. When the channel count or the number of
+ * frames is not a multiple of N the last block is moved back so that it
+ * overlaps the previous one, the overlapping samples are simply written
+ * twice with the same value. Stereo gets its own kernels for the widths where
+ * N is bigger than 2. */
+
+static inline void
+transpose_8x8_epi8 (__m128i r[8])
+{
+  __m128i a0, a1, a2, a3, b0, b1, b2, b3;
+
+  /* rows are in the lower 64 bits */
+  a0 = _mm_unpacklo_epi8 (r[0], r[1]);
+  a1 = _mm_unpacklo_epi8 (r[2], r[3]);
+  a2 = _mm_unpacklo_epi8 (r[4], r[5]);
+  a3 = _mm_unpacklo_epi8 (r[6], r[7]);
+
+  b0 = _mm_unpacklo_epi16 (a0, a1);
+  b1 = _mm_unpackhi_epi16 (a0, a1);
+  b2 = _mm_unpacklo_epi16 (a2, a3);
+  b3 = _mm_unpackhi_epi16 (a2, a3);
+
+  r[0] = _mm_unpacklo_epi32 (b0, b2);
+  r[2] = _mm_unpackhi_epi32 (b0, b2);
+  r[4] = _mm_unpacklo_epi32 (b1, b3);
+  r[6] = _mm_unpackhi_epi32 (b1, b3);
+  r[1] = _mm_unpackhi_epi64 (r[0], r[0]);
+  r[3] = _mm_unpackhi_epi64 (r[2], r[2]);
+  r[5] = _mm_unpackhi_epi64 (r[4], r[4]);
+  r[7] = _mm_unpackhi_epi64 (r[6], r[6]);
+}
+
+static inline void
+transpose_8x8_epi16 (__m128i r[8])
+{
+  __m128i a0, a1, a2, a3, a4, a5, a6, a7;
+  __m128i b0, b1, b2, b3, b4, b5, b6, b7;
+
+  a0 = _mm_unpacklo_epi16 (r[0], r[1]);
+  a1 = _mm_unpackhi_epi16 (r[0], r[1]);
+  a2 = _mm_unpacklo_epi16 (r[2], r[3]);
+  a3 = _mm_unpackhi_epi16 (r[2], r[3]);
+  a4 = _mm_unpacklo_epi16 (r[4], r[5]);
+  a5 = _mm_unpackhi_epi16 (r[4], r[5]);
+  a6 = _mm_unpacklo_epi16 (r[6], r[7]);
+  a7 = _mm_unpackhi_epi16 (r[6], r[7]);
+
+  b0 = _mm_unpacklo_epi32 (a0, a2);
+  b1 = _mm_unpackhi_epi32 (a0, a2);
+  b2 = _mm_unpacklo_epi32 (a1, a3);
+  b3 = _mm_unpackhi_epi32 (a1, a3);
+  b4 = _mm_unpacklo_epi32 (a4, a6);
+  b5 = _mm_unpackhi_epi32 (a4, a6);
+  b6 = _mm_unpacklo_epi32 (a5, a7);
+  b7 = _mm_unpackhi_epi32 (a5, a7);
+
+  r[0] = _mm_unpacklo_epi64 (b0, b4);
+  r[1] = _mm_unpackhi_epi64 (b0, b4);
+  r[2] = _mm_unpacklo_epi64 (b1, b5);
+  r[3] = _mm_unpackhi_epi64 (b1, b5);
+  r[4] = _mm_unpacklo_epi64 (b2, b6);
+  r[5] = _mm_unpackhi_epi64 (b2, b6);
+  r[6] = _mm_unpacklo_epi64 (b3, b7);
+  r[7] = _mm_unpackhi_epi64 (b3, b7);
+}
+
+static inline void
+transpose_4x4_epi32 (__m128i r[4])
+{
+  __m128i t0, t1, t2, t3;
+
+  t0 = _mm_unpacklo_epi32 (r[0], r[1]);
+  t1 = _mm_unpacklo_epi32 (r[2], r[3]);
+  t2 = _mm_unpackhi_epi32 (r[0], r[1]);
+  t3 = _mm_unpackhi_epi32 (r[2], r[3]);
+
+  r[0] = _mm_unpacklo_epi64 (t0, t1);
+  r[1] = _mm_unpackhi_epi64 (t0, t1);
+  r[2] = _mm_unpacklo_epi64 (t2, t3);
+  r[3] = _mm_unpackhi_epi64 (t2, t3);
+}
+
+static inline void
+transpose_2x2_epi64 (__m128i r[2])
+{
+  __m128i t;
+
+  t = _mm_unpacklo_epi64 (r[0], r[1]);
+  r[1] = _mm_unpackhi_epi64 (r[0], r[1]);
+  r[0] = t;
+}
+
+#define LOAD_64(p)      _mm_loadl_epi64 ((const __m128i *) (p))
+#define STORE_64(p,v)   _mm_storel_epi64 ((__m128i *) (p), v)
+#define LOAD_128(p)     _mm_loadu_si128 ((const __m128i *) (p))
+#define STORE_128(p,v)  _mm_storeu_si128 ((__m128i *) (p), v)
+
+#define MAKE_TRANSPOSE_FUNCS(bits,N,load,store,transpose)                    \
+gboolean                                                                      \
+audio_interleave_##bits##_sse2 (const gpointer in[], gpointer out,            \
+    gint channels, gsize frames)                                              \
+{                                                                             \
+  const gsize bps = bits / 8, stride = bps * channels;                       \
+  __m128i r[N];                                                               \
+  gsize f;                                                                    \
+  gint c, k;                                                                  \
+                                                                              \
+  if (channels == 2 && N > 2)                                                 \
+    return audio_interleave_##bits##_2_sse2 (in, out, frames);                \
+  if (channels < N || frames < N)                                             \
+    return FALSE;                                                             \
+                                                                              \
+  for (f = 0;; f += N) {                                                      \
+    if (f + N > frames)                                                       \
+      f = frames - N;                                                         \
+    for (c = 0;; c += N) {                                                    \
+      guint8 *o;                                                              \
+                                                                              \
+      if (c + N > channels)                                                   \
+        c = channels - N;                                                     \
+      for (k = 0; k < N; k++)                                                 \
+        r[k] = load ((const guint8 *) in[c + k] + f * bps);                   \
+      transpose (r);                                                          \
+      o = (guint8 *) out + f * stride + c * bps;                              \
+      for (k = 0; k < N; k++)                                                 \
+        store (o + k * stride, r[k]);                                         \
+      if (c + N == channels)                                                  \
+        break;                                                                \
+    }                                                                         \
+    if (f + N == frames)                                                      \
+      break;                                                                  \
+  }                                                                           \
+  return TRUE;                                                                \
+}                                                                             \
+                                                                              \
+gboolean                                                                      \
+audio_deinterleave_##bits##_sse2 (gconstpointer in, gpointer out[],           \
+    gint channels, gsize frames)                                              \
+{                                                                             \
+  const gsize bps = bits / 8, stride = bps * channels;                       \
+  __m128i r[N];                                                               \
+  gsize f;                                                                    \
+  gint c, k;                                                                  \
+                                                                              \
+  if (channels == 2 && N > 2)                                                 \
+    return audio_deinterleave_##bits##_2_sse2 (in, out, frames);              \
+  if (channels < N || frames < N)                                             \
+    return FALSE;                                                             \
+                                                                              \
+  for (f = 0;; f += N) {                                                      \
+    if (f + N > frames)                                                       \
+      f = frames - N;                                                         \
+    for (c = 0;; c += N) {                                                    \
+      const guint8 *i;                                                        \
+                                                                              \
+      if (c + N > channels)                                                   \
+        c = channels - N;                                                     \
+      i = (const guint8 *) in + f * stride + c * bps;                         \
+      for (k = 0; k < N; k++)                                                 \
+        r[k] = load (i + k * stride);                                         \
+      transpose (r);                                                          \
+      for (k = 0; k < N; k++)                                                 \
+        store ((guint8 *) out[c + k] + f * bps, r[k]);                        \
+      if (c + N == channels)                                                  \
+        break;                                                                \
+    }                                                                         \
+    if (f + N == frames)                                                      \
+      break;                                                                  \
+  }                                                                           \
+  return TRUE;                                                                \
+}
+
+/* stereo, 16 frames per iteration */
+static inline gboolean
+audio_interleave_8_2_sse2 (const gpointer in[], gpointer out, gsize frames)
+{
+  const guint8 *l = in[0], *r = in[1];
+  guint8 *o = out;
+  gsize f;
+
+  if (frames < 16)
+    return FALSE;
+
+  for (f = 0;; f += 16) {
+    __m128i vl, vr;
+
+    if (f + 16 > frames)
+      f = frames - 16;
+    vl = LOAD_128 (l + f);
+    vr = LOAD_128 (r + f);
+    STORE_128 (o + 2 * f, _mm_unpacklo_epi8 (vl, vr));
+    STORE_128 (o + 2 * f + 16, _mm_unpackhi_epi8 (vl, vr));
+    if (f + 16 == frames)
+      break;
+  }
+  return TRUE;
+}
+
+static inline gboolean
+audio_deinterleave_8_2_sse2 (gconstpointer in, gpointer out[], gsize frames)
+{
+  const guint8 *i = in;
+  guint8 *l = out[0], *r = out[1];
+  const __m128i mask = _mm_set1_epi16 (0x00ff);
+  gsize f;
+
+  if (frames < 16)
+    return FALSE;
+
+  for (f = 0;; f += 16) {
+    __m128i v0, v1;
+
+    if (f + 16 > frames)
+      f = frames - 16;
+    v0 = LOAD_128 (i + 2 * f);
+    v1 = LOAD_128 (i + 2 * f + 16);
+    /* the 16 bit lanes are 0-255 after masking/shifting, packing does not
+     * saturate */
+    STORE_128 (l + f, _mm_packus_epi16 (_mm_and_si128 (v0, mask),
+            _mm_and_si128 (v1, mask)));
+    STORE_128 (r + f, _mm_packus_epi16 (_mm_srli_epi16 (v0, 8),
+            _mm_srli_epi16 (v1, 8)));
+    if (f + 16 == frames)
+      break;
+  }
+  return TRUE;
+}
+
+/* stereo, 8 frames per iteration */
+static inline gboolean
+audio_interleave_16_2_sse2 (const gpointer in[], gpointer out, gsize frames)
+{
+  const gint16 *l = in[0], *r = in[1];
+  gint16 *o = out;
+  gsize f;
+
+  if (frames < 8)
+    return FALSE;
+
+  for (f = 0;; f += 8) {
+    __m128i vl, vr;
+
+    if (f + 8 > frames)
+      f = frames - 8;
+    vl = LOAD_128 (l + f);
+    vr = LOAD_128 (r + f);
+    STORE_128 (o + 2 * f, _mm_unpacklo_epi16 (vl, vr));
+    STORE_128 (o + 2 * f + 8, _mm_unpackhi_epi16 (vl, vr));
+    if (f + 8 == frames)
+      break;
+  }
+  return TRUE;
+}
+
+static inline gboolean
+audio_deinterleave_16_2_sse2 (gconstpointer in, gpointer out[], gsize frames)
+{
+  const gint16 *i = in;
+  gint16 *l = out[0], *r = out[1];
+  gsize f;
+
+  if (frames < 8)
+    return FALSE;
+
+  for (f = 0;; f += 8) {
+    __m128i v0, v1;
+
+    if (f + 8 > frames)
+      f = frames - 8;
+    v0 = LOAD_128 (i + 2 * f);
+    v1 = LOAD_128 (i + 2 * f + 8);
+    /* sign extend each half of the 32 bit lanes, packing then does not
+     * saturate */
+    STORE_128 (l + f,
+        _mm_packs_epi32 (_mm_srai_epi32 (_mm_slli_epi32 (v0, 16), 16),
+            _mm_srai_epi32 (_mm_slli_epi32 (v1, 16), 16)));
+    STORE_128 (r + f, _mm_packs_epi32 (_mm_srai_epi32 (v0, 16),
+            _mm_srai_epi32 (v1, 16)));
+    if (f + 8 == frames)
+      break;
+  }
+  return TRUE;
+}
+
+/* stereo, 4 frames per iteration */
+static inline gboolean
+audio_interleave_32_2_sse2 (const gpointer in[], gpointer out, gsize frames)
+{
+  const gint32 *l = in[0], *r = in[1];
+  gint32 *o = out;
+  gsize f;
+
+  if (frames < 4)
+    return FALSE;
+
+  for (f = 0;; f += 4) {
+    __m128i vl, vr;
+
+    if (f + 4 > frames)
+      f = frames - 4;
+    vl = LOAD_128 (l + f);
+    vr = LOAD_128 (r + f);
+    STORE_128 (o + 2 * f, _mm_unpacklo_epi32 (vl, vr));
+    STORE_128 (o + 2 * f + 4, _mm_unpackhi_epi32 (vl, vr));
+    if (f + 4 == frames)
+      break;
+  }
+  return TRUE;
+}
+
+static inline gboolean
+audio_deinterleave_32_2_sse2 (gconstpointer in, gpointer out[], gsize frames)
+{
+  const gint32 *i = in;
+  gint32 *l = out[0], *r = out[1];
+  gsize f;
+
+  if (frames < 4)
+    return FALSE;
+
+  for (f = 0;; f += 4) {
+    __m128 v0, v1;
+
+    if (f + 4 > frames)
+      f = frames - 4;
+    /* only moves bits around, also for NaN patterns */
+    v0 = _mm_castsi128_ps (LOAD_128 (i + 2 * f));
+    v1 = _mm_castsi128_ps (LOAD_128 (i + 2 * f + 4));
+    STORE_128 (l + f, _mm_castps_si128 (_mm_shuffle_ps (v0, v1,
+                _MM_SHUFFLE (2, 0, 2, 0))));
+    STORE_128 (r + f, _mm_castps_si128 (_mm_shuffle_ps (v0, v1,
+                _MM_SHUFFLE (3, 1, 3, 1))));
+    if (f + 4 == frames)
+      break;
+  }
+  return TRUE;
+}
+
+/* never called, N is 2 already */
+#define audio_interleave_64_2_sse2(in,out,frames) FALSE
+#define audio_deinterleave_64_2_sse2(in,out,frames) FALSE
+
+MAKE_TRANSPOSE_FUNCS (8, 8, LOAD_64, STORE_64, transpose_8x8_epi8);
+MAKE_TRANSPOSE_FUNCS (16, 8, LOAD_128, STORE_128, transpose_8x8_epi16);
+MAKE_TRANSPOSE_FUNCS (32, 4, LOAD_128, STORE_128, transpose_4x4_epi32);
+MAKE_TRANSPOSE_FUNCS (64, 2, LOAD_128, STORE_128, transpose_2x2_epi64);
+
+#endif
@@ -0,0 +1,53 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef AUDIO_CHANNELS_X86_SSE2_H
+#define AUDIO_CHANNELS_X86_SSE2_H
+
+#include <glib.h>
+
+/* These return FALSE when the channel count or the number of frames is too
+ * small for the vector kernels, the caller then uses the plain C version. */
+
+G_GNUC_INTERNAL gboolean
+audio_interleave_8_sse2 (const gpointer in[], gpointer out, gint channels,
+    gsize frames);
+G_GNUC_INTERNAL gboolean
+audio_interleave_16_sse2 (const gpointer in[], gpointer out, gint channels,
+    gsize frames);
+G_GNUC_INTERNAL gboolean
+audio_interleave_32_sse2 (const gpointer in[], gpointer out, gint channels,
+    gsize frames);
+G_GNUC_INTERNAL gboolean
+audio_interleave_64_sse2 (const gpointer in[], gpointer out, gint channels,
+    gsize frames);
+
+G_GNUC_INTERNAL gboolean
+audio_deinterleave_8_sse2 (gconstpointer in, gpointer out[], gint channels,
+    gsize frames);
+G_GNUC_INTERNAL gboolean
+audio_deinterleave_16_sse2 (gconstpointer in, gpointer out[], gint channels,
+    gsize frames);
+G_GNUC_INTERNAL gboolean
+audio_deinterleave_32_sse2 (gconstpointer in, gpointer out[], gint channels,
+    gsize frames);
+G_GNUC_INTERNAL gboolean
+audio_deinterleave_64_sse2 (gconstpointer in, gpointer out[], gint channels,
+    gsize frames);
+
+#endif /* AUDIO_CHANNELS_X86_SSE2_H */
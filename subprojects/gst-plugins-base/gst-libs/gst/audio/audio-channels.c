@@ -32,6 +32,12 @@
 
 #include "audio-channels.h"
 
+#if defined (HAVE_EMMINTRIN_H) && defined (HAVE_SSE2) && \
+    (defined (__i386__) || defined (__x86_64__))
+#  define CHECK_SSE2
+#  include "audio-channels-x86-sse2.h"
+#endif
+
 #ifndef GST_DISABLE_GST_DEBUG
 #define GST_CAT_DEFAULT ensure_debug_category()
 static GstDebugCategory *
@@ -322,6 +328,280 @@ gst_audio_buffer_reorder_channels (GstBuffer * buffer,
   return ret;
 }
 
+/* frames per block in the plain C versions, keeps the interleaved side of a
+ * block in the cache while going over all the channels */
+#define INTERLEAVE_BLOCK_FRAMES 64
+
+#define MAKE_INTERLEAVE_FUNCS(bits)                                           \
+static void                                                                   \
+interleave_##bits (const gpointer in[], gpointer out, gint channels,          \
+    gsize frames)                                                             \
+{                                                                             \
+  guint##bits *o = out;                                                       \
+  gsize b, f, n;                                                              \
+  gint c;                                                                     \
+                                                                              \
+  for (b = 0; b < frames; b += n) {                                           \
+    n = MIN (frames - b, INTERLEAVE_BLOCK_FRAMES);                            \
+    for (c = 0; c < channels; c++) {                                          \
+      const guint##bits *i = in[c];                                           \
+                                                                              \
+      if (i == NULL)                                                          \
+        continue;                                                             \
+      for (f = b; f < b + n; f++)                                             \
+        o[f * channels + c] = i[f];                                           \
+    }                                                                         \
+  }                                                                           \
+}                                                                             \
+                                                                              \
+static void                                                                   \
+deinterleave_##bits (gconstpointer in, gpointer out[], gint channels,         \
+    gsize frames)                                                             \
+{                                                                             \
+  const guint##bits *i = in;                                                  \
+  gsize b, f, n;                                                              \
+  gint c;                                                                     \
+                                                                              \
+  for (b = 0; b < frames; b += n) {                                           \
+    n = MIN (frames - b, INTERLEAVE_BLOCK_FRAMES);                            \
+    for (c = 0; c < channels; c++) {                                          \
+      guint##bits *o = out[c];                                                \
+                                                                              \
+      if (o == NULL)                                                          \
+        continue;                                                             \
+      for (f = b; f < b + n; f++)                                             \
+        o[f] = i[f * channels + c];                                           \
+    }                                                                         \
+  }                                                                           \
+}
+
+MAKE_INTERLEAVE_FUNCS (8);
+MAKE_INTERLEAVE_FUNCS (16);
+MAKE_INTERLEAVE_FUNCS (32);
+MAKE_INTERLEAVE_FUNCS (64);
+
+static void
+interleave_24 (const gpointer in[], gpointer out, gint channels, gsize frames)
+{
+  guint8 *o = out;
+  gsize b, f, n;
+  gint c;
+
+  for (b = 0; b < frames; b += n) {
+    n = MIN (frames - b, INTERLEAVE_BLOCK_FRAMES);
+    for (c = 0; c < channels; c++) {
+      const guint8 *i = in[c];
+
+      if (i == NULL)
+        continue;
+      for (f = b; f < b + n; f++) {
+        guint8 *d = o + (f * channels + c) * 3;
+        const guint8 *s = i + f * 3;
+
+        d[0] = s[0];
+        d[1] = s[1];
+        d[2] = s[2];
+      }
+    }
+  }
+}
+
+static void
+deinterleave_24 (gconstpointer in, gpointer out[], gint channels, gsize frames)
+{
+  const guint8 *i = in;
+  gsize b, f, n;
+  gint c;
+
+  for (b = 0; b < frames; b += n) {
+    n = MIN (frames - b, INTERLEAVE_BLOCK_FRAMES);
+    for (c = 0; c < channels; c++) {
+      guint8 *o = out[c];
+
+      if (o == NULL)
+        continue;
+      for (f = b; f < b + n; f++) {
+        guint8 *d = o + f * 3;
+        const guint8 *s = i + (f * channels + c) * 3;
+
+        d[0] = s[0];
+        d[1] = s[1];
+        d[2] = s[2];
+      }
+    }
+  }
+}
+
+/* vector versions, return FALSE when they can't handle the channel count or
+ * number of frames */
+typedef gboolean (*AudioInterleaveFunc) (const gpointer in[], gpointer out,
+    gint channels, gsize frames);
+typedef gboolean (*AudioDeinterleaveFunc) (gconstpointer in, gpointer out[],
+    gint channels, gsize frames);
+
+static AudioInterleaveFunc interleave_8_simd = NULL;
+static AudioInterleaveFunc interleave_16_simd = NULL;
+static AudioInterleaveFunc interleave_32_simd = NULL;
+static AudioInterleaveFunc interleave_64_simd = NULL;
+static AudioDeinterleaveFunc deinterleave_8_simd = NULL;
+static AudioDeinterleaveFunc deinterleave_16_simd = NULL;
+static AudioDeinterleaveFunc deinterleave_32_simd = NULL;
+static AudioDeinterleaveFunc deinterleave_64_simd = NULL;
+
+static void
+audio_channels_init_simd (void)
+{
+  static gsize init_gonce = 0;
+
+  if (g_once_init_enter (&init_gonce)) {
+#ifdef CHECK_SSE2
+    gboolean have_sse2;
+
+#if defined (__x86_64__)
+    have_sse2 = TRUE;
+#elif defined (__GNUC__)
+    __builtin_cpu_init ();
+    have_sse2 = __builtin_cpu_supports ("sse2");
+#else
+    have_sse2 = FALSE;
+#endif
+
+    if (have_sse2) {
+      GST_DEBUG ("enable SSE2 optimisations");
+      interleave_8_simd = audio_interleave_8_sse2;
+      interleave_16_simd = audio_interleave_16_sse2;
+      interleave_32_simd = audio_interleave_32_sse2;
+      interleave_64_simd = audio_interleave_64_sse2;
+      deinterleave_8_simd = audio_deinterleave_8_sse2;
+      deinterleave_16_simd = audio_deinterleave_16_sse2;
+      deinterleave_32_simd = audio_deinterleave_32_sse2;
+      deinterleave_64_simd = audio_deinterleave_64_sse2;
+    }
+#endif
+    g_once_init_leave (&init_gonce, 1);
+  }
+}
+
+/**
+ * gst_audio_interleave_samples:
+ * @format: The %GstAudioFormat of the samples.
+ * @channels: The number of channels.
+ * @in: (array length=channels): pointers to the planar samples of each
+ *   channel, %NULL entries are skipped.
+ * @out: (array) (element-type guint8): The memory for the interleaved samples.
+ * @frames: The number of frames.
+ *
+ * Interleaves @frames samples of each of the @channels planes in @in into
+ * @out. Samples of channels that have a %NULL pointer in @in are not
+ * written, so that @out can be prefilled with silence for them.
+ *
+ * Since: 1.24
+ */
+void
+gst_audio_interleave_samples (GstAudioFormat format, gint channels,
+    const gpointer in[], gpointer out, gsize frames)
+{
+  const GstAudioFormatInfo *info;
+  gboolean complete = TRUE;
+  gint i;
+
+  info = gst_audio_format_get_info (format);
+
+  g_return_if_fail (info != NULL && info->width > 0);
+  g_return_if_fail (channels > 0);
+  g_return_if_fail (in != NULL);
+  g_return_if_fail (out != NULL || frames == 0);
+
+  audio_channels_init_simd ();
+
+  /* the vector versions don't skip channels */
+  for (i = 0; i < channels; i++) {
+    if (in[i] == NULL) {
+      complete = FALSE;
+      break;
+    }
+  }
+
+#define INTERLEAVE_CASE(bits)                                                 \
+    case bits:                                                                \
+      if (!complete || interleave_##bits##_simd == NULL ||                    \
+          !interleave_##bits##_simd (in, out, channels, frames))              \
+        interleave_##bits (in, out, channels, frames);                        \
+      break
+
+  switch (info->width) {
+      INTERLEAVE_CASE (8);
+      INTERLEAVE_CASE (16);
+      INTERLEAVE_CASE (32);
+      INTERLEAVE_CASE (64);
+    case 24:
+      interleave_24 (in, out, channels, frames);
+      break;
+    default:
+      g_return_if_reached ();
+  }
+#undef INTERLEAVE_CASE
+}
+
+/**
+ * gst_audio_deinterleave_samples:
+ * @format: The %GstAudioFormat of the samples.
+ * @channels: The number of channels.
+ * @in: (array) (element-type guint8): The interleaved samples.
+ * @out: (array length=channels): pointers to the memory for the planar
+ *   samples of each channel, %NULL entries are skipped.
+ * @frames: The number of frames.
+ *
+ * Deinterleaves @frames frames of @channels channels in @in into a plane per
+ * channel in @out.
+ *
+ * Since: 1.24
+ */
+void
+gst_audio_deinterleave_samples (GstAudioFormat format, gint channels,
+    gconstpointer in, gpointer out[], gsize frames)
+{
+  const GstAudioFormatInfo *info;
+  gboolean complete = TRUE;
+  gint i;
+
+  info = gst_audio_format_get_info (format);
+
+  g_return_if_fail (info != NULL && info->width > 0);
+  g_return_if_fail (channels > 0);
+  g_return_if_fail (in != NULL || frames == 0);
+  g_return_if_fail (out != NULL);
+
+  audio_channels_init_simd ();
+
+  for (i = 0; i < channels; i++) {
+    if (out[i] == NULL) {
+      complete = FALSE;
+      break;
+    }
+  }
+
+#define DEINTERLEAVE_CASE(bits)                                               \
+    case bits:                                                                \
+      if (!complete || deinterleave_##bits##_simd == NULL ||                  \
+          !deinterleave_##bits##_simd (in, out, channels, frames))            \
+        deinterleave_##bits (in, out, channels, frames);                      \
+      break
+
+  switch (info->width) {
+      DEINTERLEAVE_CASE (8);
+      DEINTERLEAVE_CASE (16);
+      DEINTERLEAVE_CASE (32);
+      DEINTERLEAVE_CASE (64);
+    case 24:
+      deinterleave_24 (in, out, channels, frames);
+      break;
+    default:
+      g_return_if_reached ();
+  }
+#undef DEINTERLEAVE_CASE
+}
+
 /**
  * gst_audio_check_valid_channel_positions:
  * @position: (array length=channels): The %GstAudioChannelPositions
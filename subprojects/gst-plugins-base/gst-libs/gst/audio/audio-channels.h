@@ -145,6 +145,20 @@ gboolean       gst_audio_reorder_channels        (gpointer data, gsize size,
                                                   const GstAudioChannelPosition * from,
                                                   const GstAudioChannelPosition * to);
 
+GST_AUDIO_API
+void           gst_audio_interleave_samples      (GstAudioFormat format,
+                                                  gint channels,
+                                                  const gpointer in[],
+                                                  gpointer out,
+                                                  gsize frames);
+
+GST_AUDIO_API
+void           gst_audio_deinterleave_samples    (GstAudioFormat format,
+                                                  gint channels,
+                                                  gconstpointer in,
+                                                  gpointer out[],
+                                                  gsize frames);
+
 GST_AUDIO_API
 gboolean       gst_audio_channel_positions_to_valid_order (GstAudioChannelPosition *position,
                                                            gint channels);
@@ -29,6 +29,7 @@
 
 #include "audio-converter.h"
 #include "gstaudiopack.h"
+#include "gstaudioutilsprivate.h"
 
 /**
  * SECTION:gstaudioconverter
@@ -76,6 +77,20 @@ typedef gboolean (*AudioConvertSamplesFunc) (GstAudioConverter * convert,
     gpointer out[], gsize out_frames);
 typedef void (*AudioConvertEndianFunc) (gpointer dst, const gpointer src,
     gint count);
+typedef void (*AudioConvertRangeFunc) (GstAudioConverter * convert,
+    AudioChain * chain, gpointer in[], gpointer out[], gsize num_samples);
+typedef void (*AudioConvertMixFunc) (GstAudioConverter * convert,
+    gconstpointer src, gpointer dst, gsize frames);
+
+typedef struct
+{
+  GstAudioConverter *convert;
+  AudioChain *chain;
+  AudioConvertRangeFunc func;
+  gpointer *in;
+  gpointer *out;
+  gsize num_samples;
+} AudioConvertTask;
 
 /*                           int/int    int/float  float/int float/float
  *
@@ -132,6 +147,7 @@ struct _GstAudioConverter
 
   /* quant */
   GstAudioQuantize *quant;
+  gboolean quant_parallel;
 
   /* change layout */
   GstAudioFormat chlayout_format;
@@ -146,6 +162,21 @@ struct _GstAudioConverter
   AudioConvertEndianFunc swap_endian;
 
   AudioConvertSamplesFunc convert;
+
+  /* fused mix, quantize and pack */
+  AudioConvertMixFunc mix_func;
+  gdouble *mix_matrix;          /* m[in_channels][out_channels] */
+  gdouble *mix_acc;
+  gpointer mix_tmp;
+  gsize mix_tmp_frames;
+
+  /* threading */
+  guint n_threads;
+  GstAudioTaskRunner *runner;
+  AudioConvertTask *tasks;
+  gpointer *tasks_p;
+  gpointer *task_ptrs;
+  gint max_blocks;
 };
 
 static GstAudioConverter *
@@ -293,6 +324,7 @@ get_opt_value (GstAudioConverter * convert, const gchar * opt)
 #define DEFAULT_OPT_DITHER_THRESHOLD 20
 #define DEFAULT_OPT_NOISE_SHAPING_METHOD GST_AUDIO_NOISE_SHAPING_NONE
 #define DEFAULT_OPT_QUANTIZATION 1
+#define DEFAULT_OPT_THREADS 1
 
 #define GET_OPT_RESAMPLER_METHOD(c) get_opt_enum(c, \
     GST_AUDIO_CONVERTER_OPT_RESAMPLER_METHOD, GST_TYPE_AUDIO_RESAMPLER_METHOD, \
@@ -309,6 +341,10 @@ get_opt_value (GstAudioConverter * convert, const gchar * opt)
     GST_AUDIO_CONVERTER_OPT_QUANTIZATION, DEFAULT_OPT_QUANTIZATION)
 #define GET_OPT_MIX_MATRIX(c) get_opt_value(c, \
     GST_AUDIO_CONVERTER_OPT_MIX_MATRIX)
+#define GET_OPT_THREADS(c) get_opt_uint(c, \
+    GST_AUDIO_CONVERTER_OPT_THREADS, DEFAULT_OPT_THREADS)
+
+static void update_threads (GstAudioConverter * convert);
 
 static gboolean
 copy_config (GQuark field_id, const GValue * value, gpointer user_data)
@@ -340,7 +376,8 @@ copy_config (GQuark field_id, const GValue * value, gpointer user_data)
  * then be retrieved and refined with gst_audio_converter_get_config().
  *
  * Look at the `GST_AUDIO_CONVERTER_OPT_*` fields to check valid configuration
- * option and values.
+ * option and values. A new #GST_AUDIO_CONVERTER_OPT_THREADS value recreates
+ * the threads of @convert and of its resampler.
  *
  * Returns: %TRUE when the new parameters could be set
  */
@@ -362,6 +399,20 @@ gst_audio_converter_update_config (GstAudioConverter * convert,
   convert->in.rate = in_rate;
   convert->out.rate = out_rate;
 
+  /* the resampler uses the same amount of threads unless configured
+   * otherwise */
+  if (config && !gst_structure_has_field (config,
+          GST_AUDIO_RESAMPLER_OPT_THREADS)) {
+    guint n_threads;
+
+    if (!gst_structure_get_uint (config, GST_AUDIO_CONVERTER_OPT_THREADS,
+            &n_threads))
+      n_threads = GET_OPT_THREADS (convert);
+
+    gst_structure_set (config, GST_AUDIO_RESAMPLER_OPT_THREADS, G_TYPE_UINT,
+        n_threads, NULL);
+  }
+
   if (convert->resampler)
     gst_audio_resampler_update (convert->resampler, in_rate, out_rate, config);
 
@@ -370,6 +421,10 @@ gst_audio_converter_update_config (GstAudioConverter * convert,
     gst_structure_free (config);
   }
 
+  /* while constructing, the threads are set up after the chain */
+  if (convert->chain_end)
+    update_threads (convert);
+
   return TRUE;
 }
 
@@ -441,6 +496,90 @@ get_temp_samples (AudioChain * chain, gsize num_samples, gpointer user_data)
   return chain->tmp;
 }
 
+/* don't bother waking up the other threads for less than this */
+#define MIN_PARALLEL_BYTES (32 * 1024)
+
+static void
+convert_task (AudioConvertTask * task)
+{
+  if (task->num_samples > 0)
+    task->func (task->convert, task->chain, task->in, task->out,
+        task->num_samples);
+}
+
+/* Perform @func on @num_samples frames. When we have multiple threads, the
+ * frames are split into ranges that are processed in parallel. @in_bpf and
+ * @out_bpf are the amount of bytes per frame in each of the blocks. All
+ * functions are stateless so the result is the same as doing all frames at
+ * once. */
+static void
+run_parallel (GstAudioConverter * convert, AudioChain * chain,
+    AudioConvertRangeFunc func, gpointer in[], gint in_blocks, gint in_bpf,
+    gpointer out[], gint out_blocks, gint out_bpf, gsize num_samples)
+{
+  guint i, n_threads;
+  gsize per_thread;
+
+  /* in-place conversion to another sample size can't be split */
+  if (convert->runner == NULL || (in == out && in_bpf != out_bpf) ||
+      num_samples * in_bpf * in_blocks < MIN_PARALLEL_BYTES) {
+    func (convert, chain, in, out, num_samples);
+    return;
+  }
+
+  n_threads = convert->runner->n_threads;
+  per_thread = GST_ROUND_UP_16 ((num_samples + n_threads - 1) / n_threads);
+
+  for (i = 0; i < n_threads; i++) {
+    AudioConvertTask *task = &convert->tasks[i];
+    gsize first = MIN (i * per_thread, num_samples);
+    gint b;
+
+    task->convert = convert;
+    task->chain = chain;
+    task->func = func;
+    task->num_samples = MIN (per_thread, num_samples - first);
+
+    if (in) {
+      task->in = convert->task_ptrs + (2 * i) * convert->max_blocks;
+      for (b = 0; b < in_blocks; b++)
+        task->in[b] = (gint8 *) in[b] + first * in_bpf;
+    } else {
+      task->in = NULL;
+    }
+    task->out = convert->task_ptrs + (2 * i + 1) * convert->max_blocks;
+    for (b = 0; b < out_blocks; b++)
+      task->out[b] = (gint8 *) out[b] + first * out_bpf;
+  }
+
+  __gst_audio_task_runner_run (convert->runner,
+      (GstAudioTaskFunc) convert_task, convert->tasks_p);
+}
+
+static void
+unpack_range (GstAudioConverter * convert, AudioChain * chain,
+    gpointer in[], gpointer out[], gsize num_samples)
+{
+  gint i;
+
+  if (in) {
+    for (i = 0; i < chain->blocks; i++) {
+      if (convert->in_default) {
+        memcpy (out[i], in[i], num_samples * chain->stride);
+      } else {
+        convert->in.finfo->unpack_func (convert->in.finfo,
+            GST_AUDIO_PACK_FLAG_TRUNCATE_RANGE, out[i], in[i],
+            num_samples * chain->inc);
+      }
+    }
+  } else {
+    for (i = 0; i < chain->blocks; i++) {
+      gst_audio_format_info_fill_silence (chain->finfo, out[i],
+          num_samples * chain->inc);
+    }
+  }
+}
+
 static gboolean
 do_unpack (AudioChain * chain, gpointer user_data)
 {
@@ -453,8 +592,6 @@ do_unpack (AudioChain * chain, gpointer user_data)
   num_samples = convert->in_frames;
 
   if (!chain->allow_ip || !in_writable || !convert->in_default) {
-    gint i;
-
     if (in_writable && chain->allow_ip) {
       tmp = convert->in_data;
       GST_LOG ("unpack in-place %p, %" G_GSIZE_FORMAT, tmp, num_samples);
@@ -463,26 +600,9 @@ do_unpack (AudioChain * chain, gpointer user_data)
       GST_LOG ("unpack to tmp %p, %" G_GSIZE_FORMAT, tmp, num_samples);
     }
 
-    if (convert->in_data) {
-      for (i = 0; i < chain->blocks; i++) {
-        if (convert->in_default) {
-          GST_LOG ("copy %p, %p, %" G_GSIZE_FORMAT, tmp[i], convert->in_data[i],
-              num_samples);
-          memcpy (tmp[i], convert->in_data[i], num_samples * chain->stride);
-        } else {
-          GST_LOG ("unpack %p, %p, %" G_GSIZE_FORMAT, tmp[i],
-              convert->in_data[i], num_samples);
-          convert->in.finfo->unpack_func (convert->in.finfo,
-              GST_AUDIO_PACK_FLAG_TRUNCATE_RANGE, tmp[i], convert->in_data[i],
-              num_samples * chain->inc);
-        }
-      }
-    } else {
-      for (i = 0; i < chain->blocks; i++) {
-        gst_audio_format_info_fill_silence (chain->finfo, tmp[i],
-            num_samples * chain->inc);
-      }
-    }
+    run_parallel (convert, chain, unpack_range, convert->in_data,
+        chain->blocks, convert->in.bpf / chain->blocks, tmp, chain->blocks,
+        chain->stride, num_samples);
   } else {
     tmp = convert->in_data;
     GST_LOG ("get in samples %p", tmp);
@@ -492,26 +612,42 @@ do_unpack (AudioChain * chain, gpointer user_data)
   return TRUE;
 }
 
+static void
+convert_in_range (GstAudioConverter * convert, AudioChain * chain,
+    gpointer in[], gpointer out[], gsize num_samples)
+{
+  gint i;
+
+  for (i = 0; i < chain->blocks; i++)
+    convert->convert_in (out[i], in[i], num_samples * chain->inc);
+}
+
 static gboolean
 do_convert_in (AudioChain * chain, gpointer user_data)
 {
   gsize num_samples;
   GstAudioConverter *convert = user_data;
   gpointer *in, *out;
-  gint i;
 
   in = audio_chain_get_samples (chain->prev, &num_samples);
   out = (chain->allow_ip ? in : audio_chain_alloc_samples (chain, num_samples));
   GST_LOG ("convert in %p, %p, %" G_GSIZE_FORMAT, in, out, num_samples);
 
-  for (i = 0; i < chain->blocks; i++)
-    convert->convert_in (out[i], in[i], num_samples * chain->inc);
+  run_parallel (convert, chain, convert_in_range, in, chain->prev->blocks,
+      chain->prev->stride, out, chain->blocks, chain->stride, num_samples);
 
   audio_chain_set_samples (chain, out, num_samples);
 
   return TRUE;
 }
 
+static void
+mix_range (GstAudioConverter * convert, AudioChain * chain,
+    gpointer in[], gpointer out[], gsize num_samples)
+{
+  gst_audio_channel_mixer_samples (convert->mix, in, out, num_samples);
+}
+
 static gboolean
 do_mix (AudioChain * chain, gpointer user_data)
 {
@@ -523,7 +659,8 @@ do_mix (AudioChain * chain, gpointer user_data)
   out = (chain->allow_ip ? in : audio_chain_alloc_samples (chain, num_samples));
   GST_LOG ("mix %p, %p, %" G_GSIZE_FORMAT, in, out, num_samples);
 
-  gst_audio_channel_mixer_samples (convert->mix, in, out, num_samples);
+  run_parallel (convert, chain, mix_range, in, chain->prev->blocks,
+      chain->prev->stride, out, chain->blocks, chain->stride, num_samples);
 
   audio_chain_set_samples (chain, out, num_samples);
 
@@ -552,26 +689,42 @@ do_resample (AudioChain * chain, gpointer user_data)
   return TRUE;
 }
 
+static void
+convert_out_range (GstAudioConverter * convert, AudioChain * chain,
+    gpointer in[], gpointer out[], gsize num_samples)
+{
+  gint i;
+
+  for (i = 0; i < chain->blocks; i++)
+    convert->convert_out (out[i], in[i], num_samples * chain->inc);
+}
+
 static gboolean
 do_convert_out (AudioChain * chain, gpointer user_data)
 {
   GstAudioConverter *convert = user_data;
   gsize num_samples;
   gpointer *in, *out;
-  gint i;
 
   in = audio_chain_get_samples (chain->prev, &num_samples);
   out = (chain->allow_ip ? in : audio_chain_alloc_samples (chain, num_samples));
   GST_LOG ("convert out %p, %p %" G_GSIZE_FORMAT, in, out, num_samples);
 
-  for (i = 0; i < chain->blocks; i++)
-    convert->convert_out (out[i], in[i], num_samples * chain->inc);
+  run_parallel (convert, chain, convert_out_range, in, chain->prev->blocks,
+      chain->prev->stride, out, chain->blocks, chain->stride, num_samples);
 
   audio_chain_set_samples (chain, out, num_samples);
 
   return TRUE;
 }
 
+static void
+quantize_range (GstAudioConverter * convert, AudioChain * chain,
+    gpointer in[], gpointer out[], gsize num_samples)
+{
+  gst_audio_quantize_samples (convert->quant, in, out, num_samples);
+}
+
 static gboolean
 do_quantize (AudioChain * chain, gpointer user_data)
 {
@@ -583,8 +736,14 @@ do_quantize (AudioChain * chain, gpointer user_data)
   out = (chain->allow_ip ? in : audio_chain_alloc_samples (chain, num_samples));
   GST_LOG ("quantize %p, %p %" G_GSIZE_FORMAT, in, out, num_samples);
 
-  if (in && out)
-    gst_audio_quantize_samples (convert->quant, in, out, num_samples);
+  if (in && out) {
+    /* dither and noise shaping carry state from one sample to the next */
+    if (convert->quant_parallel && chain->blocks == 1)
+      run_parallel (convert, chain, quantize_range, in, chain->prev->blocks,
+          chain->prev->stride, out, chain->blocks, chain->stride, num_samples);
+    else
+      quantize_range (convert, chain, in, out, num_samples);
+  }
 
   audio_chain_set_samples (chain, out, num_samples);
 
@@ -628,22 +787,16 @@ MAKE_DEINTERLEAVE_FUNC (gint32);
 MAKE_DEINTERLEAVE_FUNC (gfloat);
 MAKE_DEINTERLEAVE_FUNC (gdouble);
 
-static gboolean
-do_change_layout (AudioChain * chain, gpointer user_data)
+static void
+change_layout_range (GstAudioConverter * convert, AudioChain * chain,
+    gpointer in[], gpointer out[], gsize num_samples)
 {
-  GstAudioConverter *convert = user_data;
   GstAudioFormat format = convert->chlayout_format;
   GstAudioLayout out_layout = convert->chlayout_target;
   gint channels = convert->chlayout_channels;
-  gsize num_samples;
-  gpointer *in, *out;
-
-  in = audio_chain_get_samples (chain->prev, &num_samples);
-  out = (chain->allow_ip ? in : audio_chain_alloc_samples (chain, num_samples));
 
   if (out_layout == GST_AUDIO_LAYOUT_INTERLEAVED) {
     /* interleave */
-    GST_LOG ("interleaving %p, %p %" G_GSIZE_FORMAT, in, out, num_samples);
     switch (format) {
       case GST_AUDIO_FORMAT_S16:
         interleave_gint16 ((const gint16 **) in, (gint16 **) out,
@@ -667,7 +820,6 @@ do_change_layout (AudioChain * chain, gpointer user_data)
     }
   } else {
     /* deinterleave */
-    GST_LOG ("deinterleaving %p, %p %" G_GSIZE_FORMAT, in, out, num_samples);
     switch (format) {
       case GST_AUDIO_FORMAT_S16:
         deinterleave_gint16 ((const gint16 **) in, (gint16 **) out,
@@ -690,6 +842,24 @@ do_change_layout (AudioChain * chain, gpointer user_data)
         break;
     }
   }
+}
+
+static gboolean
+do_change_layout (AudioChain * chain, gpointer user_data)
+{
+  GstAudioConverter *convert = user_data;
+  gsize num_samples;
+  gpointer *in, *out;
+
+  in = audio_chain_get_samples (chain->prev, &num_samples);
+  out = (chain->allow_ip ? in : audio_chain_alloc_samples (chain, num_samples));
+
+  GST_LOG ("%s %p, %p %" G_GSIZE_FORMAT,
+      convert->chlayout_target == GST_AUDIO_LAYOUT_INTERLEAVED ?
+      "interleaving" : "deinterleaving", in, out, num_samples);
+
+  run_parallel (convert, chain, change_layout_range, in, chain->prev->blocks,
+      chain->prev->stride, out, chain->blocks, chain->stride, num_samples);
 
   audio_chain_set_samples (chain, out, num_samples);
   return TRUE;
@@ -937,7 +1107,8 @@ chain_convert_out (GstAudioConverter * convert, AudioChain * prev)
 
     GST_INFO ("convert F64 to S32");
     prev = audio_chain_new (prev, convert);
-    prev->allow_ip = TRUE;
+    /* converting in-place to a smaller size can't be split over threads */
+    prev->allow_ip = convert->n_threads <= 1;
     prev->pass_alloc = FALSE;
     audio_chain_set_make_func (prev, do_convert_out, convert, NULL);
   }
@@ -991,6 +1162,8 @@ chain_quantize (GstAudioConverter * convert, AudioChain * prev)
     convert->quant =
         gst_audio_quantize_new (dither, ns, 0, convert->current_format,
         out->channels, 1U << (32 - out_depth));
+    convert->quant_parallel = dither == GST_AUDIO_DITHER_NONE
+        && ns == GST_AUDIO_NOISE_SHAPING_NONE;
 
     prev = audio_chain_new (prev, convert);
     prev->allow_ip = TRUE;
@@ -1069,6 +1242,57 @@ setup_allocators (GstAudioConverter * convert)
   }
 }
 
+static void
+free_threads (GstAudioConverter * convert)
+{
+  if (convert->runner)
+    __gst_audio_task_runner_free (convert->runner);
+  convert->runner = NULL;
+  g_clear_pointer (&convert->tasks, g_free);
+  g_clear_pointer (&convert->tasks_p, g_free);
+  g_clear_pointer (&convert->task_ptrs, g_free);
+}
+
+static void
+setup_threads (GstAudioConverter * convert)
+{
+  guint i, n_threads = convert->n_threads;
+
+  GST_INFO ("using %u threads", n_threads);
+
+  convert->runner = __gst_audio_task_runner_new (n_threads);
+  convert->tasks = g_new0 (AudioConvertTask, n_threads);
+  convert->tasks_p = g_new (gpointer, n_threads);
+  for (i = 0; i < n_threads; i++)
+    convert->tasks_p[i] = &convert->tasks[i];
+
+  /* in and out pointers for each of the threads */
+  convert->max_blocks = MAX (convert->in.channels, convert->out.channels);
+  convert->task_ptrs = g_new (gpointer, n_threads * 2 * convert->max_blocks);
+}
+
+/* Reads the threads option and recreates the threads when the amount
+ * changed. The conversion path that was picked when creating @convert is
+ * kept, only the generic path uses the threads. */
+static void
+update_threads (GstAudioConverter * convert)
+{
+  guint n_threads = GET_OPT_THREADS (convert);
+
+  if (n_threads == 0 || n_threads > g_get_num_processors ())
+    n_threads = g_get_num_processors ();
+
+  if (n_threads == convert->n_threads)
+    return;
+
+  convert->n_threads = n_threads;
+  free_threads (convert);
+
+  /* the resampler has its own threads */
+  if (convert->convert == converter_generic && n_threads > 1)
+    setup_threads (convert);
+}
+
 static gboolean
 converter_passthrough (GstAudioConverter * convert,
     GstAudioConverterFlags flags, gpointer in[], gsize in_frames,
@@ -1257,6 +1481,17 @@ converter_endian (GstAudioConverter * convert,
   return TRUE;
 }
 
+static void
+pack_range (GstAudioConverter * convert, AudioChain * chain,
+    gpointer in[], gpointer out[], gsize num_samples)
+{
+  gint i;
+
+  for (i = 0; i < chain->blocks; i++)
+    convert->out.finfo->pack_func (convert->out.finfo, 0, in[i], out[i],
+        num_samples * chain->inc);
+}
+
 static gboolean
 converter_generic (GstAudioConverter * convert,
     GstAudioConverterFlags flags, gpointer in[], gsize in_frames,
@@ -1264,7 +1499,6 @@ converter_generic (GstAudioConverter * convert,
 {
   AudioChain *chain;
   gpointer *tmp;
-  gint i;
   gsize produced;
 
   chain = convert->chain_end;
@@ -1281,9 +1515,9 @@ converter_generic (GstAudioConverter * convert,
   if (!convert->out_default && tmp && out) {
     GST_LOG ("pack %p, %p %" G_GSIZE_FORMAT, tmp, out, produced);
     /* and pack if needed */
-    for (i = 0; i < chain->blocks; i++)
-      convert->out.finfo->pack_func (convert->out.finfo, 0, tmp[i], out[i],
-          produced * chain->inc);
+    run_parallel (convert, chain, pack_range, tmp, chain->blocks,
+        chain->stride, out, chain->blocks, convert->out.bpf / chain->blocks,
+        produced);
   }
   return TRUE;
 }
@@ -1299,6 +1533,164 @@ converter_resample (GstAudioConverter * convert,
   return TRUE;
 }
 
+/* size of the intermediate buffer of the fused mix, small enough to stay
+ * in the L1 cache between the mix, quantize and pack steps */
+#define MIX_TILE_BYTES 16384
+
+/* same truncation and clipping as the orc double_to_s32 conversion */
+static inline gint32
+mix_double_to_s32 (gdouble v)
+{
+  v *= 2147483648.0;
+  if (v >= 2147483648.0)
+    return G_MAXINT32;
+  if (v > -2147483648.0)
+    return (gint32) v;
+  return G_MININT32;
+}
+
+/* the accumulation is done in the same order and precision as the F64
+ * channel mixer, the inner loop over the output channels vectorizes */
+#define DEFINE_MIX_TO_S32_FUNC(type) \
+static void \
+mix_##type##_to_s32 (GstAudioConverter * convert, gconstpointer src, \
+    gpointer dst, gsize frames) \
+{ \
+  const type *s = src; \
+  gint32 *d = dst; \
+  gdouble *acc = convert->mix_acc; \
+  gint in_channels = convert->in.channels; \
+  gint out_channels = convert->out.channels; \
+  gsize n; \
+  gint i, o; \
+  \
+  for (n = 0; n < frames; n++) { \
+    const gdouble *m = convert->mix_matrix; \
+    \
+    for (o = 0; o < out_channels; o++) \
+      acc[o] = 0.0; \
+    for (i = 0; i < in_channels; i++, m += out_channels) { \
+      gdouble x = s[i]; \
+      for (o = 0; o < out_channels; o++) \
+        acc[o] += x * m[o]; \
+    } \
+    for (o = 0; o < out_channels; o++) \
+      d[o] = mix_double_to_s32 (acc[o]); \
+    \
+    s += in_channels; \
+    d += out_channels; \
+  } \
+}
+
+DEFINE_MIX_TO_S32_FUNC (gfloat);
+DEFINE_MIX_TO_S32_FUNC (gdouble);
+
+static void
+mix_s32_to_double (GstAudioConverter * convert, gconstpointer src,
+    gpointer dst, gsize frames)
+{
+  const gint32 *s = src;
+  gdouble *d = dst;
+  gint in_channels = convert->in.channels;
+  gint out_channels = convert->out.channels;
+  gsize n;
+  gint i, o;
+
+  for (n = 0; n < frames; n++) {
+    const gdouble *m = convert->mix_matrix;
+
+    for (o = 0; o < out_channels; o++)
+      d[o] = 0.0;
+    for (i = 0; i < in_channels; i++, m += out_channels) {
+      gdouble x = s[i] / 2147483648.0;
+      for (o = 0; o < out_channels; o++)
+        d[o] += x * m[o];
+    }
+    s += in_channels;
+    d += out_channels;
+  }
+}
+
+/* mix, quantize and pack interleaved samples in small blocks instead of
+ * running each step of the chain over the complete buffer */
+static gboolean
+converter_mix (GstAudioConverter * convert,
+    GstAudioConverterFlags flags, gpointer in[], gsize in_frames,
+    gpointer out[], gsize out_frames)
+{
+  const guint8 *src;
+  guint8 *dst;
+  gpointer tmp[1];
+  gsize n;
+
+  /* silence goes through the chain */
+  if (in == NULL)
+    return converter_generic (convert, flags, in, in_frames, out, out_frames);
+
+  GST_LOG ("fused mix of %" G_GSIZE_FORMAT " frames", in_frames);
+
+  src = in[0];
+  dst = out[0];
+  tmp[0] = convert->mix_tmp;
+
+  while (in_frames > 0) {
+    n = MIN (in_frames, convert->mix_tmp_frames);
+
+    convert->mix_func (convert, src, tmp[0], n);
+    if (convert->quant)
+      gst_audio_quantize_samples (convert->quant, tmp, tmp, n);
+    convert->out.finfo->pack_func (convert->out.finfo, 0, tmp[0], dst,
+        n * convert->out.channels);
+
+    src += n * convert->in.bpf;
+    dst += n * convert->out.bpf;
+    in_frames -= n;
+  }
+  return TRUE;
+}
+
+/* float to integer and S32 to float conversions with a channel mix can skip
+ * the full size intermediate buffers of the chain */
+static void
+setup_mix (GstAudioConverter * convert)
+{
+  GstAudioFormat in_format = GST_AUDIO_INFO_FORMAT (&convert->in);
+  gint in_channels = convert->in.channels;
+  gint out_channels = convert->out.channels;
+  gfloat **matrix;
+  gsize width;
+  gint i, o;
+
+  if (GST_AUDIO_FORMAT_INFO_IS_INTEGER (convert->out.finfo)) {
+    if (in_format == GST_AUDIO_FORMAT_F32)
+      convert->mix_func = mix_gfloat_to_s32;
+    else if (in_format == GST_AUDIO_FORMAT_F64)
+      convert->mix_func = mix_gdouble_to_s32;
+    else
+      return;
+    width = sizeof (gint32);
+  } else if (in_format == GST_AUDIO_FORMAT_S32) {
+    convert->mix_func = mix_s32_to_double;
+    width = sizeof (gdouble);
+  } else {
+    return;
+  }
+
+  GST_INFO ("no resampler, interleaved -> fused mix and pack");
+
+  matrix = __gst_audio_channel_mixer_get_matrix (convert->mix);
+  convert->mix_matrix = g_new (gdouble, in_channels * out_channels);
+  for (i = 0; i < in_channels; i++)
+    for (o = 0; o < out_channels; o++)
+      convert->mix_matrix[i * out_channels + o] = matrix[i][o];
+  convert->mix_acc = g_new (gdouble, out_channels);
+
+  convert->mix_tmp_frames = MAX (MIX_TILE_BYTES / (width * out_channels), 16);
+  convert->mix_tmp = g_malloc (convert->mix_tmp_frames * width * out_channels);
+
+  convert->convert = converter_mix;
+}
+
 #define GST_AUDIO_FORMAT_IS_ENDIAN_CONVERSION(info1, info2) \
 		( \
 			!(((info1)->flags ^ (info2)->flags) & (~GST_AUDIO_FORMAT_FLAG_UNPACK)) && \
@@ -1360,6 +1752,10 @@ gst_audio_converter_new (GstAudioConverterFlags flags, GstAudioInfo * in_info,
 
   GST_INFO ("unitsizes: %d -> %d", in_info->bpf, out_info->bpf);
 
+  convert->n_threads = GET_OPT_THREADS (convert);
+  if (convert->n_threads == 0 || convert->n_threads > g_get_num_processors ())
+    convert->n_threads = g_get_num_processors ();
+
   /* step 1, unpack */
   prev = chain_unpack (convert);
   /* step 2, optional convert from S32 to F64 for channel mix */
@@ -1428,10 +1824,18 @@ gst_audio_converter_new (GstAudioConverterFlags flags, GstAudioInfo * in_info,
         }
       }
     }
+  } else if (convert->resampler == NULL && convert->n_threads <= 1 &&
+      in_info->layout == GST_AUDIO_LAYOUT_INTERLEAVED &&
+      out_info->layout == GST_AUDIO_LAYOUT_INTERLEAVED) {
+    setup_mix (convert);
   }
 
   setup_allocators (convert);
 
+  /* the resampler has its own threads */
+  if (convert->convert == converter_generic && convert->n_threads > 1)
+    setup_threads (convert);
+
   return convert;
 
   /* ERRORS */
@@ -1476,6 +1880,10 @@ gst_audio_converter_free (GstAudioConverter * convert)
     gst_audio_channel_mixer_free (convert->mix);
   if (convert->resampler)
     gst_audio_resampler_free (convert->resampler);
+  free_threads (convert);
+  g_free (convert->mix_matrix);
+  g_free (convert->mix_acc);
+  g_free (convert->mix_tmp);
   gst_audio_info_init (&convert->in);
   gst_audio_info_init (&convert->out);
 
@@ -117,6 +117,22 @@ typedef struct _GstAudioConverter GstAudioConverter;
  */
 #define GST_AUDIO_CONVERTER_OPT_DITHER_THRESHOLD   "GstAudioConverter.dither-threshold"
 
+/**
+ * GST_AUDIO_CONVERTER_OPT_THREADS:
+ *
+ * #G_TYPE_UINT, maximum number of threads to use. Default 1, 0 for the
+ * number of cores.
+ *
+ * The output is identical to the single-threaded conversion. Dithering and
+ * noise shaping keep state across samples and are always done in one thread.
+ * Changing the value with gst_audio_converter_update_config() recreates the
+ * threads, but keeps the conversion steps that were picked when the
+ * converter was created, so some of them may stay single-threaded.
+ *
+ * Since: 1.24
+ */
+#define GST_AUDIO_CONVERTER_OPT_THREADS   "GstAudioConverter.threads"
+
 /**
  * GstAudioConverterFlags:
  * @GST_AUDIO_CONVERTER_FLAG_NONE: no flag
@@ -108,6 +108,12 @@ struct _GstAudioResampler
   gsize samples_len;
   gsize samples_avail;
   gpointer *sbuf;
+
+  /* channel groups resampled in parallel */
+  struct _GstAudioTaskRunner *runner;
+  gpointer tasks;
+  gpointer *tasks_p;
+  gboolean fill_taps_cache;
 };
 
 #endif /* __GST_AUDIO_RESAMPLER_PRIVATE_H__ */
@@ -21,6 +21,8 @@
 #include "audio-resampler-x86-sse.h"
 #include "audio-resampler-x86-sse2.h"
 #include "audio-resampler-x86-sse41.h"
+#include "audio-resampler-x86-avx2.h"
+#include "audio-resampler-x86-avx512.h"
 
 static void
 audio_resampler_check_x86 (const gchar *option)
@@ -66,6 +68,64 @@ audio_resampler_check_x86 (const gchar *option)
     resample_gint32_cubic_1 = resample_gint32_cubic_1_sse41;
 #else
     GST_DEBUG ("SSE41 optimisations not enabled");
+#endif
+  } else if (!strcmp (option, "avx2")) {
+#if defined (__x86_64__) && defined (HAVE_IMMINTRIN_H) && HAVE_AVX2
+    GST_DEBUG ("enable AVX2 optimisations");
+    resample_gint16_full_1 = resample_gint16_full_1_avx2;
+    resample_gint16_linear_1 = resample_gint16_linear_1_avx2;
+    resample_gint16_cubic_1 = resample_gint16_cubic_1_avx2;
+
+    resample_gint32_full_1 = resample_gint32_full_1_avx2;
+    resample_gint32_linear_1 = resample_gint32_linear_1_avx2;
+    resample_gint32_cubic_1 = resample_gint32_cubic_1_avx2;
+
+    resample_gfloat_full_1 = resample_gfloat_full_1_avx2;
+    resample_gfloat_linear_1 = resample_gfloat_linear_1_avx2;
+    resample_gfloat_cubic_1 = resample_gfloat_cubic_1_avx2;
+
+    resample_gdouble_full_1 = resample_gdouble_full_1_avx2;
+    resample_gdouble_linear_1 = resample_gdouble_linear_1_avx2;
+    resample_gdouble_cubic_1 = resample_gdouble_cubic_1_avx2;
+#else
+    GST_DEBUG ("AVX2 optimisations not enabled");
+#endif
+  } else if (!strcmp (option, "avx512")) {
+#if defined (__x86_64__) && defined (HAVE_IMMINTRIN_H) && HAVE_AVX512
+    GST_DEBUG ("enable AVX512 optimisations");
+    resample_gint16_full_1 = resample_gint16_full_1_avx512;
+    resample_gint16_linear_1 = resample_gint16_linear_1_avx512;
+    resample_gint16_cubic_1 = resample_gint16_cubic_1_avx512;
+
+    resample_gint32_full_1 = resample_gint32_full_1_avx512;
+    resample_gint32_linear_1 = resample_gint32_linear_1_avx512;
+    resample_gint32_cubic_1 = resample_gint32_cubic_1_avx512;
+
+    resample_gfloat_full_1 = resample_gfloat_full_1_avx512;
+    resample_gfloat_linear_1 = resample_gfloat_linear_1_avx512;
+    resample_gfloat_cubic_1 = resample_gfloat_cubic_1_avx512;
+
+    resample_gdouble_full_1 = resample_gdouble_full_1_avx512;
+    resample_gdouble_linear_1 = resample_gdouble_linear_1_avx512;
+    resample_gdouble_cubic_1 = resample_gdouble_cubic_1_avx512;
+#else
+    GST_DEBUG ("AVX512 optimisations not enabled");
 #endif
   }
 }
+
+/* Orc does not report FMA and AVX-512 support, so ask the CPU directly
+ * after the Orc target flags have been handled. The wider versions replace
+ * the SSE ones. */
+static void
+audio_resampler_check_x86_cpu (void)
+{
+#if defined (__GNUC__) && defined (__x86_64__)
+  __builtin_cpu_init ();
+
+  if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+    audio_resampler_check_x86 ("avx2");
+  if (__builtin_cpu_supports ("avx512f") && __builtin_cpu_supports ("avx512bw"))
+    audio_resampler_check_x86 ("avx512");
+#endif
+}
@@ -32,6 +32,7 @@
 #include "audio-resampler.h"
 #include "audio-resampler-private.h"
 #include "audio-resampler-macros.h"
+#include "gstaudioutilsprivate.h"
 
 #define MEM_ALIGN(m,a) ((gint8 *)((guintptr)((gint8 *)(m) + ((a)-1)) & ~((a)-1)))
 #define ALIGN 16
@@ -105,6 +106,11 @@ static const BlackmanQualityMap blackman_qualities[] = {
 #define DEFAULT_OPT_FILTER_INTERPOLATION GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_CUBIC
 #define DEFAULT_OPT_FILTER_OVERSAMPLE 8
 #define DEFAULT_OPT_MAX_PHASE_ERROR 0.1
+#define DEFAULT_OPT_THREADS 1
+
+/* don't bother waking up the other threads for less than this many
+ * output samples */
+#define MIN_PARALLEL_SAMPLES 1024
 
 static gdouble
 get_opt_double (GstStructure * options, const gchar * name, gdouble def)
@@ -124,6 +130,15 @@ get_opt_int (GstStructure * options, const gchar * name, gint def)
   return res;
 }
 
+static guint
+get_opt_uint (GstStructure * options, const gchar * name, guint def)
+{
+  guint res;
+  if (!options || !gst_structure_get_uint (options, name, &res))
+    res = def;
+  return res;
+}
+
 static gint
 get_opt_enum (GstStructure * options, const gchar * name, GType type, gint def)
 {
@@ -160,6 +175,8 @@ get_opt_enum (GstStructure * options, const gchar * name, GType type, gint def)
     GST_AUDIO_RESAMPLER_OPT_FILTER_OVERSAMPLE, DEFAULT_OPT_FILTER_OVERSAMPLE)
 #define GET_OPT_MAX_PHASE_ERROR(options) get_opt_double(options, \
     GST_AUDIO_RESAMPLER_OPT_MAX_PHASE_ERROR, DEFAULT_OPT_MAX_PHASE_ERROR)
+#define GET_OPT_THREADS(options) get_opt_uint(options, \
+    GST_AUDIO_RESAMPLER_OPT_THREADS, DEFAULT_OPT_THREADS)
 
 #include "dbesi0.c"
 #define bessel dbesi0
@@ -568,6 +585,16 @@ GET_TAPS_FULL_FUNC (gint32);
 GET_TAPS_FULL_FUNC (gfloat);
 GET_TAPS_FULL_FUNC (gdouble);
 
+typedef gpointer (*GetTapsFunc) (GstAudioResampler * resampler,
+    gint * samp_index, gint * samp_phase, gpointer icoeff);
+
+static GetTapsFunc get_taps_full_funcs[] = {
+  (GetTapsFunc) get_taps_gint16_full,
+  (GetTapsFunc) get_taps_gint32_full,
+  (GetTapsFunc) get_taps_gfloat_full,
+  (GetTapsFunc) get_taps_gdouble_full
+};
+
 #define GET_TAPS_INTERPOLATE_FUNC(type,inter)                   \
 DECL_GET_TAPS_INTERPOLATE_FUNC (type, inter)                    \
 {                                                               \
@@ -872,6 +899,9 @@ audio_resampler_init (void)
 #endif
           }
         }
+#ifdef CHECK_X86
+        audio_resampler_check_x86_cpu ();
+#endif
       }
     }
 #endif
@@ -1018,6 +1048,7 @@ setup_functions (GstAudioResampler * resampler)
   gint index, fidx;
 
   index = resampler->format_index;
+  resampler->fill_taps_cache = FALSE;
 
   if (resampler->in_rate == resampler->out_rate)
     resampler->resample = resample_funcs[index];
@@ -1049,6 +1080,7 @@ setup_functions (GstAudioResampler * resampler)
           default:
           case GST_AUDIO_RESAMPLER_FILTER_MODE_FULL:
             GST_DEBUG ("using full filter function");
+            resampler->fill_taps_cache = TRUE;
             break;
           case GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED:
             index += 4 + fidx;
@@ -1062,6 +1094,58 @@ setup_functions (GstAudioResampler * resampler)
   }
 }
 
+typedef struct
+{
+  GstAudioResampler resampler;
+  gpointer *in;
+  gpointer *out;
+  gpointer out_ptr;
+  gsize in_len;
+  gsize out_len;
+  gsize consumed;
+} ResampleTask;
+
+static void
+free_threads (GstAudioResampler * resampler)
+{
+  if (resampler->runner)
+    __gst_audio_task_runner_free (resampler->runner);
+  resampler->runner = NULL;
+  g_free (resampler->tasks);
+  resampler->tasks = NULL;
+  g_free (resampler->tasks_p);
+  resampler->tasks_p = NULL;
+}
+
+static void
+setup_threads (GstAudioResampler * resampler)
+{
+  ResampleTask *tasks;
+  guint i, n_threads;
+
+  n_threads = GET_OPT_THREADS (resampler->options);
+  if (n_threads == 0 || n_threads > g_get_num_processors ())
+    n_threads = g_get_num_processors ();
+  /* we split on channels, each thread needs at least one */
+  n_threads = MIN (n_threads, resampler->channels);
+
+  if (resampler->runner && resampler->runner->n_threads == n_threads)
+    return;
+
+  free_threads (resampler);
+
+  if (n_threads <= 1)
+    return;
+
+  GST_DEBUG ("using %u threads", n_threads);
+
+  resampler->runner = __gst_audio_task_runner_new (n_threads);
+  resampler->tasks = tasks = g_new0 (ResampleTask, n_threads);
+  resampler->tasks_p = g_new (gpointer, n_threads);
+  for (i = 0; i < n_threads; i++)
+    resampler->tasks_p[i] = &tasks[i];
+}
+
 static void
 resampler_calculate_taps (GstAudioResampler * resampler)
 {
@@ -1573,6 +1657,7 @@ gst_audio_resampler_update (GstAudioResampler * resampler,
 
     resampler_calculate_taps (resampler);
     resampler_dump (resampler);
+    setup_threads (resampler);
 
     if (old_n_taps > 0 && old_n_taps != resampler->n_taps) {
       gpointer *sbuf;
@@ -1632,6 +1717,7 @@ gst_audio_resampler_free (GstAudioResampler * resampler)
   g_free (resampler->tmp_taps);
   g_free (resampler->samples);
   g_free (resampler->sbuf);
+  free_threads (resampler);
   if (resampler->options)
     gst_structure_free (resampler->options);
   g_free (resampler);
@@ -1725,6 +1811,71 @@ gst_audio_resampler_get_max_latency (GstAudioResampler * resampler)
   return resampler->n_taps / 2;
 }
 
+/* the full filter table is filled lazily, do this here for all the phases
+ * we will need so that the threads only ever read from it */
+static void
+fill_taps_cache (GstAudioResampler * resampler, gsize out_len)
+{
+  GetTapsFunc get_taps = get_taps_full_funcs[resampler->format_index];
+  gint samp_index = 0, samp_phase = resampler->samp_phase;
+  gdouble icoeff[4];
+  gsize i;
+
+  /* the phases repeat after out_rate samples */
+  out_len = MIN (out_len, resampler->out_rate);
+
+  for (i = 0; i < out_len; i++)
+    get_taps (resampler, &samp_index, &samp_phase, icoeff);
+}
+
+static void
+resample_task (ResampleTask * task)
+{
+  GstAudioResampler *resampler = &task->resampler;
+
+  resampler->resample (resampler, task->in, task->in_len, task->out,
+      task->out_len, &task->consumed);
+}
+
+/* resample groups of channels in parallel, every group starts from the same
+ * state so the result is the same as when doing all channels at once */
+static void
+resample_parallel (GstAudioResampler * resampler, gpointer sbuf[],
+    gsize in_len, gpointer out[], gsize out_len, gsize * consumed)
+{
+  ResampleTask *tasks = resampler->tasks;
+  guint i, n_threads = resampler->runner->n_threads;
+  gint blocks = resampler->blocks;
+
+  if (resampler->fill_taps_cache)
+    fill_taps_cache (resampler, out_len);
+
+  for (i = 0; i < n_threads; i++) {
+    ResampleTask *task = &tasks[i];
+    gint first = i * blocks / n_threads;
+    gint last = (i + 1) * blocks / n_threads;
+
+    task->resampler = *resampler;
+    task->resampler.blocks = last - first;
+    task->in = &sbuf[first];
+    if (resampler->ostride == 1) {
+      task->out = &out[first];
+    } else {
+      task->out_ptr = (gint8 *) out[0] + first * resampler->bps;
+      task->out = &task->out_ptr;
+    }
+    task->in_len = in_len;
+    task->out_len = out_len;
+  }
+
+  __gst_audio_task_runner_run (resampler->runner,
+      (GstAudioTaskFunc) resample_task, resampler->tasks_p);
+
+  *consumed = tasks[0].consumed;
+  resampler->samp_index = tasks[0].resampler.samp_index;
+  resampler->samp_phase = tasks[0].resampler.samp_phase;
+}
+
 /**
  * gst_audio_resampler_resample:
  * @resampler: a #GstAudioResampler
@@ -1787,8 +1938,13 @@ gst_audio_resampler_resample (GstAudioResampler * resampler,
   }
 
   /* resample all channels */
-  resampler->resample (resampler, sbuf, samples_avail, out, out_frames,
-      &consumed);
+  if (resampler->runner
+      && out_frames * resampler->blocks >= MIN_PARALLEL_SAMPLES)
+    resample_parallel (resampler, sbuf, samples_avail, out, out_frames,
+        &consumed);
+  else
+    resampler->resample (resampler, sbuf, samples_avail, out, out_frames,
+        &consumed);
 
   GST_LOG ("in %" G_GSIZE_FORMAT ", avail %" G_GSIZE_FORMAT ", consumed %"
       G_GSIZE_FORMAT, in_frames, samples_avail, consumed);
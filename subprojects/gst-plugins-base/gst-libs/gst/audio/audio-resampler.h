@@ -164,6 +164,17 @@ typedef enum {
  */
 #define GST_AUDIO_RESAMPLER_OPT_MAX_PHASE_ERROR "GstAudioResampler.max-phase-error"
 
+/**
+ * GST_AUDIO_RESAMPLER_OPT_THREADS:
+ *
+ * G_TYPE_UINT, maximum number of threads to use. Channels are split into
+ * groups that are resampled in parallel. Default 1, 0 for the number of
+ * cores.
+ *
+ * Since: 1.24
+ */
+#define GST_AUDIO_RESAMPLER_OPT_THREADS "GstAudioResampler.threads"
+
 /**
  * GstAudioResamplerMethod:
  * @GST_AUDIO_RESAMPLER_METHOD_NEAREST: Duplicates the samples when
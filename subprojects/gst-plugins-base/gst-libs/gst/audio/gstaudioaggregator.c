@@ -347,6 +347,18 @@ gst_audio_aggregator_convert_pad_convert_buffer (GstAudioAggregatorPad *
         GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS |
         GST_BUFFER_COPY_META, 0, -1);
 
+    /* GAP buffers only need silence in the output format. Converters with
+     * history, like the resampler, still need to see them. */
+    if (GST_BUFFER_FLAG_IS_SET (input_buffer, GST_BUFFER_FLAG_GAP) &&
+        gst_audio_converter_get_max_latency (aaggcpad->priv->converter) == 0) {
+      GST_LOG_OBJECT (aaggpad, "not converting GAP buffer");
+      gst_buffer_map (res, &outmap, GST_MAP_WRITE);
+      gst_audio_format_info_fill_silence (out_info->finfo, outmap.data,
+          outmap.size);
+      gst_buffer_unmap (res, &outmap);
+      return res;
+    }
+
     gst_buffer_map (input_buffer, &inmap, GST_MAP_READ);
     gst_buffer_map (res, &outmap, GST_MAP_WRITE);
 
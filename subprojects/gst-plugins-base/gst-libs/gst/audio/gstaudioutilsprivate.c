@@ -333,3 +333,124 @@ __gst_audio_restore_thread_priority (gpointer handle)
   return TRUE;
 #endif
 }
+
+typedef struct
+{
+  GstAudioTaskFunc func;
+  gpointer user_data;
+} GstAudioTaskWorkItem;
+
+static void
+__gst_audio_task_thread_func (gpointer data)
+{
+  GstAudioTaskRunner *runner = data;
+  GstAudioTaskWorkItem *work_item;
+
+  g_mutex_lock (&runner->lock);
+  work_item = gst_queue_array_pop_head (runner->work_items);
+  g_mutex_unlock (&runner->lock);
+
+  g_assert (work_item != NULL);
+  g_assert (work_item->func != NULL);
+
+  work_item->func (work_item->user_data);
+}
+
+static void
+__gst_audio_task_runner_join (GstAudioTaskRunner * self)
+{
+  gboolean joined = FALSE;
+
+  while (!joined) {
+    g_mutex_lock (&self->lock);
+    if (!(joined = gst_queue_array_is_empty (self->tasks))) {
+      gpointer task = gst_queue_array_pop_head (self->tasks);
+      g_mutex_unlock (&self->lock);
+      gst_task_pool_join (self->pool, task);
+    } else {
+      g_mutex_unlock (&self->lock);
+    }
+  }
+}
+
+/*
+ * Creates a runner that splits work over @n_threads threads of a private
+ * #GstSharedTaskPool. 0 means the number of processors.
+ */
+GstAudioTaskRunner *
+__gst_audio_task_runner_new (guint n_threads)
+{
+  GstAudioTaskRunner *self;
+
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+
+  self = g_new0 (GstAudioTaskRunner, 1);
+
+  self->pool = gst_shared_task_pool_new ();
+  gst_shared_task_pool_set_max_threads (GST_SHARED_TASK_POOL (self->pool),
+      n_threads);
+  gst_task_pool_prepare (self->pool, NULL);
+
+  self->tasks = gst_queue_array_new (n_threads);
+  self->work_items = gst_queue_array_new (n_threads);
+
+  self->n_threads = n_threads;
+
+  g_mutex_init (&self->lock);
+
+  return self;
+}
+
+/*
+ * Calls @func once for each of the n_threads entries in @task_data and
+ * waits until all of them are done. The first one runs in the calling
+ * thread.
+ */
+void
+__gst_audio_task_runner_run (GstAudioTaskRunner * self,
+    GstAudioTaskFunc func, gpointer * task_data)
+{
+  guint i, n_threads = self->n_threads;
+
+  if (n_threads > 1) {
+    GstAudioTaskWorkItem *work_items;
+
+    work_items = g_newa (GstAudioTaskWorkItem, n_threads);
+
+    g_mutex_lock (&self->lock);
+    for (i = 1; i < n_threads; i++) {
+      gpointer task;
+
+      work_items[i].func = func;
+      work_items[i].user_data = task_data[i];
+      gst_queue_array_push_tail (self->work_items, &work_items[i]);
+
+      task =
+          gst_task_pool_push (self->pool, __gst_audio_task_thread_func,
+          self, NULL);
+
+      /* The return value of push() is unfortunately nullable, and we can't deal with that */
+      g_assert (task != NULL);
+      gst_queue_array_push_tail (self->tasks, task);
+    }
+    g_mutex_unlock (&self->lock);
+  }
+
+  func (task_data[0]);
+
+  __gst_audio_task_runner_join (self);
+}
+
+void
+__gst_audio_task_runner_free (GstAudioTaskRunner * self)
+{
+  __gst_audio_task_runner_join (self);
+
+  gst_queue_array_free (self->work_items);
+  gst_queue_array_free (self->tasks);
+  gst_task_pool_cleanup (self->pool);
+  gst_object_unref (self->pool);
+  g_mutex_clear (&self->lock);
+  g_free (self);
+}
@@ -27,6 +27,7 @@
 #define _GST_AUDIO_UTILS_PRIVATE_H_
 
 #include <gst/gst.h>
+#include <gst/base/gstqueuearray.h>
 
 G_BEGIN_DECLS
 
@@ -48,6 +49,35 @@ gboolean __gst_audio_set_thread_priority   (gpointer * handle);
 G_GNUC_INTERNAL
 gboolean __gst_audio_restore_thread_priority (gpointer handle);
 
+G_GNUC_INTERNAL
+gfloat ** __gst_audio_channel_mixer_get_matrix (GstAudioChannelMixer * mix);
+
+/* Parallelized task runner, used by the converter and resampler */
+typedef void (*GstAudioTaskFunc) (gpointer user_data);
+
+typedef struct _GstAudioTaskRunner GstAudioTaskRunner;
+
+struct _GstAudioTaskRunner
+{
+  GstTaskPool *pool;
+  guint n_threads;
+
+  GstQueueArray *tasks;
+  GstQueueArray *work_items;
+
+  GMutex lock;
+};
+
+G_GNUC_INTERNAL
+GstAudioTaskRunner * __gst_audio_task_runner_new (guint n_threads);
+
+G_GNUC_INTERNAL
+void __gst_audio_task_runner_run (GstAudioTaskRunner * self,
+                                  GstAudioTaskFunc func, gpointer * task_data);
+
+G_GNUC_INTERNAL
+void __gst_audio_task_runner_free (GstAudioTaskRunner * self);
+
 G_END_DECLS
 
 #endif
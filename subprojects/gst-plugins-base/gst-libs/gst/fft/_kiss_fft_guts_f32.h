@@ -37,6 +37,10 @@ struct kiss_fft_f32_state{
     int nfft;
     int inverse;
     int factors[2*MAXFACTORS];
+    /* twiddle factors and scratch space of the SIMD implementation, NULL
+     * if it is not used for this length */
+    kiss_fft_f32_cpx *simd_twiddles;
+    kiss_fft_f32_cpx *simd_work;
     kiss_fft_f32_cpx twiddles[1];
 };
 
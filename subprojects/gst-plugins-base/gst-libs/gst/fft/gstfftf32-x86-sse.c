@@ -0,0 +1,214 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gstfftf32-x86-sse.h"
+
+/* Radix-4 Stockham FFT for powers of two, with a radix-2 step at the end
+ * for odd powers. Every step reads one buffer and writes the other one in
+ * natural order, so no bit reversal is needed and all loads and stores are
+ * contiguous. Two complex samples are processed per vector.
+ *
+ * A step on sequences of length n with stride s calculates, for every
+ * p < n / 4 and q < s, with a..d = x[q + s * (p + k * n / 4)] and
+ * w = exp (-2 pi i / n) (conjugated for the inverse FFT):
+ *
+ *   y[q + s * (4p + 0)] = (a + c) + (b + d)
+ *   y[q + s * (4p + 1)] = ((a - c) - i (b - d)) * w^p
+ *   y[q + s * (4p + 2)] = ((a + c) - (b + d)) * w^2p
+ *   y[q + s * (4p + 3)] = ((a - c) + i (b - d)) * w^3p
+ *
+ * and continues with n / 4 and 4 s. The twiddle factors of a step are
+ * stored as w^p, w^2p and w^3p for all p, one array after the other, and
+ * the steps follow each other. */
+
+#if defined (HAVE_XMMINTRIN_H) && defined(__SSE__)
+#include <xmmintrin.h>
+
+void
+gst_fft_f32_init_twiddles_sse (kiss_fft_f32_cpx * twiddles, int nfft,
+    int inverse)
+{
+  const double pi =
+      3.141592653589793238462643383279502884197169399375105820974944;
+  int n, m, p, k;
+
+  for (n = nfft; n >= 4; n /= 4) {
+    m = n / 4;
+    for (k = 1; k <= 3; k++) {
+      for (p = 0; p < m; p++) {
+        double phase = -2 * pi * k * p / n;
+
+        if (inverse)
+          phase *= -1;
+        twiddles[p].r = cos (phase);
+        twiddles[p].i = sin (phase);
+      }
+      twiddles += m;
+    }
+  }
+}
+
+static inline __m128
+cmul_sse (__m128 a, __m128 w)
+{
+  const __m128 sign = _mm_set_ps (0.0f, -0.0f, 0.0f, -0.0f);
+  __m128 wr = _mm_shuffle_ps (w, w, _MM_SHUFFLE (2, 2, 0, 0));
+  __m128 wi = _mm_shuffle_ps (w, w, _MM_SHUFFLE (3, 3, 1, 1));
+  __m128 as = _mm_shuffle_ps (a, a, _MM_SHUFFLE (2, 3, 0, 1));
+
+  return _mm_add_ps (_mm_mul_ps (a, wr),
+      _mm_mul_ps (_mm_xor_ps (as, sign), wi));
+}
+
+/* multiplies by -i, or by i with the sign of @rot negated */
+static inline __m128
+rotate_sse (__m128 a, __m128 rot)
+{
+  return _mm_xor_ps (_mm_shuffle_ps (a, a, _MM_SHUFFLE (2, 3, 0, 1)), rot);
+}
+
+#define BUTTERFLY_4(a,b,c,d,w1,w2,w3,rot,y0,y1,y2,y3) G_STMT_START {  \
+  __m128 apc = _mm_add_ps (a, c), amc = _mm_sub_ps (a, c);             \
+  __m128 bpd = _mm_add_ps (b, d);                                      \
+  __m128 jbmd = rotate_sse (_mm_sub_ps (b, d), rot);                   \
+                                                                       \
+  y0 = _mm_add_ps (apc, bpd);                                          \
+  y1 = cmul_sse (_mm_add_ps (amc, jbmd), w1);                          \
+  y2 = cmul_sse (_mm_sub_ps (apc, bpd), w2);                           \
+  y3 = cmul_sse (_mm_sub_ps (amc, jbmd), w3);                          \
+} G_STMT_END
+
+/* the first step, with s = 1, vectorizes over p and interleaves the
+ * results of p and p + 1 */
+static void
+fft_step_1_sse (int n, const kiss_fft_f32_cpx * tw, __m128 rot,
+    const kiss_fft_f32_cpx * x, kiss_fft_f32_cpx * y)
+{
+  int m = n / 4, p;
+
+  for (p = 0; p < m; p += 2) {
+    __m128 a, b, c, d, y0, y1, y2, y3;
+
+    a = _mm_loadu_ps ((const float *) (x + p));
+    b = _mm_loadu_ps ((const float *) (x + p + m));
+    c = _mm_loadu_ps ((const float *) (x + p + 2 * m));
+    d = _mm_loadu_ps ((const float *) (x + p + 3 * m));
+
+    BUTTERFLY_4 (a, b, c, d,
+        _mm_loadu_ps ((const float *) (tw + p)),
+        _mm_loadu_ps ((const float *) (tw + m + p)),
+        _mm_loadu_ps ((const float *) (tw + 2 * m + p)), rot, y0, y1, y2, y3);
+
+    _mm_storeu_ps ((float *) (y + 4 * p), _mm_movelh_ps (y0, y1));
+    _mm_storeu_ps ((float *) (y + 4 * p + 2), _mm_movelh_ps (y2, y3));
+    _mm_storeu_ps ((float *) (y + 4 * p + 4), _mm_movehl_ps (y1, y0));
+    _mm_storeu_ps ((float *) (y + 4 * p + 6), _mm_movehl_ps (y3, y2));
+  }
+}
+
+/* all other steps have an even stride and vectorize over q */
+static void
+fft_step_sse (int n, int s, const kiss_fft_f32_cpx * tw, __m128 rot,
+    const kiss_fft_f32_cpx * x, kiss_fft_f32_cpx * y)
+{
+  int m = n / 4, p, q;
+
+  for (p = 0; p < m; p++) {
+    const float *x0 = (const float *) (x + s * p);
+    float *y0 = (float *) (y + 4 * s * p);
+    __m128 w1, w2, w3;
+
+    w1 = _mm_set_ps (tw[p].i, tw[p].r, tw[p].i, tw[p].r);
+    w2 = _mm_set_ps (tw[m + p].i, tw[m + p].r, tw[m + p].i, tw[m + p].r);
+    w3 = _mm_set_ps (tw[2 * m + p].i, tw[2 * m + p].r, tw[2 * m + p].i,
+        tw[2 * m + p].r);
+
+    for (q = 0; q < 2 * s; q += 4) {
+      __m128 a, b, c, d, r0, r1, r2, r3;
+
+      a = _mm_loadu_ps (x0 + q);
+      b = _mm_loadu_ps (x0 + 2 * s * m + q);
+      c = _mm_loadu_ps (x0 + 4 * s * m + q);
+      d = _mm_loadu_ps (x0 + 6 * s * m + q);
+
+      BUTTERFLY_4 (a, b, c, d, w1, w2, w3, rot, r0, r1, r2, r3);
+
+      _mm_storeu_ps (y0 + q, r0);
+      _mm_storeu_ps (y0 + 2 * s + q, r1);
+      _mm_storeu_ps (y0 + 4 * s + q, r2);
+      _mm_storeu_ps (y0 + 6 * s + q, r3);
+    }
+  }
+}
+
+/* the last step for odd powers of two, n = 2 */
+static void
+fft_step_2_sse (int s, const kiss_fft_f32_cpx * x, kiss_fft_f32_cpx * y)
+{
+  const float *x0 = (const float *) x;
+  float *y0 = (float *) y;
+  int q;
+
+  for (q = 0; q < 2 * s; q += 4) {
+    __m128 a = _mm_loadu_ps (x0 + q);
+    __m128 b = _mm_loadu_ps (x0 + 2 * s + q);
+
+    _mm_storeu_ps (y0 + q, _mm_add_ps (a, b));
+    _mm_storeu_ps (y0 + 2 * s + q, _mm_sub_ps (a, b));
+  }
+}
+
+void
+gst_fft_f32_fft_sse (const kiss_fft_f32_cpx * twiddles, int nfft,
+    int inverse, const kiss_fft_f32_cpx * fin, kiss_fft_f32_cpx * fout,
+    kiss_fft_f32_cpx * work)
+{
+  const kiss_fft_f32_cpx *x = fin;
+  kiss_fft_f32_cpx *y;
+  __m128 rot;
+  int n, s, steps = 0;
+
+  if (inverse)
+    rot = _mm_set_ps (0.0f, -0.0f, 0.0f, -0.0f);
+  else
+    rot = _mm_set_ps (-0.0f, 0.0f, -0.0f, 0.0f);
+
+  for (n = nfft; n > 1; n /= 4)
+    steps++;
+
+  /* alternate between the two buffers so that the last step ends up in
+   * the output */
+  y = (steps % 2) ? fout : work;
+  fft_step_1_sse (nfft, twiddles, rot, x, y);
+  twiddles += 3 * (nfft / 4);
+
+  for (n = nfft / 4, s = 4; n >= 4; n /= 4, s *= 4) {
+    x = y;
+    y = (y == fout) ? work : fout;
+    fft_step_sse (n, s, twiddles, rot, x, y);
+    twiddles += 3 * (n / 4);
+  }
+
+  if (n == 2)
+    fft_step_2_sse (s, y, y == fout ? work : fout);
+}
+#endif
@@ -0,0 +1,158 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gstfftf64-x86-sse2.h"
+
+/* The same radix-4 Stockham FFT as in gstfftf32-x86-sse.c, with one
+ * complex sample per vector. */
+
+#if defined (HAVE_EMMINTRIN_H) && defined(__SSE2__)
+#include <emmintrin.h>
+
+void
+gst_fft_f64_init_twiddles_sse2 (kiss_fft_f64_cpx * twiddles, int nfft,
+    int inverse)
+{
+  const double pi =
+      3.141592653589793238462643383279502884197169399375105820974944;
+  int n, m, p, k;
+
+  for (n = nfft; n >= 4; n /= 4) {
+    m = n / 4;
+    for (k = 1; k <= 3; k++) {
+      for (p = 0; p < m; p++) {
+        double phase = -2 * pi * k * p / n;
+
+        if (inverse)
+          phase *= -1;
+        twiddles[p].r = cos (phase);
+        twiddles[p].i = sin (phase);
+      }
+      twiddles += m;
+    }
+  }
+}
+
+static inline __m128d
+cmul_sse2 (__m128d a, __m128d w)
+{
+  const __m128d sign = _mm_set_pd (0.0, -0.0);
+  __m128d wr = _mm_unpacklo_pd (w, w);
+  __m128d wi = _mm_unpackhi_pd (w, w);
+  __m128d as = _mm_shuffle_pd (a, a, 1);
+
+  return _mm_add_pd (_mm_mul_pd (a, wr),
+      _mm_mul_pd (_mm_xor_pd (as, sign), wi));
+}
+
+/* multiplies by -i, or by i with the sign of @rot negated */
+static inline __m128d
+rotate_sse2 (__m128d a, __m128d rot)
+{
+  return _mm_xor_pd (_mm_shuffle_pd (a, a, 1), rot);
+}
+
+static void
+fft_step_sse2 (int n, int s, const kiss_fft_f64_cpx * tw, __m128d rot,
+    const kiss_fft_f64_cpx * x, kiss_fft_f64_cpx * y)
+{
+  int m = n / 4, p, q;
+
+  for (p = 0; p < m; p++) {
+    const double *x0 = (const double *) (x + s * p);
+    double *y0 = (double *) (y + 4 * s * p);
+    __m128d w1, w2, w3;
+
+    w1 = _mm_loadu_pd ((const double *) (tw + p));
+    w2 = _mm_loadu_pd ((const double *) (tw + m + p));
+    w3 = _mm_loadu_pd ((const double *) (tw + 2 * m + p));
+
+    for (q = 0; q < 2 * s; q += 2) {
+      __m128d a, b, c, d, apc, amc, bpd, jbmd;
+
+      a = _mm_loadu_pd (x0 + q);
+      b = _mm_loadu_pd (x0 + 2 * s * m + q);
+      c = _mm_loadu_pd (x0 + 4 * s * m + q);
+      d = _mm_loadu_pd (x0 + 6 * s * m + q);
+
+      apc = _mm_add_pd (a, c);
+      amc = _mm_sub_pd (a, c);
+      bpd = _mm_add_pd (b, d);
+      jbmd = rotate_sse2 (_mm_sub_pd (b, d), rot);
+
+      _mm_storeu_pd (y0 + q, _mm_add_pd (apc, bpd));
+      _mm_storeu_pd (y0 + 2 * s + q, cmul_sse2 (_mm_add_pd (amc, jbmd), w1));
+      _mm_storeu_pd (y0 + 4 * s + q, cmul_sse2 (_mm_sub_pd (apc, bpd), w2));
+      _mm_storeu_pd (y0 + 6 * s + q, cmul_sse2 (_mm_sub_pd (amc, jbmd), w3));
+    }
+  }
+}
+
+/* the last step for odd powers of two, n = 2 */
+static void
+fft_step_2_sse2 (int s, const kiss_fft_f64_cpx * x, kiss_fft_f64_cpx * y)
+{
+  const double *x0 = (const double *) x;
+  double *y0 = (double *) y;
+  int q;
+
+  for (q = 0; q < 2 * s; q += 2) {
+    __m128d a = _mm_loadu_pd (x0 + q);
+    __m128d b = _mm_loadu_pd (x0 + 2 * s + q);
+
+    _mm_storeu_pd (y0 + q, _mm_add_pd (a, b));
+    _mm_storeu_pd (y0 + 2 * s + q, _mm_sub_pd (a, b));
+  }
+}
+
+void
+gst_fft_f64_fft_sse2 (const kiss_fft_f64_cpx * twiddles, int nfft,
+    int inverse, const kiss_fft_f64_cpx * fin, kiss_fft_f64_cpx * fout,
+    kiss_fft_f64_cpx * work)
+{
+  const kiss_fft_f64_cpx *x = fin;
+  kiss_fft_f64_cpx *y;
+  __m128d rot;
+  int n, s, steps = 0;
+
+  if (inverse)
+    rot = _mm_set_pd (0.0, -0.0);
+  else
+    rot = _mm_set_pd (-0.0, 0.0);
+
+  for (n = nfft; n > 1; n /= 4)
+    steps++;
+
+  /* alternate between the two buffers so that the last step ends up in
+   * the output */
+  y = (steps % 2) ? fout : work;
+  for (n = nfft, s = 1; n >= 4; n /= 4, s *= 4) {
+    fft_step_sse2 (n, s, twiddles, rot, x, y);
+    twiddles += 3 * (n / 4);
+    x = y;
+    y = (y == fout) ? work : fout;
+  }
+
+  if (n == 2)
+    fft_step_2_sse2 (s, x, y);
+}
+#endif
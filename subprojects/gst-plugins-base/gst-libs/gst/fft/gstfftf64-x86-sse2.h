@@ -0,0 +1,34 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_FFT_F64_X86_SSE2_H__
+#define __GST_FFT_F64_X86_SSE2_H__
+
+#include "kiss_fft_f64.h"
+
+/* Complex FFT of a power of two length of at least 16, see
+ * gstfftf64-x86-sse2.c. @twiddles must have room for @nfft values and
+ * @work for @nfft samples. */
+void gst_fft_f64_init_twiddles_sse2 (kiss_fft_f64_cpx * twiddles, int nfft,
+    int inverse);
+
+void gst_fft_f64_fft_sse2 (const kiss_fft_f64_cpx * twiddles, int nfft,
+    int inverse, const kiss_fft_f64_cpx * fin, kiss_fft_f64_cpx * fout,
+    kiss_fft_f64_cpx * work);
+
+#endif /* __GST_FFT_F64_X86_SSE2_H__ */
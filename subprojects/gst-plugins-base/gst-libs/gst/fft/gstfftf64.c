@@ -44,7 +44,8 @@
  *
  * For the best performance use gst_fft_next_fast_length() to get a
  * number that is entirely a product of 2, 3 and 5 and use this as the
- * @len parameter for gst_fft_f64_new().
+ * @len parameter for gst_fft_f64_new(). Powers of two are the fastest
+ * lengths, they use vectorized code if the CPU supports it.
  *
  * The @len parameter specifies the number of samples in the time domain that
  * will be processed or generated. The number of samples in the frequency domain
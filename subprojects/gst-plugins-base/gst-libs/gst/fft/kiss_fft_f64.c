@@ -12,6 +12,10 @@
  fixed or floating point complex numbers.  It also delares the kf_ internal functions.
  */
 
+#if defined (HAVE_EMMINTRIN_H) && HAVE_SSE2
+#include "gstfftf64-x86-sse2.h"
+#endif
+
 static void
 kf_bfly2 (kiss_fft_f64_cpx * Fout,
     const size_t fstride, const kiss_fft_f64_cfg st, int m)
@@ -350,6 +354,28 @@ kf_factor (int n, int *facbuf)
   } while (n > 1);
 }
 
+/* Powers of two from 16 on use the vectorized implementation if the CPU
+ * supports it, everything else the generic code above. */
+static int
+kf_use_simd (int nfft)
+{
+  if (nfft < 16 || (nfft & (nfft - 1)) != 0)
+    return 0;
+
+#if defined (HAVE_EMMINTRIN_H) && HAVE_SSE2
+#if defined (__x86_64__) || defined (_M_X64)
+  return 1;
+#elif defined (__GNUC__)
+  __builtin_cpu_init ();
+  return __builtin_cpu_supports ("sse2");
+#else
+  return 0;
+#endif
+#else
+  return 0;
+#endif
+}
+
 /*
  *
  * User-callable function to allocate all necessary storage space for the fft.
@@ -361,9 +387,13 @@ kiss_fft_f64_cfg
 kiss_fft_f64_alloc (int nfft, int inverse_fft, void *mem, size_t * lenmem)
 {
   kiss_fft_f64_cfg st = NULL;
+  int use_simd = kf_use_simd (nfft);
   size_t memneeded = sizeof (struct kiss_fft_f64_state)
       + sizeof (kiss_fft_f64_cpx) * (nfft - 1); /* twiddle factors */
 
+  if (use_simd)
+    memneeded += sizeof (kiss_fft_f64_cpx) * 2 * nfft;
+
   if (lenmem == NULL) {
     st = (kiss_fft_f64_cfg) KISS_FFT_F64_MALLOC (memneeded);
   } else {
@@ -386,6 +416,15 @@ kiss_fft_f64_alloc (int nfft, int inverse_fft, void *mem, size_t * lenmem)
     }
 
     kf_factor (nfft, st->factors);
+
+    st->simd_twiddles = st->simd_work = NULL;
+#if defined (HAVE_EMMINTRIN_H) && HAVE_SSE2
+    if (use_simd) {
+      st->simd_twiddles = st->twiddles + nfft;
+      st->simd_work = st->simd_twiddles + nfft;
+      gst_fft_f64_init_twiddles_sse2 (st->simd_twiddles, nfft, inverse_fft);
+    }
+#endif
   }
   return st;
 }
@@ -395,6 +434,14 @@ void
 kiss_fft_f64_stride (kiss_fft_f64_cfg st, const kiss_fft_f64_cpx * fin,
     kiss_fft_f64_cpx * fout, int in_stride)
 {
+#if defined (HAVE_EMMINTRIN_H) && HAVE_SSE2
+  if (st->simd_twiddles && in_stride == 1 && fin != fout) {
+    gst_fft_f64_fft_sse2 (st->simd_twiddles, st->nfft, st->inverse, fin, fout,
+        st->simd_work);
+    return;
+  }
+#endif
+
   if (fin == fout) {
     //NOTE: this is not really an in-place FFT algorithm.
     //It just performs an out-of-place FFT into a temp buffer
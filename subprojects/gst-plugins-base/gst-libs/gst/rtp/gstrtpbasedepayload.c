@@ -29,6 +29,8 @@
 #include "config.h"
 #endif
 
+#include <string.h>
+
 #include "gstrtpbasedepayload.h"
 #include "gstrtpmeta.h"
 #include "gstrtphdrext.h"
@@ -75,6 +77,17 @@ struct _GstRTPBaseDepayloadPrivate
 
   /* array of GstRTPHeaderExtension's * */
   GPtrArray *header_exts;
+
+  /* the packets being processed, see gst_rtp_base_depayload_queue() */
+  GstRTPBuffer *packets;
+  guint n_packets;
+  /* the packet the timestamps and discont flag were last taken from */
+  gint packet_idx;
+  GstBufferList *queued;
+
+  /* storage for the packets of a buffer list */
+  GstRTPBuffer *packet_storage;
+  guint packet_storage_len;
 };
 
 /* Filter signals and args */
@@ -419,6 +432,9 @@ gst_rtp_base_depayload_finalize (GObject * object)
   g_ptr_array_unref (rtpbasedepayload->priv->header_exts);
   rtpbasedepayload->priv->header_exts = NULL;
 
+  g_free (rtpbasedepayload->priv->packet_storage);
+  rtpbasedepayload->priv->packet_storage = NULL;
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -669,71 +685,44 @@ caps_not_changed:
   }
 }
 
-/* takes ownership of the input buffer */
-static GstFlowReturn
-gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
-    GstRTPBaseDepayloadClass * bclass, GstBuffer * in)
+/* Drops the reference timestamp meta of @in if it is the same as the one of
+ * the previous packet. Takes ownership of @in and returns the buffer to use
+ * from now on. */
+static GstBuffer *
+gst_rtp_base_depayload_drop_duplicate_ref_ts (GstRTPBaseDepayload * filter,
+    GstBuffer * in)
 {
-  GstBuffer *(*process_rtp_packet_func) (GstRTPBaseDepayload * base,
-      GstRTPBuffer * rtp_buffer);
-  GstBuffer *(*process_func) (GstRTPBaseDepayload * base, GstBuffer * in);
-  GstRTPBaseDepayloadPrivate *priv;
-  GstBuffer *out_buf;
-  guint32 ssrc;
-  guint16 seqnum;
-  guint32 rtptime;
-  gboolean discont, buf_discont;
-  gint gap;
-  GstRTPBuffer rtp = { NULL };
+  GstRTPBaseDepayloadPrivate *priv = filter->priv;
   GstReferenceTimestampMeta *meta;
   GstCaps *ref_caps;
 
-  priv = filter->priv;
-  priv->process_flow_ret = GST_FLOW_OK;
-
-  process_func = bclass->process;
-  process_rtp_packet_func = bclass->process_rtp_packet;
-
-  /* we must have a setcaps first */
-  if (G_UNLIKELY (!priv->negotiated))
-    goto not_negotiated;
-
-  /* Check for duplicate reference timestamp metadata */
   ref_caps = gst_static_caps_get (&ntp_reference_timestamp_caps);
   meta = gst_buffer_get_reference_timestamp_meta (in, ref_caps);
-  gst_caps_unref (ref_caps);
   if (meta) {
     guint64 ref_ts = meta->timestamp;
     if (ref_ts == priv->ref_ts) {
       /* Drop the redundant/duplicate reference timstamp metadata */
       in = gst_buffer_make_writable (in);
+      meta = gst_buffer_get_reference_timestamp_meta (in, ref_caps);
       gst_buffer_remove_meta (in, GST_META_CAST (meta));
     } else {
       priv->ref_ts = ref_ts;
     }
   }
+  gst_caps_unref (ref_caps);
 
-  if (G_UNLIKELY (!gst_rtp_buffer_map (in, GST_MAP_READ, &rtp)))
-    goto invalid_buffer;
-
-  buf_discont = GST_BUFFER_IS_DISCONT (in);
-
-  priv->pts = GST_BUFFER_PTS (in);
-  priv->dts = GST_BUFFER_DTS (in);
-  priv->duration = GST_BUFFER_DURATION (in);
-
-  ssrc = gst_rtp_buffer_get_ssrc (&rtp);
-  seqnum = gst_rtp_buffer_get_seq (&rtp);
-  rtptime = gst_rtp_buffer_get_timestamp (&rtp);
-
-  priv->last_seqnum = seqnum;
-  priv->last_rtptime = rtptime;
-
-  discont = buf_discont;
+  return in;
+}
 
-  GST_LOG_OBJECT (filter, "discont %d, seqnum %u, rtptime %u, pts %"
-      GST_TIME_FORMAT ", dts %" GST_TIME_FORMAT, buf_discont, seqnum, rtptime,
-      GST_TIME_ARGS (priv->pts), GST_TIME_ARGS (priv->dts));
+/* Checks the seqnum and SSRC of a packet against the previous packet.
+ * Returns %FALSE if the packet is a duplicate that should be dropped and
+ * sets @discont if packets were lost or the sender restarted. */
+static gboolean
+gst_rtp_base_depayload_check_seqnum (GstRTPBaseDepayload * filter,
+    guint32 ssrc, guint16 seqnum, gboolean * discont)
+{
+  GstRTPBaseDepayloadPrivate *priv = filter->priv;
+  gint gap;
 
   /* Check seqnum. This is a very simple check that makes sure that the seqnums
    * are strictly increasing, dropping anything that is out of the ordinary. We
@@ -743,7 +732,7 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
       GST_LOG_OBJECT (filter,
           "New ssrc %u (current ssrc %u), sender restarted",
           ssrc, priv->last_ssrc);
-      discont = TRUE;
+      *discont = TRUE;
     } else {
       gap = gst_rtp_buffer_compare_seqnum (seqnum, priv->next_seqnum);
 
@@ -755,7 +744,7 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
           /* seqnum > next_seqnum, we are missing some packets, this is always a
            * DISCONT. */
           GST_LOG_OBJECT (filter, "%d missing packets", gap);
-          discont = TRUE;
+          *discont = TRUE;
         } else {
           /* seqnum < next_seqnum, we have seen this packet before, have a
            * reordered packet or the sender could be restarted. If the packet
@@ -766,11 +755,11 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
             GST_WARNING_OBJECT (filter, "got old packet %u, expected %u, "
                 "gap %d <= max_reorder (%d), dropping!",
                 seqnum, priv->next_seqnum, gap, priv->max_reorder);
-            goto dropping;
+            return FALSE;
           }
           GST_WARNING_OBJECT (filter, "got old packet %u, expected %u, "
               "marking discont", seqnum, priv->next_seqnum);
-          discont = TRUE;
+          *discont = TRUE;
         }
       }
     }
@@ -778,6 +767,71 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
   priv->next_seqnum = (seqnum + 1) & 0xffff;
   priv->last_ssrc = ssrc;
 
+  return TRUE;
+}
+
+static GstFlowReturn gst_rtp_base_depayload_push_queued (GstRTPBaseDepayload *
+    filter);
+static void gst_rtp_base_depayload_select_packet (GstRTPBaseDepayload *
+    filter, gint idx);
+
+/* takes ownership of the input buffer */
+static GstFlowReturn
+gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
+    GstRTPBaseDepayloadClass * bclass, GstBuffer * in)
+{
+  GstBuffer *(*process_rtp_packet_func) (GstRTPBaseDepayload * base,
+      GstRTPBuffer * rtp_buffer);
+  GstBuffer *(*process_func) (GstRTPBaseDepayload * base, GstBuffer * in);
+  GstFlowReturn (*process_rtp_packet_list_func) (GstRTPBaseDepayload * base,
+      GstRTPBuffer * packets, guint n_packets);
+  GstRTPBaseDepayloadPrivate *priv;
+  GstBuffer *out_buf;
+  guint32 ssrc;
+  guint16 seqnum;
+  guint32 rtptime;
+  gboolean discont, buf_discont;
+  GstRTPBuffer rtp = { NULL };
+
+  priv = filter->priv;
+  priv->process_flow_ret = GST_FLOW_OK;
+
+  process_func = bclass->process;
+  process_rtp_packet_func = bclass->process_rtp_packet;
+  process_rtp_packet_list_func = bclass->process_rtp_packet_list;
+
+  /* we must have a setcaps first */
+  if (G_UNLIKELY (!priv->negotiated))
+    goto not_negotiated;
+
+  /* Check for duplicate reference timestamp metadata */
+  in = gst_rtp_base_depayload_drop_duplicate_ref_ts (filter, in);
+
+  if (G_UNLIKELY (!gst_rtp_buffer_map (in, GST_MAP_READ, &rtp)))
+    goto invalid_buffer;
+
+  buf_discont = GST_BUFFER_IS_DISCONT (in);
+
+  priv->pts = GST_BUFFER_PTS (in);
+  priv->dts = GST_BUFFER_DTS (in);
+  priv->duration = GST_BUFFER_DURATION (in);
+
+  ssrc = gst_rtp_buffer_get_ssrc (&rtp);
+  seqnum = gst_rtp_buffer_get_seq (&rtp);
+  rtptime = gst_rtp_buffer_get_timestamp (&rtp);
+
+  priv->last_seqnum = seqnum;
+  priv->last_rtptime = rtptime;
+
+  discont = buf_discont;
+
+  GST_LOG_OBJECT (filter, "discont %d, seqnum %u, rtptime %u, pts %"
+      GST_TIME_FORMAT ", dts %" GST_TIME_FORMAT, buf_discont, seqnum, rtptime,
+      GST_TIME_ARGS (priv->pts), GST_TIME_ARGS (priv->dts));
+
+  if (!gst_rtp_base_depayload_check_seqnum (filter, ssrc, seqnum, &discont))
+    goto dropping;
+
   if (G_UNLIKELY (discont)) {
     priv->discont = TRUE;
     if (!buf_discont) {
@@ -808,9 +862,31 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
 
   priv->input_buffer = in;
 
-  if (process_rtp_packet_func != NULL) {
-    out_buf = process_rtp_packet_func (filter, &rtp);
+  if (process_rtp_packet_func != NULL || process_rtp_packet_list_func != NULL) {
+    /* allow the subclass to queue output for this packet, the timestamps and
+     * discont flag of it were already taken above */
+    priv->packets = &rtp;
+    priv->n_packets = 1;
+    priv->packet_idx = 0;
+
+    if (process_rtp_packet_func != NULL) {
+      out_buf = process_rtp_packet_func (filter, &rtp);
+    } else {
+      GstFlowReturn ret = process_rtp_packet_list_func (filter, &rtp, 1);
+
+      if (ret != GST_FLOW_OK && priv->process_flow_ret == GST_FLOW_OK)
+        priv->process_flow_ret = ret;
+      out_buf = NULL;
+    }
+
+    priv->packets = NULL;
+    priv->n_packets = 0;
     gst_rtp_buffer_unmap (&rtp);
+
+    if (priv->process_flow_ret == GST_FLOW_OK)
+      gst_rtp_base_depayload_push_queued (filter);
+    else
+      gst_clear_buffer_list (&priv->queued);
   } else if (process_func != NULL) {
     gst_rtp_buffer_unmap (&rtp);
     out_buf = process_func (filter, in);
@@ -887,6 +963,131 @@ gst_rtp_base_depayload_chain (GstPad * pad, GstObject * parent, GstBuffer * in)
   return flow_ret;
 }
 
+/* Maps all packets of @list and checks them in one go, then hands them to
+ * process_rtp_packet_list. Takes ownership of @list. */
+static GstFlowReturn
+gst_rtp_base_depayload_handle_list (GstRTPBaseDepayload * filter,
+    GstRTPBaseDepayloadClass * bclass, GstBufferList * list)
+{
+  GstRTPBaseDepayloadPrivate *priv = filter->priv;
+  GstRTPBuffer *packets;
+  guint i, len, n_packets = 0;
+  GstFlowReturn ret;
+
+  priv->process_flow_ret = GST_FLOW_OK;
+
+  len = gst_buffer_list_length (list);
+  if (len == 0) {
+    gst_buffer_list_unref (list);
+    return GST_FLOW_OK;
+  }
+
+  if (len > priv->packet_storage_len) {
+    priv->packet_storage = g_renew (GstRTPBuffer, priv->packet_storage, len);
+    priv->packet_storage_len = len;
+  }
+  packets = priv->packet_storage;
+
+  /* take our own references, once the list is gone they are usually the only
+   * ones so setting flags and removing metas does not copy the buffers */
+  for (i = 0; i < len; i++)
+    packets[i].buffer = gst_buffer_ref (gst_buffer_list_get (list, i));
+  gst_buffer_list_unref (list);
+
+  for (i = 0; i < len; i++) {
+    GstBuffer *in = packets[i].buffer;
+    GstRTPBuffer *rtp = &packets[n_packets];
+    gboolean discont;
+    guint32 ssrc;
+    guint16 seqnum;
+
+    in = gst_rtp_base_depayload_drop_duplicate_ref_ts (filter, in);
+
+    memset (rtp, 0, sizeof (GstRTPBuffer));
+    if (G_UNLIKELY (!gst_rtp_buffer_map (in, GST_MAP_READ, rtp))) {
+      GST_ELEMENT_WARNING (filter, STREAM, DECODE, (NULL),
+          ("Received invalid RTP payload, dropping"));
+      gst_buffer_unref (in);
+      continue;
+    }
+
+    ssrc = gst_rtp_buffer_get_ssrc (rtp);
+    seqnum = gst_rtp_buffer_get_seq (rtp);
+    discont = GST_BUFFER_IS_DISCONT (in);
+
+    GST_LOG_OBJECT (filter, "discont %d, seqnum %u, rtptime %u, pts %"
+        GST_TIME_FORMAT ", dts %" GST_TIME_FORMAT, discont, seqnum,
+        gst_rtp_buffer_get_timestamp (rtp),
+        GST_TIME_ARGS (GST_BUFFER_PTS (in)),
+        GST_TIME_ARGS (GST_BUFFER_DTS (in)));
+
+    if (!gst_rtp_base_depayload_check_seqnum (filter, ssrc, seqnum, &discont)) {
+      gst_rtp_buffer_unmap (rtp);
+      gst_buffer_unref (in);
+      continue;
+    }
+
+    if (G_UNLIKELY (discont && !GST_BUFFER_IS_DISCONT (in))) {
+      /* the discont flag is picked up by gst_rtp_base_depayload_queue(), and
+       * subclasses check it on the rtp buffer too */
+      GST_LOG_OBJECT (filter, "mark DISCONT on input buffer");
+      gst_rtp_buffer_unmap (rtp);
+      in = gst_buffer_make_writable (in);
+      GST_BUFFER_FLAG_SET (in, GST_BUFFER_FLAG_DISCONT);
+      memset (rtp, 0, sizeof (GstRTPBuffer));
+      if (G_UNLIKELY (!gst_rtp_buffer_map (in, GST_MAP_READ, rtp))) {
+        gst_buffer_unref (in);
+        continue;
+      }
+    }
+
+    /* prepare segment event if needed */
+    if (filter->need_newsegment) {
+      priv->segment_event = create_segment_event (filter,
+          gst_rtp_buffer_get_timestamp (rtp), GST_BUFFER_PTS (in));
+      filter->need_newsegment = FALSE;
+    }
+
+    n_packets++;
+  }
+
+  if (n_packets > 0) {
+    priv->last_seqnum = gst_rtp_buffer_get_seq (&packets[n_packets - 1]);
+    priv->last_rtptime =
+        gst_rtp_buffer_get_timestamp (&packets[n_packets - 1]);
+
+    priv->packets = packets;
+    priv->n_packets = n_packets;
+    priv->packet_idx = -1;
+
+    ret = bclass->process_rtp_packet_list (filter, packets, n_packets);
+    if (ret != GST_FLOW_OK && priv->process_flow_ret == GST_FLOW_OK)
+      priv->process_flow_ret = ret;
+
+    /* carry over the discont flag and timestamps of packets without output to
+     * whatever is pushed next */
+    gst_rtp_base_depayload_select_packet (filter, n_packets - 1);
+
+    priv->packets = NULL;
+    priv->n_packets = 0;
+    priv->input_buffer = NULL;
+
+    for (i = 0; i < n_packets; i++) {
+      GstBuffer *in = packets[i].buffer;
+
+      gst_rtp_buffer_unmap (&packets[i]);
+      gst_buffer_unref (in);
+    }
+
+    if (priv->process_flow_ret == GST_FLOW_OK)
+      gst_rtp_base_depayload_push_queued (filter);
+    else
+      gst_clear_buffer_list (&priv->queued);
+  }
+
+  return priv->process_flow_ret;
+}
+
 static GstFlowReturn
 gst_rtp_base_depayload_chain_list (GstPad * pad, GstObject * parent,
     GstBufferList * list)
@@ -901,6 +1102,9 @@ gst_rtp_base_depayload_chain_list (GstPad * pad, GstObject * parent,
 
   bclass = GST_RTP_BASE_DEPAYLOAD_GET_CLASS (basedepay);
 
+  if (bclass->process_rtp_packet_list != NULL && basedepay->priv->negotiated)
+    return gst_rtp_base_depayload_handle_list (basedepay, bclass, list);
+
   flow_ret = GST_FLOW_OK;
 
   /* chain each buffer in list individually */
@@ -1468,6 +1672,14 @@ gst_rtp_base_depayload_push (GstRTPBaseDepayload * filter, GstBuffer * out_buf)
 {
   GstFlowReturn res;
 
+  if (G_UNLIKELY (filter->priv->queued)) {
+    res = gst_rtp_base_depayload_push_queued (filter);
+    if (res != GST_FLOW_OK) {
+      gst_buffer_unref (out_buf);
+      return res;
+    }
+  }
+
   res = gst_rtp_base_depayload_do_push (filter, FALSE, out_buf);
 
   if (res != GST_FLOW_OK)
@@ -1492,6 +1704,14 @@ gst_rtp_base_depayload_push_list (GstRTPBaseDepayload * filter,
 {
   GstFlowReturn res;
 
+  if (G_UNLIKELY (filter->priv->queued)) {
+    res = gst_rtp_base_depayload_push_queued (filter);
+    if (res != GST_FLOW_OK) {
+      gst_buffer_list_unref (out_list);
+      return res;
+    }
+  }
+
   res = gst_rtp_base_depayload_do_push (filter, TRUE, out_list);
 
   if (res != GST_FLOW_OK)
@@ -1500,6 +1720,119 @@ gst_rtp_base_depayload_push_list (GstRTPBaseDepayload * filter,
   return res;
 }
 
+static GstFlowReturn
+gst_rtp_base_depayload_push_queued (GstRTPBaseDepayload * filter)
+{
+  GstBufferList *list = filter->priv->queued;
+  GstFlowReturn res;
+
+  if (list == NULL)
+    return GST_FLOW_OK;
+
+  filter->priv->queued = NULL;
+
+  GST_LOG_OBJECT (filter, "pushing %u queued buffers",
+      gst_buffer_list_length (list));
+
+  res = gst_rtp_base_depayload_finish_push (filter, TRUE, list);
+
+  if (res != GST_FLOW_OK)
+    filter->priv->process_flow_ret = res;
+
+  return res;
+}
+
+/* Makes the packet at @idx the one whose timestamps, header extensions and
+ * source information are applied to the next output. The discont flag of any
+ * packet since the previously selected one is carried over. */
+static void
+gst_rtp_base_depayload_select_packet (GstRTPBaseDepayload * filter, gint idx)
+{
+  GstRTPBaseDepayloadPrivate *priv = filter->priv;
+  GstBuffer *in;
+  gint i;
+
+  if (idx <= priv->packet_idx)
+    return;
+
+  for (i = priv->packet_idx + 1; i <= idx; i++) {
+    if (GST_BUFFER_IS_DISCONT (priv->packets[i].buffer))
+      priv->discont = TRUE;
+  }
+
+  in = priv->packets[idx].buffer;
+  priv->pts = GST_BUFFER_PTS (in);
+  priv->dts = GST_BUFFER_DTS (in);
+  priv->duration = GST_BUFFER_DURATION (in);
+  priv->input_buffer = in;
+  priv->packet_idx = idx;
+}
+
+/**
+ * gst_rtp_base_depayload_queue:
+ * @filter: a #GstRTPBaseDepayload
+ * @rtp: the packet @out_buf was produced from
+ * @out_buf: (transfer full): a #GstBuffer
+ *
+ * Queue @out_buf to be pushed to the peer of @filter together with the other
+ * output of the packets that are currently processed, as one #GstBufferList.
+ * This can only be used from the #GstRTPBaseDepayloadClass.process_rtp_packet
+ * and #GstRTPBaseDepayloadClass.process_rtp_packet_list functions and @rtp
+ * must be one of the packets passed to them.
+ *
+ * Like with gst_rtp_base_depayload_push(), the timestamp of @rtp is applied
+ * to @out_buf when it doesn't have one already, but only to the first buffer
+ * that is queued for each packet. Output has to be queued in packet order.
+ *
+ * This function takes ownership of @out_buf.
+ *
+ * Returns: a #GstFlowReturn.
+ *
+ * Since: 1.24
+ */
+GstFlowReturn
+gst_rtp_base_depayload_queue (GstRTPBaseDepayload * filter, GstRTPBuffer * rtp,
+    GstBuffer * out_buf)
+{
+  GstRTPBaseDepayloadPrivate *priv;
+  GstFlowReturn res;
+
+  g_return_val_if_fail (GST_IS_RTP_BASE_DEPAYLOAD (filter), GST_FLOW_ERROR);
+  g_return_val_if_fail (GST_IS_BUFFER (out_buf), GST_FLOW_ERROR);
+
+  priv = filter->priv;
+
+  g_return_val_if_fail (priv->packets != NULL && rtp >= priv->packets
+      && rtp < priv->packets + priv->n_packets, GST_FLOW_ERROR);
+
+  if (G_UNLIKELY (priv->process_flow_ret != GST_FLOW_OK)) {
+    gst_buffer_unref (out_buf);
+    return priv->process_flow_ret;
+  }
+
+  gst_rtp_base_depayload_select_packet (filter, rtp - priv->packets);
+
+  if (G_UNLIKELY (gst_rtp_base_depayload_set_headers (filter, out_buf))) {
+    /* src caps have changed, push what was queued with the old caps first */
+    res = gst_rtp_base_depayload_push_queued (filter);
+    if (res != GST_FLOW_OK) {
+      gst_buffer_unref (out_buf);
+      return res;
+    }
+    if (!gst_rtp_base_depayload_set_src_caps_from_hdrext (filter)) {
+      gst_buffer_unref (out_buf);
+      priv->process_flow_ret = GST_FLOW_ERROR;
+      return GST_FLOW_ERROR;
+    }
+  }
+
+  if (priv->queued == NULL)
+    priv->queued = gst_buffer_list_new ();
+  gst_buffer_list_add (priv->queued, out_buf);
+
+  return GST_FLOW_OK;
+}
+
 /* convert the PacketLost event from a jitterbuffer to a GAP event.
  * subclasses can override this.  */
 static gboolean
@@ -82,6 +82,14 @@ struct _GstRTPBaseDepayload
  * timestamp, the timestamp of the input buffer will be applied to the result
  * buffer and the output buffer will be pushed out. If this function returns
  * %NULL, nothing is pushed out. Since: 1.6.
+ * @process_rtp_packet_list: Process a batch of rtp packets that the base
+ * class has mapped (with GST_MAP_READ) and checked for seqnum gaps and
+ * duplicates in one go, typically all packets of a #GstBufferList that was
+ * received from upstream. Output should be handed to
+ * gst_rtp_base_depayload_queue() together with the packet it was produced
+ * from and is pushed downstream as one #GstBufferList once the function
+ * returns. Single buffers are passed as a batch of one packet unless
+ * @process_rtp_packet is implemented too. Since: 1.24.
  *
  * Base class for RTP depayloaders.
  */
@@ -107,8 +115,11 @@ struct _GstRTPBaseDepayloadClass
 
   GstBuffer * (*process_rtp_packet) (GstRTPBaseDepayload *base, GstRTPBuffer * rtp_buffer);
 
+  GstFlowReturn (*process_rtp_packet_list) (GstRTPBaseDepayload *base, GstRTPBuffer * packets,
+                                            guint n_packets);
+
   /*< private >*/
-  gpointer _gst_reserved[GST_PADDING - 1];
+  gpointer _gst_reserved[GST_PADDING - 2];
 };
 
 GST_RTP_API
@@ -120,6 +131,10 @@ GstFlowReturn   gst_rtp_base_depayload_push       (GstRTPBaseDepayload *filter,
 GST_RTP_API
 GstFlowReturn   gst_rtp_base_depayload_push_list  (GstRTPBaseDepayload *filter, GstBufferList *out_list);
 
+GST_RTP_API
+GstFlowReturn   gst_rtp_base_depayload_queue      (GstRTPBaseDepayload *filter, GstRTPBuffer *rtp,
+                                                   GstBuffer *out_buf);
+
 GST_RTP_API
 gboolean        gst_rtp_base_depayload_is_source_info_enabled  (GstRTPBaseDepayload * depayload);
 
@@ -78,6 +78,14 @@ struct _GstRTPBasePayloadPrivate
 
   /* array of GstRTPHeaderExtension's * */
   GPtrArray *header_exts;
+
+  /* recycles the header memory of packets that reference their payload */
+  GstBufferPool *header_pool;
+
+  /* packets of the current access unit, see gst_rtp_base_payload_queue() */
+  GstBufferList *queued;
+  GstClockTime queued_pts;
+  guint64 queued_offset;
 };
 
 /* RTPBasePayload signals and args */
@@ -118,6 +126,68 @@ static guint gst_rtp_base_payload_signals[LAST_SIGNAL] = { 0 };
 #define RTP_HEADER_EXT_ONE_BYTE_MAX_ID 14
 #define RTP_HEADER_EXT_TWO_BYTE_MAX_ID 255
 
+/* the fixed header, and large enough for the maximum number of CSRCs */
+#define RTP_HEADER_LEN 12
+#define RTP_HEADER_MAX_LEN (RTP_HEADER_LEN + 15 * sizeof (guint32))
+
+/* Buffer pool for the RTP header of packets created with
+ * gst_rtp_base_payload_allocate_output_buffer_for_region(). The payload and
+ * header extension memories that were appended to the header are dropped
+ * again when the packet is released so only the header memory is reused. */
+typedef GstBufferPool GstRTPHeaderPool;
+typedef GstBufferPoolClass GstRTPHeaderPoolClass;
+
+static GType gst_rtp_header_pool_get_type (void);
+G_DEFINE_TYPE (GstRTPHeaderPool, gst_rtp_header_pool, GST_TYPE_BUFFER_POOL);
+
+/* set on the header memory to the pool that allocated it */
+static GQuark header_pool_quark;
+
+static GstFlowReturn
+gst_rtp_header_pool_alloc_buffer (GstBufferPool * pool, GstBuffer ** buffer,
+    GstBufferPoolAcquireParams * params)
+{
+  GstFlowReturn ret;
+
+  ret = GST_BUFFER_POOL_CLASS (gst_rtp_header_pool_parent_class)->alloc_buffer
+      (pool, buffer, params);
+  if (ret == GST_FLOW_OK)
+    gst_mini_object_set_qdata (GST_MINI_OBJECT (gst_buffer_peek_memory
+            (*buffer, 0)), header_pool_quark, pool, NULL);
+
+  return ret;
+}
+
+static void
+gst_rtp_header_pool_reset_buffer (GstBufferPool * pool, GstBuffer * buffer)
+{
+  if (gst_buffer_n_memory (buffer) > 1)
+    gst_buffer_remove_memory_range (buffer, 1, -1);
+
+  /* only put the buffer back if the header memory is still our own */
+  if (gst_buffer_n_memory (buffer) == 1 &&
+      gst_mini_object_get_qdata (GST_MINI_OBJECT (gst_buffer_peek_memory
+              (buffer, 0)), header_pool_quark) == pool)
+    GST_BUFFER_FLAG_UNSET (buffer, GST_BUFFER_FLAG_TAG_MEMORY);
+
+  GST_BUFFER_POOL_CLASS (gst_rtp_header_pool_parent_class)->reset_buffer (pool,
+      buffer);
+}
+
+static void
+gst_rtp_header_pool_class_init (GstRTPHeaderPoolClass * klass)
+{
+  klass->alloc_buffer = gst_rtp_header_pool_alloc_buffer;
+  klass->reset_buffer = gst_rtp_header_pool_reset_buffer;
+
+  header_pool_quark = g_quark_from_static_string ("GstRTPHeaderPool");
+}
+
+static void
+gst_rtp_header_pool_init (GstRTPHeaderPool * pool)
+{
+}
+
 enum
 {
   PROP_0,
@@ -567,6 +637,15 @@ gst_rtp_base_payload_init (GstRTPBasePayload * rtpbasepayload, gpointer g_class)
       g_ptr_array_new_with_free_func ((GDestroyNotify) gst_object_unref);
 }
 
+static GstFlowReturn gst_rtp_base_payload_push_queued (GstRTPBasePayload *
+    payload);
+
+static void
+gst_rtp_base_payload_clear_queued (GstRTPBasePayload * payload)
+{
+  g_clear_pointer (&payload->priv->queued, gst_buffer_list_unref);
+}
+
 static void
 gst_rtp_base_payload_finalize (GObject * object)
 {
@@ -585,6 +664,13 @@ gst_rtp_base_payload_finalize (GObject * object)
   g_ptr_array_unref (rtpbasepayload->priv->header_exts);
   rtpbasepayload->priv->header_exts = NULL;
 
+  gst_rtp_base_payload_clear_queued (rtpbasepayload);
+  if (rtpbasepayload->priv->header_pool) {
+    gst_buffer_pool_set_active (rtpbasepayload->priv->header_pool, FALSE);
+    gst_object_unref (rtpbasepayload->priv->header_pool);
+    rtpbasepayload->priv->header_pool = NULL;
+  }
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -614,12 +700,18 @@ gst_rtp_base_payload_sink_event_default (GstRTPBasePayload * rtpbasepayload,
   GstObject *parent = GST_OBJECT_CAST (rtpbasepayload);
   gboolean res = FALSE;
 
+  /* queued packets go out before anything that is serialized with them */
+  if (GST_EVENT_IS_SERIALIZED (event)
+      && GST_EVENT_TYPE (event) != GST_EVENT_FLUSH_STOP)
+    gst_rtp_base_payload_push_queued (rtpbasepayload);
+
   switch (GST_EVENT_TYPE (event)) {
     case GST_EVENT_FLUSH_START:
       res = gst_pad_event_default (rtpbasepayload->sinkpad, parent, event);
       break;
     case GST_EVENT_FLUSH_STOP:
       res = gst_pad_event_default (rtpbasepayload->sinkpad, parent, event);
+      gst_rtp_base_payload_clear_queued (rtpbasepayload);
       gst_segment_init (&rtpbasepayload->segment, GST_FORMAT_UNDEFINED);
       gst_event_replace (&rtpbasepayload->priv->pending_segment, NULL);
       break;
@@ -870,6 +962,13 @@ gst_rtp_base_payload_chain (GstPad * pad, GstObject * parent,
 
   ret = rtpbasepayload_class->handle_buffer (rtpbasepayload, buffer);
 
+  /* push the packets the subclass queued for this input buffer while the
+   * input meta is still available for the header extensions */
+  if (ret == GST_FLOW_OK)
+    ret = gst_rtp_base_payload_push_queued (rtpbasepayload);
+  else
+    gst_rtp_base_payload_clear_queued (rtpbasepayload);
+
   gst_buffer_replace (&rtpbasepayload->priv->input_meta_buffer, NULL);
 
   return ret;
@@ -1711,12 +1810,49 @@ error:
   return;
 }
 
+/* Works out the header extension format and how many 32-bit words are
+ * needed to write all header extensions. Must be called with the object lock
+ * held. */
+static gboolean
+get_header_extension_layout (GstRTPBasePayload * payload, HeaderExt * hdrext,
+    guint16 * bit_pattern, guint * wordlen)
+{
+  gsize extlen;
+
+  /* XXX: pre-calculate these flags and sizes? */
+  hdrext->flags =
+      GST_RTP_HEADER_EXTENSION_ONE_BYTE | GST_RTP_HEADER_EXTENSION_TWO_BYTE;
+  g_ptr_array_foreach (payload->priv->header_exts,
+      (GFunc) determine_header_extension_flags_size, hdrext);
+  hdrext->hdr_unit_size = 0;
+  if (hdrext->flags & GST_RTP_HEADER_EXTENSION_ONE_BYTE) {
+    /* prefer the one byte header */
+    hdrext->hdr_unit_size = 1;
+    /* TODO: support mixed size writing modes, i.e. RFC8285 */
+    hdrext->flags &= ~GST_RTP_HEADER_EXTENSION_TWO_BYTE;
+    *bit_pattern = 0xBEDE;
+  } else if (hdrext->flags & GST_RTP_HEADER_EXTENSION_TWO_BYTE) {
+    hdrext->hdr_unit_size = 2;
+    *bit_pattern = 0x1000;
+  } else {
+    return FALSE;
+  }
+
+  extlen =
+      hdrext->hdr_unit_size * payload->priv->header_exts->len +
+      hdrext->allocated_size;
+  *wordlen = extlen / 4 + ((extlen % 4) ? 1 : 0);
+
+  return TRUE;
+}
+
 static gboolean
 set_headers (GstBuffer ** buffer, guint idx, gpointer user_data)
 {
   HeaderData *data = user_data;
   HeaderExt hdrext = { NULL, };
   GstRTPBuffer rtp = { NULL, };
+  gssize reserved_size = -1;
 
   if (!gst_rtp_buffer_map (*buffer, GST_MAP_READWRITE, &rtp))
     goto map_failed;
@@ -1729,42 +1865,39 @@ set_headers (GstBuffer ** buffer, guint idx, gpointer user_data)
   GST_OBJECT_LOCK (data->payload);
   if (data->payload->priv->header_exts->len > 0
       && data->payload->priv->input_meta_buffer) {
-    guint wordlen;
-    gsize extlen;
-    guint16 bit_pattern;
+    guint wordlen, reserved_wordlen;
+    guint16 bit_pattern, reserved_bits;
+    gpointer reserved_data;
+    gboolean reserved;
 
     /* write header extensions */
     hdrext.payload = data->payload;
     hdrext.output = *buffer;
-    /* XXX: pre-calculate these flags and sizes? */
-    hdrext.flags =
-        GST_RTP_HEADER_EXTENSION_ONE_BYTE | GST_RTP_HEADER_EXTENSION_TWO_BYTE;
-    g_ptr_array_foreach (data->payload->priv->header_exts,
-        (GFunc) determine_header_extension_flags_size, &hdrext);
-    hdrext.hdr_unit_size = 0;
-    if (hdrext.flags & GST_RTP_HEADER_EXTENSION_ONE_BYTE) {
-      /* prefer the one byte header */
-      hdrext.hdr_unit_size = 1;
-      /* TODO: support mixed size writing modes, i.e. RFC8285 */
-      hdrext.flags &= ~GST_RTP_HEADER_EXTENSION_TWO_BYTE;
-      bit_pattern = 0xBEDE;
-    } else if (hdrext.flags & GST_RTP_HEADER_EXTENSION_TWO_BYTE) {
-      hdrext.hdr_unit_size = 2;
-      bit_pattern = 0x1000;
-    } else {
+    if (!get_header_extension_layout (data->payload, &hdrext, &bit_pattern,
+            &wordlen))
       goto unsupported_flags;
-    }
-
-    extlen =
-        hdrext.hdr_unit_size * data->payload->priv->header_exts->len +
-        hdrext.allocated_size;
-    wordlen = extlen / 4 + ((extlen % 4) ? 1 : 0);
 
-    /* XXX: do we need to add to any existing extension data instead of
-     * overwriting everything? */
-    gst_rtp_buffer_set_extension_data (&rtp, bit_pattern, wordlen);
-    gst_rtp_buffer_get_extension_data (&rtp, NULL, (gpointer) & hdrext.data,
-        &wordlen);
+    /* packets from gst_rtp_base_payload_allocate_output_buffer_for_region()
+     * already have the space in a memory of their own, write into it
+     * directly. Resizing it would make the payload memories get merged into
+     * a writable copy. */
+    reserved = gst_rtp_buffer_get_extension_data (&rtp, &reserved_bits,
+        &reserved_data, &reserved_wordlen)
+        && reserved_bits == bit_pattern && reserved_wordlen >= wordlen
+        && gst_buffer_n_memory (*buffer) > 1
+        && rtp.map[1].memory == gst_buffer_peek_memory (*buffer, 1)
+        && rtp.map[1].data == rtp.data[1];
+
+    if (reserved) {
+      hdrext.data = reserved_data;
+      wordlen = reserved_wordlen;
+    } else {
+      /* XXX: do we need to add to any existing extension data instead of
+       * overwriting everything? */
+      gst_rtp_buffer_set_extension_data (&rtp, bit_pattern, wordlen);
+      gst_rtp_buffer_get_extension_data (&rtp, NULL, (gpointer) & hdrext.data,
+          &wordlen);
+    }
 
     /* from 32-bit words to bytes */
     hdrext.allocated_size = wordlen * 4;
@@ -1779,7 +1912,17 @@ set_headers (GstBuffer ** buffer, guint idx, gpointer user_data)
       memset (&hdrext.data[hdrext.written_size], 0,
           wordlen * 4 - hdrext.written_size);
 
-      gst_rtp_buffer_set_extension_data (&rtp, bit_pattern, wordlen);
+      if (!reserved) {
+        gst_rtp_buffer_set_extension_data (&rtp, bit_pattern, wordlen);
+      } else if (wordlen * 4 < hdrext.allocated_size) {
+        /* the memory is shrunk after unmapping */
+        GST_WRITE_UINT16_BE ((guint8 *) rtp.data[1] + 2, wordlen);
+        reserved_size = 4 + wordlen * 4;
+      }
+    } else if (reserved) {
+      /* the memory is removed after unmapping */
+      gst_rtp_buffer_set_extension (&rtp, FALSE);
+      reserved_size = 0;
     } else {
       gst_rtp_buffer_remove_extension_data (&rtp);
     }
@@ -1787,6 +1930,11 @@ set_headers (GstBuffer ** buffer, guint idx, gpointer user_data)
   GST_OBJECT_UNLOCK (data->payload);
   gst_rtp_buffer_unmap (&rtp);
 
+  if (reserved_size == 0)
+    gst_buffer_remove_memory (*buffer, 1);
+  else if (reserved_size > 0)
+    gst_buffer_resize_range (*buffer, 1, 1, 0, reserved_size);
+
   /* increment the seqnum for each buffer */
   data->seqnum++;
 
@@ -1966,13 +2114,55 @@ no_rate:
   }
 }
 
+static GstFlowReturn
+gst_rtp_base_payload_push_internal (GstRTPBasePayload * payload,
+    gpointer obj, gboolean is_list)
+{
+  GstFlowReturn res;
+
+  res = gst_rtp_base_payload_prepare_push (payload, obj, is_list);
+
+  if (G_LIKELY (res == GST_FLOW_OK)) {
+    if (G_UNLIKELY (payload->priv->pending_segment)) {
+      gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
+      payload->priv->pending_segment = FALSE;
+      payload->priv->delay_segment = FALSE;
+    }
+    if (is_list)
+      res = gst_pad_push_list (payload->srcpad, GST_BUFFER_LIST_CAST (obj));
+    else
+      res = gst_pad_push (payload->srcpad, GST_BUFFER_CAST (obj));
+  } else {
+    gst_mini_object_unref (GST_MINI_OBJECT_CAST (obj));
+  }
+
+  return res;
+}
+
+static GstFlowReturn
+gst_rtp_base_payload_push_queued (GstRTPBasePayload * payload)
+{
+  GstBufferList *list = payload->priv->queued;
+
+  if (list == NULL)
+    return GST_FLOW_OK;
+
+  payload->priv->queued = NULL;
+
+  GST_LOG_OBJECT (payload, "pushing %u queued packets",
+      gst_buffer_list_length (list));
+
+  return gst_rtp_base_payload_push_internal (payload, list, TRUE);
+}
+
 /**
  * gst_rtp_base_payload_push_list:
  * @payload: a #GstRTPBasePayload
  * @list: (transfer full): a #GstBufferList
  *
  * Push @list to the peer element of the payloader. The SSRC, payload type,
- * seqnum and timestamp of the RTP buffer will be updated first.
+ * seqnum and timestamp of the RTP buffer will be updated first. Packets
+ * queued with gst_rtp_base_payload_queue() are pushed before @list.
  *
  * This function takes ownership of @list.
  *
@@ -1984,20 +2174,13 @@ gst_rtp_base_payload_push_list (GstRTPBasePayload * payload,
 {
   GstFlowReturn res;
 
-  res = gst_rtp_base_payload_prepare_push (payload, list, TRUE);
-
-  if (G_LIKELY (res == GST_FLOW_OK)) {
-    if (G_UNLIKELY (payload->priv->pending_segment)) {
-      gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
-      payload->priv->pending_segment = FALSE;
-      payload->priv->delay_segment = FALSE;
-    }
-    res = gst_pad_push_list (payload->srcpad, list);
-  } else {
+  res = gst_rtp_base_payload_push_queued (payload);
+  if (G_UNLIKELY (res != GST_FLOW_OK)) {
     gst_buffer_list_unref (list);
+    return res;
   }
 
-  return res;
+  return gst_rtp_base_payload_push_internal (payload, list, TRUE);
 }
 
 /**
@@ -2006,7 +2189,8 @@ gst_rtp_base_payload_push_list (GstRTPBasePayload * payload,
  * @buffer: (transfer full): a #GstBuffer
  *
  * Push @buffer to the peer element of the payloader. The SSRC, payload type,
- * seqnum and timestamp of the RTP buffer will be updated first.
+ * seqnum and timestamp of the RTP buffer will be updated first. Packets
+ * queued with gst_rtp_base_payload_queue() are pushed before @buffer.
  *
  * This function takes ownership of @buffer.
  *
@@ -2017,22 +2201,95 @@ gst_rtp_base_payload_push (GstRTPBasePayload * payload, GstBuffer * buffer)
 {
   GstFlowReturn res;
 
-  res = gst_rtp_base_payload_prepare_push (payload, buffer, FALSE);
+  res = gst_rtp_base_payload_push_queued (payload);
+  if (G_UNLIKELY (res != GST_FLOW_OK)) {
+    gst_buffer_unref (buffer);
+    return res;
+  }
 
-  if (G_LIKELY (res == GST_FLOW_OK)) {
-    if (G_UNLIKELY (payload->priv->pending_segment)) {
-      gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
-      payload->priv->pending_segment = FALSE;
-      payload->priv->delay_segment = FALSE;
+  return gst_rtp_base_payload_push_internal (payload, buffer, FALSE);
+}
+
+/**
+ * gst_rtp_base_payload_queue:
+ * @payload: a #GstRTPBasePayload
+ * @buffer: (transfer full): a #GstBuffer
+ *
+ * Queue @buffer to be pushed together with the other packets of the same
+ * access unit as one #GstBufferList, which saves a push and the header
+ * processing downstream for every packet.
+ *
+ * All packets of a list get the RTP timestamp of the first one, so queueing
+ * a packet with a different PTS or offset first pushes the packets that are
+ * already queued. The queue is also pushed when the
+ * #GstRTPBasePayloadClass.handle_buffer() function returns, before serialized
+ * events are forwarded and before gst_rtp_base_payload_push() and
+ * gst_rtp_base_payload_push_list() push their packets.
+ *
+ * This function takes ownership of @buffer.
+ *
+ * Returns: a #GstFlowReturn from pushing previously queued packets.
+ *
+ * Since: 1.24
+ */
+GstFlowReturn
+gst_rtp_base_payload_queue (GstRTPBasePayload * payload, GstBuffer * buffer)
+{
+  GstRTPBasePayloadPrivate *priv;
+  GstFlowReturn res = GST_FLOW_OK;
+
+  g_return_val_if_fail (GST_IS_RTP_BASE_PAYLOAD (payload), GST_FLOW_ERROR);
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_FLOW_ERROR);
+
+  priv = payload->priv;
+
+  if (priv->queued && (GST_BUFFER_PTS (buffer) != priv->queued_pts
+          || GST_BUFFER_OFFSET (buffer) != priv->queued_offset)) {
+    res = gst_rtp_base_payload_push_queued (payload);
+    if (G_UNLIKELY (res != GST_FLOW_OK)) {
+      gst_buffer_unref (buffer);
+      return res;
     }
-    res = gst_pad_push (payload->srcpad, buffer);
-  } else {
-    gst_buffer_unref (buffer);
   }
 
+  if (priv->queued == NULL) {
+    priv->queued = gst_buffer_list_new ();
+    priv->queued_pts = GST_BUFFER_PTS (buffer);
+    priv->queued_offset = GST_BUFFER_OFFSET (buffer);
+  }
+  gst_buffer_list_add (priv->queued, buffer);
+
   return res;
 }
 
+/* Collects the CSRCs to add from the #GstRTPSourceMeta of the input buffer
+ * after the first @csrc_count entries of @csrcs. Returns the total number of
+ * CSRCs. */
+static guint
+get_source_info_csrcs (GstRTPBasePayload * payload, guint8 csrc_count,
+    guint32 csrcs[15])
+{
+  GstRTPSourceMeta *meta;
+  guint idx, i;
+
+  if (payload->priv->input_meta_buffer == NULL)
+    return csrc_count;
+
+  meta = gst_buffer_get_rtp_source_meta (payload->priv->input_meta_buffer);
+  if (meta == NULL)
+    return csrc_count;
+
+  /* Skip CSRC fields requested by derived class and fill CSRCs from meta.
+   * Finally append the SSRC as a new CSRC. */
+  idx = csrc_count;
+  for (i = 0; i < meta->csrc_count && idx < 15; i++, idx++)
+    csrcs[idx] = meta->csrc[i];
+  if (meta->ssrc_valid && idx < 15)
+    csrcs[idx++] = meta->ssrc;
+
+  return MAX (idx, csrc_count);
+}
+
 /**
  * gst_rtp_base_payload_allocate_output_buffer:
  * @payload: a #GstRTPBasePayload
@@ -2054,41 +2311,141 @@ GstBuffer *
 gst_rtp_base_payload_allocate_output_buffer (GstRTPBasePayload * payload,
     guint payload_len, guint8 pad_len, guint8 csrc_count)
 {
-  GstBuffer *buffer = NULL;
-
-  if (payload->priv->input_meta_buffer != NULL) {
-    GstRTPSourceMeta *meta =
-        gst_buffer_get_rtp_source_meta (payload->priv->input_meta_buffer);
-    if (meta != NULL) {
-      guint total_csrc_count, idx, i;
-      GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
-
-      total_csrc_count = csrc_count + meta->csrc_count +
-          (meta->ssrc_valid ? 1 : 0);
-      total_csrc_count = MIN (total_csrc_count, 15);
-      buffer = gst_rtp_buffer_new_allocate (payload_len, pad_len,
-          total_csrc_count);
-
-      gst_rtp_buffer_map (buffer, GST_MAP_READWRITE, &rtp);
-
-      /* Skip CSRC fields requested by derived class and fill CSRCs from meta.
-       * Finally append the SSRC as a new CSRC. */
-      idx = csrc_count;
-      for (i = 0; i < meta->csrc_count && idx < 15; i++, idx++)
-        gst_rtp_buffer_set_csrc (&rtp, idx, meta->csrc[i]);
-      if (meta->ssrc_valid && idx < 15)
-        gst_rtp_buffer_set_csrc (&rtp, idx, meta->ssrc);
-
-      gst_rtp_buffer_unmap (&rtp);
-    }
-  }
+  GstBuffer *buffer;
+  guint32 csrcs[15];
+  guint total_csrc_count, i;
 
-  if (buffer == NULL)
-    buffer = gst_rtp_buffer_new_allocate (payload_len, pad_len, csrc_count);
+  total_csrc_count = get_source_info_csrcs (payload, csrc_count, csrcs);
+  buffer = gst_rtp_buffer_new_allocate (payload_len, pad_len,
+      total_csrc_count);
+
+  if (total_csrc_count > csrc_count) {
+    GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+
+    gst_rtp_buffer_map (buffer, GST_MAP_READWRITE, &rtp);
+    for (i = csrc_count; i < total_csrc_count; i++)
+      gst_rtp_buffer_set_csrc (&rtp, i, csrcs[i]);
+    gst_rtp_buffer_unmap (&rtp);
+  }
 
   return buffer;
 }
 
+/* Allocates a zeroed header extension that is large enough for all
+ * configured header extensions, so that set_headers() does not have to
+ * reallocate. */
+static GstMemory *
+reserve_header_extensions (GstRTPBasePayload * payload, GstBuffer * outbuf)
+{
+  HeaderExt hdrext = { NULL, };
+  GstMemory *mem;
+  GstMapInfo map;
+  guint16 bit_pattern;
+  guint wordlen;
+  gboolean res = FALSE;
+
+  GST_OBJECT_LOCK (payload);
+  if (payload->priv->header_exts->len > 0
+      && payload->priv->input_meta_buffer) {
+    hdrext.payload = payload;
+    hdrext.output = outbuf;
+    res = get_header_extension_layout (payload, &hdrext, &bit_pattern,
+        &wordlen);
+  }
+  GST_OBJECT_UNLOCK (payload);
+
+  if (!res)
+    return NULL;
+
+  mem = gst_allocator_alloc (NULL, 4 + wordlen * 4, NULL);
+  gst_memory_map (mem, &map, GST_MAP_WRITE);
+  GST_WRITE_UINT16_BE (map.data, bit_pattern);
+  GST_WRITE_UINT16_BE (map.data + 2, wordlen);
+  memset (map.data + 4, 0, wordlen * 4);
+  gst_memory_unmap (mem, &map);
+
+  return mem;
+}
+
+/**
+ * gst_rtp_base_payload_allocate_output_buffer_for_region:
+ * @payload: a #GstRTPBasePayload
+ * @buffer: (nullable): a #GstBuffer with the payload, or %NULL
+ * @offset: the offset of the payload in @buffer
+ * @size: the size of the payload in @buffer, or -1 for the rest of @buffer
+ * @csrc_count: the minimum number of CSRC entries
+ *
+ * Allocate a new RTP packet that references @size bytes of @buffer starting
+ * at @offset as its payload instead of copying them. The RTP header is
+ * placed in a memory of its own that is reused for a new packet once the
+ * packet is freed. If @buffer is %NULL the packet only contains the header
+ * and the payload can be appended with gst_buffer_append_memory() or
+ * gst_buffer_copy_into().
+ *
+ * Like with gst_rtp_base_payload_allocate_output_buffer(), additional CSRCs
+ * may be filled with RTP source information. When header extensions are
+ * configured, the space for them is reserved between the header and the
+ * payload so that they can be written without touching the payload.
+ *
+ * Returns: (transfer full): A new RTP packet with the header and payload in
+ * separate memories.
+ *
+ * Since: 1.24
+ */
+GstBuffer *
+gst_rtp_base_payload_allocate_output_buffer_for_region (GstRTPBasePayload *
+    payload, GstBuffer * buffer, gsize offset, gssize size, guint8 csrc_count)
+{
+  GstRTPBasePayloadPrivate *priv;
+  GstBuffer *outbuf = NULL;
+  GstMemory *extmem;
+  GstMapInfo map;
+  guint32 csrcs[15];
+  guint total_csrc_count, i;
+
+  g_return_val_if_fail (GST_IS_RTP_BASE_PAYLOAD (payload), NULL);
+  g_return_val_if_fail (buffer == NULL || GST_IS_BUFFER (buffer), NULL);
+  g_return_val_if_fail (csrc_count <= 15, NULL);
+
+  priv = payload->priv;
+
+  if (G_UNLIKELY (priv->header_pool == NULL)) {
+    GstStructure *config;
+
+    priv->header_pool = g_object_new (gst_rtp_header_pool_get_type (), NULL);
+    gst_object_ref_sink (priv->header_pool);
+    config = gst_buffer_pool_get_config (priv->header_pool);
+    gst_buffer_pool_config_set_params (config, NULL, RTP_HEADER_MAX_LEN, 0, 0);
+    gst_buffer_pool_set_config (priv->header_pool, config);
+    gst_buffer_pool_set_active (priv->header_pool, TRUE);
+  }
+
+  if (gst_buffer_pool_acquire_buffer (priv->header_pool, &outbuf,
+          NULL) != GST_FLOW_OK)
+    outbuf = gst_buffer_new_allocate (NULL, RTP_HEADER_MAX_LEN, NULL);
+
+  total_csrc_count = get_source_info_csrcs (payload, csrc_count, csrcs);
+  gst_buffer_resize (outbuf, 0, RTP_HEADER_LEN + total_csrc_count * 4);
+  extmem = reserve_header_extensions (payload, outbuf);
+
+  gst_buffer_map (outbuf, &map, GST_MAP_WRITE);
+  memset (map.data, 0, map.size);
+  map.data[0] = (GST_RTP_VERSION << 6) | total_csrc_count;
+  if (extmem)
+    map.data[0] |= 0x10;
+  for (i = csrc_count; i < total_csrc_count; i++)
+    GST_WRITE_UINT32_BE (map.data + RTP_HEADER_LEN + i * 4, csrcs[i]);
+  gst_buffer_unmap (outbuf, &map);
+
+  if (extmem)
+    gst_buffer_append_memory (outbuf, extmem);
+
+  if (buffer)
+    gst_buffer_copy_into (outbuf, buffer, GST_BUFFER_COPY_MEMORY, offset, size);
+
+  return outbuf;
+}
+
 static GstStructure *
 gst_rtp_base_payload_create_stats (GstRTPBasePayload * rtpbasepayload)
 {
@@ -2310,6 +2667,7 @@ gst_rtp_base_payload_change_state (GstElement * element,
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_event_replace (&rtpbasepayload->priv->pending_segment, NULL);
+      gst_rtp_base_payload_clear_queued (rtpbasepayload);
       break;
     default:
       break;
@@ -176,11 +176,21 @@ GST_RTP_API
 GstFlowReturn   gst_rtp_base_payload_push_list          (GstRTPBasePayload *payload,
                                                          GstBufferList *list);
 
+GST_RTP_API
+GstFlowReturn   gst_rtp_base_payload_queue              (GstRTPBasePayload *payload,
+                                                         GstBuffer *buffer);
+
 GST_RTP_API
 GstBuffer *     gst_rtp_base_payload_allocate_output_buffer (GstRTPBasePayload * payload,
                                                              guint payload_len, guint8 pad_len,
                                                              guint8 csrc_count);
 
+GST_RTP_API
+GstBuffer *     gst_rtp_base_payload_allocate_output_buffer_for_region (GstRTPBasePayload * payload,
+                                                                        GstBuffer * buffer,
+                                                                        gsize offset, gssize size,
+                                                                        guint8 csrc_count);
+
 GST_RTP_API
 void            gst_rtp_base_payload_set_source_info_enabled (GstRTPBasePayload * payload,
                                                               gboolean enable);
@@ -303,66 +303,26 @@ gst_rtp_buffer_calc_payload_len (guint packet_len, guint8 pad_len,
       - pad_len;
 }
 
-/**
- * gst_rtp_buffer_map:
- * @buffer: a #GstBuffer
- * @flags: #GstMapFlags
- * @rtp: (out): a #GstRTPBuffer
- *
- * Map the contents of @buffer into @rtp.
- *
- * Returns: %TRUE if @buffer could be mapped.
- */
-gboolean
-gst_rtp_buffer_map (GstBuffer * buffer, GstMapFlags flags, GstRTPBuffer * rtp)
+/* With GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY only the fixed header and the
+ * CSRCs are mapped, the header extension and the padding are mapped and
+ * validated the first time they are needed. */
+#define RTP_STATE_HEADER_ONLY (1 << 0)
+#define RTP_STATE_INVALID     (1 << 1)
+
+#define ENSURE_COMPLETE(rtp) \
+    (G_LIKELY ((rtp)->state == 0) || gst_rtp_buffer_complete_map (rtp))
+
+/* maps and validates the header extension and the padding that follow the
+ * CSRCs. The fixed header must have been mapped into map[0] already. */
+static gboolean
+gst_rtp_buffer_map_extension_and_padding (GstRTPBuffer * rtp,
+    GstBuffer * buffer, GstMapFlags flags)
 {
+  guint8 *data = rtp->data[0];
+  guint header_len = rtp->size[0];
   guint8 padding;
-  guint8 csrc_count;
-  guint header_len;
-  guint8 version, pt;
-  guint8 *data;
-  guint size;
   gsize bufsize, skip;
   guint idx, length;
-  guint n_mem;
-
-  g_return_val_if_fail (GST_IS_BUFFER (buffer), FALSE);
-  g_return_val_if_fail (rtp != NULL, FALSE);
-  g_return_val_if_fail (rtp->buffer == NULL, FALSE);
-
-  n_mem = gst_buffer_n_memory (buffer);
-  if (n_mem < 1)
-    goto no_memory;
-
-  /* map first memory, this should be the header */
-  if (!gst_buffer_map_range (buffer, 0, 1, &rtp->map[0], flags))
-    goto map_failed;
-
-  data = rtp->data[0] = rtp->map[0].data;
-  size = rtp->map[0].size;
-
-  /* the header must be completely in the first buffer */
-  header_len = GST_RTP_HEADER_LEN;
-  if (G_UNLIKELY (size < header_len))
-    goto wrong_length;
-
-  /* check version */
-  version = (data[0] & 0xc0);
-  if (G_UNLIKELY (version != (GST_RTP_VERSION << 6)))
-    goto wrong_version;
-
-  /* check reserved PT and marker bit, this is to check for RTCP
-   * packets. We do a relaxed check, you can still use 72-76 as long
-   * as the marker bit is cleared. */
-  pt = data[1];
-  if (G_UNLIKELY (pt >= 200 && pt <= 204))
-    goto reserved_pt;
-
-  /* calc header length with csrc */
-  csrc_count = (data[0] & 0x0f);
-  header_len += csrc_count * sizeof (guint32);
-
-  rtp->size[0] = header_len;
 
   bufsize = gst_buffer_get_size (buffer);
 
@@ -426,9 +386,7 @@ gst_rtp_buffer_map (GstBuffer * buffer, GstMapFlags flags, GstRTPBuffer * rtp)
   if (G_UNLIKELY (bufsize < padding + header_len))
     goto wrong_padding;
 
-  rtp->buffer = buffer;
-
-  if (n_mem == 1) {
+  if (gst_buffer_n_memory (buffer) == 1) {
     /* we have mapped the buffer already, so might just as well fill in the
      * payload pointer and size and avoid another buffer map/unmap later */
     rtp->data[2] = rtp->map[0].data + header_len;
@@ -439,7 +397,128 @@ gst_rtp_buffer_map (GstBuffer * buffer, GstMapFlags flags, GstRTPBuffer * rtp)
     rtp->size[2] = 0;
   }
 
-  /* rtp->state = 0; *//* unused */
+  return TRUE;
+
+  /* ERRORS */
+map_failed:
+  {
+    GST_ERROR ("failed to map memory");
+    return FALSE;
+  }
+wrong_length:
+  {
+    GST_DEBUG ("length check failed");
+    return FALSE;
+  }
+wrong_padding:
+  {
+    GST_DEBUG ("padding check failed (%" G_GSIZE_FORMAT " - %d < %d)", bufsize,
+        header_len, padding);
+    return FALSE;
+  }
+}
+
+/* finishes a header-only map, any error is remembered so that the extension,
+ * payload and padding of an invalid packet read as empty */
+static gboolean
+gst_rtp_buffer_complete_map (GstRTPBuffer * rtp)
+{
+  if (rtp->state & RTP_STATE_INVALID)
+    return FALSE;
+
+  if (!gst_rtp_buffer_map_extension_and_padding (rtp, rtp->buffer,
+          rtp->map[0].flags)) {
+    GST_MEMDUMP ("invalid packet", rtp->map[0].data, rtp->map[0].size);
+    rtp->data[1] = rtp->data[2] = rtp->data[3] = NULL;
+    rtp->size[1] = rtp->size[2] = rtp->size[3] = 0;
+    rtp->state = RTP_STATE_INVALID;
+    return FALSE;
+  }
+
+  rtp->state = 0;
+
+  return TRUE;
+}
+
+/**
+ * gst_rtp_buffer_map:
+ * @buffer: a #GstBuffer
+ * @flags: #GstMapFlags
+ * @rtp: (out): a #GstRTPBuffer
+ *
+ * Map the contents of @buffer into @rtp.
+ *
+ * With %GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY and without %GST_MAP_WRITE only
+ * the first memory of @buffer is mapped and only the fixed header and the
+ * CSRCs are validated, which is all that elements that look at the SSRC,
+ * sequence number, timestamp or payload type need. The header extension and
+ * padding are mapped and validated when they, or the payload, are first
+ * accessed. If they turn out to be invalid, @rtp behaves as if there were no
+ * header extension and an empty payload.
+ *
+ * Returns: %TRUE if @buffer could be mapped.
+ */
+gboolean
+gst_rtp_buffer_map (GstBuffer * buffer, GstMapFlags flags, GstRTPBuffer * rtp)
+{
+  guint8 csrc_count;
+  guint header_len;
+  guint8 version, pt;
+  guint8 *data;
+  guint size;
+
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), FALSE);
+  g_return_val_if_fail (rtp != NULL, FALSE);
+  g_return_val_if_fail (rtp->buffer == NULL, FALSE);
+
+  if (G_UNLIKELY (gst_buffer_n_memory (buffer) < 1))
+    goto no_memory;
+
+  /* map first memory, this should be the header */
+  if (!gst_buffer_map_range (buffer, 0, 1, &rtp->map[0], flags))
+    goto map_failed;
+
+  data = rtp->data[0] = rtp->map[0].data;
+  size = rtp->map[0].size;
+
+  /* the header must be completely in the first buffer */
+  header_len = GST_RTP_HEADER_LEN;
+  if (G_UNLIKELY (size < header_len))
+    goto wrong_length;
+
+  /* check version */
+  version = (data[0] & 0xc0);
+  if (G_UNLIKELY (version != (GST_RTP_VERSION << 6)))
+    goto wrong_version;
+
+  /* check reserved PT and marker bit, this is to check for RTCP
+   * packets. We do a relaxed check, you can still use 72-76 as long
+   * as the marker bit is cleared. */
+  pt = data[1];
+  if (G_UNLIKELY (pt >= 200 && pt <= 204))
+    goto reserved_pt;
+
+  /* calc header length with csrc */
+  csrc_count = (data[0] & 0x0f);
+  header_len += csrc_count * sizeof (guint32);
+
+  rtp->size[0] = header_len;
+
+  if ((flags & GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY) != 0 &&
+      (flags & GST_MAP_WRITE) == 0) {
+    if (G_UNLIKELY (gst_buffer_get_size (buffer) < header_len))
+      goto wrong_length;
+
+    rtp->data[1] = rtp->data[2] = rtp->data[3] = NULL;
+    rtp->size[1] = rtp->size[2] = rtp->size[3] = 0;
+    rtp->state = RTP_STATE_HEADER_ONLY;
+  } else {
+    if (!gst_rtp_buffer_map_extension_and_padding (rtp, buffer, flags))
+      goto dump_packet;
+    rtp->state = 0;
+  }
+
+  rtp->buffer = buffer;
 
   return TRUE;
 
@@ -469,17 +548,11 @@ reserved_pt:
     GST_DEBUG ("reserved PT %d found", pt);
     goto dump_packet;
   }
-wrong_padding:
-  {
-    GST_DEBUG ("padding check failed (%" G_GSIZE_FORMAT " - %d < %d)", bufsize,
-        header_len, padding);
-    goto dump_packet;
-  }
 dump_packet:
   {
     gint i;
 
-    GST_MEMDUMP ("buffer", data, size);
+    GST_MEMDUMP ("buffer", rtp->map[0].data, rtp->map[0].size);
 
     for (i = 0; i < G_N_ELEMENTS (rtp->map); ++i) {
       if (rtp->map[i].memory != NULL)
@@ -512,6 +585,7 @@ gst_rtp_buffer_unmap (GstRTPBuffer * rtp)
     rtp->size[i] = 0;
   }
   rtp->buffer = NULL;
+  rtp->state = 0;
 }
 
 
@@ -570,6 +644,9 @@ gst_rtp_buffer_get_packet_len (GstRTPBuffer * rtp)
 guint
 gst_rtp_buffer_get_header_len (GstRTPBuffer * rtp)
 {
+  if (G_UNLIKELY (rtp->state != 0))
+    gst_rtp_buffer_complete_map (rtp);
+
   return rtp->size[0] + rtp->size[1];
 }
 
@@ -703,6 +780,9 @@ gst_rtp_buffer_get_extension_data (GstRTPBuffer * rtp, guint16 * bits,
 {
   guint8 *pdata;
 
+  if (!ENSURE_COMPLETE (rtp))
+    return FALSE;
+
   /* move to the extension */
   pdata = rtp->data[1];
   if (!pdata)
@@ -768,6 +848,13 @@ gst_rtp_buffer_map_payload (GstRTPBuffer * rtp)
   if (rtp->map[2].memory != NULL)
     return TRUE;
 
+  if (!ENSURE_COMPLETE (rtp))
+    return FALSE;
+
+  /* completing a header-only map fills in single memory payloads */
+  if (rtp->data[2] != NULL)
+    return TRUE;
+
   hlen = gst_rtp_buffer_get_header_len (rtp);
   plen = gst_buffer_get_size (rtp->buffer) - hlen - rtp->size[3];
 
@@ -1148,6 +1235,9 @@ gst_rtp_buffer_get_payload_subbuffer (GstRTPBuffer * rtp, guint offset,
 {
   guint poffset, plen;
 
+  if (G_UNLIKELY (!ENSURE_COMPLETE (rtp)))
+    return NULL;
+
   plen = gst_rtp_buffer_get_payload_len (rtp);
   /* we can't go past the length */
   if (G_UNLIKELY (offset > plen))
@@ -1199,6 +1289,9 @@ gst_rtp_buffer_get_payload_buffer (GstRTPBuffer * rtp)
 guint
 gst_rtp_buffer_get_payload_len (GstRTPBuffer * rtp)
 {
+  if (G_UNLIKELY (!ENSURE_COMPLETE (rtp)))
+    return 0;
+
   return gst_buffer_get_size (rtp->buffer) - gst_rtp_buffer_get_header_len (rtp)
       - rtp->size[3];
 }
@@ -268,6 +268,12 @@ typedef enum {
  * @GST_RTP_BUFFER_MAP_FLAG_SKIP_PADDING: Skip mapping and validation of RTP
  *           padding and RTP pad count when present. Useful for buffers where
  *           the padding may be encrypted.
+ * @GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY: Only map and validate the fixed
+ *           header and the CSRCs, the header extension and padding are
+ *           mapped when first needed. A packet with an invalid header
+ *           extension or padding length still maps, so elements that drop
+ *           invalid packets should not use this. Ignored for writable maps.
+ *           (Since: 1.24)
  * @GST_RTP_BUFFER_MAP_FLAG_LAST: Offset to define more flags
  *
  * Additional mapping flags for gst_rtp_buffer_map().
@@ -276,6 +282,7 @@ typedef enum {
  */
 typedef enum {
   GST_RTP_BUFFER_MAP_FLAG_SKIP_PADDING = (GST_MAP_FLAG_LAST << 0),
+  GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY  = (GST_MAP_FLAG_LAST << 1),
   GST_RTP_BUFFER_MAP_FLAG_LAST         = (GST_MAP_FLAG_LAST << 8)
   /* 8 more flags possible afterwards */
 } GstRTPBufferMapFlags;
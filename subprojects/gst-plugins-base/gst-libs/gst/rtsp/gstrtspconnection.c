@@ -3779,6 +3779,12 @@ struct _GstRTSPWatch
   gsize messages_bytes;
   guint messages_count;
 
+  /* scratch space for writing the queued messages, allocated on the first
+   * write with room for MAX_WRITE_VECTORS */
+  GOutputVector *write_vectors;
+  GstMapInfo *write_map_infos;
+  guint *write_ids;
+
   gsize max_bytes;
   guint max_messages;
   GCond queue_not_full;
@@ -3790,6 +3796,13 @@ struct _GstRTSPWatch
   GDestroyNotify notify;
 };
 
+/* Maximum number of vectors that are written from the backlog with one
+ * writev. This is about IOV_MAX, which is all the kernel takes at once anyway,
+ * and keeps us from mapping the complete backlog every time the socket
+ * becomes writable again. A message with more memories than this is written
+ * in several rounds. */
+#define MAX_WRITE_VECTORS 1024
+
 #define IS_BACKLOG_FULL(w) (((w)->max_bytes != 0 && (w)->messages_bytes >= (w)->max_bytes) || \
       ((w)->max_messages != 0 && (w)->messages_count >= (w)->max_messages))
 
@@ -4042,13 +4055,19 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
     goto eof;
 
   g_mutex_lock (&watch->mutex);
+  if (watch->write_vectors == NULL) {
+    watch->write_vectors = g_new (GOutputVector, MAX_WRITE_VECTORS);
+    watch->write_map_infos = g_new (GstMapInfo, MAX_WRITE_VECTORS);
+    watch->write_ids = g_new (guint, MAX_WRITE_VECTORS + 1);
+  }
   do {
     guint n_messages = gst_queue_array_get_length (watch->messages);
-    GOutputVector *vectors;
-    GstMapInfo *map_infos;
+    GOutputVector *vectors = watch->write_vectors;
+    GstMapInfo *map_infos = watch->write_map_infos;
     guint *ids;
     gsize bytes_to_write, bytes_written;
-    guint n_vectors, n_memories, n_ids, drop_messages;
+    guint n_vectors, n_ids, drop_messages;
+    gboolean truncated;
     gint i, j, l, n_mmap;
     GstRTSPSerializedMessage *msg;
     GCancellable *cancellable;
@@ -4087,16 +4106,16 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
       break;
     }
 
-    for (i = 0, n_vectors = 0, n_memories = 0, n_ids = 0; i < n_messages; i++) {
+    for (i = 0, n_vectors = 0, n_ids = 0; i < n_messages; i++) {
+      guint msg_vectors = 0;
+
       msg = gst_queue_array_peek_nth_struct (watch->messages, i);
-      if (msg->id != 0)
-        n_ids++;
 
       if (msg->data_offset < msg->data_size)
-        n_vectors++;
+        msg_vectors++;
 
       if (msg->body_data && msg->body_offset < msg->body_data_size) {
-        n_vectors++;
+        msg_vectors++;
       } else if (msg->body_buffer) {
         guint m, n;
         guint offset = 0;
@@ -4112,15 +4131,26 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
           }
           offset += mem->size;
 
-          n_memories++;
-          n_vectors++;
+          msg_vectors++;
         }
       }
+
+      /* leave the remaining messages for the next round */
+      if (i > 0 && n_vectors + msg_vectors > MAX_WRITE_VECTORS)
+        break;
+
+      if (msg->id != 0)
+        n_ids++;
+      n_vectors += msg_vectors;
     }
+    n_messages = i;
 
-    vectors = g_newa (GOutputVector, n_vectors);
-    map_infos = n_memories ? g_newa (GstMapInfo, n_memories) : NULL;
-    ids = n_ids ? g_newa (guint, n_ids + 1) : NULL;
+    /* only possible with a single message, write its first vectors now */
+    truncated = n_vectors > MAX_WRITE_VECTORS;
+    if (truncated)
+      n_vectors = MAX_WRITE_VECTORS;
+
+    ids = n_ids ? watch->write_ids : NULL;
     if (ids)
       memset (ids, 0, sizeof (guint) * (n_ids + 1));
 
@@ -4147,7 +4177,7 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
         guint m, n;
         guint offset = 0;
         n = gst_buffer_n_memory (msg->body_buffer);
-        for (m = 0; m < n; m++) {
+        for (m = 0; m < n && j < n_vectors; m++) {
           GstMemory *mem = gst_buffer_peek_memory (msg->body_buffer, m);
           guint off;
 
@@ -4193,10 +4223,11 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
       gst_memory_unmap (map_infos[i].memory, &map_infos[i]);
     }
 
-    if (bytes_written == bytes_to_write) {
+    if (bytes_written == bytes_to_write && !truncated) {
       /* fast path, just unmap all memories, free memory, drop all messages and notify them */
       l = 0;
-      while ((msg = gst_queue_array_pop_head_struct (watch->messages))) {
+      for (i = 0; i < n_messages; i++) {
+        msg = gst_queue_array_pop_head_struct (watch->messages);
         if (msg->id) {
           ids[l] = msg->id;
           l++;
@@ -4341,6 +4372,10 @@ gst_rtsp_source_finalize (GSource * source)
 
   g_cond_clear (&watch->queue_not_full);
 
+  g_free (watch->write_vectors);
+  g_free (watch->write_map_infos);
+  g_free (watch->write_ids);
+
   if (watch->readsrc)
     g_source_unref (watch->readsrc);
   if (watch->writesrc)
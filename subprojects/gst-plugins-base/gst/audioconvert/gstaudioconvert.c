@@ -157,7 +157,8 @@ enum
   PROP_DITHERING,
   PROP_NOISE_SHAPING,
   PROP_MIX_MATRIX,
-  PROP_DITHERING_THRESHOLD
+  PROP_DITHERING_THRESHOLD,
+  PROP_N_THREADS
 };
 
 #define DEBUG_INIT \
@@ -237,6 +238,19 @@ gst_audio_convert_class_init (GstAudioConvertClass * klass)
           "Threshold for the output bit depth at/below which to apply dithering.",
           0, 32, 20, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioConvert:n-threads:
+   *
+   * Maximum number of threads to use for the conversion. The output does not
+   * depend on the number of threads.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = number of cores)", 0,
+          G_MAXUINT, 1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_static_pad_template (element_class,
       &gst_audio_convert_src_template);
   gst_element_class_add_static_pad_template (element_class,
@@ -275,6 +289,7 @@ gst_audio_convert_init (GstAudioConvert * this)
   this->dither = GST_AUDIO_DITHER_TPDF;
   this->dither_threshold = 20;
   this->ns = GST_AUDIO_NOISE_SHAPING_NONE;
+  this->n_threads = 1;
   g_value_init (&this->mix_matrix, GST_TYPE_ARRAY);
 
   gst_base_transform_set_gap_aware (GST_BASE_TRANSFORM (this), TRUE);
@@ -784,7 +799,8 @@ gst_audio_convert_set_caps (GstBaseTransform * base, GstCaps * incaps,
       GST_AUDIO_CONVERTER_OPT_DITHER_THRESHOLD, G_TYPE_UINT,
       this->dither_threshold,
       GST_AUDIO_CONVERTER_OPT_NOISE_SHAPING_METHOD,
-      GST_TYPE_AUDIO_NOISE_SHAPING_METHOD, this->ns, NULL);
+      GST_TYPE_AUDIO_NOISE_SHAPING_METHOD, this->ns,
+      GST_AUDIO_CONVERTER_OPT_THREADS, G_TYPE_UINT, this->n_threads, NULL);
 
   if (this->mix_matrix_is_set)
     gst_structure_set_value (config, GST_AUDIO_CONVERTER_OPT_MIX_MATRIX,
@@ -1004,6 +1020,9 @@ gst_audio_convert_set_property (GObject * object, guint prop_id,
     case PROP_DITHERING_THRESHOLD:
       this->dither_threshold = g_value_get_uint (value);
       break;
+    case PROP_N_THREADS:
+      this->n_threads = g_value_get_uint (value);
+      break;
     case PROP_MIX_MATRIX:
       if (!gst_value_array_get_size (value)) {
         this->mix_matrix_is_set = FALSE;
@@ -1043,6 +1062,9 @@ gst_audio_convert_get_property (GObject * object, guint prop_id,
     case PROP_DITHERING_THRESHOLD:
       g_value_set_uint (value, this->dither_threshold);
       break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, this->n_threads);
+      break;
     case PROP_MIX_MATRIX:
       if (this->mix_matrix_is_set)
         g_value_copy (&this->mix_matrix, value);
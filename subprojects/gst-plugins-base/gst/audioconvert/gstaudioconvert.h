@@ -45,6 +45,7 @@ struct _GstAudioConvert
   GstAudioNoiseShapingMethod ns;
   GValue mix_matrix;
   gboolean mix_matrix_is_set;
+  guint n_threads;
 
   GstAudioInfo in_info;
   GstAudioInfo out_info;
@@ -45,6 +45,16 @@
 #define GST_CAT_DEFAULT gst_audio_interleave_debug
 GST_DEBUG_CATEGORY_STATIC (GST_CAT_DEFAULT);
 
+typedef struct
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+  guint in_offset;
+  guint out_offset;
+  guint num_frames;
+  gint channel;
+} GstAudioInterleaveInput;
+
 enum
 {
   PROP_PAD_0,
@@ -156,6 +166,11 @@ static void gst_audio_interleave_release_pad (GstElement * element,
     GstPad * pad);
 
 static gboolean gst_audio_interleave_stop (GstAggregator * agg);
+static GstFlowReturn gst_audio_interleave_flush (GstAggregator * agg);
+static GstFlowReturn gst_audio_interleave_finish_buffer (GstAggregator * agg,
+    GstBuffer * buffer);
+static void gst_audio_interleave_interleave_pending (GstAudioInterleave * self);
+static void gst_audio_interleave_clear_pending (GstAudioInterleave * self);
 
 static gboolean
 gst_audio_interleave_aggregate_one_buffer (GstAudioAggregator * aagg,
@@ -347,62 +362,6 @@ gst_audio_interleave_get_channel_mask (GstAudioInterleave * self)
 }
 
 
-#define MAKE_FUNC(type) \
-static void interleave_##type (guint##type *out, guint##type *in, \
-    guint stride, guint nframes) \
-{ \
-  gint i; \
-  \
-  for (i = 0; i < nframes; i++) { \
-    *out = in[i]; \
-    out += stride; \
-  } \
-}
-
-MAKE_FUNC (8);
-MAKE_FUNC (16);
-MAKE_FUNC (32);
-MAKE_FUNC (64);
-
-static void
-interleave_24 (guint8 * out, guint8 * in, guint stride, guint nframes)
-{
-  gint i;
-
-  for (i = 0; i < nframes; i++) {
-    memcpy (out, in, 3);
-    out += stride * 3;
-    in += 3;
-  }
-}
-
-static void
-gst_audio_interleave_set_process_function (GstAudioInterleave * self,
-    GstAudioInfo * info)
-{
-  switch (GST_AUDIO_INFO_WIDTH (info)) {
-    case 8:
-      self->func = (GstInterleaveFunc) interleave_8;
-      break;
-    case 16:
-      self->func = (GstInterleaveFunc) interleave_16;
-      break;
-    case 24:
-      self->func = (GstInterleaveFunc) interleave_24;
-      break;
-    case 32:
-      self->func = (GstInterleaveFunc) interleave_32;
-      break;
-    case 64:
-      self->func = (GstInterleaveFunc) interleave_64;
-      break;
-    default:
-      g_assert_not_reached ();
-      break;
-  }
-}
-
-
 /* the first caps we receive on any of the sinkpads will define the caps for all
  * the other sinkpads because we can only mix streams with the same caps.
  */
@@ -535,14 +494,11 @@ static gboolean
 gst_audio_interleave_negotiated_src_caps (GstAggregator * agg, GstCaps * caps)
 {
   GstAudioInterleave *self = GST_AUDIO_INTERLEAVE (agg);
-  GstAudioAggregatorPad *srcpad = GST_AUDIO_AGGREGATOR_PAD (agg->srcpad);
-
-  if (!GST_AGGREGATOR_CLASS (parent_class)->negotiated_src_caps (agg, caps))
-    return FALSE;
 
-  gst_audio_interleave_set_process_function (self, &srcpad->info);
+  /* a partially interleaved output buffer is converted to the new format */
+  gst_audio_interleave_interleave_pending (self);
 
-  return TRUE;
+  return GST_AGGREGATOR_CLASS (parent_class)->negotiated_src_caps (agg, caps);
 }
 
 static void
@@ -576,6 +532,9 @@ gst_audio_interleave_class_init (GstAudioInterleaveClass * klass)
   agg_class->sink_query = GST_DEBUG_FUNCPTR (gst_audio_interleave_sink_query);
   agg_class->sink_event = GST_DEBUG_FUNCPTR (gst_audio_interleave_sink_event);
   agg_class->stop = gst_audio_interleave_stop;
+  agg_class->flush = GST_DEBUG_FUNCPTR (gst_audio_interleave_flush);
+  agg_class->finish_buffer =
+      GST_DEBUG_FUNCPTR (gst_audio_interleave_finish_buffer);
   agg_class->update_src_caps = gst_audio_interleave_update_src_caps;
   agg_class->negotiated_src_caps = gst_audio_interleave_negotiated_src_caps;
 
@@ -624,12 +583,56 @@ gst_audio_interleave_class_init (GstAudioInterleaveClass * klass)
   gst_type_mark_as_plugin_api (GST_TYPE_AUDIO_INTERLEAVE_PAD, 0);
 }
 
+static void
+gst_audio_interleave_input_clear (GstAudioInterleaveInput * input)
+{
+  gst_buffer_unref (input->buffer);
+}
+
+/* called when the base class drops the output buffer without finishing it,
+ * the inputs queued for it must not end up in the next one */
+static void
+gst_audio_interleave_pending_outbuf_freed (GstAudioInterleave * self,
+    GstMiniObject * outbuf)
+{
+  GST_DEBUG_OBJECT (self, "output buffer %p freed, dropping %u pending "
+      "inputs", outbuf, self->pending->len);
+
+  self->pending_outbuf = NULL;
+  g_array_set_size (self->pending, 0);
+}
+
+/* Like in audiomixer, a strong reference would keep the base class from
+ * resizing and writing to the output buffer */
+static void
+gst_audio_interleave_set_pending_outbuf (GstAudioInterleave * self,
+    GstBuffer * outbuf)
+{
+  if (self->pending_outbuf == outbuf)
+    return;
+
+  if (self->pending_outbuf)
+    gst_mini_object_weak_unref (GST_MINI_OBJECT_CAST (self->pending_outbuf),
+        (GstMiniObjectNotify) gst_audio_interleave_pending_outbuf_freed, self);
+
+  self->pending_outbuf = outbuf;
+
+  if (outbuf)
+    gst_mini_object_weak_ref (GST_MINI_OBJECT_CAST (outbuf),
+        (GstMiniObjectNotify) gst_audio_interleave_pending_outbuf_freed, self);
+}
+
 static void
 gst_audio_interleave_init (GstAudioInterleave * self)
 {
   self->input_channel_positions = g_value_array_new (0);
   self->channel_positions_from_input = TRUE;
   self->channel_positions = self->input_channel_positions;
+
+  self->pending =
+      g_array_new (FALSE, FALSE, sizeof (GstAudioInterleaveInput));
+  g_array_set_clear_func (self->pending,
+      (GDestroyNotify) gst_audio_interleave_input_clear);
 }
 
 static void
@@ -648,6 +651,9 @@ gst_audio_interleave_finalize (GObject * object)
     self->input_channel_positions = NULL;
   }
 
+  gst_audio_interleave_set_pending_outbuf (self, NULL);
+  g_array_unref (self->pending);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -713,6 +719,7 @@ gst_audio_interleave_stop (GstAggregator * agg)
     return FALSE;
 
   gst_caps_replace (&self->sinkcaps, NULL);
+  gst_audio_interleave_clear_pending (self);
 
   return TRUE;
 }
@@ -808,7 +815,91 @@ gst_audio_interleave_release_pad (GstElement * element, GstPad * pad)
 }
 
 
-/* Called with object lock and pad object lock held */
+/* interleave all pending inputs into the output buffer, all channels at
+ * once where the inputs cover the same frames */
+static void
+gst_audio_interleave_interleave_pending (GstAudioInterleave * self)
+{
+  GstAggregator *agg = GST_AGGREGATOR (self);
+  GstAudioAggregatorPad *srcpad = GST_AUDIO_AGGREGATOR_PAD (agg->srcpad);
+  GstAudioInterleaveInput *first;
+  GstAudioFormat format;
+  GstMapInfo outmap;
+  gpointer *planes;
+  guint i, bps, bpf, channels, out_frames;
+  gboolean aligned = TRUE;
+
+  if (self->pending->len == 0)
+    return;
+
+  GST_OBJECT_LOCK (self);
+  format = GST_AUDIO_INFO_FORMAT (&srcpad->info);
+  bps = GST_AUDIO_INFO_WIDTH (&srcpad->info) / 8;
+  bpf = GST_AUDIO_INFO_BPF (&srcpad->info);
+  channels = GST_AUDIO_INFO_CHANNELS (&srcpad->info);
+  GST_OBJECT_UNLOCK (self);
+
+  GST_LOG_OBJECT (self, "interleaving %u inputs", self->pending->len);
+
+  gst_buffer_map (self->pending_outbuf, &outmap, GST_MAP_READWRITE);
+  /* the output buffer might have been shortened at EOS */
+  out_frames = outmap.size / bpf;
+
+  first = &g_array_index (self->pending, GstAudioInterleaveInput, 0);
+  for (i = 0; i < self->pending->len; i++) {
+    GstAudioInterleaveInput *input =
+        &g_array_index (self->pending, GstAudioInterleaveInput, i);
+
+    gst_buffer_map (input->buffer, &input->map, GST_MAP_READ);
+    input->num_frames = MIN (input->num_frames,
+        out_frames - MIN (input->out_offset, out_frames));
+    if (input->out_offset != first->out_offset
+        || input->num_frames != first->num_frames)
+      aligned = FALSE;
+  }
+
+  planes = g_new0 (gpointer, channels);
+  if (aligned) {
+    for (i = 0; i < self->pending->len; i++) {
+      GstAudioInterleaveInput *input =
+          &g_array_index (self->pending, GstAudioInterleaveInput, i);
+
+      planes[input->channel] = input->map.data + input->in_offset * bps;
+    }
+    gst_audio_interleave_samples (format, channels, planes,
+        outmap.data + first->out_offset * bpf, first->num_frames);
+  } else {
+    for (i = 0; i < self->pending->len; i++) {
+      GstAudioInterleaveInput *input =
+          &g_array_index (self->pending, GstAudioInterleaveInput, i);
+
+      planes[input->channel] = input->map.data + input->in_offset * bps;
+      gst_audio_interleave_samples (format, channels, planes,
+          outmap.data + input->out_offset * bpf, input->num_frames);
+      planes[input->channel] = NULL;
+    }
+  }
+  g_free (planes);
+
+  for (i = 0; i < self->pending->len; i++) {
+    GstAudioInterleaveInput *input =
+        &g_array_index (self->pending, GstAudioInterleaveInput, i);
+
+    gst_buffer_unmap (input->buffer, &input->map);
+  }
+  gst_buffer_unmap (self->pending_outbuf, &outmap);
+
+  g_array_set_size (self->pending, 0);
+  gst_audio_interleave_set_pending_outbuf (self, NULL);
+}
+
+static void
+gst_audio_interleave_clear_pending (GstAudioInterleave * self)
+{
+  g_array_set_size (self->pending, 0);
+  gst_audio_interleave_set_pending_outbuf (self, NULL);
+}
+
 static gboolean
 gst_audio_interleave_aggregate_one_buffer (GstAudioAggregator * aagg,
     GstAudioAggregatorPad * aaggpad, GstBuffer * inbuf, guint in_offset,
@@ -816,47 +907,57 @@ gst_audio_interleave_aggregate_one_buffer (GstAudioAggregator * aagg,
 {
   GstAudioInterleave *self = GST_AUDIO_INTERLEAVE (aagg);
   GstAudioInterleavePad *pad = GST_AUDIO_INTERLEAVE_PAD (aaggpad);
-  GstMapInfo inmap;
-  GstMapInfo outmap;
-  gint out_width, in_bpf, out_bpf, out_channels, channel;
-  guint8 *outdata;
-  GstAggregator *agg = GST_AGGREGATOR (aagg);
-  GstAudioAggregatorPad *srcpad = GST_AUDIO_AGGREGATOR_PAD (agg->srcpad);
+  GstAudioInterleaveInput input;
 
   GST_OBJECT_LOCK (aagg);
   GST_OBJECT_LOCK (aaggpad);
 
-  out_width = GST_AUDIO_INFO_WIDTH (&srcpad->info) / 8;
-  in_bpf = GST_AUDIO_INFO_BPF (&aaggpad->info);
-  out_bpf = GST_AUDIO_INFO_BPF (&srcpad->info);
-  out_channels = GST_AUDIO_INFO_CHANNELS (&srcpad->info);
-
-  gst_buffer_map (outbuf, &outmap, GST_MAP_READWRITE);
-  gst_buffer_map (inbuf, &inmap, GST_MAP_READ);
-  GST_LOG_OBJECT (pad, "interleaves %u frames on channel %d/%d at offset %u"
-      " from offset %u", num_frames, pad->channel, out_channels,
-      out_offset * out_bpf, in_offset * in_bpf);
+  GST_LOG_OBJECT (pad, "queueing %u frames for channel %d at offset %u from "
+      "offset %u", num_frames, pad->channel, out_offset, in_offset);
 
   if (self->channels > 64) {
-    channel = pad->channel;
+    input.channel = pad->channel;
   } else {
-    channel = self->default_channels_ordering_map[pad->channel];
+    input.channel = self->default_channels_ordering_map[pad->channel];
   }
 
-  outdata = outmap.data + (out_offset * out_bpf) + (out_width * channel);
+  GST_OBJECT_UNLOCK (aaggpad);
+  GST_OBJECT_UNLOCK (aagg);
 
+  /* the input is only interleaved when the output buffer is finished,
+   * together with all other channels */
+  input.buffer = gst_buffer_ref (inbuf);
+  input.in_offset = in_offset;
+  input.out_offset = out_offset;
+  input.num_frames = num_frames;
+
+  if (self->pending_outbuf != outbuf) {
+    if (self->pending->len > 0) {
+      GST_WARNING_OBJECT (self, "output buffer changed, dropping %u "
+          "pending inputs", self->pending->len);
+      gst_audio_interleave_clear_pending (self);
+    }
+    gst_audio_interleave_set_pending_outbuf (self, outbuf);
+  }
+  g_array_append_val (self->pending, input);
 
-  self->func (outdata, inmap.data + (in_offset * in_bpf), out_channels,
-      num_frames);
+  return TRUE;
+}
 
+static GstFlowReturn
+gst_audio_interleave_flush (GstAggregator * agg)
+{
+  gst_audio_interleave_clear_pending (GST_AUDIO_INTERLEAVE (agg));
 
-  gst_buffer_unmap (inbuf, &inmap);
-  gst_buffer_unmap (outbuf, &outmap);
+  return GST_AGGREGATOR_CLASS (parent_class)->flush (agg);
+}
 
-  GST_OBJECT_UNLOCK (aaggpad);
-  GST_OBJECT_UNLOCK (aagg);
+static GstFlowReturn
+gst_audio_interleave_finish_buffer (GstAggregator * agg, GstBuffer * buffer)
+{
+  gst_audio_interleave_interleave_pending (GST_AUDIO_INTERLEAVE (agg));
 
-  return TRUE;
+  return GST_AGGREGATOR_CLASS (parent_class)->finish_buffer (agg, buffer);
 }
 
 
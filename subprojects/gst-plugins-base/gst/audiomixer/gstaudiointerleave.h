@@ -35,9 +35,6 @@ G_BEGIN_DECLS
 G_DECLARE_FINAL_TYPE (GstAudioInterleave, gst_audio_interleave,
     GST, AUDIO_INTERLEAVE, GstAudioAggregator)
 
-typedef void (*GstInterleaveFunc) (gpointer out, gpointer in, guint stride,
-    guint nframes);
-
 /**
  * GstAudioInterleave:
  *
@@ -57,7 +54,10 @@ struct _GstAudioInterleave {
 
   gint default_channels_ordering_map[64];
 
-  GstInterleaveFunc func;
+  /* inputs for pending_outbuf, interleaved when it is finished */
+  GArray *pending;
+  /* weak reference, cleared when the buffer is freed */
+  GstBuffer *pending_outbuf;
 };
 
 
@@ -80,6 +80,23 @@
 #define VOLUME_UNITY_INT32           134217728  /* internal int for unity 2^(32-5) */
 #define VOLUME_UNITY_INT32_BIT_SHIFT 27
 
+/* the output is mixed in blocks of this size so that it stays in the cache
+ * while all inputs are added to it */
+#define MIX_BLOCK_BYTES 4096
+
+typedef struct
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+  guint in_offset;
+  guint out_offset;
+  guint num_frames;
+  gdouble volume;
+  gint volume_i32;
+  gint volume_i16;
+  gint volume_i8;
+} GstAudioMixerInput;
+
 enum
 {
   PROP_PAD_0,
@@ -207,6 +224,13 @@ G_DEFINE_TYPE_WITH_CODE (GstAudioMixer, gst_audiomixer,
 static GstPad *gst_audiomixer_request_new_pad (GstElement * element,
     GstPadTemplate * temp, const gchar * req_name, const GstCaps * caps);
 static void gst_audiomixer_release_pad (GstElement * element, GstPad * pad);
+static void gst_audiomixer_finalize (GObject * object);
+static gboolean gst_audiomixer_stop (GstAggregator * agg);
+static GstFlowReturn gst_audiomixer_flush (GstAggregator * agg);
+static gboolean gst_audiomixer_negotiated_src_caps (GstAggregator * agg,
+    GstCaps * caps);
+static GstFlowReturn gst_audiomixer_finish_buffer (GstAggregator * agg,
+    GstBuffer * buffer);
 
 static gboolean
 gst_audiomixer_aggregate_one_buffer (GstAudioAggregator * aagg,
@@ -217,9 +241,13 @@ gst_audiomixer_aggregate_one_buffer (GstAudioAggregator * aagg,
 static void
 gst_audiomixer_class_init (GstAudioMixerClass * klass)
 {
+  GObjectClass *gobject_class = (GObjectClass *) klass;
   GstElementClass *gstelement_class = (GstElementClass *) klass;
+  GstAggregatorClass *agg_class = (GstAggregatorClass *) klass;
   GstAudioAggregatorClass *aagg_class = (GstAudioAggregatorClass *) klass;
 
+  gobject_class->finalize = gst_audiomixer_finalize;
+
   gst_element_class_add_static_pad_template_with_gtype (gstelement_class,
       &gst_audiomixer_src_template, GST_TYPE_AUDIO_AGGREGATOR_CONVERT_PAD);
   gst_element_class_add_static_pad_template_with_gtype (gstelement_class,
@@ -233,14 +261,75 @@ gst_audiomixer_class_init (GstAudioMixerClass * klass)
   gstelement_class->release_pad =
       GST_DEBUG_FUNCPTR (gst_audiomixer_release_pad);
 
+  agg_class->stop = GST_DEBUG_FUNCPTR (gst_audiomixer_stop);
+  agg_class->flush = GST_DEBUG_FUNCPTR (gst_audiomixer_flush);
+  agg_class->negotiated_src_caps =
+      GST_DEBUG_FUNCPTR (gst_audiomixer_negotiated_src_caps);
+  agg_class->finish_buffer = GST_DEBUG_FUNCPTR (gst_audiomixer_finish_buffer);
+
   aagg_class->aggregate_one_buffer = gst_audiomixer_aggregate_one_buffer;
 
   gst_type_mark_as_plugin_api (GST_TYPE_AUDIO_MIXER_PAD, 0);
 }
 
+static void
+gst_audiomixer_input_clear (GstAudioMixerInput * input)
+{
+  gst_buffer_unref (input->buffer);
+}
+
+/* called when the base class drops the output buffer without finishing it,
+ * the inputs queued for it must not end up in the next one */
+static void
+gst_audiomixer_pending_outbuf_freed (GstAudioMixer * audiomixer,
+    GstMiniObject * outbuf)
+{
+  GST_DEBUG_OBJECT (audiomixer, "output buffer %p freed, dropping %u "
+      "pending inputs", outbuf, audiomixer->pending->len);
+
+  audiomixer->pending_outbuf = NULL;
+  g_array_set_size (audiomixer->pending, 0);
+}
+
+/* The output buffer is only tracked with a weak reference: the base class
+ * resizes and maps it for writing before it is finished, which needs it to
+ * be writable */
+static void
+gst_audiomixer_set_pending_outbuf (GstAudioMixer * audiomixer,
+    GstBuffer * outbuf)
+{
+  if (audiomixer->pending_outbuf == outbuf)
+    return;
+
+  if (audiomixer->pending_outbuf)
+    gst_mini_object_weak_unref (GST_MINI_OBJECT_CAST
+        (audiomixer->pending_outbuf),
+        (GstMiniObjectNotify) gst_audiomixer_pending_outbuf_freed, audiomixer);
+
+  audiomixer->pending_outbuf = outbuf;
+
+  if (outbuf)
+    gst_mini_object_weak_ref (GST_MINI_OBJECT_CAST (outbuf),
+        (GstMiniObjectNotify) gst_audiomixer_pending_outbuf_freed, audiomixer);
+}
+
 static void
 gst_audiomixer_init (GstAudioMixer * audiomixer)
 {
+  audiomixer->pending = g_array_new (FALSE, FALSE, sizeof (GstAudioMixerInput));
+  g_array_set_clear_func (audiomixer->pending,
+      (GDestroyNotify) gst_audiomixer_input_clear);
+}
+
+static void
+gst_audiomixer_finalize (GObject * object)
+{
+  GstAudioMixer *audiomixer = GST_AUDIO_MIXER (object);
+
+  gst_audiomixer_set_pending_outbuf (audiomixer, NULL);
+  g_array_unref (audiomixer->pending);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
 static GstPad *
@@ -284,138 +373,228 @@ gst_audiomixer_release_pad (GstElement * element, GstPad * pad)
 }
 
 
-static gboolean
-gst_audiomixer_aggregate_one_buffer (GstAudioAggregator * aagg,
-    GstAudioAggregatorPad * aaggpad, GstBuffer * inbuf, guint in_offset,
-    GstBuffer * outbuf, guint out_offset, guint num_frames)
+/* add num_samples samples from in to out with the volume of input */
+static void
+gst_audiomixer_mix_samples (GstAudioFormat format, GstAudioMixerInput * input,
+    gpointer out, gpointer in, guint num_samples)
 {
-  GstAudioMixerPad *pad = GST_AUDIO_MIXER_PAD (aaggpad);
-  GstMapInfo inmap;
-  GstMapInfo outmap;
-  gint bpf;
-  GstAggregator *agg = GST_AGGREGATOR (aagg);
-  GstAudioAggregatorPad *srcpad = GST_AUDIO_AGGREGATOR_PAD (agg->srcpad);
-
-  GST_OBJECT_LOCK (aagg);
-  GST_OBJECT_LOCK (aaggpad);
-
-  if (pad->mute || pad->volume < G_MINDOUBLE) {
-    GST_DEBUG_OBJECT (pad, "Skipping muted pad");
-    GST_OBJECT_UNLOCK (aaggpad);
-    GST_OBJECT_UNLOCK (aagg);
-    return FALSE;
-  }
-
-  bpf = GST_AUDIO_INFO_BPF (&srcpad->info);
-
-  gst_buffer_map (outbuf, &outmap, GST_MAP_READWRITE);
-  gst_buffer_map (inbuf, &inmap, GST_MAP_READ);
-  GST_LOG_OBJECT (pad, "mixing %u bytes at offset %u from offset %u",
-      num_frames * bpf, out_offset * bpf, in_offset * bpf);
-
-  /* further buffers, need to add them */
-  if (pad->volume == 1.0) {
-    switch (srcpad->info.finfo->format) {
+  if (input->volume == 1.0) {
+    switch (format) {
       case GST_AUDIO_FORMAT_U8:
-        audiomixer_orc_add_u8 ((gpointer) (outmap.data + out_offset * bpf),
-            (gpointer) (inmap.data + in_offset * bpf),
-            num_frames * srcpad->info.channels);
+        audiomixer_orc_add_u8 (out, in, num_samples);
         break;
       case GST_AUDIO_FORMAT_S8:
-        audiomixer_orc_add_s8 ((gpointer) (outmap.data + out_offset * bpf),
-            (gpointer) (inmap.data + in_offset * bpf),
-            num_frames * srcpad->info.channels);
+        audiomixer_orc_add_s8 (out, in, num_samples);
         break;
       case GST_AUDIO_FORMAT_U16:
-        audiomixer_orc_add_u16 ((gpointer) (outmap.data + out_offset * bpf),
-            (gpointer) (inmap.data + in_offset * bpf),
-            num_frames * srcpad->info.channels);
+        audiomixer_orc_add_u16 (out, in, num_samples);
         break;
       case GST_AUDIO_FORMAT_S16:
-        audiomixer_orc_add_s16 ((gpointer) (outmap.data + out_offset * bpf),
-            (gpointer) (inmap.data + in_offset * bpf),
-            num_frames * srcpad->info.channels);
+        audiomixer_orc_add_s16 (out, in, num_samples);
         break;
       case GST_AUDIO_FORMAT_U32:
-        audiomixer_orc_add_u32 ((gpointer) (outmap.data + out_offset * bpf),
-            (gpointer) (inmap.data + in_offset * bpf),
-            num_frames * srcpad->info.channels);
+        audiomixer_orc_add_u32 (out, in, num_samples);
         break;
       case GST_AUDIO_FORMAT_S32:
-        audiomixer_orc_add_s32 ((gpointer) (outmap.data + out_offset * bpf),
-            (gpointer) (inmap.data + in_offset * bpf),
-            num_frames * srcpad->info.channels);
+        audiomixer_orc_add_s32 (out, in, num_samples);
         break;
       case GST_AUDIO_FORMAT_F32:
-        audiomixer_orc_add_f32 ((gpointer) (outmap.data + out_offset * bpf),
-            (gpointer) (inmap.data + in_offset * bpf),
-            num_frames * srcpad->info.channels);
+        audiomixer_orc_add_f32 (out, in, num_samples);
         break;
       case GST_AUDIO_FORMAT_F64:
-        audiomixer_orc_add_f64 ((gpointer) (outmap.data + out_offset * bpf),
-            (gpointer) (inmap.data + in_offset * bpf),
-            num_frames * srcpad->info.channels);
+        audiomixer_orc_add_f64 (out, in, num_samples);
         break;
       default:
         g_assert_not_reached ();
         break;
     }
   } else {
-    switch (srcpad->info.finfo->format) {
+    switch (format) {
       case GST_AUDIO_FORMAT_U8:
-        audiomixer_orc_add_volume_u8 ((gpointer) (outmap.data +
-                out_offset * bpf), (gpointer) (inmap.data + in_offset * bpf),
-            pad->volume_i8, num_frames * srcpad->info.channels);
+        audiomixer_orc_add_volume_u8 (out, in, input->volume_i8, num_samples);
         break;
       case GST_AUDIO_FORMAT_S8:
-        audiomixer_orc_add_volume_s8 ((gpointer) (outmap.data +
-                out_offset * bpf), (gpointer) (inmap.data + in_offset * bpf),
-            pad->volume_i8, num_frames * srcpad->info.channels);
+        audiomixer_orc_add_volume_s8 (out, in, input->volume_i8, num_samples);
         break;
       case GST_AUDIO_FORMAT_U16:
-        audiomixer_orc_add_volume_u16 ((gpointer) (outmap.data +
-                out_offset * bpf), (gpointer) (inmap.data + in_offset * bpf),
-            pad->volume_i16, num_frames * srcpad->info.channels);
+        audiomixer_orc_add_volume_u16 (out, in, input->volume_i16, num_samples);
         break;
       case GST_AUDIO_FORMAT_S16:
-        audiomixer_orc_add_volume_s16 ((gpointer) (outmap.data +
-                out_offset * bpf), (gpointer) (inmap.data + in_offset * bpf),
-            pad->volume_i16, num_frames * srcpad->info.channels);
+        audiomixer_orc_add_volume_s16 (out, in, input->volume_i16, num_samples);
         break;
       case GST_AUDIO_FORMAT_U32:
-        audiomixer_orc_add_volume_u32 ((gpointer) (outmap.data +
-                out_offset * bpf), (gpointer) (inmap.data + in_offset * bpf),
-            pad->volume_i32, num_frames * srcpad->info.channels);
+        audiomixer_orc_add_volume_u32 (out, in, input->volume_i32, num_samples);
         break;
       case GST_AUDIO_FORMAT_S32:
-        audiomixer_orc_add_volume_s32 ((gpointer) (outmap.data +
-                out_offset * bpf), (gpointer) (inmap.data + in_offset * bpf),
-            pad->volume_i32, num_frames * srcpad->info.channels);
+        audiomixer_orc_add_volume_s32 (out, in, input->volume_i32, num_samples);
         break;
       case GST_AUDIO_FORMAT_F32:
-        audiomixer_orc_add_volume_f32 ((gpointer) (outmap.data +
-                out_offset * bpf), (gpointer) (inmap.data + in_offset * bpf),
-            pad->volume, num_frames * srcpad->info.channels);
+        audiomixer_orc_add_volume_f32 (out, in, input->volume, num_samples);
         break;
       case GST_AUDIO_FORMAT_F64:
-        audiomixer_orc_add_volume_f64 ((gpointer) (outmap.data +
-                out_offset * bpf), (gpointer) (inmap.data + in_offset * bpf),
-            pad->volume, num_frames * srcpad->info.channels);
+        audiomixer_orc_add_volume_f64 (out, in, input->volume, num_samples);
         break;
       default:
         g_assert_not_reached ();
         break;
     }
   }
-  gst_buffer_unmap (inbuf, &inmap);
-  gst_buffer_unmap (outbuf, &outmap);
+}
+
+/* mix all pending inputs into the output buffer, block by block so that the
+ * output is only read and written once from memory */
+static void
+gst_audiomixer_mix_pending (GstAudioMixer * audiomixer)
+{
+  GstAggregator *agg = GST_AGGREGATOR (audiomixer);
+  GstAudioAggregatorPad *srcpad = GST_AUDIO_AGGREGATOR_PAD (agg->srcpad);
+  GstAudioFormat format;
+  GstMapInfo outmap;
+  guint i, bpf, channels, out_frames, block, start, end;
+
+  if (audiomixer->pending->len == 0)
+    return;
+
+  GST_OBJECT_LOCK (audiomixer);
+  format = GST_AUDIO_INFO_FORMAT (&srcpad->info);
+  bpf = GST_AUDIO_INFO_BPF (&srcpad->info);
+  channels = GST_AUDIO_INFO_CHANNELS (&srcpad->info);
+  GST_OBJECT_UNLOCK (audiomixer);
+
+  GST_LOG_OBJECT (audiomixer, "mixing %u inputs", audiomixer->pending->len);
+
+  gst_buffer_map (audiomixer->pending_outbuf, &outmap, GST_MAP_READWRITE);
+  /* the output buffer might have been shortened at EOS */
+  out_frames = outmap.size / bpf;
+
+  for (i = 0; i < audiomixer->pending->len; i++) {
+    GstAudioMixerInput *input =
+        &g_array_index (audiomixer->pending, GstAudioMixerInput, i);
+
+    gst_buffer_map (input->buffer, &input->map, GST_MAP_READ);
+  }
+
+  block = MAX (MIX_BLOCK_BYTES / bpf, 1);
+  for (start = 0; start < out_frames; start += block) {
+    end = MIN (start + block, out_frames);
+
+    for (i = 0; i < audiomixer->pending->len; i++) {
+      GstAudioMixerInput *input =
+          &g_array_index (audiomixer->pending, GstAudioMixerInput, i);
+      guint from, to;
+
+      from = MAX (start, input->out_offset);
+      to = MIN (end, input->out_offset + input->num_frames);
+      if (from >= to)
+        continue;
+
+      gst_audiomixer_mix_samples (format, input, outmap.data + from * bpf,
+          input->map.data + (input->in_offset + from -
+              input->out_offset) * bpf, (to - from) * channels);
+    }
+  }
+
+  for (i = 0; i < audiomixer->pending->len; i++) {
+    GstAudioMixerInput *input =
+        &g_array_index (audiomixer->pending, GstAudioMixerInput, i);
+
+    gst_buffer_unmap (input->buffer, &input->map);
+  }
+  gst_buffer_unmap (audiomixer->pending_outbuf, &outmap);
+
+  g_array_set_size (audiomixer->pending, 0);
+  gst_audiomixer_set_pending_outbuf (audiomixer, NULL);
+}
+
+static void
+gst_audiomixer_clear_pending (GstAudioMixer * audiomixer)
+{
+  g_array_set_size (audiomixer->pending, 0);
+  gst_audiomixer_set_pending_outbuf (audiomixer, NULL);
+}
+
+static gboolean
+gst_audiomixer_aggregate_one_buffer (GstAudioAggregator * aagg,
+    GstAudioAggregatorPad * aaggpad, GstBuffer * inbuf, guint in_offset,
+    GstBuffer * outbuf, guint out_offset, guint num_frames)
+{
+  GstAudioMixer *audiomixer = GST_AUDIO_MIXER (aagg);
+  GstAudioMixerPad *pad = GST_AUDIO_MIXER_PAD (aaggpad);
+  GstAudioMixerInput input;
+
+  GST_OBJECT_LOCK (aagg);
+  GST_OBJECT_LOCK (aaggpad);
+
+  if (pad->mute || pad->volume < G_MINDOUBLE) {
+    GST_DEBUG_OBJECT (pad, "Skipping muted pad");
+    GST_OBJECT_UNLOCK (aaggpad);
+    GST_OBJECT_UNLOCK (aagg);
+    return FALSE;
+  }
+
+  GST_LOG_OBJECT (pad, "queueing %u frames at offset %u from offset %u",
+      num_frames, out_offset, in_offset);
+
+  /* the input is only added to the output when the output buffer is
+   * finished, together with all other inputs */
+  input.buffer = gst_buffer_ref (inbuf);
+  input.in_offset = in_offset;
+  input.out_offset = out_offset;
+  input.num_frames = num_frames;
+  input.volume = pad->volume;
+  input.volume_i32 = pad->volume_i32;
+  input.volume_i16 = pad->volume_i16;
+  input.volume_i8 = pad->volume_i8;
 
   GST_OBJECT_UNLOCK (aaggpad);
   GST_OBJECT_UNLOCK (aagg);
 
+  if (audiomixer->pending_outbuf != outbuf) {
+    if (audiomixer->pending->len > 0) {
+      GST_WARNING_OBJECT (audiomixer, "output buffer changed, dropping %u "
+          "pending inputs", audiomixer->pending->len);
+      gst_audiomixer_clear_pending (audiomixer);
+    }
+    gst_audiomixer_set_pending_outbuf (audiomixer, outbuf);
+  }
+  g_array_append_val (audiomixer->pending, input);
+
   return TRUE;
 }
 
+static gboolean
+gst_audiomixer_stop (GstAggregator * agg)
+{
+  gst_audiomixer_clear_pending (GST_AUDIO_MIXER (agg));
+
+  return GST_AGGREGATOR_CLASS (parent_class)->stop (agg);
+}
+
+static GstFlowReturn
+gst_audiomixer_flush (GstAggregator * agg)
+{
+  gst_audiomixer_clear_pending (GST_AUDIO_MIXER (agg));
+
+  return GST_AGGREGATOR_CLASS (parent_class)->flush (agg);
+}
+
+static gboolean
+gst_audiomixer_negotiated_src_caps (GstAggregator * agg, GstCaps * caps)
+{
+  /* a partially mixed output buffer is converted to the new format */
+  gst_audiomixer_mix_pending (GST_AUDIO_MIXER (agg));
+
+  return GST_AGGREGATOR_CLASS (parent_class)->negotiated_src_caps (agg, caps);
+}
+
+static GstFlowReturn
+gst_audiomixer_finish_buffer (GstAggregator * agg, GstBuffer * buffer)
+{
+  gst_audiomixer_mix_pending (GST_AUDIO_MIXER (agg));
+
+  return GST_AGGREGATOR_CLASS (parent_class)->finish_buffer (agg, buffer);
+}
+
 
 /* GstChildProxy implementation */
 static GObject *
@@ -41,6 +41,13 @@ G_DECLARE_FINAL_TYPE (GstAudioMixer, gst_audiomixer, GST, AUDIO_MIXER,
  */
 struct _GstAudioMixer {
   GstAudioAggregator element;
+
+  /*< private >*/
+  /* inputs for the current output buffer, mixed in one pass when the
+   * output buffer is finished */
+  GArray *pending;
+  /* weak reference, cleared when the buffer is freed */
+  GstBuffer *pending_outbuf;
 };
 
 #define GST_TYPE_AUDIO_MIXER_PAD (gst_audiomixer_pad_get_type())
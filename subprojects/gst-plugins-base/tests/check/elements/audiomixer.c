@@ -1371,6 +1371,124 @@ GST_START_TEST (test_sync)
 
 GST_END_TEST;
 
+static void
+send_buffers_sync_gap (GstPad * pad1, GstPad * pad2)
+{
+  GstBuffer *buffer;
+  GstFlowReturn ret;
+
+  buffer = new_buffer (2000, 1, 1 * GST_SECOND, 1 * GST_SECOND, 0);
+  ret = gst_pad_chain (pad1, buffer);
+  ck_assert_int_eq (ret, GST_FLOW_OK);
+
+  /* the contents of GAP buffers must not be mixed */
+  buffer = new_buffer (2000, 5, 2 * GST_SECOND, 1 * GST_SECOND,
+      GST_BUFFER_FLAG_GAP);
+  ret = gst_pad_chain (pad1, buffer);
+  ck_assert_int_eq (ret, GST_FLOW_OK);
+
+  gst_pad_send_event (pad1, gst_event_new_eos ());
+
+  buffer = new_buffer (2000, 2, 2 * GST_SECOND, 1 * GST_SECOND, 0);
+  ret = gst_pad_chain (pad2, buffer);
+  ck_assert_int_eq (ret, GST_FLOW_OK);
+
+  buffer = new_buffer (2000, 2, 3 * GST_SECOND, 1 * GST_SECOND, 0);
+  ret = gst_pad_chain (pad2, buffer);
+  ck_assert_int_eq (ret, GST_FLOW_OK);
+
+  gst_pad_send_event (pad2, gst_event_new_eos ());
+}
+
+static void
+check_buffers_sync_gap (GList * received_buffers)
+{
+  static const guint8 expected[] = { 0, 0, 1, 1, 2, 2, 2, 2 };
+  GstBuffer *buffer;
+  GList *l;
+  gint i;
+  GstMapInfo map;
+
+  /* Should have 8 * 0.5s buffers */
+  fail_unless_equals_int (g_list_length (received_buffers), 8);
+  for (i = 0, l = received_buffers; l; l = l->next, i++) {
+    buffer = l->data;
+
+    fail_unless_equals_uint64 (GST_BUFFER_TIMESTAMP (buffer),
+        i * 500 * GST_MSECOND);
+
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    fail_unless (map.data[0] == expected[i]);
+    fail_unless (map.data[map.size - 1] == expected[i]);
+    gst_buffer_unmap (buffer, &map);
+  }
+}
+
+GST_START_TEST (test_sync_gap)
+{
+  run_sync_test (send_buffers_sync_gap, check_buffers_sync_gap);
+}
+
+GST_END_TEST;
+
+static void
+send_buffers_sync_overlap (GstPad * pad1, GstPad * pad2)
+{
+  GstBuffer *buffer;
+  GstFlowReturn ret;
+
+  buffer = new_buffer (2000, 1, 0, 1 * GST_SECOND, 0);
+  ret = gst_pad_chain (pad1, buffer);
+  ck_assert_int_eq (ret, GST_FLOW_OK);
+
+  gst_pad_send_event (pad1, gst_event_new_eos ());
+
+  /* starts and ends in the middle of an output buffer */
+  buffer = new_buffer (2000, 2, 250 * GST_MSECOND, 1 * GST_SECOND, 0);
+  ret = gst_pad_chain (pad2, buffer);
+  ck_assert_int_eq (ret, GST_FLOW_OK);
+
+  gst_pad_send_event (pad2, gst_event_new_eos ());
+}
+
+static void
+check_buffers_sync_overlap (GList * received_buffers)
+{
+  /* first, middle and last byte of every output buffer */
+  static const guint8 expected[][3] = { {1, 3, 3}, {3, 3, 3}, {2, 2, 2} };
+  static const gsize expected_sizes[] = { 1000, 1000, 500 };
+  GstBuffer *buffer;
+  GList *l;
+  gint i;
+  GstMapInfo map;
+
+  /* Should have 2 * 0.5s buffers and the last 0.25s */
+  fail_unless_equals_int (g_list_length (received_buffers), 3);
+  for (i = 0, l = received_buffers; l; l = l->next, i++) {
+    buffer = l->data;
+
+    fail_unless_equals_uint64 (GST_BUFFER_TIMESTAMP (buffer),
+        i * 500 * GST_MSECOND);
+
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    fail_unless_equals_int (map.size, expected_sizes[i]);
+    fail_unless_equals_int (map.data[0], expected[i][0]);
+    fail_unless_equals_int (map.data[map.size / 2], expected[i][1]);
+    fail_unless_equals_int (map.data[map.size - 1], expected[i][2]);
+    gst_buffer_unmap (buffer, &map);
+  }
+}
+
+/* inputs of both pads are queued for the same output buffers at different
+ * offsets and only mixed when the output buffer is finished, the last one
+ * being shortened at EOS */
+GST_START_TEST (test_sync_overlap)
+{
+  run_sync_test (send_buffers_sync_overlap, check_buffers_sync_overlap);
+}
+
+GST_END_TEST;
+
 static void
 send_buffers_sync_discont (GstPad * pad1, GstPad * pad2)
 {
@@ -2242,6 +2360,8 @@ audiomixer_suite (void)
   tcase_add_test (tc_chain, test_flush_start_flush_stop);
   tcase_add_test (tc_chain, test_sync);
   tcase_add_test (tc_chain, test_sync_discont);
+  tcase_add_test (tc_chain, test_sync_gap);
+  tcase_add_test (tc_chain, test_sync_overlap);
   tcase_add_test (tc_chain, test_sync_discont_backwards);
   tcase_add_test (tc_chain, test_sync_discont_and_drop_backwards);
   tcase_add_test (tc_chain, test_sync_discont_and_drop_before_output_backwards);
@@ -1578,6 +1578,271 @@ GST_START_TEST (test_audio_make_raw_caps)
 
 GST_END_TEST;
 
+#define CONVERTER_THREADS_CHANNELS 64
+#define CONVERTER_THREADS_FRAMES 4800
+
+/* creates the converter with @n_threads and switches to @new_threads with
+ * gst_audio_converter_update_config() when they differ */
+static gpointer
+convert_with_threads (guint n_threads, guint new_threads,
+    GstAudioLayout in_layout, GstAudioLayout out_layout,
+    const gfloat * in_data, gsize * out_size)
+{
+  GstAudioConverter *convert;
+  GstAudioInfo in_info, out_info;
+  gpointer in[CONVERTER_THREADS_CHANNELS], out[CONVERTER_THREADS_CHANNELS];
+  gsize in_frames = CONVERTER_THREADS_FRAMES, out_frames;
+  guint8 *out_data;
+  gint c;
+
+  gst_audio_info_set_format (&in_info, GST_AUDIO_FORMAT_F32, 48000,
+      CONVERTER_THREADS_CHANNELS, NULL);
+  in_info.layout = in_layout;
+  gst_audio_info_set_format (&out_info, GST_AUDIO_FORMAT_S16, 44100,
+      CONVERTER_THREADS_CHANNELS, NULL);
+  out_info.layout = out_layout;
+
+  convert = gst_audio_converter_new (0, &in_info, &out_info,
+      gst_structure_new ("options", GST_AUDIO_CONVERTER_OPT_THREADS,
+          G_TYPE_UINT, n_threads, NULL));
+  fail_unless (convert != NULL);
+
+  if (new_threads != n_threads)
+    fail_unless (gst_audio_converter_update_config (convert, 0, 0,
+            gst_structure_new ("options", GST_AUDIO_CONVERTER_OPT_THREADS,
+                G_TYPE_UINT, new_threads, NULL)));
+
+  out_frames = gst_audio_converter_get_out_frames (convert, in_frames);
+  *out_size = out_frames * out_info.bpf;
+  out_data = g_malloc0 (*out_size);
+
+  for (c = 0; c < CONVERTER_THREADS_CHANNELS; c++) {
+    if (in_layout == GST_AUDIO_LAYOUT_NON_INTERLEAVED)
+      in[c] = (gpointer) (in_data + c * in_frames);
+    else
+      in[c] = (gpointer) in_data;
+    if (out_layout == GST_AUDIO_LAYOUT_NON_INTERLEAVED)
+      out[c] = out_data + c * out_frames * sizeof (gint16);
+    else
+      out[c] = out_data;
+  }
+
+  fail_unless (gst_audio_converter_samples (convert, 0, in, in_frames, out,
+          out_frames));
+
+  gst_audio_converter_free (convert);
+
+  return out_data;
+}
+
+GST_START_TEST (test_audio_converter_threads)
+{
+  GstAudioLayout layouts[] = {
+    GST_AUDIO_LAYOUT_INTERLEAVED, GST_AUDIO_LAYOUT_NON_INTERLEAVED
+  };
+  GRand *rand = g_rand_new_with_seed (42);
+  gfloat *in_data;
+  gint i, j;
+
+  in_data = g_new (gfloat, CONVERTER_THREADS_FRAMES *
+      CONVERTER_THREADS_CHANNELS);
+  for (i = 0; i < CONVERTER_THREADS_FRAMES * CONVERTER_THREADS_CHANNELS; i++)
+    in_data[i] = g_rand_double_range (rand, -0.9, 0.9);
+  g_rand_free (rand);
+
+  for (i = 0; i < G_N_ELEMENTS (layouts); i++) {
+    for (j = 0; j < G_N_ELEMENTS (layouts); j++) {
+      gpointer single, threaded, more, fewer;
+      gsize single_size, threaded_size, more_size, fewer_size;
+
+      single = convert_with_threads (1, 1, layouts[i], layouts[j], in_data,
+          &single_size);
+      threaded = convert_with_threads (4, 4, layouts[i], layouts[j], in_data,
+          &threaded_size);
+      more = convert_with_threads (2, 4, layouts[i], layouts[j], in_data,
+          &more_size);
+      fewer = convert_with_threads (4, 1, layouts[i], layouts[j], in_data,
+          &fewer_size);
+
+      fail_unless_equals_int (single_size, threaded_size);
+      fail_unless (memcmp (single, threaded, single_size) == 0);
+      fail_unless_equals_int (single_size, more_size);
+      fail_unless (memcmp (single, more, single_size) == 0);
+      fail_unless_equals_int (single_size, fewer_size);
+      fail_unless (memcmp (single, fewer, single_size) == 0);
+
+      g_free (single);
+      g_free (threaded);
+      g_free (more);
+      g_free (fewer);
+    }
+  }
+
+  g_free (in_data);
+}
+
+GST_END_TEST;
+
+#define FUSED_MIX_FRAMES 4096
+
+/* with more than one thread the converter always runs the generic chain */
+static gpointer
+convert_mix (guint n_threads, GstAudioInfo * in_info, GstAudioInfo * out_info,
+    gpointer in_data)
+{
+  GstAudioConverter *convert;
+  gpointer in[1], out[1];
+
+  convert = gst_audio_converter_new (0, in_info, out_info,
+      gst_structure_new ("options", GST_AUDIO_CONVERTER_OPT_THREADS,
+          G_TYPE_UINT, n_threads, GST_AUDIO_CONVERTER_OPT_DITHER_METHOD,
+          GST_TYPE_AUDIO_DITHER_METHOD, GST_AUDIO_DITHER_TPDF,
+          GST_AUDIO_CONVERTER_OPT_NOISE_SHAPING_METHOD,
+          GST_TYPE_AUDIO_NOISE_SHAPING_METHOD,
+          GST_AUDIO_NOISE_SHAPING_ERROR_FEEDBACK, NULL));
+  fail_unless (convert != NULL);
+
+  in[0] = in_data;
+  out[0] = g_malloc0 (FUSED_MIX_FRAMES * out_info->bpf);
+
+  fail_unless (gst_audio_converter_samples (convert, 0, in, FUSED_MIX_FRAMES,
+          out, FUSED_MIX_FRAMES));
+
+  gst_audio_converter_free (convert);
+
+  return out[0];
+}
+
+GST_START_TEST (test_audio_converter_fused_mix)
+{
+  struct
+  {
+    GstAudioFormat in_format;
+    gint in_channels;
+    GstAudioFormat out_format;
+    gint out_channels;
+  } conversions[] = {
+    {GST_AUDIO_FORMAT_F32, 6, GST_AUDIO_FORMAT_S16, 2},
+    {GST_AUDIO_FORMAT_F64, 8, GST_AUDIO_FORMAT_S24, 6},
+    {GST_AUDIO_FORMAT_F32, 2, GST_AUDIO_FORMAT_S32, 1},
+    {GST_AUDIO_FORMAT_S32, 2, GST_AUDIO_FORMAT_F32, 6},
+    {GST_AUDIO_FORMAT_S32, 8, GST_AUDIO_FORMAT_F64, 2},
+  };
+  GRand *rand = g_rand_new_with_seed (42);
+  gint i;
+
+  for (i = 0; i < G_N_ELEMENTS (conversions); i++) {
+    GstAudioInfo in_info, out_info;
+    gpointer in_data, fused, generic;
+    gsize j, samples;
+
+    gst_audio_info_set_format (&in_info, conversions[i].in_format, 48000,
+        conversions[i].in_channels, NULL);
+    gst_audio_info_set_format (&out_info, conversions[i].out_format, 48000,
+        conversions[i].out_channels, NULL);
+
+    samples = FUSED_MIX_FRAMES * in_info.channels;
+    in_data = g_malloc (FUSED_MIX_FRAMES * in_info.bpf);
+    for (j = 0; j < samples; j++) {
+      /* include some clipping */
+      gdouble v = g_rand_double_range (rand, -1.2, 1.2);
+
+      switch (conversions[i].in_format) {
+        case GST_AUDIO_FORMAT_F32:
+          ((gfloat *) in_data)[j] = v;
+          break;
+        case GST_AUDIO_FORMAT_F64:
+          ((gdouble *) in_data)[j] = v;
+          break;
+        default:
+          ((gint32 *) in_data)[j] = CLAMP (v, -1.0, 1.0) * G_MAXINT32;
+          break;
+      }
+    }
+
+    fused = convert_mix (1, &in_info, &out_info, in_data);
+    generic = convert_mix (2, &in_info, &out_info, in_data);
+    fail_unless (memcmp (fused, generic,
+            FUSED_MIX_FRAMES * out_info.bpf) == 0);
+
+    g_free (in_data);
+    g_free (fused);
+    g_free (generic);
+  }
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_interleave_samples)
+{
+  static const GstAudioFormat formats[] = {
+    GST_AUDIO_FORMAT_U8, GST_AUDIO_FORMAT_S16, GST_AUDIO_FORMAT_S24,
+    GST_AUDIO_FORMAT_F32, GST_AUDIO_FORMAT_F64
+  };
+  static const gint channels[] = { 1, 2, 3, 6, 8, 9, 64 };
+  static const gsize frames[] = { 0, 1, 7, 17, 100 };
+  GRand *rand = g_rand_new_with_seed (42);
+  gint f, c, n, ch;
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    const GstAudioFormatInfo *finfo = gst_audio_format_get_info (formats[f]);
+    gint bps = GST_AUDIO_FORMAT_INFO_WIDTH (finfo) / 8;
+
+    for (c = 0; c < G_N_ELEMENTS (channels); c++) {
+      for (n = 0; n < G_N_ELEMENTS (frames); n++) {
+        gint nch = channels[c];
+        gsize j, nframes = frames[n], size = nframes * nch * bps;
+        guint8 *in, *out;
+        gpointer planes[64];
+
+        in = g_malloc (size + 1);
+        out = g_malloc0 (size + 1);
+        for (j = 0; j < size; j++)
+          in[j] = g_rand_int (rand);
+        for (ch = 0; ch < nch; ch++)
+          planes[ch] = g_malloc (nframes * bps + 1);
+
+        gst_audio_deinterleave_samples (formats[f], nch, in, planes, nframes);
+        for (ch = 0; ch < nch; ch++) {
+          for (j = 0; j < nframes; j++)
+            fail_unless (memcmp ((guint8 *) planes[ch] + j * bps,
+                    in + (j * nch + ch) * bps, bps) == 0);
+        }
+
+        gst_audio_interleave_samples (formats[f], nch, planes, out, nframes);
+        fail_unless (memcmp (in, out, size) == 0);
+
+        /* channels without input are left alone */
+        if (nch > 1) {
+          g_free (planes[1]);
+          planes[1] = NULL;
+          memset (out, 0, size);
+          gst_audio_interleave_samples (formats[f], nch, planes, out, nframes);
+          for (j = 0; j < nframes; j++) {
+            for (ch = 0; ch < nch; ch++) {
+              guint8 *o = out + (j * nch + ch) * bps;
+
+              if (ch == 1)
+                fail_unless (o[0] == 0 && o[bps - 1] == 0);
+              else
+                fail_unless (memcmp (o, in + (j * nch + ch) * bps, bps) == 0);
+            }
+          }
+        }
+
+        for (ch = 0; ch < nch; ch++)
+          g_free (planes[ch]);
+        g_free (in);
+        g_free (out);
+      }
+    }
+  }
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
 static Suite *
 audio_suite (void)
 {
@@ -1616,6 +1881,9 @@ audio_suite (void)
   tcase_add_test (tc_chain, test_audio_buffer_and_audio_meta);
   tcase_add_test (tc_chain, test_audio_info_from_caps);
   tcase_add_test (tc_chain, test_audio_make_raw_caps);
+  tcase_add_test (tc_chain, test_audio_converter_threads);
+  tcase_add_test (tc_chain, test_audio_converter_fused_mix);
+  tcase_add_test (tc_chain, test_interleave_samples);
 
   return s;
 }
@@ -521,6 +521,122 @@ GST_START_TEST (test_f64_22050hz)
 
 GST_END_TEST;
 
+/* Lengths that take every path: powers of two whose half is an even or odd
+ * power of two, and a length that is not a power of two */
+static const gint dft_lengths[] = { 32, 64, 1024, 2048, 30 };
+
+/* naive DFT of @in at frequency @k */
+static void
+dft (const gdouble * in, gint len, gint k, gdouble * re, gdouble * im)
+{
+  gint i;
+
+  *re = *im = 0.0;
+  for (i = 0; i < len; i++) {
+    gdouble phase = -2.0 * G_PI * ((gint64) k * i % len) / len;
+
+    *re += in[i] * cos (phase);
+    *im += in[i] * sin (phase);
+  }
+}
+
+GST_START_TEST (test_f32_dft)
+{
+  guint l;
+
+  for (l = 0; l < G_N_ELEMENTS (dft_lengths); l++) {
+    gint i, len = dft_lengths[l];
+    gfloat *in, *out;
+    gdouble *ref;
+    GstFFTF32Complex *freq;
+    GstFFTF32 *ctx, *ictx;
+
+    in = g_new (gfloat, len);
+    out = g_new (gfloat, len);
+    ref = g_new (gdouble, len);
+    freq = g_new (GstFFTF32Complex, len / 2 + 1);
+    ctx = gst_fft_f32_new (len, FALSE);
+    ictx = gst_fft_f32_new (len, TRUE);
+
+    for (i = 0; i < len; i++)
+      ref[i] = in[i] = g_random_double_range (-1.0, 1.0);
+
+    gst_fft_f32_fft (ctx, in, freq);
+
+    for (i = 0; i < len / 2 + 1; i++) {
+      gdouble re, im;
+
+      dft (ref, len, i, &re, &im);
+      fail_unless (fabs (freq[i].r - re) < 1e-3,
+          "%d/%d: %f != %f", i, len, freq[i].r, re);
+      fail_unless (fabs (freq[i].i - im) < 1e-3,
+          "%d/%d: %f != %f", i, len, freq[i].i, im);
+    }
+
+    gst_fft_f32_inverse_fft (ictx, freq, out);
+
+    for (i = 0; i < len; i++)
+      fail_unless (fabs (out[i] / len - ref[i]) < 1e-5,
+          "%d/%d: %f != %f", i, len, out[i] / len, ref[i]);
+
+    gst_fft_f32_free (ctx);
+    gst_fft_f32_free (ictx);
+    g_free (in);
+    g_free (out);
+    g_free (ref);
+    g_free (freq);
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_f64_dft)
+{
+  guint l;
+
+  for (l = 0; l < G_N_ELEMENTS (dft_lengths); l++) {
+    gint i, len = dft_lengths[l];
+    gdouble *in, *out;
+    GstFFTF64Complex *freq;
+    GstFFTF64 *ctx, *ictx;
+
+    in = g_new (gdouble, len);
+    out = g_new (gdouble, len);
+    freq = g_new (GstFFTF64Complex, len / 2 + 1);
+    ctx = gst_fft_f64_new (len, FALSE);
+    ictx = gst_fft_f64_new (len, TRUE);
+
+    for (i = 0; i < len; i++)
+      in[i] = g_random_double_range (-1.0, 1.0);
+
+    gst_fft_f64_fft (ctx, in, freq);
+
+    for (i = 0; i < len / 2 + 1; i++) {
+      gdouble re, im;
+
+      dft (in, len, i, &re, &im);
+      fail_unless (fabs (freq[i].r - re) < 1e-9,
+          "%d/%d: %f != %f", i, len, freq[i].r, re);
+      fail_unless (fabs (freq[i].i - im) < 1e-9,
+          "%d/%d: %f != %f", i, len, freq[i].i, im);
+    }
+
+    gst_fft_f64_inverse_fft (ictx, freq, out);
+
+    for (i = 0; i < len; i++)
+      fail_unless (fabs (out[i] / len - in[i]) < 1e-12,
+          "%d/%d: %f != %f", i, len, out[i] / len, in[i]);
+
+    gst_fft_f64_free (ctx);
+    gst_fft_f64_free (ictx);
+    g_free (in);
+    g_free (out);
+    g_free (freq);
+  }
+}
+
+GST_END_TEST;
+
 static Suite *
 fft_suite (void)
 {
@@ -541,6 +657,8 @@ fft_suite (void)
   tcase_add_test (tc_chain, test_f64_0hz);
   tcase_add_test (tc_chain, test_f64_11025hz);
   tcase_add_test (tc_chain, test_f64_22050hz);
+  tcase_add_test (tc_chain, test_f32_dft);
+  tcase_add_test (tc_chain, test_f64_dft);
 
   return s;
 }
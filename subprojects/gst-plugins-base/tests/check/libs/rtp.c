@@ -203,6 +203,67 @@ GST_START_TEST (test_rtp_buffer_validate_padding)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtp_buffer_map_header_only)
+{
+  GstBuffer *buf;
+  guint8 rtp_test_buffer[] = {
+    0xb0, 0x7c, 0x18, 0xa6,     /* |V=2|P|X|CC|M|PT|sequence number| */
+    0x7a, 0x62, 0x17, 0x0f,     /* |timestamp| */
+    0x70, 0x23, 0x91, 0x38,     /* |synchronization source (SSRC) identifier| */
+    0xbe, 0xde, 0x00, 0x01,     /* |0xBE|0xDE|length=1| */
+    0x10, 0xaa, 0x00, 0x00,     /* |ID 1|L=0|data|0 (pad)|0 (pad)| */
+    0xff, 0xff, 0xff, 0xff,     /* |dummy payload| */
+    0x00, 0x00, 0x00, 0x04      /* |padding| */
+  };
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  gpointer data;
+  guint size;
+
+  buf = gst_buffer_new_and_alloc (sizeof (rtp_test_buffer));
+  gst_buffer_fill (buf, 0, rtp_test_buffer, sizeof (rtp_test_buffer));
+
+  fail_unless (gst_rtp_buffer_map (buf,
+          GST_MAP_READ | GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY, &rtp));
+  fail_unless_equals_int (gst_rtp_buffer_get_seq (&rtp), 0x18a6);
+  fail_unless_equals_int (gst_rtp_buffer_get_ssrc (&rtp), 0x70239138);
+  fail_unless_equals_int (gst_rtp_buffer_get_payload_type (&rtp), 0x7c);
+  /* extension and padding are not mapped yet */
+  fail_unless (rtp.map[1].memory == NULL);
+  fail_unless (rtp.map[3].memory == NULL);
+
+  /* but get mapped on demand */
+  fail_unless (gst_rtp_buffer_get_extension_onebyte_header (&rtp, 1, 0, &data,
+          &size));
+  fail_unless_equals_int (size, 1);
+  fail_unless_equals_int (GST_READ_UINT8 (data), 0xaa);
+  fail_unless_equals_int (gst_rtp_buffer_get_header_len (&rtp), 20);
+  fail_unless_equals_int (gst_rtp_buffer_get_payload_len (&rtp), 4);
+  fail_unless_equals_int (GST_READ_UINT32_BE (gst_rtp_buffer_get_payload
+          (&rtp)), 0xffffffff);
+  gst_rtp_buffer_unmap (&rtp);
+
+  /* invalid padding is only noticed when the payload is needed */
+  gst_buffer_memset (buf, gst_buffer_get_size (buf) - 1, 0xff, 1);
+  fail_if (gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp));
+
+  memset (&rtp, 0, sizeof (rtp));
+  fail_unless (gst_rtp_buffer_map (buf,
+          GST_MAP_READ | GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY, &rtp));
+  fail_unless_equals_int (gst_rtp_buffer_get_seq (&rtp), 0x18a6);
+  fail_unless_equals_int (gst_rtp_buffer_get_payload_len (&rtp), 0);
+  fail_unless (gst_rtp_buffer_get_payload (&rtp) == NULL);
+  fail_if (gst_rtp_buffer_get_extension_data (&rtp, NULL, NULL, NULL));
+  gst_rtp_buffer_unmap (&rtp);
+
+  /* writable maps are always complete */
+  fail_if (gst_rtp_buffer_map (buf,
+          GST_MAP_READWRITE | GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY, &rtp));
+
+  gst_buffer_unref (buf);
+}
+
+GST_END_TEST;
+
 #if 0
 GST_START_TEST (test_rtp_buffer_list)
 {
@@ -2333,6 +2394,7 @@ rtp_suite (void)
   tcase_add_test (tc_chain, test_rtp_buffer);
   tcase_add_test (tc_chain, test_rtp_buffer_validate_corrupt);
   tcase_add_test (tc_chain, test_rtp_buffer_validate_padding);
+  tcase_add_test (tc_chain, test_rtp_buffer_map_header_only);
   tcase_add_test (tc_chain, test_rtp_buffer_set_extension_data);
   //tcase_add_test (tc_chain, test_rtp_buffer_list_set_extension);
   tcase_add_test (tc_chain, test_rtp_seqnum_compare);
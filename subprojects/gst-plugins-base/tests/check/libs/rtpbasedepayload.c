@@ -196,6 +196,70 @@ gst_rtp_dummy_depay_set_caps (GstRTPBaseDepayload * filter, GstCaps * caps)
   return TRUE;
 }
 
+/* Dummy depayloader that processes buffer lists in one batch */
+
+#define GST_TYPE_RTP_DUMMY_LIST_DEPAY \
+  (gst_rtp_dummy_list_depay_get_type())
+#define GST_RTP_DUMMY_LIST_DEPAY(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_RTP_DUMMY_LIST_DEPAY,GstRtpDummyListDepay))
+
+typedef struct _GstRtpDummyListDepay GstRtpDummyListDepay;
+typedef struct _GstRtpDummyListDepayClass GstRtpDummyListDepayClass;
+
+struct _GstRtpDummyListDepay
+{
+  GstRtpDummyDepay depayload;
+
+  guint num_batches;
+  guint num_packets;
+};
+
+struct _GstRtpDummyListDepayClass
+{
+  GstRtpDummyDepayClass parent_class;
+};
+
+GType gst_rtp_dummy_list_depay_get_type (void);
+
+G_DEFINE_TYPE (GstRtpDummyListDepay, gst_rtp_dummy_list_depay,
+    GST_TYPE_RTP_DUMMY_DEPAY);
+
+static GstFlowReturn
+gst_rtp_dummy_list_depay_process_list (GstRTPBaseDepayload * depayload,
+    GstRTPBuffer * packets, guint n_packets)
+{
+  GstRtpDummyListDepay *self = GST_RTP_DUMMY_LIST_DEPAY (depayload);
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint i;
+
+  self->num_batches++;
+  self->num_packets += n_packets;
+
+  for (i = 0; i < n_packets && ret == GST_FLOW_OK; i++) {
+    GstBuffer *outbuf = gst_rtp_buffer_get_payload_buffer (&packets[i]);
+
+    ret = gst_rtp_base_depayload_queue (depayload, &packets[i], outbuf);
+  }
+
+  return ret;
+}
+
+static void
+gst_rtp_dummy_list_depay_class_init (GstRtpDummyListDepayClass * klass)
+{
+  GstRTPBaseDepayloadClass *gstrtpbasedepayload_class;
+
+  gstrtpbasedepayload_class = GST_RTP_BASE_DEPAYLOAD_CLASS (klass);
+
+  gstrtpbasedepayload_class->process_rtp_packet_list =
+      gst_rtp_dummy_list_depay_process_list;
+}
+
+static void
+gst_rtp_dummy_list_depay_init (GstRtpDummyListDepay * depay)
+{
+}
+
 /* Helper functions and global state */
 
 static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
@@ -1567,6 +1631,64 @@ GST_START_TEST (rtp_base_depayload_flow_return_push_list_func)
 
 GST_END_TEST;
 
+/* Test that a buffer list is processed in one batch, with duplicates dropped
+ * and gaps marked as discont like for single buffers. */
+GST_START_TEST (rtp_base_depayload_process_list_test)
+{
+  GstHarness *h;
+  GstRtpDummyListDepay *depay;
+  GstBufferList *list;
+  GstBuffer *buffer;
+  const guint seqnums[] = { 100, 101, 101, 103, 104 };
+  const GstClockTime expected_pts[] = { 0, 1, 3, 4 };
+  guint i;
+
+  depay = g_object_new (GST_TYPE_RTP_DUMMY_LIST_DEPAY, NULL);
+  h = gst_harness_new_with_element (GST_ELEMENT_CAST (depay), "sink", "src");
+  gst_harness_set_src_caps_str (h, "application/x-rtp");
+
+  list = gst_buffer_list_new ();
+  for (i = 0; i < G_N_ELEMENTS (seqnums); i++) {
+    buffer = gst_rtp_buffer_new_allocate (4, 0, 0);
+    rtp_buffer_set (buffer, "pts", i * GST_SECOND, "seq", seqnums[i],
+        "ssrc", 0x11, "rtptime", G_GUINT64_CONSTANT (0x1234) + i, NULL);
+    gst_buffer_list_add (list, buffer);
+  }
+
+  fail_unless_equals_int (GST_FLOW_OK, gst_pad_push_list (h->srcpad, list));
+
+  /* the duplicate is dropped before the subclass sees the batch */
+  fail_unless_equals_int (depay->num_batches, 1);
+  fail_unless_equals_int (depay->num_packets, 4);
+
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 4);
+  for (i = 0; i < 4; i++) {
+    buffer = gst_harness_pull (h);
+    fail_unless_equals_uint64 (GST_BUFFER_PTS (buffer),
+        expected_pts[i] * GST_SECOND);
+    fail_unless_equals_int (gst_buffer_get_size (buffer), 4);
+    /* seqnum 102 is missing */
+    fail_unless_equals_int (GST_BUFFER_IS_DISCONT (buffer), i == 2);
+    gst_buffer_unref (buffer);
+  }
+
+  /* single buffers are a batch of one packet */
+  buffer = gst_rtp_buffer_new_allocate (4, 0, 0);
+  rtp_buffer_set (buffer, "pts", 5 * GST_SECOND, "seq", 105, "ssrc", 0x11,
+      "rtptime", G_GUINT64_CONSTANT (0x1239), NULL);
+  fail_unless_equals_int (GST_FLOW_OK, gst_harness_push (h, buffer));
+  fail_unless_equals_int (depay->num_batches, 2);
+  buffer = gst_harness_pull (h);
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (buffer), 5 * GST_SECOND);
+  fail_if (GST_BUFFER_IS_DISCONT (buffer));
+  gst_buffer_unref (buffer);
+
+  g_object_unref (depay);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (rtp_base_depayload_one_byte_hdr_ext)
 {
   GstRTPHeaderExtension *ext;
@@ -1914,6 +2036,8 @@ rtp_basepayloading_suite (void)
   tcase_add_test (tc_chain, rtp_base_depayload_flow_return_push_func);
   tcase_add_test (tc_chain, rtp_base_depayload_flow_return_push_list_func);
 
+  tcase_add_test (tc_chain, rtp_base_depayload_process_list_test);
+
   tcase_add_test (tc_chain, rtp_base_depayload_one_byte_hdr_ext);
   tcase_add_test (tc_chain, rtp_base_depayload_two_byte_hdr_ext);
   tcase_add_test (tc_chain, rtp_base_depayload_request_extension);
@@ -50,6 +50,9 @@ typedef struct _GstRtpDummyPayClass GstRtpDummyPayClass;
 struct _GstRtpDummyPay
 {
   GstRTPBasePayload payload;
+
+  /* queue two packets referencing halves of a payload per input buffer */
+  gboolean split;
 };
 
 struct _GstRtpDummyPayClass
@@ -121,6 +124,26 @@ gst_rtp_dummy_pay_handle_buffer (GstRTPBasePayload * pay, GstBuffer * buffer)
     }
   }
 
+  if (GST_RTP_DUMMY_PAY (pay)->split) {
+    GstBuffer *payload = gst_buffer_new_allocate (NULL, 8, NULL);
+    GstFlowReturn ret = GST_FLOW_OK;
+    guint i;
+
+    gst_buffer_memset (payload, 0, 0xab, 8);
+
+    for (i = 0; i < 2 && ret == GST_FLOW_OK; i++) {
+      paybuffer = gst_rtp_base_payload_allocate_output_buffer_for_region (pay,
+          payload, i * 4, 4, 0);
+      GST_BUFFER_PTS (paybuffer) = GST_BUFFER_PTS (buffer);
+      GST_BUFFER_OFFSET (paybuffer) = GST_BUFFER_OFFSET (buffer);
+      ret = gst_rtp_base_payload_queue (pay, paybuffer);
+    }
+
+    gst_buffer_unref (payload);
+    gst_buffer_unref (buffer);
+    return ret;
+  }
+
   paybuffer =
       gst_rtp_base_payload_allocate_output_buffer (GST_RTP_BASE_PAYLOAD (pay),
       0, 0, 0);
@@ -2310,6 +2333,139 @@ GST_START_TEST (rtp_base_payload_extensions_shrink_ext_data)
 }
 
 GST_END_TEST;
+
+/* let the payloader queue two packets per input buffer that reference
+ * halves of a payload buffer. both packets of an input buffer are pushed
+ * together and get the same rtptime, the payload is not copied.
+ */
+GST_START_TEST (rtp_base_payload_queue_region_test)
+{
+  State *state;
+  GstBuffer *buf;
+  guint32 rtptime;
+  guint16 seq;
+
+  state = create_payloader ("application/x-rtp", &sinktmpl,
+      "perfect-rtptime", FALSE, NULL);
+  GST_RTP_DUMMY_PAY (state->element)->split = TRUE;
+
+  set_state (state, GST_STATE_PLAYING);
+
+  push_buffer (state, "pts", 0 * GST_SECOND, NULL);
+
+  push_buffer (state, "pts", 1 * GST_SECOND, NULL);
+
+  set_state (state, GST_STATE_NULL);
+
+  validate_buffers_received (4);
+
+  validate_buffer (0, "pts", 0 * GST_SECOND, "size", (gsize) 16, NULL);
+  get_buffer_field (0, "rtptime", &rtptime, "seq", &seq, NULL);
+
+  validate_buffer (1, "pts", 0 * GST_SECOND, "size", (gsize) 16,
+      "rtptime", rtptime, "seq", seq + 1, NULL);
+  validate_buffer (2, "pts", 1 * GST_SECOND,
+      "rtptime", rtptime + 1 * DEFAULT_CLOCK_RATE, "seq", seq + 2, NULL);
+  validate_buffer (3, "pts", 1 * GST_SECOND,
+      "rtptime", rtptime + 1 * DEFAULT_CLOCK_RATE, "seq", seq + 3, NULL);
+
+  /* header and payload are separate memories */
+  buf = GST_BUFFER (g_list_nth_data (buffers, 0));
+  fail_unless_equals_int (gst_buffer_n_memory (buf), 2);
+  fail_unless_equals_int (gst_buffer_get_sizes_range (buf, 0, 1, NULL, NULL),
+      12);
+
+  validate_events_received (3);
+
+  validate_normal_start_events (0);
+
+  destroy_payloader (state);
+}
+
+GST_END_TEST;
+
+/* the header memory of released packets is reused, but not when it was
+ * replaced by memory from somewhere else */
+GST_START_TEST (rtp_base_payload_region_header_reuse)
+{
+  GstRTPBasePayload *pay;
+  GstBuffer *buf;
+  GstMemory *mem, *foreign;
+
+  pay = gst_object_ref_sink (rtp_dummy_pay_new ());
+
+  buf = gst_rtp_base_payload_allocate_output_buffer_for_region (pay, NULL, 0,
+      0, 0);
+  mem = gst_memory_ref (gst_buffer_peek_memory (buf, 0));
+  gst_buffer_unref (buf);
+
+  buf = gst_rtp_base_payload_allocate_output_buffer_for_region (pay, NULL, 0,
+      0, 0);
+  fail_unless (gst_buffer_peek_memory (buf, 0) == mem);
+  gst_memory_unref (mem);
+
+  /* as large as the pool's own header memory */
+  foreign = gst_allocator_alloc (NULL, 12 + 15 * 4, NULL);
+  gst_buffer_replace_memory (buf, 0, gst_memory_ref (foreign));
+  gst_buffer_unref (buf);
+
+  buf = gst_rtp_base_payload_allocate_output_buffer_for_region (pay, NULL, 0,
+      0, 0);
+  fail_unless (gst_buffer_peek_memory (buf, 0) != foreign);
+  gst_buffer_unref (buf);
+  gst_memory_unref (foreign);
+
+  gst_object_unref (pay);
+}
+
+GST_END_TEST;
+
+/* the header extension space of packets that reference their payload is
+ * reserved when the packet is allocated and shrunk to what was written */
+GST_START_TEST (rtp_base_payload_region_hdr_ext)
+{
+  GstRTPHeaderExtension *ext;
+  State *state;
+  guint i;
+
+  state = create_payloader ("application/x-rtp", &sinktmpl, NULL);
+  GST_RTP_DUMMY_PAY (state->element)->split = TRUE;
+  ext = rtp_dummy_hdr_ext_new ();
+  GST_RTP_DUMMY_HDR_EXT (ext)->supported_flags =
+      GST_RTP_HEADER_EXTENSION_ONE_BYTE;
+  GST_RTP_DUMMY_HDR_EXT (ext)->max_size = 5;
+  gst_rtp_header_extension_set_id (ext, 1);
+
+  g_signal_emit_by_name (state->element, "add-extension", ext);
+
+  set_state (state, GST_STATE_PLAYING);
+
+  push_buffer (state, "pts", 0 * GST_SECOND, NULL);
+
+  set_state (state, GST_STATE_NULL);
+
+  validate_buffers_received (2);
+
+  for (i = 0; i < 2; i++) {
+    GstBuffer *buf = GST_BUFFER (g_list_nth_data (buffers, i));
+
+    validate_buffer (i, "pts", 0 * GST_SECOND, "size", (gsize) 24, "ext-data",
+        (guint) 0xBEDE, (gsize) 4, NULL);
+    fail_unless_equals_int (gst_buffer_n_memory (buf), 3);
+  }
+
+  validate_events_received (3);
+
+  validate_normal_start_events (0);
+
+  fail_unless_equals_int (GST_RTP_DUMMY_HDR_EXT (ext)->write_count, 2);
+  gst_object_unref (ext);
+
+  destroy_payloader (state);
+}
+
+GST_END_TEST;
+
 static Suite *
 rtp_basepayloading_suite (void)
 {
@@ -2358,6 +2514,9 @@ rtp_basepayloading_suite (void)
   tcase_add_test (tc_chain, rtp_base_payload_caps_request_ignored);
   tcase_add_test (tc_chain, rtp_base_payload_extensions_in_output_caps);
   tcase_add_test (tc_chain, rtp_base_payload_extensions_shrink_ext_data);
+  tcase_add_test (tc_chain, rtp_base_payload_queue_region_test);
+  tcase_add_test (tc_chain, rtp_base_payload_region_header_reuse);
+  tcase_add_test (tc_chain, rtp_base_payload_region_hdr_ext);
 
   return s;
 }
@@ -0,0 +1,271 @@
+/* GStreamer audio converter benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Compares the audio converter on conversions that mix channels and change
+ * the sample format against running the same steps one after the other on
+ * full size buffers, the way the generic conversion chain does it. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/audio/audio.h>
+
+#define DEFAULT_DURATION 0.5
+#define RATE 48000
+/* process 20ms per call, like a typical audioconvert buffer */
+#define BLOCK_MS 20
+
+static const struct
+{
+  GstAudioFormat in_format;
+  gint in_channels;
+  GstAudioFormat out_format;
+  gint out_channels;
+  GstAudioDitherMethod dither;
+} conversions[] = {
+  {GST_AUDIO_FORMAT_F32, 6, GST_AUDIO_FORMAT_S16, 2, GST_AUDIO_DITHER_NONE},
+  {GST_AUDIO_FORMAT_F32, 6, GST_AUDIO_FORMAT_S16, 2, GST_AUDIO_DITHER_TPDF},
+  {GST_AUDIO_FORMAT_F32, 8, GST_AUDIO_FORMAT_S16, 2, GST_AUDIO_DITHER_TPDF},
+  {GST_AUDIO_FORMAT_F64, 8, GST_AUDIO_FORMAT_S24, 6, GST_AUDIO_DITHER_NONE},
+  {GST_AUDIO_FORMAT_S32, 2, GST_AUDIO_FORMAT_F32, 6, GST_AUDIO_DITHER_NONE},
+  {GST_AUDIO_FORMAT_S32, 2, GST_AUDIO_FORMAT_F32, 8, GST_AUDIO_DITHER_NONE},
+};
+
+typedef struct
+{
+  GstAudioInfo in;
+  GstAudioInfo out;
+  GstAudioChannelMixer *mix;
+  GstAudioQuantize *quant;
+  gpointer unpacked;
+  gpointer mixed;
+  gpointer converted;
+} Staged;
+
+static void
+fill_noise (const GstAudioFormatInfo * finfo, gpointer data, gsize samples)
+{
+  gsize i;
+
+  switch (GST_AUDIO_FORMAT_INFO_FORMAT (finfo)) {
+    case GST_AUDIO_FORMAT_S32:
+      for (i = 0; i < samples; i++)
+        ((gint32 *) data)[i] = g_random_int_range (-(1 << 30), 1 << 30);
+      break;
+    case GST_AUDIO_FORMAT_F32:
+      for (i = 0; i < samples; i++)
+        ((gfloat *) data)[i] = g_random_double_range (-0.5, 0.5);
+      break;
+    case GST_AUDIO_FORMAT_F64:
+      for (i = 0; i < samples; i++)
+        ((gdouble *) data)[i] = g_random_double_range (-0.5, 0.5);
+      break;
+    default:
+      g_assert_not_reached ();
+  }
+}
+
+static Staged *
+staged_new (GstAudioInfo * in, GstAudioInfo * out,
+    GstAudioDitherMethod dither, gsize frames)
+{
+  Staged *s = g_new0 (Staged, 1);
+  gint depth;
+
+  s->in = *in;
+  s->out = *out;
+  s->mix = gst_audio_channel_mixer_new (0, GST_AUDIO_FORMAT_F64,
+      in->channels, in->position, out->channels, out->position);
+
+  depth = GST_AUDIO_INFO_DEPTH (out);
+  if (GST_AUDIO_INFO_IS_INTEGER (out) && depth < 32)
+    s->quant = gst_audio_quantize_new (dither, GST_AUDIO_NOISE_SHAPING_NONE,
+        0, GST_AUDIO_FORMAT_S32, out->channels, 1U << (32 - depth));
+
+  s->unpacked = g_malloc (frames * in->channels * sizeof (gdouble));
+  s->mixed = g_malloc (frames * out->channels * sizeof (gdouble));
+  s->converted = g_malloc (frames * out->channels * sizeof (gint32));
+
+  return s;
+}
+
+static void
+staged_free (Staged * s)
+{
+  gst_audio_channel_mixer_free (s->mix);
+  if (s->quant)
+    gst_audio_quantize_free (s->quant);
+  g_free (s->unpacked);
+  g_free (s->mixed);
+  g_free (s->converted);
+  g_free (s);
+}
+
+/* bytes of intermediate buffers written and read again per frame */
+static gsize
+staged_intermediate_bpf (Staged * s)
+{
+  gsize res = s->in.channels * sizeof (gdouble) +
+      s->out.channels * sizeof (gdouble);
+
+  if (GST_AUDIO_INFO_IS_INTEGER (&s->out))
+    res += s->out.channels * sizeof (gint32);
+
+  return res;
+}
+
+/* unpack, mix, convert, quantize and pack, each over the complete buffer */
+static void
+staged_process (Staged * s, gpointer in, gpointer out, gsize frames)
+{
+  gsize i, in_samples = frames * s->in.channels;
+  gsize out_samples = frames * s->out.channels;
+  gdouble *unpacked = s->unpacked, *mixed = s->mixed;
+  gint32 *converted = s->converted;
+  gpointer src[1], dst[1];
+
+  if (GST_AUDIO_INFO_IS_FLOAT (&s->in)) {
+    s->in.finfo->unpack_func (s->in.finfo, 0, unpacked, in, in_samples);
+  } else {
+    for (i = 0; i < in_samples; i++)
+      unpacked[i] = ((gint32 *) in)[i] / 2147483648.0;
+  }
+
+  src[0] = unpacked;
+  dst[0] = mixed;
+  gst_audio_channel_mixer_samples (s->mix, src, dst, frames);
+
+  if (GST_AUDIO_INFO_IS_FLOAT (&s->out)) {
+    s->out.finfo->pack_func (s->out.finfo, 0, mixed, out, out_samples);
+    return;
+  }
+
+  for (i = 0; i < out_samples; i++) {
+    gdouble v = mixed[i] * 2147483648.0;
+    converted[i] = CLAMP (v, G_MININT32, G_MAXINT32);
+  }
+  if (s->quant) {
+    src[0] = dst[0] = converted;
+    gst_audio_quantize_samples (s->quant, src, dst, frames);
+  }
+  s->out.finfo->pack_func (s->out.finfo, 0, converted, out, out_samples);
+}
+
+static void
+do_benchmark (GstAudioFormat in_format, gint in_channels,
+    GstAudioFormat out_format, gint out_channels, GstAudioDitherMethod dither,
+    gdouble max_duration)
+{
+  GstAudioInfo in_info, out_info;
+  GstAudioConverter *convert;
+  Staged *staged;
+  gsize frames, total_frames;
+  gpointer in[1], out[1];
+  gdouble elapsed, ns_converter, ns_staged;
+  GTimer *timer;
+
+  /* default channel positions */
+  gst_audio_info_set_format (&in_info, in_format, RATE, in_channels, NULL);
+  gst_audio_info_set_format (&out_info, out_format, RATE, out_channels, NULL);
+
+  convert = gst_audio_converter_new (GST_AUDIO_CONVERTER_FLAG_NONE, &in_info,
+      &out_info, gst_structure_new ("GstAudioConverter",
+          GST_AUDIO_CONVERTER_OPT_DITHER_METHOD, GST_TYPE_AUDIO_DITHER_METHOD,
+          dither, GST_AUDIO_CONVERTER_OPT_NOISE_SHAPING_METHOD,
+          GST_TYPE_AUDIO_NOISE_SHAPING_METHOD, GST_AUDIO_NOISE_SHAPING_NONE,
+          NULL));
+  g_assert (convert != NULL);
+
+  frames = RATE * BLOCK_MS / 1000;
+  staged = staged_new (&in_info, &out_info, dither, frames);
+
+  in[0] = g_malloc (frames * in_info.bpf);
+  out[0] = g_malloc (frames * out_info.bpf);
+  fill_noise (in_info.finfo, in[0], frames * in_channels);
+
+  timer = g_timer_new ();
+  total_frames = 0;
+  while (TRUE) {
+    gst_audio_converter_samples (convert, 0, in, frames, out, frames);
+    total_frames += frames;
+
+    elapsed = g_timer_elapsed (timer, NULL);
+    if (elapsed >= max_duration)
+      break;
+  }
+  ns_converter = elapsed * GST_SECOND / total_frames;
+
+  g_timer_start (timer);
+  total_frames = 0;
+  while (TRUE) {
+    staged_process (staged, in[0], out[0], frames);
+    total_frames += frames;
+
+    elapsed = g_timer_elapsed (timer, NULL);
+    if (elapsed >= max_duration)
+      break;
+  }
+  ns_staged = elapsed * GST_SECOND / total_frames;
+  g_timer_destroy (timer);
+
+  gst_println ("%-7s %d ch -> %-7s %d ch %-4s: converter %7.2f ns/frame, "
+      "staged %7.2f ns/frame (%" G_GSIZE_FORMAT " intermediate bytes/frame), "
+      "%.2fx", GST_AUDIO_INFO_NAME (&in_info), in_channels,
+      GST_AUDIO_INFO_NAME (&out_info), out_channels,
+      dither == GST_AUDIO_DITHER_NONE ? "" : "tpdf", ns_converter, ns_staged,
+      staged_intermediate_bpf (staged), ns_staged / ns_converter);
+
+  g_free (in[0]);
+  g_free (out[0]);
+  staged_free (staged);
+  gst_audio_converter_free (convert);
+}
+
+int
+main (int argc, char **argv)
+{
+  GError *err = NULL;
+  gdouble max_dur = DEFAULT_DURATION;
+  GOptionContext *ctx;
+  GOptionEntry options[] = {
+    {"duration", 'd', 0, G_OPTION_ARG_DOUBLE, &max_dur,
+        "Benchmark duration for each run (in seconds)", NULL},
+    {NULL}
+  };
+  guint i;
+
+  ctx = g_option_context_new ("");
+  g_option_context_add_main_entries (ctx, options, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", GST_STR_NULL (err->message));
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  for (i = 0; i < G_N_ELEMENTS (conversions); i++)
+    do_benchmark (conversions[i].in_format, conversions[i].in_channels,
+        conversions[i].out_format, conversions[i].out_channels,
+        conversions[i].dither, max_dur);
+
+  return 0;
+}
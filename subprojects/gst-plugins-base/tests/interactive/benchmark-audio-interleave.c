@@ -0,0 +1,180 @@
+/* GStreamer audio interleave benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Compares gst_audio_interleave_samples() and
+ * gst_audio_deinterleave_samples() against copying one channel at a time
+ * with a strided loop, like the interleave and deinterleave elements used
+ * to do. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include <gst/gst.h>
+#include <gst/audio/audio.h>
+
+#define DEFAULT_DURATION 0.5
+/* 20ms at 48kHz */
+#define FRAMES 960
+
+static const gint default_channels[] = { 2, 6, 8, 16, 64 };
+
+static const GstAudioFormat formats[] = {
+  GST_AUDIO_FORMAT_S8,
+  GST_AUDIO_FORMAT_S16,
+  GST_AUDIO_FORMAT_S24,
+  GST_AUDIO_FORMAT_F32,
+  GST_AUDIO_FORMAT_F64,
+};
+
+static void
+strided_interleave (gint bps, gint channels, gpointer in[], guint8 * out,
+    gsize frames)
+{
+  gint c;
+  gsize f;
+
+  for (c = 0; c < channels; c++) {
+    const guint8 *i = in[c];
+    guint8 *o = out + c * bps;
+
+    for (f = 0; f < frames; f++) {
+      memcpy (o, i, bps);
+      o += channels * bps;
+      i += bps;
+    }
+  }
+}
+
+static void
+strided_deinterleave (gint bps, gint channels, const guint8 * in,
+    gpointer out[], gsize frames)
+{
+  gint c;
+  gsize f;
+
+  for (c = 0; c < channels; c++) {
+    const guint8 *i = in + c * bps;
+    guint8 *o = out[c];
+
+    for (f = 0; f < frames; f++) {
+      memcpy (o, i, bps);
+      i += channels * bps;
+      o += bps;
+    }
+  }
+}
+
+static void
+do_benchmark (GstAudioFormat format, gint channels, gdouble max_duration)
+{
+  const GstAudioFormatInfo *finfo = gst_audio_format_get_info (format);
+  gint c, bps = GST_AUDIO_FORMAT_INFO_WIDTH (finfo) / 8;
+  gpointer planes[64];
+  guint8 *interleaved;
+  gsize i, total_frames;
+  gdouble elapsed, ns_strided_il, ns_il, ns_strided_dil, ns_dil;
+  GTimer *timer;
+
+  interleaved = g_malloc (FRAMES * channels * bps);
+  for (i = 0; i < FRAMES * channels * bps; i++)
+    interleaved[i] = g_random_int ();
+  for (c = 0; c < channels; c++)
+    planes[c] = g_malloc (FRAMES * bps);
+
+#define RUN(result, code)                                                     \
+  G_STMT_START {                                                              \
+    g_timer_start (timer);                                                    \
+    total_frames = 0;                                                         \
+    while (TRUE) {                                                            \
+      code;                                                                   \
+      total_frames += FRAMES;                                                 \
+      elapsed = g_timer_elapsed (timer, NULL);                                \
+      if (elapsed >= max_duration)                                            \
+        break;                                                                \
+    }                                                                         \
+    result = elapsed * GST_SECOND / total_frames;                             \
+  } G_STMT_END
+
+  timer = g_timer_new ();
+  RUN (ns_strided_dil, strided_deinterleave (bps, channels, interleaved,
+          planes, FRAMES));
+  RUN (ns_dil, gst_audio_deinterleave_samples (format, channels, interleaved,
+          planes, FRAMES));
+  RUN (ns_strided_il, strided_interleave (bps, channels, planes, interleaved,
+          FRAMES));
+  RUN (ns_il, gst_audio_interleave_samples (format, channels, planes,
+          interleaved, FRAMES));
+  g_timer_destroy (timer);
+#undef RUN
+
+  gst_println ("%-5s %2d ch: deinterleave %7.2f ns/frame (strided %7.2f, "
+      "%.2fx), interleave %7.2f ns/frame (strided %7.2f, %.2fx)",
+      GST_AUDIO_FORMAT_INFO_NAME (finfo), channels, ns_dil, ns_strided_dil,
+      ns_strided_dil / ns_dil, ns_il, ns_strided_il, ns_strided_il / ns_il);
+
+  for (c = 0; c < channels; c++)
+    g_free (planes[c]);
+  g_free (interleaved);
+}
+
+int
+main (int argc, char **argv)
+{
+  GError *err = NULL;
+  gint channels = 0;
+  gdouble max_dur = DEFAULT_DURATION;
+  GOptionContext *ctx;
+  GOptionEntry options[] = {
+    {"channels", 'c', 0, G_OPTION_ARG_INT, &channels,
+        "Number of channels, up to 64 (default: 2, 6, 8, 16 and 64)", NULL},
+    {"duration", 'd', 0, G_OPTION_ARG_DOUBLE, &max_dur,
+        "Benchmark duration for each run (in seconds)", NULL},
+    {NULL}
+  };
+  guint f, c;
+
+  ctx = g_option_context_new ("");
+  g_option_context_add_main_entries (ctx, options, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", GST_STR_NULL (err->message));
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  if (channels > 64) {
+    g_print ("At most 64 channels are supported\n");
+    return 1;
+  }
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    for (c = 0; c < G_N_ELEMENTS (default_channels); c++) {
+      do_benchmark (formats[f], channels > 0 ? channels : default_channels[c],
+          max_dur);
+      if (channels > 0)
+        break;
+    }
+  }
+
+  return 0;
+}
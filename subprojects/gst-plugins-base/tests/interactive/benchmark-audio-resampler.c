@@ -0,0 +1,199 @@
+/* GStreamer audio resampler benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/audio/audio.h>
+
+#define DEFAULT_DURATION 0.5
+/* process 100ms per call, like a typical audioresample buffer */
+#define BLOCK_MS 100
+
+static const gint default_channels[] = { 1, 2, 8, 64 };
+
+static const guint default_qualities[] = {
+  GST_AUDIO_RESAMPLER_QUALITY_MIN,
+  GST_AUDIO_RESAMPLER_QUALITY_DEFAULT,
+  GST_AUDIO_RESAMPLER_QUALITY_MAX,
+};
+
+static const struct
+{
+  gint in_rate;
+  gint out_rate;
+} rates[] = {
+  {48000, 44100},
+  {44100, 48000},
+  {48000, 96000},
+};
+
+static const GstAudioFormat formats[] = {
+  GST_AUDIO_FORMAT_S16,
+  GST_AUDIO_FORMAT_S32,
+  GST_AUDIO_FORMAT_F32,
+  GST_AUDIO_FORMAT_F64,
+};
+
+static void
+fill_noise (const GstAudioFormatInfo * finfo, gpointer data, gsize samples)
+{
+  gsize i;
+
+  switch (GST_AUDIO_FORMAT_INFO_FORMAT (finfo)) {
+    case GST_AUDIO_FORMAT_S16:
+      for (i = 0; i < samples; i++)
+        ((gint16 *) data)[i] = g_random_int_range (-16384, 16384);
+      break;
+    case GST_AUDIO_FORMAT_S32:
+      for (i = 0; i < samples; i++)
+        ((gint32 *) data)[i] = g_random_int_range (-(1 << 30), 1 << 30);
+      break;
+    case GST_AUDIO_FORMAT_F32:
+      for (i = 0; i < samples; i++)
+        ((gfloat *) data)[i] = g_random_double_range (-0.5, 0.5);
+      break;
+    case GST_AUDIO_FORMAT_F64:
+      for (i = 0; i < samples; i++)
+        ((gdouble *) data)[i] = g_random_double_range (-0.5, 0.5);
+      break;
+    default:
+      g_assert_not_reached ();
+  }
+}
+
+static void
+do_benchmark (GstAudioFormat format, gint channels, gint in_rate,
+    gint out_rate, guint quality, gdouble max_duration)
+{
+  const GstAudioFormatInfo *finfo = gst_audio_format_get_info (format);
+  GstAudioResampler *resampler;
+  GstStructure *options;
+  gsize in_frames, out_frames, total_frames = 0;
+  gpointer in[1], out[1];
+  gdouble elapsed, ns_per_frame;
+  GTimer *timer;
+  gint bpf = GST_AUDIO_FORMAT_INFO_WIDTH (finfo) / 8 * channels;
+
+  options = gst_structure_new_empty ("GstAudioResampler.options");
+  gst_audio_resampler_options_set_quality (GST_AUDIO_RESAMPLER_METHOD_KAISER,
+      quality, in_rate, out_rate, options);
+
+  resampler = gst_audio_resampler_new (GST_AUDIO_RESAMPLER_METHOD_KAISER,
+      GST_AUDIO_RESAMPLER_FLAG_NONE, format, channels, in_rate, out_rate,
+      options);
+  gst_structure_free (options);
+
+  in_frames = in_rate * BLOCK_MS / 1000;
+  out_frames = gst_audio_resampler_get_out_frames (resampler, in_frames);
+
+  in[0] = g_malloc (in_frames * bpf);
+  out[0] = g_malloc (out_frames * bpf);
+  fill_noise (finfo, in[0], in_frames * channels);
+
+  /* warmup, also fills the history */
+  gst_audio_resampler_resample (resampler, in, in_frames, out, out_frames);
+
+  timer = g_timer_new ();
+  while (TRUE) {
+    out_frames = gst_audio_resampler_get_out_frames (resampler, in_frames);
+    gst_audio_resampler_resample (resampler, in, in_frames, out, out_frames);
+    total_frames += out_frames;
+
+    elapsed = g_timer_elapsed (timer, NULL);
+    if (elapsed >= max_duration)
+      break;
+  }
+  g_timer_destroy (timer);
+
+  ns_per_frame = elapsed * GST_SECOND / total_frames;
+
+  gst_println ("%-4s %3d ch q%-2u %6d -> %6d: %9.2f ns/frame %8.2f ns/sample "
+      "%8.1fx realtime", GST_AUDIO_FORMAT_INFO_NAME (finfo), channels, quality,
+      in_rate, out_rate, ns_per_frame, ns_per_frame / channels,
+      (gdouble) total_frames / out_rate / elapsed);
+
+  g_free (in[0]);
+  g_free (out[0]);
+  gst_audio_resampler_free (resampler);
+}
+
+int
+main (int argc, char **argv)
+{
+  GError *err = NULL;
+  gint channels = 0;
+  gint quality = -1;
+  gdouble max_dur = DEFAULT_DURATION;
+  gchar *format = NULL;
+  GOptionContext *ctx;
+  GOptionEntry options[] = {
+    {"channels", 'c', 0, G_OPTION_ARG_INT, &channels,
+        "Number of channels (default: 1, 2, 8 and 64)", NULL},
+    {"quality", 'q', 0, G_OPTION_ARG_INT, &quality,
+        "Resampler quality 0-10 (default: 0, 4 and 10)", NULL},
+    {"format", 'f', 0, G_OPTION_ARG_STRING, &format,
+        "Sample format S16, S32, F32 or F64 (default: all)", NULL},
+    {"duration", 'd', 0, G_OPTION_ARG_DOUBLE, &max_dur,
+        "Benchmark duration for each run (in seconds)", NULL},
+    {NULL}
+  };
+  guint f, c, r, q;
+
+  ctx = g_option_context_new ("");
+  g_option_context_add_main_entries (ctx, options, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", GST_STR_NULL (err->message));
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    const GstAudioFormatInfo *finfo = gst_audio_format_get_info (formats[f]);
+
+    /* match both "S16" and the native endian "S16LE" names */
+    if (format != NULL &&
+        !g_str_has_prefix (GST_AUDIO_FORMAT_INFO_NAME (finfo), format))
+      continue;
+
+    for (c = 0; c < G_N_ELEMENTS (default_channels); c++) {
+      gint n_channels = channels > 0 ? channels : default_channels[c];
+
+      for (q = 0; q < G_N_ELEMENTS (default_qualities); q++) {
+        guint n_quality = quality >= 0 ? quality : default_qualities[q];
+
+        for (r = 0; r < G_N_ELEMENTS (rates); r++)
+          do_benchmark (formats[f], n_channels, rates[r].in_rate,
+              rates[r].out_rate, n_quality, max_dur);
+
+        if (quality >= 0)
+          break;
+      }
+      if (channels > 0)
+        break;
+    }
+  }
+
+  g_free (format);
+  return 0;
+}
@@ -0,0 +1,146 @@
+/* GStreamer FFT benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Times a forward and an inverse FFT of every power of two length, which
+ * uses the vectorized code where the CPU has it, and of the slightly
+ * shorter length 15/16 of it, which always uses the generic code. The time
+ * per N log2 N compares the two. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <math.h>
+
+#include <gst/gst.h>
+#include <gst/fft/gstfftf32.h>
+#include <gst/fft/gstfftf64.h>
+
+#define DEFAULT_DURATION 0.2
+#define MIN_BITS 6
+#define MAX_BITS 16
+
+static void
+report (const gchar * type, gint len, gdouble elapsed, guint64 runs)
+{
+  gdouble ns = elapsed * GST_SECOND / runs;
+
+  gst_println ("%s %6d: %11.1f ns %7.3f ns/(N log2 N)", type, len, ns,
+      ns / (len * log2 (len)));
+}
+
+static void
+do_benchmark_f32 (gint len, gdouble max_duration)
+{
+  GstFFTF32 *fft = gst_fft_f32_new (len, FALSE);
+  GstFFTF32 *ifft = gst_fft_f32_new (len, TRUE);
+  gfloat *data = g_new (gfloat, len);
+  GstFFTF32Complex *freq = g_new (GstFFTF32Complex, len / 2 + 1);
+  guint64 runs = 0;
+  gdouble elapsed;
+  GTimer *timer;
+  gint i;
+
+  for (i = 0; i < len; i++)
+    data[i] = g_random_double_range (-0.5, 0.5);
+
+  timer = g_timer_new ();
+  do {
+    gst_fft_f32_fft (fft, data, freq);
+    gst_fft_f32_inverse_fft (ifft, freq, data);
+    /* keep the values in range */
+    data[0] /= len;
+    runs++;
+  } while ((elapsed = g_timer_elapsed (timer, NULL)) < max_duration);
+  g_timer_destroy (timer);
+
+  report ("F32", len, elapsed, runs);
+
+  gst_fft_f32_free (fft);
+  gst_fft_f32_free (ifft);
+  g_free (data);
+  g_free (freq);
+}
+
+static void
+do_benchmark_f64 (gint len, gdouble max_duration)
+{
+  GstFFTF64 *fft = gst_fft_f64_new (len, FALSE);
+  GstFFTF64 *ifft = gst_fft_f64_new (len, TRUE);
+  gdouble *data = g_new (gdouble, len);
+  GstFFTF64Complex *freq = g_new (GstFFTF64Complex, len / 2 + 1);
+  guint64 runs = 0;
+  gdouble elapsed;
+  GTimer *timer;
+  gint i;
+
+  for (i = 0; i < len; i++)
+    data[i] = g_random_double_range (-0.5, 0.5);
+
+  timer = g_timer_new ();
+  do {
+    gst_fft_f64_fft (fft, data, freq);
+    gst_fft_f64_inverse_fft (ifft, freq, data);
+    data[0] /= len;
+    runs++;
+  } while ((elapsed = g_timer_elapsed (timer, NULL)) < max_duration);
+  g_timer_destroy (timer);
+
+  report ("F64", len, elapsed, runs);
+
+  gst_fft_f64_free (fft);
+  gst_fft_f64_free (ifft);
+  g_free (data);
+  g_free (freq);
+}
+
+int
+main (int argc, char **argv)
+{
+  GError *err = NULL;
+  gdouble max_dur = DEFAULT_DURATION;
+  GOptionContext *ctx;
+  GOptionEntry options[] = {
+    {"duration", 'd', 0, G_OPTION_ARG_DOUBLE, &max_dur,
+        "Benchmark duration for each length (in seconds)", NULL},
+    {NULL}
+  };
+  gint bits;
+
+  ctx = g_option_context_new ("");
+  g_option_context_add_main_entries (ctx, options, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", GST_STR_NULL (err->message));
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  for (bits = MIN_BITS; bits <= MAX_BITS; bits++) {
+    do_benchmark_f32 (1 << bits, max_dur);
+    do_benchmark_f32 ((1 << bits) / 16 * 15, max_dur);
+  }
+  for (bits = MIN_BITS; bits <= MAX_BITS; bits++) {
+    do_benchmark_f64 (1 << bits, max_dur);
+    do_benchmark_f64 ((1 << bits) / 16 * 15, max_dur);
+  }
+
+  return 0;
+}
@@ -50,11 +50,13 @@ enum
 {
   PROP_0 = 0,
   PROP_LOW_LATENCY,
-  PROP_DRAIN_ON_CHANGES
+  PROP_DRAIN_ON_CHANGES,
+  PROP_PARTITION_LENGTH
 };
 
 #define DEFAULT_LOW_LATENCY FALSE
 #define DEFAULT_DRAIN_ON_CHANGES TRUE
+#define DEFAULT_PARTITION_LENGTH 0
 
 #define gst_audio_fx_base_fir_filter_parent_class parent_class
 G_DEFINE_TYPE (GstAudioFXBaseFIRFilter, gst_audio_fx_base_fir_filter,
@@ -362,6 +364,172 @@ DEFINE_FFT_PROCESS_FUNC_FIXED_CHANNELS (64, 2, double);
 #undef DEFINE_FFT_PROCESS_FUNC
 #undef DEFINE_FFT_PROCESS_FUNC_FIXED_CHANNELS
 
+/* This implements uniformly partitioned FFT convolution, also using the
+ * overlap-save algorithm.
+ *
+ * The kernel is split into K partitions of length P and the spectrum of
+ * every partition, zero-padded to N = 2 * P, is calculated once. In every
+ * pass P new input samples are appended to the previous P input samples and
+ * the spectrum of these N samples is stored in a ring of the last K input
+ * spectra. The output is then
+ *
+ * y = IFFT (\sum_{k=0}^{K-1} X_{n-k} * H_k)
+ *
+ * of which only the last P samples are free of circular aliasing.
+ *
+ * Compared to the single FFT over the complete kernel above this only needs
+ * P samples of latency instead of about 3 * M, at the cost of K complex
+ * multiplications per frequency bin and pass:
+ *
+ *   ( 2 N log N + K N )
+ * O ( --------------- )
+ *   (        P        )
+ */
+#define DEFINE_PARTITIONED_PROCESS_FUNC(width,ctype) \
+static guint \
+process_partitioned_##width (GstAudioFXBaseFIRFilter * self, \
+    const g##ctype * src, g##ctype * dst, guint input_samples) \
+{ \
+  gint channels = GST_AUDIO_FILTER_CHANNELS (self); \
+  PARTITIONED_CONVOLUTION_BODY (channels); \
+}
+
+#define DEFINE_PARTITIONED_PROCESS_FUNC_FIXED_CHANNELS(width,channels,ctype) \
+static guint \
+process_partitioned_##channels##_##width (GstAudioFXBaseFIRFilter * self, \
+    const g##ctype * src, g##ctype * dst, guint input_samples) \
+{ \
+  PARTITIONED_CONVOLUTION_BODY (channels); \
+}
+
+#define PARTITIONED_CONVOLUTION_BODY(channels) G_STMT_START { \
+  gint i, j; \
+  guint k, pass; \
+  guint block_length = self->block_length; \
+  guint partition_length = block_length / 2; \
+  guint partitions = self->partitions; \
+  guint frequency_response_length = self->frequency_response_length; \
+  guint channel_length = 2 * block_length + \
+      2 * partitions * frequency_response_length; \
+  guint buffer_fill = self->buffer_fill; \
+  GstFFTF64 *fft = self->fft; \
+  GstFFTF64 *ifft = self->ifft; \
+  GstFFTF64Complex *frequency_response = self->frequency_response; \
+  GstFFTF64Complex *fft_buffer = self->fft_buffer; \
+  gdouble *buffer = self->buffer; \
+  guint generated = 0; \
+  \
+  if (!fft_buffer) \
+    self->fft_buffer = fft_buffer = \
+        g_new (GstFFTF64Complex, frequency_response_length); \
+  \
+  /* For every channel the buffer contains the previous and the current \
+   * partition of input samples, space for the inverse FFT and the \
+   * spectra of the last input blocks, one per kernel partition. \
+   */ \
+  if (!buffer) { \
+    self->buffer_length = block_length; \
+    self->buffer = buffer = g_new0 (gdouble, channel_length * channels); \
+    self->buffer_fill = buffer_fill = partition_length; \
+    self->partition_pos = 0; \
+  } \
+  \
+  g_assert (self->buffer_length == block_length); \
+  \
+  while (input_samples) { \
+    pass = MIN (block_length - buffer_fill, input_samples); \
+    \
+    /* Deinterleave channels */ \
+    for (i = 0; i < pass; i++) { \
+      for (j = 0; j < channels; j++) { \
+        buffer[channel_length * j + buffer_fill + i] = \
+            src[i * channels + j]; \
+      } \
+    } \
+    buffer_fill += pass; \
+    src += channels * pass; \
+    input_samples -= pass; \
+    \
+    /* If we don't have a complete partition go out */ \
+    if (buffer_fill < block_length) \
+      break; \
+    \
+    for (j = 0; j < channels; j++) { \
+      gdouble *samples = buffer + channel_length * j; \
+      GstFFTF64Complex *spectra = \
+          (GstFFTF64Complex *) (samples + 2 * block_length); \
+      \
+      /* Calculate FFT of the input block into the ring of spectra */ \
+      gst_fft_f64_fft (fft, samples, \
+          spectra + self->partition_pos * frequency_response_length); \
+      \
+      /* Multiply every kernel partition with the input spectrum that is \
+       * as many partitions old and accumulate */ \
+      memset (fft_buffer, 0, \
+          frequency_response_length * sizeof (GstFFTF64Complex)); \
+      for (k = 0; k < partitions; k++) { \
+        const GstFFTF64Complex *x = spectra + \
+            ((self->partition_pos + partitions - k) % partitions) * \
+            frequency_response_length; \
+        const GstFFTF64Complex *h = \
+            frequency_response + k * frequency_response_length; \
+        \
+        for (i = 0; i < frequency_response_length; i++) { \
+          fft_buffer[i].r += x[i].r * h[i].r - x[i].i * h[i].i; \
+          fft_buffer[i].i += x[i].r * h[i].i + x[i].i * h[i].r; \
+        } \
+      } \
+      \
+      /* Calculate inverse FFT of the result */ \
+      gst_fft_f64_inverse_fft (ifft, fft_buffer, samples + block_length); \
+      \
+      /* Copy the last partition_length samples to the output */ \
+      for (i = 0; i < partition_length; i++) { \
+        dst[i * channels + j] = \
+            samples[block_length + partition_length + i]; \
+      } \
+      \
+      /* The current input partition is the previous one of the next block */ \
+      memcpy (samples, samples + partition_length, \
+          partition_length * sizeof (gdouble)); \
+    } \
+    \
+    self->partition_pos = (self->partition_pos + 1) % partitions; \
+    generated += partition_length; \
+    dst += channels * partition_length; \
+    \
+    buffer_fill = partition_length; \
+  } \
+  \
+  /* Write back cached buffer_fill value */ \
+  self->buffer_fill = buffer_fill; \
+  \
+  return generated; \
+} G_STMT_END
+
+DEFINE_PARTITIONED_PROCESS_FUNC (32, float);
+DEFINE_PARTITIONED_PROCESS_FUNC (64, double);
+
+DEFINE_PARTITIONED_PROCESS_FUNC_FIXED_CHANNELS (32, 1, float);
+DEFINE_PARTITIONED_PROCESS_FUNC_FIXED_CHANNELS (64, 1, double);
+
+DEFINE_PARTITIONED_PROCESS_FUNC_FIXED_CHANNELS (32, 2, float);
+DEFINE_PARTITIONED_PROCESS_FUNC_FIXED_CHANNELS (64, 2, double);
+
+#undef PARTITIONED_CONVOLUTION_BODY
+#undef DEFINE_PARTITIONED_PROCESS_FUNC
+#undef DEFINE_PARTITIONED_PROCESS_FUNC_FIXED_CHANNELS
+
+/* Number of output samples generated per pass in FFT mode */
+static guint
+gst_audio_fx_base_fir_filter_get_block_output_length (GstAudioFXBaseFIRFilter *
+    self)
+{
+  if (self->partitions > 0)
+    return self->block_length / 2;
+  return self->block_length - self->kernel_length + 1;
+}
+
 /* Element class */
 static void
     gst_audio_fx_base_fir_filter_calculate_frequency_response
@@ -375,8 +543,51 @@ static void
   self->frequency_response_length = 0;
   g_free (self->fft_buffer);
   self->fft_buffer = NULL;
+  self->partitions = 0;
 
   if (self->kernel && self->kernel_length >= FFT_THRESHOLD
+      && !self->low_latency && self->partition_length > 0) {
+    guint block_length, frequency_response_length, i, k;
+    gdouble *kernel_tmp;
+
+    /* Blocks of two partitions, both halves must have the same length */
+    block_length = gst_fft_next_fast_length (2 * self->partition_length);
+    while (block_length % 2 != 0)
+      block_length = gst_fft_next_fast_length (block_length + 1);
+    self->block_length = block_length;
+    self->partitions =
+        (self->kernel_length + block_length / 2 - 1) / (block_length / 2);
+
+    GST_DEBUG_OBJECT (self, "using %u partitions of length %u",
+        self->partitions, block_length / 2);
+
+    self->fft = gst_fft_f64_new (block_length, FALSE);
+    self->ifft = gst_fft_f64_new (block_length, TRUE);
+    frequency_response_length = block_length / 2 + 1;
+    self->frequency_response_length = frequency_response_length;
+    self->frequency_response =
+        g_new (GstFFTF64Complex,
+        self->partitions * frequency_response_length);
+
+    kernel_tmp = g_new (gdouble, block_length);
+    for (k = 0; k < self->partitions; k++) {
+      GstFFTF64Complex *response =
+          self->frequency_response + k * frequency_response_length;
+      guint offset = k * (block_length / 2);
+      guint length = MIN (block_length / 2, self->kernel_length - offset);
+
+      memset (kernel_tmp, 0, block_length * sizeof (gdouble));
+      memcpy (kernel_tmp, self->kernel + offset, length * sizeof (gdouble));
+      gst_fft_f64_fft (self->fft, kernel_tmp, response);
+
+      /* Normalize to make sure IFFT(FFT(x)) == x */
+      for (i = 0; i < frequency_response_length; i++) {
+        response[i].r /= block_length;
+        response[i].i /= block_length;
+      }
+    }
+    g_free (kernel_tmp);
+  } else if (self->kernel && self->kernel_length >= FFT_THRESHOLD
       && !self->low_latency) {
     guint block_length, i;
     gdouble *kernel_tmp, *kernel = self->kernel;
@@ -412,7 +623,17 @@ gst_audio_fx_base_fir_filter_select_process_function (GstAudioFXBaseFIRFilter *
 {
   switch (format) {
     case GST_AUDIO_FORMAT_F32:
-      if (self->fft && !self->low_latency) {
+      if (self->fft && !self->low_latency && self->partitions > 0) {
+        if (channels == 1)
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc) process_partitioned_1_32;
+        else if (channels == 2)
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc) process_partitioned_2_32;
+        else
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc) process_partitioned_32;
+      } else if (self->fft && !self->low_latency) {
         if (channels == 1)
           self->process = (GstAudioFXBaseFIRFilterProcessFunc) process_fft_1_32;
         else if (channels == 2)
@@ -429,7 +650,17 @@ gst_audio_fx_base_fir_filter_select_process_function (GstAudioFXBaseFIRFilter *
       }
       break;
     case GST_AUDIO_FORMAT_F64:
-      if (self->fft && !self->low_latency) {
+      if (self->fft && !self->low_latency && self->partitions > 0) {
+        if (channels == 1)
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc) process_partitioned_1_64;
+        else if (channels == 2)
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc) process_partitioned_2_64;
+        else
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc) process_partitioned_64;
+      } else if (self->fft && !self->low_latency) {
         if (channels == 1)
           self->process = (GstAudioFXBaseFIRFilterProcessFunc) process_fft_1_64;
         else if (channels == 2)
@@ -502,6 +733,27 @@ gst_audio_fx_base_fir_filter_set_property (GObject * object, guint prop_id,
       g_mutex_unlock (&self->lock);
       break;
     }
+    case PROP_PARTITION_LENGTH:{
+      guint partition_length;
+
+      if (GST_STATE (self) >= GST_STATE_PAUSED) {
+        g_warning ("Changing the \"partition-length\" property "
+            "is only allowed in states < PAUSED");
+        return;
+      }
+
+      g_mutex_lock (&self->lock);
+      partition_length = g_value_get_uint (value);
+
+      if (self->partition_length != partition_length) {
+        self->partition_length = partition_length;
+        gst_audio_fx_base_fir_filter_calculate_frequency_response (self);
+        gst_audio_fx_base_fir_filter_select_process_function (self,
+            GST_AUDIO_FILTER_FORMAT (self), GST_AUDIO_FILTER_CHANNELS (self));
+      }
+      g_mutex_unlock (&self->lock);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -521,6 +773,9 @@ gst_audio_fx_base_fir_filter_get_property (GObject * object, guint prop_id,
     case PROP_DRAIN_ON_CHANGES:
       g_value_set_boolean (value, self->drain_on_changes);
       break;
+    case PROP_PARTITION_LENGTH:
+      g_value_set_uint (value, self->partition_length);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -569,6 +824,27 @@ gst_audio_fx_base_fir_filter_class_init (GstAudioFXBaseFIRFilterClass * klass)
           DEFAULT_DRAIN_ON_CHANGES,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioFXBaseFIRFilter:partition-length:
+   *
+   * Split long filter kernels into partitions of this many samples and
+   * convolve them with the input separately. The latency is then only the
+   * partition length instead of a multiple of the kernel length, at the
+   * cost of more processing. 0 disables partitioning. Powers of two are
+   * processed fastest.
+   *
+   * Has no effect in low-latency mode or for short kernels.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_PARTITION_LENGTH,
+      g_param_spec_uint ("partition-length", "Partition length",
+          "Length of the kernel partitions for FFT convolution, "
+          "0 for no partitioning. "
+          "Can only be changed in states < PAUSED!", 0, G_MAXINT / 4,
+          DEFAULT_PARTITION_LENGTH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   caps = gst_caps_from_string (ALLOWED_CAPS);
   gst_audio_filter_class_add_pad_templates (GST_AUDIO_FILTER_CLASS (klass),
       caps);
@@ -602,6 +878,7 @@ gst_audio_fx_base_fir_filter_init (GstAudioFXBaseFIRFilter * self)
 
   self->low_latency = DEFAULT_LOW_LATENCY;
   self->drain_on_changes = DEFAULT_DRAIN_ON_CHANGES;
+  self->partition_length = DEFAULT_PARTITION_LENGTH;
 
   g_mutex_init (&self->lock);
 }
@@ -677,8 +954,8 @@ gst_audio_fx_base_fir_filter_push_residue (GstAudioFXBaseFIRFilter * self)
       step_gensamples = self->process (self, zeroes, out, step_insamples);
       g_free (zeroes);
 
-      memcpy (map.data + gensamples * bps, out, MIN (step_gensamples,
-              outsamples - gensamples) * bps);
+      memcpy (map.data + gensamples * channels * bps, out,
+          MIN (step_gensamples, outsamples - gensamples) * channels * bps);
       gensamples += MIN (step_gensamples, outsamples - gensamples);
 
       g_free (out);
@@ -777,7 +1054,7 @@ gst_audio_fx_base_fir_filter_transform_size (GstBaseTransform * base,
   bpf = GST_AUDIO_INFO_BPF (&info);
 
   size /= bpf;
-  blocklen = self->block_length - self->kernel_length + 1;
+  blocklen = gst_audio_fx_base_fir_filter_get_block_output_length (self);
   *othersize = ((size + blocklen - 1) / blocklen) * blocklen;
   *othersize *= bpf;
 
@@ -973,7 +1250,7 @@ gst_audio_fx_base_fir_filter_query (GstBaseTransform * trans,
             GST_TIME_ARGS (min), GST_TIME_ARGS (max));
 
         if (self->fft && !self->low_latency)
-          latency = self->block_length - self->kernel_length + 1;
+          latency = gst_audio_fx_base_fir_filter_get_block_output_length (self);
         else
           latency = self->latency;
 
@@ -1030,7 +1307,7 @@ gst_audio_fx_base_fir_filter_set_kernel (GstAudioFXBaseFIRFilter * self,
     gdouble * kernel, guint kernel_length, guint64 latency,
     const GstAudioInfo * info)
 {
-  gboolean latency_changed;
+  gboolean latency_changed, buffer_changed;
   GstAudioFormat format;
   gint channels;
 
@@ -1045,9 +1322,14 @@ gst_audio_fx_base_fir_filter_set_kernel (GstAudioFXBaseFIRFilter * self,
       || (!self->low_latency && self->kernel_length >= FFT_THRESHOLD
           && kernel_length < FFT_THRESHOLD));
 
+  /* In partitioned mode the buffer has space for the input spectra of
+   * every kernel partition */
+  buffer_changed = latency_changed || (self->partitions > 0
+      && self->kernel_length != kernel_length);
+
   /* FIXME: If the latency changes, the buffer size changes too and we
    * have to drain in any case until this is fixed in the future */
-  if (self->buffer && (!self->drain_on_changes || latency_changed)) {
+  if (self->buffer && (!self->drain_on_changes || buffer_changed)) {
     gst_audio_fx_base_fir_filter_push_residue (self);
     self->start_ts = GST_CLOCK_TIME_NONE;
     self->start_off = GST_BUFFER_OFFSET_NONE;
@@ -1057,7 +1339,7 @@ gst_audio_fx_base_fir_filter_set_kernel (GstAudioFXBaseFIRFilter * self,
   }
 
   g_free (self->kernel);
-  if (!self->drain_on_changes || latency_changed) {
+  if (!self->drain_on_changes || buffer_changed) {
     g_free (self->buffer);
     self->buffer = NULL;
     self->buffer_fill = 0;
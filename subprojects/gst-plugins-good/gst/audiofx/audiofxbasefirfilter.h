@@ -61,6 +61,8 @@ struct _GstAudioFXBaseFIRFilter {
 
   guint64 latency;              /* pre-latency of the filter kernel */
   gboolean low_latency;         /* work in slower low latency mode */
+  guint partition_length;       /* length of the kernel partitions, 0 for
+                                 * a single FFT over the complete kernel */
 
   gboolean drain_on_changes;    /* If the filter should be drained when
                                  * coefficients change */
@@ -79,6 +81,8 @@ struct _GstAudioFXBaseFIRFilter {
   guint frequency_response_length;       /* length of filter kernel -- frequency domain */
   GstFFTF64Complex *fft_buffer;          /* FFT buffer, has the length of the frequency response */
   guint block_length;                    /* Length of the processing blocks -- time domain */
+  guint partitions;                      /* Number of kernel partitions, 0 if not partitioned */
+  guint partition_pos;                   /* Partition of the newest input spectrum */
 
   GstClockTime start_ts;        /* start timestamp after a discont */
   guint64 start_off;            /* start offset after a discont */
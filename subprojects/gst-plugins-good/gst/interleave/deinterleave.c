@@ -86,35 +86,6 @@ static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
         "rate = (int) [ 1, MAX ], "
         "channels = (int) [ 1, MAX ], layout = (string) interleaved"));
 
-#define MAKE_FUNC(type) \
-static void deinterleave_##type (guint##type *out, guint##type *in, \
-    guint stride, guint nframes) \
-{ \
-  gint i; \
-  \
-  for (i = 0; i < nframes; i++) { \
-    out[i] = *in; \
-    in += stride; \
-  } \
-}
-
-MAKE_FUNC (8);
-MAKE_FUNC (16);
-MAKE_FUNC (32);
-MAKE_FUNC (64);
-
-static void
-deinterleave_24 (guint8 * out, guint8 * in, guint stride, guint nframes)
-{
-  gint i;
-
-  for (i = 0; i < nframes; i++) {
-    memcpy (out, in, 3);
-    out += 3;
-    in += stride * 3;
-  }
-}
-
 #define gst_deinterleave_parent_class parent_class
 G_DEFINE_TYPE (GstDeinterleave, gst_deinterleave, GST_TYPE_ELEMENT);
 GST_ELEMENT_REGISTER_DEFINE (deinterleave, "deinterleave",
@@ -206,7 +177,7 @@ static void
 gst_deinterleave_init (GstDeinterleave * self)
 {
   self->keep_positions = FALSE;
-  self->func = NULL;
+  self->format = GST_AUDIO_FORMAT_UNKNOWN;
   gst_audio_info_init (&self->audio_info);
 
   /* Add sink pad */
@@ -336,31 +307,6 @@ gst_deinterleave_remove_pads (GstDeinterleave * self)
   gst_caps_replace (&self->sinkcaps, NULL);
 }
 
-static gboolean
-gst_deinterleave_set_process_function (GstDeinterleave * self)
-{
-  switch (GST_AUDIO_INFO_WIDTH (&self->audio_info)) {
-    case 8:
-      self->func = (GstDeinterleaveFunc) deinterleave_8;
-      break;
-    case 16:
-      self->func = (GstDeinterleaveFunc) deinterleave_16;
-      break;
-    case 24:
-      self->func = (GstDeinterleaveFunc) deinterleave_24;
-      break;
-    case 32:
-      self->func = (GstDeinterleaveFunc) deinterleave_32;
-      break;
-    case 64:
-      self->func = (GstDeinterleaveFunc) deinterleave_64;
-      break;
-    default:
-      return FALSE;
-  }
-  return TRUE;
-}
-
 static gboolean
 gst_deinterleave_check_caps_change (GstDeinterleave * self,
     GstAudioInfo * old_info, GstAudioInfo * new_info)
@@ -432,8 +378,7 @@ gst_deinterleave_sink_setcaps (GstDeinterleave * self, GstCaps * caps)
   if (!gst_audio_info_from_caps (&self->audio_info, caps))
     goto invalid_caps;
 
-  if (!gst_deinterleave_set_process_function (self))
-    goto unsupported_caps;
+  self->format = GST_AUDIO_INFO_FORMAT (&self->audio_info);
 
   if (self->sinkcaps && !gst_caps_is_equal (caps, self->sinkcaps)) {
     GstAudioInfo old_info;
@@ -442,10 +387,8 @@ gst_deinterleave_sink_setcaps (GstDeinterleave * self, GstCaps * caps)
     if (!gst_audio_info_from_caps (&old_info, self->sinkcaps))
       goto info_from_caps_failed;
 
-    if (gst_deinterleave_check_caps_change (self, &old_info, &self->audio_info)) {
-      if (!gst_deinterleave_set_process_function (self))
-        goto cannot_change_caps;
-    } else
+    if (!gst_deinterleave_check_caps_change (self, &old_info,
+            &self->audio_info))
       goto cannot_change_caps;
 
   }
@@ -478,11 +421,6 @@ cannot_change_caps:
         "positions change", self->sinkcaps, caps);
     return FALSE;
   }
-unsupported_caps:
-  {
-    GST_ERROR_OBJECT (self, "caps not supported: %" GST_PTR_FORMAT, caps);
-    return FALSE;
-  }
 invalid_caps:
   {
     GST_ERROR_OBJECT (self, "invalid caps");
@@ -841,7 +779,8 @@ gst_deinterleave_process (GstDeinterleave * self, GstBuffer * buf)
   guint i;
   GList *srcs;
   GstBuffer **buffers_out = g_new0 (GstBuffer *, channels);
-  guint8 *in, *out;
+  GstMapInfo *write_info = g_new0 (GstMapInfo, channels);
+  gpointer *planes = g_new0 (gpointer, channels);
   GstMapInfo read_info;
   GList *pending_events, *l;
 
@@ -893,19 +832,24 @@ gst_deinterleave_process (GstDeinterleave * self, GstBuffer * buf)
     goto done;
   }
 
-  /* deinterleave */
+  /* deinterleave all channels in one go */
+  for (i = 0; i < channels; i++) {
+    if (buffers_out[i]) {
+      gst_buffer_map (buffers_out[i], &write_info[i], GST_MAP_WRITE);
+      planes[i] = write_info[i].data;
+    }
+  }
+  gst_audio_deinterleave_samples (self->format, channels, read_info.data,
+      planes, nframes);
+  for (i = 0; i < channels; i++) {
+    if (buffers_out[i])
+      gst_buffer_unmap (buffers_out[i], &write_info[i]);
+  }
+
   for (srcs = self->srcpads, i = 0; srcs; srcs = srcs->next, i++) {
     GstPad *pad = (GstPad *) srcs->data;
-    GstMapInfo write_info;
 
-    in = (guint8 *) read_info.data;
-    in += i * (GST_AUDIO_INFO_WIDTH (&self->audio_info) / 8);
     if (buffers_out[i]) {
-      gst_buffer_map (buffers_out[i], &write_info, GST_MAP_WRITE);
-      out = (guint8 *) write_info.data;
-      self->func (out, in, channels, nframes);
-      gst_buffer_unmap (buffers_out[i], &write_info);
-
       ret = gst_pad_push (pad, buffers_out[i]);
       buffers_out[i] = NULL;
       if (ret == GST_FLOW_OK)
@@ -927,6 +871,8 @@ done:
   gst_buffer_unmap (buf, &read_info);
   gst_buffer_unref (buf);
   g_free (buffers_out);
+  g_free (write_info);
+  g_free (planes);
   return ret;
 
 alloc_buffer_failed:
@@ -955,6 +901,8 @@ clean_buffers:
     }
     gst_buffer_unref (buf);
     g_free (buffers_out);
+    g_free (write_info);
+    g_free (planes);
     return ret;
   }
 }
@@ -965,7 +913,8 @@ gst_deinterleave_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
   GstDeinterleave *self = GST_DEINTERLEAVE (parent);
   GstFlowReturn ret;
 
-  g_return_val_if_fail (self->func != NULL, GST_FLOW_NOT_NEGOTIATED);
+  g_return_val_if_fail (self->format != GST_AUDIO_FORMAT_UNKNOWN,
+      GST_FLOW_NOT_NEGOTIATED);
   g_return_val_if_fail (GST_AUDIO_INFO_WIDTH (&self->audio_info) > 0,
       GST_FLOW_NOT_NEGOTIATED);
   g_return_val_if_fail (GST_AUDIO_INFO_CHANNELS (&self->audio_info) > 0,
@@ -991,7 +940,7 @@ gst_deinterleave_change_state (GstElement * element, GstStateChange transition)
     case GST_STATE_CHANGE_READY_TO_PAUSED:
       gst_deinterleave_remove_pads (self);
 
-      self->func = NULL;
+      self->format = GST_AUDIO_FORMAT_UNKNOWN;
 
       if (self->pending_events) {
         g_list_foreach (self->pending_events, (GFunc) gst_mini_object_unref,
@@ -1014,7 +963,7 @@ gst_deinterleave_change_state (GstElement * element, GstStateChange transition)
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_deinterleave_remove_pads (self);
 
-      self->func = NULL;
+      self->format = GST_AUDIO_FORMAT_UNKNOWN;
 
       if (self->pending_events) {
         g_list_foreach (self->pending_events, (GFunc) gst_mini_object_unref,
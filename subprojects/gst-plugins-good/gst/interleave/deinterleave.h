@@ -42,8 +42,6 @@ G_BEGIN_DECLS
 typedef struct _GstDeinterleave GstDeinterleave;
 typedef struct _GstDeinterleaveClass GstDeinterleaveClass;
 
-typedef void (*GstDeinterleaveFunc) (gpointer out, gpointer in, guint stride, guint nframes);
-
 struct _GstDeinterleave
 {
   GstElement element;
@@ -56,7 +54,7 @@ struct _GstDeinterleave
 
   GstPad *sink;
 
-  GstDeinterleaveFunc func;
+  GstAudioFormat format;
 
   GList *pending_events;
 };
@@ -99,35 +99,6 @@ static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
         "layout = (string) interleaved")
     );
 
-#define MAKE_FUNC(type) \
-static void interleave_##type (guint##type *out, guint##type *in, \
-    guint stride, guint nframes) \
-{ \
-  gint i; \
-  \
-  for (i = 0; i < nframes; i++) { \
-    *out = in[i]; \
-    out += stride; \
-  } \
-}
-
-MAKE_FUNC (8);
-MAKE_FUNC (16);
-MAKE_FUNC (32);
-MAKE_FUNC (64);
-
-static void
-interleave_24 (guint8 * out, guint8 * in, guint stride, guint nframes)
-{
-  gint i;
-
-  for (i = 0; i < nframes; i++) {
-    memcpy (out, in, 3);
-    out += stride * 3;
-    in += 3;
-  }
-}
-
 typedef struct
 {
   GstPad parent;
@@ -771,31 +742,6 @@ gst_interleave_sink_getcaps (GstPad * pad, GstInterleave * self,
   return result;
 }
 
-static void
-gst_interleave_set_process_function (GstInterleave * self)
-{
-  switch (self->width) {
-    case 8:
-      self->func = (GstInterleaveFunc) interleave_8;
-      break;
-    case 16:
-      self->func = (GstInterleaveFunc) interleave_16;
-      break;
-    case 24:
-      self->func = (GstInterleaveFunc) interleave_24;
-      break;
-    case 32:
-      self->func = (GstInterleaveFunc) interleave_32;
-      break;
-    case 64:
-      self->func = (GstInterleaveFunc) interleave_64;
-      break;
-    default:
-      g_assert_not_reached ();
-      break;
-  }
-}
-
 static gboolean
 gst_interleave_sink_setcaps (GstInterleave * self, GstPad * pad,
     const GstCaps * caps, const GstAudioInfo * info)
@@ -812,8 +758,7 @@ gst_interleave_sink_setcaps (GstInterleave * self, GstPad * pad,
 
     self->width = GST_AUDIO_INFO_WIDTH (info);
     self->rate = GST_AUDIO_INFO_RATE (info);
-
-    gst_interleave_set_process_function (self);
+    self->format = GST_AUDIO_INFO_FORMAT (info);
 
     srccaps = gst_caps_copy (caps);
     s = gst_caps_get_structure (srccaps, 0);
@@ -1178,6 +1123,10 @@ gst_interleave_collected (GstCollectPads * pads, GstInterleave * self)
   GSList *collected;
   guint nsamples;
   guint ncollected = 0;
+  gint i, nplanes = 0;
+  GstBuffer **inbufs;
+  GstMapInfo *in_info;
+  gpointer *planes;
   gboolean empty = TRUE;
   gint width = self->width / 8;
   GstMapInfo write_info;
@@ -1187,7 +1136,8 @@ gst_interleave_collected (GstCollectPads * pads, GstInterleave * self)
   if (size == 0)
     goto eos;
 
-  g_return_val_if_fail (self->func != NULL, GST_FLOW_NOT_NEGOTIATED);
+  g_return_val_if_fail (self->format != GST_AUDIO_FORMAT_UNKNOWN,
+      GST_FLOW_NOT_NEGOTIATED);
   g_return_val_if_fail (self->width > 0, GST_FLOW_NOT_NEGOTIATED);
   g_return_val_if_fail (self->channels > 0, GST_FLOW_NOT_NEGOTIATED);
   g_return_val_if_fail (self->rate > 0, GST_FLOW_NOT_NEGOTIATED);
@@ -1207,13 +1157,14 @@ gst_interleave_collected (GstCollectPads * pads, GstInterleave * self)
   }
 
   gst_buffer_map (outbuf, &write_info, GST_MAP_WRITE);
-  memset (write_info.data, 0, size * self->channels);
+
+  inbufs = g_new0 (GstBuffer *, self->channels);
+  in_info = g_new0 (GstMapInfo, self->channels);
+  planes = g_new0 (gpointer, self->channels);
 
   for (collected = pads->data; collected != NULL; collected = collected->next) {
     GstCollectData *cdata;
     GstBuffer *inbuf;
-    guint8 *outdata;
-    GstMapInfo input_info;
     gint channel;
 
     cdata = (GstCollectData *) collected->data;
@@ -1221,31 +1172,47 @@ gst_interleave_collected (GstCollectPads * pads, GstInterleave * self)
     inbuf = gst_collect_pads_take_buffer (pads, cdata, size);
     if (inbuf == NULL) {
       GST_DEBUG_OBJECT (cdata->pad, "No buffer available");
-      goto next;
+      continue;
     }
     ncollected++;
 
     if (timestamp == -1)
       timestamp = GST_BUFFER_TIMESTAMP (inbuf);
 
-    if (GST_BUFFER_FLAG_IS_SET (inbuf, GST_BUFFER_FLAG_GAP))
-      goto next;
+    if (GST_BUFFER_FLAG_IS_SET (inbuf, GST_BUFFER_FLAG_GAP)) {
+      gst_buffer_unref (inbuf);
+      continue;
+    }
 
-    empty = FALSE;
     channel = GST_INTERLEAVE_PAD_CAST (cdata->pad)->channel;
     if (self->channels <= 64 && self->channel_mask) {
       channel = self->default_channels_ordering_map[channel];
     }
-    outdata = write_info.data + width * channel;
 
-    gst_buffer_map (inbuf, &input_info, GST_MAP_READ);
-    self->func (outdata, input_info.data, self->channels, nsamples);
-    gst_buffer_unmap (inbuf, &input_info);
+    gst_buffer_map (inbuf, &in_info[channel], GST_MAP_READ);
+    planes[channel] = in_info[channel].data;
+    inbufs[channel] = inbuf;
+    nplanes++;
+  }
 
-  next:
-    if (inbuf)
-      gst_buffer_unref (inbuf);
+  /* interleave all channels in one go, channels without data stay silent */
+  if (nplanes < self->channels)
+    memset (write_info.data, 0, size * self->channels);
+  if (nplanes > 0) {
+    empty = FALSE;
+    gst_audio_interleave_samples (self->format, self->channels, planes,
+        write_info.data, nsamples);
+  }
+
+  for (i = 0; i < self->channels; i++) {
+    if (inbufs[i]) {
+      gst_buffer_unmap (inbufs[i], &in_info[i]);
+      gst_buffer_unref (inbufs[i]);
+    }
   }
+  g_free (inbufs);
+  g_free (in_info);
+  g_free (planes);
 
   if (ncollected == 0) {
     gst_buffer_unmap (outbuf, &write_info);
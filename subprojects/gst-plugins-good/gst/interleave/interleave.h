@@ -28,6 +28,7 @@
 
 #include <gst/gst.h>
 #include <gst/base/gstcollectpads.h>
+#include <gst/audio/audio.h>
 
 G_BEGIN_DECLS
 
@@ -42,8 +43,6 @@ G_BEGIN_DECLS
 typedef struct _GstInterleave GstInterleave;
 typedef struct _GstInterleaveClass GstInterleaveClass;
 
-typedef void (*GstInterleaveFunc) (gpointer out, gpointer in, guint stride, guint nframes);
-
 struct _GstInterleave
 {
   GstElement element;
@@ -55,6 +54,7 @@ struct _GstInterleave
   gint padcounter;
   gint rate;
   gint width;
+  GstAudioFormat format;
 
   GValueArray *channel_positions;
   GValueArray *input_channel_positions;
@@ -71,8 +71,6 @@ struct _GstInterleave
 
   GstEvent *pending_segment;
 
-  GstInterleaveFunc func;
-
   GstPad *src;
 
   gboolean send_stream_start;
@@ -216,6 +216,7 @@ static void
 gst_level_init (GstLevel * filter)
 {
   filter->CS = NULL;
+  filter->block_CS = NULL;
   filter->peak = NULL;
   filter->last_peak = NULL;
   filter->decay_peak = NULL;
@@ -242,6 +243,7 @@ gst_level_finalize (GObject * obj)
   GstLevel *filter = GST_LEVEL (obj);
 
   g_free (filter->CS);
+  g_free (filter->block_CS);
   g_free (filter->peak);
   g_free (filter->last_peak);
   g_free (filter->decay_peak);
@@ -249,6 +251,7 @@ gst_level_finalize (GObject * obj)
   g_free (filter->decay_peak_age);
 
   filter->CS = NULL;
+  filter->block_CS = NULL;
   filter->peak = NULL;
   filter->last_peak = NULL;
   filter->decay_peak = NULL;
@@ -334,90 +337,72 @@ gst_level_get_property (GObject * object, guint prop_id,
 }
 
 
-/* process one (interleaved) channel of incoming samples
- * calculate square sum of samples
+/* process all channels of a block of interleaved samples in one pass
+ * calculate square sum of samples for each channel
  * normalize and average over number of samples
- * returns a normalized cumulative square value, which can be averaged
+ * returns normalized cumulative square values, which can be averaged
  * to return the average power as a double between 0 and 1
- * also returns the normalized peak power (square of the highest amplitude)
+ * also returns the normalized peak powers (square of the highest amplitude)
  *
- * caller must assure num is a multiple of channels
- * samples for multiple channels are interleaved
+ * NCS and NPS must hold one value per channel
  * input sample data enters in *in_data and is not modified
  * this filter only accepts signed audio data, so mid level is always 0
  *
+ * the inner loop goes over the channels of a frame and keeps one
+ * accumulator per channel, so the compiler can vectorize it and the
+ * data is only read once however many channels there are
+ *
  * for integers, this code considers the non-existent positive max value to be
  * full-scale; so max-1 will not map to 1.0
  */
 
-#define DEFINE_INT_LEVEL_CALCULATOR(TYPE, RESOLUTION)                         \
+#define DEFINE_LEVEL_CALCULATOR(TYPE, NORMALIZER)                             \
 static void inline                                                            \
-gst_level_calculate_##TYPE (gpointer data, guint num, guint channels,         \
+gst_level_calculate_##TYPE (gpointer data, guint num_frames, guint channels,  \
                             gdouble *NCS, gdouble *NPS)                       \
 {                                                                             \
   TYPE * in = (TYPE *)data;                                                   \
-  register guint j;                                                           \
-  gdouble squaresum = 0.0;           /* square sum of the input samples */    \
-  register gdouble square = 0.0;     /* Square */                             \
-  register gdouble peaksquare = 0.0; /* Peak Square Sample */                 \
-  gdouble normalizer;                /* divisor to get a [-1.0, 1.0] range */ \
+  guint i, c;                                                                 \
+  gdouble normalizer = (NORMALIZER);  /* divisor to get a [-1.0, 1.0] range */\
                                                                               \
-  /* *NCS = 0.0; Normalized Cumulative Square */                              \
-  /* *NPS = 0.0; Normalized Peak Square */                                    \
+  for (c = 0; c < channels; c++)                                              \
+    NCS[c] = NPS[c] = 0.0;                                                    \
                                                                               \
-  for (j = 0; j < num; j += channels) {                                       \
-    square = ((gdouble) in[j]) * in[j];                                       \
-    if (square > peaksquare) peaksquare = square;                             \
-    squaresum += square;                                                      \
-  }                                                                           \
+  if (channels == 1) {                                                        \
+    gdouble squaresum = 0.0, peaksquare = 0.0;                                \
                                                                               \
-  normalizer = (gdouble) (G_GINT64_CONSTANT(1) << (RESOLUTION * 2));          \
-  *NCS = squaresum / normalizer;                                              \
-  *NPS = peaksquare / normalizer;                                             \
-}
-
-DEFINE_INT_LEVEL_CALCULATOR (gint32, 31);
-DEFINE_INT_LEVEL_CALCULATOR (gint16, 15);
-DEFINE_INT_LEVEL_CALCULATOR (gint8, 7);
-
-/* FIXME: use orc to calculate squaresums? */
-#define DEFINE_FLOAT_LEVEL_CALCULATOR(TYPE)                                   \
-static void inline                                                            \
-gst_level_calculate_##TYPE (gpointer data, guint num, guint channels,         \
-                            gdouble *NCS, gdouble *NPS)                       \
-{                                                                             \
-  TYPE * in = (TYPE *)data;                                                   \
-  register guint j;                                                           \
-  gdouble squaresum = 0.0;           /* square sum of the input samples */    \
-  register gdouble square = 0.0;     /* Square */                             \
-  register gdouble peaksquare = 0.0; /* Peak Square Sample */                 \
+    for (i = 0; i < num_frames; i++) {                                        \
+      gdouble square = ((gdouble) in[i]) * in[i];                             \
                                                                               \
-  /* *NCS = 0.0; Normalized Cumulative Square */                              \
-  /* *NPS = 0.0; Normalized Peak Square */                                    \
+      peaksquare = MAX (peaksquare, square);                                  \
+      squaresum += square;                                                    \
+    }                                                                         \
+    NCS[0] = squaresum;                                                       \
+    NPS[0] = peaksquare;                                                      \
+  } else {                                                                    \
+    for (i = 0; i < num_frames; i++, in += channels) {                        \
+      for (c = 0; c < channels; c++) {                                       \
+        gdouble square = ((gdouble) in[c]) * in[c];                           \
                                                                               \
-  /* orc_level_squaresum_f64(&squaresum,in,num); */                           \
-  for (j = 0; j < num; j += channels) {                                       \
-    square = ((gdouble) in[j]) * in[j];                                       \
-    if (square > peaksquare) peaksquare = square;                             \
-    squaresum += square;                                                      \
+        NPS[c] = MAX (NPS[c], square);                                        \
+        NCS[c] += square;                                                     \
+      }                                                                       \
+    }                                                                         \
   }                                                                           \
                                                                               \
-  *NCS = squaresum;                                                           \
-  *NPS = peaksquare;                                                          \
+  if (normalizer != 1.0) {                                                    \
+    for (c = 0; c < channels; c++) {                                          \
+      NCS[c] /= normalizer;                                                   \
+      NPS[c] /= normalizer;                                                   \
+    }                                                                         \
+  }                                                                           \
 }
 
-DEFINE_FLOAT_LEVEL_CALCULATOR (gfloat);
-DEFINE_FLOAT_LEVEL_CALCULATOR (gdouble);
-
-/* we would need stride to deinterleave also
-static void inline
-gst_level_calculate_gdouble (gpointer data, guint num, guint channels,
-                            gdouble *NCS, gdouble *NPS)
-{
-  orc_level_squaresum_f64(NCS,(gdouble *)data,num);
-  *NPS = 0.0;
-}
-*/
+DEFINE_LEVEL_CALCULATOR (gint32, (gdouble) (G_GINT64_CONSTANT (1) << 62));
+DEFINE_LEVEL_CALCULATOR (gint16, (gdouble) (G_GINT64_CONSTANT (1) << 30));
+DEFINE_LEVEL_CALCULATOR (gint8, (gdouble) (G_GINT64_CONSTANT (1) << 14));
+DEFINE_LEVEL_CALCULATOR (gfloat, 1.0);
+DEFINE_LEVEL_CALCULATOR (gdouble, 1.0);
 
 /* called with object lock */
 static void
@@ -483,12 +468,14 @@ gst_level_set_caps (GstBaseTransform * trans, GstCaps * in, GstCaps * out)
 
   /* allocate channel variable arrays */
   g_free (filter->CS);
+  g_free (filter->block_CS);
   g_free (filter->peak);
   g_free (filter->last_peak);
   g_free (filter->decay_peak);
   g_free (filter->decay_peak_base);
   g_free (filter->decay_peak_age);
   filter->CS = g_new (gdouble, channels);
+  filter->block_CS = g_new (gdouble, channels);
   filter->peak = g_new (gdouble, channels);
   filter->last_peak = g_new (gdouble, channels);
   filter->decay_peak = g_new (gdouble, channels);
@@ -657,10 +644,14 @@ gst_level_transform_ip (GstBaseTransform * trans, GstBuffer * in)
     block_size = MIN (block_size, num_frames);
     block_int_size = block_size * channels;
 
+    if (!GST_BUFFER_FLAG_IS_SET (in, GST_BUFFER_FLAG_GAP)) {
+      filter->process (in_data, block_size, channels, filter->block_CS,
+          filter->peak);
+    }
+
     for (i = 0; i < channels; ++i) {
       if (!GST_BUFFER_FLAG_IS_SET (in, GST_BUFFER_FLAG_GAP)) {
-        filter->process (in_data + (bps * i), block_int_size, channels, &CS,
-            &filter->peak[i]);
+        CS = filter->block_CS[i];
         CS_tot += CS;
         GST_LOG_OBJECT (filter,
             "[%d]: cumulative squares %lf, over %d samples/%d channels",
@@ -71,12 +71,14 @@ struct _GstLevel {
 
   /* per-channel arrays for intermediate values */
   gdouble *CS;                  /* normalized Cumulative Square */
+  gdouble *block_CS;            /* normalized Cumulative Square over block */
   gdouble *peak;                /* normalized Peak value over buffer */
   gdouble *last_peak;           /* last normalized Peak value over interval */
   gdouble *decay_peak;          /* running decaying normalized Peak */
   gdouble *decay_peak_base;     /* value of last peak we are decaying from */
   GstClockTime *decay_peak_age; /* age of last peak */
 
+  /* data, frames, channels, per-channel CS and peak */
   void (*process)(gpointer, guint, guint, gdouble*, gdouble*);
 };
 
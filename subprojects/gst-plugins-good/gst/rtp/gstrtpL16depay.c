@@ -89,6 +89,8 @@ static gboolean gst_rtp_L16_depay_setcaps (GstRTPBaseDepayload * depayload,
     GstCaps * caps);
 static GstBuffer *gst_rtp_L16_depay_process (GstRTPBaseDepayload * depayload,
     GstRTPBuffer * rtp);
+static GstFlowReturn gst_rtp_L16_depay_process_list (GstRTPBaseDepayload *
+    depayload, GstRTPBuffer * packets, guint n_packets);
 
 static void
 gst_rtp_L16_depay_class_init (GstRtpL16DepayClass * klass)
@@ -101,6 +103,8 @@ gst_rtp_L16_depay_class_init (GstRtpL16DepayClass * klass)
 
   gstrtpbasedepayload_class->set_caps = gst_rtp_L16_depay_setcaps;
   gstrtpbasedepayload_class->process_rtp_packet = gst_rtp_L16_depay_process;
+  gstrtpbasedepayload_class->process_rtp_packet_list =
+      gst_rtp_L16_depay_process_list;
 
   gst_element_class_add_static_pad_template (gstelement_class,
       &gst_rtp_L16_depay_src_template);
@@ -294,3 +298,22 @@ reorder_failed:
     return NULL;
   }
 }
+
+static GstFlowReturn
+gst_rtp_L16_depay_process_list (GstRTPBaseDepayload * depayload,
+    GstRTPBuffer * packets, guint n_packets)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint i;
+
+  /* every packet is depayloaded on its own, the output of the whole batch is
+   * pushed as one buffer list */
+  for (i = 0; i < n_packets && ret == GST_FLOW_OK; i++) {
+    GstBuffer *outbuf = gst_rtp_L16_depay_process (depayload, &packets[i]);
+
+    if (outbuf)
+      ret = gst_rtp_base_depayload_queue (depayload, &packets[i], outbuf);
+  }
+
+  return ret;
+}
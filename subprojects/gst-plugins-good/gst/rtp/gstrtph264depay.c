@@ -103,6 +103,8 @@ static GstStateChangeReturn gst_rtp_h264_depay_change_state (GstElement *
 
 static GstBuffer *gst_rtp_h264_depay_process (GstRTPBaseDepayload * depayload,
     GstRTPBuffer * rtp);
+static GstFlowReturn gst_rtp_h264_depay_process_list (GstRTPBaseDepayload *
+    depayload, GstRTPBuffer * packets, guint n_packets);
 static gboolean gst_rtp_h264_depay_setcaps (GstRTPBaseDepayload * filter,
     GstCaps * caps);
 static gboolean gst_rtp_h264_depay_handle_event (GstRTPBaseDepayload * depay,
@@ -206,6 +208,8 @@ gst_rtp_h264_depay_class_init (GstRtpH264DepayClass * klass)
   gstelement_class->change_state = gst_rtp_h264_depay_change_state;
 
   gstrtpbasedepayload_class->process_rtp_packet = gst_rtp_h264_depay_process;
+  gstrtpbasedepayload_class->process_rtp_packet_list =
+      gst_rtp_h264_depay_process_list;
   gstrtpbasedepayload_class->set_caps = gst_rtp_h264_depay_setcaps;
   gstrtpbasedepayload_class->handle_event = gst_rtp_h264_depay_handle_event;
 }
@@ -977,7 +981,17 @@ gst_rtp_h264_depay_push (GstRtpH264Depay * rtph264depay, GstBuffer * outbuf,
   if (marker)
     GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_MARKER);
 
-  gst_rtp_base_depayload_push (GST_RTP_BASE_DEPAYLOAD (rtph264depay), outbuf);
+  /* in a batch the output goes out together with that of the other packets */
+  if (rtph264depay->current_rtp) {
+    GstFlowReturn ret;
+
+    ret = gst_rtp_base_depayload_queue (GST_RTP_BASE_DEPAYLOAD (rtph264depay),
+        rtph264depay->current_rtp, outbuf);
+    if (rtph264depay->current_flow_ret == GST_FLOW_OK)
+      rtph264depay->current_flow_ret = ret;
+  } else
+    gst_rtp_base_depayload_push (GST_RTP_BASE_DEPAYLOAD (rtph264depay),
+        outbuf);
 }
 
 /* SPS/PPS/IDR considered key, all others DELTA;
@@ -1456,6 +1470,28 @@ not_implemented:
   }
 }
 
+static GstFlowReturn
+gst_rtp_h264_depay_process_list (GstRTPBaseDepayload * depayload,
+    GstRTPBuffer * packets, guint n_packets)
+{
+  GstRtpH264Depay *rtph264depay = GST_RTP_H264_DEPAY (depayload);
+  GstFlowReturn ret;
+  guint i;
+
+  rtph264depay->current_flow_ret = GST_FLOW_OK;
+  for (i = 0; i < n_packets &&
+      rtph264depay->current_flow_ret == GST_FLOW_OK; i++) {
+    rtph264depay->current_rtp = &packets[i];
+    gst_rtp_h264_depay_process (depayload, &packets[i]);
+  }
+  rtph264depay->current_rtp = NULL;
+
+  ret = rtph264depay->current_flow_ret;
+  rtph264depay->current_flow_ret = GST_FLOW_OK;
+
+  return ret;
+}
+
 static gboolean
 gst_rtp_h264_depay_handle_event (GstRTPBaseDepayload * depay, GstEvent * event)
 {
@@ -75,6 +75,11 @@ struct _GstRtpH264Depay
   gboolean wait_for_keyframe;
   gboolean request_keyframe;
   gboolean waiting_for_keyframe;
+
+  /* packet being processed as part of a batch, output is queued for it */
+  GstRTPBuffer *current_rtp;
+  /* first failure to queue output in the current batch */
+  GstFlowReturn current_flow_ret;
 };
 
 struct _GstRtpH264DepayClass
@@ -1033,8 +1033,9 @@ gst_rtp_h264_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
   GstRtpH264Pay *rtph264pay;
   guint mtu, size, max_fragment_size, max_fragments, ii, pos;
   GstBuffer *outbuf;
-  guint8 *payload;
-  GstBufferList *list = NULL;
+  GstMemory *fu_headers[3];
+  GstMapInfo map;
+  GstFlowReturn ret = GST_FLOW_OK;
   GstRTPBuffer rtp = { NULL };
 
   rtph264pay = GST_RTP_H264_PAY (basepayload);
@@ -1055,7 +1056,21 @@ gst_rtp_h264_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
   /* We keep 2 bytes for FU indicator and FU Header */
   max_fragment_size = gst_rtp_buffer_calc_payload_len (mtu - 2, 0, 0);
   max_fragments = (size + max_fragment_size - 2) / max_fragment_size;
-  list = gst_buffer_list_new_sized (max_fragments);
+
+  /* The FU indicator and FU header only differ between the first, middle
+   * and last fragment, all packets share one of these three memories */
+  for (ii = 0; ii < 3; ii++) {
+    fu_headers[ii] = gst_allocator_alloc (NULL, 2, NULL);
+    gst_memory_map (fu_headers[ii], &map, GST_MAP_WRITE);
+
+    /* FU indicator */
+    map.data[0] = (nal_header & 0x60) | FU_A_TYPE_ID;
+
+    /* FU Header */
+    map.data[1] = ((ii == 0) << 7) | ((ii == 2) << 6) | (nal_header & 0x1f);
+
+    gst_memory_unmap (fu_headers[ii], &map);
+  }
 
   /* Start at the NALU payload */
   for (pos = 1, ii = 0; pos < size; pos += max_fragment_size, ii++) {
@@ -1071,31 +1086,26 @@ gst_rtp_h264_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
         "creating FU-A packet %u/%u, size %u",
         ii + 1, max_fragments, fragment_size);
 
-    /* use buffer lists
-     * create buffer without payload containing only the RTP header
-     * (memory block at index 0) */
-    outbuf = gst_rtp_base_payload_allocate_output_buffer (basepayload, 2, 0, 0);
-
-    gst_rtp_buffer_map (outbuf, GST_MAP_WRITE, &rtp);
+    /* create buffer with only the RTP header from the header pool, the FU
+     * indicator and header and the fragment are appended without copying */
+    outbuf = gst_rtp_base_payload_allocate_output_buffer_for_region
+        (basepayload, NULL, 0, 0, 0);
 
     GST_BUFFER_DTS (outbuf) = dts;
     GST_BUFFER_PTS (outbuf) = pts;
-    payload = gst_rtp_buffer_get_payload (&rtp);
 
     /* If it's the last fragment and the end of this au, mark the end of
      * slice */
-    gst_rtp_buffer_set_marker (&rtp, last_fragment && end_of_au);
-    if (last_fragment && end_of_au)
+    if (last_fragment && end_of_au) {
+      gst_rtp_buffer_map (outbuf, GST_MAP_WRITE, &rtp);
+      gst_rtp_buffer_set_marker (&rtp, TRUE);
+      gst_rtp_buffer_unmap (&rtp);
       GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_MARKER);
+    }
 
-    /* FU indicator */
-    payload[0] = (nal_header & 0x60) | FU_A_TYPE_ID;
-
-    /* FU Header */
-    payload[1] = (first_fragment << 7) | (last_fragment << 6) |
-        (nal_header & 0x1f);
-
-    gst_rtp_buffer_unmap (&rtp);
+    gst_buffer_append_memory (outbuf,
+        gst_memory_ref (fu_headers[last_fragment ? 2 : first_fragment ? 0 :
+                1]));
 
     /* insert payload memory block */
     gst_rtp_copy_video_meta (rtph264pay, outbuf, paybuf);
@@ -1114,15 +1124,20 @@ gst_rtp_h264_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
       discont = FALSE;
     }
 
-    /* add the buffer to the buffer list */
-    gst_buffer_list_add (list, outbuf);
+    /* the packets of the access unit are pushed together as a buffer list */
+    ret = gst_rtp_base_payload_queue (basepayload, outbuf);
+    if (ret != GST_FLOW_OK)
+      break;
   }
 
   GST_DEBUG_OBJECT (rtph264pay,
-      "sending FU-A fragments: n=%u datasize=%u mtu=%u", ii, size, mtu);
+      "queued FU-A fragments: n=%u datasize=%u mtu=%u", ii, size, mtu);
 
+  for (ii = 0; ii < 3; ii++)
+    gst_memory_unref (fu_headers[ii]);
   gst_buffer_unref (paybuf);
-  return gst_rtp_base_payload_push_list (basepayload, list);
+
+  return ret;
 }
 
 static GstFlowReturn
@@ -1136,9 +1151,10 @@ gst_rtp_h264_pay_payload_nal_single (GstRTPBasePayload * basepayload,
 
   rtph264pay = GST_RTP_H264_PAY (basepayload);
 
-  /* create buffer without payload containing only the RTP header
-   * (memory block at index 0) */
-  outbuf = gst_rtp_base_payload_allocate_output_buffer (basepayload, 0, 0, 0);
+  /* create buffer with the RTP header from the header pool that references
+   * the payload memory */
+  outbuf = gst_rtp_base_payload_allocate_output_buffer_for_region (basepayload,
+      paybuf, 0, -1, 0);
 
   gst_rtp_buffer_map (outbuf, GST_MAP_WRITE, &rtp);
 
@@ -1159,12 +1175,11 @@ gst_rtp_h264_pay_payload_nal_single (GstRTPBasePayload * basepayload,
 
   gst_rtp_buffer_unmap (&rtp);
 
-  /* insert payload memory block */
   gst_rtp_copy_video_meta (rtph264pay, outbuf, paybuf);
-  outbuf = gst_buffer_append (outbuf, paybuf);
+  gst_buffer_unref (paybuf);
 
-  /* push the buffer to the next element */
-  return gst_rtp_base_payload_push (basepayload, outbuf);
+  /* the packets of the access unit are pushed together as a buffer list */
+  return gst_rtp_base_payload_queue (basepayload, outbuf);
 }
 
 static void
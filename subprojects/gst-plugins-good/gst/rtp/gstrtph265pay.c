@@ -1133,14 +1133,13 @@ gst_rtp_h265_pay_payload_nal_single (GstRTPBasePayload * basepayload,
     GstBuffer * paybuf, GstClockTime dts, GstClockTime pts, gboolean marker,
     gboolean delta_unit)
 {
-  GstBufferList *outlist;
   GstBuffer *outbuf;
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
 
-  /* use buffer lists
-   * create buffer without payload containing only the RTP header
-   * (memory block at index 0) */
-  outbuf = gst_rtp_base_payload_allocate_output_buffer (basepayload, 0, 0, 0);
+  /* create buffer with the RTP header from the header pool that references
+   * the payload memory */
+  outbuf = gst_rtp_base_payload_allocate_output_buffer_for_region (basepayload,
+      paybuf, 0, -1, 0);
 
   gst_rtp_buffer_map (outbuf, GST_MAP_WRITE, &rtp);
 
@@ -1155,19 +1154,13 @@ gst_rtp_h265_pay_payload_nal_single (GstRTPBasePayload * basepayload,
   GST_BUFFER_PTS (outbuf) = pts;
   GST_BUFFER_DTS (outbuf) = dts;
 
-  /* insert payload memory block */
-  gst_rtp_copy_video_meta (basepayload, outbuf, paybuf);
-  outbuf = gst_buffer_append (outbuf, paybuf);
-
-  outlist = gst_buffer_list_new ();
-
-  /* add the buffer to the buffer list */
-  gst_buffer_list_add (outlist, outbuf);
-
   gst_rtp_buffer_unmap (&rtp);
 
-  /* push the list to the next element in the pipe */
-  return gst_rtp_base_payload_push_list (basepayload, outlist);
+  gst_rtp_copy_video_meta (basepayload, outbuf, paybuf);
+  gst_buffer_unref (paybuf);
+
+  /* the packets of the access unit are pushed together as a buffer list */
+  return gst_rtp_base_payload_queue (basepayload, outbuf);
 }
 
 static GstFlowReturn
@@ -1177,12 +1170,12 @@ gst_rtp_h265_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
     guint mtu, guint8 nal_type, const guint8 * nal_header, int size)
 {
   GstRtpH265Pay *rtph265pay = (GstRtpH265Pay *) basepayload;
-  GstFlowReturn ret;
+  GstFlowReturn ret = GST_FLOW_OK;
   guint max_fragment_size, ii, pos;
   GstBuffer *outbuf;
-  GstBufferList *outlist = NULL;
+  GstMemory *fu_headers[3];
+  GstMapInfo map;
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
-  guint8 *payload;
 
   if (gst_rtp_buffer_calc_packet_len (size, 0, 0) < mtu) {
     GST_DEBUG_OBJECT (rtph265pay,
@@ -1201,7 +1194,21 @@ gst_rtp_h265_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
   /* We keep 3 bytes for PayloadHdr and FU Header */
   max_fragment_size = gst_rtp_buffer_calc_payload_len (mtu - 3, 0, 0);
 
-  outlist = gst_buffer_list_new ();
+  /* The PayloadHdr and FU header only differ between the first, middle and
+   * last fragment, all packets share one of these three memories */
+  for (ii = 0; ii < 3; ii++) {
+    fu_headers[ii] = gst_allocator_alloc (NULL, 3, NULL);
+    gst_memory_map (fu_headers[ii], &map, GST_MAP_WRITE);
+
+    /* PayloadHdr (type = FU_TYPE_ID (49)) */
+    map.data[0] = (nal_header[0] & 0x81) | (FU_TYPE_ID << 1);
+    map.data[1] = nal_header[1];
+
+    /* FU Header */
+    map.data[2] = ((ii == 0) << 7) | ((ii == 2) << 6) | (nal_type & 0x3f);
+
+    gst_memory_unmap (fu_headers[ii], &map);
+  }
 
   for (pos = 2, ii = 0; pos < size; pos += max_fragment_size, ii++) {
     guint remaining, fragment_size;
@@ -1217,32 +1224,26 @@ gst_rtp_h265_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
         fragment_size, ii, first_fragment ? "first" : "",
         last_fragment ? "last" : "");
 
-    /* use buffer lists
-     * create buffer without payload containing only the RTP header
-     * (memory block at index 0), and with space for PayloadHdr and FU header */
-    outbuf = gst_rtp_base_payload_allocate_output_buffer (basepayload, 3, 0, 0);
-
-    gst_rtp_buffer_map (outbuf, GST_MAP_WRITE, &rtp);
+    /* create buffer with only the RTP header from the header pool, the
+     * PayloadHdr, FU header and the fragment are appended without copying */
+    outbuf = gst_rtp_base_payload_allocate_output_buffer_for_region
+        (basepayload, NULL, 0, 0, 0);
 
     GST_BUFFER_DTS (outbuf) = dts;
     GST_BUFFER_PTS (outbuf) = pts;
-    payload = gst_rtp_buffer_get_payload (&rtp);
-
-    /* PayloadHdr (type = FU_TYPE_ID (49)) */
-    payload[0] = (nal_header[0] & 0x81) | (FU_TYPE_ID << 1);
-    payload[1] = nal_header[1];
 
     /* If it's the last fragment and the end of this au, mark the end of
      * slice */
-    gst_rtp_buffer_set_marker (&rtp, last_fragment && marker);
-    if (last_fragment && marker)
+    if (last_fragment && marker) {
+      gst_rtp_buffer_map (outbuf, GST_MAP_WRITE, &rtp);
+      gst_rtp_buffer_set_marker (&rtp, TRUE);
+      gst_rtp_buffer_unmap (&rtp);
       GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_MARKER);
+    }
 
-    /* FU Header */
-    payload[2] = (first_fragment << 7) | (last_fragment << 6) |
-        (nal_type & 0x3f);
-
-    gst_rtp_buffer_unmap (&rtp);
+    gst_buffer_append_memory (outbuf,
+        gst_memory_ref (fu_headers[last_fragment ? 2 : first_fragment ? 0 :
+                1]));
 
     /* insert payload memory block */
     gst_rtp_copy_video_meta (rtph265pay, outbuf, paybuf);
@@ -1254,11 +1255,14 @@ gst_rtp_h265_pay_payload_nal_fragment (GstRTPBasePayload * basepayload,
     else
       GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_DELTA_UNIT);
 
-    /* add the buffer to the buffer list */
-    gst_buffer_list_add (outlist, outbuf);
+    /* the packets of the access unit are pushed together as a buffer list */
+    ret = gst_rtp_base_payload_queue (basepayload, outbuf);
+    if (ret != GST_FLOW_OK)
+      break;
   }
 
-  ret = gst_rtp_base_payload_push_list (basepayload, outlist);
+  for (ii = 0; ii < 3; ii++)
+    gst_memory_unref (fu_headers[ii]);
   gst_buffer_unref (paybuf);
 
   return ret;
@@ -79,6 +79,8 @@ static gboolean gst_rtp_mp2t_depay_setcaps (GstRTPBaseDepayload * depayload,
     GstCaps * caps);
 static GstBuffer *gst_rtp_mp2t_depay_process (GstRTPBaseDepayload * depayload,
     GstRTPBuffer * rtp);
+static GstFlowReturn gst_rtp_mp2t_depay_process_list (GstRTPBaseDepayload *
+    depayload, GstRTPBuffer * packets, guint n_packets);
 
 static void gst_rtp_mp2t_depay_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
@@ -97,6 +99,8 @@ gst_rtp_mp2t_depay_class_init (GstRtpMP2TDepayClass * klass)
   gstrtpbasedepayload_class = (GstRTPBaseDepayloadClass *) klass;
 
   gstrtpbasedepayload_class->process_rtp_packet = gst_rtp_mp2t_depay_process;
+  gstrtpbasedepayload_class->process_rtp_packet_list =
+      gst_rtp_mp2t_depay_process_list;
   gstrtpbasedepayload_class->set_caps = gst_rtp_mp2t_depay_setcaps;
 
   gobject_class->set_property = gst_rtp_mp2t_depay_set_property;
@@ -202,6 +206,25 @@ empty_packet:
   }
 }
 
+static GstFlowReturn
+gst_rtp_mp2t_depay_process_list (GstRTPBaseDepayload * depayload,
+    GstRTPBuffer * packets, guint n_packets)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint i;
+
+  /* every packet is depayloaded on its own, the output of the whole batch is
+   * pushed as one buffer list */
+  for (i = 0; i < n_packets && ret == GST_FLOW_OK; i++) {
+    GstBuffer *outbuf = gst_rtp_mp2t_depay_process (depayload, &packets[i]);
+
+    if (outbuf)
+      ret = gst_rtp_base_depayload_queue (depayload, &packets[i], outbuf);
+  }
+
+  return ret;
+}
+
 static void
 gst_rtp_mp2t_depay_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
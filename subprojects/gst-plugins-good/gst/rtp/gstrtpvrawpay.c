@@ -286,6 +286,11 @@ gst_rtp_vraw_pay_handle_buffer (GstRTPBasePayload * payload, GstBuffer * buffer)
   GstBufferList *list = NULL;
   GstRTPBuffer rtp = { NULL, };
   gboolean discont;
+  gboolean zero_copy;
+  GstMemory *headers_mem = NULL;
+  GstMapInfo headers_map;
+  guint headers_idx;
+  gsize plane_offset;
 
   rtpvrawpay = GST_RTP_VRAW_PAY (payload);
 
@@ -322,6 +327,26 @@ gst_rtp_vraw_pay_handle_buffer (GstRTPBasePayload * payload, GstBuffer * buffer)
   yinc = rtpvrawpay->yinc;
   xinc = rtpvrawpay->xinc;
 
+  /* for formats where the RTP sample layout is the same as in memory, the
+   * packets reference the pixels of the input buffer instead of copying them
+   * and only the payload headers are written into a separate memory. With
+   * very short lines a packet would need more memories than a buffer can
+   * hold though. */
+  switch (format) {
+    case GST_VIDEO_FORMAT_RGB:
+    case GST_VIDEO_FORMAT_RGBA:
+    case GST_VIDEO_FORMAT_BGR:
+    case GST_VIDEO_FORMAT_BGRA:
+    case GST_VIDEO_FORMAT_UYVY:
+    case GST_VIDEO_FORMAT_UYVP:
+      zero_copy = (width / xinc) * pgroup >= mtu / 8;
+      break;
+    default:
+      zero_copy = FALSE;
+      break;
+  }
+  plane_offset = GST_VIDEO_FRAME_PLANE_OFFSET (&frame, 0);
+
   /* after how many packed lines we push out a buffer list */
   lines_delay = GST_ROUND_UP_4 (height / rtpvrawpay->chunks_per_frame);
 
@@ -356,7 +381,12 @@ gst_rtp_vraw_pay_handle_buffer (GstRTPBasePayload * payload, GstBuffer * buffer)
 
       /* get the max allowed payload length size, we try to fill the complete MTU */
       left = gst_rtp_buffer_calc_payload_len (mtu, 0, 0);
-      out = gst_rtp_base_payload_allocate_output_buffer (payload, left, 0, 0);
+      if (zero_copy)
+        out = gst_rtp_base_payload_allocate_output_buffer_for_region (payload,
+            NULL, 0, 0, 0);
+      else
+        out = gst_rtp_base_payload_allocate_output_buffer (payload, left, 0,
+            0);
 
       if (discont) {
         GST_BUFFER_FLAG_SET (out, GST_BUFFER_FLAG_DISCONT);
@@ -371,8 +401,14 @@ gst_rtp_vraw_pay_handle_buffer (GstRTPBasePayload * payload, GstBuffer * buffer)
             GST_BUFFER_DURATION (buffer) / 2;
       }
 
-      gst_rtp_buffer_map (out, GST_MAP_WRITE, &rtp);
-      outdata = gst_rtp_buffer_get_payload (&rtp);
+      if (zero_copy) {
+        headers_mem = gst_allocator_alloc (NULL, left, NULL);
+        gst_memory_map (headers_mem, &headers_map, GST_MAP_WRITE);
+        outdata = headers_map.data;
+      } else {
+        gst_rtp_buffer_map (out, GST_MAP_WRITE, &rtp);
+        outdata = gst_rtp_buffer_get_payload (&rtp);
+      }
 
       GST_LOG_OBJECT (rtpvrawpay, "created buffer of size %u for MTU %u", left,
           mtu);
@@ -405,7 +441,12 @@ gst_rtp_vraw_pay_handle_buffer (GstRTPBasePayload * payload, GstBuffer * buffer)
 
       /* make sure we can fit at least *one* header and pixel */
       if (!(left > (6 + pgroup))) {
-        gst_rtp_buffer_unmap (&rtp);
+        if (zero_copy) {
+          gst_memory_unmap (headers_mem, &headers_map);
+          gst_memory_unref (headers_mem);
+        } else {
+          gst_rtp_buffer_unmap (&rtp);
+        }
         gst_buffer_unref (out);
         goto too_small;
       }
@@ -468,6 +509,11 @@ gst_rtp_vraw_pay_handle_buffer (GstRTPBasePayload * payload, GstBuffer * buffer)
       GST_LOG_OBJECT (rtpvrawpay, "consumed %u bytes",
           (guint) (outdata - headers));
 
+      /* the pixels are appended to the RTP header without copying, the
+       * extended sequence number and the headers are inserted before them
+       * afterwards */
+      headers_idx = gst_buffer_n_memory (out);
+
       /* second pass, read headers and write the data */
       while (TRUE) {
         guint offs, lin;
@@ -492,6 +538,11 @@ gst_rtp_vraw_pay_handle_buffer (GstRTPBasePayload * payload, GstBuffer * buffer)
           case GST_VIDEO_FORMAT_UYVY:
           case GST_VIDEO_FORMAT_UYVP:
             offs /= xinc;
+            if (zero_copy) {
+              gst_buffer_copy_into (out, buffer, GST_BUFFER_COPY_MEMORY,
+                  plane_offset + (lin * ystride) + (offs * pgroup), length);
+              break;
+            }
             memcpy (outdata, p0 + (lin * ystride) + (offs * pgroup), length);
             outdata += length;
             break;
@@ -554,7 +605,12 @@ gst_rtp_vraw_pay_handle_buffer (GstRTPBasePayload * payload, GstBuffer * buffer)
             break;
           }
           default:
-            gst_rtp_buffer_unmap (&rtp);
+            if (zero_copy) {
+              gst_memory_unmap (headers_mem, &headers_map);
+              gst_memory_unref (headers_mem);
+            } else {
+              gst_rtp_buffer_unmap (&rtp);
+            }
             gst_buffer_unref (out);
             goto unknown_sampling;
         }
@@ -563,14 +619,27 @@ gst_rtp_vraw_pay_handle_buffer (GstRTPBasePayload * payload, GstBuffer * buffer)
           break;
       }
 
+      if (zero_copy) {
+        gsize headers_size = outdata - headers_map.data;
+
+        gst_memory_unmap (headers_mem, &headers_map);
+        gst_memory_resize (headers_mem, 0, headers_size);
+        gst_buffer_insert_memory (out, headers_idx, headers_mem);
+      }
+
       if (line >= height) {
         GST_LOG_OBJECT (rtpvrawpay, "field/frame complete, set marker");
+        if (zero_copy)
+          gst_rtp_buffer_map (out, GST_MAP_WRITE, &rtp);
         gst_rtp_buffer_set_marker (&rtp, TRUE);
         GST_BUFFER_FLAG_SET (out, GST_BUFFER_FLAG_MARKER);
         complete = TRUE;
+        if (zero_copy)
+          gst_rtp_buffer_unmap (&rtp);
       }
-      gst_rtp_buffer_unmap (&rtp);
-      if (left > 0) {
+      if (!zero_copy)
+        gst_rtp_buffer_unmap (&rtp);
+      if (!zero_copy && left > 0) {
         GST_LOG_OBJECT (rtpvrawpay, "we have %u bytes left", left);
         gst_buffer_resize (out, 0, gst_buffer_get_size (out) - left);
       }
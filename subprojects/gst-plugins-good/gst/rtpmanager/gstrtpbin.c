@@ -358,6 +358,7 @@ enum
 #define DEFAULT_MIN_TS_OFFSET        MIN_TS_OFFSET_ROUND_OFF_COMP
 #define DEFAULT_TS_OFFSET_SMOOTHING_FACTOR  0
 #define DEFAULT_UPDATE_NTP64_HEADER_EXT TRUE
+#define DEFAULT_SHARED_RTCP_THREAD   FALSE
 
 enum
 {
@@ -391,6 +392,7 @@ enum
   PROP_FEC_DECODERS,
   PROP_FEC_ENCODERS,
   PROP_UPDATE_NTP64_HEADER_EXT,
+  PROP_SHARED_RTCP_THREAD,
 };
 
 #define GST_RTP_BIN_RTCP_SYNC_TYPE (gst_rtp_bin_rtcp_sync_get_type())
@@ -781,7 +783,8 @@ create_session (GstRtpBin * rtpbin, gint id)
       "max-misorder-time", rtpbin->max_misorder_time, NULL);
 
   g_object_set (session, "update-ntp64-header-ext",
-      rtpbin->update_ntp64_header_ext, NULL);
+      rtpbin->update_ntp64_header_ext, "shared-rtcp-thread",
+      rtpbin->shared_rtcp_thread, NULL);
 
   GST_OBJECT_UNLOCK (rtpbin);
 
@@ -3002,6 +3005,21 @@ gst_rtp_bin_class_init (GstRtpBinClass * klass)
           DEFAULT_UPDATE_NTP64_HEADER_EXT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstRtpBin:shared-rtcp-thread:
+   *
+   * Generate RTCP of the sessions from a small process-wide thread pool
+   * instead of a thread per session. Useful for processes with many rtpbin
+   * instances. See #GstRtpSession:shared-rtcp-thread.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_SHARED_RTCP_THREAD,
+      g_param_spec_boolean ("shared-rtcp-thread", "Shared RTCP Thread",
+          "Generate RTCP from a process-wide thread pool",
+          DEFAULT_SHARED_RTCP_THREAD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state = GST_DEBUG_FUNCPTR (gst_rtp_bin_change_state);
   gstelement_class->request_new_pad =
       GST_DEBUG_FUNCPTR (gst_rtp_bin_request_new_pad);
@@ -3093,6 +3111,7 @@ gst_rtp_bin_init (GstRtpBin * rtpbin)
   rtpbin->min_ts_offset_is_set = FALSE;
   rtpbin->ts_offset_smoothing_factor = DEFAULT_TS_OFFSET_SMOOTHING_FACTOR;
   rtpbin->update_ntp64_header_ext = DEFAULT_UPDATE_NTP64_HEADER_EXT;
+  rtpbin->shared_rtcp_thread = DEFAULT_SHARED_RTCP_THREAD;
 
   /* some default SDES entries */
   cname = g_strdup_printf ("user%u@host-%x", g_random_int (), g_random_int ());
@@ -3439,6 +3458,13 @@ gst_rtp_bin_set_property (GObject * object, guint prop_id,
       gst_rtp_bin_propagate_property_to_session (rtpbin,
           "update-ntp64-header-ext", value);
       break;
+    case PROP_SHARED_RTCP_THREAD:
+      GST_RTP_BIN_LOCK (rtpbin);
+      rtpbin->shared_rtcp_thread = g_value_get_boolean (value);
+      GST_RTP_BIN_UNLOCK (rtpbin);
+      gst_rtp_bin_propagate_property_to_session (rtpbin,
+          "shared-rtcp-thread", value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -3551,6 +3577,9 @@ gst_rtp_bin_get_property (GObject * object, guint prop_id,
     case PROP_UPDATE_NTP64_HEADER_EXT:
       g_value_set_boolean (value, rtpbin->update_ntp64_header_ext);
       break;
+    case PROP_SHARED_RTCP_THREAD:
+      g_value_set_boolean (value, rtpbin->shared_rtcp_thread);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
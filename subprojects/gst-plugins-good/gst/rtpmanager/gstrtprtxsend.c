@@ -28,7 +28,8 @@
  * See #GstRtpRtxReceive for examples
  *
  * The purpose of the sender RTX object is to keep a history of RTP packets up
- * to a configurable limit (max-size-time or max-size-packets). It will listen
+ * to a configurable limit (max-size-time, max-size-packets or max-size-bytes
+ * for the packets of all SSRCs together). It will listen
  * for upstream custom retransmission events (GstRTPRetransmissionRequest) that
  * comes from downstream (#GstRtpSession). When receiving a request it will
  * look up the requested seqnum in its list of stored packets. If the packet
@@ -52,6 +53,14 @@ GST_DEBUG_CATEGORY_STATIC (gst_rtp_rtx_send_debug);
 #define DEFAULT_RTX_PAYLOAD_TYPE 0
 #define DEFAULT_MAX_SIZE_TIME    0
 #define DEFAULT_MAX_SIZE_PACKETS 100
+#define DEFAULT_MAX_SIZE_BYTES   0
+
+/* a larger jump in seqnums restarts the history of an ssrc */
+#define MAX_SEQNUM_GAP 1000
+
+/* the shared history is compacted once it has at least this many entries of
+ * packets that are gone, and more of those than of stored packets */
+#define MIN_STALE_HISTORY 1024
 
 enum
 {
@@ -63,6 +72,8 @@ enum
   PROP_NUM_RTX_REQUESTS,
   PROP_NUM_RTX_PACKETS,
   PROP_CLOCK_RATE_MAP,
+  PROP_MAX_SIZE_BYTES,
+  PROP_NUM_RTX_MISSES,
 };
 
 enum
@@ -163,23 +174,37 @@ typedef struct
   guint16 seqnum;
   guint32 timestamp;
   GstBuffer *buffer;
+  gsize size;
+  guint64 serial;
 } BufferQueueItem;
 
 static void
-buffer_queue_item_free (BufferQueueItem * item)
+buffer_queue_item_clear (BufferQueueItem * item)
 {
-  gst_buffer_unref (item->buffer);
-  g_free (item);
+  gst_clear_buffer (&item->buffer);
 }
 
+/* a packet in the history of all ssrcs, it is gone when the item of its
+ * seqnum has a different serial */
+typedef struct
+{
+  guint32 ssrc;
+  guint16 seqnum;
+  guint64 serial;
+} HistoryItem;
+
 typedef struct
 {
   guint32 rtx_ssrc;
   guint16 seqnum_base, next_seqnum;
   gint clock_rate;
 
-  /* history of rtp packets */
-  GSequence *queue;
+  /* history of rtp packets, with an item for every seqnum from the oldest to
+   * the newest stored packet. The items of seqnums that were not stored have
+   * no buffer, but the oldest and the newest item always have one. */
+  GstQueueArray *queue;
+  guint n_packets;
+  guint64 bytes;
 } SSRCRtxData;
 
 static SSRCRtxData *
@@ -189,7 +214,9 @@ ssrc_rtx_data_new (guint32 rtx_ssrc)
 
   data->rtx_ssrc = rtx_ssrc;
   data->next_seqnum = data->seqnum_base = g_random_int_range (0, G_MAXUINT16);
-  data->queue = g_sequence_new ((GDestroyNotify) buffer_queue_item_free);
+  data->queue = gst_queue_array_new_for_struct (sizeof (BufferQueueItem), 64);
+  gst_queue_array_set_clear_func (data->queue,
+      (GDestroyNotify) buffer_queue_item_clear);
 
   return data;
 }
@@ -197,10 +224,28 @@ ssrc_rtx_data_new (guint32 rtx_ssrc)
 static void
 ssrc_rtx_data_free (SSRCRtxData * data)
 {
-  g_sequence_free (data->queue);
+  gst_queue_array_free (data->queue);
   g_free (data);
 }
 
+static BufferQueueItem *
+ssrc_rtx_data_find (SSRCRtxData * data, guint16 seqnum)
+{
+  BufferQueueItem *item = gst_queue_array_peek_head_struct (data->queue);
+  guint16 idx;
+
+  if (item == NULL)
+    return NULL;
+
+  idx = seqnum - item->seqnum;
+  if (idx >= gst_queue_array_get_length (data->queue))
+    return NULL;
+
+  item = gst_queue_array_peek_nth_struct (data->queue, idx);
+
+  return item->buffer ? item : NULL;
+}
+
 typedef enum
 {
   RTX_TASK_START,
@@ -214,6 +259,7 @@ gst_rtp_rtx_send_set_flushing (GstRtpRtxSend * rtx, gboolean flush)
   GST_OBJECT_LOCK (rtx);
   gst_data_queue_set_flushing (rtx->queue, flush);
   gst_data_queue_flush (rtx->queue);
+  rtx->pending_rtx = NULL;
   GST_OBJECT_UNLOCK (rtx);
 }
 
@@ -305,6 +351,34 @@ gst_rtp_rtx_send_class_init (GstRtpRtxSendClass * klass)
           "Map of payload types to their clock rates",
           GST_TYPE_STRUCTURE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * rtprtxsend:max-size-bytes:
+   *
+   * Amount of bytes to queue for all SSRCs together. When it is exceeded, the
+   * oldest packets are dropped, no matter which SSRC they belong to.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_SIZE_BYTES,
+      g_param_spec_uint ("max-size-bytes", "Max Size Bytes",
+          "Amount of bytes to queue for all SSRCs together (0 = unlimited)",
+          0, G_MAXUINT, DEFAULT_MAX_SIZE_BYTES,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * rtprtxsend:num-rtx-misses:
+   *
+   * Number of retransmission requests for packets that were not in the
+   * history (anymore). The other requests were answered with a
+   * retransmission.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_NUM_RTX_MISSES,
+      g_param_spec_uint ("num-rtx-misses", "Num RTX Misses",
+          "Number of retransmission requests for packets not in the history",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * rtprtxsend::add-extension:
    *
@@ -354,10 +428,15 @@ gst_rtp_rtx_send_reset (GstRtpRtxSend * rtx)
 {
   GST_OBJECT_LOCK (rtx);
   gst_data_queue_flush (rtx->queue);
+  rtx->pending_rtx = NULL;
   g_hash_table_remove_all (rtx->ssrc_data);
   g_hash_table_remove_all (rtx->rtx_ssrcs);
+  gst_queue_array_clear (rtx->history);
+  rtx->history_bytes = 0;
+  rtx->history_packets = 0;
   rtx->num_rtx_requests = 0;
   rtx->num_rtx_packets = 0;
+  rtx->num_rtx_misses = 0;
   GST_OBJECT_UNLOCK (rtx);
 }
 
@@ -377,6 +456,7 @@ gst_rtp_rtx_send_finalize (GObject * object)
   if (rtx->clock_rate_map_structure)
     gst_structure_free (rtx->clock_rate_map_structure);
   g_object_unref (rtx->queue);
+  gst_queue_array_free (rtx->history);
 
   gst_clear_object (&rtx->rid_stream);
   gst_clear_object (&rtx->rid_repaired);
@@ -423,8 +503,11 @@ gst_rtp_rtx_send_init (GstRtpRtxSend * rtx)
   rtx->rtx_pt_map = g_hash_table_new (g_direct_hash, g_direct_equal);
   rtx->clock_rate_map = g_hash_table_new (g_direct_hash, g_direct_equal);
 
+  rtx->history = gst_queue_array_new_for_struct (sizeof (HistoryItem), 1024);
+
   rtx->max_size_time = DEFAULT_MAX_SIZE_TIME;
   rtx->max_size_packets = DEFAULT_MAX_SIZE_PACKETS;
+  rtx->max_size_bytes = DEFAULT_MAX_SIZE_BYTES;
 
   rtx->dummy_writable = gst_buffer_new ();
 }
@@ -508,6 +591,144 @@ gst_rtp_rtx_send_get_ssrc_data (GstRtpRtxSend * rtx, guint32 ssrc)
   return data;
 }
 
+/* Must be called with lock */
+static void
+gst_rtp_rtx_send_release_item (GstRtpRtxSend * rtx, SSRCRtxData * data,
+    BufferQueueItem * item)
+{
+  data->n_packets--;
+  data->bytes -= item->size;
+  if (item->serial) {
+    rtx->history_bytes -= item->size;
+    rtx->history_packets--;
+  }
+
+  gst_clear_buffer (&item->buffer);
+  item->size = 0;
+  item->serial = 0;
+}
+
+/* Must be called with lock */
+static void
+gst_rtp_rtx_send_pop_oldest (GstRtpRtxSend * rtx, SSRCRtxData * data)
+{
+  BufferQueueItem *item;
+
+  gst_rtp_rtx_send_release_item (rtx, data,
+      gst_queue_array_pop_head_struct (data->queue));
+
+  /* the oldest item always has a buffer */
+  while ((item = gst_queue_array_peek_head_struct (data->queue)) &&
+      item->buffer == NULL)
+    gst_queue_array_pop_head_struct (data->queue);
+}
+
+/* Must be called with lock */
+static void
+gst_rtp_rtx_send_remove_item (GstRtpRtxSend * rtx, SSRCRtxData * data,
+    BufferQueueItem * item)
+{
+  if (item == gst_queue_array_peek_head_struct (data->queue)) {
+    gst_rtp_rtx_send_pop_oldest (rtx, data);
+  } else {
+    gst_rtp_rtx_send_release_item (rtx, data, item);
+
+    /* the newest item always has a buffer as well, the head has one so this
+     * stops before the queue is empty */
+    while ((item = gst_queue_array_peek_tail_struct (data->queue)) &&
+        item->buffer == NULL)
+      gst_queue_array_pop_tail_struct (data->queue);
+  }
+}
+
+/* Returns the item that the history entry refers to, or NULL if that packet
+ * was already removed.
+ * Must be called with lock */
+static BufferQueueItem *
+gst_rtp_rtx_send_lookup_history (GstRtpRtxSend * rtx, HistoryItem * entry,
+    SSRCRtxData ** data)
+{
+  BufferQueueItem *item;
+
+  *data = g_hash_table_lookup (rtx->ssrc_data, GUINT_TO_POINTER (entry->ssrc));
+  if (*data == NULL)
+    return NULL;
+
+  item = ssrc_rtx_data_find (*data, entry->seqnum);
+  if (item == NULL || item->serial != entry->serial)
+    return NULL;
+
+  return item;
+}
+
+/* Drops the oldest packets of all ssrcs until max-size-bytes is respected.
+ * Must be called with lock */
+static void
+gst_rtp_rtx_send_expire_history (GstRtpRtxSend * rtx)
+{
+  HistoryItem *entry;
+  BufferQueueItem *item;
+  SSRCRtxData *data;
+
+  while ((entry = gst_queue_array_peek_head_struct (rtx->history))) {
+    item = gst_rtp_rtx_send_lookup_history (rtx, entry, &data);
+
+    if (item) {
+      if (rtx->history_bytes <= rtx->max_size_bytes)
+        break;
+
+      GST_LOG_OBJECT (rtx, "dropping seqnum %u of ssrc %X, %" G_GUINT64_FORMAT
+          " bytes stored", item->seqnum, entry->ssrc, rtx->history_bytes);
+      gst_rtp_rtx_send_remove_item (rtx, data, item);
+    }
+    gst_queue_array_pop_head_struct (rtx->history);
+  }
+}
+
+/* Removes the entries of packets that are gone from the whole history. The
+ * loop above only removes them from the head, so the entries of packets that
+ * were dropped by max-size-packets, max-size-time or a seqnum jump pile up
+ * behind the stored packets of an idle ssrc.
+ * Must be called with lock */
+static void
+gst_rtp_rtx_send_compact_history (GstRtpRtxSend * rtx)
+{
+  guint i, len = gst_queue_array_get_length (rtx->history);
+  HistoryItem entry;
+  SSRCRtxData *data;
+
+  if (len - rtx->history_packets < MAX (MIN_STALE_HISTORY,
+          rtx->history_packets))
+    return;
+
+  GST_LOG_OBJECT (rtx, "compacting history of %u entries, %u stored", len,
+      rtx->history_packets);
+
+  /* rotate through the array once, keeping the order */
+  for (i = 0; i < len; i++) {
+    entry = *(HistoryItem *) gst_queue_array_pop_head_struct (rtx->history);
+    if (gst_rtp_rtx_send_lookup_history (rtx, &entry, &data))
+      gst_queue_array_push_tail_struct (rtx->history, &entry);
+  }
+}
+
+/* Must be called with lock */
+static void
+gst_rtp_rtx_send_clear_history (GstRtpRtxSend * rtx)
+{
+  HistoryItem *entry;
+  BufferQueueItem *item;
+  SSRCRtxData *data;
+
+  while ((entry = gst_queue_array_pop_head_struct (rtx->history))) {
+    item = gst_rtp_rtx_send_lookup_history (rtx, entry, &data);
+    if (item)
+      item->serial = 0;
+  }
+  rtx->history_bytes = 0;
+  rtx->history_packets = 0;
+}
+
 static GstMemory *
 rewrite_header_extensions (GstRtpRtxSend * rtx, GstRTPBuffer * rtp)
 {
@@ -740,16 +961,6 @@ gst_rtp_rtx_buffer_new (GstRtpRtxSend * rtx, GstBuffer * buffer)
   return new_buffer;
 }
 
-static gint
-buffer_queue_items_cmp (BufferQueueItem * a, BufferQueueItem * b,
-    gpointer user_data)
-{
-  /* gst_rtp_buffer_compare_seqnum returns the opposite of what we want,
-   * it returns negative when seqnum1 > seqnum2 and we want negative
-   * when b > a, i.e. a is smaller, so it comes first in the sequence */
-  return gst_rtp_buffer_compare_seqnum (b->seqnum, a->seqnum);
-}
-
 static gboolean
 gst_rtp_rtx_send_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
 {
@@ -782,47 +993,51 @@ gst_rtp_rtx_send_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
         /* check if request is for us */
         if (g_hash_table_contains (rtx->ssrc_data, GUINT_TO_POINTER (ssrc))) {
           SSRCRtxData *data;
-          GSequenceIter *iter;
-          BufferQueueItem search_item;
+          BufferQueueItem *item;
 
           /* update statistics */
           ++rtx->num_rtx_requests;
 
           data = gst_rtp_rtx_send_get_ssrc_data (rtx, ssrc);
 
-          search_item.seqnum = seqnum;
-          iter = g_sequence_lookup (data->queue, &search_item,
-              (GCompareDataFunc) buffer_queue_items_cmp, NULL);
-          if (iter) {
-            BufferQueueItem *item = g_sequence_get (iter);
+          item = ssrc_rtx_data_find (data, seqnum);
+          if (item) {
             GST_LOG_OBJECT (rtx, "found %u", item->seqnum);
             rtx_buf = gst_rtp_rtx_buffer_new (rtx, item->buffer);
-          }
+          } else {
+            ++rtx->num_rtx_misses;
 #ifndef GST_DISABLE_DEBUG
-          else {
-            BufferQueueItem *item = NULL;
-
-            iter = g_sequence_get_begin_iter (data->queue);
-            if (!g_sequence_iter_is_end (iter))
-              item = g_sequence_get (iter);
-
-            if (item && seqnum < item->seqnum) {
-              GST_DEBUG_OBJECT (rtx, "requested seqnum %u has already been "
-                  "removed from the rtx queue; the first available is %u",
-                  seqnum, item->seqnum);
+            item = gst_queue_array_peek_tail_struct (data->queue);
+
+            if (item && gst_rtp_buffer_compare_seqnum (item->seqnum,
+                    seqnum) < 0) {
+              item = gst_queue_array_peek_head_struct (data->queue);
+              GST_DEBUG_OBJECT (rtx, "requested seqnum %u is not in the rtx "
+                  "queue (anymore); the first available is %u", seqnum,
+                  item->seqnum);
             } else {
               GST_WARNING_OBJECT (rtx, "requested seqnum %u has not been "
                   "transmitted yet in the original stream; either the remote end "
                   "is not configured correctly, or the source is too slow",
                   seqnum);
             }
-          }
 #endif
+          }
         }
-        GST_OBJECT_UNLOCK (rtx);
 
-        if (rtx_buf)
-          gst_rtp_rtx_send_push_out (rtx, rtx_buf);
+        /* add the packet to the list that is waiting to be pushed, so that
+         * the requests of a NACK burst go out together */
+        if (rtx_buf && rtx->pending_rtx) {
+          gst_buffer_list_add (rtx->pending_rtx, rtx_buf);
+        } else if (rtx_buf) {
+          GstBufferList *list = gst_buffer_list_new ();
+
+          gst_buffer_list_add (list, rtx_buf);
+          rtx->pending_rtx = list;
+          if (!gst_rtp_rtx_send_push_out (rtx, list))
+            rtx->pending_rtx = NULL;
+        }
+        GST_OBJECT_UNLOCK (rtx);
 
         gst_event_unref (event);
         res = TRUE;
@@ -867,6 +1082,8 @@ gst_rtp_rtx_send_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
           if (g_hash_table_contains (rtx->ssrc_data, GUINT_TO_POINTER (ssrc))) {
             SSRCRtxData *data;
             data = gst_rtp_rtx_send_get_ssrc_data (rtx, ssrc);
+            while (!gst_queue_array_is_empty (data->queue))
+              gst_rtp_rtx_send_pop_oldest (rtx, data);
             g_hash_table_remove (rtx->rtx_ssrcs,
                 GUINT_TO_POINTER (data->rtx_ssrc));
             g_hash_table_remove (rtx->ssrc_data, GUINT_TO_POINTER (ssrc));
@@ -906,7 +1123,10 @@ gst_rtp_rtx_send_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
       return TRUE;
     case GST_EVENT_EOS:
       GST_INFO_OBJECT (rtx, "Got EOS - enqueueing it");
+      GST_OBJECT_LOCK (rtx);
+      rtx->pending_rtx = NULL;
       gst_rtp_rtx_send_push_out (rtx, event);
+      GST_OBJECT_UNLOCK (rtx);
       return TRUE;
     case GST_EVENT_CAPS:
     {
@@ -981,10 +1201,8 @@ gst_rtp_rtx_send_get_ts_diff (SSRCRtxData * data)
   BufferQueueItem *high_buf, *low_buf;
   guint32 result;
 
-  high_buf =
-      g_sequence_get (g_sequence_iter_prev (g_sequence_get_end_iter
-          (data->queue)));
-  low_buf = g_sequence_get (g_sequence_get_begin_iter (data->queue));
+  high_buf = gst_queue_array_peek_tail_struct (data->queue);
+  low_buf = gst_queue_array_peek_head_struct (data->queue);
 
   if (!high_buf || !low_buf || high_buf == low_buf)
     return 0;
@@ -1016,7 +1234,7 @@ process_buffer (GstRtpRtxSend * rtx, GstBuffer * buffer)
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
   BufferQueueItem *item;
   SSRCRtxData *data;
-  guint16 seqnum;
+  guint16 seqnum, idx;
   guint8 payload_type;
   guint32 ssrc, rtptime;
 
@@ -1041,21 +1259,77 @@ process_buffer (GstRtpRtxSend * rtx, GstBuffer * buffer)
               GUINT_TO_POINTER (payload_type)));
     }
 
+    /* find the slot of the seqnum in the queue history */
+    item = gst_queue_array_peek_tail_struct (data->queue);
+    if (item) {
+      gint gap = gst_rtp_buffer_compare_seqnum (item->seqnum, seqnum);
+
+      if (gap <= 0) {
+        /* a reordered packet, store it if its slot is free */
+        item = gst_queue_array_peek_head_struct (data->queue);
+        idx = seqnum - item->seqnum;
+        if (idx >= gst_queue_array_get_length (data->queue))
+          return;
+        item = gst_queue_array_peek_nth_struct (data->queue, idx);
+        if (item->buffer)
+          return;
+      } else if (gap > MAX_SEQNUM_GAP) {
+        GST_DEBUG_OBJECT (rtx, "seqnum jumped from %u to %u, restarting the "
+            "history of ssrc %X", item->seqnum, seqnum, ssrc);
+        while (!gst_queue_array_is_empty (data->queue))
+          gst_rtp_rtx_send_pop_oldest (rtx, data);
+        item = NULL;
+      } else {
+        BufferQueueItem hole = { 0, };
+
+        /* keep a slot for every seqnum that was not seen (yet) */
+        for (hole.seqnum = item->seqnum + 1; hole.seqnum != seqnum;
+            hole.seqnum++)
+          gst_queue_array_push_tail_struct (data->queue, &hole);
+        item = NULL;
+      }
+    }
+    if (item == NULL) {
+      BufferQueueItem new_item = { 0, };
+
+      new_item.seqnum = seqnum;
+      gst_queue_array_push_tail_struct (data->queue, &new_item);
+      item = gst_queue_array_peek_tail_struct (data->queue);
+    }
+
     /* add current rtp buffer to queue history */
-    item = g_new0 (BufferQueueItem, 1);
-    item->seqnum = seqnum;
     item->timestamp = rtptime;
     item->buffer = gst_buffer_ref (buffer);
-    g_sequence_append (data->queue, item);
+    item->size = gst_buffer_get_size (buffer);
+    data->n_packets++;
+    data->bytes += item->size;
+    if (rtx->max_size_bytes) {
+      HistoryItem entry;
+
+      entry.ssrc = ssrc;
+      entry.seqnum = seqnum;
+      entry.serial = item->serial = ++rtx->history_serial;
+      gst_queue_array_push_tail_struct (rtx->history, &entry);
+      rtx->history_bytes += item->size;
+      rtx->history_packets++;
+    }
 
     /* remove oldest packets from history if they are too many */
     if (rtx->max_size_packets) {
-      while (g_sequence_get_length (data->queue) > rtx->max_size_packets)
-        g_sequence_remove (g_sequence_get_begin_iter (data->queue));
+      while (data->n_packets > rtx->max_size_packets)
+        gst_rtp_rtx_send_pop_oldest (rtx, data);
     }
+    /* seqnums must stay unambiguous within the queue */
+    while (gst_queue_array_get_length (data->queue) > G_MAXINT16)
+      gst_rtp_rtx_send_pop_oldest (rtx, data);
     if (rtx->max_size_time) {
       while (gst_rtp_rtx_send_get_ts_diff (data) > rtx->max_size_time)
-        g_sequence_remove (g_sequence_get_begin_iter (data->queue));
+        gst_rtp_rtx_send_pop_oldest (rtx, data);
+    }
+    /* and the oldest packets of all ssrcs if they take too much memory */
+    if (rtx->max_size_bytes) {
+      gst_rtp_rtx_send_expire_history (rtx);
+      gst_rtp_rtx_send_compact_history (rtx);
     }
   }
 }
@@ -1106,7 +1380,19 @@ gst_rtp_rtx_send_src_loop (GstRtpRtxSend * rtx)
   if (gst_data_queue_pop (rtx->queue, &data)) {
     GST_LOG_OBJECT (rtx, "pushing rtx buffer %p", data->object);
 
-    if (G_LIKELY (GST_IS_BUFFER (data->object))) {
+    if (G_LIKELY (GST_IS_BUFFER_LIST (data->object))) {
+      GstBufferList *list = GST_BUFFER_LIST (data->object);
+
+      GST_OBJECT_LOCK (rtx);
+      /* no more packets can be added once it is out of the queue */
+      if (rtx->pending_rtx == list)
+        rtx->pending_rtx = NULL;
+      /* Update statistics just before pushing. */
+      rtx->num_rtx_packets += gst_buffer_list_length (list);
+      GST_OBJECT_UNLOCK (rtx);
+
+      gst_pad_push_list (rtx->srcpad, list);
+    } else if (GST_IS_BUFFER (data->object)) {
       GST_OBJECT_LOCK (rtx);
       /* Update statistics just before pushing. */
       rtx->num_rtx_packets++;
@@ -1187,6 +1473,16 @@ gst_rtp_rtx_send_get_property (GObject * object,
       g_value_set_uint (value, rtx->num_rtx_packets);
       GST_OBJECT_UNLOCK (rtx);
       break;
+    case PROP_MAX_SIZE_BYTES:
+      GST_OBJECT_LOCK (rtx);
+      g_value_set_uint (value, rtx->max_size_bytes);
+      GST_OBJECT_UNLOCK (rtx);
+      break;
+    case PROP_NUM_RTX_MISSES:
+      GST_OBJECT_LOCK (rtx);
+      g_value_set_uint (value, rtx->num_rtx_misses);
+      GST_OBJECT_UNLOCK (rtx);
+      break;
     case PROP_CLOCK_RATE_MAP:
       GST_OBJECT_LOCK (rtx);
       g_value_set_boxed (value, rtx->clock_rate_map_structure);
@@ -1254,6 +1550,15 @@ gst_rtp_rtx_send_set_property (GObject * object,
       rtx->max_size_packets = g_value_get_uint (value);
       GST_OBJECT_UNLOCK (rtx);
       break;
+    case PROP_MAX_SIZE_BYTES:
+      GST_OBJECT_LOCK (rtx);
+      rtx->max_size_bytes = g_value_get_uint (value);
+      if (rtx->max_size_bytes)
+        gst_rtp_rtx_send_expire_history (rtx);
+      else
+        gst_rtp_rtx_send_clear_history (rtx);
+      GST_OBJECT_UNLOCK (rtx);
+      break;
     case PROP_CLOCK_RATE_MAP:
       GST_OBJECT_LOCK (rtx);
       if (rtx->clock_rate_map_structure)
@@ -27,6 +27,7 @@
 #include <gst/gst.h>
 #include <gst/rtp/rtp.h>
 #include <gst/base/gstdataqueue.h>
+#include <gst/base/gstqueuearray.h>
 
 G_BEGIN_DECLS
 
@@ -51,6 +52,8 @@ struct _GstRtpRtxSend
 
   /* rtp packets that will be pushed out */
   GstDataQueue *queue;
+  /* list of rtx packets in the queue that more can be added to */
+  GstBufferList *pending_rtx;
 
   /* ssrc -> SSRCRtxData */
   GHashTable *ssrc_data;
@@ -73,10 +76,19 @@ struct _GstRtpRtxSend
   /* buffering control properties */
   guint max_size_time;
   guint max_size_packets;
+  guint max_size_bytes;
+
+  /* stored packets of all ssrcs, oldest first, when max-size-bytes is set.
+   * history_packets counts the entries whose packet is still stored. */
+  GstQueueArray *history;
+  guint64 history_serial;
+  guint64 history_bytes;
+  guint history_packets;
 
   /* statistics */
   guint num_rtx_requests;
   guint num_rtx_packets;
+  guint num_rtx_misses;
 
   /* list of relevant RTP Header Extensions */
   GstRTPHeaderExtension *rid_stream;
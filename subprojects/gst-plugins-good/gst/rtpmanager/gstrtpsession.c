@@ -224,6 +224,11 @@ enum
 #define DEFAULT_NTP_TIME_SOURCE      GST_RTP_NTP_TIME_SOURCE_NTP
 #define DEFAULT_RTCP_SYNC_SEND_TIME  TRUE
 #define DEFAULT_UPDATE_NTP64_HEADER_EXT  TRUE
+#define DEFAULT_SHARED_RTCP_THREAD   FALSE
+
+/* RTCP that may be queued for pushing in the shared mode when downstream
+ * does not keep up, older reports are dropped */
+#define MAX_QUEUED_RTCP 16
 
 enum
 {
@@ -246,7 +251,8 @@ enum
   PROP_RTP_PROFILE,
   PROP_NTP_TIME_SOURCE,
   PROP_RTCP_SYNC_SEND_TIME,
-  PROP_UPDATE_NTP64_HEADER_EXT
+  PROP_UPDATE_NTP64_HEADER_EXT,
+  PROP_SHARED_RTCP_THREAD
 };
 
 #define GST_RTP_SESSION_LOCK(sess)   g_mutex_lock (&(sess)->priv->lock)
@@ -270,6 +276,20 @@ struct _GstRtpSessionPrivate
   gboolean thread_stopped;
   gboolean wait_send;
 
+  /* RTCP is scheduled on the shared thread pool instead of an own thread */
+  gboolean shared_rtcp_thread;
+  /* the mode of the currently running RTCP thread or task */
+  gboolean shared;
+  /* if the RTCP thread or task already set the session start time */
+  gboolean started;
+  /* if the shared task needs to be queued when wait_send is cleared */
+  gboolean shared_waiting;
+  /* RTCP buffers and events generated by the shared task, pushed from
+   * another pool so that a blocking downstream only holds up this session */
+  GQueue rtcp_queue;
+  /* if a push task is queued or running */
+  gboolean rtcp_pushing;
+
   /* caps mapping */
   GHashTable *ptmap;
 
@@ -828,6 +848,28 @@ gst_rtp_session_class_init (GstRtpSessionClass * klass)
           DEFAULT_UPDATE_NTP64_HEADER_EXT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstRtpSession:shared-rtcp-thread:
+   *
+   * Generate RTCP from a small process-wide thread pool instead of a thread
+   * per session. The RTCP timeouts of all sessions are waited for on the
+   * system clock, so processes with many sessions don't need one mostly idle
+   * thread per session. The RTCP timing is the same in both modes.
+   *
+   * The RTCP is not pushed from the pool but queued and pushed from a
+   * separate pool, so that a session with a blocking downstream doesn't
+   * delay the RTCP of other sessions. If downstream does not keep up, older
+   * queued reports of that session are dropped. The mode is applied when the
+   * RTCP thread starts when going to PLAYING.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_SHARED_RTCP_THREAD,
+      g_param_spec_boolean ("shared-rtcp-thread", "Shared RTCP Thread",
+          "Generate RTCP from a process-wide thread pool",
+          DEFAULT_SHARED_RTCP_THREAD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_rtp_session_change_state);
   gstelement_class->request_new_pad =
@@ -879,10 +921,12 @@ gst_rtp_session_init (GstRtpSession * rtpsession)
   rtpsession->priv = gst_rtp_session_get_instance_private (rtpsession);
   g_mutex_init (&rtpsession->priv->lock);
   g_cond_init (&rtpsession->priv->cond);
+  g_queue_init (&rtpsession->priv->rtcp_queue);
   rtpsession->priv->sysclock = gst_system_clock_obtain ();
   rtpsession->priv->session = rtp_session_new ();
   rtpsession->priv->use_pipeline_clock = DEFAULT_USE_PIPELINE_CLOCK;
   rtpsession->priv->rtcp_sync_send_time = DEFAULT_RTCP_SYNC_SEND_TIME;
+  rtpsession->priv->shared_rtcp_thread = DEFAULT_SHARED_RTCP_THREAD;
 
   /* configure callbacks */
   rtp_session_set_callbacks (rtpsession->priv->session, &callbacks, rtpsession);
@@ -935,6 +979,8 @@ gst_rtp_session_finalize (GObject * object)
   rtpsession = GST_RTP_SESSION (object);
 
   g_hash_table_destroy (rtpsession->priv->ptmap);
+  g_queue_clear_full (&rtpsession->priv->rtcp_queue,
+      (GDestroyNotify) gst_mini_object_unref);
   g_mutex_clear (&rtpsession->priv->lock);
   g_cond_clear (&rtpsession->priv->cond);
   g_object_unref (rtpsession->priv->sysclock);
@@ -1004,6 +1050,11 @@ gst_rtp_session_set_property (GObject * object, guint prop_id,
       g_object_set_property (G_OBJECT (priv->session),
           "update-ntp64-header-ext", value);
       break;
+    case PROP_SHARED_RTCP_THREAD:
+      GST_RTP_SESSION_LOCK (rtpsession);
+      priv->shared_rtcp_thread = g_value_get_boolean (value);
+      GST_RTP_SESSION_UNLOCK (rtpsession);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1087,6 +1138,11 @@ gst_rtp_session_get_property (GObject * object, guint prop_id,
       g_object_get_property (G_OBJECT (priv->session),
           "update-ntp64-header-ext", value);
       break;
+    case PROP_SHARED_RTCP_THREAD:
+      GST_RTP_SESSION_LOCK (rtpsession);
+      g_value_set_boolean (value, priv->shared_rtcp_thread);
+      GST_RTP_SESSION_UNLOCK (rtpsession);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1166,6 +1222,12 @@ get_current_times (GstRtpSession * rtpsession, GstClockTime * running_time,
     *ntpnstime = ntpns;
 }
 
+static void queue_shared_rtcp_task (GstRtpSession * rtpsession);
+static void shared_rtcp_task (GstRtpSession * rtpsession, gpointer user_data);
+static void queue_shared_rtcp_unlocked (GstRtpSession * rtpsession,
+    GstMiniObject * obj);
+static void do_rtcp_events (GstRtpSession * rtpsession, GstPad * srcpad);
+
 /* must be called with GST_RTP_SESSION_LOCK */
 static void
 signal_waiting_rtcp_thread_unlocked (GstRtpSession * rtpsession)
@@ -1174,9 +1236,33 @@ signal_waiting_rtcp_thread_unlocked (GstRtpSession * rtpsession)
     GST_LOG_OBJECT (rtpsession, "signal RTCP thread");
     rtpsession->priv->wait_send = FALSE;
     GST_RTP_SESSION_SIGNAL (rtpsession);
+    if (rtpsession->priv->shared_waiting) {
+      rtpsession->priv->shared_waiting = FALSE;
+      queue_shared_rtcp_task (rtpsession);
+    }
   }
 }
 
+/* must be called with GST_RTP_SESSION_LOCK. Wakes up the RTCP thread from
+ * waiting for the next timeout, returns %TRUE when a wait was pending. */
+static gboolean
+unschedule_rtcp_thread_unlocked (GstRtpSession * rtpsession)
+{
+  GstClockID id = rtpsession->priv->id;
+
+  if (id == NULL)
+    return FALSE;
+
+  gst_clock_id_unschedule (id);
+  if (rtpsession->priv->shared) {
+    /* async waits don't call the callback when unscheduled, forget about the
+     * id so that a callback that is just firing is ignored */
+    gst_clock_id_unref (id);
+    rtpsession->priv->id = NULL;
+  }
+  return TRUE;
+}
+
 static void
 rtcp_thread (GstRtpSession * rtpsession)
 {
@@ -1203,9 +1289,13 @@ rtcp_thread (GstRtpSession * rtpsession)
 
   session = rtpsession->priv->session;
 
-  GST_DEBUG_OBJECT (rtpsession, "starting at %" GST_TIME_FORMAT,
-      GST_TIME_ARGS (current_time));
-  session->start_time = current_time;
+  /* a shared task that fell back to this thread already started */
+  if (!rtpsession->priv->started) {
+    GST_DEBUG_OBJECT (rtpsession, "starting at %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (current_time));
+    session->start_time = current_time;
+    rtpsession->priv->started = TRUE;
+  }
 
   while (!rtpsession->priv->stop_thread) {
     GstClockReturn res;
@@ -1256,6 +1346,228 @@ rtcp_thread (GstRtpSession * rtpsession)
   GST_DEBUG_OBJECT (rtpsession, "leaving RTCP thread");
 }
 
+/* In the shared mode the RTCP thread loop below is split into tasks that run
+ * on a process-wide thread pool. Each task handles one timeout and then
+ * waits asynchronously on the system clock for the next one, the clock
+ * callback queues the next task. */
+static GThreadPool *
+get_shared_rtcp_pool (void)
+{
+  static gsize pool = 0;
+
+  if (g_once_init_enter (&pool)) {
+    GThreadPool *p;
+
+    p = g_thread_pool_new ((GFunc) shared_rtcp_task, NULL,
+        MAX (g_get_num_processors (), 2), FALSE, NULL);
+    g_once_init_leave (&pool, (gsize) p);
+  }
+
+  return (GThreadPool *) pool;
+}
+
+/* must be called with GST_RTP_SESSION_LOCK */
+static void
+queue_shared_rtcp_task (GstRtpSession * rtpsession)
+{
+  g_thread_pool_push (get_shared_rtcp_pool (), gst_object_ref (rtpsession),
+      NULL);
+}
+
+static gboolean
+shared_rtcp_timeout (GstClock * clock, GstClockTime time, GstClockID id,
+    GstRtpSession * rtpsession)
+{
+  GST_RTP_SESSION_LOCK (rtpsession);
+  /* ignore when unscheduled meanwhile */
+  if (rtpsession->priv->id == id) {
+    gst_clock_id_unref (id);
+    rtpsession->priv->id = NULL;
+    queue_shared_rtcp_task (rtpsession);
+  }
+  GST_RTP_SESSION_UNLOCK (rtpsession);
+
+  return TRUE;
+}
+
+static void
+shared_rtcp_task (GstRtpSession * rtpsession, gpointer user_data)
+{
+  GstClockID id;
+  GstClockTime current_time;
+  GstClockTime next_timeout;
+  guint64 ntpnstime;
+  GstClockTime running_time;
+  RTPSession *session;
+  GstClock *sysclock;
+
+  GST_RTP_SESSION_LOCK (rtpsession);
+  if (rtpsession->priv->stop_thread)
+    goto stopped;
+
+  if (rtpsession->priv->wait_send) {
+    GST_LOG_OBJECT (rtpsession, "waiting for getting started");
+    rtpsession->priv->shared_waiting = TRUE;
+    goto done;
+  }
+
+  sysclock = rtpsession->priv->sysclock;
+  current_time = gst_clock_get_time (sysclock);
+
+  session = rtpsession->priv->session;
+
+  if (!rtpsession->priv->started) {
+    GST_DEBUG_OBJECT (rtpsession, "starting at %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (current_time));
+    session->start_time = current_time;
+    rtpsession->priv->started = TRUE;
+  } else {
+    get_current_times (rtpsession, &running_time, &ntpnstime);
+
+    GST_DEBUG_OBJECT (rtpsession, "timeout, current %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (current_time));
+
+    GST_RTP_SESSION_UNLOCK (rtpsession);
+    rtp_session_on_timeout (session, current_time, ntpnstime, running_time);
+    GST_RTP_SESSION_LOCK (rtpsession);
+
+    if (rtpsession->priv->stop_thread)
+      goto stopped;
+  }
+
+  next_timeout = rtp_session_next_timeout (session, current_time);
+
+  GST_DEBUG_OBJECT (rtpsession, "next check time %" GST_TIME_FORMAT,
+      GST_TIME_ARGS (next_timeout));
+
+  /* leave if no more timeouts, the session ended */
+  if (next_timeout == GST_CLOCK_TIME_NONE)
+    goto stopped;
+
+  id = rtpsession->priv->id =
+      gst_clock_new_single_shot_id (sysclock, next_timeout);
+  if (gst_clock_id_wait_async (id, (GstClockCallback) shared_rtcp_timeout,
+          gst_object_ref (rtpsession),
+          (GDestroyNotify) gst_object_unref) != GST_CLOCK_OK)
+    goto wait_failed;
+
+done:
+  GST_RTP_SESSION_UNLOCK (rtpsession);
+  gst_object_unref (rtpsession);
+  return;
+
+stopped:
+  {
+    GST_DEBUG_OBJECT (rtpsession, "leaving shared RTCP task");
+    rtpsession->priv->thread_stopped = TRUE;
+    GST_RTP_SESSION_SIGNAL (rtpsession);
+    goto done;
+  }
+wait_failed:
+  {
+    GError *error = NULL;
+
+    /* the reference passed to the wait is released with the id */
+    gst_clock_id_unref (id);
+    rtpsession->priv->id = NULL;
+
+    /* continue with an own thread, it waits for the next timeout itself */
+    GST_WARNING_OBJECT (rtpsession,
+        "async clock wait failed, falling back to an own RTCP thread");
+    rtpsession->priv->shared = FALSE;
+    rtpsession->priv->thread = g_thread_try_new ("rtpsession-rtcp",
+        (GThreadFunc) rtcp_thread, rtpsession, &error);
+    if (error != NULL) {
+      GST_ERROR_OBJECT (rtpsession, "failed to start thread, %s",
+          error->message);
+      g_error_free (error);
+      goto stopped;
+    }
+    goto done;
+  }
+}
+
+static void
+shared_rtcp_push_task (GstRtpSession * rtpsession, gpointer user_data)
+{
+  GstMiniObject *obj;
+  GstPad *rtcp_src;
+
+  GST_RTP_SESSION_LOCK (rtpsession);
+  while ((obj = g_queue_pop_head (&rtpsession->priv->rtcp_queue))) {
+    if (!(rtcp_src = rtpsession->send_rtcp_src)) {
+      GST_DEBUG_OBJECT (rtpsession, "not sending RTCP, no output pad");
+      gst_mini_object_unref (obj);
+      continue;
+    }
+    gst_object_ref (rtcp_src);
+    GST_RTP_SESSION_UNLOCK (rtpsession);
+
+    /* set rtcp caps on output pad */
+    if (!gst_pad_has_current_caps (rtcp_src))
+      do_rtcp_events (rtpsession, rtcp_src);
+
+    if (GST_IS_BUFFER (obj)) {
+      GST_LOG_OBJECT (rtpsession, "sending RTCP");
+      gst_pad_push (rtcp_src, GST_BUFFER_CAST (obj));
+    } else {
+      GST_LOG_OBJECT (rtpsession, "sending %" GST_PTR_FORMAT, obj);
+      gst_pad_push_event (rtcp_src, GST_EVENT_CAST (obj));
+    }
+    gst_object_unref (rtcp_src);
+
+    GST_RTP_SESSION_LOCK (rtpsession);
+  }
+  rtpsession->priv->rtcp_pushing = FALSE;
+  GST_RTP_SESSION_SIGNAL (rtpsession);
+  GST_RTP_SESSION_UNLOCK (rtpsession);
+
+  gst_object_unref (rtpsession);
+}
+
+/* Pushing may block for as long as downstream wants, so it has its own pool
+ * without a thread limit. Each session has at most one push task queued or
+ * running, a blocked session only holds on to one thread. */
+static GThreadPool *
+get_shared_rtcp_push_pool (void)
+{
+  static gsize pool = 0;
+
+  if (g_once_init_enter (&pool)) {
+    GThreadPool *p;
+
+    p = g_thread_pool_new ((GFunc) shared_rtcp_push_task, NULL, -1, FALSE,
+        NULL);
+    g_once_init_leave (&pool, (gsize) p);
+  }
+
+  return (GThreadPool *) pool;
+}
+
+/* must be called with GST_RTP_SESSION_LOCK. Queues @obj for pushing on the
+ * RTCP source pad from the push pool, takes ownership of @obj. */
+static void
+queue_shared_rtcp_unlocked (GstRtpSession * rtpsession, GstMiniObject * obj)
+{
+  GstRtpSessionPrivate *priv = rtpsession->priv;
+
+  /* downstream doesn't keep up, old reports are of no use anymore */
+  if (g_queue_get_length (&priv->rtcp_queue) >= MAX_QUEUED_RTCP) {
+    GstMiniObject *old = g_queue_pop_head (&priv->rtcp_queue);
+
+    GST_DEBUG_OBJECT (rtpsession, "dropping queued %" GST_PTR_FORMAT, old);
+    gst_mini_object_unref (old);
+  }
+
+  g_queue_push_tail (&priv->rtcp_queue, obj);
+
+  if (!priv->rtcp_pushing) {
+    priv->rtcp_pushing = TRUE;
+    g_thread_pool_push (get_shared_rtcp_push_pool (),
+        gst_object_ref (rtpsession), NULL);
+  }
+}
+
 static gboolean
 start_rtcp_thread (GstRtpSession * rtpsession)
 {
@@ -1270,12 +1582,21 @@ start_rtcp_thread (GstRtpSession * rtpsession)
     /* if the thread stopped, and we still have a handle to the thread, join it
      * now. We can safely join with the lock held, the thread will not take it
      * anymore. */
-    if (rtpsession->priv->thread)
+    if (rtpsession->priv->thread) {
       g_thread_join (rtpsession->priv->thread);
+      rtpsession->priv->thread = NULL;
+    }
     /* only create a new thread if the old one was stopped. Otherwise we can
      * just reuse the currently running one. */
-    rtpsession->priv->thread = g_thread_try_new ("rtpsession-rtcp",
-        (GThreadFunc) rtcp_thread, rtpsession, &error);
+    rtpsession->priv->shared = rtpsession->priv->shared_rtcp_thread;
+    rtpsession->priv->started = FALSE;
+    if (rtpsession->priv->shared) {
+      rtpsession->priv->shared_waiting = FALSE;
+      queue_shared_rtcp_task (rtpsession);
+    } else {
+      rtpsession->priv->thread = g_thread_try_new ("rtpsession-rtcp",
+          (GThreadFunc) rtcp_thread, rtpsession, &error);
+    }
     rtpsession->priv->thread_stopped = FALSE;
   }
   GST_RTP_SESSION_UNLOCK (rtpsession);
@@ -1298,8 +1619,15 @@ stop_rtcp_thread (GstRtpSession * rtpsession)
   GST_RTP_SESSION_LOCK (rtpsession);
   rtpsession->priv->stop_thread = TRUE;
   signal_waiting_rtcp_thread_unlocked (rtpsession);
-  if (rtpsession->priv->id)
-    gst_clock_id_unschedule (rtpsession->priv->id);
+  if (unschedule_rtcp_thread_unlocked (rtpsession)
+      && rtpsession->priv->shared) {
+    /* no task is running or queued while waiting for the timeout */
+    rtpsession->priv->thread_stopped = TRUE;
+  }
+  /* RTCP is not sent anymore when stopping, a running push task finishes
+   * with what it is pushing now */
+  g_queue_clear_full (&rtpsession->priv->rtcp_queue,
+      (GDestroyNotify) gst_mini_object_unref);
   GST_RTP_SESSION_UNLOCK (rtpsession);
 }
 
@@ -1307,6 +1635,14 @@ static void
 join_rtcp_thread (GstRtpSession * rtpsession)
 {
   GST_RTP_SESSION_LOCK (rtpsession);
+  /* wait for a running shared task to finish */
+  if (rtpsession->priv->shared) {
+    while (!rtpsession->priv->thread_stopped)
+      GST_RTP_SESSION_WAIT (rtpsession);
+  }
+  /* and for the push task, downstream is flushing now */
+  while (rtpsession->priv->rtcp_pushing)
+    GST_RTP_SESSION_WAIT (rtpsession);
   /* don't try to join when we have no thread */
   if (rtpsession->priv->thread != NULL) {
     GST_DEBUG_OBJECT (rtpsession, "joining RTCP thread");
@@ -1532,6 +1868,23 @@ gst_rtp_session_send_rtcp (RTPSession * sess, RTPSource * src,
   if (rtpsession->priv->stop_thread)
     goto stopping;
 
+  if (rtpsession->priv->shared) {
+    /* don't push from the shared pool, a blocking downstream would delay
+     * the RTCP of all other sessions */
+    queue_shared_rtcp_unlocked (rtpsession, GST_MINI_OBJECT_CAST (buffer));
+
+    if (all_sources_bye && rtpsession->send_rtp_sink &&
+        GST_PAD_IS_EOS (rtpsession->send_rtp_sink)) {
+      GstEvent *event = gst_event_new_eos ();
+
+      gst_event_set_seqnum (event, rtpsession->recv_rtcp_segment_seqnum);
+      queue_shared_rtcp_unlocked (rtpsession, GST_MINI_OBJECT_CAST (event));
+    }
+    GST_RTP_SESSION_UNLOCK (rtpsession);
+
+    return GST_FLOW_OK;
+  }
+
   if ((rtcp_src = rtpsession->send_rtcp_src)) {
     gst_object_ref (rtcp_src);
     GST_RTP_SESSION_UNLOCK (rtpsession);
@@ -1722,8 +2075,8 @@ gst_rtp_session_reconsider (RTPSession * sess, gpointer user_data)
 
   GST_RTP_SESSION_LOCK (rtpsession);
   GST_DEBUG_OBJECT (rtpsession, "unlock timer for reconsideration");
-  if (rtpsession->priv->id)
-    gst_clock_id_unschedule (rtpsession->priv->id);
+  if (unschedule_rtcp_thread_unlocked (rtpsession) && rtpsession->priv->shared)
+    queue_shared_rtcp_task (rtpsession);
   GST_RTP_SESSION_UNLOCK (rtpsession);
 }
 
@@ -128,6 +128,8 @@ static void gst_rtp_ssrc_demux_clear_ssrc (GstRtpSsrcDemux * demux,
 /* sinkpad stuff */
 static GstFlowReturn gst_rtp_ssrc_demux_chain (GstPad * pad, GstObject * parent,
     GstBuffer * buf);
+static GstFlowReturn gst_rtp_ssrc_demux_chain_list (GstPad * pad,
+    GstObject * parent, GstBufferList * list);
 static gboolean gst_rtp_ssrc_demux_sink_event (GstPad * pad, GstObject * parent,
     GstEvent * event);
 
@@ -163,15 +165,7 @@ typedef struct
 static GstRtpSsrcDemuxPads *
 find_demux_pads_for_ssrc (GstRtpSsrcDemux * demux, guint32 ssrc)
 {
-  GSList *walk;
-
-  for (walk = demux->srcpads; walk; walk = g_slist_next (walk)) {
-    GstRtpSsrcDemuxPads *pad = (GstRtpSsrcDemuxPads *) walk->data;
-
-    if (pad->ssrc == ssrc)
-      return pad;
-  }
-  return NULL;
+  return g_hash_table_lookup (demux->ssrc_pads, GUINT_TO_POINTER (ssrc));
 }
 
 /* returns a reference to the pad if found, %NULL otherwise */
@@ -322,6 +316,7 @@ find_or_create_demux_pad_for_ssrc (GstRtpSsrcDemux * demux, guint32 ssrc,
 
   GST_OBJECT_LOCK (demux);
   demux->srcpads = g_slist_prepend (demux->srcpads, dpads);
+  g_hash_table_insert (demux->ssrc_pads, GUINT_TO_POINTER (ssrc), dpads);
   GST_OBJECT_UNLOCK (demux);
 
   gst_pad_set_query_function (rtp_pad, gst_rtp_ssrc_demux_src_query);
@@ -480,6 +475,7 @@ gst_rtp_ssrc_demux_class_init (GstRtpSsrcDemuxClass * klass)
       "rtpssrcdemux", 0, "RTP SSRC demuxer");
 
   GST_DEBUG_REGISTER_FUNCPTR (gst_rtp_ssrc_demux_chain);
+  GST_DEBUG_REGISTER_FUNCPTR (gst_rtp_ssrc_demux_chain_list);
   GST_DEBUG_REGISTER_FUNCPTR (gst_rtp_ssrc_demux_rtcp_chain);
 }
 
@@ -492,6 +488,8 @@ gst_rtp_ssrc_demux_init (GstRtpSsrcDemux * demux)
       gst_pad_new_from_template (gst_element_class_get_pad_template (klass,
           "sink"), "sink");
   gst_pad_set_chain_function (demux->rtp_sink, gst_rtp_ssrc_demux_chain);
+  gst_pad_set_chain_list_function (demux->rtp_sink,
+      gst_rtp_ssrc_demux_chain_list);
   gst_pad_set_event_function (demux->rtp_sink, gst_rtp_ssrc_demux_sink_event);
   gst_pad_set_iterate_internal_links_function (demux->rtp_sink,
       gst_rtp_ssrc_demux_iterate_internal_links_sink);
@@ -507,6 +505,7 @@ gst_rtp_ssrc_demux_init (GstRtpSsrcDemux * demux)
   gst_element_add_pad (GST_ELEMENT_CAST (demux), demux->rtcp_sink);
 
   demux->max_streams = DEFAULT_MAX_STREAMS;
+  demux->ssrc_pads = g_hash_table_new (NULL, NULL);
 
   g_rec_mutex_init (&demux->padlock);
 }
@@ -526,6 +525,7 @@ gst_rtp_ssrc_demux_pads_free (GstRtpSsrcDemuxPads * dpads)
 static void
 gst_rtp_ssrc_demux_reset (GstRtpSsrcDemux * demux)
 {
+  g_hash_table_remove_all (demux->ssrc_pads);
   g_slist_free_full (demux->srcpads,
       (GDestroyNotify) gst_rtp_ssrc_demux_pads_free);
   demux->srcpads = NULL;
@@ -549,6 +549,7 @@ gst_rtp_ssrc_demux_finalize (GObject * object)
   GstRtpSsrcDemux *demux;
 
   demux = GST_RTP_SSRC_DEMUX (object);
+  g_hash_table_unref (demux->ssrc_pads);
   g_rec_mutex_clear (&demux->padlock);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
@@ -569,6 +570,7 @@ gst_rtp_ssrc_demux_clear_ssrc (GstRtpSsrcDemux * demux, guint32 ssrc)
   GST_DEBUG_OBJECT (demux, "clearing pad for SSRC %08x", ssrc);
 
   demux->srcpads = g_slist_remove (demux->srcpads, dpads);
+  g_hash_table_remove (demux->ssrc_pads, GUINT_TO_POINTER (ssrc));
   GST_OBJECT_UNLOCK (demux);
 
   g_signal_emit (G_OBJECT (demux),
@@ -648,25 +650,14 @@ gst_rtp_ssrc_demux_sink_event (GstPad * pad, GstObject * parent,
   return fdata.res;
 }
 
+/* push @obj, a buffer or a buffer list, on the RTP pad for @ssrc */
 static GstFlowReturn
-gst_rtp_ssrc_demux_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
+gst_rtp_ssrc_demux_push_rtp (GstRtpSsrcDemux * demux, guint32 ssrc,
+    GstMiniObject * obj)
 {
   GstFlowReturn ret;
-  GstRtpSsrcDemux *demux;
-  guint32 ssrc;
-  GstRTPBuffer rtp = { NULL };
   GstPad *srcpad;
 
-  demux = GST_RTP_SSRC_DEMUX (parent);
-
-  if (!gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp))
-    goto invalid_payload;
-
-  ssrc = gst_rtp_buffer_get_ssrc (&rtp);
-  gst_rtp_buffer_unmap (&rtp);
-
-  GST_DEBUG_OBJECT (demux, "received buffer of SSRC %08x", ssrc);
-
   srcpad = find_or_create_demux_pad_for_ssrc (demux, ssrc, RTP_PAD);
   if (srcpad == NULL)
     goto create_failed;
@@ -677,7 +668,10 @@ gst_rtp_ssrc_demux_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   }
 
   /* push to srcpad */
-  ret = gst_pad_push (srcpad, buf);
+  if (GST_IS_BUFFER_LIST (obj))
+    ret = gst_pad_push_list (srcpad, GST_BUFFER_LIST_CAST (obj));
+  else
+    ret = gst_pad_push (srcpad, GST_BUFFER_CAST (obj));
 
   if (ret != GST_FLOW_OK) {
     GstPad *active_pad;
@@ -698,15 +692,9 @@ gst_rtp_ssrc_demux_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   return ret;
 
   /* ERRORS */
-invalid_payload:
-  {
-    GST_DEBUG_OBJECT (demux, "Dropping invalid RTP packet");
-    gst_buffer_unref (buf);
-    return GST_FLOW_OK;
-  }
 create_failed:
   {
-    gst_buffer_unref (buf);
+    gst_mini_object_unref (obj);
     GST_WARNING_OBJECT (demux,
         "Dropping buffer SSRC %08x. "
         "Max streams number reached (%u)", ssrc, demux->max_streams);
@@ -714,6 +702,108 @@ create_failed:
   }
 }
 
+static GstFlowReturn
+gst_rtp_ssrc_demux_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
+{
+  GstRtpSsrcDemux *demux;
+  guint32 ssrc;
+  GstRTPBuffer rtp = { NULL };
+
+  demux = GST_RTP_SSRC_DEMUX (parent);
+
+  if (!gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp))
+    goto invalid_payload;
+
+  ssrc = gst_rtp_buffer_get_ssrc (&rtp);
+  gst_rtp_buffer_unmap (&rtp);
+
+  GST_DEBUG_OBJECT (demux, "received buffer of SSRC %08x", ssrc);
+
+  return gst_rtp_ssrc_demux_push_rtp (demux, ssrc, GST_MINI_OBJECT_CAST (buf));
+
+  /* ERRORS */
+invalid_payload:
+  {
+    GST_DEBUG_OBJECT (demux, "Dropping invalid RTP packet");
+    gst_buffer_unref (buf);
+    return GST_FLOW_OK;
+  }
+}
+
+typedef struct
+{
+  GstRtpSsrcDemux *demux;
+  /* consecutive buffers of the same SSRC */
+  GstBufferList *run;
+  guint32 run_ssrc;
+  GstFlowReturn ret;
+} ChainListData;
+
+static gboolean
+chain_list_buffer (GstBuffer ** buffer, guint idx, ChainListData * data)
+{
+  GstRTPBuffer rtp = { NULL };
+  guint32 ssrc;
+
+  if (!gst_rtp_buffer_map (*buffer, GST_MAP_READ, &rtp)) {
+    /* stays in the list and is dropped with it */
+    GST_DEBUG_OBJECT (data->demux, "Dropping invalid RTP packet");
+    return TRUE;
+  }
+
+  ssrc = gst_rtp_buffer_get_ssrc (&rtp);
+  gst_rtp_buffer_unmap (&rtp);
+
+  if (data->run && ssrc != data->run_ssrc) {
+    data->ret = gst_rtp_ssrc_demux_push_rtp (data->demux, data->run_ssrc,
+        GST_MINI_OBJECT_CAST (data->run));
+    data->run = NULL;
+    if (data->ret != GST_FLOW_OK)
+      return FALSE;
+  }
+
+  /* runs are usually short, the list grows for the long ones */
+  if (data->run == NULL) {
+    data->run = gst_buffer_list_new ();
+    data->run_ssrc = ssrc;
+  }
+
+  /* move the buffer to the run */
+  gst_buffer_list_add (data->run, *buffer);
+  *buffer = NULL;
+
+  return TRUE;
+}
+
+/* Packets of one SSRC usually arrive in bursts, push every run of packets
+ * with the same SSRC as one list instead of looking up the pad and pushing
+ * every packet on its own */
+static GstFlowReturn
+gst_rtp_ssrc_demux_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  ChainListData data;
+
+  data.demux = GST_RTP_SSRC_DEMUX (parent);
+  data.run = NULL;
+  data.run_ssrc = 0;
+  data.ret = GST_FLOW_OK;
+
+  GST_DEBUG_OBJECT (data.demux, "received list of %u buffers",
+      gst_buffer_list_length (list));
+
+  list = gst_buffer_list_make_writable (list);
+  gst_buffer_list_foreach (list, (GstBufferListFunc) chain_list_buffer,
+      &data);
+  gst_buffer_list_unref (list);
+
+  if (data.run)
+    data.ret = gst_rtp_ssrc_demux_push_rtp (data.demux, data.run_ssrc,
+        GST_MINI_OBJECT_CAST (data.run));
+
+  return data.ret;
+}
+
 static GstFlowReturn
 gst_rtp_ssrc_demux_rtcp_chain (GstPad * pad, GstObject * parent,
     GstBuffer * buf)
@@ -40,6 +40,8 @@ struct _GstRtpSsrcDemux
 
   GRecMutex padlock;
   GSList *srcpads;
+  /* SSRC -> GstRtpSsrcDemuxPads, protected by the object lock */
+  GHashTable *ssrc_pads;
   guint max_streams;
 };
 
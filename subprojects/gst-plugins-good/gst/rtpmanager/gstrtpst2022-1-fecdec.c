@@ -93,14 +93,18 @@ GST_DEBUG_CATEGORY_STATIC (gst_rtpst_2022_1_fecdec_debug);
 
 #define DEFAULT_SIZE_TIME (GST_SECOND)
 
+/* Initial and maximum number of seqnums the media packet storage covers */
+#define MIN_MEDIA_PACKETS 1024
+#define MAX_MEDIA_PACKETS 32768
+
 typedef struct
 {
   guint16 seq;
   GstBuffer *buffer;
 } Item;
 
-static GstFlowReturn store_media_item (GstRTPST_2022_1_FecDec * dec,
-    GstRTPBuffer * rtp, Item * item);
+static GstFlowReturn store_media_buffer (GstRTPST_2022_1_FecDec * dec,
+    guint16 seq, GstBuffer * buffer, GstBufferList ** recovered);
 
 static void
 free_item (Item * item)
@@ -136,7 +140,13 @@ struct _GstRTPST_2022_1_FecDec
   GList *fec_sinkpads;
 
   /* All the following field are protected by the OBJECT_LOCK */
-  GSequence *packets;
+  /* The media packets, at index seqnum & packets_mask, for the
+   * n_packets seqnums starting at packets_seq. The first one is
+   * always present. */
+  GstBuffer **packets;
+  guint packets_mask;
+  guint16 packets_seq;
+  guint n_packets;
   GHashTable *column_fec_packets;
   GSequence *fec_packets[2];
   /* N columns */
@@ -196,33 +206,115 @@ GST_ELEMENT_REGISTER_DEFINE (rtpst2022_1_fecdec, "rtpst2022-1-fecdec",
     GST_RANK_NONE, GST_TYPE_RTPST_2022_1_FECDEC);
 
 static void
-trim_items (GstRTPST_2022_1_FecDec * dec)
+pop_media_packet (GstRTPST_2022_1_FecDec * dec)
 {
-  GSequenceIter *tmp_iter, *iter = NULL;
+  GstBuffer **slot = &dec->packets[dec->packets_seq & dec->packets_mask];
 
-  for (tmp_iter = g_sequence_get_begin_iter (dec->packets);
-      tmp_iter; tmp_iter = g_sequence_iter_next (tmp_iter)) {
-    Item *item;
+  gst_clear_buffer (slot);
+  dec->packets_seq++;
+  dec->n_packets--;
 
-    if (g_sequence_iter_is_end (tmp_iter))
-      break;
+  /* skip the seqnums we have no packet for */
+  while (dec->n_packets &&
+      dec->packets[dec->packets_seq & dec->packets_mask] == NULL) {
+    dec->packets_seq++;
+    dec->n_packets--;
+  }
+}
 
-    item = g_sequence_get (tmp_iter);
+static void
+clear_media_packets (GstRTPST_2022_1_FecDec * dec)
+{
+  while (dec->n_packets)
+    pop_media_packet (dec);
+}
+
+static void
+grow_media_packets (GstRTPST_2022_1_FecDec * dec, guint n_packets)
+{
+  guint size = dec->packets_mask + 1;
+  GstBuffer **packets;
+  guint i;
+
+  while (size < n_packets)
+    size *= 2;
+
+  packets = g_new0 (GstBuffer *, size);
+  for (i = 0; i < dec->n_packets; i++) {
+    guint16 seq = dec->packets_seq + i;
+
+    packets[seq & (size - 1)] = dec->packets[seq & dec->packets_mask];
+  }
+
+  g_free (dec->packets);
+  dec->packets = packets;
+  dec->packets_mask = size - 1;
+}
+
+/* Takes ownership of @buffer and returns %FALSE if it could not be stored */
+static gboolean
+insert_media_packet (GstRTPST_2022_1_FecDec * dec, guint16 seq,
+    GstBuffer * buffer)
+{
+  guint16 offset = seq - dec->packets_seq;
+  guint n_packets;
+
+  if (dec->n_packets == 0) {
+    dec->packets_seq = seq;
+    n_packets = 1;
+  } else if (offset < dec->n_packets) {
+    /* inside the current window, only store it if it is a new one */
+    if (dec->packets[seq & dec->packets_mask])
+      goto drop;
+    n_packets = dec->n_packets;
+  } else if (offset < 0x8000) {
+    /* newer than the newest one, drop what falls out of the window */
+    while (dec->n_packets && (guint16) (seq - dec->packets_seq) >=
+        MAX_MEDIA_PACKETS)
+      pop_media_packet (dec);
+    if (dec->n_packets == 0)
+      dec->packets_seq = seq;
+    n_packets = (guint16) (seq - dec->packets_seq) + 1;
+  } else {
+    /* older than the oldest one */
+    n_packets = dec->n_packets + (guint16) (dec->packets_seq - seq);
+    if (n_packets > MAX_MEDIA_PACKETS)
+      goto drop;
+    dec->packets_seq = seq;
+  }
 
-    if (dec->max_arrival_time - GST_BUFFER_DTS_OR_PTS (item->buffer) <
+  if (n_packets > dec->packets_mask + 1)
+    grow_media_packets (dec, n_packets);
+
+  dec->packets[seq & dec->packets_mask] = buffer;
+  dec->n_packets = n_packets;
+
+  return TRUE;
+
+drop:
+  gst_buffer_unref (buffer);
+  return FALSE;
+}
+
+static void
+trim_items (GstRTPST_2022_1_FecDec * dec)
+{
+  GstBuffer *buffer;
+  guint16 seq = dec->packets_seq;
+
+  while (dec->n_packets) {
+    buffer = dec->packets[dec->packets_seq & dec->packets_mask];
+
+    if (dec->max_arrival_time - GST_BUFFER_DTS_OR_PTS (buffer) <
         dec->size_time)
       break;
 
-    iter = tmp_iter;
+    seq = dec->packets_seq;
+    pop_media_packet (dec);
   }
 
-  if (iter) {
-    Item *item = g_sequence_get (iter);
-    GST_TRACE_OBJECT (dec,
-        "Trimming packets up to %" GST_TIME_FORMAT " (seq: %u)",
-        GST_TIME_ARGS (GST_BUFFER_DTS_OR_PTS (item->buffer)), item->seq);
-    g_sequence_remove_range (g_sequence_get_begin_iter (dec->packets),
-        g_sequence_iter_next (iter));
+  if (seq != dec->packets_seq) {
+    GST_TRACE_OBJECT (dec, "Trimmed packets up to seq %u", seq);
   }
 }
 
@@ -268,21 +360,13 @@ trim_fec_items (GstRTPST_2022_1_FecDec * dec, guint D)
   }
 }
 
-static Item *
+static GstBuffer *
 lookup_media_packet (GstRTPST_2022_1_FecDec * dec, guint16 seqnum)
 {
-  GSequenceIter *iter;
-  Item *ret = NULL;
-  Item dummy = { seqnum, NULL };
+  if ((guint16) (seqnum - dec->packets_seq) >= dec->n_packets)
+    return NULL;
 
-  iter =
-      g_sequence_lookup (dec->packets, &dummy, (GCompareDataFunc) cmp_items,
-      NULL);
-
-  if (iter)
-    ret = g_sequence_get (iter);
-
-  return ret;
+  return dec->packets[seqnum & dec->packets_mask];
 }
 
 static gboolean
@@ -370,50 +454,51 @@ done:
   return ret;
 }
 
+/* XORs 32 bytes per iteration, which compilers turn into vector
+ * instructions, the payloads don't need to be aligned for this */
 static void
 _xor_mem (guint8 * restrict dst, const guint8 * restrict src, gsize length)
 {
-  guint i;
-
-  for (i = 0; i < (length / sizeof (guint64)); ++i) {
-#if G_BYTE_ORDER == G_LITTLE_ENDIAN
-    GST_WRITE_UINT64_LE (dst,
-        GST_READ_UINT64_LE (dst) ^ GST_READ_UINT64_LE (src));
-#else
-    GST_WRITE_UINT64_BE (dst,
-        GST_READ_UINT64_BE (dst) ^ GST_READ_UINT64_BE (src));
-#endif
-    dst += sizeof (guint64);
-    src += sizeof (guint64);
+  gsize i;
+
+  for (i = 0; i + 4 * sizeof (guint64) <= length; i += 4 * sizeof (guint64)) {
+    guint64 d[4], s[4];
+
+    memcpy (d, dst + i, sizeof (d));
+    memcpy (s, src + i, sizeof (s));
+    d[0] ^= s[0];
+    d[1] ^= s[1];
+    d[2] ^= s[2];
+    d[3] ^= s[3];
+    memcpy (dst + i, d, sizeof (d));
   }
-  for (i = 0; i < (length % sizeof (guint64)); ++i)
+  for (; i < length; ++i)
     dst[i] ^= src[i];
 }
 
 static GstFlowReturn
-xor_items (GstRTPST_2022_1_FecDec * dec, Rtp2DFecHeader * fec, GList * packets,
-    guint16 seqnum)
+xor_items (GstRTPST_2022_1_FecDec * dec, Rtp2DFecHeader * fec,
+    GstBuffer ** packets, guint n_packets, guint16 seqnum,
+    GstBufferList ** recovered)
 {
   guint8 *xored;
   guint32 xored_timestamp;
   guint8 xored_pt;
   guint16 xored_payload_len;
-  Item *item;
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
-  GList *tmp;
   GstFlowReturn ret = GST_FLOW_OK;
   GstBuffer *buffer;
   gboolean xored_marker;
   gboolean xored_padding;
   gboolean xored_extension;
+  guint i;
 
   /* Figure out the recovered packet length first */
   xored_payload_len = fec->len;
-  for (tmp = packets; tmp; tmp = tmp->next) {
+  for (i = 0; i < n_packets; i++) {
     GstRTPBuffer media_rtp = GST_RTP_BUFFER_INIT;
-    Item *item = (Item *) tmp->data;
 
-    gst_rtp_buffer_map (item->buffer, GST_MAP_READ, &media_rtp);
+    gst_rtp_buffer_map (packets[i], GST_MAP_READ, &media_rtp);
     xored_payload_len ^= gst_rtp_buffer_get_payload_len (&media_rtp);
     gst_rtp_buffer_unmap (&media_rtp);
   }
@@ -424,10 +509,8 @@ xor_items (GstRTPST_2022_1_FecDec * dec, Rtp2DFecHeader * fec, GList * packets,
     goto done;
   }
 
-  item = g_malloc0 (sizeof (Item));
-  item->seq = seqnum;
-  item->buffer = gst_rtp_buffer_new_allocate (xored_payload_len, 0, 0);
-  gst_rtp_buffer_map (item->buffer, GST_MAP_WRITE, &rtp);
+  buffer = gst_rtp_buffer_new_allocate (xored_payload_len, 0, 0);
+  gst_rtp_buffer_map (buffer, GST_MAP_WRITE, &rtp);
 
   xored = gst_rtp_buffer_get_payload (&rtp);
   memcpy (xored, fec->payload, xored_payload_len);
@@ -437,11 +520,10 @@ xor_items (GstRTPST_2022_1_FecDec * dec, Rtp2DFecHeader * fec, GList * packets,
   xored_padding = fec->padding;
   xored_extension = fec->extension;
 
-  for (tmp = packets; tmp; tmp = tmp->next) {
+  for (i = 0; i < n_packets; i++) {
     GstRTPBuffer media_rtp = GST_RTP_BUFFER_INIT;
-    Item *item = (Item *) tmp->data;
 
-    gst_rtp_buffer_map (item->buffer, GST_MAP_READ, &media_rtp);
+    gst_rtp_buffer_map (packets[i], GST_MAP_READ, &media_rtp);
     _xor_mem (xored, gst_rtp_buffer_get_payload (&media_rtp),
         MIN (gst_rtp_buffer_get_payload_len (&media_rtp), xored_payload_len));
     xored_timestamp ^= gst_rtp_buffer_get_timestamp (&media_rtp);
@@ -457,7 +539,7 @@ xor_items (GstRTPST_2022_1_FecDec * dec, Rtp2DFecHeader * fec, GList * packets,
       "Recovered buffer through %s FEC with seqnum %u, payload len %u and timestamp %u",
       fec->D ? "row" : "column", seqnum, xored_payload_len, xored_timestamp);
 
-  GST_BUFFER_DTS (item->buffer) = dec->max_arrival_time;
+  GST_BUFFER_DTS (buffer) = dec->max_arrival_time;
 
   gst_rtp_buffer_set_timestamp (&rtp, xored_timestamp);
   gst_rtp_buffer_set_seq (&rtp, seqnum);
@@ -468,27 +550,15 @@ xor_items (GstRTPST_2022_1_FecDec * dec, Rtp2DFecHeader * fec, GList * packets,
 
   gst_rtp_buffer_unmap (&rtp);
 
-  /* Store a ref on item->buffer as store_media_item may
-   * recurse and call this method again, potentially releasing
-   * the object lock and leaving our item unprotected in
-   * dec->packets
-   */
-  buffer = gst_buffer_ref (item->buffer);
-
   /* It is right that we should celebrate,
-   * for your brother was dead, and is alive again */
-  gst_rtp_buffer_map (item->buffer, GST_MAP_READ, &rtp);
-  ret = store_media_item (dec, &rtp, item);
-  gst_rtp_buffer_unmap (&rtp);
+   * for your brother was dead, and is alive again.
+   * Storing it may recover more packets, which are pushed before this
+   * one like in the case of a media packet. */
+  ret = store_media_buffer (dec, seqnum, gst_buffer_ref (buffer), recovered);
 
-  if (ret == GST_FLOW_OK) {
-    /* Unlocking here is safe */
-    GST_OBJECT_UNLOCK (dec);
-    ret = gst_pad_push (dec->srcpad, buffer);
-    GST_OBJECT_LOCK (dec);
-  } else {
-    gst_buffer_unref (buffer);
-  }
+  if (*recovered == NULL)
+    *recovered = gst_buffer_list_new ();
+  gst_buffer_list_add (*recovered, buffer);
 
 done:
   return ret;
@@ -496,9 +566,11 @@ done:
 
 /* Returns a flow value if we should discard the packet, GST_FLOW_CUSTOM_SUCCESS otherwise */
 static GstFlowReturn
-check_fec (GstRTPST_2022_1_FecDec * dec, Rtp2DFecHeader * fec)
+check_fec (GstRTPST_2022_1_FecDec * dec, Rtp2DFecHeader * fec,
+    GstBufferList ** recovered)
 {
-  GList *packets = NULL;
+  /* L and D are 8 bits in the FEC header */
+  GstBuffer *packets[G_MAXUINT8];
   gint missing_seq = -1;
   guint n_packets = 0;
   guint required_n_packets;
@@ -510,10 +582,10 @@ check_fec (GstRTPST_2022_1_FecDec * dec, Rtp2DFecHeader * fec)
     required_n_packets = dec->l;
 
     for (i = 0; i < dec->l; i++) {
-      Item *item = lookup_media_packet (dec, fec->seq + i);
+      GstBuffer *buffer = lookup_media_packet (dec, fec->seq + i);
 
-      if (item) {
-        packets = g_list_prepend (packets, item);
+      if (buffer) {
+        packets[n_packets] = buffer;
         n_packets += 1;
       } else {
         missing_seq = fec->seq + i;
@@ -525,10 +597,10 @@ check_fec (GstRTPST_2022_1_FecDec * dec, Rtp2DFecHeader * fec)
     required_n_packets = dec->d;
 
     for (i = 0; i < dec->d; i++) {
-      Item *item = lookup_media_packet (dec, fec->seq + i * dec->l);
+      GstBuffer *buffer = lookup_media_packet (dec, fec->seq + i * dec->l);
 
-      if (item) {
-        packets = g_list_prepend (packets, item);
+      if (buffer) {
+        packets[n_packets] = buffer;
         n_packets += 1;
       } else {
         missing_seq = fec->seq + i * dec->l;
@@ -542,19 +614,19 @@ check_fec (GstRTPST_2022_1_FecDec * dec, Rtp2DFecHeader * fec)
         "All media packets present, we can discard that FEC packet");
   } else if (n_packets + 1 == required_n_packets) {
     g_assert (missing_seq != -1);
-    ret = xor_items (dec, fec, packets, missing_seq);
     GST_LOG_OBJECT (dec, "We have enough info to reconstruct %u", missing_seq);
+    ret = xor_items (dec, fec, packets, n_packets, missing_seq, recovered);
   } else {
     ret = GST_FLOW_CUSTOM_SUCCESS;
     GST_LOG_OBJECT (dec, "Too many media packets missing, storing FEC packet");
   }
-  g_list_free (packets);
 
   return ret;
 }
 
 static GstFlowReturn
-check_fec_item (GstRTPST_2022_1_FecDec * dec, Item * item)
+check_fec_item (GstRTPST_2022_1_FecDec * dec, Item * item,
+    GstBufferList ** recovered)
 {
   Rtp2DFecHeader fec;
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
@@ -564,33 +636,35 @@ check_fec_item (GstRTPST_2022_1_FecDec * dec, Item * item)
 
   parse_header (&rtp, &fec);
 
-  ret = check_fec (dec, &fec);
+  ret = check_fec (dec, &fec, recovered);
 
   gst_rtp_buffer_unmap (&rtp);
 
   return ret;
 }
 
+/* Takes ownership of @buffer. Packets that can be recovered thanks to it
+ * are added to @recovered, which is created if needed. */
 static GstFlowReturn
-store_media_item (GstRTPST_2022_1_FecDec * dec, GstRTPBuffer * rtp, Item * item)
+store_media_buffer (GstRTPST_2022_1_FecDec * dec, guint16 seq,
+    GstBuffer * buffer, GstBufferList ** recovered)
 {
   GstFlowReturn ret = GST_FLOW_OK;
   Item *fec_item;
-  guint16 seq;
-
-  seq = gst_rtp_buffer_get_seq (rtp);
 
-  g_sequence_insert_sorted (dec->packets, item, (GCompareDataFunc) cmp_items,
-      NULL);
+  if (!insert_media_packet (dec, seq, buffer)) {
+    GST_LOG_OBJECT (dec, "Not storing media packet with seq %u", seq);
+    return ret;
+  }
 
   if ((fec_item = get_row_fec (dec, seq))) {
-    ret = check_fec_item (dec, fec_item);
+    ret = check_fec_item (dec, fec_item, recovered);
     if (ret == GST_FLOW_CUSTOM_SUCCESS)
       ret = GST_FLOW_OK;
   }
 
   if (ret == GST_FLOW_OK && (fec_item = get_column_fec (dec, seq))) {
-    ret = check_fec_item (dec, fec_item);
+    ret = check_fec_item (dec, fec_item, recovered);
     if (ret == GST_FLOW_CUSTOM_SUCCESS)
       ret = GST_FLOW_OK;
   }
@@ -598,19 +672,25 @@ store_media_item (GstRTPST_2022_1_FecDec * dec, GstRTPBuffer * rtp, Item * item)
   return ret;
 }
 
+/* Must be called with the object lock, returns GST_FLOW_CUSTOM_ERROR if
+ * @buffer isn't valid RTP */
 static GstFlowReturn
-store_media (GstRTPST_2022_1_FecDec * dec, GstRTPBuffer * rtp,
-    GstBuffer * buffer)
+store_media (GstRTPST_2022_1_FecDec * dec, GstBuffer * buffer,
+    GstBufferList ** recovered)
 {
-  Item *item;
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
   guint16 seq;
 
-  seq = gst_rtp_buffer_get_seq (rtp);
-  item = g_malloc0 (sizeof (Item));
-  item->buffer = gst_buffer_ref (buffer);
-  item->seq = seq;
+  if (!gst_rtp_buffer_map (buffer, GST_MAP_READ, &rtp))
+    return GST_FLOW_CUSTOM_ERROR;
+  seq = gst_rtp_buffer_get_seq (&rtp);
+  gst_rtp_buffer_unmap (&rtp);
 
-  return store_media_item (dec, rtp, item);
+  dec->max_arrival_time =
+      MAX (dec->max_arrival_time, GST_BUFFER_DTS_OR_PTS (buffer));
+  trim_items (dec);
+
+  return store_media_buffer (dec, seq, gst_buffer_ref (buffer), recovered);
 }
 
 static GstFlowReturn
@@ -624,6 +704,7 @@ gst_rtpst_2022_1_fecdec_sink_chain_fec (GstPad * pad, GstObject * parent,
   GstFlowReturn ret = GST_FLOW_OK;
   Item *item;
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  GstBufferList *recovered = NULL;
 
   GST_OBJECT_LOCK (dec);
 
@@ -678,7 +759,7 @@ gst_rtpst_2022_1_fecdec_sink_chain_fec (GstPad * pad, GstObject * parent,
   dec->max_fec_arrival_time[fec.D] = GST_BUFFER_DTS_OR_PTS (buffer);
   trim_fec_items (dec, fec.D);
 
-  ret = check_fec (dec, &fec);
+  ret = check_fec (dec, &fec, &recovered);
 
   if (ret == GST_FLOW_CUSTOM_SUCCESS) {
     item = g_malloc0 (sizeof (Item));
@@ -706,6 +787,10 @@ gst_rtpst_2022_1_fecdec_sink_chain_fec (GstPad * pad, GstObject * parent,
 
 done:
   GST_OBJECT_UNLOCK (dec);
+
+  if (recovered)
+    ret = gst_pad_push_list (dec->srcpad, recovered);
+
   return ret;
 
 discard:
@@ -722,34 +807,81 @@ gst_rtpst_2022_1_fecdec_sink_chain (GstPad * pad, GstObject * parent,
     GstBuffer * buffer)
 {
   GstRTPST_2022_1_FecDec *dec = GST_RTPST_2022_1_FECDEC_CAST (parent);
-  GstFlowReturn ret = GST_FLOW_OK;
-  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  GstFlowReturn ret;
+  GstBufferList *recovered = NULL;
 
-  if (!gst_rtp_buffer_map (buffer, GST_MAP_READ, &rtp)) {
+  GST_OBJECT_LOCK (dec);
+  ret = store_media (dec, buffer, &recovered);
+  GST_OBJECT_UNLOCK (dec);
+
+  if (ret == GST_FLOW_CUSTOM_ERROR) {
     GST_WARNING_OBJECT (pad, "Chained buffer isn't valid RTP");
+    ret = GST_FLOW_OK;
+    goto error;
+  } else if (ret != GST_FLOW_OK) {
+    GST_WARNING_OBJECT (pad, "Failed to store media buffer: %s",
+        gst_flow_get_name (ret));
     goto error;
   }
 
-  GST_OBJECT_LOCK (dec);
-  dec->max_arrival_time =
-      MAX (dec->max_arrival_time, GST_BUFFER_DTS_OR_PTS (buffer));
-  trim_items (dec);
-  ret = store_media (dec, &rtp, buffer);
-  GST_OBJECT_UNLOCK (dec);
-
-  gst_rtp_buffer_unmap (&rtp);
+  if (recovered)
+    ret = gst_pad_push_list (dec->srcpad, recovered);
 
   if (ret == GST_FLOW_OK)
     ret = gst_pad_push (dec->srcpad, buffer);
+  else
+    gst_buffer_unref (buffer);
 
 done:
   return ret;
 
 error:
+  if (recovered)
+    gst_buffer_list_unref (recovered);
   gst_buffer_unref (buffer);
   goto done;
 }
 
+static GstFlowReturn
+gst_rtpst_2022_1_fecdec_sink_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  GstRTPST_2022_1_FecDec *dec = GST_RTPST_2022_1_FECDEC_CAST (parent);
+  guint i, length = gst_buffer_list_length (list);
+  GstBufferList *out = gst_buffer_list_new_sized (length);
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  /* Handle the whole list with the lock taken once, recovered packets
+   * are output right before the media packet that allowed recovering
+   * them, like in the non-list case. Invalid packets are dropped and
+   * a failure drops the whole list, also like in the non-list case. */
+  GST_OBJECT_LOCK (dec);
+  for (i = 0; i < length && ret == GST_FLOW_OK; i++) {
+    GstBuffer *buffer = gst_buffer_list_get (list, i);
+
+    ret = store_media (dec, buffer, &out);
+    if (ret == GST_FLOW_CUSTOM_ERROR) {
+      GST_WARNING_OBJECT (pad, "Chained buffer isn't valid RTP");
+      ret = GST_FLOW_OK;
+    } else if (ret != GST_FLOW_OK) {
+      GST_WARNING_OBJECT (pad, "Failed to store media buffer: %s",
+          gst_flow_get_name (ret));
+    } else {
+      gst_buffer_list_add (out, gst_buffer_ref (buffer));
+    }
+  }
+  GST_OBJECT_UNLOCK (dec);
+
+  gst_buffer_list_unref (list);
+
+  if (ret != GST_FLOW_OK || gst_buffer_list_length (out) == 0) {
+    gst_buffer_list_unref (out);
+    return ret;
+  }
+
+  return gst_pad_push_list (dec->srcpad, out);
+}
+
 static gboolean
 gst_rtpst_2022_1_fecdec_src_event (GstPad * pad, GstObject * parent,
     GstEvent * event)
@@ -773,7 +905,8 @@ gst_rtpst_2022_1_fecdec_reset (GstRTPST_2022_1_FecDec * dec, gboolean allocate)
   GST_OBJECT_LOCK (dec);
 
   if (dec->packets) {
-    g_sequence_free (dec->packets);
+    clear_media_packets (dec);
+    g_free (dec->packets);
     dec->packets = NULL;
   }
 
@@ -783,7 +916,8 @@ gst_rtpst_2022_1_fecdec_reset (GstRTPST_2022_1_FecDec * dec, gboolean allocate)
   }
 
   if (allocate) {
-    dec->packets = g_sequence_new ((GDestroyNotify) free_item);
+    dec->packets = g_new0 (GstBuffer *, MIN_MEDIA_PACKETS);
+    dec->packets_mask = MIN_MEDIA_PACKETS - 1;
     dec->column_fec_packets = g_hash_table_new (g_direct_hash, g_direct_equal);
   }
 
@@ -1002,6 +1136,8 @@ gst_rtpst_2022_1_fecdec_init (GstRTPST_2022_1_FecDec * dec)
   dec->sinkpad = gst_pad_new_from_static_template (&sink_template, "sink");
   GST_PAD_SET_PROXY_CAPS (dec->sinkpad);
   gst_pad_set_chain_function (dec->sinkpad, gst_rtpst_2022_1_fecdec_sink_chain);
+  gst_pad_set_chain_list_function (dec->sinkpad,
+      gst_rtpst_2022_1_fecdec_sink_chain_list);
   gst_pad_set_event_function (dec->sinkpad,
       GST_DEBUG_FUNCPTR (gst_2d_fec_sink_event));
   gst_pad_set_iterate_internal_links_function (dec->sinkpad,
@@ -98,7 +98,10 @@ typedef struct
 
 typedef struct
 {
+  /* Kept around from one FEC packet to the next */
   guint8 *xored_payload;
+  guint payload_size;
+
   guint32 xored_timestamp;
   guint8 xored_pt;
   guint16 xored_payload_len;
@@ -220,23 +223,46 @@ free_fec_packet (FecPacket * packet)
   g_free (packet);
 }
 
+/* Resets @packet for the next row or column, keeping its payload memory */
 static void
-_xor_mem (guint8 * restrict dst, const guint8 * restrict src, gsize length)
+fec_packet_reset (FecPacket * packet)
 {
-  guint i;
+  guint8 *xored_payload = packet->xored_payload;
+  guint payload_size = packet->payload_size;
 
-  for (i = 0; i < (length / sizeof (guint64)); ++i) {
-#if G_BYTE_ORDER == G_LITTLE_ENDIAN
-    GST_WRITE_UINT64_LE (dst,
-        GST_READ_UINT64_LE (dst) ^ GST_READ_UINT64_LE (src));
-#else
-    GST_WRITE_UINT64_BE (dst,
-        GST_READ_UINT64_BE (dst) ^ GST_READ_UINT64_BE (src));
-#endif
-    dst += sizeof (guint64);
-    src += sizeof (guint64);
+  memset (packet, 0x00, sizeof (FecPacket));
+  packet->xored_payload = xored_payload;
+  packet->payload_size = payload_size;
+}
+
+static void
+fec_packet_ensure_payload_size (FecPacket * fec, guint size)
+{
+  if (fec->payload_size < size) {
+    fec->xored_payload = g_realloc (fec->xored_payload, size);
+    fec->payload_size = size;
+  }
+}
+
+/* XORs 32 bytes per iteration, which compilers turn into vector
+ * instructions, the payloads don't need to be aligned for this */
+static void
+_xor_mem (guint8 * restrict dst, const guint8 * restrict src, gsize length)
+{
+  gsize i;
+
+  for (i = 0; i + 4 * sizeof (guint64) <= length; i += 4 * sizeof (guint64)) {
+    guint64 d[4], s[4];
+
+    memcpy (d, dst + i, sizeof (d));
+    memcpy (s, src + i, sizeof (s));
+    d[0] ^= s[0];
+    d[1] ^= s[1];
+    d[2] ^= s[2];
+    d[3] ^= s[3];
+    memcpy (dst + i, d, sizeof (d));
   }
-  for (i = 0; i < (length % sizeof (guint64)); ++i)
+  for (; i < length; ++i)
     dst[i] ^= src[i];
 }
 
@@ -252,15 +278,14 @@ fec_packet_update (FecPacket * fec, GstRTPBuffer * rtp)
     fec->xored_marker = gst_rtp_buffer_get_marker (rtp);
     fec->xored_padding = gst_rtp_buffer_get_padding (rtp);
     fec->xored_extension = gst_rtp_buffer_get_extension (rtp);
-    fec->xored_payload = g_malloc (sizeof (guint8) * fec->payload_len);
+    fec_packet_ensure_payload_size (fec, fec->payload_len);
     memcpy (fec->xored_payload, gst_rtp_buffer_get_payload (rtp),
         fec->payload_len);
   } else {
     guint plen = gst_rtp_buffer_get_payload_len (rtp);
 
     if (fec->payload_len < plen) {
-      fec->xored_payload =
-          g_realloc (fec->xored_payload, sizeof (guint8) * plen);
+      fec_packet_ensure_payload_size (fec, plen);
       memset (fec->xored_payload + fec->payload_len, 0,
           plen - fec->payload_len);
       fec->payload_len = plen;
@@ -299,7 +324,9 @@ push_initial_events (GstRTPST_2022_1_FecEnc * enc, GstPad * pad,
   gst_pad_push_event (pad, gst_event_new_segment (&segment));
 }
 
-static void
+/* Returns row FEC packets, which are sent out right away, and queues column
+ * FEC packets */
+static GstBuffer *
 queue_fec_packet (GstRTPST_2022_1_FecEnc * enc, FecPacket * fec, gboolean row)
 {
   GstBuffer *buffer = gst_rtp_buffer_new_allocate (fec->payload_len + 16, 0, 0);
@@ -347,20 +374,11 @@ queue_fec_packet (GstRTPST_2022_1_FecEnc * enc, FecPacket * fec, gboolean row)
    * delaying by L <= delay < L * D
    */
   if (row) {
-    GstFlowReturn ret;
-
     GST_LOG_OBJECT (enc,
         "Pushing row FEC packet, seq base: %u, media seqnum: %u",
         fec->seq_base, enc->last_media_seqnum);
 
-    /* Safe to unlock here */
-    GST_OBJECT_UNLOCK (enc);
-    ret = gst_pad_push (enc->row_fec_srcpad, buffer);
-    GST_OBJECT_LOCK (enc);
-
-    if (ret != GST_FLOW_OK && ret != GST_FLOW_FLUSHING)
-      GST_WARNING_OBJECT (enc->row_fec_srcpad,
-          "Failed to push row FEC packet: %s", gst_flow_get_name (ret));
+    return buffer;
   } else {
     Item *item = g_malloc0 (sizeof (Item));
 
@@ -373,14 +391,17 @@ queue_fec_packet (GstRTPST_2022_1_FecEnc * enc, FecPacket * fec, gboolean row)
 
     g_queue_push_tail (&enc->queued_column_packets, item);
   }
+
+  return NULL;
 }
 
-static void
-gst_2d_fec_push_item_unlocked (GstRTPST_2022_1_FecEnc * enc)
+/* Dequeues the next column FEC packet to send out */
+static GstBuffer *
+gst_2d_fec_pop_item (GstRTPST_2022_1_FecEnc * enc)
 {
-  GstFlowReturn ret;
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
   Item *item = g_queue_pop_head (&enc->queued_column_packets);
+  GstBuffer *buffer;
 
   GST_LOG_OBJECT (enc,
       "Pushing column FEC packet, target media seq: %u, seq base: %u, "
@@ -389,22 +410,41 @@ gst_2d_fec_push_item_unlocked (GstRTPST_2022_1_FecEnc * enc)
   gst_rtp_buffer_map (item->buffer, GST_MAP_WRITE, &rtp);
   gst_rtp_buffer_set_timestamp (&rtp, enc->last_media_timestamp);
   gst_rtp_buffer_unmap (&rtp);
-  GST_OBJECT_UNLOCK (enc);
-  ret = gst_pad_push (enc->column_fec_srcpad, gst_buffer_ref (item->buffer));
-  GST_OBJECT_LOCK (enc);
-
-  if (ret != GST_FLOW_OK && ret != GST_FLOW_FLUSHING)
-    GST_WARNING_OBJECT (enc->column_fec_srcpad,
-        "Failed to push column FEC packet: %s", gst_flow_get_name (ret));
 
+  buffer = gst_buffer_ref (item->buffer);
   free_item (item);
+
+  return buffer;
+}
+
+/* Must be called without the object lock */
+static void
+gst_2d_fec_push_fec_packets (GstRTPST_2022_1_FecEnc * enc, GstBuffer * row_fec,
+    GstBuffer * column_fec)
+{
+  GstFlowReturn ret;
+
+  if (row_fec) {
+    ret = gst_pad_push (enc->row_fec_srcpad, row_fec);
+    if (ret != GST_FLOW_OK && ret != GST_FLOW_FLUSHING)
+      GST_WARNING_OBJECT (enc->row_fec_srcpad,
+          "Failed to push row FEC packet: %s", gst_flow_get_name (ret));
+  }
+
+  if (column_fec) {
+    ret = gst_pad_push (enc->column_fec_srcpad, column_fec);
+    if (ret != GST_FLOW_OK && ret != GST_FLOW_FLUSHING)
+      GST_WARNING_OBJECT (enc->column_fec_srcpad,
+          "Failed to push column FEC packet: %s", gst_flow_get_name (ret));
+  }
 }
 
+/* Updates the FEC packets with @buffer and returns the ones that are due
+ * in @row_fec and @column_fec, to be pushed right before @buffer */
 static GstFlowReturn
-gst_rtpst_2022_1_fecenc_sink_chain (GstPad * pad, GstObject * parent,
-    GstBuffer * buffer)
+gst_rtpst_2022_1_fecenc_process (GstRTPST_2022_1_FecEnc * enc,
+    GstBuffer * buffer, GstBuffer ** row_fec, GstBuffer ** column_fec)
 {
-  GstRTPST_2022_1_FecEnc *enc = GST_RTPST_2022_1_FECENC_CAST (parent);
   GstFlowReturn ret = GST_FLOW_OK;
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
 
@@ -444,9 +484,8 @@ gst_rtpst_2022_1_fecenc_sink_chain (GstPad * pad, GstObject * parent,
     g_assert (enc->row->n_packets < enc->l);
     fec_packet_update (enc->row, &rtp);
     if (enc->row->n_packets == enc->l) {
-      queue_fec_packet (enc, enc->row, TRUE);
-      g_free (enc->row->xored_payload);
-      memset (enc->row, 0x00, sizeof (FecPacket));
+      *row_fec = queue_fec_packet (enc, enc->row, TRUE);
+      fec_packet_reset (enc->row);
     }
   }
 
@@ -456,8 +495,7 @@ gst_rtpst_2022_1_fecenc_sink_chain (GstPad * pad, GstObject * parent,
     fec_packet_update (column, &rtp);
     if (column->n_packets == enc->d) {
       queue_fec_packet (enc, column, FALSE);
-      g_free (column->xored_payload);
-      memset (column, 0x00, sizeof (FecPacket));
+      fec_packet_reset (column);
     }
 
     enc->current_column++;
@@ -469,24 +507,103 @@ gst_rtpst_2022_1_fecenc_sink_chain (GstPad * pad, GstObject * parent,
   {
     Item *item = g_queue_peek_head (&enc->queued_column_packets);
     if (item && item->target_media_seq == enc->last_media_seqnum)
-      gst_2d_fec_push_item_unlocked (enc);
+      *column_fec = gst_2d_fec_pop_item (enc);
   }
 
   GST_OBJECT_UNLOCK (enc);
 
-  ret = gst_pad_push (enc->srcpad, buffer);
-
 done:
   return ret;
 
 error:
   if (rtp.buffer)
     gst_rtp_buffer_unmap (&rtp);
-  gst_buffer_unref (buffer);
   ret = GST_FLOW_ERROR;
   goto done;
 }
 
+static GstFlowReturn
+gst_rtpst_2022_1_fecenc_sink_chain (GstPad * pad, GstObject * parent,
+    GstBuffer * buffer)
+{
+  GstRTPST_2022_1_FecEnc *enc = GST_RTPST_2022_1_FECENC_CAST (parent);
+  GstBuffer *row_fec = NULL, *column_fec = NULL;
+  GstFlowReturn ret;
+
+  ret = gst_rtpst_2022_1_fecenc_process (enc, buffer, &row_fec, &column_fec);
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (buffer);
+    return ret;
+  }
+
+  gst_2d_fec_push_fec_packets (enc, row_fec, column_fec);
+
+  return gst_pad_push (enc->srcpad, buffer);
+}
+
+/* Pushes the media packets from @start to @end of @list */
+static GstFlowReturn
+gst_rtpst_2022_1_fecenc_push_media (GstRTPST_2022_1_FecEnc * enc,
+    GstBufferList * list, guint start, guint end)
+{
+  GstBufferList *sublist;
+  guint i;
+
+  if (start == 0 && end == gst_buffer_list_length (list))
+    return gst_pad_push_list (enc->srcpad, gst_buffer_list_ref (list));
+
+  sublist = gst_buffer_list_new_sized (end - start);
+  for (i = start; i < end; i++)
+    gst_buffer_list_add (sublist,
+        gst_buffer_ref (gst_buffer_list_get (list, i)));
+
+  return gst_pad_push_list (enc->srcpad, sublist);
+}
+
+static GstFlowReturn
+gst_rtpst_2022_1_fecenc_sink_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  GstRTPST_2022_1_FecEnc *enc = GST_RTPST_2022_1_FECENC_CAST (parent);
+  GstFlowReturn ret = GST_FLOW_OK, process_ret = GST_FLOW_OK;
+  guint i, start = 0, length = gst_buffer_list_length (list);
+
+  for (i = 0; i < length; i++) {
+    GstBuffer *row_fec = NULL, *column_fec = NULL;
+
+    process_ret = gst_rtpst_2022_1_fecenc_process (enc,
+        gst_buffer_list_get (list, i), &row_fec, &column_fec);
+    if (process_ret != GST_FLOW_OK)
+      break;
+
+    if (row_fec || column_fec) {
+      /* Like with single buffers, the FEC packets go out right before the
+       * media packet that completed them */
+      if (i > start) {
+        ret = gst_rtpst_2022_1_fecenc_push_media (enc, list, start, i);
+        start = i;
+      }
+
+      gst_2d_fec_push_fec_packets (enc, row_fec, column_fec);
+
+      if (ret != GST_FLOW_OK)
+        goto done;
+    }
+  }
+
+  /* On errors, the media packets before the invalid one still go out */
+  if (i > start)
+    ret = gst_rtpst_2022_1_fecenc_push_media (enc, list, start, i);
+
+  if (process_ret != GST_FLOW_OK)
+    ret = process_ret;
+
+done:
+  gst_buffer_list_unref (list);
+
+  return ret;
+}
+
 static GstIterator *
 gst_rtpst_2022_1_fecenc_iterate_linked_pads (GstPad * pad, GstObject * parent)
 {
@@ -632,9 +749,7 @@ gst_rtpst_2022_1_fecenc_set_property (GObject * object, guint prop_id,
 
         if (enc->columns) {
           for (i = 0; i < enc->l; i++) {
-            FecPacket *column = g_ptr_array_index (enc->columns, i);
-            g_free (column->xored_payload);
-            memset (column, 0x00, sizeof (FecPacket));
+            fec_packet_reset (g_ptr_array_index (enc->columns, i));
           }
         }
         enc->current_column = 0;
@@ -700,8 +815,13 @@ gst_2d_fec_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
     case GST_EVENT_EOS:
       gst_pad_push_event (enc->row_fec_srcpad, gst_event_ref (event));
       GST_OBJECT_LOCK (enc);
-      while (g_queue_peek_head (&enc->queued_column_packets))
-        gst_2d_fec_push_item_unlocked (enc);
+      while (g_queue_peek_head (&enc->queued_column_packets)) {
+        GstBuffer *column_fec = gst_2d_fec_pop_item (enc);
+
+        GST_OBJECT_UNLOCK (enc);
+        gst_2d_fec_push_fec_packets (enc, NULL, column_fec);
+        GST_OBJECT_LOCK (enc);
+      }
       GST_OBJECT_UNLOCK (enc);
       gst_pad_push_event (enc->column_fec_srcpad, gst_event_ref (event));
       break;
@@ -792,6 +912,8 @@ gst_rtpst_2022_1_fecenc_init (GstRTPST_2022_1_FecEnc * enc)
   enc->sinkpad = gst_pad_new_from_static_template (&sink_template, "sink");
   GST_PAD_SET_PROXY_CAPS (enc->sinkpad);
   gst_pad_set_chain_function (enc->sinkpad, gst_rtpst_2022_1_fecenc_sink_chain);
+  gst_pad_set_chain_list_function (enc->sinkpad,
+      gst_rtpst_2022_1_fecenc_sink_chain_list);
   gst_pad_set_event_function (enc->sinkpad,
       GST_DEBUG_FUNCPTR (gst_2d_fec_sink_event));
   gst_pad_set_iterate_internal_links_function (enc->sinkpad,
@@ -748,6 +748,7 @@ rtp_session_init (RTPSession * sess)
   sess->timestamp_sender_reports = !DEFAULT_RTCP_DISABLE_SR_TIMESTAMP;
 
   sess->is_doing_ptp = TRUE;
+  sess->ptp_dirty = FALSE;
 
   sess->twcc = rtp_twcc_manager_new (sess->mtu);
   sess->twcc_stats = rtp_twcc_stats_new ();
@@ -1213,6 +1214,7 @@ rtp_session_reset (RTPSession * sess)
   sess->stats.nacks_received = 0;
 
   sess->is_doing_ptp = TRUE;
+  sess->ptp_dirty = FALSE;
 
   g_list_free_full (sess->conflicting_addresses,
       (GDestroyNotify) rtp_conflicting_address_free);
@@ -1713,6 +1715,7 @@ check_collision (RTPSession * sess, RTPSource * source,
               rtp_source_set_rtp_from (source, pinfo->address);
             else
               rtp_source_set_rtcp_from (source, pinfo->address);
+            sess->ptp_dirty = TRUE;
 
             g_free (buf1);
             g_free (buf2);
@@ -1730,6 +1733,7 @@ check_collision (RTPSession * sess, RTPSource * source,
         rtp_source_set_rtp_from (source, pinfo->address);
       else
         rtp_source_set_rtcp_from (source, pinfo->address);
+      sess->ptp_dirty = TRUE;
       return FALSE;
     }
 
@@ -1804,7 +1808,9 @@ compare_rtcp_source_addr (const gchar * key, RTPSource * source,
 }
 
 /* loop over our non-internal source to know if the session
- * is doing point-to-point */
+ * is doing point-to-point. This is only done when a source was added or
+ * removed or an address changed since the last time, with thousands of
+ * sources it is too expensive to do for every new source. */
 static void
 session_update_ptp (RTPSession * sess)
 {
@@ -1816,6 +1822,10 @@ session_update_ptp (RTPSession * sess)
   gboolean is_doing_rtcp_ptp;
   CompareAddrData data;
 
+  if (!sess->ptp_dirty)
+    return;
+  sess->ptp_dirty = FALSE;
+
   /* compare the first remote source's ip addr that receive rtp packets
    * with other remote rtp source.
    * it's enough because the session just needs to know if they are all
@@ -1863,7 +1873,7 @@ add_source (RTPSession * sess, RTPSource * src)
 
   /* update point-to-point status */
   if (!src->internal)
-    session_update_ptp (sess);
+    sess->ptp_dirty = TRUE;
 }
 
 static RTPSource *
@@ -2968,8 +2978,6 @@ rtp_session_process_twcc (RTPSession * sess, guint32 sender_ssrc,
   GST_DEBUG_OBJECT (sess, "Parsed TWCC: %" GST_PTR_FORMAT, twcc_packets_s);
   GST_INFO_OBJECT (sess, "Current TWCC stats %" GST_PTR_FORMAT, twcc_stats_s);
 
-  g_array_unref (twcc_packets);
-
   RTP_SESSION_UNLOCK (sess);
   if (sess->callbacks.notify_twcc)
     sess->callbacks.notify_twcc (sess, twcc_packets_s, twcc_stats_s,
@@ -3791,6 +3799,11 @@ typedef struct
   gboolean may_suppress;
   GQueue output;
   guint nacked_seqnums;
+  /* remote sources that need a report block in this generation, collected
+   * once for all internal sources */
+  GPtrArray *report_sources;
+  /* sources with pending FIR, PLI or NACK requests */
+  GPtrArray *feedback_sources;
 } ReportData;
 
 static void
@@ -3837,16 +3850,19 @@ session_start_rtcp (RTPSession * sess, ReportData * data)
   }
 }
 
-/* construct a Sender or Receiver Report */
+/* only remote senders with RTCP enabled get a report block */
+static gboolean
+source_needs_report_block (RTPSource * source)
+{
+  return !source->internal && RTP_SOURCE_IS_SENDER (source)
+      && !source->disable_rtcp;
+}
+
 static void
-session_report_blocks (const gchar * key, RTPSource * source, ReportData * data)
+collect_report_sources (const gchar * key, RTPSource * source,
+    ReportData * data)
 {
   RTPSession *sess = data->sess;
-  GstRTCPPacket *packet = &data->packet;
-  guint8 fractionlost;
-  gint32 packetslost;
-  guint32 exthighestseq, jitter;
-  guint32 lsr, dlsr;
 
   /* don't report for sources in future generations */
   if (((gint16) (source->generation - sess->generation)) > 0) {
@@ -3855,29 +3871,36 @@ session_report_blocks (const gchar * key, RTPSource * source, ReportData * data)
     return;
   }
 
-  if (g_hash_table_contains (source->reported_in_sr_of,
-          GUINT_TO_POINTER (data->source->ssrc))) {
-    GST_DEBUG ("source %08x already reported in this generation", source->ssrc);
+  if (!source_needs_report_block (source)) {
+    GST_DEBUG ("source %08x not reported, internal %d, sender %d, "
+        "RTCP disabled %d", source->ssrc, source->internal,
+        RTP_SOURCE_IS_SENDER (source), source->disable_rtcp);
     return;
   }
 
-  if (gst_rtcp_packet_get_rb_count (packet) == GST_RTCP_MAX_RB_COUNT) {
-    GST_DEBUG ("max RB count reached");
-    return;
-  }
+  g_ptr_array_add (data->report_sources, source);
+}
 
-  /* only report about remote sources */
-  if (source->internal)
-    goto reported;
+/* construct a Sender or Receiver Report block, returns %FALSE when the
+ * packet is full */
+static gboolean
+session_report_block (RTPSource * source, ReportData * data)
+{
+  GstRTCPPacket *packet = &data->packet;
+  guint8 fractionlost;
+  gint32 packetslost;
+  guint32 exthighestseq, jitter;
+  guint32 lsr, dlsr;
 
-  if (!RTP_SOURCE_IS_SENDER (source)) {
-    GST_DEBUG ("source %08x not sender", source->ssrc);
-    goto reported;
+  if (g_hash_table_contains (source->reported_in_sr_of,
+          GUINT_TO_POINTER (data->source->ssrc))) {
+    GST_DEBUG ("source %08x already reported in this generation", source->ssrc);
+    return TRUE;
   }
 
-  if (source->disable_rtcp) {
-    GST_DEBUG ("source %08x has RTCP disabled", source->ssrc);
-    goto reported;
+  if (gst_rtcp_packet_get_rb_count (packet) == GST_RTCP_MAX_RB_COUNT) {
+    GST_DEBUG ("max RB count reached");
+    return FALSE;
   }
 
   GST_DEBUG ("create RB for SSRC %08x", source->ssrc);
@@ -3900,14 +3923,15 @@ session_report_blocks (const gchar * key, RTPSource * source, ReportData * data)
   gst_rtcp_packet_add_rb (packet, source->ssrc, fractionlost, packetslost,
       exthighestseq, jitter, lsr, dlsr);
 
-reported:
   g_hash_table_add (source->reported_in_sr_of,
       GUINT_TO_POINTER (data->source->ssrc));
+
+  return TRUE;
 }
 
 /* construct FIR */
 static void
-session_add_fir (const gchar * key, RTPSource * source, ReportData * data)
+session_add_fir (RTPSource * source, ReportData * data)
 {
   GstRTCPPacket *packet = &data->packet;
   guint16 len;
@@ -3946,8 +3970,7 @@ session_fir (RTPSession * sess, ReportData * data)
   gst_rtcp_packet_fb_set_sender_ssrc (packet, data->source->ssrc);
   gst_rtcp_packet_fb_set_media_ssrc (packet, 0);
 
-  g_hash_table_foreach (sess->ssrcs[sess->mask_idx],
-      (GHFunc) session_add_fir, data);
+  g_ptr_array_foreach (data->feedback_sources, (GFunc) session_add_fir, data);
 
   if (gst_rtcp_packet_fb_get_fci_length (packet) == 0)
     gst_rtcp_packet_remove (packet);
@@ -3977,7 +4000,7 @@ has_pli_compare_func (gconstpointer a, gconstpointer ignored)
 
 /* construct PLI */
 static void
-session_pli (const gchar * key, RTPSource * source, ReportData * data)
+session_pli (RTPSource * source, ReportData * data)
 {
   GstRTCPBuffer *rtcp = &data->rtcpbuf;
   GstRTCPPacket *packet = &data->packet;
@@ -4005,7 +4028,7 @@ session_pli (const gchar * key, RTPSource * source, ReportData * data)
 
 /* construct NACK */
 static void
-session_nack (const gchar * key, RTPSource * source, ReportData * data)
+session_nack (RTPSource * source, ReportData * data)
 {
   RTPSession *sess = data->sess;
   GstRTCPBuffer *rtcp = &data->rtcpbuf;
@@ -4437,17 +4460,22 @@ is_rtcp_time (RTPSession * sess, GstClockTime current_time, ReportData * data)
 }
 
 static void
-clone_ssrcs_hashtable (gchar * key, RTPSource * source, GHashTable * hash_table)
+clone_ssrcs_array (gchar * key, RTPSource * source, GPtrArray * array)
 {
-  g_hash_table_insert (hash_table, key, g_object_ref (source));
+  g_ptr_array_add (array, g_object_ref (source));
 }
 
 static gboolean
 remove_closing_sources (const gchar * key, RTPSource * source,
     ReportData * data)
 {
-  if (source->closing)
+  RTPSession *sess = data->sess;
+
+  if (source->closing) {
+    if (!source->internal)
+      sess->ptp_dirty = TRUE;
     return TRUE;
+  }
 
   if (source->send_fir)
     data->have_fir = TRUE;
@@ -4455,6 +4483,8 @@ remove_closing_sources (const gchar * key, RTPSource * source,
     data->have_pli = TRUE;
   if (source->send_nack)
     data->have_nack = TRUE;
+  if (source->send_fir || source->send_pli || source->send_nack)
+    g_ptr_array_add (data->feedback_sources, g_object_ref (source));
 
   return FALSE;
 }
@@ -4524,10 +4554,23 @@ generate_rtcp (const gchar * key, RTPSource * source, ReportData * data)
     make_source_bye (sess, source, data);
     is_bye = TRUE;
   } else if (!data->is_early) {
-    /* loop over all known sources and add report blocks. If we are early, we
-     * just make a minimal RTCP packet and skip this step */
-    g_hash_table_foreach (sess->ssrcs[sess->mask_idx],
-        (GHFunc) session_report_blocks, data);
+    guint i;
+
+    /* add report blocks for the remote sources. If we are early, we just make
+     * a minimal RTCP packet and skip this step. The sources are collected
+     * once for all internal sources, the ones that were reported by every
+     * internal source moved to the next generation in the previous round so
+     * each internal source only has to look at a few more than it reports */
+    if (data->report_sources == NULL) {
+      data->report_sources = g_ptr_array_new ();
+      g_hash_table_foreach (sess->ssrcs[sess->mask_idx],
+          (GHFunc) collect_report_sources, data);
+    }
+    for (i = 0; i < data->report_sources->len; i++) {
+      if (!session_report_block (g_ptr_array_index (data->report_sources, i),
+              data))
+        break;
+    }
   }
   if (!data->has_sdes && (!data->is_early || !sess->reduced_size_rtcp
           || sr_req_pending))
@@ -4537,12 +4580,10 @@ generate_rtcp (const gchar * key, RTPSource * source, ReportData * data)
     session_fir (sess, data);
 
   if (data->have_pli)
-    g_hash_table_foreach (sess->ssrcs[sess->mask_idx],
-        (GHFunc) session_pli, data);
+    g_ptr_array_foreach (data->feedback_sources, (GFunc) session_pli, data);
 
   if (data->have_nack)
-    g_hash_table_foreach (sess->ssrcs[sess->mask_idx],
-        (GHFunc) session_nack, data);
+    g_ptr_array_foreach (data->feedback_sources, (GFunc) session_nack, data);
 
   gst_rtcp_buffer_unmap (&data->rtcpbuf);
 
@@ -4558,9 +4599,19 @@ static void
 update_generation (const gchar * key, RTPSource * source, ReportData * data)
 {
   RTPSession *sess = data->sess;
+  gboolean reported;
+
+  if (source_needs_report_block (source)) {
+    reported = g_hash_table_size (source->reported_in_sr_of) >=
+        sess->stats.internal_sources;
+  } else {
+    /* sources without report block are done as soon as reports were made
+     * for this generation */
+    reported = data->report_sources != NULL &&
+        ((gint16) (source->generation - sess->generation)) <= 0;
+  }
 
-  if (g_hash_table_size (source->reported_in_sr_of) >=
-      sess->stats.internal_sources) {
+  if (reported) {
     /* source is reported, move to next generation */
     source->generation = sess->generation + 1;
     g_hash_table_remove_all (source->reported_in_sr_of);
@@ -4577,8 +4628,7 @@ update_generation (const gchar * key, RTPSource * source, ReportData * data)
 }
 
 static void
-schedule_remaining_nacks (const gchar * key, RTPSource * source,
-    ReportData * data)
+schedule_remaining_nacks (RTPSource * source, ReportData * data)
 {
   RTPSession *sess = data->sess;
   GstClockTime *nack_deadlines;
@@ -4599,24 +4649,32 @@ schedule_remaining_nacks (const gchar * key, RTPSource * source,
 }
 
 static gboolean
-rtp_session_are_all_sources_bye (RTPSession * sess)
+rtp_session_are_all_sources_bye_locked (RTPSession * sess)
 {
   GHashTableIter iter;
   RTPSource *src;
 
-  RTP_SESSION_LOCK (sess);
   g_hash_table_iter_init (&iter, sess->ssrcs[sess->mask_idx]);
   while (g_hash_table_iter_next (&iter, NULL, (gpointer *) & src)) {
-    if (src->internal && !src->sent_bye) {
-      RTP_SESSION_UNLOCK (sess);
+    if (src->internal && !src->sent_bye)
       return FALSE;
-    }
   }
-  RTP_SESSION_UNLOCK (sess);
 
   return TRUE;
 }
 
+static gboolean
+rtp_session_are_all_sources_bye (RTPSession * sess)
+{
+  gboolean ret;
+
+  RTP_SESSION_LOCK (sess);
+  ret = rtp_session_are_all_sources_bye_locked (sess);
+  RTP_SESSION_UNLOCK (sess);
+
+  return ret;
+}
+
 /**
  * rtp_session_on_timeout:
  * @sess: an #RTPSession
@@ -4640,10 +4698,12 @@ rtp_session_on_timeout (RTPSession * sess, GstClockTime current_time,
     guint64 ntpnstime, GstClockTime running_time)
 {
   GstFlowReturn result = GST_FLOW_OK;
+  guint i;
   ReportData data = { GST_RTCP_BUFFER_INIT };
-  GHashTable *table_copy;
+  GPtrArray *table_copy;
   ReportOutput *output;
   gboolean all_empty = FALSE;
+  gboolean all_bye = FALSE;
 
   g_return_val_if_fail (RTP_IS_SESSION (sess), GST_FLOW_ERROR);
 
@@ -4658,6 +4718,9 @@ rtp_session_on_timeout (RTPSession * sess, GstClockTime current_time,
   data.num_to_report = 0;
   data.may_suppress = FALSE;
   data.nacked_seqnums = 0;
+  data.report_sources = NULL;
+  data.feedback_sources =
+      g_ptr_array_new_with_free_func ((GDestroyNotify) g_object_unref);
   g_queue_init (&data.output);
 
   RTP_SESSION_LOCK (sess);
@@ -4684,17 +4747,18 @@ rtp_session_on_timeout (RTPSession * sess, GstClockTime current_time,
   sess->conflicting_addresses =
       timeout_conflicting_addresses (sess->conflicting_addresses, current_time);
 
-  /* Make a local copy of the hashtable. We need to do this because the
+  /* Make a local copy of the sources. We need to do this because the
    * cleanup stage below releases the session lock. */
-  table_copy = g_hash_table_new_full (NULL, NULL, NULL,
-      (GDestroyNotify) g_object_unref);
+  table_copy = g_ptr_array_new_full (g_hash_table_size (sess->ssrcs
+          [sess->mask_idx]), (GDestroyNotify) g_object_unref);
   g_hash_table_foreach (sess->ssrcs[sess->mask_idx],
-      (GHFunc) clone_ssrcs_hashtable, table_copy);
+      (GHFunc) clone_ssrcs_array, table_copy);
 
   /* Clean up the session, mark the source for removing, this might release the
    * session lock. */
-  g_hash_table_foreach (table_copy, (GHFunc) session_cleanup, &data);
-  g_hash_table_destroy (table_copy);
+  for (i = 0; i < table_copy->len; i++)
+    session_cleanup (NULL, g_ptr_array_index (table_copy, i), &data);
+  g_ptr_array_unref (table_copy);
 
   /* Now remove the marked sources */
   g_hash_table_foreach_remove (sess->ssrcs[sess->mask_idx],
@@ -4745,9 +4809,16 @@ rtp_session_on_timeout (RTPSession * sess, GstClockTime current_time,
   sess->next_early_rtcp_time = GST_CLOCK_TIME_NONE;
   sess->scheduled_bye = FALSE;
 
+  /* sources only send BYE while generating RTCP above, so if any of them
+   * has not sent one yet it will not during pushing either */
+  all_bye = rtp_session_are_all_sources_bye_locked (sess);
+
 done:
   RTP_SESSION_UNLOCK (sess);
 
+  if (data.report_sources)
+    g_ptr_array_unref (data.report_sources);
+
   /* notify about updated statistics */
   g_object_notify_by_pspec (G_OBJECT (sess), properties[PROP_STATS]);
 
@@ -4775,9 +4846,12 @@ done:
       UPDATE_AVG (sess->stats.avg_rtcp_packet_size, packet_size);
       GST_DEBUG ("%p, sending RTCP packet, avg size %u, %u", &sess->stats,
           sess->stats.avg_rtcp_packet_size, packet_size);
+      /* sources might have been added meanwhile */
+      if (all_bye)
+        all_bye = rtp_session_are_all_sources_bye (sess);
       result =
-          sess->callbacks.send_rtcp (sess, source, buffer,
-          rtp_session_are_all_sources_bye (sess), sess->send_rtcp_user_data);
+          sess->callbacks.send_rtcp (sess, source, buffer, all_bye,
+          sess->send_rtcp_user_data);
 
       RTP_SESSION_LOCK (sess);
       sess->stats.nacks_sent += data.nacked_seqnums;
@@ -4804,9 +4878,10 @@ done:
 
   /* schedule remaining nacks */
   RTP_SESSION_LOCK (sess);
-  g_hash_table_foreach (sess->ssrcs[sess->mask_idx],
-      (GHFunc) schedule_remaining_nacks, &data);
+  g_ptr_array_foreach (data.feedback_sources,
+      (GFunc) schedule_remaining_nacks, &data);
   RTP_SESSION_UNLOCK (sess);
+  g_ptr_array_unref (data.feedback_sources);
 
   return result;
 }
@@ -4879,6 +4954,8 @@ rtp_session_request_early_rtcp (RTPSession * sess, GstClockTime current_time,
 
   T_rr = sess->last_rtcp_interval;
 
+  session_update_ptp (sess);
+
   /*  RFC 4585 section 3.5.2 step 2b */
   /* If the total sources is <=2, then there is only us and one peer */
   /* When there is one auxiliary stream the session can still do point
@@ -305,6 +305,9 @@ struct _RTPSession {
   guint         rtcp_immediate_feedback_threshold;
 
   gboolean      is_doing_ptp;
+  /* set when sources or their addresses changed and is_doing_ptp needs to
+   * be recalculated */
+  gboolean      ptp_dirty;
 
   GList         *conflicting_addresses;
 
@@ -19,8 +19,6 @@
  */
 #include "rtptwcc.h"
 #include <gst/rtp/gstrtcpbuffer.h>
-#include <gst/base/gstbitreader.h>
-#include <gst/base/gstbitwriter.h>
 
 #include "gstrtputils.h"
 
@@ -36,6 +34,11 @@ GST_DEBUG_CATEGORY_EXTERN (rtp_session_debug);
 #define STATUS_VECTOR_MAX_CAPACITY 14
 #define STATUS_VECTOR_TWO_BIT_MAX_CAPACITY 7
 
+/* sizes of the ring of sent packets, the largest one holds a packet for
+   every twcc seqnum */
+#define SENT_PACKETS_MIN_SIZE 512
+#define SENT_PACKETS_MAX_SIZE 65536
+
 typedef enum
 {
   RTP_TWCC_CHUNK_TYPE_RUN_LENGTH = 0,
@@ -83,11 +86,25 @@ struct _RTPTWCCManager
   guint mtu;
   guint max_packets_per_rtcp;
   GArray *recv_packets;
+  GArray *packet_chunks;
+
+  /* the deltas, statuses and runs of the received packets are calculated
+     as they arrive, unless a packet arrives out of order */
+  gboolean recv_sorted;
+  GstClockTime recv_ts_rounded;
+  guint recv_deltas_size;
+  guint recv_symbol_size;
+  gint recv_equal_idx;
 
   guint64 fb_pkt_count;
   gint32 last_seqnum;
 
-  GArray *sent_packets;
+  /* ring of sent packets, indexed by their twcc seqnum */
+  SentPacket *sent_packets;
+  guint sent_packets_mask;
+  guint sent_packets_len;
+  guint16 first_sent_seqnum;
+
   GArray *parsed_packets;
   GQueue *rtcp_buffers;
 
@@ -111,8 +128,11 @@ static void
 rtp_twcc_manager_init (RTPTWCCManager * twcc)
 {
   twcc->recv_packets = g_array_new (FALSE, FALSE, sizeof (RecvPacket));
-  twcc->sent_packets = g_array_new (FALSE, FALSE, sizeof (SentPacket));
-  twcc->parsed_packets = g_array_new (FALSE, FALSE, sizeof (RecvPacket));
+  twcc->packet_chunks = g_array_new (FALSE, FALSE, 2);
+  twcc->recv_sorted = TRUE;
+  twcc->sent_packets = g_new (SentPacket, SENT_PACKETS_MIN_SIZE);
+  twcc->sent_packets_mask = SENT_PACKETS_MIN_SIZE - 1;
+  twcc->parsed_packets = g_array_new (FALSE, FALSE, sizeof (RTPTWCCPacket));
 
   twcc->rtcp_buffers = g_queue_new ();
 
@@ -132,7 +152,8 @@ rtp_twcc_manager_finalize (GObject * object)
   RTPTWCCManager *twcc = RTP_TWCC_MANAGER_CAST (object);
 
   g_array_unref (twcc->recv_packets);
-  g_array_unref (twcc->sent_packets);
+  g_array_unref (twcc->packet_chunks);
+  g_free (twcc->sent_packets);
   g_array_unref (twcc->parsed_packets);
   g_queue_free_full (twcc->rtcp_buffers, (GDestroyNotify) gst_buffer_unref);
 
@@ -245,11 +266,59 @@ sent_packet_init (SentPacket * packet, guint16 seqnum, RTPPacketInfo * pinfo,
   packet->lost = FALSE;
 }
 
+/* returns the slot for @seqnum in the ring of sent packets, growing it when
+   it is full, or dropping the oldest packet once it holds all seqnums. When
+   it holds all seqnums the length wraps to 0 when compared with the seqnum
+   distance. */
+static SentPacket *
+sent_packets_push (RTPTWCCManager * twcc, guint16 seqnum)
+{
+  if (twcc->sent_packets_len == 0 ||
+      (guint16) (seqnum - twcc->first_sent_seqnum) !=
+      (guint16) twcc->sent_packets_len) {
+    twcc->first_sent_seqnum = seqnum;
+    twcc->sent_packets_len = 0;
+  } else if (twcc->sent_packets_len > twcc->sent_packets_mask) {
+    guint size = twcc->sent_packets_mask + 1;
+
+    if (size < SENT_PACKETS_MAX_SIZE) {
+      SentPacket *packets = g_new (SentPacket, size * 2);
+      guint mask = size * 2 - 1;
+      guint i;
+
+      for (i = 0; i < twcc->sent_packets_len; i++) {
+        guint16 s = twcc->first_sent_seqnum + i;
+        packets[s & mask] = twcc->sent_packets[s & twcc->sent_packets_mask];
+      }
+      g_free (twcc->sent_packets);
+      twcc->sent_packets = packets;
+      twcc->sent_packets_mask = mask;
+    } else {
+      twcc->first_sent_seqnum++;
+      twcc->sent_packets_len--;
+    }
+  }
+  twcc->sent_packets_len++;
+
+  return &twcc->sent_packets[seqnum & twcc->sent_packets_mask];
+}
+
+static SentPacket *
+sent_packets_find (RTPTWCCManager * twcc, guint16 seqnum)
+{
+  guint16 idx = seqnum - twcc->first_sent_seqnum;
+
+  if (idx >= twcc->sent_packets_len)
+    return NULL;
+
+  return &twcc->sent_packets[seqnum & twcc->sent_packets_mask];
+}
+
 static void
 _set_twcc_seqnum_data (RTPTWCCManager * twcc, RTPPacketInfo * pinfo,
     GstBuffer * buf, guint8 ext_id)
 {
-  SentPacket packet;
+  SentPacket *packet;
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
   gpointer data;
 
@@ -259,11 +328,11 @@ _set_twcc_seqnum_data (RTPTWCCManager * twcc, RTPPacketInfo * pinfo,
       guint16 seqnum = twcc->send_seqnum++;
 
       GST_WRITE_UINT16_BE (data, seqnum);
-      sent_packet_init (&packet, seqnum, pinfo, &rtp);
-      g_array_append_val (twcc->sent_packets, packet);
+      packet = sent_packets_push (twcc, seqnum);
+      sent_packet_init (packet, seqnum, pinfo, &rtp);
 
       GST_LOG ("Send: twcc-seqnum: %u, pt: %u, marker: %d, len: %u, ts: %"
-          GST_TIME_FORMAT, seqnum, packet.pt, pinfo->marker, packet.size,
+          GST_TIME_FORMAT, seqnum, packet->pt, pinfo->marker, packet->size,
           GST_TIME_ARGS (pinfo->current_time));
     }
     gst_rtp_buffer_unmap (&rtp);
@@ -313,10 +382,8 @@ rtp_twcc_manager_get_recv_twcc_seqnum (RTPTWCCManager * twcc,
 }
 
 static gint
-_twcc_seqnum_sort (gconstpointer a, gconstpointer b)
+_twcc_seqnum_compare (gint32 seqa, gint32 seqb)
 {
-  gint32 seqa = ((RecvPacket *) a)->seqnum;
-  gint32 seqb = ((RecvPacket *) b)->seqnum;
   gint res = seqa - seqb;
   if (res < -65000)
     res = 1;
@@ -325,6 +392,13 @@ _twcc_seqnum_sort (gconstpointer a, gconstpointer b)
   return res;
 }
 
+static gint
+_twcc_seqnum_sort (gconstpointer a, gconstpointer b)
+{
+  return _twcc_seqnum_compare (((RecvPacket *) a)->seqnum,
+      ((RecvPacket *) b)->seqnum);
+}
+
 static void
 rtp_twcc_write_recv_deltas (guint8 * fci_data, GArray * twcc_packets)
 {
@@ -342,23 +416,27 @@ rtp_twcc_write_recv_deltas (guint8 * fci_data, GArray * twcc_packets)
   }
 }
 
+static void
+rtp_twcc_append_chunk (GArray * packet_chunks, guint16 chunk)
+{
+  guint16 data;
+
+  GST_WRITE_UINT16_BE (&data, chunk);
+  g_array_append_val (packet_chunks, data);
+}
+
 static void
 rtp_twcc_write_run_length_chunk (GArray * packet_chunks,
     RTPTWCCPacketStatus status, guint run_length)
 {
   guint written = 0;
   while (written < run_length) {
-    GstBitWriter writer;
-    guint16 data = 0;
     guint len = MIN (run_length - written, 8191);
 
     GST_LOG ("Writing a run-length of %u with status %u", len, status);
 
-    gst_bit_writer_init_with_data (&writer, (guint8 *) & data, 2, FALSE);
-    gst_bit_writer_put_bits_uint8 (&writer, RTP_TWCC_CHUNK_TYPE_RUN_LENGTH, 1);
-    gst_bit_writer_put_bits_uint8 (&writer, status, 2);
-    gst_bit_writer_put_bits_uint16 (&writer, len, 13);
-    g_array_append_val (packet_chunks, data);
+    rtp_twcc_append_chunk (packet_chunks,
+        (RTP_TWCC_CHUNK_TYPE_RUN_LENGTH << 15) | (status << 13) | len);
     written += len;
   }
 }
@@ -366,22 +444,18 @@ rtp_twcc_write_run_length_chunk (GArray * packet_chunks,
 typedef struct
 {
   GArray *packet_chunks;
-  GstBitWriter writer;
   guint16 data;
+  guint bit_size;
   guint symbol_size;
 } ChunkBitWriter;
 
 static void
 chunk_bit_writer_reset (ChunkBitWriter * writer)
 {
-  writer->data = 0;
-  gst_bit_writer_init_with_data (&writer->writer,
-      (guint8 *) & writer->data, 2, FALSE);
-
-  gst_bit_writer_put_bits_uint8 (&writer->writer,
-      RTP_TWCC_CHUNK_TYPE_STATUS_VECTOR, 1);
   /* 1 for 2-bit symbol-size, 0 for 1-bit */
-  gst_bit_writer_put_bits_uint8 (&writer->writer, writer->symbol_size - 1, 1);
+  writer->data = (RTP_TWCC_CHUNK_TYPE_STATUS_VECTOR << 15) |
+      ((writer->symbol_size - 1) << 14);
+  writer->bit_size = 2;
 }
 
 static void
@@ -394,19 +468,19 @@ chunk_bit_writer_configure (ChunkBitWriter * writer, guint symbol_size)
 static gboolean
 chunk_bit_writer_is_empty (ChunkBitWriter * writer)
 {
-  return writer->writer.bit_size == 2;
+  return writer->bit_size == 2;
 }
 
 static gboolean
 chunk_bit_writer_is_full (ChunkBitWriter * writer)
 {
-  return writer->writer.bit_size == 16;
+  return writer->bit_size == 16;
 }
 
 static guint
 chunk_bit_writer_get_available_slots (ChunkBitWriter * writer)
 {
-  return (16 - writer->writer.bit_size) / writer->symbol_size;
+  return (16 - writer->bit_size) / writer->symbol_size;
 }
 
 static guint
@@ -420,7 +494,7 @@ chunk_bit_writer_flush (ChunkBitWriter * writer)
 {
   /* don't append a chunk if no bits have been written */
   if (!chunk_bit_writer_is_empty (writer)) {
-    g_array_append_val (writer->packet_chunks, writer->data);
+    rtp_twcc_append_chunk (writer->packet_chunks, writer->data);
     chunk_bit_writer_reset (writer);
   }
 }
@@ -436,7 +510,8 @@ chunk_bit_writer_init (ChunkBitWriter * writer,
 static void
 chunk_bit_writer_write (ChunkBitWriter * writer, RTPTWCCPacketStatus status)
 {
-  gst_bit_writer_put_bits_uint8 (&writer->writer, status, writer->symbol_size);
+  writer->bit_size += writer->symbol_size;
+  writer->data |= status << (16 - writer->bit_size);
   if (chunk_bit_writer_is_full (writer)) {
     chunk_bit_writer_flush (writer);
   }
@@ -468,33 +543,6 @@ rtp_twcc_write_status_vector_chunk (ChunkBitWriter * writer, RecvPacket * pkt)
   chunk_bit_writer_write (writer, pkt->status);
 }
 
-typedef struct
-{
-  RecvPacket *equal;
-} RunLengthHelper;
-
-static void
-run_lenght_helper_update (RunLengthHelper * rlh, RecvPacket * pkt)
-{
-  /* for missing packets we reset */
-  if (pkt->missing_run > 0) {
-    rlh->equal = NULL;
-  }
-
-  /* all status equal run */
-  if (rlh->equal == NULL) {
-    rlh->equal = pkt;
-    rlh->equal->equal_run = 0;
-  }
-
-  if (rlh->equal->status == pkt->status) {
-    rlh->equal->equal_run++;
-  } else {
-    rlh->equal = pkt;
-    rlh->equal->equal_run = 1;
-  }
-}
-
 static guint
 _get_max_packets_capacity (guint symbol_size)
 {
@@ -573,30 +621,86 @@ rtp_twcc_write_chunks (GArray * packet_chunks,
   chunk_bit_writer_flush (&writer);
 }
 
+/* calculates the delta, status and runs of the received packet at @idx from
+   the packets before it */
+static void
+rtp_twcc_manager_update_recv_packet (RTPTWCCManager * twcc, guint idx)
+{
+  RecvPacket *pkt = &g_array_index (twcc->recv_packets, RecvPacket, idx);
+  RecvPacket *equal;
+  GstClockTimeDiff delta_ts;
+  gint64 delta_ts_rounded;
+
+  if (idx == 0) {
+    twcc->recv_ts_rounded = (pkt->ts / REF_TIME_UNIT) * REF_TIME_UNIT;
+    twcc->recv_deltas_size = 0;
+    twcc->recv_symbol_size = 1;
+    twcc->recv_equal_idx = -1;
+    pkt->missing_run = 0;
+  } else {
+    pkt->missing_run = pkt->seqnum - (pkt - 1)->seqnum - 1;
+  }
+  pkt->equal_run = 0;
+
+  delta_ts = GST_CLOCK_DIFF (twcc->recv_ts_rounded, pkt->ts);
+  pkt->delta = delta_ts / DELTA_UNIT;
+  delta_ts_rounded = pkt->delta * DELTA_UNIT;
+  twcc->recv_ts_rounded += delta_ts_rounded;
+
+  if (delta_ts_rounded < 0 || delta_ts_rounded > MAX_TS_DELTA) {
+    pkt->status = RTP_TWCC_PACKET_STATUS_LARGE_NEGATIVE_DELTA;
+    twcc->recv_deltas_size += 2;
+    twcc->recv_symbol_size = 2;
+  } else {
+    pkt->status = RTP_TWCC_PACKET_STATUS_SMALL_DELTA;
+    twcc->recv_deltas_size += 1;
+  }
+
+  /* all status equal run, for missing packets we reset */
+  if (pkt->missing_run > 0 || twcc->recv_equal_idx == -1)
+    twcc->recv_equal_idx = idx;
+
+  equal = &g_array_index (twcc->recv_packets, RecvPacket, twcc->recv_equal_idx);
+  if (equal->status == pkt->status) {
+    equal->equal_run++;
+  } else {
+    twcc->recv_equal_idx = idx;
+    pkt->equal_run = 1;
+  }
+
+  GST_LOG ("pkt: #%u, ts: %" GST_TIME_FORMAT
+      " ts_rounded: %" GST_TIME_FORMAT
+      " delta_ts: %" GST_STIME_FORMAT
+      " delta_ts_rounded: %" GST_STIME_FORMAT
+      " missing_run: %u, status: %u", pkt->seqnum,
+      GST_TIME_ARGS (pkt->ts), GST_TIME_ARGS (twcc->recv_ts_rounded),
+      GST_STIME_ARGS (delta_ts), GST_STIME_ARGS (delta_ts_rounded),
+      pkt->missing_run, pkt->status);
+}
+
 static void
 rtp_twcc_manager_add_fci (RTPTWCCManager * twcc, GstRTCPPacket * packet)
 {
-  RecvPacket *first, *last, *prev;
+  RecvPacket *first, *last;
   guint16 packet_count;
   GstClockTime base_time;
-  GstClockTime ts_rounded;
   guint i;
-  GArray *packet_chunks = g_array_new (FALSE, FALSE, 2);
+  GArray *packet_chunks = twcc->packet_chunks;
   RTPTWCCHeader header;
   guint header_size = sizeof (RTPTWCCHeader);
   guint packet_chunks_size;
-  guint recv_deltas_size = 0;
   guint16 fci_length;
   guint16 fci_chunks;
   guint8 *fci_data;
   guint8 *fci_data_ptr;
-  RunLengthHelper rlh = { NULL };
-  guint symbol_size = 1;
-  GstClockTimeDiff delta_ts;
-  gint64 delta_ts_rounded;
   guint8 fb_pkt_count;
 
-  g_array_sort (twcc->recv_packets, _twcc_seqnum_sort);
+  /* packets that arrived in order have been handled already */
+  if (!twcc->recv_sorted) {
+    g_array_sort (twcc->recv_packets, _twcc_seqnum_sort);
+    for (i = 0; i < twcc->recv_packets->len; i++)
+      rtp_twcc_manager_update_recv_packet (twcc, i);
+  }
 
   /* get first and last packet */
   first = &g_array_index (twcc->recv_packets, RecvPacket, 0);
@@ -614,7 +718,6 @@ rtp_twcc_manager_add_fci (RTPTWCCManager * twcc, GstRTCPPacket * packet)
   GST_WRITE_UINT8 (header.fb_pkt_count, fb_pkt_count);
 
   base_time *= REF_TIME_UNIT;
-  ts_rounded = base_time;
 
   GST_DEBUG ("Created TWCC feedback: base_seqnum: #%u, packet_count: %u, "
       "base_time %" GST_TIME_FORMAT " fb_pkt_count: %u",
@@ -623,44 +726,12 @@ rtp_twcc_manager_add_fci (RTPTWCCManager * twcc, GstRTCPPacket * packet)
   twcc->fb_pkt_count++;
   twcc->expected_recv_seqnum = first->seqnum + packet_count;
 
-  /* calculate all deltas and check for gaps etc */
-  prev = first;
-  for (i = 0; i < twcc->recv_packets->len; i++) {
-    RecvPacket *pkt = &g_array_index (twcc->recv_packets, RecvPacket, i);
-    if (i != 0) {
-      pkt->missing_run = pkt->seqnum - prev->seqnum - 1;
-    }
-
-    delta_ts = GST_CLOCK_DIFF (ts_rounded, pkt->ts);
-    pkt->delta = delta_ts / DELTA_UNIT;
-    delta_ts_rounded = pkt->delta * DELTA_UNIT;
-    ts_rounded += delta_ts_rounded;
-
-    if (delta_ts_rounded < 0 || delta_ts_rounded > MAX_TS_DELTA) {
-      pkt->status = RTP_TWCC_PACKET_STATUS_LARGE_NEGATIVE_DELTA;
-      recv_deltas_size += 2;
-      symbol_size = 2;
-    } else {
-      pkt->status = RTP_TWCC_PACKET_STATUS_SMALL_DELTA;
-      recv_deltas_size += 1;
-    }
-    run_lenght_helper_update (&rlh, pkt);
-
-    GST_LOG ("pkt: #%u, ts: %" GST_TIME_FORMAT
-        " ts_rounded: %" GST_TIME_FORMAT
-        " delta_ts: %" GST_STIME_FORMAT
-        " delta_ts_rounded: %" GST_STIME_FORMAT
-        " missing_run: %u, status: %u", pkt->seqnum,
-        GST_TIME_ARGS (pkt->ts), GST_TIME_ARGS (ts_rounded),
-        GST_STIME_ARGS (delta_ts), GST_STIME_ARGS (delta_ts_rounded),
-        pkt->missing_run, pkt->status);
-    prev = pkt;
-  }
-
-  rtp_twcc_write_chunks (packet_chunks, twcc->recv_packets, symbol_size);
+  g_array_set_size (packet_chunks, 0);
+  rtp_twcc_write_chunks (packet_chunks, twcc->recv_packets,
+      twcc->recv_symbol_size);
 
   packet_chunks_size = packet_chunks->len * 2;
-  fci_length = header_size + packet_chunks_size + recv_deltas_size;
+  fci_length = header_size + packet_chunks_size + twcc->recv_deltas_size;
   fci_chunks = (fci_length - 1) / sizeof (guint32) + 1;
 
   if (!gst_rtcp_packet_fb_set_fci_length (packet, fci_chunks)) {
@@ -684,8 +755,8 @@ rtp_twcc_manager_add_fci (RTPTWCCManager * twcc, GstRTCPPacket * packet)
       packet_chunks_size);
   GST_MEMDUMP ("full fci:", fci_data, fci_length);
 
-  g_array_unref (packet_chunks);
   g_array_set_size (twcc->recv_packets, 0);
+  twcc->recv_sorted = TRUE;
 }
 
 static void
@@ -796,11 +867,17 @@ rtp_twcc_manager_recv_packet (RTPTWCCManager * twcc, RTPPacketInfo * pinfo)
       GST_INFO ("Received duplicate packet (%u), dropping", seqnum);
       return FALSE;
     }
+
+    /* the feedback has to be recalculated once the packets are sorted */
+    if (_twcc_seqnum_compare (last->seqnum, seqnum) > 0)
+      twcc->recv_sorted = FALSE;
   }
 
   /* store the packet for Transport-wide RTCP feedback message */
   recv_packet_init (&packet, seqnum, pinfo);
   g_array_append_val (twcc->recv_packets, packet);
+  if (twcc->recv_sorted)
+    rtp_twcc_manager_update_recv_packet (twcc, twcc->recv_packets->len - 1);
   twcc->last_seqnum = seqnum;
 
   GST_LOG ("Receive: twcc-seqnum: %u, pt: %u, marker: %d, ts: %"
@@ -867,57 +944,57 @@ rtp_twcc_manager_send_packet (RTPTWCCManager * twcc, RTPPacketInfo * pinfo)
   rtp_twcc_manager_set_send_twcc_seqnum (twcc, pinfo);
 }
 
+static const RTPTWCCPacket twcc_packet_init = {
+  .local_ts = GST_CLOCK_TIME_NONE,
+  .remote_ts = GST_CLOCK_TIME_NONE,
+  .local_delta = GST_CLOCK_STIME_NONE,
+  .remote_delta = GST_CLOCK_STIME_NONE,
+  .delta_delta = GST_CLOCK_STIME_NONE,
+};
+
 static void
-_add_twcc_packet (GArray * twcc_packets, guint16 seqnum, guint status)
+_add_twcc_packets (GArray * twcc_packets, guint16 seqnum, guint status,
+    guint count)
 {
-  RTPTWCCPacket packet;
-  memset (&packet, 0, sizeof (RTPTWCCPacket));
-  packet.local_ts = GST_CLOCK_TIME_NONE;
-  packet.remote_ts = GST_CLOCK_TIME_NONE;
-  packet.local_delta = GST_CLOCK_STIME_NONE;
-  packet.remote_delta = GST_CLOCK_STIME_NONE;
-  packet.delta_delta = GST_CLOCK_STIME_NONE;
-  packet.seqnum = seqnum;
-  packet.status = status;
-  g_array_append_val (twcc_packets, packet);
+  guint i, len = twcc_packets->len;
+
+  g_array_set_size (twcc_packets, len + count);
+  for (i = 0; i < count; i++) {
+    RTPTWCCPacket *pkt = &g_array_index (twcc_packets, RTPTWCCPacket, len + i);
+
+    *pkt = twcc_packet_init;
+    pkt->seqnum = seqnum + i;
+    pkt->status = status;
+  }
 }
 
 static guint
-_parse_run_length_chunk (GstBitReader * reader, GArray * twcc_packets,
+_parse_run_length_chunk (guint16 chunk, GArray * twcc_packets,
     guint16 seqnum_offset, guint remaining_packets)
 {
-  guint16 run_length;
-  guint8 status_code;
-  guint i;
-
-  gst_bit_reader_get_bits_uint8 (reader, &status_code, 2);
-  gst_bit_reader_get_bits_uint16 (reader, &run_length, 13);
+  guint run_length = MIN (remaining_packets, chunk & 0x1fff);
 
-  run_length = MIN (remaining_packets, run_length);
-
-  for (i = 0; i < run_length; i++) {
-    _add_twcc_packet (twcc_packets, seqnum_offset + i, status_code);
-  }
+  _add_twcc_packets (twcc_packets, seqnum_offset, (chunk >> 13) & 0x3,
+      run_length);
 
   return run_length;
 }
 
 static guint
-_parse_status_vector_chunk (GstBitReader * reader, GArray * twcc_packets,
+_parse_status_vector_chunk (guint16 chunk, GArray * twcc_packets,
     guint16 seqnum_offset, guint remaining_packets)
 {
-  guint8 symbol_size;
+  guint symbol_size = ((chunk >> 14) & 0x1) + 1;
+  guint symbol_mask = (1 << symbol_size) - 1;
   guint num_bits;
   guint i;
 
-  gst_bit_reader_get_bits_uint8 (reader, &symbol_size, 1);
-  symbol_size += 1;
   num_bits = MIN (remaining_packets, 14 / symbol_size);
 
   for (i = 0; i < num_bits; i++) {
-    guint8 status_code;
-    if (gst_bit_reader_get_bits_uint8 (reader, &status_code, symbol_size))
-      _add_twcc_packet (twcc_packets, seqnum_offset + i, status_code);
+    guint shift = 14 - (i + 1) * symbol_size;
+    _add_twcc_packets (twcc_packets, seqnum_offset + i,
+        (chunk >> shift) & symbol_mask, 1);
   }
 
   return num_bits;
@@ -928,20 +1005,20 @@ _parse_status_vector_chunk (GstBitReader * reader, GArray * twcc_packets,
 static void
 _prune_sent_packets (RTPTWCCManager * twcc, GArray * twcc_packets)
 {
-  SentPacket *first;
   RTPTWCCPacket *last;
   guint16 last_idx;
 
-  if (twcc_packets->len == 0 || twcc->sent_packets->len == 0)
+  if (twcc_packets->len == 0 || twcc->sent_packets_len == 0)
     return;
 
-  first = &g_array_index (twcc->sent_packets, SentPacket, 0);
   last = &g_array_index (twcc_packets, RTPTWCCPacket, twcc_packets->len - 1);
 
-  last_idx = last->seqnum - first->seqnum;
+  last_idx = last->seqnum - twcc->first_sent_seqnum;
 
-  if (last_idx < twcc->sent_packets->len)
-    g_array_remove_range (twcc->sent_packets, 0, last_idx);
+  if (last_idx < twcc->sent_packets_len) {
+    twcc->first_sent_seqnum += last_idx;
+    twcc->sent_packets_len -= last_idx;
+  }
 }
 
 static void
@@ -950,7 +1027,6 @@ _check_for_lost_packets (RTPTWCCManager * twcc, GArray * twcc_packets,
 {
   guint packets_lost;
   gint8 fb_pkt_count_diff;
-  guint i;
 
   /* first packet */
   if (twcc->first_fci_parse) {
@@ -984,10 +1060,8 @@ _check_for_lost_packets (RTPTWCCManager * twcc, GArray * twcc_packets,
   }
 
   packets_lost = base_seqnum - twcc->expected_parsed_seqnum;
-  for (i = 0; i < packets_lost; i++) {
-    _add_twcc_packet (twcc_packets, twcc->expected_parsed_seqnum + i,
-        RTP_TWCC_PACKET_STATUS_NOT_RECV);
-  }
+  _add_twcc_packets (twcc_packets, twcc->expected_parsed_seqnum,
+      RTP_TWCC_PACKET_STATUS_NOT_RECV, packets_lost);
 
 done:
   twcc->expected_parsed_seqnum = base_seqnum + packet_count;
@@ -995,11 +1069,12 @@ done:
   return;
 }
 
+/* The returned array is owned by @twcc and reused for the next feedback */
 GArray *
 rtp_twcc_manager_parse_fci (RTPTWCCManager * twcc,
     guint8 * fci_data, guint fci_length)
 {
-  GArray *twcc_packets;
+  GArray *twcc_packets = twcc->parsed_packets;
   guint16 base_seqnum;
   guint16 packet_count;
   GstClockTime base_time;
@@ -1008,7 +1083,6 @@ rtp_twcc_manager_parse_fci (RTPTWCCManager * twcc,
   guint packets_parsed = 0;
   guint fci_parsed;
   guint i;
-  SentPacket *first_sent_pkt = NULL;
 
   if (fci_length < 10) {
     GST_WARNING ("Malformed TWCC RTCP feedback packet");
@@ -1024,37 +1098,31 @@ rtp_twcc_manager_parse_fci (RTPTWCCManager * twcc,
       "base_time %" GST_TIME_FORMAT " fb_pkt_count: %u",
       base_seqnum, packet_count, GST_TIME_ARGS (base_time), fb_pkt_count);
 
-  twcc_packets = g_array_sized_new (FALSE, FALSE,
-      sizeof (RTPTWCCPacket), packet_count);
+  g_array_set_size (twcc_packets, 0);
 
   _check_for_lost_packets (twcc, twcc_packets,
       base_seqnum, packet_count, fb_pkt_count);
 
   fci_parsed = 8;
   while (packets_parsed < packet_count && (fci_parsed + 1) < fci_length) {
-    GstBitReader reader = GST_BIT_READER_INIT (&fci_data[fci_parsed], 2);
-    guint8 chunk_type;
+    guint16 chunk = GST_READ_UINT16_BE (&fci_data[fci_parsed]);
     guint seqnum_offset = base_seqnum + packets_parsed;
     guint remaining_packets = packet_count - packets_parsed;
 
-    gst_bit_reader_get_bits_uint8 (&reader, &chunk_type, 1);
-
-    if (chunk_type == RTP_TWCC_CHUNK_TYPE_RUN_LENGTH) {
-      packets_parsed += _parse_run_length_chunk (&reader,
+    if ((chunk >> 15) == RTP_TWCC_CHUNK_TYPE_RUN_LENGTH) {
+      packets_parsed += _parse_run_length_chunk (chunk,
           twcc_packets, seqnum_offset, remaining_packets);
     } else {
-      packets_parsed += _parse_status_vector_chunk (&reader,
+      packets_parsed += _parse_status_vector_chunk (chunk,
           twcc_packets, seqnum_offset, remaining_packets);
     }
     fci_parsed += 2;
   }
 
-  if (twcc->sent_packets->len > 0)
-    first_sent_pkt = &g_array_index (twcc->sent_packets, SentPacket, 0);
-
   ts_rounded = base_time;
   for (i = 0; i < twcc_packets->len; i++) {
     RTPTWCCPacket *pkt = &g_array_index (twcc_packets, RTPTWCCPacket, i);
+    SentPacket *found;
     gint16 delta = 0;
     GstClockTimeDiff delta_ts;
 
@@ -1084,23 +1152,17 @@ rtp_twcc_manager_parse_fci (RTPTWCCManager * twcc,
           pkt->status);
     }
 
-    if (first_sent_pkt) {
-      SentPacket *found = NULL;
-      guint16 sent_idx = pkt->seqnum - first_sent_pkt->seqnum;
-      if (sent_idx < twcc->sent_packets->len)
-        found = &g_array_index (twcc->sent_packets, SentPacket, sent_idx);
-      if (found && found->seqnum == pkt->seqnum) {
-        if (GST_CLOCK_TIME_IS_VALID (found->socket_ts)) {
-          pkt->local_ts = found->socket_ts;
-        } else {
-          pkt->local_ts = found->ts;
-        }
-        pkt->size = found->size;
-        pkt->pt = found->pt;
-
-        GST_LOG ("matching pkt: #%u with local_ts: %" GST_TIME_FORMAT
-            " size: %u", pkt->seqnum, GST_TIME_ARGS (pkt->local_ts), pkt->size);
+    if ((found = sent_packets_find (twcc, pkt->seqnum))) {
+      if (GST_CLOCK_TIME_IS_VALID (found->socket_ts)) {
+        pkt->local_ts = found->socket_ts;
+      } else {
+        pkt->local_ts = found->ts;
       }
+      pkt->size = found->size;
+      pkt->pt = found->pt;
+
+      GST_LOG ("matching pkt: #%u with local_ts: %" GST_TIME_FORMAT
+          " size: %u", pkt->seqnum, GST_TIME_ARGS (pkt->local_ts), pkt->size);
     }
   }
 
@@ -312,6 +312,7 @@ gst_rtsp_backchannel_get_type (void)
 #define DEFAULT_ONVIF_RATE_CONTROL TRUE
 #define DEFAULT_IS_LIVE TRUE
 #define DEFAULT_IGNORE_X_SERVER_REPLY FALSE
+#define DEFAULT_FAST_START FALSE
 
 enum
 {
@@ -361,7 +362,8 @@ enum
   PROP_ONVIF_MODE,
   PROP_ONVIF_RATE_CONTROL,
   PROP_IS_LIVE,
-  PROP_IGNORE_X_SERVER_REPLY
+  PROP_IGNORE_X_SERVER_REPLY,
+  PROP_FAST_START
 };
 
 #define GST_TYPE_RTSP_NAT_METHOD (gst_rtsp_nat_method_get_type())
@@ -1093,6 +1095,28 @@ gst_rtspsrc_class_init (GstRTSPSrcClass * klass)
           DEFAULT_IGNORE_X_SERVER_REPLY,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstRTSPSrc:fast-start
+   *
+   * Pipeline requests during the RTSP handshake instead of waiting for the
+   * response of each request before sending the next one. The DESCRIBE
+   * request is sent right behind the OPTIONS request and, once the first
+   * stream was set up, the SETUP requests of all other streams are sent at
+   * once. This saves one round trip per stream, which matters on links
+   * with a high latency.
+   *
+   * When a pipelined request needs to be retried, for example because of
+   * authentication or RTSP version negotiation, the handshake continues
+   * one request at a time. With RTSP 2.0 the SETUP requests are always
+   * pipelined.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_FAST_START,
+      g_param_spec_boolean ("fast-start", "Fast start",
+          "Pipeline the RTSP requests of the handshake to start faster",
+          DEFAULT_FAST_START, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstRTSPSrc::handle-request:
    * @rtspsrc: a #GstRTSPSrc
@@ -1520,6 +1544,7 @@ gst_rtspsrc_init (GstRTSPSrc * src)
   src->onvif_mode = DEFAULT_ONVIF_MODE;
   src->onvif_rate_control = DEFAULT_ONVIF_RATE_CONTROL;
   src->is_live = DEFAULT_IS_LIVE;
+  src->fast_start = DEFAULT_FAST_START;
   src->seek_seqnum = GST_SEQNUM_INVALID;
   src->group_id = GST_GROUP_ID_INVALID;
 
@@ -1867,6 +1892,9 @@ gst_rtspsrc_set_property (GObject * object, guint prop_id, const GValue * value,
     case PROP_IGNORE_X_SERVER_REPLY:
       rtspsrc->ignore_x_server_reply = g_value_get_boolean (value);
       break;
+    case PROP_FAST_START:
+      rtspsrc->fast_start = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2040,6 +2068,9 @@ gst_rtspsrc_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_IGNORE_X_SERVER_REPLY:
       g_value_set_boolean (value, rtspsrc->ignore_x_server_reply);
       break;
+    case PROP_FAST_START:
+      g_value_set_boolean (value, rtspsrc->fast_start);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -5031,6 +5062,12 @@ gst_rtspsrc_activate_streams (GstRTSPSrc * src)
 
   GST_DEBUG_OBJECT (src, "activating streams");
 
+  if (src->open_time != 0) {
+    GST_INFO_OBJECT (src, "first data %" G_GINT64_FORMAT " us after opening",
+        g_get_monotonic_time () - src->open_time);
+    src->open_time = 0;
+  }
+
   for (walk = src->streams; walk; walk = g_list_next (walk)) {
     GstRTSPStream *stream = (GstRTSPStream *) walk->data;
 
@@ -6707,21 +6744,21 @@ server_eof:
 }
 
 
+/* let the extensions and the before-send signal see @request and send it.
+ * @sent is set to FALSE when the signal dropped the request */
 static GstRTSPResult
-gst_rtspsrc_try_send (GstRTSPSrc * src, GstRTSPConnInfo * conninfo,
-    GstRTSPMessage * request, GstRTSPMessage * response,
-    GstRTSPStatusCode * code)
+gst_rtspsrc_send_request (GstRTSPSrc * src, GstRTSPConnInfo * conninfo,
+    GstRTSPMessage * request, gboolean * sent)
 {
   GstRTSPResult res;
-  gint try = 0;
   gboolean allow_send = TRUE;
 
-again:
   if (!src->short_header)
     gst_rtsp_ext_list_before_send (src->extensions, request);
 
   g_signal_emit (src, gst_rtspsrc_signals[SIGNAL_BEFORE_SEND], 0,
       request, &allow_send);
+  *sent = allow_send;
   if (!allow_send) {
     GST_DEBUG_OBJECT (src, "skipping message, disabled by signal");
     return GST_RTSP_OK;
@@ -6733,10 +6770,28 @@ again:
 
   res = gst_rtspsrc_connection_send (src, conninfo, request, src->tcp_timeout);
   if (res < 0)
-    goto send_error;
+    return res;
 
   gst_rtsp_connection_reset_timeout (conninfo->connection);
-  if (!response)
+
+  return res;
+}
+
+static GstRTSPResult
+gst_rtspsrc_try_send (GstRTSPSrc * src, GstRTSPConnInfo * conninfo,
+    GstRTSPMessage * request, GstRTSPMessage * response,
+    GstRTSPStatusCode * code)
+{
+  GstRTSPResult res;
+  gint try = 0;
+  gboolean sent;
+
+again:
+  res = gst_rtspsrc_send_request (src, conninfo, request, &sent);
+  if (res < 0)
+    goto send_error;
+
+  if (!sent || !response)
     return res;
 
   res = gst_rtsp_src_receive_response (src, conninfo, response, code);
@@ -7434,18 +7489,32 @@ no_transport:
   }
 }
 
+/* Receive the responses to the pipelined SETUP requests and configure the
+ * streams from them. All responses are read, even after a failure, so that
+ * the connection stays usable. Returns GST_RTSP_ENOTIMPL with the status code
+ * of the first failed response in @failed_code when a stream could not be set
+ * up from its response, and an error when no response could be received or
+ * an error was posted. */
 static GstRTSPResult
-gst_rtspsrc_setup_streams_end (GstRTSPSrc * src, gboolean async)
+gst_rtspsrc_setup_streams_end (GstRTSPSrc * src, gboolean async,
+    GstRTSPStatusCode * failed_code)
 {
   GList *tmp;
   GstRTSPConnInfo *conninfo;
+  GstRTSPResult ret = GST_RTSP_OK;
+
+  /* requests are pipelined with RTSP 2.0 or, once the first stream was set
+   * up, with fast-start */
+  g_assert (src->version >= GST_RTSP_VERSION_2_0 || src->fast_start);
 
-  g_assert (src->version >= GST_RTSP_VERSION_2_0);
+  *failed_code = GST_RTSP_STS_OK;
 
   conninfo = &src->conninfo;
   for (tmp = src->streams; tmp; tmp = tmp->next) {
     GstRTSPStream *stream = (GstRTSPStream *) tmp->data;
     GstRTSPMessage response = { 0, };
+    GstRTSPStatusCode code = GST_RTSP_STS_INVALID;
+    GstRTSPResult res;
 
     if (!stream->waiting_setup_response)
       continue;
@@ -7453,13 +7522,37 @@ gst_rtspsrc_setup_streams_end (GstRTSPSrc * src, gboolean async)
     if (!src->conninfo.connection)
       conninfo = &((GstRTSPStream *) tmp->data)->conninfo;
 
-    gst_rtsp_src_receive_response (src, conninfo, &response, NULL);
+    res = gst_rtsp_src_receive_response (src, conninfo, &response, &code);
+    if (res < 0) {
+      gst_rtsp_message_unset (&response);
+      return res;
+    }
+
+    if (code == GST_RTSP_STS_OK && ret != GST_RTSP_ERROR) {
+      /* this unsets the response */
+      res = gst_rtsp_src_setup_stream_from_response (src, stream,
+          &response, NULL, 0, NULL, NULL);
+      if (res == GST_RTSP_ERROR)
+        ret = GST_RTSP_ERROR;
+      else if (res < 0)
+        code = GST_RTSP_STS_INVALID;
+    } else {
+      gst_rtsp_message_unset (&response);
+    }
 
-    gst_rtsp_src_setup_stream_from_response (src, stream,
-        &response, NULL, 0, NULL, NULL);
+    if (!stream->setup) {
+      GST_DEBUG_OBJECT (src, "pipelined SETUP of stream %p failed: %d",
+          stream, code);
+      stream->waiting_setup_response = FALSE;
+      gst_rtspsrc_stream_free_udp (stream);
+      if (ret == GST_RTSP_OK) {
+        *failed_code = code;
+        ret = GST_RTSP_ENOTIMPL;
+      }
+    }
   }
 
-  return GST_RTSP_OK;
+  return ret;
 }
 
 /* Perform the SETUP request for all the streams.
@@ -7476,6 +7569,10 @@ gst_rtspsrc_setup_streams_end (GstRTSPSrc * src, gboolean async)
  * Otherwise, the first stream is setup right away from the reply and a
  * CMD_FINALIZE_SETUP command is set for the stream pipelines to happen on the
  * remaining streams from the RTSP thread.
+ *
+ * Requests are pipelined with RTSP 2.0. With RTSP 1.0 and fast-start, the
+ * requests of all streams after the first one are pipelined, once the first
+ * reply selected the transport and the session.
  */
 static GstRTSPResult
 gst_rtspsrc_setup_streams_start (GstRTSPSrc * src, gboolean async)
@@ -7492,6 +7589,8 @@ gst_rtspsrc_setup_streams_start (GstRTSPSrc * src, gboolean async)
   GstRTSPUrl *url;
   gchar *hval;
   gchar *pipelined_request_id = NULL;
+  gboolean pipelined = FALSE;
+  gboolean serial_fallback = FALSE;
 
   if (src->conninfo.connection) {
     url = gst_rtsp_connection_get_url (src->conninfo.connection);
@@ -7521,6 +7620,7 @@ gst_rtspsrc_setup_streams_start (GstRTSPSrc * src, gboolean async)
   if (G_UNLIKELY (src->streams == NULL))
     goto no_streams;
 
+next_pass:
   for (walk = src->streams; walk; walk = g_list_next (walk)) {
     GstRTSPConnInfo *conninfo;
     gchar *transports;
@@ -7532,6 +7632,10 @@ gst_rtspsrc_setup_streams_start (GstRTSPSrc * src, gboolean async)
 
     stream = (GstRTSPStream *) walk->data;
 
+    /* already set up from a pipelined response */
+    if (serial_fallback && stream->setup)
+      continue;
+
     caps = stream_get_caps_for_pt (stream, stream->default_pt);
     if (caps == NULL) {
       GST_WARNING_OBJECT (src, "skipping stream %p, no caps", stream);
@@ -7649,6 +7753,7 @@ gst_rtspsrc_setup_streams_start (GstRTSPSrc * src, gboolean async)
       if (!pipelined_request_id)
         pipelined_request_id = g_strdup_printf ("%d",
             g_random_int_range (0, G_MAXINT32));
+      pipelined = TRUE;
 
       gst_rtsp_message_add_header (&request, GST_RTSP_HDR_PIPELINED_REQUESTS,
           pipelined_request_id);
@@ -7684,7 +7789,7 @@ gst_rtspsrc_setup_streams_start (GstRTSPSrc * src, gboolean async)
     /* handle the code ourselves */
     res =
         gst_rtspsrc_send (src, conninfo, &request,
-        pipelined_request_id ? NULL : &response, &code, NULL);
+        pipelined ? NULL : &response, &code, NULL);
     if (res < 0)
       goto send_error;
 
@@ -7766,7 +7871,7 @@ gst_rtspsrc_setup_streams_start (GstRTSPSrc * src, gboolean async)
     }
 
 
-    if (!pipelined_request_id) {
+    if (!pipelined) {
       /* parse response transport */
       res = gst_rtsp_src_setup_stream_from_response (src, stream,
           &response, &protocols, retry, &rtpport, &rtcpport);
@@ -7778,6 +7883,11 @@ gst_rtspsrc_setup_streams_start (GstRTSPSrc * src, gboolean async)
         default:
           break;
       }
+
+      /* the transport and the session are known now, the other streams
+       * only need to follow */
+      if (src->fast_start && !serial_fallback && src->conninfo.connection)
+        pipelined = TRUE;
     } else {
       stream->waiting_setup_response = TRUE;
       /* we need to activate at least one stream when we detect activity */
@@ -7807,8 +7917,25 @@ gst_rtspsrc_setup_streams_start (GstRTSPSrc * src, gboolean async)
     gst_rtsp_message_unset (&request);
   }
 
-  if (pipelined_request_id) {
-    gst_rtspsrc_setup_streams_end (src, TRUE);
+  if (pipelined) {
+    GstRTSPStatusCode failed_code;
+
+    res = gst_rtspsrc_setup_streams_end (src, async, &failed_code);
+    if (res == GST_RTSP_ENOTIMPL) {
+      if (src->version < GST_RTSP_VERSION_2_0 && !serial_fallback) {
+        /* let the serial handshake deal with authentication, other
+         * transports, non-compliant control URLs and errors */
+        GST_DEBUG_OBJECT (src, "pipelined SETUP failed, setting up the "
+            "remaining streams one at a time");
+        serial_fallback = TRUE;
+        pipelined = FALSE;
+        goto next_pass;
+      }
+      code = failed_code;
+      goto response_error;
+    } else if (res < 0) {
+      goto cleanup_error;
+    }
   }
 
   /* store the transport protocol that was configured */
@@ -8170,6 +8297,137 @@ setup_failed:
   }
 }
 
+static GstRTSPResult
+gst_rtspsrc_init_describe_request (GstRTSPSrc * src, GstRTSPMessage * request)
+{
+  GstRTSPResult res;
+
+  res = gst_rtspsrc_init_request (src, request, GST_RTSP_DESCRIBE,
+      src->conninfo.url_str);
+  if (res < 0)
+    return res;
+
+  /* we only accept SDP for now */
+  gst_rtsp_message_add_header (request, GST_RTSP_HDR_ACCEPT,
+      "application/sdp");
+
+  if (src->backchannel == BACKCHANNEL_ONVIF)
+    gst_rtsp_message_add_header (request, GST_RTSP_HDR_REQUIRE,
+        BACKCHANNEL_ONVIF_HDR_REQUIRE_VAL);
+  /* TODO: Handle the case when backchannel is unsupported and goto restart */
+
+  return res;
+}
+
+/* Send OPTIONS and DESCRIBE back to back and receive both responses.
+ * Returns GST_RTSP_OK with the DESCRIBE response in @response when both
+ * requests succeeded, GST_RTSP_ENOTIMPL when the requests have to be done
+ * one at a time, for example to authenticate or to negotiate the RTSP
+ * version, and an error otherwise. */
+static GstRTSPResult
+gst_rtspsrc_pipeline_describe (GstRTSPSrc * src, GstRTSPMessage * response)
+{
+  GstRTSPMessage options = { 0 };
+  GstRTSPMessage describe = { 0 };
+  GstRTSPMessage options_response = { 0 };
+  GstRTSPStatusCode options_code = GST_RTSP_STS_INVALID;
+  GstRTSPStatusCode describe_code = GST_RTSP_STS_INVALID;
+  GstRTSPResult res;
+  gboolean options_sent, describe_sent;
+
+  if ((res = gst_rtspsrc_init_request (src, &options, GST_RTSP_OPTIONS,
+              src->conninfo.url_str)) < 0)
+    goto fallback;
+  if ((res = gst_rtspsrc_init_describe_request (src, &describe)) < 0)
+    goto fallback;
+
+  options.type_data.request.version = src->version;
+  describe.type_data.request.version = src->version;
+
+  GST_DEBUG_OBJECT (src, "send pipelined options and describe...");
+
+  res = gst_rtspsrc_send_request (src, &src->conninfo, &options,
+      &options_sent);
+  if (res < 0)
+    goto send_error;
+  if (!options_sent)
+    goto fallback;
+
+  res = gst_rtspsrc_send_request (src, &src->conninfo, &describe,
+      &describe_sent);
+  if (res < 0)
+    goto send_error;
+
+  res = gst_rtsp_src_receive_response (src, &src->conninfo,
+      &options_response, &options_code);
+  if (res < 0)
+    goto receive_error;
+  gst_rtsp_ext_list_after_send (src->extensions, &options, &options_response);
+
+  if (describe_sent) {
+    res = gst_rtsp_src_receive_response (src, &src->conninfo, response,
+        &describe_code);
+    if (res < 0)
+      goto receive_error;
+    gst_rtsp_ext_list_after_send (src->extensions, &describe, response);
+  }
+
+  if (options_code != GST_RTSP_STS_OK || describe_code != GST_RTSP_STS_OK) {
+    GST_DEBUG_OBJECT (src, "OPTIONS got %d, DESCRIBE got %d, retrying one by "
+        "one", options_code, describe_code);
+    gst_rtsp_message_unset (response);
+    goto fallback;
+  }
+
+  if (!gst_rtspsrc_parse_methods (src, &options_response)) {
+    /* error was posted */
+    gst_rtsp_message_unset (response);
+    res = GST_RTSP_ERROR;
+    goto done;
+  }
+
+  res = GST_RTSP_OK;
+  goto done;
+
+fallback:
+  res = GST_RTSP_ENOTIMPL;
+done:
+  gst_rtsp_message_unset (&options);
+  gst_rtsp_message_unset (&describe);
+  gst_rtsp_message_unset (&options_response);
+
+  return res;
+
+  /* ERRORS */
+send_error:
+  {
+    gchar *str = gst_rtsp_strresult (res);
+
+    if (res != GST_RTSP_EINTR) {
+      GST_ELEMENT_ERROR (src, RESOURCE, WRITE, (NULL),
+          ("Could not send message. (%s)", str));
+    } else {
+      GST_WARNING_OBJECT (src, "send interrupted");
+    }
+    g_free (str);
+    goto done;
+  }
+receive_error:
+  {
+    gchar *str = gst_rtsp_strresult (res);
+
+    if (res != GST_RTSP_EINTR) {
+      GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL),
+          ("Could not receive message. (%s)", str));
+    } else {
+      GST_WARNING_OBJECT (src, "receive interrupted");
+    }
+    g_free (str);
+    gst_rtsp_message_unset (response);
+    goto done;
+  }
+}
+
 static GstRTSPResult
 gst_rtspsrc_retrieve_sdp (GstRTSPSrc * src, GstSDPMessage ** sdp,
     gboolean async)
@@ -8201,6 +8459,17 @@ restart:
   if ((res = gst_rtsp_conninfo_connect (src, &src->conninfo, async)) < 0)
     goto connect_failed;
 
+  if (src->fast_start) {
+    if (async)
+      GST_ELEMENT_PROGRESS (src, CONTINUE, "open", ("Retrieving media info"));
+
+    res = gst_rtspsrc_pipeline_describe (src, &response);
+    if (res == GST_RTSP_OK)
+      goto describe_done;
+    else if (res != GST_RTSP_ENOTIMPL)
+      goto send_error;
+  }
+
   /* create OPTIONS */
   GST_DEBUG_OBJECT (src, "create options... (%s)", async ? "async" : "sync");
   res =
@@ -8232,21 +8501,10 @@ restart:
 
   /* create DESCRIBE */
   GST_DEBUG_OBJECT (src, "create describe...");
-  res =
-      gst_rtspsrc_init_request (src, &request, GST_RTSP_DESCRIBE,
-      src->conninfo.url_str);
+  res = gst_rtspsrc_init_describe_request (src, &request);
   if (res < 0)
     goto create_request_failed;
 
-  /* we only accept SDP for now */
-  gst_rtsp_message_add_header (&request, GST_RTSP_HDR_ACCEPT,
-      "application/sdp");
-
-  if (src->backchannel == BACKCHANNEL_ONVIF)
-    gst_rtsp_message_add_header (&request, GST_RTSP_HDR_REQUIRE,
-        BACKCHANNEL_ONVIF_HDR_REQUIRE_VAL);
-  /* TODO: Handle the case when backchannel is unsupported and goto restart */
-
   /* send DESCRIBE */
   GST_DEBUG_OBJECT (src, "send describe...");
 
@@ -8271,6 +8529,7 @@ restart:
     goto restart;
   }
 
+describe_done:
   /* it could be that the DESCRIBE method was not implemented */
   if (!(src->methods & GST_RTSP_DESCRIBE))
     goto no_describe;
@@ -8390,6 +8649,7 @@ gst_rtspsrc_open (GstRTSPSrc * src, gboolean async)
 
   src->methods =
       GST_RTSP_SETUP | GST_RTSP_PLAY | GST_RTSP_PAUSE | GST_RTSP_TEARDOWN;
+  src->open_time = g_get_monotonic_time ();
 
   if (src->sdp == NULL) {
     if ((ret = gst_rtspsrc_retrieve_sdp (src, &src->sdp, async)) < 0)
@@ -8399,6 +8659,9 @@ gst_rtspsrc_open (GstRTSPSrc * src, gboolean async)
   if ((ret = gst_rtspsrc_open_from_sdp (src, src->sdp, async)) < 0)
     goto open_failed;
 
+  GST_INFO_OBJECT (src, "streams set up %" G_GINT64_FORMAT " us after opening",
+      g_get_monotonic_time () - src->open_time);
+
   if (src->initial_seek) {
     if (!gst_rtspsrc_perform_seek (src, src->initial_seek))
       goto initial_seek_failed;
@@ -9059,6 +9322,10 @@ restart:
   src->base_time = -1;
   src->state = GST_RTSP_STATE_PLAYING;
 
+  if (src->open_time != 0)
+    GST_INFO_OBJECT (src, "playing %" G_GINT64_FORMAT " us after opening",
+        g_get_monotonic_time () - src->open_time);
+
   /* mark discont */
   GST_DEBUG_OBJECT (src, "mark DISCONT, we did a seek to another position");
   for (walk = src->streams; walk; walk = g_list_next (walk)) {
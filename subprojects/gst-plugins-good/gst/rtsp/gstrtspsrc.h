@@ -280,6 +280,7 @@ struct _GstRTSPSrc {
   gboolean          onvif_rate_control;
   gboolean          is_live;
   gboolean          ignore_x_server_reply;
+  gboolean          fast_start;
 
   /* state */
   GstRTSPState       state;
@@ -292,6 +293,7 @@ struct _GstRTSPSrc {
   gchar             *control;
   guint              next_port_num;
   GstClock          *provided_clock;
+  gint64             open_time;
 
   /* supported methods */
   gint               methods;
@@ -47,6 +47,10 @@
  * fields will be each a nested #GST_TYPE_ARRAY value. The first dimension are the
  * channels and the second dimension are the values.
  *
+ * Every interval is analysed with an FFT of 2 * (#GstSpectrum:bands - 1)
+ * samples. A power of two plus one as the number of bands, e.g. 129 or 1025,
+ * makes this a power of two, which the FFT library handles fastest.
+ *
  * ## Example application
  *
  * {{ tests/examples/spectrum/spectrum-example.c }}
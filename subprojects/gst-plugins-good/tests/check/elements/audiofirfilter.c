@@ -22,8 +22,13 @@
  * with newer GLib versions (>= 2.31.0) */
 #define GLIB_DISABLE_DEPRECATION_WARNINGS
 
+#include <math.h>
+#include <string.h>
+
 #include <gst/gst.h>
 #include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/audio/audio.h>
 
 static gboolean have_eos = FALSE;
 
@@ -178,6 +183,87 @@ GST_START_TEST (test_pipeline)
 
 GST_END_TEST;
 
+#define IMPULSE_KERNEL_LENGTH 100
+#define IMPULSE_SAMPLES 1000
+
+static void
+check_impulse_response (gboolean low_latency, guint partition_length)
+{
+  GstHarness *h;
+  GstBuffer *buffer;
+  GstMapInfo map;
+  GValueArray *va;
+  GValue v = { 0, };
+  gdouble *data;
+  gdouble output[IMPULSE_SAMPLES];
+  guint i, n_output = 0;
+
+  h = gst_harness_new ("audiofirfilter");
+  g_object_set (h->element, "low-latency", low_latency, "partition-length",
+      partition_length, NULL);
+
+  va = g_value_array_new (IMPULSE_KERNEL_LENGTH);
+  g_value_init (&v, G_TYPE_DOUBLE);
+  for (i = 0; i < IMPULSE_KERNEL_LENGTH; i++) {
+    g_value_set_double (&v, (i + 1) / (gdouble) IMPULSE_KERNEL_LENGTH);
+    g_value_array_append (va, &v);
+  }
+  g_value_unset (&v);
+  g_object_set (h->element, "kernel", va, NULL);
+  g_value_array_free (va);
+
+  gst_harness_set_src_caps_str (h, "audio/x-raw, format=" GST_AUDIO_NE (F64)
+      ", rate=44100, channels=1, layout=interleaved");
+
+  buffer = gst_buffer_new_allocate (NULL, IMPULSE_SAMPLES * sizeof (gdouble),
+      NULL);
+  gst_buffer_map (buffer, &map, GST_MAP_WRITE);
+  data = (gdouble *) map.data;
+  memset (data, 0, map.size);
+  data[0] = 1.0;
+  gst_buffer_unmap (buffer, &map);
+  GST_BUFFER_PTS (buffer) = 0;
+  GST_BUFFER_OFFSET (buffer) = 0;
+
+  fail_unless_equals_int (gst_harness_push (h, buffer), GST_FLOW_OK);
+  /* pushes the remaining samples */
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+
+  while ((buffer = gst_harness_try_pull (h))) {
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    fail_unless (n_output * sizeof (gdouble) + map.size <= sizeof (output));
+    memcpy (output + n_output, map.data, map.size);
+    n_output += map.size / sizeof (gdouble);
+    gst_buffer_unmap (buffer, &map);
+    gst_buffer_unref (buffer);
+  }
+
+  fail_unless_equals_int (n_output, IMPULSE_SAMPLES);
+  for (i = 0; i < IMPULSE_SAMPLES; i++) {
+    gdouble expected = i < IMPULSE_KERNEL_LENGTH ?
+        (i + 1) / (gdouble) IMPULSE_KERNEL_LENGTH : 0.0;
+
+    fail_unless (fabs (output[i] - expected) < 1e-9,
+        "sample %u: %f != %f", i, output[i], expected);
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_START_TEST (test_impulse_response)
+{
+  /* time domain */
+  check_impulse_response (TRUE, 0);
+  /* FFT over the complete kernel */
+  check_impulse_response (FALSE, 0);
+  /* partitioned FFT, with and without a partial last partition */
+  check_impulse_response (FALSE, 20);
+  check_impulse_response (FALSE, 32);
+  check_impulse_response (FALSE, 256);
+}
+
+GST_END_TEST;
+
 static Suite *
 audiofirfilter_suite (void)
 {
@@ -186,6 +272,7 @@ audiofirfilter_suite (void)
 
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_pipeline);
+  tcase_add_test (tc_chain, test_impulse_response);
 
   return s;
 }
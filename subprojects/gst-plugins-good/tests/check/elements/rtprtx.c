@@ -22,6 +22,8 @@
 #include <gst/check/gstharness.h>
 #include <gst/rtp/rtp.h>
 
+#include "../../gst/rtpmanager/gstrtprtxsend.h"
+
 #define verify_buf(buf, is_rtx, expected_ssrc, expted_pt, expected_seqnum)       \
   G_STMT_START {                                                                 \
     GstRTPBuffer _rtp = GST_RTP_BUFFER_INIT;                                     \
@@ -785,6 +787,235 @@ GST_START_TEST (test_rtxsender_max_size_time_no_clock_rate)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtxsender_max_size_bytes)
+{
+  const guint32 ssrcs[] = { 1234567, 2345678 };
+  const guint32 rtx_ssrcs[] = { 7654321, 8765432 };
+  const guint master_pt = 96;
+  const guint rtx_pt = 99;
+  /* 12 bytes of header and 29 of payload */
+  const guint packet_size = 41;
+  GstStructure *pt_map = gst_structure_new ("application/x-rtp-pt-map",
+      "96", G_TYPE_UINT, rtx_pt, NULL);
+  GstStructure *ssrc_map = gst_structure_new ("application/x-rtp-ssrc-map",
+      "1234567", G_TYPE_UINT, rtx_ssrcs[0],
+      "2345678", G_TYPE_UINT, rtx_ssrcs[1], NULL);
+  guint rtx_requests, rtx_packets, rtx_misses;
+  GstHarness *h;
+  gint i, j;
+
+  h = gst_harness_new ("rtprtxsend");
+
+  /* room for the 4 most recent packets of both ssrcs together */
+  g_object_set (h->element, "max-size-packets", 0,
+      "max-size-bytes", 4 * packet_size,
+      "payload-type-map", pt_map, "ssrc-map", ssrc_map, NULL);
+  gst_harness_set_src_caps_str (h, "application/x-rtp, "
+      "clock-rate = (int)90000");
+
+  for (i = 0; i < 4; i++) {
+    for (j = 0; j < G_N_ELEMENTS (ssrcs); j++) {
+      push_pull_and_verify (h, create_rtp_buffer (ssrcs[j], master_pt,
+              0x100 + i), FALSE, ssrcs[j], master_pt, 0x100 + i);
+    }
+  }
+
+  /* only the last two packets of each ssrc are still there */
+  for (j = 0; j < G_N_ELEMENTS (ssrcs); j++) {
+    for (i = 0; i < 4; i++) {
+      gst_harness_push_upstream_event (h,
+          create_rtx_event (ssrcs[j], master_pt, 0x100 + i));
+      if (i >= 2)
+        pull_and_verify (h, TRUE, rtx_ssrcs[j], rtx_pt, 0x100 + i);
+    }
+  }
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  g_object_get (h->element, "num-rtx-requests", &rtx_requests,
+      "num-rtx-packets", &rtx_packets, "num-rtx-misses", &rtx_misses, NULL);
+  fail_unless_equals_int (rtx_requests, 8);
+  fail_unless_equals_int (rtx_packets, 4);
+  fail_unless_equals_int (rtx_misses, 4);
+
+  gst_structure_free (pt_map);
+  gst_structure_free (ssrc_map);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+/* one ssrc stops sending while its packets are the oldest ones in the
+ * shared history. the entries of the packets of the other ssrc that
+ * max-size-packets drops behind them are still removed */
+GST_START_TEST (test_rtxsender_max_size_bytes_idle_ssrc)
+{
+  const guint32 ssrcs[] = { 1234567, 2345678 };
+  const guint32 rtx_ssrcs[] = { 7654321, 8765432 };
+  const guint master_pt = 96;
+  const guint rtx_pt = 99;
+  const guint n_packets = 10;
+  GstStructure *pt_map = gst_structure_new ("application/x-rtp-pt-map",
+      "96", G_TYPE_UINT, rtx_pt, NULL);
+  GstStructure *ssrc_map = gst_structure_new ("application/x-rtp-ssrc-map",
+      "1234567", G_TYPE_UINT, rtx_ssrcs[0],
+      "2345678", G_TYPE_UINT, rtx_ssrcs[1], NULL);
+  GstRtpRtxSend *rtx;
+  GstHarness *h;
+  guint i;
+
+  h = gst_harness_new ("rtprtxsend");
+  rtx = (GstRtpRtxSend *) h->element;
+
+  /* the byte budget is never reached */
+  g_object_set (h->element, "max-size-packets", n_packets,
+      "max-size-bytes", 1024 * 1024,
+      "payload-type-map", pt_map, "ssrc-map", ssrc_map, NULL);
+  gst_harness_set_src_caps_str (h, "application/x-rtp, "
+      "clock-rate = (int)90000");
+
+  for (i = 0; i < n_packets; i++) {
+    push_pull_and_verify (h, create_rtp_buffer (ssrcs[0], master_pt, i),
+        FALSE, ssrcs[0], master_pt, i);
+  }
+  for (i = 0; i < 20000; i++) {
+    push_pull_and_verify (h, create_rtp_buffer (ssrcs[1], master_pt, i),
+        FALSE, ssrcs[1], master_pt, i);
+  }
+
+  GST_OBJECT_LOCK (rtx);
+  fail_unless_equals_int (rtx->history_packets, 2 * n_packets);
+  fail_unless (gst_queue_array_get_length (rtx->history) <=
+      2 * n_packets + 1024);
+  GST_OBJECT_UNLOCK (rtx);
+
+  /* the stored packets of both ssrcs can still be retransmitted */
+  for (i = 0; i < n_packets; i++) {
+    gst_harness_push_upstream_event (h,
+        create_rtx_event (ssrcs[0], master_pt, i));
+    pull_and_verify (h, TRUE, rtx_ssrcs[0], rtx_pt, i);
+    gst_harness_push_upstream_event (h,
+        create_rtx_event (ssrcs[1], master_pt, 20000 - n_packets + i));
+    pull_and_verify (h, TRUE, rtx_ssrcs[1], rtx_pt, 20000 - n_packets + i);
+  }
+
+  /* and the idle ssrc is still the oldest one once the budget is reached */
+  g_object_set (h->element, "max-size-bytes", 2 * n_packets * 41 - 1, NULL);
+  gst_harness_push_upstream_event (h,
+      create_rtx_event (ssrcs[0], master_pt, 0));
+  gst_harness_push_upstream_event (h,
+      create_rtx_event (ssrcs[0], master_pt, 1));
+  pull_and_verify (h, TRUE, rtx_ssrcs[0], rtx_pt, 1);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  gst_structure_free (pt_map);
+  gst_structure_free (ssrc_map);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtxsender_reordered_packets)
+{
+  const guint32 master_ssrc = 1234567;
+  const guint32 rtx_ssrc = 7654321;
+  const guint master_pt = 96;
+  const guint rtx_pt = 99;
+  const guint16 seqnums[] = { 10, 13, 11, 12 };
+  GstStructure *pt_map = gst_structure_new ("application/x-rtp-pt-map",
+      "96", G_TYPE_UINT, rtx_pt, NULL);
+  GstStructure *ssrc_map = gst_structure_new ("application/x-rtp-ssrc-map",
+      "1234567", G_TYPE_UINT, rtx_ssrc, NULL);
+  guint rtx_misses;
+  GstHarness *h;
+  gint i;
+
+  h = gst_harness_new ("rtprtxsend");
+  g_object_set (h->element, "payload-type-map", pt_map,
+      "ssrc-map", ssrc_map, NULL);
+  gst_harness_set_src_caps_str (h, "application/x-rtp, "
+      "clock-rate = (int)90000");
+
+  for (i = 0; i < G_N_ELEMENTS (seqnums); i++) {
+    push_pull_and_verify (h, create_rtp_buffer (master_ssrc, master_pt,
+            seqnums[i]), FALSE, master_ssrc, master_pt, seqnums[i]);
+  }
+
+  /* packets that arrived late can be retransmitted as well */
+  for (i = 10; i <= 13; i++) {
+    gst_harness_push_upstream_event (h,
+        create_rtx_event (master_ssrc, master_pt, i));
+    pull_and_verify (h, TRUE, rtx_ssrc, rtx_pt, i);
+  }
+
+  /* but not the ones that were never sent */
+  gst_harness_push_upstream_event (h,
+      create_rtx_event (master_ssrc, master_pt, 9));
+  gst_harness_push_upstream_event (h,
+      create_rtx_event (master_ssrc, master_pt, 14));
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  g_object_get (h->element, "num-rtx-misses", &rtx_misses, NULL);
+  fail_unless_equals_int (rtx_misses, 2);
+
+  gst_structure_free (pt_map);
+  gst_structure_free (ssrc_map);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtxsender_max_size_bytes_reordered)
+{
+  const guint32 master_ssrc = 1234567;
+  const guint32 rtx_ssrc = 7654321;
+  const guint master_pt = 96;
+  const guint rtx_pt = 99;
+  /* 12 bytes of header and 29 of payload */
+  const guint packet_size = 41;
+  /* the byte budget drops the newest packet 5 while 4 is still missing */
+  const guint16 seqnums[] = { 1, 5, 2, 3, 4 };
+  GstStructure *pt_map = gst_structure_new ("application/x-rtp-pt-map",
+      "96", G_TYPE_UINT, rtx_pt, NULL);
+  GstStructure *ssrc_map = gst_structure_new ("application/x-rtp-ssrc-map",
+      "1234567", G_TYPE_UINT, rtx_ssrc, NULL);
+  guint rtx_misses;
+  GstHarness *h;
+  gint i;
+
+  h = gst_harness_new ("rtprtxsend");
+
+  /* no clock-rate, so max-size-time goes by the buffer timestamps */
+  g_object_set (h->element, "max-size-packets", 0,
+      "max-size-time", 1000, "max-size-bytes", 2 * packet_size,
+      "payload-type-map", pt_map, "ssrc-map", ssrc_map, NULL);
+  gst_harness_set_src_caps_str (h, "application/x-rtp");
+
+  for (i = 0; i < G_N_ELEMENTS (seqnums); i++) {
+    push_pull_and_verify (h, create_rtp_buffer_with_timestamp (master_ssrc,
+            master_pt, seqnums[i], seqnums[i] * 3000,
+            seqnums[i] * GST_SECOND / 30), FALSE, master_ssrc, master_pt,
+        seqnums[i]);
+  }
+
+  /* only the two packets pushed last are still there */
+  for (i = 1; i <= 5; i++) {
+    gst_harness_push_upstream_event (h,
+        create_rtx_event (master_ssrc, master_pt, i));
+    if (i == 3 || i == 4)
+      pull_and_verify (h, TRUE, rtx_ssrc, rtx_pt, i);
+  }
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  g_object_get (h->element, "num-rtx-misses", &rtx_misses, NULL);
+  fail_unless_equals_int (rtx_misses, 3);
+
+  gst_structure_free (pt_map);
+  gst_structure_free (ssrc_map);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 static void
 test_rtxqueue_packet_retention (gboolean test_with_time)
 {
@@ -1183,6 +1414,10 @@ rtprtx_suite (void)
   tcase_add_test (tc_chain, test_rtxsender_max_size_packets);
   tcase_add_test (tc_chain, test_rtxsender_max_size_time);
   tcase_add_test (tc_chain, test_rtxsender_max_size_time_no_clock_rate);
+  tcase_add_test (tc_chain, test_rtxsender_max_size_bytes);
+  tcase_add_test (tc_chain, test_rtxsender_max_size_bytes_idle_ssrc);
+  tcase_add_test (tc_chain, test_rtxsender_reordered_packets);
+  tcase_add_test (tc_chain, test_rtxsender_max_size_bytes_reordered);
 
   tcase_add_test (tc_chain, test_rtxqueue_max_size_packets);
   tcase_add_test (tc_chain, test_rtxqueue_max_size_time);
@@ -172,7 +172,7 @@ session_harness_get_last_twcc_stats (SessionHarness * h)
 }
 
 static SessionHarness *
-session_harness_new (void)
+session_harness_new_full (gboolean shared_rtcp_thread)
 {
   SessionHarness *h = g_new0 (SessionHarness, 1);
   h->caps = generate_caps ();
@@ -183,6 +183,7 @@ session_harness_new (void)
 
   h->session = gst_element_factory_make ("rtpsession", NULL);
   gst_element_set_clock (h->session, GST_CLOCK_CAST (h->testclock));
+  g_object_set (h->session, "shared-rtcp-thread", shared_rtcp_thread, NULL);
 
   h->send_rtp_h = gst_harness_new_with_element (h->session,
       "send_rtp_sink", "send_rtp_src");
@@ -207,6 +208,12 @@ session_harness_new (void)
   return h;
 }
 
+static SessionHarness *
+session_harness_new (void)
+{
+  return session_harness_new_full (FALSE);
+}
+
 static void
 session_harness_free (SessionHarness * h)
 {
@@ -419,6 +426,47 @@ GST_START_TEST (test_multiple_ssrc_rr)
 
 GST_END_TEST;
 
+GST_START_TEST (test_shared_rtcp_thread)
+{
+  SessionHarness *h = session_harness_new_full (TRUE);
+  GstFlowReturn res;
+  GstBuffer *buf;
+  GstRTCPBuffer rtcp = GST_RTCP_BUFFER_INIT;
+  GstRTCPPacket rtcp_packet;
+  gint i, j;
+
+  /* nothing is scheduled before the first packet */
+  fail_unless_equals_int (0, gst_test_clock_peek_id_count (h->testclock));
+
+  for (i = 0; i < 2; i++) {
+    for (j = 0; j < 2; j++) {
+      buf = generate_test_buffer (i, 0x01BADBAD + j);
+      res = session_harness_recv_rtp (h, buf);
+      fail_unless_equals_int (GST_FLOW_OK, res);
+    }
+  }
+
+  /* the timeouts are waited for asynchronously and the RTCP is generated on
+   * the shared thread pool */
+  for (i = 0; i < 2; i++) {
+    session_harness_produce_rtcp (h, 1);
+    buf = session_harness_pull_rtcp (h);
+    fail_unless (gst_rtcp_buffer_validate (buf));
+    gst_rtcp_buffer_map (buf, GST_MAP_READ, &rtcp);
+    fail_unless (gst_rtcp_buffer_get_first_packet (&rtcp, &rtcp_packet));
+    fail_unless_equals_int (GST_RTCP_TYPE_RR,
+        gst_rtcp_packet_get_type (&rtcp_packet));
+    fail_unless_equals_int (2, gst_rtcp_packet_get_rb_count (&rtcp_packet));
+    gst_rtcp_buffer_unmap (&rtcp);
+    gst_buffer_unref (buf);
+  }
+
+  /* stopping waits for the task */
+  session_harness_free (h);
+}
+
+GST_END_TEST;
+
 /* This verifies that rtpsession will correctly place RBs round-robin
  * across multiple RRs when there are too many senders that their RBs
  * do not fit in one RR */
@@ -627,6 +675,91 @@ GST_START_TEST (test_no_rbs_for_internal_senders)
 
 GST_END_TEST;
 
+GST_START_TEST (test_multiple_internal_senders_roundrobin_rbs)
+{
+  SessionHarness *h = session_harness_new ();
+  GstFlowReturn res;
+  GstBuffer *buf;
+  GstRTCPBuffer rtcp = GST_RTCP_BUFFER_INIT;
+  GstRTCPPacket rtcp_packet;
+  gint i, j, k;
+  guint32 ssrc;
+  GHashTable *rb_ssrcs, *tmp_set;
+
+  g_object_set (h->session, "rtcp-min-interval", 20 * GST_SECOND, NULL);
+
+  /* 2 internal and 40 remote senders */
+  for (j = 0; j < 5; j++) {
+    for (k = 0; k < 2; k++) {
+      buf = generate_test_buffer (j, 10000 + k);
+      res = session_harness_send_rtp (h, buf);
+      fail_unless_equals_int (GST_FLOW_OK, res);
+    }
+    for (k = 0; k < 40; k++) {
+      buf = generate_test_buffer (j, 20000 + k);
+      res = session_harness_recv_rtp (h, buf);
+      fail_unless_equals_int (GST_FLOW_OK, res);
+    }
+  }
+
+  rb_ssrcs = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+      (GDestroyNotify) g_hash_table_unref);
+
+  /* both internal senders report the same first 31 sources in the first
+   * round and the remaining 9 in the second */
+  for (i = 0; i < 4; i++) {
+    guint expected_rb_count = (i < 2) ? GST_RTCP_MAX_RB_COUNT :
+        (40 - GST_RTCP_MAX_RB_COUNT);
+
+    session_harness_produce_rtcp (h, 1);
+    buf = session_harness_pull_rtcp (h);
+    g_assert (buf != NULL);
+    fail_unless (gst_rtcp_buffer_validate (buf));
+
+    gst_rtcp_buffer_map (buf, GST_MAP_READ, &rtcp);
+    fail_unless (gst_rtcp_buffer_get_first_packet (&rtcp, &rtcp_packet));
+    fail_unless_equals_int (GST_RTCP_TYPE_SR,
+        gst_rtcp_packet_get_type (&rtcp_packet));
+    gst_rtcp_packet_sr_get_sender_info (&rtcp_packet, &ssrc, NULL, NULL,
+        NULL, NULL);
+    g_assert_cmpint (ssrc, >=, 10000);
+    g_assert_cmpint (ssrc, <=, 10001);
+
+    fail_unless_equals_int (expected_rb_count,
+        gst_rtcp_packet_get_rb_count (&rtcp_packet));
+
+    tmp_set = g_hash_table_lookup (rb_ssrcs, GUINT_TO_POINTER (ssrc));
+    if (tmp_set == NULL) {
+      tmp_set = g_hash_table_new (g_direct_hash, g_direct_equal);
+      g_hash_table_insert (rb_ssrcs, GUINT_TO_POINTER (ssrc), tmp_set);
+    }
+
+    for (j = 0; j < expected_rb_count; j++) {
+      gst_rtcp_packet_get_rb (&rtcp_packet, j, &ssrc, NULL, NULL,
+          NULL, NULL, NULL, NULL);
+      g_assert_cmpint (ssrc, >=, 20000);
+      g_assert_cmpint (ssrc, <, 20040);
+      g_hash_table_add (tmp_set, GUINT_TO_POINTER (ssrc));
+    }
+
+    gst_rtcp_buffer_unmap (&rtcp);
+    gst_buffer_unref (buf);
+  }
+
+  /* every internal sender reported every remote sender */
+  fail_unless_equals_int (2, g_hash_table_size (rb_ssrcs));
+  for (i = 10000; i < 10002; i++) {
+    tmp_set = g_hash_table_lookup (rb_ssrcs, GUINT_TO_POINTER (i));
+    g_assert (tmp_set);
+    fail_unless_equals_int (40, g_hash_table_size (tmp_set));
+  }
+
+  g_hash_table_unref (rb_ssrcs);
+  session_harness_free (h);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_internal_sources_timeout)
 {
   SessionHarness *h = session_harness_new ();
@@ -2204,6 +2337,55 @@ GST_START_TEST (test_request_nack_surplus)
 
 GST_END_TEST;
 
+/* With the shared RTCP thread pool, a session with a blocked downstream must
+ * not hold up the RTCP of the other sessions, nor its own timeouts */
+GST_START_TEST (test_shared_rtcp_thread_blocked_downstream)
+{
+#define NUM_SESSIONS 4
+  SessionHarness *h[NUM_SESSIONS];
+  BlockingProbeData probe;
+  GstBuffer *buf;
+  gint i, j;
+
+  for (i = 0; i < NUM_SESSIONS; i++) {
+    h[i] = session_harness_new_full (TRUE);
+    fail_unless_equals_int (GST_FLOW_OK,
+        session_harness_recv_rtp (h[i], generate_test_buffer (0,
+                0x01BADBAD)));
+  }
+
+  /* downstream of the first session stops taking RTCP */
+  session_harness_block_rtcp (h[0], &probe);
+
+  /* its timeouts are still handled while the push is blocked */
+  for (j = 0; j < 3; j++) {
+    session_harness_crank_clock (h[0]);
+    gst_test_clock_wait_for_next_pending_id (h[0]->testclock, NULL);
+  }
+
+  /* and all other sessions keep sending RTCP */
+  for (i = 1; i < NUM_SESSIONS; i++) {
+    for (j = 0; j < 2; j++) {
+      session_harness_produce_rtcp (h[i], 1);
+      buf = session_harness_pull_rtcp (h[i]);
+      fail_unless (gst_rtcp_buffer_validate (buf));
+      gst_buffer_unref (buf);
+    }
+  }
+
+  /* the blocked RTCP arrives once downstream takes it again */
+  session_harness_unblock_rtcp (h[0], &probe);
+  buf = session_harness_pull_rtcp (h[0]);
+  fail_unless (gst_rtcp_buffer_validate (buf));
+  gst_buffer_unref (buf);
+
+  for (i = 0; i < NUM_SESSIONS; i++)
+    session_harness_free (h[i]);
+#undef NUM_SESSIONS
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_request_nack_packing)
 {
   SessionHarness *h = session_harness_new ();
@@ -4041,6 +4223,141 @@ GST_START_TEST (test_twcc_send_and_recv)
 
 GST_END_TEST;
 
+GST_START_TEST (test_twcc_send_many_before_feedback)
+{
+  SessionHarness *h_send = session_harness_new ();
+  SessionHarness *h_recv = session_harness_new ();
+  const guint num_packets = 1000;
+  const guint num_received = 10;
+  GValueArray *packets_array;
+  GstEvent *event;
+  GstBuffer *buf;
+  guint i;
+
+  /* enable twcc */
+  session_harness_set_twcc_recv_ext_id (h_recv, TEST_TWCC_EXT_ID);
+  session_harness_set_twcc_send_ext_id (h_send, TEST_TWCC_EXT_ID);
+
+  /* send more packets than the sender keeps records of initially, only the
+     last ones arrive at the receiver */
+  for (i = 0; i < num_packets; i++) {
+    buf = generate_twcc_send_buffer (i, i == num_packets - 1);
+    fail_unless_equals_int (GST_FLOW_OK, session_harness_send_rtp (h_send,
+            buf));
+    buf = session_harness_pull_send_rtp (h_send);
+
+    if (i < num_packets - num_received) {
+      gst_buffer_unref (buf);
+      continue;
+    }
+    fail_unless_equals_int (GST_FLOW_OK, session_harness_recv_rtp (h_recv,
+            buf));
+  }
+
+  session_harness_recv_rtcp (h_send, session_harness_produce_twcc (h_recv));
+
+  while ((event = gst_harness_pull_upstream_event (h_send->send_rtp_h))) {
+    if (gst_event_has_name (event, "RTPTWCCPackets"))
+      break;
+    gst_event_unref (event);
+  }
+  fail_unless (event != NULL);
+
+  /* all the reported packets are matched with the ones that were sent */
+  packets_array = g_value_get_boxed (gst_structure_get_value
+      (gst_event_get_structure (event), "packets"));
+  fail_unless_equals_int (num_received, packets_array->n_values);
+  for (i = 0; i < packets_array->n_values; i++) {
+    const GstStructure *pkt_s =
+        gst_value_get_structure (g_value_array_get_nth (packets_array, i));
+    GstClockTime local_ts;
+    guint seqnum, size;
+
+    fail_unless (gst_structure_get_uint (pkt_s, "seqnum", &seqnum));
+    fail_unless (gst_structure_get_clock_time (pkt_s, "local-ts", &local_ts));
+    fail_unless (gst_structure_get_uint (pkt_s, "size", &size));
+    fail_unless_equals_int (num_packets - num_received + i, seqnum);
+    fail_unless (GST_CLOCK_TIME_IS_VALID (local_ts));
+    fail_unless_equals_int (TEST_BUF_SIZE, size);
+  }
+  gst_event_unref (event);
+
+  session_harness_free (h_send);
+  session_harness_free (h_recv);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_twcc_send_more_than_seqnum_space)
+{
+  SessionHarness *h_send = session_harness_new ();
+  SessionHarness *h_recv = session_harness_new ();
+  const guint num_packets = 65536 + 100;
+  const guint first_received = 200;
+  const guint num_received = 10;
+  GValueArray *packets_array;
+  GstEvent *event;
+  GstBuffer *buf;
+  guint i;
+
+  /* enable twcc */
+  session_harness_set_twcc_recv_ext_id (h_recv, TEST_TWCC_EXT_ID);
+  session_harness_set_twcc_send_ext_id (h_send, TEST_TWCC_EXT_ID);
+
+  /* the sender keeps records of the last 65536 seqnums, the oldest ones are
+     dropped once the seqnum wraps around. the packets that arrive at the
+     receiver were sent before that and are still recorded */
+  for (i = 0; i < num_packets; i++) {
+    gboolean received = i >= first_received &&
+        i < first_received + num_received;
+
+    buf = generate_twcc_send_buffer (i,
+        i == first_received + num_received - 1);
+    fail_unless_equals_int (GST_FLOW_OK, session_harness_send_rtp (h_send,
+            buf));
+    buf = session_harness_pull_send_rtp (h_send);
+
+    if (!received) {
+      gst_buffer_unref (buf);
+      continue;
+    }
+    fail_unless_equals_int (GST_FLOW_OK, session_harness_recv_rtp (h_recv,
+            buf));
+  }
+
+  session_harness_recv_rtcp (h_send, session_harness_produce_twcc (h_recv));
+
+  while ((event = gst_harness_pull_upstream_event (h_send->send_rtp_h))) {
+    if (gst_event_has_name (event, "RTPTWCCPackets"))
+      break;
+    gst_event_unref (event);
+  }
+  fail_unless (event != NULL);
+
+  packets_array = g_value_get_boxed (gst_structure_get_value
+      (gst_event_get_structure (event), "packets"));
+  fail_unless_equals_int (num_received, packets_array->n_values);
+  for (i = 0; i < packets_array->n_values; i++) {
+    const GstStructure *pkt_s =
+        gst_value_get_structure (g_value_array_get_nth (packets_array, i));
+    GstClockTime local_ts;
+    guint seqnum, size;
+
+    fail_unless (gst_structure_get_uint (pkt_s, "seqnum", &seqnum));
+    fail_unless (gst_structure_get_clock_time (pkt_s, "local-ts", &local_ts));
+    fail_unless (gst_structure_get_uint (pkt_s, "size", &size));
+    fail_unless_equals_int (first_received + i, seqnum);
+    fail_unless (GST_CLOCK_TIME_IS_VALID (local_ts));
+    fail_unless_equals_int (TEST_BUF_SIZE, size);
+  }
+  gst_event_unref (event);
+
+  session_harness_free (h_send);
+  session_harness_free (h_recv);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_twcc_multiple_payloads_below_window)
 {
   SessionHarness *h_send = session_harness_new ();
@@ -4312,8 +4629,10 @@ rtpsession_suite (void)
 
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_multiple_ssrc_rr);
+  tcase_add_test (tc_chain, test_shared_rtcp_thread);
   tcase_add_test (tc_chain, test_multiple_senders_roundrobin_rbs);
   tcase_add_test (tc_chain, test_no_rbs_for_internal_senders);
+  tcase_add_test (tc_chain, test_multiple_internal_senders_roundrobin_rbs);
   tcase_add_test (tc_chain, test_internal_sources_timeout);
   tcase_add_test (tc_chain, test_receive_rtcp_app_packet);
   tcase_add_test (tc_chain, test_dont_lock_on_stats);
@@ -4332,6 +4651,7 @@ rtpsession_suite (void)
   tcase_add_test (tc_chain, test_request_fir_after_pli_in_caps);
   tcase_add_test (tc_chain, test_request_nack);
   tcase_add_test (tc_chain, test_request_nack_surplus);
+  tcase_add_test (tc_chain, test_shared_rtcp_thread_blocked_downstream);
   tcase_add_test (tc_chain, test_request_nack_packing);
   tcase_add_test (tc_chain, test_illegal_rtcp_fb_packet);
   tcase_add_test (tc_chain, test_feedback_rtcp_race);
@@ -4377,6 +4697,8 @@ rtpsession_suite (void)
   tcase_add_test (tc_chain, test_twcc_recv_rtcp_reordered);
   tcase_add_test (tc_chain, test_twcc_no_exthdr_in_buffer);
   tcase_add_test (tc_chain, test_twcc_send_and_recv);
+  tcase_add_test (tc_chain, test_twcc_send_many_before_feedback);
+  tcase_add_test (tc_chain, test_twcc_send_more_than_seqnum_space);
   tcase_add_test (tc_chain, test_twcc_multiple_payloads_below_window);
   tcase_add_loop_test (tc_chain, test_twcc_feedback_interval, 0,
       G_N_ELEMENTS (test_twcc_feedback_interval_ctx));
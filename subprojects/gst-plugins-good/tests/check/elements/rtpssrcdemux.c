@@ -286,6 +286,55 @@ GST_START_TEST (test_rtpssrcdemux_max_streams)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtpssrcdemux_buffer_list)
+{
+  GstHarness *h = gst_harness_new_with_padnames ("rtpssrcdemux", "sink", NULL);
+  const guint32 ssrcs[] = { 1, 1, 2, 2, 1, 3 };
+  const guint expected[] = { 3, 2, 1 };
+  GstBufferList *list;
+  GSList *src_h = NULL, *walk;
+  guint i;
+
+  gst_harness_set_src_caps_str (h, "application/x-rtp");
+  g_signal_connect (h->element,
+      "new-ssrc-pad", (GCallback) new_ssrc_pad_found, &src_h);
+  gst_harness_play (h);
+
+  list = gst_buffer_list_new ();
+  for (i = 0; i < G_N_ELEMENTS (ssrcs); i++)
+    gst_buffer_list_add (list, create_buffer (i, ssrcs[i]));
+
+  fail_unless_equals_int (GST_FLOW_OK, gst_pad_push_list (h->srcpad, list));
+
+  /* pads were prepended, the one of the first SSRC is last */
+  fail_unless_equals_int (g_slist_length (src_h), 3);
+  for (walk = src_h, i = 3; walk; walk = walk->next) {
+    GstHarness *src = walk->data;
+    guint16 prev_seq = 0;
+    guint j;
+
+    i--;
+    fail_unless_equals_int (gst_harness_buffers_in_queue (src), expected[i]);
+    for (j = 0; j < expected[i]; j++) {
+      GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+      GstBuffer *buf = gst_harness_pull (src);
+
+      /* buffers of one SSRC keep their order */
+      fail_unless (gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp));
+      fail_unless_equals_int (gst_rtp_buffer_get_ssrc (&rtp), i + 1);
+      fail_unless (j == 0 || gst_rtp_buffer_get_seq (&rtp) > prev_seq);
+      prev_seq = gst_rtp_buffer_get_seq (&rtp);
+      gst_rtp_buffer_unmap (&rtp);
+      gst_buffer_unref (buf);
+    }
+  }
+
+  g_slist_free_full (src_h, (GDestroyNotify) gst_harness_teardown);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 static void
 new_rtcp_ssrc_pad_found (GstElement * element, guint ssrc,
     G_GNUC_UNUSED GstPad * rtp_pad, GSList ** src_h)
@@ -344,6 +393,49 @@ GST_START_TEST (test_rtpssrcdemux_invalid_rtp)
 
 GST_END_TEST;
 
+/* packets whose header is fine but whose padding or header extension
+ * length is not are dropped as well, also from buffer lists */
+GST_START_TEST (test_rtpssrcdemux_invalid_rtp_length)
+{
+  GstHarness *h = gst_harness_new_with_padnames ("rtpssrcdemux", "sink", NULL);
+  guint8 bad_padding[] = {
+    0xa0, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0xff, 0xff, 0xff, 0x20
+  };
+  guint8 bad_extension[] = {
+    0x90, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x02, 0xbe, 0xde, 0x00, 0x10,
+    0xff, 0xff, 0xff, 0xff
+  };
+  GSList *src_h = NULL;
+  GstBufferList *list;
+
+  gst_harness_set_src_caps_str (h, "application/x-rtp");
+  g_signal_connect (h->element,
+      "new-ssrc-pad", (GCallback) new_ssrc_pad_found, &src_h);
+  gst_harness_play (h);
+
+  fail_unless_equals_int (GST_FLOW_OK,
+      gst_harness_push (h, gst_buffer_new_memdup (bad_padding,
+              sizeof bad_padding)));
+  fail_unless_equals_int (GST_FLOW_OK,
+      gst_harness_push (h, gst_buffer_new_memdup (bad_extension,
+              sizeof bad_extension)));
+
+  list = gst_buffer_list_new ();
+  gst_buffer_list_add (list, gst_buffer_new_memdup (bad_padding,
+          sizeof bad_padding));
+  gst_buffer_list_add (list, gst_buffer_new_memdup (bad_extension,
+          sizeof bad_extension));
+  fail_unless_equals_int (GST_FLOW_OK, gst_pad_push_list (h->srcpad, list));
+
+  fail_unless (src_h == NULL);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_rtpssrcdemux_invalid_rtcp)
 {
   GstHarness *h =
@@ -463,8 +555,10 @@ rtpssrcdemux_suite (void)
   tcase_add_test (tc_chain, test_event_forwarding);
   tcase_add_test (tc_chain, test_oob_event_locking);
   tcase_add_test (tc_chain, test_rtpssrcdemux_max_streams);
+  tcase_add_test (tc_chain, test_rtpssrcdemux_buffer_list);
   tcase_add_test (tc_chain, test_rtpssrcdemux_rtcp_app);
   tcase_add_test (tc_chain, test_rtpssrcdemux_invalid_rtp);
+  tcase_add_test (tc_chain, test_rtpssrcdemux_invalid_rtp_length);
   tcase_add_test (tc_chain, test_rtpssrcdemux_invalid_rtcp);
   tcase_add_test (tc_chain, test_rtp_and_rtcp_arrives_simultaneously);
 
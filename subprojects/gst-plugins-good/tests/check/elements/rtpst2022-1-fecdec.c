@@ -424,6 +424,101 @@ GST_START_TEST (test_variable_length)
 
 GST_END_TEST;
 
+/**
+ * +--------------+
+ * | 9  | 10 |  x | l1
+ * +--------------+
+ *
+ * Media packets pushed as a buffer list after l1
+ *
+ * Missing values:
+ * 11: 0xc5
+ */
+GST_START_TEST (test_row_list)
+{
+  guint8 payload;
+  GstBufferList *list;
+  GstHarness *h =
+      gst_harness_new_with_padnames ("rtpst2022-1-fecdec", NULL, "src");
+  GstHarness *h0 = gst_harness_new_with_element (h->element, "sink", NULL);
+  GstHarness *h_fec_1 =
+      gst_harness_new_with_element (h->element, "fec_1", NULL);
+
+  gst_harness_set_src_caps_str (h0, "application/x-rtp");
+  gst_harness_set_src_caps_str (h_fec_1, "application/x-rtp");
+
+  payload = 0xda;
+  gst_harness_push (h_fec_1, make_fec_sample (0, 0, 9, TRUE, 1, 3, 0, &payload,
+          1, 1));
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  list = gst_buffer_list_new ();
+  payload = 0x37;
+  gst_buffer_list_add (list, make_media_sample (9, 0, &payload, 1));
+  payload = 0x28;
+  gst_buffer_list_add (list, make_media_sample (10, 0, &payload, 1));
+  fail_unless_equals_int (gst_pad_push_list (h0->srcpad, list), GST_FLOW_OK);
+
+  /* 11 is output right before 10, which allowed recovering it */
+  payload = 0x37;
+  pull_and_check (h, 9, 0, &payload, 1, 3);
+  payload = 0xc5;
+  pull_and_check (h, 11, 0, &payload, 1, 2);
+  payload = 0x28;
+  pull_and_check (h, 10, 0, &payload, 1, 1);
+
+  gst_harness_teardown (h);
+  gst_harness_teardown (h0);
+  gst_harness_teardown (h_fec_1);
+}
+
+GST_END_TEST;
+
+/* Invalid RTP packets are dropped, on their own and in buffer lists, and
+ * the valid packets of the list are still output */
+GST_START_TEST (test_invalid_list)
+{
+  guint8 payload;
+  guint8 bad_pkt[] = { 0x01, 0x02, 0x03 };
+  GstBufferList *list;
+  GstHarness *h =
+      gst_harness_new_with_padnames ("rtpst2022-1-fecdec", NULL, "src");
+  GstHarness *h0 = gst_harness_new_with_element (h->element, "sink", NULL);
+  GstHarness *h_fec_1 =
+      gst_harness_new_with_element (h->element, "fec_1", NULL);
+
+  gst_harness_set_src_caps_str (h0, "application/x-rtp");
+  gst_harness_set_src_caps_str (h_fec_1, "application/x-rtp");
+
+  fail_unless_equals_int (gst_harness_push (h0,
+          gst_buffer_new_memdup (bad_pkt, sizeof bad_pkt)), GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  payload = 0xda;
+  gst_harness_push (h_fec_1, make_fec_sample (0, 0, 9, TRUE, 1, 3, 0, &payload,
+          1, 1));
+
+  list = gst_buffer_list_new ();
+  payload = 0x37;
+  gst_buffer_list_add (list, make_media_sample (9, 0, &payload, 1));
+  gst_buffer_list_add (list, gst_buffer_new_memdup (bad_pkt, sizeof bad_pkt));
+  payload = 0x28;
+  gst_buffer_list_add (list, make_media_sample (10, 0, &payload, 1));
+  fail_unless_equals_int (gst_pad_push_list (h0->srcpad, list), GST_FLOW_OK);
+
+  payload = 0x37;
+  pull_and_check (h, 9, 0, &payload, 1, 3);
+  payload = 0xc5;
+  pull_and_check (h, 11, 0, &payload, 1, 2);
+  payload = 0x28;
+  pull_and_check (h, 10, 0, &payload, 1, 1);
+
+  gst_harness_teardown (h);
+  gst_harness_teardown (h0);
+  gst_harness_teardown (h_fec_1);
+}
+
+GST_END_TEST;
 
 static Suite *
 st2022_1_dec_suite (void)
@@ -437,6 +532,8 @@ st2022_1_dec_suite (void)
   tcase_add_test (tc_chain, test_column);
   tcase_add_test (tc_chain, test_2d);
   tcase_add_test (tc_chain, test_variable_length);
+  tcase_add_test (tc_chain, test_row_list);
+  tcase_add_test (tc_chain, test_invalid_list);
 
   return s;
 }
@@ -212,6 +212,175 @@ GST_START_TEST (test_columns)
 
 GST_END_TEST;
 
+GST_START_TEST (test_row_list)
+{
+  GstHarness *h, *h_fec_1;
+  GstBufferList *list;
+  guint8 payload;
+  GstElement *enc = gst_element_factory_make ("rtpst2022-1-fecenc", NULL);
+
+  g_object_set (enc, "columns", 3, "enable-column-fec", FALSE, NULL);
+  h = gst_harness_new_with_element (enc, "sink", "src");
+  h_fec_1 = gst_harness_new_with_element (h->element, NULL, "fec_1");
+
+  gst_harness_set_src_caps_str (h, "application/x-rtp");
+
+  list = gst_buffer_list_new ();
+  payload = 0x37;
+  gst_buffer_list_add (list, make_media_sample (0, 0, &payload, 1));
+  payload = 0x28;
+  gst_buffer_list_add (list, make_media_sample (1, 0, &payload, 1));
+  payload = 0xff;
+  gst_buffer_list_add (list, make_media_sample (2, 0, &payload, 1));
+  fail_unless_equals_int (gst_pad_push_list (h->srcpad, list), GST_FLOW_OK);
+
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 3);
+
+  payload = 0x37 ^ 0x28 ^ 0xff;
+  pull_and_check (h_fec_1, 1, 0, 1, 33, 0, TRUE, 1, 3, &payload, 1);
+
+  gst_object_unref (enc);
+  gst_harness_teardown (h);
+  gst_harness_teardown (h_fec_1);
+}
+
+GST_END_TEST;
+
+static void
+log_output_buffer (GString * log, GstPad * pad, GstBuffer * buffer)
+{
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+
+  fail_unless (gst_rtp_buffer_map (buffer, GST_MAP_READ, &rtp));
+  g_string_append_printf (log, "%s:%u ", GST_PAD_NAME (pad),
+      gst_rtp_buffer_get_seq (&rtp));
+  gst_rtp_buffer_unmap (&rtp);
+}
+
+static GstPadProbeReturn
+log_output (GstPad * pad, GstPadProbeInfo * info, GString * log)
+{
+  if (info->type & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    GstBufferList *list = GST_PAD_PROBE_INFO_BUFFER_LIST (info);
+    guint i;
+
+    for (i = 0; i < gst_buffer_list_length (list); i++)
+      log_output_buffer (log, pad, gst_buffer_list_get (list, i));
+  } else {
+    log_output_buffer (log, pad, GST_PAD_PROBE_INFO_BUFFER (info));
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+/* Returns the order in which media, column and row FEC packets came out for
+ * 40 media packets pushed with a 3 x 3 matrix, one by one or in lists of
+ * @list_length packets */
+static gchar *
+get_output_order (guint list_length)
+{
+  GstHarness *h, *h_fec_0, *h_fec_1;
+  GString *log = g_string_new (NULL);
+  const gchar *pad_names[] = { "src", "fec_0", "fec_1" };
+  GstBufferList *list = NULL;
+  guint8 payload = 0x37;
+  guint i;
+  GstElement *enc = gst_element_factory_make ("rtpst2022-1-fecenc", NULL);
+
+  g_object_set (enc, "columns", 3, "rows", 3, NULL);
+  h = gst_harness_new_with_element (enc, "sink", "src");
+  h_fec_0 = gst_harness_new_with_element (h->element, NULL, "fec_0");
+  h_fec_1 = gst_harness_new_with_element (h->element, NULL, "fec_1");
+
+  gst_harness_set_src_caps_str (h, "application/x-rtp");
+
+  for (i = 0; i < G_N_ELEMENTS (pad_names); i++) {
+    GstPad *pad = gst_element_get_static_pad (enc, pad_names[i]);
+
+    gst_pad_add_probe (pad,
+        GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+        (GstPadProbeCallback) log_output, log, NULL);
+    gst_object_unref (pad);
+  }
+
+  for (i = 0; i < 40; i++) {
+    GstBuffer *buffer = make_media_sample (i, 0, &payload, 1);
+
+    if (list_length == 0) {
+      fail_unless_equals_int (gst_harness_push (h, buffer), GST_FLOW_OK);
+      continue;
+    }
+
+    if (list == NULL)
+      list = gst_buffer_list_new ();
+    gst_buffer_list_add (list, buffer);
+    if (gst_buffer_list_length (list) == list_length || i == 39) {
+      fail_unless_equals_int (gst_pad_push_list (h->srcpad, list),
+          GST_FLOW_OK);
+      list = NULL;
+    }
+  }
+
+  gst_object_unref (enc);
+  gst_harness_teardown (h);
+  gst_harness_teardown (h_fec_0);
+  gst_harness_teardown (h_fec_1);
+
+  return g_string_free (log, FALSE);
+}
+
+GST_START_TEST (test_list_order)
+{
+  gchar *expected, *order;
+
+  expected = get_output_order (0);
+  GST_DEBUG ("single buffers: %s", expected);
+
+  order = get_output_order (7);
+  fail_unless_equals_string (order, expected);
+  g_free (order);
+
+  order = get_output_order (40);
+  fail_unless_equals_string (order, expected);
+  g_free (order);
+
+  g_free (expected);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_list_error)
+{
+  GstHarness *h;
+  GstBufferList *list;
+  guint8 payload = 0x37;
+  GstElement *enc = gst_element_factory_make ("rtpst2022-1-fecenc", NULL);
+
+  g_object_set (enc, "columns", 3, "enable-column-fec", FALSE, NULL);
+  h = gst_harness_new_with_element (enc, "sink", "src");
+
+  gst_harness_set_src_caps_str (h, "application/x-rtp");
+
+  /* the gap after the fourth packet is an error, the packets before it
+   * still go out */
+  list = gst_buffer_list_new ();
+  gst_buffer_list_add (list, make_media_sample (0, 0, &payload, 1));
+  gst_buffer_list_add (list, make_media_sample (1, 0, &payload, 1));
+  gst_buffer_list_add (list, make_media_sample (2, 0, &payload, 1));
+  gst_buffer_list_add (list, make_media_sample (3, 0, &payload, 1));
+  gst_buffer_list_add (list, make_media_sample (5, 0, &payload, 1));
+  gst_buffer_list_add (list, make_media_sample (6, 0, &payload, 1));
+  fail_unless_equals_int (gst_pad_push_list (h->srcpad, list),
+      GST_FLOW_ERROR);
+
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 4);
+
+  gst_object_unref (enc);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 static Suite *
 st2022_1_dec_suite (void)
 {
@@ -222,6 +391,9 @@ st2022_1_dec_suite (void)
 
   tcase_add_test (tc_chain, test_row);
   tcase_add_test (tc_chain, test_columns);
+  tcase_add_test (tc_chain, test_row_list);
+  tcase_add_test (tc_chain, test_list_order);
+  tcase_add_test (tc_chain, test_list_error);
 
   return s;
 }
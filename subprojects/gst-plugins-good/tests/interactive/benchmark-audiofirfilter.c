@@ -0,0 +1,153 @@
+/* GStreamer audiofirfilter benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Compares time domain, single FFT and partitioned FFT convolution in
+ * audiofirfilter for different kernel lengths. */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+/* the kernel property is a GValueArray */
+#define GLIB_DISABLE_DEPRECATION_WARNINGS
+
+#include <gst/gst.h>
+
+#define RATE 48000
+#define CHANNELS 2
+#define DEFAULT_SECONDS 10
+/* time domain convolution of longer kernels takes forever */
+#define MAX_TIME_DOMAIN_KERNEL 4096
+
+static const guint kernel_lengths[] = { 256, 4096, 16384, 65536 };
+static const guint partition_lengths[] = { 64, 256, 1024 };
+
+static void
+set_kernel (GstElement * filter, guint kernel_length)
+{
+  GValueArray *va;
+  GValue v = G_VALUE_INIT;
+  guint i;
+
+  va = g_value_array_new (kernel_length);
+  g_value_init (&v, G_TYPE_DOUBLE);
+  for (i = 0; i < kernel_length; i++) {
+    /* decaying noise, like a room impulse response */
+    g_value_set_double (&v, g_random_double_range (-1.0, 1.0) *
+        (kernel_length - i) / kernel_length / 16.0);
+    g_value_array_append (va, &v);
+  }
+  g_value_unset (&v);
+
+  g_object_set (filter, "kernel", va, NULL);
+  g_value_array_free (va);
+}
+
+static void
+do_benchmark (guint kernel_length, gboolean low_latency,
+    guint partition_length, guint seconds)
+{
+  GstElement *pipeline, *filter;
+  GstMessage *msg;
+  GstQuery *query;
+  GstClockTime latency = GST_CLOCK_TIME_NONE;
+  GTimer *timer;
+  gdouble elapsed;
+  gchar *desc;
+  guint64 samples = (guint64) seconds * RATE;
+
+  desc = g_strdup_printf ("audiotestsrc wave=white-noise num-buffers=%u "
+      "samplesperbuffer=1024 ! audio/x-raw,format=F32,rate=%d,channels=%d ! "
+      "audiofirfilter name=filter ! fakesink", (guint) (samples / 1024), RATE,
+      CHANNELS);
+  pipeline = gst_parse_launch (desc, NULL);
+  g_free (desc);
+  g_assert (pipeline != NULL);
+
+  filter = gst_bin_get_by_name (GST_BIN (pipeline), "filter");
+  g_object_set (filter, "low-latency", low_latency, "partition-length",
+      partition_length, NULL);
+  set_kernel (filter, kernel_length);
+
+  timer = g_timer_new ();
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      GST_CLOCK_TIME_NONE, GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  elapsed = g_timer_elapsed (timer, NULL);
+  g_timer_destroy (timer);
+  g_assert (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+
+  query = gst_query_new_latency ();
+  if (gst_element_query (filter, query))
+    gst_query_parse_latency (query, NULL, &latency, NULL);
+  gst_query_unref (query);
+
+  gst_println ("kernel %6u %-12s partition %5u: %8.2f ns/frame, "
+      "%7.1fx realtime, latency %" GST_TIME_FORMAT, kernel_length,
+      low_latency ? "time domain" : partition_length ? "partitioned" : "fft",
+      partition_length, elapsed * GST_SECOND / samples,
+      seconds / elapsed, GST_TIME_ARGS (latency));
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (filter);
+  gst_object_unref (pipeline);
+}
+
+int
+main (int argc, char **argv)
+{
+  GError *err = NULL;
+  gint kernel_length = 0;
+  gint seconds = DEFAULT_SECONDS;
+  GOptionContext *ctx;
+  GOptionEntry options[] = {
+    {"kernel-length", 'k', 0, G_OPTION_ARG_INT, &kernel_length,
+        "Kernel length (default: 256, 4096, 16384 and 65536)", NULL},
+    {"seconds", 's', 0, G_OPTION_ARG_INT, &seconds,
+        "Seconds of audio to filter in each run", NULL},
+    {NULL}
+  };
+  guint k, p;
+
+  ctx = g_option_context_new ("");
+  g_option_context_add_main_entries (ctx, options, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", GST_STR_NULL (err->message));
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  for (k = 0; k < G_N_ELEMENTS (kernel_lengths); k++) {
+    guint length = kernel_length > 0 ? kernel_length : kernel_lengths[k];
+
+    if (length <= MAX_TIME_DOMAIN_KERNEL)
+      do_benchmark (length, TRUE, 0, seconds);
+    do_benchmark (length, FALSE, 0, seconds);
+    for (p = 0; p < G_N_ELEMENTS (partition_lengths); p++)
+      do_benchmark (length, FALSE, partition_lengths[p], seconds);
+
+    if (kernel_length > 0)
+      break;
+  }
+
+  return 0;
+}
@@ -115,6 +115,10 @@ struct _GstRTSPClientPrivate
 
   GHashTable *pipelined_requests;       /* pipelined_request_id -> session_id */
   GstRTSPTunnelState tstate;
+
+  /* monotonic time of the last DESCRIBE until the first interleaved data
+   * was sent, protected by send_lock */
+  gint64 describe_time;
 };
 
 typedef struct
@@ -1027,24 +1031,46 @@ find_media (GstRTSPClient * client, GstRTSPContext * ctx, gchar * path,
      * media for uri */
     clean_cached_media (client, TRUE);
 
-    /* prepare the media and add it to the pipeline */
-    if (!(media = gst_rtsp_media_factory_construct (factory, url)))
-      goto no_media;
-
-    ctx->media = media;
-
-    if (!(gst_rtsp_media_get_transport_mode (media) &
-            GST_RTSP_TRANSPORT_MODE_RECORD)) {
-      GstRTSPThread *thread;
-
-      thread = gst_rtsp_thread_pool_get_thread (priv->thread_pool,
-          GST_RTSP_THREAD_TYPE_MEDIA, ctx);
-      if (thread == NULL)
-        goto no_thread;
+    /* use a media the factory prepared ahead of time if it has one, we then
+     * own its prepare */
+    media = gst_rtsp_media_factory_take_prepared (factory, url,
+        priv->thread_pool);
+    if (media) {
+      ctx->media = media;
+    } else {
+      /* prepare the media and add it to the pipeline */
+      if (!(media = gst_rtsp_media_factory_construct (factory, url)))
+        goto no_media;
+
+      ctx->media = media;
+
+      if (!(gst_rtsp_media_get_transport_mode (media) &
+              GST_RTSP_TRANSPORT_MODE_RECORD)) {
+        GstRTSPThread *thread;
+        gboolean blocking, prepared;
+
+        /* waiting for the preroll blocks all clients of this thread, don't
+         * let too many clients do that at the same time */
+        blocking = gst_rtsp_media_get_status (media) !=
+            GST_RTSP_MEDIA_STATUS_PREPARED;
+        if (blocking && !gst_rtsp_thread_pool_begin_prepare (priv->thread_pool))
+          goto too_busy;
+
+        thread = gst_rtsp_thread_pool_get_thread (priv->thread_pool,
+            GST_RTSP_THREAD_TYPE_MEDIA, ctx);
+        if (thread == NULL) {
+          if (blocking)
+            gst_rtsp_thread_pool_end_prepare (priv->thread_pool);
+          goto no_thread;
+        }
 
-      /* prepare the media */
-      if (!gst_rtsp_media_prepare (media, thread))
-        goto no_prepare;
+        /* prepare the media */
+        prepared = gst_rtsp_media_prepare (media, thread);
+        if (blocking)
+          gst_rtsp_thread_pool_end_prepare (priv->thread_pool);
+        if (!prepared)
+          goto no_prepare;
+      }
     }
 
     /* now keep track of the uri and the media */
@@ -1110,6 +1136,22 @@ no_thread:
     ctx->factory = NULL;
     return NULL;
   }
+too_busy:
+  {
+    GstRTSPStatusCode code = GST_RTSP_STS_SERVICE_UNAVAILABLE;
+
+    GST_WARNING ("client %p: too many medias preparing", client);
+    gst_rtsp_message_init_response (ctx->response, code,
+        gst_rtsp_status_as_text (code), ctx->request);
+    gst_rtsp_message_add_header (ctx->response, GST_RTSP_HDR_RETRY_AFTER, "1");
+    send_message (client, ctx, ctx->response, FALSE);
+    gst_rtsp_url_free (url);
+    g_object_unref (media);
+    ctx->media = NULL;
+    g_object_unref (factory);
+    ctx->factory = NULL;
+    return NULL;
+  }
 no_prepare:
   {
     GST_ERROR ("client %p: can't prepare media", client);
@@ -1199,6 +1241,20 @@ do_close (gpointer user_data)
   return G_SOURCE_REMOVE;
 }
 
+/* with send_lock */
+static void
+log_startup_latency (GstRTSPClient * client)
+{
+  GstRTSPClientPrivate *priv = client->priv;
+
+  if (G_LIKELY (priv->describe_time == 0))
+    return;
+
+  GST_INFO ("client %p: first data sent %" G_GINT64_FORMAT " us after "
+      "DESCRIBE", client, g_get_monotonic_time () - priv->describe_time);
+  priv->describe_time = 0;
+}
+
 static gboolean
 do_send_data (GstBuffer * buffer, guint8 channel, GstRTSPClient * client)
 {
@@ -1216,6 +1272,7 @@ do_send_data (GstBuffer * buffer, guint8 channel, GstRTSPClient * client)
     g_mutex_unlock (&priv->send_lock);
     return FALSE;
   }
+  log_startup_latency (client);
   if (priv->send_messages_func) {
     ret =
         priv->send_messages_func (client, &message, 1, FALSE, priv->send_data);
@@ -1261,6 +1318,8 @@ do_send_data_list (GstBufferList * buffer_list, guint8 channel,
     return FALSE;
   }
 
+  log_startup_latency (client);
+
   messages = g_newa (GstRTSPMessage, n);
   memset (messages, 0, sizeof (GstRTSPMessage) * n);
   for (i = 0; i < n; i++) {
@@ -2077,6 +2136,7 @@ seek_failed:
 static gboolean
 handle_play_request (GstRTSPClient * client, GstRTSPContext * ctx)
 {
+  GstRTSPClientPrivate *priv = client->priv;
   GstRTSPSession *session;
   GstRTSPClientClass *klass;
   GstRTSPSessionMedia *sessmedia;
@@ -2196,6 +2256,12 @@ handle_play_request (GstRTSPClient * client, GstRTSPContext * ctx)
 
   send_message (client, ctx, ctx->response, FALSE);
 
+  g_mutex_lock (&priv->send_lock);
+  if (priv->describe_time != 0)
+    GST_INFO ("client %p: PLAY response sent %" G_GINT64_FORMAT " us after "
+        "DESCRIBE", client, g_get_monotonic_time () - priv->describe_time);
+  g_mutex_unlock (&priv->send_lock);
+
   /* start playing after sending the response */
   gst_rtsp_session_media_set_state (sessmedia, GST_STATE_PLAYING);
 
@@ -3315,6 +3381,11 @@ handle_describe_request (GstRTSPClient * client, GstRTSPContext * ctx)
     goto sig_failed;
   }
 
+  /* to measure how long it takes until the client gets data */
+  g_mutex_lock (&priv->send_lock);
+  priv->describe_time = g_get_monotonic_time ();
+  g_mutex_unlock (&priv->send_lock);
+
   /* check what kind of format is accepted, we don't really do anything with it
    * and always return SDP for now. */
   for (i = 0;; i++) {
@@ -75,6 +75,9 @@ struct _GstRTSPMediaFactoryPrivate
   GMutex medias_lock;
   GHashTable *medias;           /* protected by medias_lock */
 
+  guint prepared_pool_size;
+  GHashTable *prepared;         /* protected by medias_lock */
+
   GType media_gtype;
 
   GstClock *clock;
@@ -98,6 +101,23 @@ struct _GstRTSPMediaFactoryPrivate
 #define DEFAULT_DO_RETRANSMISSION FALSE
 #define DEFAULT_DSCP_QOS        (-1)
 #define DEFAULT_ENABLE_RTCP     TRUE
+#define DEFAULT_PREPARED_POOL_SIZE 0
+
+/* Medias of a non-shared factory that were constructed and prepared ahead of
+ * time for one key, so that a client can start right away */
+typedef struct
+{
+  GstRTSPUrl *url;
+  GstRTSPThreadPool *thread_pool;
+  GQueue medias;                /* prepared GstRTSPMedia */
+  guint n_preparing;
+} PreparedPool;
+
+typedef struct
+{
+  GstRTSPMediaFactory *factory;
+  gchar *key;
+} PrepareJob;
 
 enum
 {
@@ -117,6 +137,7 @@ enum
   PROP_BIND_MCAST_ADDRESS,
   PROP_DSCP_QOS,
   PROP_ENABLE_RTCP,
+  PROP_PREPARED_POOL_SIZE,
   PROP_LAST
 };
 
@@ -148,6 +169,7 @@ static void default_configure (GstRTSPMediaFactory * factory,
     GstRTSPMedia * media);
 static GstElement *default_create_pipeline (GstRTSPMediaFactory * factory,
     GstRTSPMedia * media);
+static void prepared_pool_free (PreparedPool * pool);
 
 G_DEFINE_TYPE_WITH_PRIVATE (GstRTSPMediaFactory, gst_rtsp_media_factory,
     G_TYPE_OBJECT);
@@ -268,6 +290,25 @@ gst_rtsp_media_factory_class_init (GstRTSPMediaFactoryClass * klass)
           "The IP DSCP field to use", -1, 63,
           DEFAULT_DSCP_QOS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstRTSPMediaFactory:prepared-pool-size:
+   *
+   * The number of medias that are constructed and prepared ahead of time for
+   * each url of a non-shared factory, so that clients don't have to wait for
+   * the pipeline to preroll on DESCRIBE. The medias are prepared in the
+   * background after a client first requested the url and every time a client
+   * took one of them. The #GstRTSPMediaFactory::media-constructed and
+   * #GstRTSPMediaFactory::media-configure signals of those medias are emitted
+   * from the background threads.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_PREPARED_POOL_SIZE,
+      g_param_spec_uint ("prepared-pool-size", "Prepared Pool Size",
+          "The number of medias to keep prepared for non-shared factories",
+          0, G_MAXUINT, DEFAULT_PREPARED_POOL_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_rtsp_media_factory_signals[SIGNAL_MEDIA_CONSTRUCTED] =
       g_signal_new ("media-constructed", G_TYPE_FROM_CLASS (klass),
       G_SIGNAL_RUN_LAST, G_STRUCT_OFFSET (GstRTSPMediaFactoryClass,
@@ -313,14 +354,35 @@ gst_rtsp_media_factory_init (GstRTSPMediaFactory * factory)
   priv->bind_mcast_address = DEFAULT_BIND_MCAST_ADDRESS;
   priv->enable_rtcp = DEFAULT_ENABLE_RTCP;
   priv->dscp_qos = DEFAULT_DSCP_QOS;
+  priv->prepared_pool_size = DEFAULT_PREPARED_POOL_SIZE;
 
   g_mutex_init (&priv->lock);
   g_mutex_init (&priv->medias_lock);
   priv->medias = g_hash_table_new_full (g_str_hash, g_str_equal,
       g_free, g_object_unref);
+  priv->prepared = g_hash_table_new_full (g_str_hash, g_str_equal,
+      g_free, (GDestroyNotify) prepared_pool_free);
   priv->media_gtype = GST_TYPE_RTSP_MEDIA;
 }
 
+static void
+release_prepared_media (GstRTSPMedia * media)
+{
+  gst_rtsp_media_unprepare (media);
+  g_object_unref (media);
+}
+
+/* must not be called with medias_lock, unpreparing a media can call back
+ * into the factory */
+static void
+prepared_pool_free (PreparedPool * pool)
+{
+  g_queue_clear_full (&pool->medias, (GDestroyNotify) release_prepared_media);
+  gst_rtsp_url_free (pool->url);
+  g_object_unref (pool->thread_pool);
+  g_free (pool);
+}
+
 static void
 gst_rtsp_media_factory_finalize (GObject * obj)
 {
@@ -332,6 +394,7 @@ gst_rtsp_media_factory_finalize (GObject * obj)
   if (priv->permissions)
     gst_rtsp_permissions_unref (priv->permissions);
   g_hash_table_unref (priv->medias);
+  g_hash_table_unref (priv->prepared);
   g_mutex_clear (&priv->medias_lock);
   g_free (priv->launch);
   g_mutex_clear (&priv->lock);
@@ -402,6 +465,10 @@ gst_rtsp_media_factory_get_property (GObject * object, guint propid,
       g_value_set_boolean (value,
           gst_rtsp_media_factory_is_enable_rtcp (factory));
       break;
+    case PROP_PREPARED_POOL_SIZE:
+      g_value_set_uint (value,
+          gst_rtsp_media_factory_get_prepared_pool_size (factory));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, propid, pspec);
   }
@@ -467,6 +534,10 @@ gst_rtsp_media_factory_set_property (GObject * object, guint propid,
       gst_rtsp_media_factory_set_enable_rtcp (factory,
           g_value_get_boolean (value));
       break;
+    case PROP_PREPARED_POOL_SIZE:
+      gst_rtsp_media_factory_set_prepared_pool_size (factory,
+          g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, propid, pspec);
   }
@@ -1320,6 +1391,86 @@ gst_rtsp_media_factory_get_latency (GstRTSPMediaFactory * factory)
   return res;
 }
 
+/**
+ * gst_rtsp_media_factory_set_prepared_pool_size:
+ * @factory: a #GstRTSPMediaFactory
+ * @size: the number of medias to keep prepared
+ *
+ * Configure @factory to keep @size medias constructed and prepared for each
+ * url of a non-shared factory, so that clients get a media that is ready to
+ * play immediately instead of having to wait for the pipeline to preroll.
+ *
+ * The medias for an url are prepared in the background after the first
+ * client requested it and every time a client took a prepared media. Note
+ * that the #GstRTSPMediaFactory::media-constructed and
+ * #GstRTSPMediaFactory::media-configure signals are emitted ahead of time for
+ * those medias, from one of the threads that prepare them. The current
+ * #GstRTSPContext then only has the factory, the url and the media set, it
+ * has no client or request.
+ *
+ * The threads are shared by all factories. gst_rtsp_thread_pool_cleanup()
+ * waits for them to finish and frees them.
+ *
+ * This has no effect on shared factories and factories that record.
+ *
+ * Since: 1.24
+ */
+void
+gst_rtsp_media_factory_set_prepared_pool_size (GstRTSPMediaFactory * factory,
+    guint size)
+{
+  GstRTSPMediaFactoryPrivate *priv;
+  GHashTableIter iter;
+  PreparedPool *pool;
+  GList *trimmed = NULL;
+
+  g_return_if_fail (GST_IS_RTSP_MEDIA_FACTORY (factory));
+
+  priv = factory->priv;
+
+  GST_RTSP_MEDIA_FACTORY_LOCK (factory);
+  priv->prepared_pool_size = size;
+  GST_RTSP_MEDIA_FACTORY_UNLOCK (factory);
+
+  g_mutex_lock (&priv->medias_lock);
+  g_hash_table_iter_init (&iter, priv->prepared);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) & pool)) {
+    while (g_queue_get_length (&pool->medias) > size)
+      trimmed = g_list_prepend (trimmed, g_queue_pop_tail (&pool->medias));
+  }
+  g_mutex_unlock (&priv->medias_lock);
+
+  /* unpreparing takes the medias_lock again */
+  g_list_free_full (trimmed, (GDestroyNotify) release_prepared_media);
+}
+
+/**
+ * gst_rtsp_media_factory_get_prepared_pool_size:
+ * @factory: a #GstRTSPMediaFactory
+ *
+ * Get the number of medias that @factory keeps prepared for each url.
+ *
+ * Returns: the number of prepared medias.
+ *
+ * Since: 1.24
+ */
+guint
+gst_rtsp_media_factory_get_prepared_pool_size (GstRTSPMediaFactory * factory)
+{
+  GstRTSPMediaFactoryPrivate *priv;
+  guint res;
+
+  g_return_val_if_fail (GST_IS_RTSP_MEDIA_FACTORY (factory), 0);
+
+  priv = factory->priv;
+
+  GST_RTSP_MEDIA_FACTORY_LOCK (factory);
+  res = priv->prepared_pool_size;
+  GST_RTSP_MEDIA_FACTORY_UNLOCK (factory);
+
+  return res;
+}
+
 static gboolean
 compare_media (gpointer key, GstRTSPMedia * media1, GstRTSPMedia * media2)
 {
@@ -1360,6 +1511,36 @@ weak_ref_free (GWeakRef * ref)
   g_slice_free (GWeakRef, ref);
 }
 
+/* construct and configure a new media */
+static GstRTSPMedia *
+construct_media (GstRTSPMediaFactory * factory, const GstRTSPUrl * url)
+{
+  GstRTSPMediaFactoryClass *klass;
+  GstRTSPMedia *media;
+
+  klass = GST_RTSP_MEDIA_FACTORY_GET_CLASS (factory);
+
+  if (klass->construct)
+    media = klass->construct (factory, url);
+  else
+    media = NULL;
+
+  if (media == NULL)
+    return NULL;
+
+  g_signal_emit (factory,
+      gst_rtsp_media_factory_signals[SIGNAL_MEDIA_CONSTRUCTED], 0, media, NULL);
+
+  /* configure the media */
+  if (klass->configure)
+    klass->configure (factory, media);
+
+  g_signal_emit (factory,
+      gst_rtsp_media_factory_signals[SIGNAL_MEDIA_CONFIGURE], 0, media, NULL);
+
+  return media;
+}
+
 /**
  * gst_rtsp_media_factory_construct:
  * @factory: a #GstRTSPMediaFactory
@@ -1410,24 +1591,9 @@ gst_rtsp_media_factory_construct (GstRTSPMediaFactory * factory,
 
   if (media == NULL) {
     /* nothing cached found, try to create one */
-    if (klass->construct) {
-      media = klass->construct (factory, url);
-      if (media)
-        g_signal_emit (factory,
-            gst_rtsp_media_factory_signals[SIGNAL_MEDIA_CONSTRUCTED], 0, media,
-            NULL);
-    } else
-      media = NULL;
+    media = construct_media (factory, url);
 
     if (media) {
-      /* configure the media */
-      if (klass->configure)
-        klass->configure (factory, media);
-
-      g_signal_emit (factory,
-          gst_rtsp_media_factory_signals[SIGNAL_MEDIA_CONFIGURE], 0, media,
-          NULL);
-
       /* check if we can cache this media */
       if (gst_rtsp_media_is_shared (media) && key) {
         /* insert in the hashtable, takes ownership of the key */
@@ -1454,6 +1620,185 @@ gst_rtsp_media_factory_construct (GstRTSPMediaFactory * factory,
   return media;
 }
 
+static void
+prepare_job_func (PrepareJob * job, gpointer user_data)
+{
+  GstRTSPMediaFactory *factory = job->factory;
+  GstRTSPMediaFactoryPrivate *priv = factory->priv;
+  GstRTSPContext sctx = { NULL };
+  PreparedPool *pool;
+  GstRTSPUrl *url;
+  GstRTSPThreadPool *thread_pool;
+  GstRTSPThread *thread;
+  GstRTSPMedia *media;
+  guint size;
+
+  /* pools are only freed in finalize and the job keeps the factory alive */
+  g_mutex_lock (&priv->medias_lock);
+  pool = g_hash_table_lookup (priv->prepared, job->key);
+  url = gst_rtsp_url_copy (pool->url);
+  thread_pool = g_object_ref (pool->thread_pool);
+  g_mutex_unlock (&priv->medias_lock);
+
+  /* there is no client or request, but the signal handlers and the thread
+   * pool still get the factory, url and media they are working on */
+  sctx.factory = factory;
+  sctx.uri = url;
+  gst_rtsp_context_push_current (&sctx);
+
+  media = construct_media (factory, url);
+  if (media && gst_rtsp_media_is_shared (media)) {
+    GST_WARNING ("media %p for url %s was made shared, not keeping it",
+        media, url->abspath);
+    g_clear_object (&media);
+  }
+
+  if (media) {
+    sctx.media = media;
+    thread = gst_rtsp_thread_pool_get_thread (thread_pool,
+        GST_RTSP_THREAD_TYPE_MEDIA, &sctx);
+    if (thread == NULL || !gst_rtsp_media_prepare (media, thread)) {
+      GST_WARNING ("failed to prepare media %p for url %s", media,
+          url->abspath);
+      g_clear_object (&media);
+    }
+  }
+
+  gst_rtsp_context_pop_current (&sctx);
+
+  GST_RTSP_MEDIA_FACTORY_LOCK (factory);
+  size = priv->prepared_pool_size;
+  GST_RTSP_MEDIA_FACTORY_UNLOCK (factory);
+
+  g_mutex_lock (&priv->medias_lock);
+  pool->n_preparing--;
+  if (media && g_queue_get_length (&pool->medias) < size) {
+    GST_DEBUG ("prepared media %p for url %s", media, url->abspath);
+    g_queue_push_tail (&pool->medias, media);
+    media = NULL;
+  }
+  g_mutex_unlock (&priv->medias_lock);
+
+  if (media)
+    release_prepared_media (media);
+
+  gst_rtsp_url_free (url);
+  g_object_unref (thread_pool);
+  g_object_unref (factory);
+  g_free (job->key);
+  g_free (job);
+}
+
+/* prepares the medias of all factories in the background, freed with
+ * gst_rtsp_thread_pool_cleanup() */
+static GThreadPool *prepare_thread_pool;
+
+static GThreadPool *
+get_prepare_thread_pool (void)
+{
+  if (G_UNLIKELY (!g_atomic_pointer_get (&prepare_thread_pool))) {
+    GThreadPool *t_pool;
+
+    t_pool = g_thread_pool_new ((GFunc) prepare_job_func, NULL,
+        g_get_num_processors (), FALSE, NULL);
+    if (!g_atomic_pointer_compare_and_exchange (&prepare_thread_pool,
+            (GThreadPool *) NULL, t_pool))
+      g_thread_pool_free (t_pool, FALSE, TRUE);
+  }
+
+  return prepare_thread_pool;
+}
+
+/* waits for the medias that are being prepared in the background */
+void
+gst_rtsp_media_factory_cleanup_prepare_pool (void)
+{
+  if (prepare_thread_pool != NULL) {
+    g_thread_pool_free (prepare_thread_pool, FALSE, TRUE);
+    prepare_thread_pool = NULL;
+  }
+}
+
+/* takes a media that was prepared ahead of time for @url and schedules the
+ * preparation of new medias with @thread_pool until there are prepared-pool-size
+ * of them again. The caller owns one prepare of the returned media and should
+ * unprepare it when done. Returns %NULL when there is no prepared media, the
+ * caller should construct one itself. */
+GstRTSPMedia *
+gst_rtsp_media_factory_take_prepared (GstRTSPMediaFactory * factory,
+    const GstRTSPUrl * url, GstRTSPThreadPool * thread_pool)
+{
+  GstRTSPMediaFactoryPrivate *priv;
+  GstRTSPMediaFactoryClass *klass;
+  GstRTSPTransportMode transport_mode;
+  PreparedPool *pool;
+  GstRTSPMedia *media;
+  GList *stale = NULL;
+  gboolean shared;
+  gchar *key;
+  guint size, n_pending, n_new, i;
+
+  g_return_val_if_fail (GST_IS_RTSP_MEDIA_FACTORY (factory), NULL);
+  g_return_val_if_fail (url != NULL, NULL);
+  g_return_val_if_fail (GST_IS_RTSP_THREAD_POOL (thread_pool), NULL);
+
+  priv = factory->priv;
+  klass = GST_RTSP_MEDIA_FACTORY_GET_CLASS (factory);
+
+  GST_RTSP_MEDIA_FACTORY_LOCK (factory);
+  size = priv->prepared_pool_size;
+  shared = priv->shared;
+  transport_mode = priv->transport_mode;
+  GST_RTSP_MEDIA_FACTORY_UNLOCK (factory);
+
+  /* shared medias are already kept prepared in the medias cache */
+  if (size == 0 || shared || klass->gen_key == NULL ||
+      (transport_mode & GST_RTSP_TRANSPORT_MODE_RECORD))
+    return NULL;
+
+  key = klass->gen_key (factory, url);
+  if (key == NULL)
+    return NULL;
+
+  g_mutex_lock (&priv->medias_lock);
+  pool = g_hash_table_lookup (priv->prepared, key);
+  if (pool == NULL) {
+    pool = g_new0 (PreparedPool, 1);
+    pool->url = gst_rtsp_url_copy (url);
+    pool->thread_pool = g_object_ref (thread_pool);
+    g_queue_init (&pool->medias);
+    g_hash_table_insert (priv->prepared, g_strdup (key), pool);
+  }
+
+  while ((media = g_queue_pop_head (&pool->medias))) {
+    if (gst_rtsp_media_get_status (media) == GST_RTSP_MEDIA_STATUS_PREPARED)
+      break;
+    /* went into error or EOS while waiting for a client */
+    stale = g_list_prepend (stale, media);
+  }
+
+  n_pending = g_queue_get_length (&pool->medias) + pool->n_preparing;
+  n_new = size > n_pending ? size - n_pending : 0;
+  pool->n_preparing += n_new;
+  g_mutex_unlock (&priv->medias_lock);
+
+  for (i = 0; i < n_new; i++) {
+    PrepareJob *job = g_new (PrepareJob, 1);
+
+    job->factory = g_object_ref (factory);
+    job->key = g_strdup (key);
+    g_thread_pool_push (get_prepare_thread_pool (), job, NULL);
+  }
+  g_free (key);
+
+  g_list_free_full (stale, (GDestroyNotify) release_prepared_media);
+
+  GST_INFO ("took prepared media %p for url %s, preparing %u more", media,
+      url->abspath, n_new);
+
+  return media;
+}
+
 /**
  * gst_rtsp_media_factory_set_media_gtype:
  * @factory: a #GstRTSPMediaFactory
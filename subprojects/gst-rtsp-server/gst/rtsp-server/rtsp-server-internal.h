@@ -25,6 +25,9 @@
 G_BEGIN_DECLS
 
 #include "rtsp-stream-transport.h"
+#include "rtsp-session-pool.h"
+#include "rtsp-media-factory.h"
+#include "rtsp-thread-pool.h"
 
 /* Internal GstRTSPStreamTransport interface */
 
@@ -63,6 +66,28 @@ gboolean                 gst_rtsp_stream_is_tcp_receiver (GstRTSPStream * stream
 void                     gst_rtsp_media_set_enable_rtcp (GstRTSPMedia *media, gboolean enable);
 void                     gst_rtsp_stream_set_enable_rtcp (GstRTSPStream *stream, gboolean enable);
 
+/* Internal GstRTSPSession and GstRTSPSessionPool interface */
+
+void                     gst_rtsp_session_set_pool (GstRTSPSession * session,
+                                                    GstRTSPSessionPool * pool);
+
+void                     gst_rtsp_session_pool_update_expiry (GstRTSPSessionPool * pool,
+                                                              GstRTSPSession * session);
+
+/* Internal GstRTSPThreadPool interface */
+
+gboolean                 gst_rtsp_thread_pool_begin_prepare (GstRTSPThreadPool * pool);
+
+void                     gst_rtsp_thread_pool_end_prepare (GstRTSPThreadPool * pool);
+
+/* Internal GstRTSPMediaFactory interface */
+
+GstRTSPMedia *           gst_rtsp_media_factory_take_prepared (GstRTSPMediaFactory * factory,
+                                                               const GstRTSPUrl * url,
+                                                               GstRTSPThreadPool * thread_pool);
+
+void                     gst_rtsp_media_factory_cleanup_prepare_pool (void);
+
 G_END_DECLS
 
 #endif /* __GST_RTSP_SERVER_INTERNAL_H__ */
@@ -44,6 +44,18 @@
 #endif
 
 #include "rtsp-session-pool.h"
+#include "rtsp-server-internal.h"
+
+/* The time at which a session expires. Sessions are touched without the pool
+ * knowing about it, which only moves their expiry time further away, so the
+ * time here is the earliest the session can expire and is updated when the
+ * session is looked at again. */
+typedef struct
+{
+  GstRTSPSession *session;
+  gint64 expiry;                /* monotonic time in microseconds */
+  GSequenceIter *iter;          /* in expiry_queue, NULL if never expiring */
+} ExpiryEntry;
 
 struct _GstRTSPSessionPoolPrivate
 {
@@ -51,6 +63,11 @@ struct _GstRTSPSessionPoolPrivate
   guint max_sessions;
   GHashTable *sessions;
   guint sessions_cookie;
+
+  /* GstRTSPSession -> ExpiryEntry */
+  GHashTable *expiries;
+  /* ExpiryEntry sorted by expiry time, earliest first */
+  GSequence *expiry_queue;
 };
 
 #define DEFAULT_MAX_SESSIONS 0
@@ -134,6 +151,8 @@ gst_rtsp_session_pool_init (GstRTSPSessionPool * pool)
   g_mutex_init (&priv->lock);
   priv->sessions = g_hash_table_new_full (g_str_hash, g_str_equal,
       NULL, g_object_unref);
+  priv->expiries = g_hash_table_new_full (NULL, NULL, NULL, g_free);
+  priv->expiry_queue = g_sequence_new (NULL);
   priv->max_sessions = DEFAULT_MAX_SESSIONS;
 }
 
@@ -152,11 +171,112 @@ gst_rtsp_session_pool_finalize (GObject * object)
 
   gst_rtsp_session_pool_filter (pool, remove_sessions_func, NULL);
   g_hash_table_unref (priv->sessions);
+  g_hash_table_unref (priv->expiries);
+  g_sequence_free (priv->expiry_queue);
   g_mutex_clear (&priv->lock);
 
   G_OBJECT_CLASS (gst_rtsp_session_pool_parent_class)->finalize (object);
 }
 
+static gint
+compare_expiry (const ExpiryEntry * a, const ExpiryEntry * b,
+    gpointer user_data)
+{
+  if (a->expiry < b->expiry)
+    return -1;
+  if (a->expiry > b->expiry)
+    return 1;
+  return 0;
+}
+
+/* with lock, @timeout is the result of gst_rtsp_session_next_timeout_usec()
+ * at @now */
+static void
+schedule_expiry (GstRTSPSessionPoolPrivate * priv, ExpiryEntry * entry,
+    gint64 now, gint timeout)
+{
+  if (timeout < 0) {
+    /* the session never expires, keep it out of the queue */
+    if (entry->iter) {
+      g_sequence_remove (entry->iter);
+      entry->iter = NULL;
+    }
+    return;
+  }
+
+  entry->expiry = now + (gint64) timeout * 1000;
+  if (entry->iter)
+    g_sequence_sort_changed (entry->iter, (GCompareDataFunc) compare_expiry,
+        NULL);
+  else
+    entry->iter = g_sequence_insert_sorted (priv->expiry_queue, entry,
+        (GCompareDataFunc) compare_expiry, NULL);
+}
+
+/* with lock */
+static void
+add_expiry (GstRTSPSessionPoolPrivate * priv, GstRTSPSession * sess)
+{
+  ExpiryEntry *entry;
+  gint64 now;
+
+  entry = g_new0 (ExpiryEntry, 1);
+  entry->session = sess;
+  g_hash_table_insert (priv->expiries, sess, entry);
+
+  now = g_get_monotonic_time ();
+  schedule_expiry (priv, entry, now,
+      gst_rtsp_session_next_timeout_usec (sess, now));
+}
+
+/* with lock */
+static void
+remove_expiry (GstRTSPSessionPoolPrivate * priv, GstRTSPSession * sess)
+{
+  ExpiryEntry *entry;
+
+  entry = g_hash_table_lookup (priv->expiries, sess);
+  if (entry == NULL)
+    return;
+
+  if (entry->iter)
+    g_sequence_remove (entry->iter);
+  g_hash_table_remove (priv->expiries, sess);
+}
+
+/* with lock, returns the entry that expires first or %NULL */
+static ExpiryEntry *
+peek_expiry (GstRTSPSessionPoolPrivate * priv)
+{
+  GSequenceIter *iter;
+
+  iter = g_sequence_get_begin_iter (priv->expiry_queue);
+  if (g_sequence_iter_is_end (iter))
+    return NULL;
+
+  return g_sequence_get (iter);
+}
+
+/* Called by the session when its timeout changed, which can make it expire
+ * earlier than what we have in the queue */
+void
+gst_rtsp_session_pool_update_expiry (GstRTSPSessionPool * pool,
+    GstRTSPSession * sess)
+{
+  GstRTSPSessionPoolPrivate *priv = pool->priv;
+  ExpiryEntry *entry;
+
+  g_mutex_lock (&priv->lock);
+  entry = g_hash_table_lookup (priv->expiries, sess);
+  if (entry) {
+    gint64 now = g_get_monotonic_time ();
+
+    schedule_expiry (priv, entry, now,
+        gst_rtsp_session_next_timeout_usec (sess, now));
+  }
+  g_mutex_unlock (&priv->lock);
+}
+
 static void
 gst_rtsp_session_pool_get_property (GObject * object, guint propid,
     GValue * value, GParamSpec * pspec)
@@ -393,6 +513,8 @@ gst_rtsp_session_pool_create (GstRTSPSessionPool * pool)
       g_object_ref (result);
       g_hash_table_insert (priv->sessions,
           (gchar *) gst_rtsp_session_get_sessionid (result), result);
+      gst_rtsp_session_set_pool (result, pool);
+      add_expiry (priv, result);
       priv->sessions_cookie++;
     }
     g_mutex_unlock (&priv->lock);
@@ -454,8 +576,10 @@ gst_rtsp_session_pool_remove (GstRTSPSessionPool * pool, GstRTSPSession * sess)
   found =
       g_hash_table_remove (priv->sessions,
       gst_rtsp_session_get_sessionid (sess));
-  if (found)
+  if (found) {
+    remove_expiry (priv, sess);
     priv->sessions_cookie++;
+  }
   g_mutex_unlock (&priv->lock);
 
   if (found)
@@ -467,28 +591,6 @@ gst_rtsp_session_pool_remove (GstRTSPSessionPool * pool, GstRTSPSession * sess)
   return found;
 }
 
-typedef struct
-{
-  gint64 now_monotonic_time;
-  GstRTSPSessionPool *pool;
-  GList *removed;
-} CleanupData;
-
-static gboolean
-cleanup_func (gchar * sessionid, GstRTSPSession * sess, CleanupData * data)
-{
-  gboolean expired;
-
-  expired = gst_rtsp_session_is_expired_usec (sess, data->now_monotonic_time);
-
-  if (expired) {
-    GST_DEBUG ("session expired");
-    data->removed = g_list_prepend (data->removed, g_object_ref (sess));
-  }
-
-  return expired;
-}
-
 /**
  * gst_rtsp_session_pool_cleanup:
  * @pool: a #GstRTSPSessionPool
@@ -503,27 +605,42 @@ gst_rtsp_session_pool_cleanup (GstRTSPSessionPool * pool)
 {
   GstRTSPSessionPoolPrivate *priv;
   guint result;
-  CleanupData data;
-  GList *walk;
+  gint64 now;
+  ExpiryEntry *entry;
+  GList *removed, *walk;
 
   g_return_val_if_fail (GST_IS_RTSP_SESSION_POOL (pool), 0);
 
   priv = pool->priv;
 
-  data.now_monotonic_time = g_get_monotonic_time ();
-
-  data.pool = pool;
-  data.removed = NULL;
+  now = g_get_monotonic_time ();
+  result = 0;
+  removed = NULL;
 
   g_mutex_lock (&priv->lock);
-  result =
-      g_hash_table_foreach_remove (priv->sessions, (GHRFunc) cleanup_func,
-      &data);
+  /* only the sessions at the front of the queue can have expired */
+  while ((entry = peek_expiry (priv)) && entry->expiry <= now) {
+    GstRTSPSession *sess = entry->session;
+    gint timeout;
+
+    timeout = gst_rtsp_session_next_timeout_usec (sess, now);
+    if (timeout == 0) {
+      GST_DEBUG ("session expired");
+      removed = g_list_prepend (removed, g_object_ref (sess));
+      remove_expiry (priv, sess);
+      g_hash_table_remove (priv->sessions,
+          gst_rtsp_session_get_sessionid (sess));
+      result++;
+    } else {
+      /* touched or reconfigured since it was scheduled */
+      schedule_expiry (priv, entry, now, timeout);
+    }
+  }
   if (result > 0)
     priv->sessions_cookie++;
   g_mutex_unlock (&priv->lock);
 
-  for (walk = data.removed; walk; walk = walk->next) {
+  for (walk = removed; walk; walk = walk->next) {
     GstRTSPSession *sess = walk->data;
 
     g_signal_emit (pool,
@@ -531,7 +648,7 @@ gst_rtsp_session_pool_cleanup (GstRTSPSessionPool * pool)
 
     g_object_unref (sess);
   }
-  g_list_free (data.removed);
+  g_list_free (removed);
 
   return result;
 }
@@ -617,6 +734,7 @@ restart:
           g_hash_table_iter_remove (&iter);
 
         if (removed) {
+          remove_expiry (priv, session);
           /* if we managed to remove the session, update the cookie and
            * signal */
           cookie = ++priv->sessions_cookie;
@@ -658,34 +776,40 @@ typedef struct
   gint timeout;
 } GstPoolSource;
 
-static void
-collect_timeout (gchar * sessionid, GstRTSPSession * sess, GstPoolSource * psrc)
-{
-  gint timeout;
-  gint64 now_monotonic_time;
-
-  now_monotonic_time = g_get_monotonic_time ();
-
-  timeout = gst_rtsp_session_next_timeout_usec (sess, now_monotonic_time);
-
-  GST_INFO ("%p: next timeout: %d", sess, timeout);
-  if (psrc->timeout == -1 || timeout < psrc->timeout)
-    psrc->timeout = timeout;
-}
-
 static gboolean
 gst_pool_source_prepare (GSource * source, gint * timeout)
 {
   GstRTSPSessionPoolPrivate *priv;
   GstPoolSource *psrc;
+  ExpiryEntry *entry;
+  gint64 now;
   gboolean result;
 
   psrc = (GstPoolSource *) source;
   psrc->timeout = -1;
   priv = psrc->pool->priv;
 
+  now = g_get_monotonic_time ();
+
   g_mutex_lock (&priv->lock);
-  g_hash_table_foreach (priv->sessions, (GHFunc) collect_timeout, psrc);
+  while ((entry = peek_expiry (priv))) {
+    gint next;
+
+    if (entry->expiry > now) {
+      /* round up, we don't want to wake up before the session expires */
+      psrc->timeout = MIN ((entry->expiry - now + 999) / 1000, G_MAXINT);
+      break;
+    }
+
+    next = gst_rtsp_session_next_timeout_usec (entry->session, now);
+    GST_INFO ("%p: next timeout: %d", entry->session, next);
+    if (next == 0) {
+      psrc->timeout = 0;
+      break;
+    }
+    /* the session was touched, look at the next one */
+    schedule_expiry (priv, entry, now, next);
+  }
   g_mutex_unlock (&priv->lock);
 
   if (timeout)
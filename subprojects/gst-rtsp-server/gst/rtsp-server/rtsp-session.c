@@ -49,6 +49,7 @@
 #include <string.h>
 
 #include "rtsp-session.h"
+#include "rtsp-server-internal.h"
 
 struct _GstRTSPSessionPrivate
 {
@@ -65,6 +66,9 @@ struct _GstRTSPSessionPrivate
   GList *medias;
   guint medias_cookie;
   guint extra_time_timeout;
+
+  /* the GstRTSPSessionPool that tracks our expiry */
+  GWeakRef pool;
 };
 
 #undef DEBUG
@@ -160,6 +164,7 @@ gst_rtsp_session_init (GstRTSPSession * session)
   g_mutex_init (&priv->last_access_lock);
   priv->timeout = DEFAULT_TIMEOUT;
   priv->extra_time_timeout = DEFAULT_EXTRA_TIMEOUT;
+  g_weak_ref_init (&priv->pool, NULL);
 
   gst_rtsp_session_touch (session);
 }
@@ -180,12 +185,32 @@ gst_rtsp_session_finalize (GObject * obj)
 
   /* free session id */
   g_free (priv->sessionid);
+  g_weak_ref_clear (&priv->pool);
   g_mutex_clear (&priv->last_access_lock);
   g_mutex_clear (&priv->lock);
 
   G_OBJECT_CLASS (gst_rtsp_session_parent_class)->finalize (obj);
 }
 
+/* let the pool know that we might expire at a different time now */
+static void
+update_pool_expiry (GstRTSPSession * session)
+{
+  GstRTSPSessionPool *pool;
+
+  pool = g_weak_ref_get (&session->priv->pool);
+  if (pool) {
+    gst_rtsp_session_pool_update_expiry (pool, session);
+    g_object_unref (pool);
+  }
+}
+
+void
+gst_rtsp_session_set_pool (GstRTSPSession * session, GstRTSPSessionPool * pool)
+{
+  g_weak_ref_set (&session->priv->pool, pool);
+}
+
 static void
 gst_rtsp_session_get_property (GObject * object, guint propid,
     GValue * value, GParamSpec * pspec)
@@ -235,6 +260,7 @@ gst_rtsp_session_set_property (GObject * object, guint propid,
       g_mutex_lock (&priv->lock);
       priv->extra_time_timeout = g_value_get_uint (value);
       g_mutex_unlock (&priv->lock);
+      update_pool_expiry (session);
       break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, propid, pspec);
@@ -623,6 +649,8 @@ gst_rtsp_session_set_timeout (GstRTSPSession * session, guint timeout)
   g_mutex_lock (&priv->lock);
   priv->timeout = timeout;
   g_mutex_unlock (&priv->lock);
+
+  update_pool_expiry (session);
 }
 
 /**
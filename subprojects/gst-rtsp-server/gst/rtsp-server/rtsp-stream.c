@@ -60,6 +60,8 @@
  * When a sample is popped, it is either sent directly on transports that don't
  * experience backpressure, or queued on the transport's backlog otherwise. Samples
  * are then popped from that backlog when the transport reports it has sent the message.
+ * Everything of the same kind (RTP or RTCP) that queued up meanwhile is popped at once
+ * and sent as one buffer list, which the connection writes with a single writev.
  *
  * Once the backlog reaches an overly large duration, the transport is dropped as
  * the client was deemed too slow.
@@ -241,6 +243,10 @@ struct _GstRTSPStreamPrivate
 #define DEFAULT_DO_RATE_CONTROL TRUE
 #define DEFAULT_ENABLE_RTCP TRUE
 
+/* maximum number of packets to send to a TCP transport at once when
+ * draining its backlog */
+#define MAX_BACKLOG_BATCH 64
+
 enum
 {
   PROP_0,
@@ -2629,6 +2635,45 @@ ensure_cached_transports (GstRTSPStream * stream)
   }
 }
 
+static void
+append_to_list (GstBufferList * list, GstBuffer * buffer,
+    GstBufferList * buffer_list)
+{
+  if (buffer) {
+    gst_buffer_list_add (list, buffer);
+  } else {
+    guint i, len = gst_buffer_list_length (buffer_list);
+
+    for (i = 0; i < len; i++)
+      gst_buffer_list_add (list,
+          gst_buffer_ref (gst_buffer_list_get (buffer_list, i)));
+    gst_buffer_list_unref (buffer_list);
+  }
+}
+
+/* Must be called with the backlog lock. Takes ownership of @buffer or
+ * @buffer_list and adds the following backlog items of the same kind to them,
+ * so that they can be sent with one message chunk */
+static GstBufferList *
+merge_backlog (GstRTSPStreamTransport * trans, GstBuffer * buffer,
+    GstBufferList * buffer_list, gboolean is_rtp)
+{
+  GstBufferList *merged;
+
+  merged = gst_buffer_list_new_sized (MAX_BACKLOG_BATCH);
+  append_to_list (merged, buffer, buffer_list);
+
+  while (gst_buffer_list_length (merged) < MAX_BACKLOG_BATCH &&
+      !gst_rtsp_stream_transport_backlog_is_empty (trans) &&
+      gst_rtsp_stream_transport_backlog_peek_is_rtp (trans) == is_rtp) {
+    gst_rtsp_stream_transport_backlog_pop (trans, &buffer, &buffer_list,
+        NULL);
+    append_to_list (merged, buffer, buffer_list);
+  }
+
+  return merged;
+}
+
 /* Must be called *without* priv->lock */
 static void
 check_transport_backlog (GstRTSPStream * stream, GstRTSPStreamTransport * trans)
@@ -2653,6 +2698,12 @@ check_transport_backlog (GstRTSPStream * stream, GstRTSPStreamTransport * trans)
 
       g_assert (popped == TRUE);
 
+      if (!gst_rtsp_stream_transport_backlog_is_empty (trans) &&
+          gst_rtsp_stream_transport_backlog_peek_is_rtp (trans) == is_rtp) {
+        buffer_list = merge_backlog (trans, buffer, buffer_list, is_rtp);
+        buffer = NULL;
+      }
+
       send_ret = push_data (stream, trans, buffer, buffer_list, is_rtp);
 
       gst_clear_buffer (&buffer);
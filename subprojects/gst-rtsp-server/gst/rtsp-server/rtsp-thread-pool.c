@@ -53,6 +53,7 @@
 #include <string.h>
 
 #include "rtsp-thread-pool.h"
+#include "rtsp-server-internal.h"
 
 typedef struct _GstRTSPThreadImpl
 {
@@ -194,14 +195,19 @@ struct _GstRTSPThreadPoolPrivate
   gint max_threads;
   /* currently used mainloops */
   GQueue threads;
+
+  guint max_preparing;
+  guint n_preparing;
 };
 
 #define DEFAULT_MAX_THREADS 1
+#define DEFAULT_MAX_PREPARING 0
 
 enum
 {
   PROP_0,
   PROP_MAX_THREADS,
+  PROP_MAX_PREPARING,
   PROP_LAST
 };
 
@@ -247,6 +253,23 @@ gst_rtsp_thread_pool_class_init (GstRTSPThreadPoolClass * klass)
           "(0 = only mainloop, -1 = unlimited)", -1, G_MAXINT,
           DEFAULT_MAX_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstRTSPThreadPool::max-preparing:
+   *
+   * The maximum amount of medias that clients can be preparing at the same
+   * time. Preparing a media blocks the client thread until the pipeline
+   * prerolled, which also blocks all other clients sharing the thread.
+   * Clients that would exceed the limit get a 503 Service Unavailable
+   * response with a Retry-After header instead. 0 means no limit.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_PREPARING,
+      g_param_spec_uint ("max-preparing", "Max Preparing",
+          "The maximum amount of medias clients can prepare at the same time "
+          "(0 = unlimited)", 0, G_MAXUINT,
+          DEFAULT_MAX_PREPARING, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   klass->get_thread = default_get_thread;
 
   GST_DEBUG_CATEGORY_INIT (rtsp_thread_pool_debug, "rtspthreadpool", 0,
@@ -264,6 +287,7 @@ gst_rtsp_thread_pool_init (GstRTSPThreadPool * pool)
 
   g_mutex_init (&priv->lock);
   priv->max_threads = DEFAULT_MAX_THREADS;
+  priv->max_preparing = DEFAULT_MAX_PREPARING;
   g_queue_init (&priv->threads);
 }
 
@@ -291,6 +315,9 @@ gst_rtsp_thread_pool_get_property (GObject * object, guint propid,
     case PROP_MAX_THREADS:
       g_value_set_int (value, gst_rtsp_thread_pool_get_max_threads (pool));
       break;
+    case PROP_MAX_PREPARING:
+      g_value_set_uint (value, gst_rtsp_thread_pool_get_max_preparing (pool));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, propid, pspec);
   }
@@ -306,6 +333,9 @@ gst_rtsp_thread_pool_set_property (GObject * object, guint propid,
     case PROP_MAX_THREADS:
       gst_rtsp_thread_pool_set_max_threads (pool, g_value_get_int (value));
       break;
+    case PROP_MAX_PREPARING:
+      gst_rtsp_thread_pool_set_max_preparing (pool, g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, propid, pspec);
   }
@@ -409,6 +439,115 @@ gst_rtsp_thread_pool_get_max_threads (GstRTSPThreadPool * pool)
   return res;
 }
 
+/**
+ * gst_rtsp_thread_pool_set_max_preparing:
+ * @pool: a #GstRTSPThreadPool
+ * @max_preparing: maximum medias being prepared
+ *
+ * Set the maximum amount of medias that clients can be preparing at the
+ * same time. A value of 0 means no limit.
+ *
+ * Since: 1.24
+ */
+void
+gst_rtsp_thread_pool_set_max_preparing (GstRTSPThreadPool * pool,
+    guint max_preparing)
+{
+  GstRTSPThreadPoolPrivate *priv;
+
+  g_return_if_fail (GST_IS_RTSP_THREAD_POOL (pool));
+
+  priv = pool->priv;
+
+  g_mutex_lock (&priv->lock);
+  priv->max_preparing = max_preparing;
+  g_mutex_unlock (&priv->lock);
+}
+
+/**
+ * gst_rtsp_thread_pool_get_max_preparing:
+ * @pool: a #GstRTSPThreadPool
+ *
+ * Get the maximum amount of medias that clients can be preparing at the
+ * same time. See gst_rtsp_thread_pool_set_max_preparing().
+ *
+ * Returns: the maximum amount of medias being prepared.
+ *
+ * Since: 1.24
+ */
+guint
+gst_rtsp_thread_pool_get_max_preparing (GstRTSPThreadPool * pool)
+{
+  GstRTSPThreadPoolPrivate *priv;
+  guint res;
+
+  g_return_val_if_fail (GST_IS_RTSP_THREAD_POOL (pool), 0);
+
+  priv = pool->priv;
+
+  g_mutex_lock (&priv->lock);
+  res = priv->max_preparing;
+  g_mutex_unlock (&priv->lock);
+
+  return res;
+}
+
+/* Returns FALSE when the client should not prepare a media now, otherwise
+ * gst_rtsp_thread_pool_end_prepare() must be called when the prepare is
+ * done. */
+gboolean
+gst_rtsp_thread_pool_begin_prepare (GstRTSPThreadPool * pool)
+{
+  GstRTSPThreadPoolPrivate *priv = pool->priv;
+  guint n_preparing;
+  gboolean res;
+
+  g_mutex_lock (&priv->lock);
+  n_preparing = priv->n_preparing;
+  res = priv->max_preparing == 0 || n_preparing < priv->max_preparing;
+  if (res)
+    priv->n_preparing++;
+  g_mutex_unlock (&priv->lock);
+
+  if (!res)
+    GST_DEBUG_OBJECT (pool, "already %u medias preparing", n_preparing);
+
+  return res;
+}
+
+void
+gst_rtsp_thread_pool_end_prepare (GstRTSPThreadPool * pool)
+{
+  GstRTSPThreadPoolPrivate *priv = pool->priv;
+
+  g_mutex_lock (&priv->lock);
+  g_assert (priv->n_preparing > 0);
+  priv->n_preparing--;
+  g_mutex_unlock (&priv->lock);
+}
+
+/* with priv->lock, the thread that serves the least clients */
+static GstRTSPThread *
+find_least_used_thread (GstRTSPThreadPool * pool)
+{
+  GstRTSPThreadPoolPrivate *priv = pool->priv;
+  GstRTSPThreadImpl *best = NULL;
+  gint best_reused = G_MAXINT;
+  GList *walk;
+
+  for (walk = priv->threads.head; walk; walk = walk->next) {
+    GstRTSPThreadImpl *impl = walk->data;
+    gint reused = g_atomic_int_get (&impl->reused);
+
+    if (reused < best_reused) {
+      best = impl;
+      best_reused = reused;
+    }
+  }
+
+  return GST_RTSP_THREAD (best);
+}
+
 static GstRTSPThread *
 make_thread (GstRTSPThreadPool * pool, GstRTSPThreadType type,
     GstRTSPContext * ctx)
@@ -452,8 +591,10 @@ default_get_thread (GstRTSPThreadPool * pool,
       retry:
         if (priv->max_threads > 0 &&
             g_queue_get_length (&priv->threads) >= priv->max_threads) {
-          /* max threads reached, recycle from queue */
-          thread = g_queue_pop_head (&priv->threads);
+          /* max threads reached, recycle the thread with the least clients
+           * so that a burst of clients is spread evenly */
+          thread = find_least_used_thread (pool);
+          g_queue_remove (&priv->threads, thread);
           GST_DEBUG_OBJECT (pool, "recycle client thread %p", thread);
           if (!gst_rtsp_thread_reuse (thread)) {
             GST_DEBUG_OBJECT (pool, "thread %p stopping, retry", thread);
@@ -547,13 +688,18 @@ gst_rtsp_thread_pool_get_thread (GstRTSPThreadPool * pool,
  *
  * Wait for all tasks to be stopped and free all allocated resources. This is
  * mainly used in test suites to ensure proper cleanup of internal data
- * structures.
+ * structures. This includes the threads that prepare medias for
+ * #GstRTSPMediaFactory:prepared-pool-size.
  */
 void
 gst_rtsp_thread_pool_cleanup (void)
 {
   GstRTSPThreadPoolClass *klass;
 
+  /* the medias that factories prepare in the background get their threads
+   * from here */
+  gst_rtsp_media_factory_cleanup_prepare_pool ();
+
   klass =
       GST_RTSP_THREAD_POOL_CLASS (g_type_class_ref
       (gst_rtsp_thread_pool_get_type ()));
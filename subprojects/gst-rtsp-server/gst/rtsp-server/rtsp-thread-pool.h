@@ -171,6 +171,12 @@ void                gst_rtsp_thread_pool_set_max_threads (GstRTSPThreadPool * po
 GST_RTSP_SERVER_API
 gint                gst_rtsp_thread_pool_get_max_threads (GstRTSPThreadPool * pool);
 
+GST_RTSP_SERVER_API
+void                gst_rtsp_thread_pool_set_max_preparing (GstRTSPThreadPool * pool, guint max_preparing);
+
+GST_RTSP_SERVER_API
+guint               gst_rtsp_thread_pool_get_max_preparing (GstRTSPThreadPool * pool);
+
 GST_RTSP_SERVER_API
 GstRTSPThread *     gst_rtsp_thread_pool_get_thread      (GstRTSPThreadPool *pool,
                                                           GstRTSPThreadType type,
@@ -0,0 +1,273 @@
+/* GStreamer RTSP server load benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Starts a server on a local port and lets many clients connect at once,
+ * like cameras reconnecting after a network outage. Every client does
+ * DESCRIBE, SETUP with TCP interleaved transport and PLAY on its own
+ * connection and keeps the session open until all clients are done.
+ * Reports how long the clients took from connecting until the PLAY
+ * response and how many were turned away by the server. */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <gst/gst.h>
+
+#include <gst/rtsp-server/rtsp-server.h>
+
+#define DEFAULT_CLIENTS 1000
+#define DEFAULT_CONCURRENCY 100
+#define TIMEOUT (10 * G_USEC_PER_SEC)
+
+typedef struct
+{
+  gchar *uri;
+  GMutex lock;
+  GstRTSPConnection **conns;
+  gdouble *latencies;
+  guint n_played;
+  guint n_rejected;
+  guint n_failed;
+} Load;
+
+/* send @method for @uri and wait for the response, which is returned in
+ * @response */
+static GstRTSPStatusCode
+do_request (GstRTSPConnection * conn, GstRTSPMethod method, const gchar * uri,
+    const gchar * session, const gchar * transport, GstRTSPMessage * response)
+{
+  GstRTSPMessage request = { 0 };
+
+  gst_rtsp_message_init_request (&request, method, uri);
+  if (session)
+    gst_rtsp_message_add_header (&request, GST_RTSP_HDR_SESSION, session);
+  if (transport)
+    gst_rtsp_message_add_header (&request, GST_RTSP_HDR_TRANSPORT, transport);
+
+  if (gst_rtsp_connection_send_usec (conn, &request, TIMEOUT) != GST_RTSP_OK) {
+    gst_rtsp_message_unset (&request);
+    return GST_RTSP_STS_INVALID;
+  }
+  gst_rtsp_message_unset (&request);
+
+  if (gst_rtsp_connection_receive_usec (conn, response, TIMEOUT) !=
+      GST_RTSP_OK)
+    return GST_RTSP_STS_INVALID;
+
+  return response->type_data.response.code;
+}
+
+static void
+run_client (gpointer data, Load * load)
+{
+  guint idx = GPOINTER_TO_UINT (data) - 1;
+  GstRTSPMessage response = { 0 };
+  GstRTSPConnection *conn = NULL;
+  GstRTSPStatusCode code;
+  GstRTSPUrl *url;
+  gchar *setup_uri, *session = NULL, *value;
+  gint64 start;
+
+  start = g_get_monotonic_time ();
+  setup_uri = g_strdup_printf ("%s/stream=0", load->uri);
+
+  gst_rtsp_url_parse (load->uri, &url);
+  if (gst_rtsp_connection_create (url, &conn) != GST_RTSP_OK ||
+      gst_rtsp_connection_connect_usec (conn, TIMEOUT) != GST_RTSP_OK)
+    goto failed;
+
+  code = do_request (conn, GST_RTSP_DESCRIBE, load->uri, NULL, NULL,
+      &response);
+  gst_rtsp_message_unset (&response);
+  if (code != GST_RTSP_STS_OK)
+    goto not_ok;
+
+  code = do_request (conn, GST_RTSP_SETUP, setup_uri, NULL,
+      "RTP/AVP/TCP;unicast;interleaved=0-1", &response);
+  if (code == GST_RTSP_STS_OK && gst_rtsp_message_get_header (&response,
+          GST_RTSP_HDR_SESSION, &value, 0) == GST_RTSP_OK)
+    session = g_strndup (value, strcspn (value, ";"));
+  gst_rtsp_message_unset (&response);
+  if (code != GST_RTSP_STS_OK)
+    goto not_ok;
+
+  code = do_request (conn, GST_RTSP_PLAY, load->uri, session, NULL,
+      &response);
+  gst_rtsp_message_unset (&response);
+  if (code != GST_RTSP_STS_OK)
+    goto not_ok;
+
+  g_mutex_lock (&load->lock);
+  load->conns[idx] = conn;
+  load->latencies[load->n_played++] =
+      (g_get_monotonic_time () - start) / 1000.0;
+  g_mutex_unlock (&load->lock);
+  conn = NULL;
+  goto done;
+
+not_ok:
+  if (code == GST_RTSP_STS_SERVICE_UNAVAILABLE) {
+    g_mutex_lock (&load->lock);
+    load->n_rejected++;
+    g_mutex_unlock (&load->lock);
+    goto done;
+  }
+failed:
+  g_mutex_lock (&load->lock);
+  load->n_failed++;
+  g_mutex_unlock (&load->lock);
+done:
+  if (conn)
+    gst_rtsp_connection_free (conn);
+  gst_rtsp_url_free (url);
+  g_free (setup_uri);
+  g_free (session);
+}
+
+static gpointer
+run_server (GMainLoop * loop)
+{
+  g_main_loop_run (loop);
+
+  return NULL;
+}
+
+static gint
+compare_latency (gconstpointer a, gconstpointer b)
+{
+  gdouble la = *(const gdouble *) a, lb = *(const gdouble *) b;
+
+  return la < lb ? -1 : la > lb;
+}
+
+int
+main (int argc, char *argv[])
+{
+  GError *err = NULL;
+  gint n_clients = DEFAULT_CLIENTS;
+  gint concurrency = DEFAULT_CONCURRENCY;
+  gint max_threads = 1;
+  gint max_preparing = 0;
+  gboolean non_shared = FALSE;
+  GOptionContext *ctx;
+  GOptionEntry options[] = {
+    {"clients", 'c', 0, G_OPTION_ARG_INT, &n_clients,
+        "Number of clients", NULL},
+    {"concurrency", 'n', 0, G_OPTION_ARG_INT, &concurrency,
+        "Number of clients connecting at the same time", NULL},
+    {"max-threads", 't', 0, G_OPTION_ARG_INT, &max_threads,
+        "Maximum number of server threads for clients", NULL},
+    {"max-preparing", 'p', 0, G_OPTION_ARG_INT, &max_preparing,
+        "Maximum number of medias the clients prepare at once", NULL},
+    {"non-shared", 's', 0, G_OPTION_ARG_NONE, &non_shared,
+        "Give every client its own media", NULL},
+    {NULL}
+  };
+  GstRTSPServer *server;
+  GstRTSPMountPoints *mounts;
+  GstRTSPMediaFactory *factory;
+  GstRTSPThreadPool *thread_pool;
+  GMainContext *context;
+  GMainLoop *loop;
+  GThread *server_thread;
+  GThreadPool *clients;
+  GTimer *timer;
+  gdouble elapsed;
+  Load load = { 0, };
+  gint i;
+
+  ctx = g_option_context_new ("");
+  g_option_context_add_main_entries (ctx, options, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_print ("Error initializing: %s\n", GST_STR_NULL (err->message));
+    g_option_context_free (ctx);
+    g_clear_error (&err);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  server = gst_rtsp_server_new ();
+  gst_rtsp_server_set_service (server, "0");
+  gst_rtsp_server_set_backlog (server, n_clients);
+
+  thread_pool = gst_rtsp_server_get_thread_pool (server);
+  gst_rtsp_thread_pool_set_max_threads (thread_pool, max_threads);
+  gst_rtsp_thread_pool_set_max_preparing (thread_pool, max_preparing);
+  g_object_unref (thread_pool);
+
+  factory = gst_rtsp_media_factory_new ();
+  gst_rtsp_media_factory_set_launch (factory, "( audiotestsrc is-live=true "
+      "! audio/x-raw,format=S16BE,rate=8000,channels=1 "
+      "! rtpL16pay name=pay0 )");
+  gst_rtsp_media_factory_set_shared (factory, !non_shared);
+  mounts = gst_rtsp_server_get_mount_points (server);
+  gst_rtsp_mount_points_add_factory (mounts, "/test", factory);
+  g_object_unref (mounts);
+
+  context = g_main_context_new ();
+  loop = g_main_loop_new (context, FALSE);
+  if (gst_rtsp_server_attach (server, context) == 0) {
+    g_print ("Failed to attach the server\n");
+    return 1;
+  }
+  server_thread = g_thread_new ("server", (GThreadFunc) run_server, loop);
+
+  load.uri = g_strdup_printf ("rtsp://127.0.0.1:%d/test",
+      gst_rtsp_server_get_bound_port (server));
+  g_mutex_init (&load.lock);
+  load.conns = g_new0 (GstRTSPConnection *, n_clients);
+  load.latencies = g_new0 (gdouble, n_clients);
+
+  timer = g_timer_new ();
+  clients = g_thread_pool_new ((GFunc) run_client, &load, concurrency, TRUE,
+      NULL);
+  for (i = 0; i < n_clients; i++)
+    g_thread_pool_push (clients, GUINT_TO_POINTER (i + 1), NULL);
+  g_thread_pool_free (clients, FALSE, TRUE);
+  elapsed = g_timer_elapsed (timer, NULL);
+
+  qsort (load.latencies, load.n_played, sizeof (gdouble), compare_latency);
+  gst_println ("%u playing, %u rejected, %u failed in %.2f s",
+      load.n_played, load.n_rejected, load.n_failed, elapsed);
+  if (load.n_played > 0) {
+    gst_println ("connect to PLAY response: median %.1f ms, 99%% %.1f ms, "
+        "max %.1f ms", load.latencies[load.n_played / 2],
+        load.latencies[load.n_played * 99 / 100],
+        load.latencies[load.n_played - 1]);
+  }
+
+  for (i = 0; i < n_clients; i++) {
+    if (load.conns[i])
+      gst_rtsp_connection_free (load.conns[i]);
+  }
+
+  g_main_loop_quit (loop);
+  g_thread_join (server_thread);
+
+  g_timer_destroy (timer);
+  g_free (load.conns);
+  g_free (load.latencies);
+  g_free (load.uri);
+  g_mutex_clear (&load.lock);
+  g_main_loop_unref (loop);
+  g_main_context_unref (context);
+  g_object_unref (server);
+
+  return 0;
+}
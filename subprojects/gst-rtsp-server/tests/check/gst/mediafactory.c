@@ -314,6 +314,28 @@ GST_START_TEST (test_reset)
 
 GST_END_TEST;
 
+GST_START_TEST (test_prepared_pool_size)
+{
+  GstRTSPMediaFactory *factory;
+  guint size;
+
+  factory = gst_rtsp_media_factory_new ();
+  fail_unless_equals_int (gst_rtsp_media_factory_get_prepared_pool_size
+      (factory), 0);
+
+  gst_rtsp_media_factory_set_prepared_pool_size (factory, 2);
+  fail_unless_equals_int (gst_rtsp_media_factory_get_prepared_pool_size
+      (factory), 2);
+
+  g_object_set (factory, "prepared-pool-size", 4, NULL);
+  g_object_get (factory, "prepared-pool-size", &size, NULL);
+  fail_unless_equals_int (size, 4);
+
+  g_object_unref (factory);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_mcast_ttl)
 {
   GstRTSPMediaFactory *factory;
@@ -435,6 +457,7 @@ rtspmediafactory_suite (void)
   tcase_add_test (tc, test_addresspool);
   tcase_add_test (tc, test_permissions);
   tcase_add_test (tc, test_reset);
+  tcase_add_test (tc, test_prepared_pool_size);
   tcase_add_test (tc, test_mcast_ttl);
   tcase_add_test (tc, test_allow_bind_mcast);
 
@@ -709,6 +709,176 @@ GST_START_TEST (test_describe)
 
 GST_END_TEST;
 
+static GMutex prepared_lock;
+static GPtrArray *constructed_medias;
+static GstRTSPMedia *described_media;
+
+static void
+prepared_media_constructed (GstRTSPMediaFactory * factory,
+    GstRTSPMedia * media, gpointer user_data)
+{
+  /* medias for the pool are constructed from a background thread */
+  g_mutex_lock (&prepared_lock);
+  g_ptr_array_add (constructed_medias, g_object_ref (media));
+  g_mutex_unlock (&prepared_lock);
+}
+
+static void
+prepared_describe_request (GstRTSPClient * client, GstRTSPContext * ctx,
+    gpointer user_data)
+{
+  g_mutex_lock (&prepared_lock);
+  described_media = ctx->media;
+  g_mutex_unlock (&prepared_lock);
+}
+
+static void
+prepared_client_connected (GstRTSPServer * server, GstRTSPClient * client,
+    gpointer user_data)
+{
+  g_signal_connect (client, "describe-request",
+      G_CALLBACK (prepared_describe_request), NULL);
+}
+
+/* returns the @index'th media the factory constructed, waiting for it */
+static GstRTSPMedia *
+wait_for_constructed_media (guint index)
+{
+  gint64 deadline = g_get_monotonic_time () + 10 * G_USEC_PER_SEC;
+  GstRTSPMedia *media = NULL;
+
+  while (media == NULL) {
+    g_mutex_lock (&prepared_lock);
+    if (constructed_medias->len > index)
+      media = g_ptr_array_index (constructed_medias, index);
+    g_mutex_unlock (&prepared_lock);
+
+    if (media == NULL) {
+      fail_unless (g_get_monotonic_time () < deadline);
+      g_usleep (10000);
+    }
+  }
+
+  return media;
+}
+
+/* returns the media of the last DESCRIBE, the signal is emitted after the
+ * response was sent */
+static GstRTSPMedia *
+wait_for_described_media (void)
+{
+  gint64 deadline = g_get_monotonic_time () + 10 * G_USEC_PER_SEC;
+  GstRTSPMedia *media = NULL;
+
+  while (media == NULL) {
+    g_mutex_lock (&prepared_lock);
+    media = described_media;
+    described_media = NULL;
+    g_mutex_unlock (&prepared_lock);
+
+    if (media == NULL) {
+      fail_unless (g_get_monotonic_time () < deadline);
+      g_usleep (10000);
+    }
+  }
+
+  return media;
+}
+
+static void
+wait_for_prepared_media (GstRTSPMedia * media)
+{
+  gint64 deadline = g_get_monotonic_time () + 10 * G_USEC_PER_SEC;
+
+  while (gst_rtsp_media_get_status (media) != GST_RTSP_MEDIA_STATUS_PREPARED) {
+    fail_unless (g_get_monotonic_time () < deadline);
+    g_usleep (10000);
+  }
+
+  /* leave the preparing thread time to hand it to the factory */
+  g_usleep (G_USEC_PER_SEC / 10);
+}
+
+GST_START_TEST (test_describe_prepared_pool)
+{
+  GstRTSPMountPoints *mounts;
+  GstRTSPMediaFactory *factory;
+  GstRTSPConnection *conn1, *conn2;
+  GstSDPMessage *sdp_message;
+  const GstSDPMedia *sdp_media;
+  const gchar *video_control;
+  GstRTSPRange client_ports;
+  GstRTSPTransport *video_transport = NULL;
+  GstRTSPMedia *media, *prepared, *replacement;
+  gchar *session = NULL;
+
+  constructed_medias = g_ptr_array_new_with_free_func (g_object_unref);
+  g_signal_connect (server, "client-connected",
+      G_CALLBACK (prepared_client_connected), NULL);
+
+  start_server (FALSE);
+
+  mounts = gst_rtsp_server_get_mount_points (server);
+  factory = gst_rtsp_mount_points_match (mounts, TEST_MOUNT_POINT, NULL);
+  g_object_unref (mounts);
+  gst_rtsp_media_factory_set_prepared_pool_size (factory, 1);
+  g_signal_connect (factory, "media-constructed",
+      G_CALLBACK (prepared_media_constructed), NULL);
+
+  /* the first client constructs its own media, which makes the factory
+   * prepare one for the next client */
+  conn1 = connect_to_server (test_port, TEST_MOUNT_POINT);
+  sdp_message = do_describe (conn1, TEST_MOUNT_POINT);
+  gst_sdp_message_free (sdp_message);
+
+  media = wait_for_described_media ();
+
+  prepared = wait_for_constructed_media (0);
+  if (prepared == media)
+    prepared = wait_for_constructed_media (1);
+  fail_unless (prepared != media);
+  wait_for_prepared_media (prepared);
+
+  /* the second client gets the prepared media and can set it up */
+  conn2 = connect_to_server (test_port, TEST_MOUNT_POINT);
+  sdp_message = do_describe (conn2, TEST_MOUNT_POINT);
+
+  fail_unless (wait_for_described_media () == prepared);
+
+  fail_unless (gst_sdp_message_medias_len (sdp_message) == 2);
+  sdp_media = gst_sdp_message_get_media (sdp_message, 0);
+  video_control = gst_sdp_media_get_attribute_val (sdp_media, "control");
+  get_client_ports (&client_ports);
+  fail_unless (do_setup (conn2, video_control, &client_ports, &session,
+          &video_transport) == GST_RTSP_STS_OK);
+
+  /* and a replacement is prepared for the client after it */
+  replacement = wait_for_constructed_media (2);
+  fail_unless (replacement != media && replacement != prepared);
+  wait_for_prepared_media (replacement);
+
+  g_mutex_lock (&prepared_lock);
+  fail_unless_equals_int (constructed_medias->len, 3);
+  g_mutex_unlock (&prepared_lock);
+
+  /* clean up and iterate so the clean-up can finish */
+  fail_unless (do_simple_request (conn2, GST_RTSP_TEARDOWN,
+          session) == GST_RTSP_STS_OK);
+  g_free (session);
+  gst_rtsp_transport_free (video_transport);
+  gst_sdp_message_free (sdp_message);
+  gst_rtsp_connection_free (conn1);
+  gst_rtsp_connection_free (conn2);
+  g_object_unref (factory);
+  stop_server ();
+  iterate ();
+
+  g_ptr_array_unref (constructed_medias);
+  constructed_medias = NULL;
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_describe_record_media)
 {
   GstRTSPConnection *conn;
@@ -1309,6 +1479,86 @@ GST_START_TEST (test_play_tcp)
 
 GST_END_TEST;
 
+/* the client does not read for a while, so that the server has to queue the
+ * packets in the backlog of the transport, and then reads them all back. The
+ * backlog is drained in batches, which must not lose or reorder packets */
+GST_START_TEST (test_play_tcp_stalled_reader)
+{
+  GstRTSPConnection *conn;
+  GstSDPMessage *sdp_message = NULL;
+  const GstSDPMedia *sdp_media;
+  const gchar *video_control;
+  GstRTSPRange client_ports = { 0 };
+  gchar *session = NULL;
+  GstRTSPTransport *video_transport = NULL;
+  GstRTSPMessage *message;
+  gint n_packets = 0;
+  gint prev_seq = -1;
+
+  start_tcp_server (FALSE);
+
+  conn = connect_to_server (test_port, TEST_MOUNT_POINT);
+
+  sdp_message = do_describe (conn, TEST_MOUNT_POINT);
+  fail_unless (gst_sdp_message_medias_len (sdp_message) == 2);
+  sdp_media = gst_sdp_message_get_media (sdp_message, 0);
+  video_control = gst_sdp_media_get_attribute_val (sdp_media, "control");
+
+  get_client_ports (&client_ports);
+  fail_unless (do_setup_full (conn, video_control, GST_RTSP_LOWER_TRANS_TCP,
+          &client_ports, NULL, &session, &video_transport,
+          NULL) == GST_RTSP_STS_OK);
+
+  fail_unless (do_simple_request (conn, GST_RTSP_PLAY,
+          session) == GST_RTSP_STS_OK);
+
+  /* fill the socket buffers and let the backlog grow */
+  g_usleep (G_USEC_PER_SEC);
+
+  fail_unless (gst_rtsp_message_new (&message) == GST_RTSP_OK);
+  while (n_packets < 2000) {
+    guint8 channel = 0xff;
+    guint8 *data;
+    guint size;
+    gint seq;
+
+    fail_unless (gst_rtsp_connection_receive (conn, message,
+            NULL) == GST_RTSP_OK);
+    if (gst_rtsp_message_get_type (message) != GST_RTSP_MESSAGE_DATA)
+      goto next;
+
+    gst_rtsp_message_parse_data (message, &channel);
+    if (channel != video_transport->interleaved.min)
+      goto next;
+
+    gst_rtsp_message_get_body (message, &data, &size);
+    fail_unless (size >= 12);
+    seq = GST_READ_UINT16_BE (data + 2);
+    if (prev_seq != -1)
+      fail_unless_equals_int (seq, (prev_seq + 1) & 0xffff);
+    prev_seq = seq;
+    n_packets++;
+
+  next:
+    gst_rtsp_message_unset (message);
+  }
+  gst_rtsp_message_free (message);
+
+  fail_unless (do_simple_request (conn, GST_RTSP_TEARDOWN,
+          session) == GST_RTSP_STS_OK);
+
+  /* clean up and iterate so the clean-up can finish */
+  g_free (session);
+  gst_rtsp_transport_free (video_transport);
+  gst_sdp_message_free (sdp_message);
+  gst_rtsp_connection_free (conn);
+  stop_server ();
+  iterate ();
+}
+
+GST_END_TEST;
+
+
 GST_START_TEST (test_play_without_session)
 {
   GstRTSPConnection *conn;
@@ -2705,6 +2955,149 @@ GST_START_TEST (test_double_play)
 
 GST_END_TEST;
 
+/* SETUP requests of the stream with index 1 that still have to fail, or -1 to
+ * fail all of them */
+static gint failing_audio_setups;
+static gint n_setup_requests;
+
+static GstRTSPStatusCode
+pre_setup_request_fail_audio (GstRTSPClient * client, GstRTSPContext * ctx,
+    gpointer user_data)
+{
+  n_setup_requests++;
+
+  if (gst_rtsp_stream_get_index (ctx->stream) == 1 &&
+      failing_audio_setups != 0) {
+    if (failing_audio_setups > 0)
+      failing_audio_setups--;
+    return GST_RTSP_STS_SERVICE_UNAVAILABLE;
+  }
+
+  return GST_RTSP_STS_OK;
+}
+
+static void
+client_connected_fail_audio_setup (GstRTSPServer * server,
+    GstRTSPClient * client, gpointer user_data)
+{
+  g_signal_connect (client, "pre-setup-request",
+      G_CALLBACK (pre_setup_request_fail_audio), NULL);
+}
+
+static gint n_streams_with_data;
+
+static GstPadProbeReturn
+rtspsrc_data_probe (GstPad * pad, GstPadProbeInfo * info,
+    GstElement * pipeline)
+{
+  /* tell the test once both streams received data */
+  if (g_atomic_int_add (&n_streams_with_data, 1) == 1)
+    gst_element_post_message (pipeline,
+        gst_message_new_application (GST_OBJECT (pipeline),
+            gst_structure_new_empty ("streams-flowing")));
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
+static void
+rtspsrc_pad_added (GstElement * rtspsrc, GstPad * pad, GstElement * pipeline)
+{
+  GstElement *sink;
+  GstPad *sinkpad;
+
+  sink = gst_element_factory_make ("fakesink", NULL);
+  fail_unless (sink != NULL);
+  g_object_set (sink, "async", FALSE, NULL);
+  gst_bin_add (GST_BIN (pipeline), sink);
+  gst_element_sync_state_with_parent (sink);
+
+  sinkpad = gst_element_get_static_pad (sink, "sink");
+  fail_unless (gst_pad_link (pad, sinkpad) == GST_PAD_LINK_OK);
+  gst_pad_add_probe (sinkpad, GST_PAD_PROBE_TYPE_BUFFER,
+      (GstPadProbeCallback) rtspsrc_data_probe, pipeline, NULL);
+  gst_object_unref (sinkpad);
+}
+
+/* play the two stream test media with rtspsrc and fast-start, where the
+ * first @failing_setups SETUP requests of the audio stream fail */
+static void
+do_test_rtspsrc_fast_start (gint failing_setups, gboolean expect_error,
+    gint expected_setups)
+{
+  GstElement *pipeline, *rtspsrc;
+  GstMessage *msg;
+  GstBus *bus;
+  gchar *address, *uri;
+
+  start_tcp_server (FALSE);
+
+  failing_audio_setups = failing_setups;
+  n_setup_requests = 0;
+  n_streams_with_data = 0;
+  g_signal_connect (server, "client-connected",
+      G_CALLBACK (client_connected_fail_audio_setup), NULL);
+
+  address = gst_rtsp_server_get_address (server);
+  uri = g_strdup_printf ("rtsp://%s:%d%s", address, test_port,
+      TEST_MOUNT_POINT);
+  g_free (address);
+
+  pipeline = gst_pipeline_new (NULL);
+  rtspsrc = gst_element_factory_make ("rtspsrc", NULL);
+  fail_unless (rtspsrc != NULL);
+  g_object_set (rtspsrc, "location", uri, "fast-start", TRUE,
+      "protocols", GST_RTSP_LOWER_TRANS_TCP, NULL);
+  g_free (uri);
+  g_signal_connect (rtspsrc, "pad-added", G_CALLBACK (rtspsrc_pad_added),
+      pipeline);
+  gst_bin_add (GST_BIN (pipeline), rtspsrc);
+
+  bus = gst_element_get_bus (pipeline);
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  /* this iterates the default main context, which runs the server */
+  msg = gst_bus_poll (bus, GST_MESSAGE_APPLICATION | GST_MESSAGE_ERROR, -1);
+  if (expect_error)
+    fail_unless (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR);
+  else
+    fail_unless (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_APPLICATION);
+  gst_message_unref (msg);
+
+  /* all SETUP requests were answered by then */
+  fail_unless_equals_int (n_setup_requests, expected_setups);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (bus);
+  gst_object_unref (pipeline);
+
+  stop_server ();
+  iterate ();
+}
+
+GST_START_TEST (test_rtspsrc_fast_start)
+{
+  /* video serially, then audio pipelined */
+  do_test_rtspsrc_fast_start (0, FALSE, 2);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtspsrc_fast_start_setup_failed)
+{
+  /* the pipelined audio SETUP fails and is retried on its own */
+  do_test_rtspsrc_fast_start (1, FALSE, 3);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtspsrc_fast_start_setup_error)
+{
+  /* the audio SETUP also fails when retried on its own */
+  do_test_rtspsrc_fast_start (-1, TRUE, 3);
+}
+
+GST_END_TEST;
+
 
 static Suite *
 rtspserver_suite (void)
@@ -2718,6 +3111,7 @@ rtspserver_suite (void)
   tcase_add_test (tc, test_connect);
   tcase_add_test (tc, test_describe);
   tcase_add_test (tc, test_describe_non_existing_mount_point);
+  tcase_add_test (tc, test_describe_prepared_pool);
   tcase_add_test (tc, test_describe_record_media);
   tcase_add_test (tc, test_setup_udp);
   tcase_add_test (tc, test_setup_tcp);
@@ -2727,6 +3121,7 @@ rtspserver_suite (void)
   tcase_add_test (tc, test_setup_non_existing_stream);
   tcase_add_test (tc, test_play);
   tcase_add_test (tc, test_play_tcp);
+  tcase_add_test (tc, test_play_tcp_stalled_reader);
   tcase_add_test (tc, test_play_without_session);
   tcase_add_test (tc, test_bind_already_in_use);
   tcase_add_test (tc, test_play_multithreaded);
@@ -2747,6 +3142,9 @@ rtspserver_suite (void)
   tcase_add_test (tc, test_multiple_transports);
   tcase_add_test (tc, test_suspend_mode_reset_only_audio);
   tcase_add_test (tc, test_double_play);
+  tcase_add_test (tc, test_rtspsrc_fast_start);
+  tcase_add_test (tc, test_rtspsrc_fast_start_setup_failed);
+  tcase_add_test (tc, test_rtspsrc_fast_start_setup_error);
 
   return s;
 }
@@ -187,6 +187,60 @@ GST_START_TEST (test_pool)
 
 GST_END_TEST;
 
+GST_START_TEST (test_cleanup_expiry)
+{
+  GstRTSPSessionPool *pool;
+  GstRTSPSession *session1, *session2, *session3;
+  gchar *session1id;
+  GstRTSPSession *compare;
+
+  pool = gst_rtsp_session_pool_new ();
+
+  session1 = gst_rtsp_session_pool_create (pool);
+  session1id = g_strdup (gst_rtsp_session_get_sessionid (session1));
+  g_object_set (session1, "timeout", 1, "extra-timeout", 0, NULL);
+
+  /* never expires until it gets a timeout */
+  session2 = gst_rtsp_session_pool_create (pool);
+  g_object_set (session2, "timeout", 0, "extra-timeout", 0, NULL);
+
+  /* expires after the others */
+  session3 = gst_rtsp_session_pool_create (pool);
+  g_object_set (session3, "timeout", 4, "extra-timeout", 0, NULL);
+
+  fail_unless_equals_int (gst_rtsp_session_pool_get_n_sessions (pool), 3);
+
+  /* touching session1 moves its expiry time */
+  g_usleep (G_USEC_PER_SEC / 2);
+  compare = gst_rtsp_session_pool_find (pool, session1id);
+  fail_unless (compare == session1);
+  g_object_unref (compare);
+  g_usleep (G_USEC_PER_SEC * 3 / 4);
+  fail_unless_equals_int (gst_rtsp_session_pool_cleanup (pool), 0);
+  fail_unless_equals_int (gst_rtsp_session_pool_get_n_sessions (pool), 3);
+
+  gst_rtsp_session_set_timeout (session2, 1);
+
+  g_usleep (G_USEC_PER_SEC * 5 / 4);
+  fail_unless_equals_int (gst_rtsp_session_pool_cleanup (pool), 2);
+  fail_unless_equals_int (gst_rtsp_session_pool_get_n_sessions (pool), 1);
+  fail_unless (gst_rtsp_session_pool_find (pool, session1id) == NULL);
+
+  /* lowering the timeout makes session3 expire earlier */
+  gst_rtsp_session_set_timeout (session3, 1);
+  fail_unless_equals_int (gst_rtsp_session_pool_cleanup (pool), 1);
+  fail_unless_equals_int (gst_rtsp_session_pool_get_n_sessions (pool), 0);
+
+  g_object_unref (session1);
+  g_object_unref (session2);
+  g_object_unref (session3);
+  g_free (session1id);
+
+  g_object_unref (pool);
+}
+
+GST_END_TEST;
+
 static Suite *
 rtspsessionpool_suite (void)
 {
@@ -196,6 +250,7 @@ rtspsessionpool_suite (void)
   suite_add_tcase (s, tc);
   tcase_set_timeout (tc, 15);
   tcase_add_test (tc, test_pool);
+  tcase_add_test (tc, test_cleanup_expiry);
 
   return s;
 }
@@ -22,6 +22,7 @@
 #include <gst/check/gstcheck.h>
 
 #include <rtsp-thread-pool.h>
+#include <rtsp-client.h>
 
 GST_START_TEST (test_pool_get_thread)
 {
@@ -215,6 +216,224 @@ GST_START_TEST (test_pool_thread_copy)
 
 GST_END_TEST;
 
+GST_START_TEST (test_pool_least_used_thread)
+{
+  GstRTSPThreadPool *pool;
+  GstRTSPThread *thread1, *thread2, *thread3, *thread4, *thread5;
+
+  pool = gst_rtsp_thread_pool_new ();
+  gst_rtsp_thread_pool_set_max_threads (pool, 2);
+
+  thread1 = gst_rtsp_thread_pool_get_thread (pool, GST_RTSP_THREAD_TYPE_CLIENT,
+      NULL);
+  thread2 = gst_rtsp_thread_pool_get_thread (pool, GST_RTSP_THREAD_TYPE_CLIENT,
+      NULL);
+  fail_unless (thread2 != thread1);
+
+  /* both threads serve two clients now */
+  thread3 = gst_rtsp_thread_pool_get_thread (pool, GST_RTSP_THREAD_TYPE_CLIENT,
+      NULL);
+  fail_unless (thread3 == thread1);
+  thread4 = gst_rtsp_thread_pool_get_thread (pool, GST_RTSP_THREAD_TYPE_CLIENT,
+      NULL);
+  fail_unless (thread4 == thread2);
+
+  /* a client of the second thread leaves, the next client goes there even
+   * though the first thread is next in line */
+  gst_rtsp_thread_stop (thread4);
+  thread5 = gst_rtsp_thread_pool_get_thread (pool, GST_RTSP_THREAD_TYPE_CLIENT,
+      NULL);
+  fail_unless (thread5 == thread2);
+
+  gst_rtsp_thread_stop (thread1);
+  gst_rtsp_thread_stop (thread2);
+  gst_rtsp_thread_stop (thread3);
+  gst_rtsp_thread_stop (thread5);
+  g_object_unref (pool);
+  gst_rtsp_thread_pool_cleanup ();
+}
+
+GST_END_TEST;
+
+typedef struct
+{
+  GMutex lock;
+  GCond cond;
+  GstElement *appsrc;
+  gboolean need_data;
+  GstRTSPStatusCode code;
+  gchar *retry_after;
+} PrepareData;
+
+static void
+need_data (GstElement * appsrc, guint length, PrepareData * data)
+{
+  g_mutex_lock (&data->lock);
+  data->need_data = TRUE;
+  g_cond_broadcast (&data->cond);
+  g_mutex_unlock (&data->lock);
+}
+
+static void
+media_constructed (GstRTSPMediaFactory * factory, GstRTSPMedia * media,
+    PrepareData * data)
+{
+  GstElement *element = gst_rtsp_media_get_element (media);
+  GstCaps *caps;
+
+  data->appsrc = gst_bin_get_by_name (GST_BIN (element), "src");
+  caps = gst_caps_from_string ("audio/x-raw,format=S16BE,rate=8000,"
+      "channels=1,layout=interleaved");
+  g_object_set (data->appsrc, "caps", caps, "format", GST_FORMAT_TIME, NULL);
+  g_signal_connect (data->appsrc, "need-data", G_CALLBACK (need_data), data);
+  gst_caps_unref (caps);
+  gst_object_unref (element);
+}
+
+static gboolean
+record_response (GstRTSPClient * client, GstRTSPMessage * response,
+    gboolean close, PrepareData * data)
+{
+  const gchar *reason;
+  GstRTSPVersion version;
+  gchar *retry_after;
+
+  fail_unless (gst_rtsp_message_parse_response (response, &data->code,
+          &reason, &version) == GST_RTSP_OK);
+  g_free (data->retry_after);
+  data->retry_after = NULL;
+  if (gst_rtsp_message_get_header (response, GST_RTSP_HDR_RETRY_AFTER,
+          &retry_after, 0) == GST_RTSP_OK)
+    data->retry_after = g_strdup (retry_after);
+
+  return TRUE;
+}
+
+static GstRTSPClient *
+setup_client (GstRTSPMountPoints * mounts, GstRTSPSessionPool * sessions,
+    GstRTSPThreadPool * pool, PrepareData * data)
+{
+  GstRTSPClient *client = gst_rtsp_client_new ();
+
+  gst_rtsp_client_set_mount_points (client, mounts);
+  gst_rtsp_client_set_session_pool (client, sessions);
+  gst_rtsp_client_set_thread_pool (client, pool);
+  gst_rtsp_client_set_send_func (client,
+      (GstRTSPClientSendFunc) record_response, data, NULL);
+
+  return client;
+}
+
+static GstRTSPResult
+describe (GstRTSPClient * client)
+{
+  GstRTSPMessage request = { 0, };
+  GstRTSPResult res;
+
+  fail_unless (gst_rtsp_message_init_request (&request, GST_RTSP_DESCRIBE,
+          "rtsp://localhost/test") == GST_RTSP_OK);
+  gst_rtsp_message_add_header (&request, GST_RTSP_HDR_CSEQ, "1");
+  res = gst_rtsp_client_handle_message (client, &request);
+  gst_rtsp_message_unset (&request);
+
+  return res;
+}
+
+static gpointer
+describe_thread (GstRTSPClient * client)
+{
+  return GINT_TO_POINTER (describe (client));
+}
+
+static void
+teardown_client (GstRTSPClient * client)
+{
+  gst_rtsp_client_set_thread_pool (client, NULL);
+  g_object_unref (client);
+}
+
+/* The first client's DESCRIBE waits for the media to preroll, which only
+ * happens once the test pushes a buffer. Meanwhile a second client is
+ * turned away. */
+GST_START_TEST (test_pool_max_preparing)
+{
+  PrepareData data1 = { 0, }, data2 = { 0, };
+  GstRTSPThreadPool *pool;
+  GstRTSPSessionPool *sessions;
+  GstRTSPMountPoints *mounts;
+  GstRTSPMediaFactory *factory;
+  GstRTSPClient *client1, *client2;
+  GstFlowReturn ret;
+  GstBuffer *buf;
+  GThread *thread;
+  guint max_preparing;
+
+  g_mutex_init (&data1.lock);
+  g_cond_init (&data1.cond);
+
+  pool = gst_rtsp_thread_pool_new ();
+  g_object_set (pool, "max-preparing", 1, NULL);
+  g_object_get (pool, "max-preparing", &max_preparing, NULL);
+  fail_unless_equals_int (max_preparing, 1);
+  fail_unless_equals_int (gst_rtsp_thread_pool_get_max_preparing (pool), 1);
+
+  factory = gst_rtsp_media_factory_new ();
+  gst_rtsp_media_factory_set_launch (factory,
+      "( appsrc name=src ! rtpL16pay name=pay0 )");
+  gst_rtsp_media_factory_set_shared (factory, TRUE);
+  g_signal_connect (factory, "media-constructed",
+      G_CALLBACK (media_constructed), &data1);
+  mounts = gst_rtsp_mount_points_new ();
+  gst_rtsp_mount_points_add_factory (mounts, "/test", factory);
+  sessions = gst_rtsp_session_pool_new ();
+
+  client1 = setup_client (mounts, sessions, pool, &data1);
+  client2 = setup_client (mounts, sessions, pool, &data2);
+
+  thread = g_thread_new ("describe", (GThreadFunc) describe_thread,
+      client1);
+
+  g_mutex_lock (&data1.lock);
+  while (!data1.need_data)
+    g_cond_wait (&data1.cond, &data1.lock);
+  g_mutex_unlock (&data1.lock);
+
+  fail_unless_equals_int (describe (client2), GST_RTSP_OK);
+  fail_unless_equals_int (data2.code, GST_RTSP_STS_SERVICE_UNAVAILABLE);
+  fail_unless_equals_string (data2.retry_after, "1");
+
+  /* let the media preroll */
+  buf = gst_buffer_new_allocate (NULL, 160, NULL);
+  gst_buffer_memset (buf, 0, 0, 160);
+  GST_BUFFER_PTS (buf) = 0;
+  GST_BUFFER_DURATION (buf) = 10 * GST_MSECOND;
+  g_signal_emit_by_name (data1.appsrc, "push-buffer", buf, &ret);
+  fail_unless_equals_int (ret, GST_FLOW_OK);
+  gst_buffer_unref (buf);
+
+  fail_unless_equals_int (GPOINTER_TO_INT (g_thread_join (thread)),
+      GST_RTSP_OK);
+  fail_unless_equals_int (data1.code, GST_RTSP_STS_OK);
+
+  /* the media is prepared now, so the retry doesn't count */
+  fail_unless_equals_int (describe (client2), GST_RTSP_OK);
+  fail_unless_equals_int (data2.code, GST_RTSP_STS_OK);
+  fail_unless (data2.retry_after == NULL);
+
+  teardown_client (client1);
+  teardown_client (client2);
+  gst_object_unref (data1.appsrc);
+  g_free (data1.retry_after);
+  g_mutex_clear (&data1.lock);
+  g_cond_clear (&data1.cond);
+  g_object_unref (mounts);
+  g_object_unref (sessions);
+  g_object_unref (pool);
+  gst_rtsp_thread_pool_cleanup ();
+}
+
+GST_END_TEST;
+
 static Suite *
 rtspthreadpool_suite (void)
 {
@@ -229,6 +448,8 @@ rtspthreadpool_suite (void)
   tcase_add_test (tc, test_pool_max_threads);
   tcase_add_test (tc, test_pool_max_threads_property);
   tcase_add_test (tc, test_pool_thread_copy);
+  tcase_add_test (tc, test_pool_least_used_thread);
+  tcase_add_test (tc, test_pool_max_preparing);
 
   return s;
 }